@@ -0,0 +1,254 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/**
+This example benchmarks the host-side 2D convolution references in
+cutlass/util/reference/host/convolution.h.
+
+Conv2dFprop, Conv2dDgrad and Conv2dWgrad compute plain multiply-adds of real scalars as implicit
+GEMMs: activation and filter tiles are gathered into panels and multiplied by the packed host GEMM
+micro-kernel, with output tiles distributed over OpenMP threads when the example is built with
+CUTLASS_ENABLE_OPENMP_TESTS. The original nested loops remain available as Conv2dFpropDirect,
+Conv2dDgradDirect and Conv2dWgradDirect.
+
+For each operator the example times both paths on the same operands and checks that the results are
+bitwise identical. Operands hold small integers, so every product and partial sum is exact.
+
+  $ ./examples/61_host_conv2d_reference/61_host_conv2d_reference --n=2 --h=56 --w=56 --c=64 --k=64
+*/
+
+#include <chrono>
+#include <iostream>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/conv/conv2d_problem_size.h"
+
+#include "cutlass/util/command_line.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/convolution.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+using Element = float;
+using Layout = cutlass::layout::TensorNHWC;
+
+/// Command line options
+struct Options {
+  bool help;
+  cutlass::Tensor4DCoord input_size;
+  cutlass::Tensor4DCoord filter_size;
+  cutlass::Tensor4DCoord padding;
+  cutlass::MatrixCoord conv_stride;
+  cutlass::MatrixCoord dilation;
+  int groups;
+  int iterations;
+
+  Options():
+    help(false),
+    input_size(2, 56, 56, 64),
+    filter_size(64, 3, 3, 64),
+    padding(1, 1, 1, 1),
+    conv_stride(1, 1),
+    dilation(1, 1),
+    groups(1),
+    iterations(1) { }
+
+  // Parses the command line
+  void parse(int argc, char const **args) {
+    cutlass::CommandLine cmd(argc, args);
+
+    if (cmd.check_cmd_line_flag("help")) {
+      help = true;
+    }
+
+    cmd.get_cmd_line_argument("n", input_size.n());
+    cmd.get_cmd_line_argument("h", input_size.h());
+    cmd.get_cmd_line_argument("w", input_size.w());
+    cmd.get_cmd_line_argument("c", input_size.c());
+
+    cmd.get_cmd_line_argument("k", filter_size.n());
+    cmd.get_cmd_line_argument("r", filter_size.h());
+    cmd.get_cmd_line_argument("s", filter_size.w());
+
+    cmd.get_cmd_line_argument("g", groups);
+    cmd.get_cmd_line_argument("iterations", iterations);
+
+    int pad_h = filter_size.h() / 2;
+    int pad_w = filter_size.w() / 2;
+    cmd.get_cmd_line_argument("pad_h", pad_h);
+    cmd.get_cmd_line_argument("pad_w", pad_w);
+    padding = {pad_h, pad_h, pad_w, pad_w};
+
+    cmd.get_cmd_line_argument("stride_h", conv_stride.row());
+    cmd.get_cmd_line_argument("stride_w", conv_stride.column());
+
+    filter_size.c() = input_size.c() / groups;
+  }
+
+  /// Prints the usage statement.
+  std::ostream & print_usage(std::ostream &out) const {
+
+    out << "61_host_conv2d_reference example\n\n"
+      << "  Times the implicit GEMM and direct host references for Conv2d fprop, dgrad and wgrad.\n\n"
+      << "Options:\n\n"
+      << "  --help               If specified, displays this usage statement.\n\n"
+      << "  --n=<int>            Input tensor extent N\n"
+      << "  --h=<int>            Input tensor extent H\n"
+      << "  --w=<int>            Input tensor extent W\n"
+      << "  --c=<int>            Input tensor extent C\n"
+      << "  --k=<int>            Filter extent K\n"
+      << "  --r=<int>            Filter extent R\n"
+      << "  --s=<int>            Filter extent S\n"
+      << "  --g=<int>            Number of groups (fprop only when greater than 1)\n"
+      << "  --pad_h=<int>        Padding in H (default R / 2)\n"
+      << "  --pad_w=<int>        Padding in W (default S / 2)\n"
+      << "  --stride_h=<int>     Convolution stride in H\n"
+      << "  --stride_w=<int>     Convolution stride in W\n"
+      << "  --iterations=<int>   Number of timed runs of each reference\n\n";
+
+    return out;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns the average wall-clock time of func in milliseconds
+template <typename Func>
+double time_ms(int iterations, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int iter = 0; iter < iterations; ++iter) {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+/// Times both references for one operator and returns true if their results match
+bool profile(
+  cutlass::conv::Operator conv_operator,
+  char const *name,
+  cutlass::conv::Conv2dProblemSize const &problem_size,
+  int iterations) {
+
+  cutlass::HostTensor<Element, Layout> tensor_a(
+    cutlass::conv::implicit_gemm_tensor_a_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_b(
+    cutlass::conv::implicit_gemm_tensor_b_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_c(
+    cutlass::conv::implicit_gemm_tensor_c_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_d(tensor_c.extent(), false);
+  cutlass::HostTensor<Element, Layout> tensor_d_direct(tensor_c.extent(), false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_a.host_view(), 1, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_b.host_view(), 2, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_c.host_view(), 3, 3, -3, 0);
+
+  Element alpha = Element(1);
+  Element beta = Element(1);
+
+  double implicit_gemm_ms = time_ms(iterations, [&]() {
+    cutlass::reference::host::Conv2d<Element, Layout, Element, Layout, Element, Layout, Element>(
+      conv_operator, problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+      tensor_c.host_ref(), tensor_d.host_ref(), alpha, beta);
+  });
+
+  double direct_ms = time_ms(iterations, [&]() {
+    switch (conv_operator) {
+    case cutlass::conv::Operator::kFprop:
+      cutlass::reference::host::Conv2dFpropDirect<Element, Layout, Element, Layout, Element, Layout, Element>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta);
+      break;
+    case cutlass::conv::Operator::kDgrad:
+      cutlass::reference::host::Conv2dDgradDirect<Element, Layout, Element, Layout, Element, Layout, Element>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta);
+      break;
+    default:
+      cutlass::reference::host::Conv2dWgradDirect<Element, Layout, Element, Layout, Element, Layout, Element>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta);
+      break;
+    }
+  });
+
+  bool passed = cutlass::reference::host::TensorEquals(tensor_d.host_view(), tensor_d_direct.host_view());
+
+  std::cout << name
+    << "  implicit gemm: " << implicit_gemm_ms << " ms"
+    << "  direct: " << direct_ms << " ms"
+    << "  speedup: " << direct_ms / implicit_gemm_ms << "x"
+    << "  " << (passed ? "Passed" : "Failed") << std::endl;
+
+  return passed;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char const **args) {
+
+  Options options;
+  options.parse(argc, args);
+
+  if (options.help) {
+    options.print_usage(std::cout) << std::endl;
+    return 0;
+  }
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    options.input_size,
+    options.filter_size,
+    options.padding,
+    options.conv_stride,
+    options.dilation,
+    cutlass::conv::Mode::kCrossCorrelation,
+    1,
+    options.groups);
+
+  std::cout << "Conv2d N=" << problem_size.N << " H=" << problem_size.H << " W=" << problem_size.W
+    << " C=" << problem_size.C << " K=" << problem_size.K << " R=" << problem_size.R
+    << " S=" << problem_size.S << " P=" << problem_size.P << " Q=" << problem_size.Q
+    << " groups=" << problem_size.groups << std::endl;
+
+  bool passed = profile(cutlass::conv::Operator::kFprop, "fprop", problem_size, options.iterations);
+
+  // The direct dgrad and wgrad references do not model groups.
+  if (problem_size.groups == 1) {
+    passed = profile(cutlass::conv::Operator::kDgrad, "dgrad", problem_size, options.iterations) && passed;
+    passed = profile(cutlass::conv::Operator::kWgrad, "wgrad", problem_size, options.iterations) && passed;
+  }
+
+  return passed ? 0 : -1;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
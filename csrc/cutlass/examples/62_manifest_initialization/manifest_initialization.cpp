@@ -0,0 +1,251 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/**
+This example benchmarks the startup of the CUTLASS Library.
+
+Generated libraries register a lightweight descriptor for each configuration of kernels instead of
+constructing its operations. Registrations are indexed by kind and functional key. The operation
+table and index of the library's Singleton construct the configurations of a functional key when
+they first look it up, and a Manifest constructs all configurations passing its ManifestFilter when
+its operations are first accessed. Applications and the profiler that need a few kernels therefore
+do not pay for constructing the whole library.
+
+The example times
+
+  - Singleton::get(): creation of the singleton with the filter given by --operation, --cc,
+    --kernels and --ignore-kernels, as the first call made by an application,
+  - the first lookup: the singleton's index looking up the GEMM functional key of --element
+    operands with F32 accumulation, constructing the configurations of its element types, and,
+    averaged over fresh manifests,
+  - full initialization: registration and construction of every operation, as before, and
+  - filtered initialization: registration and construction of the operations passing the filter.
+
+  $ ./examples/62_manifest_initialization/62_manifest_initialization --operation=Gemm --cc=80 --kernels=h16816gemm*nt
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/operation_table.h"
+#include "cutlass/library/singleton.h"
+#include "cutlass/library/util.h"
+
+#include "cutlass/util/command_line.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Command line options
+struct Options {
+  bool help;
+  cutlass::library::ManifestFilter filter;
+  cutlass::library::NumericTypeID element;
+  int iterations;
+
+  Options():
+    help(false),
+    element(cutlass::library::NumericTypeID::kF16),
+    iterations(5) { }
+
+  // Parses the command line
+  void parse(int argc, char const **args) {
+    cutlass::CommandLine cmd(argc, args);
+
+    if (cmd.check_cmd_line_flag("help")) {
+      help = true;
+    }
+
+    if (cmd.check_cmd_line_flag("operation")) {
+      std::string kind;
+      cmd.get_cmd_line_argument("operation", kind);
+      filter.kinds = {cutlass::library::from_string<cutlass::library::OperationKind>(kind)};
+    }
+
+    cmd.get_cmd_line_argument("cc", filter.compute_capability);
+    cmd.get_cmd_line_arguments("kernels", filter.names);
+    cmd.get_cmd_line_arguments("ignore-kernels", filter.excluded_names);
+    cmd.get_cmd_line_argument("iterations", iterations);
+
+    if (cmd.check_cmd_line_flag("element")) {
+      std::string element_name;
+      cmd.get_cmd_line_argument("element", element_name);
+      element = cutlass::library::from_string<cutlass::library::NumericTypeID>(element_name);
+    }
+
+    iterations = std::max(iterations, 1);
+  }
+
+  /// Prints the usage statement.
+  std::ostream & print_usage(std::ostream &out) const {
+
+    out << "62_manifest_initialization example\n\n"
+      << "  Times creation of the CUTLASS Library singleton, its first lookup, and full and\n"
+      << "  filtered initialization of the manifest.\n\n"
+      << "Options:\n\n"
+      << "  --help                     If specified, displays this usage statement.\n\n"
+      << "  --operation=<kind>         Kind of operations constructed (e.g. Gemm, Conv2d)\n"
+      << "  --cc=<int>                 Compute capability; later configurations are not constructed\n"
+      << "  --kernels=<patterns>       Comma-separated name patterns of kernels constructed\n"
+      << "  --ignore-kernels=<patterns> Comma-separated name patterns of kernels not constructed\n"
+      << "  --element=<type>           Element type of the operands of the GEMM looked up (e.g. f16)\n"
+      << "  --iterations=<int>         Number of manifests initialized for each measurement\n\n";
+
+    return out;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Startup time and the resulting manifest
+struct Measurement {
+  double milliseconds;
+  size_t operation_count;
+};
+
+/// Returns the time in milliseconds taken by a function
+template <typename Function>
+double time_milliseconds(Function const &function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/// Initializes fresh manifests, constructing their operations, and returns the average wall-clock
+/// time in milliseconds
+Measurement measure(cutlass::library::ManifestFilter const &filter, int iterations) {
+
+  Measurement measurement{0, 0};
+
+  for (int iter = 0; iter < iterations; ++iter) {
+    measurement.milliseconds += time_milliseconds([&] {
+      cutlass::library::Manifest manifest(cutlass::library::Provider::kCUTLASS, filter);
+      manifest.initialize();
+      measurement.operation_count = manifest.operations().size();
+    });
+  }
+
+  measurement.milliseconds /= iterations;
+
+  return measurement;
+}
+
+/// Functional key of a GEMM with operands of the given element type and F32 accumulation
+cutlass::library::GemmFunctionalKey gemm_key(cutlass::library::NumericTypeID element) {
+  using namespace cutlass::library;
+  return GemmFunctionalKey(
+    Provider::kCUTLASS,
+    GemmKind::kUniversal,
+    NumericTypeID::kF32,
+    NumericTypeID::kF32,
+    element,
+    LayoutTypeID::kColumnMajor,
+    ComplexTransform::kNone,
+    element,
+    LayoutTypeID::kRowMajor,
+    ComplexTransform::kNone,
+    element,
+    LayoutTypeID::kColumnMajor,
+    element,
+    LayoutTypeID::kColumnMajor);
+}
+
+/// Prints a line of the report
+void print(char const *name, double milliseconds, std::string const &detail) {
+  std::cout << "  " << std::left << std::setw(26) << name << std::right << std::fixed
+    << std::setprecision(3) << std::setw(12) << milliseconds << " ms   " << detail << std::endl;
+}
+
+int main(int argc, char const **args) {
+
+  Options options;
+  options.parse(argc, args);
+
+  if (options.help) {
+    options.print_usage(std::cout) << std::endl;
+    return 0;
+  }
+
+  // The singleton is created once per process, so it is timed first and only once
+  cutlass::library::Singleton::set_filter(options.filter);
+
+  double singleton_milliseconds = time_milliseconds([] {
+    cutlass::library::Singleton::get();
+  });
+
+  cutlass::library::Singleton const &singleton = cutlass::library::Singleton::get();
+  size_t registered_count = singleton.manifest.pending_configuration_count();
+
+  size_t candidate_count = 0;
+  double lookup_milliseconds = time_milliseconds([&] {
+    auto const *entries = singleton.operation_index.find_gemm_operations(gemm_key(options.element));
+    candidate_count = entries ? entries->size() : 0;
+  });
+
+  size_t constructed_count = registered_count - singleton.manifest.pending_configuration_count();
+
+  cutlass::library::ManifestFilter no_filter;
+
+  Measurement full = measure(no_filter, options.iterations);
+  Measurement filtered = measure(options.filter, options.iterations);
+
+  std::cout << "Library initialization:\n";
+
+  print("Singleton::get()", singleton_milliseconds,
+    std::to_string(registered_count) + " configurations registered and accepted");
+
+  print("first lookup", lookup_milliseconds,
+    std::to_string(constructed_count) + " configurations constructed, " +
+    std::to_string(candidate_count) + " operations of " +
+    cutlass::library::to_string(options.element) + " GEMM");
+
+  std::cout << "Manifest initialization, averaged over " << options.iterations << " manifests:\n";
+
+  print("full initialization", full.milliseconds,
+    std::to_string(full.operation_count) + " operations");
+  print("filtered initialization", filtered.milliseconds,
+    std::to_string(filtered.operation_count) + " operations");
+
+  if (filtered.milliseconds > 0) {
+    std::cout << "  speedup of filtered over full initialization: " << std::setprecision(1)
+      << full.milliseconds / filtered.milliseconds << "x" << std::endl;
+  }
+
+  return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,296 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/**
+This example benchmarks the CuTe layout algebra in host code on layouts of dynamic shapes.
+
+With dynamic shapes, composition(), logical_divide(), complement() and coalesce() are evaluated at
+runtime on every call. Host code constructing many tiled layouts, such as a search over tilings,
+evaluates them repeatedly on the same arguments. The cached_ variants in cute/layout_cache.hpp
+memoize the results by the signature of their arguments, and a RuntimeLayout in
+cute/layout_runtime.hpp maps linear indices to offsets using a canonical, coalesced form of a layout
+with precomputed divisions.
+
+The example times, for tilings of an M x N problem,
+
+  - the layout algebra constructing each tiling, evaluated directly and through the caches, and
+  - the offsets of every element of a tile, computed by the Layout and by its RuntimeLayout.
+
+  $ ./examples/63_layout_algebra_cache/63_layout_algebra_cache --m=4096 --n=2048 --iterations=100
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include <cute/tensor.hpp>
+#include <cute/layout_cache.hpp>
+#include <cute/layout_runtime.hpp>
+
+#include "cutlass/util/command_line.h"
+
+using namespace cute;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Command line options
+struct Options {
+  bool help;
+  int m;
+  int n;
+  int iterations;
+
+  Options():
+    help(false),
+    m(4096),
+    n(2048),
+    iterations(100) { }
+
+  // Parses the command line
+  void parse(int argc, char const **args) {
+    cutlass::CommandLine cmd(argc, args);
+
+    if (cmd.check_cmd_line_flag("help")) {
+      help = true;
+    }
+
+    cmd.get_cmd_line_argument("m", m);
+    cmd.get_cmd_line_argument("n", n);
+    cmd.get_cmd_line_argument("iterations", iterations);
+
+    iterations = std::max(iterations, 1);
+  }
+
+  /// Prints the usage statement.
+  std::ostream & print_usage(std::ostream &out) const {
+
+    out << "63_layout_algebra_cache example\n\n"
+      << "  Times the CuTe layout algebra on dynamic layouts with and without memoization.\n\n"
+      << "Options:\n\n"
+      << "  --help                     If specified, displays this usage statement.\n\n"
+      << "  --m=<int>                  Rows of the tiled problem\n"
+      << "  --n=<int>                  Columns of the tiled problem\n"
+      << "  --iterations=<int>         Number of passes over all tilings\n\n";
+
+    return out;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Number of tilings constructed per pass
+static int const kTilingCount = 5 * 5 * 4;
+
+/// Algebra constructing one tiling of an M x N column-major tensor among T threads, following the
+/// cases of the CuTe core unit tests. Returns a checksum of the resulting layouts.
+template <bool Cached>
+int64_t construct_tiling(int m, int n, int tile_m, int tile_n, int threads) {
+
+  auto layout = make_layout(make_shape(m, n));
+  auto tiler = make_shape(tile_m, tile_n);
+  auto strided_tiler = make_tile(make_layout(tile_m, 2), make_layout(tile_n));
+  auto thr_tiler = make_shape(tile_m / 4, tile_n / 8);
+  auto thr_layout = make_layout(threads, tile_m);
+
+  if constexpr (Cached) {
+    auto tiled = cached_zipped_divide(layout, tiler);                          // ((TM,TN),(RM,RN))
+    auto partitioned = cached_logical_divide(make_layout(tiler), thr_tiler);   // ((TM/4,4),(TN/8,8))
+    auto strided = cached_composition(layout, strided_tiler);                  // (TM,TN)
+    auto rest = cached_complement(thr_layout, tile_m * tile_n);
+    return int64_t(size<1>(tiled)) + size(partitioned) + strided(1) + cosize(rest) + size(cached_coalesce(tiled));
+  }
+  else {
+    auto tiled = zipped_divide(layout, tiler);
+    auto partitioned = logical_divide(make_layout(tiler), thr_tiler);
+    auto strided = composition(layout, strided_tiler);
+    auto rest = complement(thr_layout, tile_m * tile_n);
+    return int64_t(size<1>(tiled)) + size(partitioned) + strided(1) + cosize(rest) + size(coalesce(tiled));
+  }
+}
+
+/// Algebra dividing a hierarchical layout of rank 3 with dynamic extents a, b and c.
+/// Returns a checksum of the resulting layouts.
+template <bool Cached>
+int64_t construct_hierarchical(int a, int b, int c) {
+
+  auto layout = make_layout(make_shape(make_shape(a, b, 2), make_shape(c, 4, b), make_shape(2, a)));
+  auto tiler = make_shape(2 * b, 2 * c, a);
+  auto gather = make_layout(make_shape(a * b, c), make_stride(1, 2 * a * b));
+
+  if constexpr (Cached) {
+    auto divided = cached_logical_divide(layout, tiler);
+    auto gathered = cached_composition(layout, gather);
+    return int64_t(size(divided)) + size(gathered) + size(cached_coalesce(divided));
+  }
+  else {
+    auto divided = logical_divide(layout, tiler);
+    auto gathered = composition(layout, gather);
+    return int64_t(size(divided)) + size(gathered) + size(coalesce(divided));
+  }
+}
+
+/// Constructs every tiling and returns the average wall-clock time per tiling in nanoseconds
+template <bool Cached, bool Hierarchical>
+double measure_algebra(Options const &options, int64_t &checksum) {
+
+  // Read the extents through volatile copies so that the compiler neither specializes the algebra
+  // to them nor hoists it out of the loop, as for extents known only at runtime
+  volatile int const problem_m = options.m;
+  volatile int const problem_n = options.n;
+  volatile int const tile_extents[] = {16, 32, 64, 128, 256};
+  volatile int const thread_counts[] = {32, 64, 128, 256};
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int iter = 0; iter < options.iterations; ++iter) {
+    for (int tile_m : tile_extents) {
+      for (int tile_n : tile_extents) {
+        for (int threads : thread_counts) {
+          if constexpr (Hierarchical) {
+            checksum += construct_hierarchical<Cached>(tile_m / 8, tile_n / 8, threads / 32);
+          }
+          else {
+            checksum += construct_tiling<Cached>(problem_m, problem_n, tile_m, tile_n, threads);
+          }
+        }
+      }
+    }
+  }
+
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() / (double(kTilingCount) * options.iterations);
+}
+
+/// Prints the time to construct tilings directly and through the caches. Returns true if both
+/// construct the same layouts.
+template <bool Hierarchical>
+bool compare_algebra(char const *name, Options const &options) {
+
+  int64_t checksum_direct = 0;
+  int64_t checksum_cached = 0;
+
+  // The first cached pass fills the caches
+  measure_algebra<true, Hierarchical>(options, checksum_cached);
+  checksum_cached = 0;
+
+  double direct_ns = measure_algebra<false, Hierarchical>(options, checksum_direct);
+  double cached_ns = measure_algebra<true, Hierarchical>(options, checksum_cached);
+
+  std::cout << "  " << name << "\n"
+    << std::fixed << std::setprecision(3)
+    << "    direct:        " << std::setw(9) << direct_ns << " ns\n"
+    << "    cached:        " << std::setw(9) << cached_ns << " ns\n";
+
+  return checksum_direct == checksum_cached;
+}
+
+/// Computes the offset of every element of the layout and returns the wall-clock time in
+/// nanoseconds per element
+template <class Layout>
+double measure_offsets(Layout const &layout, int count, int iterations, int64_t &checksum) {
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int iter = 0; iter < iterations; ++iter) {
+    for (int idx = 0; idx < count; ++idx) {
+      checksum += layout(idx);
+    }
+  }
+
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() / (double(count) * iterations);
+}
+
+/// Prints the time to compute offsets with a Layout and with its RuntimeLayout. Returns true if
+/// both compute the same offsets.
+template <class Layout>
+bool compare_offsets(char const *name, Layout const &layout, int iterations) {
+
+  RuntimeLayout<> runtime_layout(layout);
+
+  int64_t checksum_layout = 0;
+  int64_t checksum_runtime = 0;
+
+  int count = int(size(layout));
+
+  double layout_ns = measure_offsets(layout, count, iterations, checksum_layout);
+  double runtime_ns = measure_offsets(runtime_layout, count, iterations, checksum_runtime);
+
+  std::cout << "  " << name << " " << layout << " => " << runtime_layout << "\n"
+    << std::fixed << std::setprecision(3)
+    << "    Layout:        " << std::setw(9) << layout_ns << " ns\n"
+    << "    RuntimeLayout: " << std::setw(9) << runtime_ns << " ns\n";
+
+  return checksum_layout == checksum_runtime;
+}
+
+int main(int argc, char const **args) {
+
+  Options options;
+  options.parse(argc, args);
+
+  if (options.help) {
+    options.print_usage(std::cout) << std::endl;
+    return 0;
+  }
+
+  std::cout << "Layout algebra of " << kTilingCount << " tilings of a " << options.m << "x" << options.n
+    << " problem, per tiling:\n";
+
+  bool passed = compare_algebra<false>("tilings", options);
+  passed = compare_algebra<true>("hierarchical tilings", options) && passed;
+
+  if (!passed) {
+    std::cerr << "Cached layouts differ from the directly evaluated layouts." << std::endl;
+    return -1;
+  }
+
+  // Hierarchical tile layouts of the core unit cases with dynamic extents
+  auto tile_layout = make_layout(make_shape(make_shape(4, options.m / 64), make_shape(8, options.n / 256)),
+                                 make_stride(make_stride(1, 4 * options.n / 32), make_stride(4, 32)));
+  auto thr_layout = logical_divide(make_layout(make_shape(options.m / 16, options.n / 16)), make_shape(16, 8));
+
+  std::cout << "\nOffsets of every element, per element:\n";
+
+  passed = compare_offsets("tile", tile_layout, options.iterations);
+  passed = compare_offsets("partitioned tile", thr_layout, options.iterations) && passed;
+
+  if (!passed) {
+    std::cerr << "RuntimeLayout offsets differ from the Layout offsets." << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
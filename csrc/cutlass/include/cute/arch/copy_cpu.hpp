@@ -0,0 +1,104 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+#include <cute/config.hpp>
+
+#include <cute/arch/copy.hpp>
+
+// Config
+#if !defined(__CUDA_ARCH__) && !defined(__CUDACC_RTC__)
+#  if defined(__AVX__)
+#    define CUTE_ARCH_COPY_CPU_AVX_ENABLED
+#  endif
+#  if defined(__AVX512F__)
+#    define CUTE_ARCH_COPY_CPU_AVX512_ENABLED
+#  endif
+#endif
+
+#if defined(CUTE_ARCH_COPY_CPU_AVX_ENABLED) || defined(CUTE_ARCH_COPY_CPU_AVX512_ENABLED)
+#  include <immintrin.h>
+#endif
+
+namespace cute
+{
+
+//
+// Host copy operations moving one 256b or 512b vector register. Without the instruction set
+// extensions enabled by the host compiler, each operation falls back to a memcpy of the whole
+// cpu_vector register, as the fragments may have been written as another type.
+//
+
+struct CPU_U256_COPY
+{
+  using Vector = cpu_vector<uint128_t,2>;
+
+  using SRegisters = Vector[1];
+  using DRegisters = Vector[1];
+
+  CUTE_HOST_DEVICE static void
+  copy(Vector const& src,
+       Vector      & dst)
+  {
+#if defined(CUTE_ARCH_COPY_CPU_AVX_ENABLED)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data()),
+                        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src.data())));
+#else
+    cpu_store(dst, cpu_load(src));
+#endif
+  }
+};
+
+struct CPU_U512_COPY
+{
+  using Vector = cpu_vector<uint128_t,4>;
+
+  using SRegisters = Vector[1];
+  using DRegisters = Vector[1];
+
+  CUTE_HOST_DEVICE static void
+  copy(Vector const& src,
+       Vector      & dst)
+  {
+#if defined(CUTE_ARCH_COPY_CPU_AVX512_ENABLED)
+    _mm512_storeu_si512(dst.data(), _mm512_loadu_si512(src.data()));
+#elif defined(CUTE_ARCH_COPY_CPU_AVX_ENABLED)
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src.data()));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src.data() + 2));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data()), lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data() + 2), hi);
+#else
+    cpu_store(dst, cpu_load(src));
+#endif
+  }
+};
+
+} // end namespace cute
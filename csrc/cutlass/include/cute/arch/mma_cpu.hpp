@@ -0,0 +1,292 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <cute/config.hpp>
+#include <cute/arch/mma.hpp>
+#include <cute/numeric/numeric_types.hpp>
+
+// Config
+#if !defined(__CUDA_ARCH__) && !defined(__CUDACC_RTC__)
+#  if defined(__AVX2__) && defined(__FMA__)
+#    define CUTE_ARCH_MMA_CPU_AVX2_ENABLED
+#  endif
+#  if defined(__AVX512F__)
+#    define CUTE_ARCH_MMA_CPU_AVX512_ENABLED
+#  endif
+#  if defined(__AVX512BF16__)
+#    define CUTE_ARCH_MMA_CPU_AVX512_BF16_ENABLED
+#  endif
+#endif
+
+#if defined(CUTE_ARCH_MMA_CPU_AVX2_ENABLED) || defined(CUTE_ARCH_MMA_CPU_AVX512_ENABLED)
+#  include <immintrin.h>
+#endif
+
+namespace cute {
+
+//
+// Host MMA operations computing an outer product per K-step. The M-mode of A and of each
+// column of C is held in one vector register and each element of B is broadcast, so that
+// a column of C is updated by a single vector FMA. Without the instruction set extensions
+// enabled by the host compiler (e.g. -march=native), each operation falls back to scalar code.
+// The fallbacks agree with the vector instructions only up to rounding: the FP32 and FP64
+// fallbacks round each product unless the compiler contracts them to FMAs, and vdpbf16ps adds
+// the two products to the accumulator in another order and flushes denormals to zero.
+//
+// Operands are recast to cpu_vector registers from fragments that may have been written as
+// another type, so they are only read and written by cpu_load, cpu_store and unaligned vector
+// loads and stores.
+//
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// MMA 8x8x1 FP32 : one 256b FMA per column of C
+struct CPU_8x8x1_F32F32F32F32
+{
+  using Vector = cpu_vector<float,8>;
+
+  using DRegisters = Vector[8];
+  using ARegisters = Vector[1];
+  using BRegisters = float[8];
+  using CRegisters = Vector[8];
+
+  CUTE_HOST_DEVICE static void
+  fma(Vector      & d0, Vector      & d1, Vector      & d2, Vector      & d3,
+      Vector      & d4, Vector      & d5, Vector      & d6, Vector      & d7,
+      Vector const& a0,
+      float  const& b0, float  const& b1, float  const& b2, float  const& b3,
+      float  const& b4, float  const& b5, float  const& b6, float  const& b7,
+      Vector const& c0, Vector const& c1, Vector const& c2, Vector const& c3,
+      Vector const& c4, Vector const& c5, Vector const& c6, Vector const& c7)
+  {
+    Vector      * d[8] = {&d0, &d1, &d2, &d3, &d4, &d5, &d6, &d7};
+    float  const* b[8] = {&b0, &b1, &b2, &b3, &b4, &b5, &b6, &b7};
+    Vector const* c[8] = {&c0, &c1, &c2, &c3, &c4, &c5, &c6, &c7};
+
+#if defined(CUTE_ARCH_MMA_CPU_AVX2_ENABLED)
+    __m256 a = _mm256_loadu_ps(a0.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      __m256 acc = _mm256_fmadd_ps(a, _mm256_set1_ps(cpu_load(*b[n])), _mm256_loadu_ps(c[n]->data()));
+      _mm256_storeu_ps(d[n]->data(), acc);
+    }
+#else
+    Vector a = cpu_load(a0);
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      float b_n = cpu_load(*b[n]);
+      Vector acc = cpu_load(*c[n]);
+      CUTE_UNROLL
+      for (int m = 0; m < 8; ++m) {
+        acc[m] = a[m] * b_n + acc[m];
+      }
+      cpu_store(*d[n], acc);
+    }
+#endif
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// MMA 16x8x1 FP32 : one 512b FMA per column of C
+struct CPU_16x8x1_F32F32F32F32
+{
+  using Vector = cpu_vector<float,16>;
+
+  using DRegisters = Vector[8];
+  using ARegisters = Vector[1];
+  using BRegisters = float[8];
+  using CRegisters = Vector[8];
+
+  CUTE_HOST_DEVICE static void
+  fma(Vector      & d0, Vector      & d1, Vector      & d2, Vector      & d3,
+      Vector      & d4, Vector      & d5, Vector      & d6, Vector      & d7,
+      Vector const& a0,
+      float  const& b0, float  const& b1, float  const& b2, float  const& b3,
+      float  const& b4, float  const& b5, float  const& b6, float  const& b7,
+      Vector const& c0, Vector const& c1, Vector const& c2, Vector const& c3,
+      Vector const& c4, Vector const& c5, Vector const& c6, Vector const& c7)
+  {
+    Vector      * d[8] = {&d0, &d1, &d2, &d3, &d4, &d5, &d6, &d7};
+    float  const* b[8] = {&b0, &b1, &b2, &b3, &b4, &b5, &b6, &b7};
+    Vector const* c[8] = {&c0, &c1, &c2, &c3, &c4, &c5, &c6, &c7};
+
+#if defined(CUTE_ARCH_MMA_CPU_AVX512_ENABLED)
+    __m512 a = _mm512_loadu_ps(a0.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      __m512 acc = _mm512_fmadd_ps(a, _mm512_set1_ps(cpu_load(*b[n])), _mm512_loadu_ps(c[n]->data()));
+      _mm512_storeu_ps(d[n]->data(), acc);
+    }
+#elif defined(CUTE_ARCH_MMA_CPU_AVX2_ENABLED)
+    __m256 a_lo = _mm256_loadu_ps(a0.data());
+    __m256 a_hi = _mm256_loadu_ps(a0.data() + 8);
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      __m256 b_n = _mm256_set1_ps(cpu_load(*b[n]));
+      __m256 acc_lo = _mm256_fmadd_ps(a_lo, b_n, _mm256_loadu_ps(c[n]->data()));
+      __m256 acc_hi = _mm256_fmadd_ps(a_hi, b_n, _mm256_loadu_ps(c[n]->data() + 8));
+      _mm256_storeu_ps(d[n]->data(), acc_lo);
+      _mm256_storeu_ps(d[n]->data() + 8, acc_hi);
+    }
+#else
+    Vector a = cpu_load(a0);
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      float b_n = cpu_load(*b[n]);
+      Vector acc = cpu_load(*c[n]);
+      CUTE_UNROLL
+      for (int m = 0; m < 16; ++m) {
+        acc[m] = a[m] * b_n + acc[m];
+      }
+      cpu_store(*d[n], acc);
+    }
+#endif
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// MMA 8x4x1 FP64 : one 512b FMA per column of C
+struct CPU_8x4x1_F64F64F64F64
+{
+  using Vector = cpu_vector<double,8>;
+
+  using DRegisters = Vector[4];
+  using ARegisters = Vector[1];
+  using BRegisters = double[4];
+  using CRegisters = Vector[4];
+
+  CUTE_HOST_DEVICE static void
+  fma(Vector      & d0, Vector      & d1, Vector      & d2, Vector      & d3,
+      Vector const& a0,
+      double const& b0, double const& b1, double const& b2, double const& b3,
+      Vector const& c0, Vector const& c1, Vector const& c2, Vector const& c3)
+  {
+    Vector      * d[4] = {&d0, &d1, &d2, &d3};
+    double const* b[4] = {&b0, &b1, &b2, &b3};
+    Vector const* c[4] = {&c0, &c1, &c2, &c3};
+
+#if defined(CUTE_ARCH_MMA_CPU_AVX512_ENABLED)
+    __m512d a = _mm512_loadu_pd(a0.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 4; ++n) {
+      __m512d acc = _mm512_fmadd_pd(a, _mm512_set1_pd(cpu_load(*b[n])), _mm512_loadu_pd(c[n]->data()));
+      _mm512_storeu_pd(d[n]->data(), acc);
+    }
+#elif defined(CUTE_ARCH_MMA_CPU_AVX2_ENABLED)
+    __m256d a_lo = _mm256_loadu_pd(a0.data());
+    __m256d a_hi = _mm256_loadu_pd(a0.data() + 4);
+    CUTE_UNROLL
+    for (int n = 0; n < 4; ++n) {
+      __m256d b_n = _mm256_set1_pd(cpu_load(*b[n]));
+      __m256d acc_lo = _mm256_fmadd_pd(a_lo, b_n, _mm256_loadu_pd(c[n]->data()));
+      __m256d acc_hi = _mm256_fmadd_pd(a_hi, b_n, _mm256_loadu_pd(c[n]->data() + 4));
+      _mm256_storeu_pd(d[n]->data(), acc_lo);
+      _mm256_storeu_pd(d[n]->data() + 4, acc_hi);
+    }
+#else
+    Vector a = cpu_load(a0);
+    CUTE_UNROLL
+    for (int n = 0; n < 4; ++n) {
+      double b_n = cpu_load(*b[n]);
+      Vector acc = cpu_load(*c[n]);
+      CUTE_UNROLL
+      for (int m = 0; m < 8; ++m) {
+        acc[m] = a[m] * b_n + acc[m];
+      }
+      cpu_store(*d[n], acc);
+    }
+#endif
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// MMA 16x8x2 BF16 with FP32 accumulation : one 512b BF16 dot product per column of C
+//   A holds the (k0,k1) pair of each row contiguously and B holds the (k0,k1) pair of each column
+//   in one 32b register, matching the operands of vdpbf16ps.
+struct CPU_16x8x2_F32BF16BF16F32
+{
+  using VectorA = cpu_vector<bfloat16_t,32>;
+  using VectorB = cpu_vector<uint32_t,1>;
+  using VectorC = cpu_vector<float,16>;
+
+  using DRegisters = VectorC[8];
+  using ARegisters = VectorA[1];
+  using BRegisters = VectorB[8];
+  using CRegisters = VectorC[8];
+
+  CUTE_HOST_DEVICE static void
+  fma(VectorC      & d0, VectorC      & d1, VectorC      & d2, VectorC      & d3,
+      VectorC      & d4, VectorC      & d5, VectorC      & d6, VectorC      & d7,
+      VectorA const& a0,
+      VectorB const& b0, VectorB const& b1, VectorB const& b2, VectorB const& b3,
+      VectorB const& b4, VectorB const& b5, VectorB const& b6, VectorB const& b7,
+      VectorC const& c0, VectorC const& c1, VectorC const& c2, VectorC const& c3,
+      VectorC const& c4, VectorC const& c5, VectorC const& c6, VectorC const& c7)
+  {
+    VectorC      * d[8] = {&d0, &d1, &d2, &d3, &d4, &d5, &d6, &d7};
+    VectorB const* b[8] = {&b0, &b1, &b2, &b3, &b4, &b5, &b6, &b7};
+    VectorC const* c[8] = {&c0, &c1, &c2, &c3, &c4, &c5, &c6, &c7};
+
+#if defined(CUTE_ARCH_MMA_CPU_AVX512_BF16_ENABLED)
+    __m512bh a = (__m512bh)_mm512_loadu_si512(a0.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      VectorB b_k = cpu_load(*b[n]);
+      __m512bh b_n = (__m512bh)_mm512_set1_epi32(int(b_k[0]));
+      __m512 acc = _mm512_dpbf16_ps(_mm512_loadu_ps(c[n]->data()), a, b_n);
+      _mm512_storeu_ps(d[n]->data(), acc);
+    }
+#else
+    VectorA a = cpu_load(a0);
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      VectorB b_k = cpu_load(*b[n]);
+      bfloat16_t b_k0 = bfloat16_t::bitcast(uint16_t(b_k[0] & 0xffff));
+      bfloat16_t b_k1 = bfloat16_t::bitcast(uint16_t(b_k[0] >> 16));
+      VectorC acc = cpu_load(*c[n]);
+      CUTE_UNROLL
+      for (int m = 0; m < 16; ++m) {
+        acc[m] = float(a[2 * m]) * float(b_k0) + float(a[2 * m + 1]) * float(b_k1) + acc[m];
+      }
+      cpu_store(*d[n], acc);
+    }
+#endif
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cute
@@ -34,6 +34,10 @@
 
 #include <cute/numeric/integer_sequence.hpp>
 
+#if !defined(__CUDACC_RTC__)
+#include <cstring>
+#endif
+
 #if defined(__clang__) && defined(__CUDA__)
   //  __cvta_generic_to_shared was added in Clang 14: https://reviews.llvm.org/D111665
   #if __clang_major__ >= 14
@@ -132,6 +136,45 @@ cast_smem_ptr_to_uint(void const* const ptr)
 #endif
 }
 
+/// Vector register of host MMA and copy operations. Operands are recast to it from fragments of
+/// other element types, so it may alias any type, as the vector types of <immintrin.h> do.
+template <class T, int N>
+struct CUTE_MAY_ALIAS cpu_vector
+{
+  using value_type = T;
+
+  T data_[N];
+
+  CUTE_HOST_DEVICE static constexpr int size() { return N; }
+
+  CUTE_HOST_DEVICE T      * data()       { return data_; }
+  CUTE_HOST_DEVICE T const* data() const { return data_; }
+
+  CUTE_HOST_DEVICE T      & operator[](int i)       { return data_[i]; }
+  CUTE_HOST_DEVICE T const& operator[](int i) const { return data_[i]; }
+};
+
+/// Reads a register of host MMA and copy operations. Fragments may have been written as another
+/// type, e.g. as uint128_t by the vectorizing copy(), so registers are only accessed by memcpy.
+template <class T>
+CUTE_HOST_DEVICE
+T
+cpu_load(T const& reg)
+{
+  T val;
+  memcpy(&val, &reg, sizeof(T));
+  return val;
+}
+
+/// Writes a register of host MMA and copy operations
+template <class T>
+CUTE_HOST_DEVICE
+void
+cpu_store(T& reg, T const& val)
+{
+  memcpy(&reg, &val, sizeof(T));
+}
+
 namespace detail {
 
 //
@@ -98,6 +98,16 @@
 #  endif
 #endif
 
+// Exempts accesses through a type from type-based alias analysis, as for register fragments
+// recast from tensors of another element type in host code.
+#if ! defined(CUTE_MAY_ALIAS)
+#  if defined(__GNUC__) || defined(__clang__)
+#    define CUTE_MAY_ALIAS __attribute__((__may_alias__))
+#  else
+#    define CUTE_MAY_ALIAS
+#  endif
+#endif
+
 #if defined(_MSC_VER)
 // Provides support for alternative operators 'and', 'or', and 'not'
 #  include <iso646.h>
@@ -0,0 +1,311 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+#include <cute/config.hpp>
+
+#include <cute/layout.hpp>
+
+/* This implements memoization of the layout algebra for host code constructing many layouts of
+ * dynamic shapes or strides, such as a search over tilings. With dynamic shapes, functions such as
+ * composition() and logical_divide() are evaluated at runtime on every call. The cached_ variants
+ * below return the same layouts, looking them up by the signature of their arguments:
+ * the argument types select a cache and the values of their dynamic integers are its key.
+ *
+ * Each thread holds its own caches, open-addressed hash tables that are cleared once they hold
+ * kLayoutCacheCapacity results. Arguments that are static, or that hold dynamic values other than
+ * integers, are passed to the layout function directly.
+ *
+ * A lookup costs the hashing and comparison of every dynamic integer of the arguments. Optimized
+ * builds evaluate the algebra of flat layouts of rank two faster than that, so the caches pay off for
+ * hierarchical layouts and for unoptimized builds. The example 63_layout_algebra_cache measures both.
+ */
+
+#if !defined(__CUDACC_RTC__)
+
+#include <array>
+#include <vector>
+
+namespace cute
+{
+
+// Number of results held by each cache before it is cleared
+static constexpr int kLayoutCacheCapacity = 1024;
+
+namespace detail {
+
+// Number of dynamic integers in the signature of a value, or -1 if it cannot be cached
+template <class T>
+constexpr int
+layout_signature_size();
+
+// Total number of dynamic integers in the signatures of values, or -1 if one cannot be cached
+template <class... Ts>
+constexpr int
+signature_size_sum()
+{
+  int sizes[] = {0, layout_signature_size<Ts>()...};
+  int result = 0;
+  for (int size : sizes) {
+    if (size < 0) {
+      return -1;
+    }
+    result += size;
+  }
+  return result;
+}
+
+template <class T, int... I>
+constexpr int
+tuple_signature_size(seq<I...>)
+{
+  return signature_size_sum<remove_cvref_t<tuple_element_t<I,T>>...>();
+}
+
+// Layouts other than Layout<Shape,Stride>, e.g. ComposedLayout, are not cached
+template <class T>
+struct layout_signature_size_of : C<-1> {};
+
+template <class Shape, class Stride>
+struct layout_signature_size_of<Layout<Shape,Stride>>
+    : C<signature_size_sum<Shape,Stride>()> {};
+
+template <class T>
+constexpr int
+layout_signature_size()
+{
+  if constexpr (is_static<T>::value) {
+    return 0;
+  } else if constexpr (is_std_integral<T>::value) {
+    return 1;
+  } else if constexpr (is_layout<T>::value) {
+    return layout_signature_size_of<T>::value;
+  } else if constexpr (is_tuple<T>::value) {
+    return tuple_signature_size<T>(make_seq<tuple_size<T>::value>{});
+  } else {
+    return -1;
+  }
+}
+
+// Writes the dynamic integers of a value to the signature
+template <class T>
+CUTE_HOST
+void
+append_layout_signature(int64_t*& signature, T const& t)
+{
+  if constexpr (is_static<T>::value) {
+    // Defined by the type
+  } else if constexpr (is_std_integral<T>::value) {
+    *signature++ = int64_t(t);
+  } else if constexpr (is_layout<T>::value) {
+    append_layout_signature(signature, t.shape());
+    append_layout_signature(signature, t.stride());
+  } else {
+    for_each(t, [&](auto const& e) { append_layout_signature(signature, e); });
+  }
+}
+
+template <size_t N>
+CUTE_HOST
+uint64_t
+layout_signature_hash(std::array<int64_t,N> const& signature)
+{
+  // Independent products of each value with a multiplier of its position, then a final mix
+  uint64_t result = 0;
+  for (size_t i = 0; i < N; ++i) {
+    result += uint64_t(signature[i]) * (0x9e3779b97f4a7c15ull + 2 * i);
+  }
+  result ^= result >> 32;
+  result *= 0xd6e8feb86659fd93ull;
+  return result ^ (result >> 32);
+}
+
+// Hash table of results by signature with linear probing, at most half full
+template <class Signature, class Result>
+struct LayoutCache
+{
+  struct Entry {
+    Signature signature;
+    Result result;
+    bool valid = false;
+  };
+
+  static constexpr size_t kSlots = 2 * size_t(kLayoutCacheCapacity);
+
+  std::vector<Entry> entries;
+  int count = 0;
+
+  // Returns the entry holding the signature, or the empty entry it would be inserted into
+  CUTE_HOST
+  Entry&
+  find(Signature const& signature)
+  {
+    if (entries.empty()) {
+      entries.resize(kSlots);
+    }
+    size_t idx = layout_signature_hash(signature) % kSlots;
+    while (entries[idx].valid && entries[idx].signature != signature) {
+      idx = (idx + 1) % kSlots;
+    }
+    return entries[idx];
+  }
+
+  template <class Fn>
+  CUTE_HOST
+  Result const&
+  find_or_insert(Signature const& signature, Fn const& fn)
+  {
+    Entry* entry = &find(signature);
+    if (!entry->valid) {
+      if (count == kLayoutCacheCapacity) {
+        for (Entry& e : entries) {
+          e.valid = false;
+        }
+        count = 0;
+        entry = &find(signature);
+      }
+      entry->signature = signature;
+      entry->result = fn();
+      entry->valid = true;
+      ++count;
+    }
+    return entry->result;
+  }
+};
+
+// Evaluates Fn on the arguments, or returns the result of an earlier evaluation on the same arguments
+template <class Fn, class... Args>
+CUTE_HOST
+auto
+memoize_layout_function(Args const&... args)
+{
+  constexpr int N = signature_size_sum<Args...>();
+
+  if constexpr (N <= 0) {
+    return Fn{}(args...);
+  } else {
+    using Result    = decltype(Fn{}(args...));
+    using Signature = std::array<int64_t,N>;
+
+    thread_local LayoutCache<Signature, Result> cache;
+
+    Signature signature;
+    int64_t* ptr = signature.data();
+    (append_layout_signature(ptr, args), ...);
+
+    return cache.find_or_insert(signature, [&]() { return Fn{}(args...); });
+  }
+}
+
+// Function objects selecting the cache of each layout function
+struct composition_fn {
+  template <class... Args>
+  CUTE_HOST auto operator()(Args const&... args) const { return composition(args...); }
+};
+
+struct complement_fn {
+  template <class... Args>
+  CUTE_HOST auto operator()(Args const&... args) const { return complement(args...); }
+};
+
+struct coalesce_fn {
+  template <class... Args>
+  CUTE_HOST auto operator()(Args const&... args) const { return coalesce(args...); }
+};
+
+struct logical_divide_fn {
+  template <class... Args>
+  CUTE_HOST auto operator()(Args const&... args) const { return logical_divide(args...); }
+};
+
+struct zipped_divide_fn {
+  template <class... Args>
+  CUTE_HOST auto operator()(Args const&... args) const { return zipped_divide(args...); }
+};
+
+struct logical_product_fn {
+  template <class... Args>
+  CUTE_HOST auto operator()(Args const&... args) const { return logical_product(args...); }
+};
+
+} // end namespace detail
+
+template <class... Args>
+CUTE_HOST
+auto
+cached_composition(Args const&... args)
+{
+  return detail::memoize_layout_function<detail::composition_fn>(args...);
+}
+
+template <class... Args>
+CUTE_HOST
+auto
+cached_complement(Args const&... args)
+{
+  return detail::memoize_layout_function<detail::complement_fn>(args...);
+}
+
+template <class... Args>
+CUTE_HOST
+auto
+cached_coalesce(Args const&... args)
+{
+  return detail::memoize_layout_function<detail::coalesce_fn>(args...);
+}
+
+template <class... Args>
+CUTE_HOST
+auto
+cached_logical_divide(Args const&... args)
+{
+  return detail::memoize_layout_function<detail::logical_divide_fn>(args...);
+}
+
+template <class... Args>
+CUTE_HOST
+auto
+cached_zipped_divide(Args const&... args)
+{
+  return detail::memoize_layout_function<detail::zipped_divide_fn>(args...);
+}
+
+template <class... Args>
+CUTE_HOST
+auto
+cached_logical_product(Args const&... args)
+{
+  return detail::memoize_layout_function<detail::logical_product_fn>(args...);
+}
+
+} // end namespace cute
+
+#endif // !defined(__CUDACC_RTC__)
@@ -0,0 +1,232 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+#include <cute/config.hpp>
+
+#include <cute/layout.hpp>
+
+#include <cutlass/fast_math.h>
+
+/* This implements a RuntimeLayout, a flat layout of runtime rank in canonical form:
+ * the modes of a Layout are flattened, modes of size one are removed and adjacent modes
+ * that are contiguous are merged, as in coalesce(). Layouts of the same function therefore have
+ * the same RuntimeLayout, which can serve as a key, and mapping a linear index to an offset takes
+ * one precomputed division per remaining mode rather than a division by every mode of the
+ * original shape.
+ *
+ * A RuntimeLayout is useful for host code evaluating layouts of dynamic shapes many times, for
+ * example when enumerating the offsets of a tile. Layouts of static shapes are already evaluated
+ * at compile time and should be used directly.
+ */
+
+namespace cute
+{
+
+// MaxRank bounds the rank of the flattened layout, before modes are removed or merged
+template <int MaxRank = 8>
+struct RuntimeLayout
+{
+  static constexpr int kMaxRank = MaxRank;
+
+  // Number of modes after canonicalization
+  int rank = 0;
+
+  // Extent and stride of each mode
+  int     shape[MaxRank]  = {};
+  int64_t stride[MaxRank] = {};
+
+  // Precomputed division by the extent of each mode but the last
+  cutlass::FastDivmod divmod[MaxRank];
+
+  RuntimeLayout() = default;
+
+  template <class Shape, class Stride>
+  CUTE_HOST_DEVICE explicit
+  RuntimeLayout(Layout<Shape,Stride> const& layout)
+  {
+    auto flat_layout = flatten(layout);
+    CUTE_STATIC_ASSERT_V(cute::rank(flat_layout) <= Int<MaxRank>{},
+                         "RuntimeLayout: rank of the flattened layout exceeds MaxRank.");
+    for_each(make_seq<decltype(cute::rank(flat_layout))::value>{}, [&](auto i) {
+      append_mode(int(cute::shape<i>(flat_layout)), int64_t(cute::stride<i>(flat_layout)));
+    });
+    for (int i = 0; i + 1 < rank; ++i) {
+      divmod[i] = cutlass::FastDivmod(shape[i] > 0 ? shape[i] : 1);
+    }
+  }
+
+  // Number of indices in the domain
+  CUTE_HOST_DEVICE
+  int
+  size() const
+  {
+    int result = 1;
+    for (int i = 0; i < rank; ++i) {
+      result *= shape[i];
+    }
+    return result;
+  }
+
+  // One past the largest offset in the codomain. Modes of negative stride lower the smallest
+  // offset rather than raise the largest one, so only positive strides contribute.
+  CUTE_HOST_DEVICE
+  int64_t
+  cosize() const
+  {
+    int64_t result = 1;
+    for (int i = 0; i < rank; ++i) {
+      if (stride[i] > 0) {
+        result += int64_t(shape[i] - 1) * stride[i];
+      }
+    }
+    return result;
+  }
+
+  // Maps a linear index to an offset
+  CUTE_HOST_DEVICE
+  int64_t
+  operator()(int idx) const
+  {
+    int64_t offset = 0;
+    for (int i = 0; i + 1 < rank; ++i) {
+      int quotient, remainder;
+      divmod[i](quotient, remainder, idx);
+      offset += remainder * stride[i];
+      idx = quotient;
+    }
+    if (rank > 0) {
+      offset += idx * stride[rank - 1];
+    }
+    return offset;
+  }
+
+  CUTE_HOST_DEVICE
+  bool
+  operator==(RuntimeLayout const& other) const
+  {
+    if (rank != other.rank) {
+      return false;
+    }
+    for (int i = 0; i < rank; ++i) {
+      if (shape[i] != other.shape[i] || stride[i] != other.stride[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  CUTE_HOST_DEVICE
+  bool
+  operator!=(RuntimeLayout const& other) const
+  {
+    return !(*this == other);
+  }
+
+  // Hash of the canonical form
+  CUTE_HOST_DEVICE
+  uint64_t
+  hash() const
+  {
+    uint64_t result = 0;
+    for (int i = 0; i < rank; ++i) {
+      result = (result ^ uint64_t(shape[i])) * 0x9e3779b97f4a7c15ull;
+      result ^= result >> 32;
+      result = (result ^ uint64_t(stride[i])) * 0x9e3779b97f4a7c15ull;
+      result ^= result >> 32;
+    }
+    return result;
+  }
+
+private:
+
+  // Appends a mode, merging it with the previous mode as coalesce() does
+  CUTE_HOST_DEVICE
+  void
+  append_mode(int s, int64_t d)
+  {
+    if (s == 1) {
+      return;
+    }
+    if (rank > 0 && int64_t(shape[rank - 1]) * stride[rank - 1] == d) {
+      shape[rank - 1] *= s;
+      return;
+    }
+    assert(rank < MaxRank && "RuntimeLayout: rank of the canonical form exceeds MaxRank.");
+    shape[rank]  = s;
+    stride[rank] = d;
+    ++rank;
+  }
+};
+
+template <class Shape, class Stride>
+CUTE_HOST_DEVICE
+auto
+make_runtime_layout(Layout<Shape,Stride> const& layout)
+{
+  return RuntimeLayout<>(layout);
+}
+
+//
+// Display utilities
+//
+
+template <int MaxRank>
+CUTE_HOST_DEVICE void print(RuntimeLayout<MaxRank> const& layout)
+{
+  printf("(");
+  for (int i = 0; i < layout.rank; ++i) {
+    printf(i ? ",%d" : "%d", layout.shape[i]);
+  }
+  printf("):(");
+  for (int i = 0; i < layout.rank; ++i) {
+    printf(i ? ",%lld" : "%lld", static_cast<long long>(layout.stride[i]));
+  }
+  printf(")");
+}
+
+#if !defined(__CUDACC_RTC__)
+template <int MaxRank>
+CUTE_HOST std::ostream& operator<<(std::ostream& os, RuntimeLayout<MaxRank> const& layout)
+{
+  os << "(";
+  for (int i = 0; i < layout.rank; ++i) {
+    os << (i ? "," : "") << layout.shape[i];
+  }
+  os << "):(";
+  for (int i = 0; i < layout.rank; ++i) {
+    os << (i ? "," : "") << layout.stride[i];
+  }
+  return os << ")";
+}
+#endif
+
+} // end namespace cute
@@ -65,6 +65,33 @@ except ImportError:
 ###################################################################################################
 _LOGGER = logging.getLogger(__name__)
 
+# Element types the CUTLASS Library names differently from DataTypeNames
+_LibraryDataTypeNames = {
+  DataType.e4m3: "fe4m3",
+  DataType.e5m2: "fe5m2",
+}
+
+# GEMM kinds whose library descriptions carry the element types of the generator's operands
+_KeyedGemmKinds = [GemmKind.Gemm, GemmKind.Universal, GemmKind.Universal3x, GemmKind.Grouped]
+
+def ConfigurationKey(kind, operation):
+  """
+  Returns the functional key under which the manifest registers the configuration of an
+  operation, as cutlass::library::configuration_key() forms it from the operation's description:
+  the element types of its A, B and C operands. Returns None if the description of the operation
+  may name other types, as for complex and planar complex kernels.
+  """
+  if kind not in (OperationKind.Gemm, OperationKind.Conv2d, OperationKind.Conv3d):
+    return None
+  if kind == OperationKind.Gemm and operation.gemm_kind not in _KeyedGemmKinds:
+    return None
+  if hasattr(operation, 'is_complex') and operation.is_complex():
+    return None
+
+  elements = (operation.A.element, operation.B.element, operation.C.element)
+  return ','.join(_LibraryDataTypeNames.get(element, DataTypeNames[element]) for element in elements)
+
+
 
 class EmitOperationKindAll:
   """
@@ -245,7 +272,10 @@ namespace library {
 void initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(Manifest &manifest) {
 """
     self.configuration_prototype_template = "void initialize_${configuration_name}(Manifest &manifest);\n"
-    self.configuration_template = "  initialize_${configuration_name}(manifest);\n"
+    self.configuration_template = """  manifest.register_configuration({
+    ${operation_kind}, ${min_cc}, "${operation_names}", initialize_${configuration_name},
+    "${functional_keys}"});
+"""
     self.subclass_call_template = "  initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(manifest);\n"
     self.subclass_prototype_template = "void initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(Manifest &manifest);\n"
     self.epilogue_template ="""}
@@ -329,7 +359,27 @@ void initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(Ma
                     str(configuration_emitter.configuration_path))
       self.source_files[extended_name].append(configuration_emitter.configuration_path)
 
-    self.subclass_configurations[extended_name].append(configuration_name)
+    # Operations of the configuration are constructed when the manifest is first used, or when
+    # an operation table first looks up their functional key. The registration carries what the
+    # manifest filters and indexes them by. Without a key for every operation, the configuration
+    # is constructed by the first lookup of its kind.
+    if self.kind == OperationKind.Gemm and operations[0].gemm_kind == GemmKind.Sparse:
+      operation_kind = 'cutlass::library::OperationKind::kSparseGemm'
+    else:
+      operation_kind = OperationKindTag[self.kind]
+
+    functional_keys = [ConfigurationKey(self.kind, operation) for operation in operations]
+    if None in functional_keys:
+      functional_keys = []
+    functional_keys = sorted(set(functional_keys))
+
+    self.subclass_configurations[extended_name].append({
+      'configuration_name': configuration_name,
+      'operation_kind': operation_kind,
+      'min_cc': str(self.min_cc),
+      'operation_names': ','.join(operation.procedural_name() for operation in operations),
+      'functional_keys': ';'.join(functional_keys)
+    })
     self.subclass_files[extended_name].write(SubstituteTemplate(self.configuration_prototype_template, {'configuration_name': configuration_name} ))
 
   #
@@ -361,9 +411,7 @@ void initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(Ma
 
       for configuration in self.subclass_configurations[subclass_name]:
         subclass_file.write(
-          SubstituteTemplate(self.configuration_template, {
-            'configuration_name': configuration
-          }))
+          SubstituteTemplate(self.configuration_template, configuration))
 
       subclass_file.write(self.epilogue_template)
       subclass_file.close()
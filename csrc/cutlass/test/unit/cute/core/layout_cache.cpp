@@ -0,0 +1,93 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "cutlass_unit_test.h"
+
+#include <cutlass/trace.h>
+
+#include <thread>
+
+#include <cute/tensor.hpp>
+#include <cute/layout_cache.hpp>
+
+using namespace cute;
+
+template <class Result, class Expected>
+void
+test_cached_result(Result const& result, Expected const& expected)
+{
+  CUTLASS_TRACE_HOST(result << "  ==  " << expected);
+
+  static_assert(is_same<Result, Expected>::value, "Cached and evaluated layouts differ in type");
+  EXPECT_EQ(shape(result), shape(expected));
+  EXPECT_EQ(stride(result), stride(expected));
+}
+
+TEST(CuTe_core, Layout_cache)
+{
+  CUTLASS_TRACE_HOST("-------------------------------");
+  CUTLASS_TRACE_HOST("LAYOUT CACHE"                   );
+  CUTLASS_TRACE_HOST("-------------------------------");
+
+  // Evaluate each function twice with the same and once with different dynamic values
+  for (int repeat = 0; repeat < 2; ++repeat) {
+    for (int n : {4, 6, 4}) {
+      auto a = make_layout(make_shape(12, make_shape(n, 8)), make_stride(_1{}, make_stride(12, 12 * n)));
+      auto b = make_layout(make_shape(4, 3), make_stride(_3{}, _1{}));
+
+      test_cached_result(cached_composition(a, b), composition(a, b));
+      test_cached_result(cached_composition(a, make_shape(6, n)), composition(a, make_shape(6, n)));
+      test_cached_result(cached_coalesce(a), coalesce(a));
+      test_cached_result(cached_coalesce(a, Step<_1,_1>{}), coalesce(a, Step<_1,_1>{}));
+      test_cached_result(cached_complement(b, 12 * n), complement(b, 12 * n));
+      test_cached_result(cached_complement(make_layout(n, 2)), complement(make_layout(n, 2)));
+
+      auto c = make_layout(make_shape(16, 8 * n));
+      auto tiler = make_tile(make_layout(4, 2), make_layout(n));
+      test_cached_result(cached_logical_divide(c, make_shape(4, n)), logical_divide(c, make_shape(4, n)));
+      test_cached_result(cached_logical_divide(c, tiler), logical_divide(c, tiler));
+      test_cached_result(cached_zipped_divide(c, make_shape(4, n)), zipped_divide(c, make_shape(4, n)));
+      test_cached_result(cached_logical_product(make_layout(n), make_layout(3, 2)),
+                         logical_product(make_layout(n), make_layout(3, 2)));
+    }
+  }
+
+  // Static layouts are evaluated directly
+  test_cached_result(cached_composition(Layout<Shape<_4,_8>>{}, Layout<_8,_4>{}),
+                     composition(Layout<Shape<_4,_8>>{}, Layout<_8,_4>{}));
+
+  // Each thread holds its own cache
+  std::thread thread([]() {
+    auto a = make_layout(make_shape(12, 8));
+    test_cached_result(cached_logical_divide(a, make_shape(4, 2)), logical_divide(a, make_shape(4, 2)));
+  });
+  thread.join();
+}
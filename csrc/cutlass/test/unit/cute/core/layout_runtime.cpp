@@ -0,0 +1,107 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "cutlass_unit_test.h"
+
+#include <algorithm>
+
+#include <cutlass/trace.h>
+
+#include <cute/tensor.hpp>
+#include <cute/layout_runtime.hpp>
+
+using namespace cute;
+
+template <class Layout>
+void
+test_runtime_layout(Layout const& layout)
+{
+  RuntimeLayout<> runtime_layout(layout);
+
+  CUTLASS_TRACE_HOST("test_runtime_layout()");
+  CUTLASS_TRACE_HOST(layout << "  =>  " << runtime_layout);
+
+  EXPECT_EQ(runtime_layout.size(), int(size(layout)));
+  EXPECT_EQ(runtime_layout.cosize(), int64_t(cosize(layout)));
+
+  // Test that the canonical form is the flattened coalesced layout
+  auto coalesced = coalesce(flatten(layout));
+  EXPECT_EQ(runtime_layout, RuntimeLayout<>(coalesced));
+  EXPECT_EQ(runtime_layout.hash(), RuntimeLayout<>(coalesced).hash());
+
+  // Test that the RuntimeLayout maps every index as the layout does
+  for (int i = 0; i < size(layout); ++i) {
+    EXPECT_EQ(runtime_layout(i), int64_t(layout(i)));
+  }
+}
+
+TEST(CuTe_core, RuntimeLayout)
+{
+  CUTLASS_TRACE_HOST("-------------------------------");
+  CUTLASS_TRACE_HOST("RUNTIME LAYOUT"                 );
+  CUTLASS_TRACE_HOST("-------------------------------");
+
+  test_runtime_layout(make_layout(1));
+  test_runtime_layout(make_layout(7, 3));
+  test_runtime_layout(make_layout(make_shape(8, 4)));
+  test_runtime_layout(make_layout(make_shape(8, 4), LayoutRight{}));
+  test_runtime_layout(make_layout(make_shape(5, 1, 7), make_stride(7, 99, 1)));
+  test_runtime_layout(make_layout(make_shape(4, 3), make_stride(0, 1)));
+  test_runtime_layout(make_layout(make_shape(4, 3, 2), make_stride(0, 0, 5)));
+  test_runtime_layout(make_layout(make_shape(make_shape(2, 3), make_shape(4, 5)),
+                                  make_stride(make_stride(1, 40), make_stride(2, 8))));
+  test_runtime_layout(make_layout(make_shape(12, make_shape(4, 8)),
+                                  make_stride(_1{}, make_stride(12, 48))));
+  test_runtime_layout(Layout<Shape<Shape<_2,_4>,_8>, Stride<Stride<_8,_1>,_16>>{});
+
+  // Layouts of the same function have the same canonical form
+  EXPECT_EQ(RuntimeLayout<>(make_layout(make_shape(2, 4, 8))), RuntimeLayout<>(make_layout(64)));
+  EXPECT_NE(RuntimeLayout<>(make_layout(make_shape(2, 4, 8))),
+            RuntimeLayout<>(make_layout(make_shape(2, 4, 8), LayoutRight{})));
+  EXPECT_EQ(RuntimeLayout<>(make_layout(make_shape(1, 6, 1), make_stride(5, 2, 3))),
+            RuntimeLayout<>(make_layout(6, 2)));
+}
+
+TEST(CuTe_core, RuntimeLayout_negative_stride)
+{
+  auto layout = make_layout(make_shape(4, 3, 5), make_stride(-1, 4, -12));
+  RuntimeLayout<> runtime_layout(layout);
+
+  int64_t max_offset = 0;
+  for (int i = 0; i < size(layout); ++i) {
+    EXPECT_EQ(runtime_layout(i), int64_t(layout(i)));
+    max_offset = std::max(max_offset, int64_t(layout(i)));
+  }
+
+  // One past the largest offset, which the modes of negative stride do not raise
+  EXPECT_EQ(runtime_layout.cosize(), max_offset + 1);
+  EXPECT_EQ(runtime_layout.cosize(), 9);
+}
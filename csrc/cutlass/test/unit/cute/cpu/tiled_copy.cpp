@@ -0,0 +1,93 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "cutlass_unit_test.h"
+
+#include <vector>
+
+#include <cute/tensor.hpp>
+#include <cute/atom/copy_atom.hpp>
+
+using namespace cute;
+
+namespace {
+
+template <class CopyOp, class Element, class ValLayout, class TensorLayout>
+void
+test_tiled_copy(ValLayout const& val_layout, TensorLayout const& layout)
+{
+  std::vector<Element> src_data(cosize(layout));
+  std::vector<Element> dst_data(cosize(layout), Element(0));
+  for (size_t i = 0; i < src_data.size(); ++i) {
+    src_data[i] = Element(int(i % 251) - 125);
+  }
+
+  Tensor src = make_tensor(src_data.data(), layout);
+  Tensor dst = make_tensor(dst_data.data(), layout);
+
+  auto tiled_copy = make_tiled_copy(Copy_Atom<CopyOp, Element>{}, Layout<Shape<_1,_1>>{}, val_layout);
+  auto thr_copy = tiled_copy.get_slice(0);
+
+  Tensor tSsrc = thr_copy.partition_S(src);           // (CPY,CPY_M,CPY_N)
+  Tensor tDdst = thr_copy.partition_D(dst);           // (CPY,CPY_M,CPY_N)
+
+  copy(tiled_copy, tSsrc, tDdst);
+
+  for (int i = 0; i < int(size(layout)); ++i) {
+    EXPECT_EQ(dst(i), src(i)) << "i=" << i;
+  }
+}
+
+} // end namespace
+
+TEST(CuTe_cpu, TiledCopy_U256)
+{
+  // Eight contiguous floats per copy along the M-major mode
+  test_tiled_copy<CPU_U256_COPY, float>(
+    Layout<Shape<_8,_1>>{}, make_layout(make_shape(_64{}, _32{})));
+
+  // Sixteen contiguous halves per copy along the N-major mode
+  test_tiled_copy<CPU_U256_COPY, half_t>(
+    Layout<Shape<_1,_16>, Stride<_16,_1>>{}, make_layout(make_shape(_32{}, _64{}), LayoutRight{}));
+
+  // Strided leading dimension
+  test_tiled_copy<CPU_U256_COPY, double>(
+    Layout<Shape<_4,_1>>{}, make_layout(make_shape(_16{}, _8{}), make_stride(_1{}, Int<20>{})));
+}
+
+TEST(CuTe_cpu, TiledCopy_U512)
+{
+  test_tiled_copy<CPU_U512_COPY, float>(
+    Layout<Shape<_16,_1>>{}, make_layout(make_shape(_64{}, _32{})));
+
+  test_tiled_copy<CPU_U512_COPY, int8_t>(
+    Layout<Shape<_64,_1>>{}, make_layout(make_shape(_128{}, _4{})));
+}
@@ -0,0 +1,215 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "cutlass_unit_test.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <cute/tensor.hpp>
+#include <cute/atom/mma_atom.hpp>
+
+using namespace cute;
+
+namespace {
+
+// Computes C += A * B^T with a single-threaded TiledMMA, staging each operand in fragments
+template <class MMA_Op, class TensorA, class TensorB, class TensorC>
+void
+tiled_mma_gemm(TensorA const& A, TensorB const& B, TensorC& C)
+{
+  TiledMMA tiled_mma = make_tiled_mma(MMA_Op{});
+  auto thr_mma = tiled_mma.get_slice(0);
+
+  Tensor tCgA = thr_mma.partition_A(A);               // (MMA,MMA_M,MMA_K)
+  Tensor tCgB = thr_mma.partition_B(B);               // (MMA,MMA_N,MMA_K)
+  Tensor tCgC = thr_mma.partition_C(C);               // (MMA,MMA_M,MMA_N)
+
+  Tensor tCrA = thr_mma.partition_fragment_A(A);
+  Tensor tCrB = thr_mma.partition_fragment_B(B);
+  Tensor tCrC = thr_mma.partition_fragment_C(C);
+
+  copy(tCgA, tCrA);
+  copy(tCgB, tCrB);
+  copy(tCgC, tCrC);
+
+  gemm(tiled_mma, tCrC, tCrA, tCrB, tCrC);
+
+  copy(tCrC, tCgC);
+}
+
+// Compares against a double precision reference. The error may not exceed epsilon times the
+// sum of the magnitudes of the terms accumulated into each element.
+template <class MMA_Op, class ElementA, class ElementAccumulator, class LayoutA, class LayoutB,
+          class Distribution>
+void
+test_tiled_mma(LayoutA const& layout_A, LayoutB const& layout_B, Distribution dist, double epsilon)
+{
+  auto M = size<0>(layout_A);
+  auto N = size<0>(layout_B);
+  auto K = size<1>(layout_A);
+  auto layout_C = make_layout(make_shape(M, N));
+
+  std::mt19937 rng(2024);
+
+  std::vector<ElementA> A_data(cosize(layout_A));
+  std::vector<ElementA> B_data(cosize(layout_B));
+  std::vector<ElementAccumulator> C_data(cosize(layout_C));
+  for (auto &a : A_data) { a = ElementA(dist(rng)); }
+  for (auto &b : B_data) { b = ElementA(dist(rng)); }
+  for (auto &c : C_data) { c = ElementAccumulator(dist(rng)); }
+
+  Tensor A = make_tensor(A_data.data(), layout_A);
+  Tensor B = make_tensor(B_data.data(), layout_B);
+  Tensor C = make_tensor(C_data.data(), layout_C);
+
+  std::vector<double> reference(size(layout_C));
+  std::vector<double> magnitude(size(layout_C));
+  for (int m = 0; m < int(M); ++m) {
+    for (int n = 0; n < int(N); ++n) {
+      double accum = double(C(m,n));
+      double accum_abs = std::abs(accum);
+      for (int k = 0; k < int(K); ++k) {
+        accum += double(A(m,k)) * double(B(n,k));
+        accum_abs += std::abs(double(A(m,k)) * double(B(n,k)));
+      }
+      reference[m + n * int(M)] = accum;
+      magnitude[m + n * int(M)] = accum_abs;
+    }
+  }
+
+  tiled_mma_gemm<MMA_Op>(A, B, C);
+
+  for (int m = 0; m < int(M); ++m) {
+    for (int n = 0; n < int(N); ++n) {
+      EXPECT_NEAR(double(C(m,n)), reference[m + n * int(M)], epsilon * magnitude[m + n * int(M)])
+        << "m=" << m << " n=" << n;
+    }
+  }
+}
+
+// Exact in every element type and in any order of accumulation
+std::uniform_int_distribution<int> small_integers(-4, 4);
+
+// Rounded differently by the vector instructions and by the scalar fallbacks
+std::uniform_real_distribution<double> reals(-1.0, 1.0);
+
+} // end namespace
+
+TEST(CuTe_cpu, TiledMma_8x8x1_F32F32F32F32)
+{
+  // M-major A and B
+  test_tiled_mma<CPU_8x8x1_F32F32F32F32, float, float>(
+    make_layout(make_shape(_64{}, _16{})),
+    make_layout(make_shape(_32{}, _16{})), small_integers, 0);
+
+  // K-major A and B
+  test_tiled_mma<CPU_8x8x1_F32F32F32F32, float, float>(
+    make_layout(make_shape(_64{}, _16{}), LayoutRight{}),
+    make_layout(make_shape(_32{}, _16{}), LayoutRight{}), small_integers, 0);
+}
+
+TEST(CuTe_cpu, TiledMma_16x8x1_F32F32F32F32)
+{
+  test_tiled_mma<CPU_16x8x1_F32F32F32F32, float, float>(
+    make_layout(make_shape(_64{}, _16{})),
+    make_layout(make_shape(_32{}, _16{})), small_integers, 0);
+
+  test_tiled_mma<CPU_16x8x1_F32F32F32F32, float, float>(
+    make_layout(make_shape(_64{}, _16{}), LayoutRight{}),
+    make_layout(make_shape(_32{}, _16{}), LayoutRight{}), small_integers, 0);
+}
+
+TEST(CuTe_cpu, TiledMma_8x4x1_F64F64F64F64)
+{
+  test_tiled_mma<CPU_8x4x1_F64F64F64F64, double, double>(
+    make_layout(make_shape(_32{}, _16{})),
+    make_layout(make_shape(_16{}, _16{})), small_integers, 0);
+
+  test_tiled_mma<CPU_8x4x1_F64F64F64F64, double, double>(
+    make_layout(make_shape(_32{}, _16{}), LayoutRight{}),
+    make_layout(make_shape(_16{}, _16{}), LayoutRight{}), small_integers, 0);
+}
+
+TEST(CuTe_cpu, TiledMma_16x8x2_F32BF16BF16F32)
+{
+  // Small integers are exact in bf16 and their products accumulate exactly in fp32
+  test_tiled_mma<CPU_16x8x2_F32BF16BF16F32, bfloat16_t, float>(
+    make_layout(make_shape(_64{}, _16{}), LayoutRight{}),
+    make_layout(make_shape(_32{}, _16{}), LayoutRight{}), small_integers, 0);
+
+  test_tiled_mma<CPU_16x8x2_F32BF16BF16F32, bfloat16_t, float>(
+    make_layout(make_shape(_64{}, _16{})),
+    make_layout(make_shape(_32{}, _16{})), small_integers, 0);
+}
+
+TEST(CuTe_cpu, TiledMma_Rounding)
+{
+  // Agreement up to the rounding of fused and unfused FMAs and of the order of summation
+  test_tiled_mma<CPU_8x8x1_F32F32F32F32, float, float>(
+    make_layout(make_shape(_64{}, _16{})),
+    make_layout(make_shape(_32{}, _16{})), reals, 2e-6);
+
+  test_tiled_mma<CPU_16x8x1_F32F32F32F32, float, float>(
+    make_layout(make_shape(_64{}, _16{})),
+    make_layout(make_shape(_32{}, _16{})), reals, 2e-6);
+
+  test_tiled_mma<CPU_8x4x1_F64F64F64F64, double, double>(
+    make_layout(make_shape(_32{}, _16{})),
+    make_layout(make_shape(_16{}, _16{})), reals, 4e-15);
+
+  test_tiled_mma<CPU_16x8x2_F32BF16BF16F32, bfloat16_t, float>(
+    make_layout(make_shape(_64{}, _16{}), LayoutRight{}),
+    make_layout(make_shape(_32{}, _16{}), LayoutRight{}), reals, 2e-6);
+}
+
+TEST(CuTe_cpu, TiledMma_Direct)
+{
+  // The FP32 atoms consume M-major operands and accumulators in place, without fragments
+  std::vector<float> A_data(64 * 16, 1.0f);
+  std::vector<float> B_data(32 * 16, 2.0f);
+  std::vector<float> C_data(64 * 32, 1.0f);
+
+  Tensor A = make_tensor(A_data.data(), make_layout(make_shape(_64{}, _16{})));
+  Tensor B = make_tensor(B_data.data(), make_layout(make_shape(_32{}, _16{})));
+  Tensor C = make_tensor(C_data.data(), make_layout(make_shape(_64{}, _32{})));
+
+  TiledMMA tiled_mma = make_tiled_mma(CPU_16x8x1_F32F32F32F32{});
+  auto thr_mma = tiled_mma.get_slice(0);
+
+  Tensor tCgC = thr_mma.partition_C(C);
+  gemm(tiled_mma, tCgC, thr_mma.partition_A(A), thr_mma.partition_B(B), tCgC);
+
+  for (float c : C_data) {
+    EXPECT_EQ(c, 33.0f);
+  }
+}
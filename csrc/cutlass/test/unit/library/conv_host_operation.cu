@@ -0,0 +1,351 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/util.h"
+
+#include "cutlass/conv/conv2d_problem_size.h"
+#include "cutlass/conv/conv3d_problem_size.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/util/reference/host/convolution.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+void initialize_host_operations(Manifest &manifest);
+
+} // namespace library
+} // namespace cutlass
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::library;
+
+/// Finds the host convolution of the given kind, conv kind and element types
+Operation const *find_host_conv(
+  Manifest const &manifest,
+  OperationKind kind,
+  ConvKind conv_kind,
+  NumericTypeID element,
+  NumericTypeID element_accumulator) {
+
+  for (auto const &operation : manifest) {
+    if (operation->description().kind != kind || operation->description().provider != Provider::kHost) {
+      continue;
+    }
+
+    ConvDescription const &desc = static_cast<ConvDescription const &>(operation->description());
+
+    if (desc.conv_kind == conv_kind &&
+      desc.A.element == element &&
+      desc.tile_description.math_instruction.element_accumulator == element_accumulator) {
+
+      return operation.get();
+    }
+  }
+  return nullptr;
+}
+
+/// Fills a tensor with small integers so every path computes exactly
+template <typename Element>
+std::vector<Element> make_operand(int64_t count, int seed) {
+  std::vector<Element> data(count);
+  for (int64_t i = 0; i < count; ++i) {
+    data[i] = Element(int((i * 7 + seed) % 9) - 4);
+  }
+  return data;
+}
+
+/// Runs a host Conv2d on a problem and compares it to the direct host reference
+void verify_host_conv2d(
+  Operation const *operation,
+  cutlass::conv::Operator conv_operator,
+  cutlass::conv::Conv2dProblemSize const &problem_size) {
+
+  using Layout = cutlass::layout::TensorNHWC;
+
+  cutlass::Tensor4DCoord extent_a = cutlass::conv::implicit_gemm_tensor_a_extent(conv_operator, problem_size);
+  cutlass::Tensor4DCoord extent_b = cutlass::conv::implicit_gemm_tensor_b_extent(conv_operator, problem_size);
+  cutlass::Tensor4DCoord extent_c = cutlass::conv::implicit_gemm_tensor_c_extent(conv_operator, problem_size);
+
+  Layout layout_a = Layout::packed(extent_a);
+  Layout layout_b = Layout::packed(extent_b);
+  Layout layout_c = Layout::packed(extent_c);
+
+  std::vector<float> A = make_operand<float>(layout_a.capacity(extent_a), 1);
+  std::vector<float> B = make_operand<float>(layout_b.capacity(extent_b), 2);
+  std::vector<float> C = make_operand<float>(layout_c.capacity(extent_c), 3);
+  std::vector<float> D(C.size(), 0.0f);
+  std::vector<float> D_direct(C.size(), 0.0f);
+
+  float alpha = 2.0f;
+  float beta = -1.0f;
+
+  Conv2dConfiguration config;
+  config.split_k_mode = cutlass::conv::SplitKMode::kSerial;
+  config.problem_size = problem_size;
+
+  for (int i = 0; i < 3; ++i) {
+    config.stride_a.push_back(layout_a.stride()[i]);
+    config.stride_b.push_back(layout_b.stride()[i]);
+    config.stride_c.push_back(layout_c.stride()[i]);
+  }
+
+  ConvArguments args;
+  args.A = A.data();
+  args.B = B.data();
+  args.C = C.data();
+  args.D = D.data();
+  args.alpha = &alpha;
+  args.beta = &beta;
+  args.pointer_mode = ScalarPointerMode::kHost;
+
+  ASSERT_EQ(operation->can_implement(&config, &args), cutlass::Status::kSuccess);
+  EXPECT_EQ(operation->get_device_workspace_size(&config, &args), 0u);
+
+  std::vector<uint8_t> host_workspace(operation->get_host_workspace_size(&config));
+  ASSERT_EQ(operation->initialize(&config, host_workspace.data()), cutlass::Status::kSuccess);
+  ASSERT_EQ(operation->run(&args, host_workspace.data()), cutlass::Status::kSuccess);
+
+  cutlass::TensorRef<float, Layout> ref_a(A.data(), layout_a);
+  cutlass::TensorRef<float, Layout> ref_b(B.data(), layout_b);
+  cutlass::TensorRef<float, Layout> ref_c(C.data(), layout_c);
+  cutlass::TensorRef<float, Layout> ref_d(D_direct.data(), layout_c);
+
+  switch (conv_operator) {
+  case cutlass::conv::Operator::kFprop:
+    cutlass::reference::host::Conv2dFpropDirect<float, Layout, float, Layout, float, Layout, float>(
+      problem_size, ref_a, ref_b, ref_c, ref_d, alpha, beta);
+    break;
+  case cutlass::conv::Operator::kDgrad:
+    cutlass::reference::host::Conv2dDgradDirect<float, Layout, float, Layout, float, Layout, float>(
+      problem_size, ref_a, ref_b, ref_c, ref_d, alpha, beta);
+    break;
+  default:
+    cutlass::reference::host::Conv2dWgradDirect<float, Layout, float, Layout, float, Layout, float>(
+      problem_size, ref_a, ref_b, ref_c, ref_d, alpha, beta);
+    break;
+  }
+
+  EXPECT_TRUE(D == D_direct) << operation->description().name;
+}
+
+/// Runs a host Conv3d on a problem and compares it to the direct host reference
+void verify_host_conv3d(
+  Operation const *operation,
+  cutlass::conv::Operator conv_operator,
+  cutlass::conv::Conv3dProblemSize const &problem_size) {
+
+  using Layout = cutlass::layout::TensorNDHWC;
+
+  cutlass::Tensor5DCoord extent_activations(
+    problem_size.N, problem_size.D, problem_size.H, problem_size.W, problem_size.C);
+  cutlass::Tensor5DCoord extent_filters(
+    problem_size.K, problem_size.T, problem_size.R, problem_size.S, problem_size.C);
+  cutlass::Tensor5DCoord extent_output(
+    problem_size.N, problem_size.Z, problem_size.P, problem_size.Q, problem_size.K);
+
+  Conv3dConfiguration config;
+  config.split_k_mode = cutlass::conv::SplitKMode::kSerial;
+  config.problem_size = problem_size;
+  config.layout_activations = Layout::packed(extent_activations);
+  config.layout_filters = Layout::packed(extent_filters);
+  config.layout_output = Layout::packed(extent_output);
+
+  ConvKind conv_kind = (conv_operator == cutlass::conv::Operator::kFprop ? ConvKind::kFprop :
+    conv_operator == cutlass::conv::Operator::kDgrad ? ConvKind::kDgrad : ConvKind::kWgrad);
+
+  cutlass::Tensor5DCoord extent_a = cutlass::conv::implicit_gemm_tensor_a_extent(conv_operator, problem_size);
+  cutlass::Tensor5DCoord extent_b = cutlass::conv::implicit_gemm_tensor_b_extent(conv_operator, problem_size);
+  cutlass::Tensor5DCoord extent_c = cutlass::conv::implicit_gemm_tensor_c_extent(conv_operator, problem_size);
+
+  Layout layout_a = config.layout_a(conv_kind);
+  Layout layout_b = config.layout_b(conv_kind);
+  Layout layout_c = config.layout_c(conv_kind);
+
+  std::vector<float> A = make_operand<float>(layout_a.capacity(extent_a), 1);
+  std::vector<float> B = make_operand<float>(layout_b.capacity(extent_b), 2);
+  std::vector<float> C = make_operand<float>(layout_c.capacity(extent_c), 3);
+  std::vector<float> D(C.size(), 0.0f);
+  std::vector<float> D_direct(C.size(), 0.0f);
+
+  float alpha = 2.0f;
+  float beta = -1.0f;
+
+  ConvArguments args;
+  args.A = A.data();
+  args.B = B.data();
+  args.C = C.data();
+  args.D = D.data();
+  args.alpha = &alpha;
+  args.beta = &beta;
+  args.pointer_mode = ScalarPointerMode::kHost;
+
+  ASSERT_EQ(operation->can_implement(&config, &args), cutlass::Status::kSuccess);
+
+  std::vector<uint8_t> host_workspace(operation->get_host_workspace_size(&config));
+  ASSERT_EQ(operation->initialize(&config, host_workspace.data()), cutlass::Status::kSuccess);
+  ASSERT_EQ(operation->run(&args, host_workspace.data()), cutlass::Status::kSuccess);
+
+  cutlass::TensorRef<float, Layout> ref_a(A.data(), layout_a);
+  cutlass::TensorRef<float, Layout> ref_b(B.data(), layout_b);
+  cutlass::TensorRef<float, Layout> ref_c(C.data(), layout_c);
+  cutlass::TensorRef<float, Layout> ref_d(D_direct.data(), layout_c);
+
+  switch (conv_operator) {
+  case cutlass::conv::Operator::kFprop:
+    cutlass::reference::host::Conv3dFpropDirect<float, Layout, float, Layout, float, Layout, float>(
+      problem_size, ref_a, ref_b, ref_c, ref_d, alpha, beta);
+    break;
+  case cutlass::conv::Operator::kDgrad:
+    cutlass::reference::host::Conv3dDgradDirect<float, Layout, float, Layout, float, Layout, float>(
+      problem_size, ref_a, ref_b, ref_c, ref_d, alpha, beta);
+    break;
+  default:
+    cutlass::reference::host::Conv3dWgradDirect<float, Layout, float, Layout, float, Layout, float>(
+      problem_size, ref_a, ref_b, ref_c, ref_d, alpha, beta);
+    break;
+  }
+
+  EXPECT_TRUE(D == D_direct) << operation->description().name;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(Library_ConvHostOperation, registers_conv2d_and_conv3d) {
+
+  Manifest manifest;
+  initialize_host_operations(manifest);
+
+  for (OperationKind kind : {OperationKind::kConv2d, OperationKind::kConv3d}) {
+    for (ConvKind conv_kind : {ConvKind::kFprop, ConvKind::kDgrad, ConvKind::kWgrad}) {
+      Operation const *operation = find_host_conv(
+        manifest, kind, conv_kind, NumericTypeID::kF32, NumericTypeID::kF32);
+
+      ASSERT_NE(operation, nullptr);
+
+      ConvDescription const &desc = static_cast<ConvDescription const &>(operation->description());
+
+      EXPECT_EQ(desc.iterator_algorithm, IteratorAlgorithmID::kNone);
+      EXPECT_EQ(desc.tile_description.minimum_compute_capability, 0);
+      EXPECT_EQ(std::string(desc.name).find(
+        std::string(kind == OperationKind::kConv2d ? "conv2d_" : "conv3d_") + to_string(conv_kind) + "_cpu_f32"),
+        0u) << desc.name;
+    }
+  }
+}
+
+TEST(Library_ConvHostOperation, conv2d_f32) {
+
+  Manifest manifest;
+  initialize_host_operations(manifest);
+
+  cutlass::conv::Conv2dProblemSize problem_size(
+    {2, 9, 11, 24}, {40, 3, 3, 24}, {1, 1, 1, 1}, {2, 1}, {1, 2}, cutlass::conv::Mode::kCrossCorrelation);
+
+  verify_host_conv2d(
+    find_host_conv(manifest, OperationKind::kConv2d, ConvKind::kFprop, NumericTypeID::kF32, NumericTypeID::kF32),
+    cutlass::conv::Operator::kFprop, problem_size);
+  verify_host_conv2d(
+    find_host_conv(manifest, OperationKind::kConv2d, ConvKind::kDgrad, NumericTypeID::kF32, NumericTypeID::kF32),
+    cutlass::conv::Operator::kDgrad, problem_size);
+  verify_host_conv2d(
+    find_host_conv(manifest, OperationKind::kConv2d, ConvKind::kWgrad, NumericTypeID::kF32, NumericTypeID::kF32),
+    cutlass::conv::Operator::kWgrad, problem_size);
+}
+
+TEST(Library_ConvHostOperation, conv3d_f32) {
+
+  Manifest manifest;
+  initialize_host_operations(manifest);
+
+  cutlass::conv::Conv3dProblemSize problem_size(
+    {1, 7, 8, 6, 16}, {12, 3, 3, 2, 16}, cutlass::make_Coord(1, 1, 0),
+    cutlass::make_Coord(2, 1, 1), cutlass::make_Coord(1, 1, 2), cutlass::conv::Mode::kConvolution);
+
+  verify_host_conv3d(
+    find_host_conv(manifest, OperationKind::kConv3d, ConvKind::kFprop, NumericTypeID::kF32, NumericTypeID::kF32),
+    cutlass::conv::Operator::kFprop, problem_size);
+  verify_host_conv3d(
+    find_host_conv(manifest, OperationKind::kConv3d, ConvKind::kDgrad, NumericTypeID::kF32, NumericTypeID::kF32),
+    cutlass::conv::Operator::kDgrad, problem_size);
+  verify_host_conv3d(
+    find_host_conv(manifest, OperationKind::kConv3d, ConvKind::kWgrad, NumericTypeID::kF32, NumericTypeID::kF32),
+    cutlass::conv::Operator::kWgrad, problem_size);
+}
+
+TEST(Library_ConvHostOperation, rejects_unsupported_configurations) {
+
+  Manifest manifest;
+  initialize_host_operations(manifest);
+
+  Operation const *fprop = find_host_conv(
+    manifest, OperationKind::kConv2d, ConvKind::kFprop, NumericTypeID::kF32, NumericTypeID::kF32);
+  Operation const *dgrad = find_host_conv(
+    manifest, OperationKind::kConv2d, ConvKind::kDgrad, NumericTypeID::kF32, NumericTypeID::kF32);
+
+  ASSERT_NE(fprop, nullptr);
+  ASSERT_NE(dgrad, nullptr);
+
+  Conv2dConfiguration config;
+  config.split_k_mode = cutlass::conv::SplitKMode::kParallel;
+  config.problem_size = cutlass::conv::Conv2dProblemSize(
+    {1, 8, 8, 16}, {16, 3, 3, 16}, {1, 1, 1, 1}, {1, 1}, {1, 1}, cutlass::conv::Mode::kCrossCorrelation);
+  config.stride_a = {16, 128, 1024};
+  config.stride_b = {16, 48, 144};
+  config.stride_c = {16, 128, 1024};
+
+  ConvArguments args;
+
+  EXPECT_EQ(fprop->can_implement(&config, &args), cutlass::Status::kErrorNotSupported);
+
+  config.split_k_mode = cutlass::conv::SplitKMode::kSerial;
+  config.problem_size = cutlass::conv::Conv2dProblemSize(
+    {1, 8, 8, 16}, {16, 3, 3, 4}, {1, 1, 1, 1}, {1, 1}, {1, 1}, cutlass::conv::Mode::kCrossCorrelation, 1, 4);
+
+  EXPECT_EQ(fprop->can_implement(&config, &args), cutlass::Status::kSuccess);
+  EXPECT_EQ(dgrad->can_implement(&config, &args), cutlass::Status::kErrorNotSupported);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
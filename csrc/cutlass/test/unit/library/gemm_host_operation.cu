@@ -0,0 +1,232 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/util.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+void initialize_host_operations(Manifest &manifest);
+
+} // namespace library
+} // namespace cutlass
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::library;
+
+/// Offset of element (row, column) of a column-major or row-major matrix
+int64_t offset(LayoutTypeID layout, int row, int column, int64_t ld) {
+  return layout == LayoutTypeID::kColumnMajor ? row + column * ld : row * ld + column;
+}
+
+/// Runs a host GEMM on a problem and compares it to a naive loop
+template <typename ElementAB, typename ElementC, typename ElementCompute>
+void verify_host_gemm(
+  Operation const *operation,
+  GemmUniversalMode mode,
+  int m, int n, int k, int batch_count) {
+
+  GemmDescription const &desc = static_cast<GemmDescription const &>(operation->description());
+
+  // Leading dimensions are padded so that they differ from the problem extents
+  int64_t lda = (desc.A.layout == LayoutTypeID::kColumnMajor ? m : k) + 3;
+  int64_t ldb = (desc.B.layout == LayoutTypeID::kColumnMajor ? k : n) + 1;
+  int64_t ldc = (desc.C.layout == LayoutTypeID::kColumnMajor ? m : n) + 2;
+
+  int64_t batch_stride_A = lda * (desc.A.layout == LayoutTypeID::kColumnMajor ? k : m);
+  int64_t batch_stride_B = ldb * (desc.B.layout == LayoutTypeID::kColumnMajor ? n : k);
+  int64_t batch_stride_C = ldc * (desc.C.layout == LayoutTypeID::kColumnMajor ? n : m);
+
+  std::vector<ElementAB> A(batch_stride_A * batch_count);
+  std::vector<ElementAB> B(batch_stride_B * batch_count);
+  std::vector<ElementC> C(batch_stride_C * batch_count);
+  std::vector<ElementC> D(batch_stride_C * batch_count, ElementC(0));
+
+  for (size_t i = 0; i < A.size(); ++i) { A[i] = ElementAB(int(i * 7 % 9) - 4); }
+  for (size_t i = 0; i < B.size(); ++i) { B[i] = ElementAB(int(i * 5 % 7) - 3); }
+  for (size_t i = 0; i < C.size(); ++i) { C[i] = ElementC(int(i * 3 % 5) - 2); }
+
+  ElementCompute alpha = ElementCompute(2);
+  ElementCompute beta = ElementCompute(-1);
+
+  GemmUniversalConfiguration config;
+  config.mode = mode;
+  config.problem_size = cutlass::gemm::GemmCoord(m, n, k);
+  config.batch_count = batch_count;
+  config.lda = lda;
+  config.ldb = ldb;
+  config.ldc = ldc;
+  config.ldd = ldc;
+
+  GemmUniversalArguments args;
+  args.problem_size = config.problem_size;
+  args.batch_count = batch_count;
+  args.A = A.data();
+  args.B = B.data();
+  args.C = C.data();
+  args.D = D.data();
+  args.alpha = &alpha;
+  args.beta = &beta;
+  args.batch_stride_A = batch_stride_A;
+  args.batch_stride_B = batch_stride_B;
+  args.batch_stride_C = batch_stride_C;
+  args.batch_stride_D = batch_stride_C;
+
+  ASSERT_EQ(operation->can_implement(&config, &args), cutlass::Status::kSuccess);
+  EXPECT_EQ(operation->get_device_workspace_size(&config, &args), 0u);
+
+  std::vector<uint8_t> host_workspace(operation->get_host_workspace_size(&config));
+  ASSERT_EQ(operation->initialize(&config, host_workspace.data()), cutlass::Status::kSuccess);
+  ASSERT_EQ(operation->run(&args, host_workspace.data()), cutlass::Status::kSuccess);
+
+  for (int l = 0; l < batch_count; ++l) {
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < n; ++j) {
+        ElementCompute accum = ElementCompute(0);
+        for (int p = 0; p < k; ++p) {
+          accum += ElementCompute(A[l * batch_stride_A + offset(desc.A.layout, i, p, lda)]) *
+            ElementCompute(B[l * batch_stride_B + offset(desc.B.layout, p, j, ldb)]);
+        }
+        int64_t c = l * batch_stride_C + offset(desc.C.layout, i, j, ldc);
+        ElementCompute expected = alpha * accum + beta * ElementCompute(C[c]);
+
+        ASSERT_EQ(ElementCompute(D[c]), expected)
+          << operation->description().name << " at (" << i << ", " << j << ", " << l << ")";
+      }
+    }
+  }
+}
+
+/// Finds the host GEMMs with the given element types
+std::vector<Operation const *> find_host_gemms(
+  Manifest const &manifest,
+  NumericTypeID element,
+  NumericTypeID element_accumulator) {
+
+  std::vector<Operation const *> operations;
+
+  for (auto const &operation : manifest) {
+    if (operation->description().kind != OperationKind::kGemm) {
+      continue;
+    }
+
+    GemmDescription const &desc = static_cast<GemmDescription const &>(operation->description());
+
+    if (desc.provider == Provider::kHost &&
+      desc.A.element == element &&
+      desc.tile_description.math_instruction.element_accumulator == element_accumulator) {
+
+      operations.push_back(operation.get());
+    }
+  }
+  return operations;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(Library_GemmHostOperation, registers_canonical_layouts) {
+
+  Manifest manifest;
+  initialize_host_operations(manifest);
+
+  std::vector<Operation const *> operations = find_host_gemms(manifest, NumericTypeID::kF32, NumericTypeID::kF32);
+
+  ASSERT_EQ(operations.size(), 8u);
+
+  for (Operation const *operation : operations) {
+    OperationDescription const &desc = operation->description();
+
+    EXPECT_EQ(desc.kind, OperationKind::kGemm);
+    EXPECT_EQ(desc.tile_description.minimum_compute_capability, 0);
+    EXPECT_EQ(std::string(desc.name).find("gemm_cpu_f32"), 0u) << desc.name;
+  }
+
+  EXPECT_EQ(std::string(to_string(Provider::kHost)), "cpu");
+  EXPECT_EQ(from_string<Provider>("cpu"), Provider::kHost);
+}
+
+TEST(Library_GemmHostOperation, f32_all_layouts) {
+
+  Manifest manifest;
+  initialize_host_operations(manifest);
+
+  for (Operation const *operation : find_host_gemms(manifest, NumericTypeID::kF32, NumericTypeID::kF32)) {
+    verify_host_gemm<float, float, float>(operation, GemmUniversalMode::kGemm, 70, 67, 33, 1);
+  }
+}
+
+TEST(Library_GemmHostOperation, s8_batched) {
+
+  Manifest manifest;
+  initialize_host_operations(manifest);
+
+  for (Operation const *operation : find_host_gemms(manifest, NumericTypeID::kS8, NumericTypeID::kS32)) {
+    GemmDescription const &desc = static_cast<GemmDescription const &>(operation->description());
+
+    if (desc.C.element == NumericTypeID::kS32) {
+      verify_host_gemm<int8_t, int32_t, int32_t>(operation, GemmUniversalMode::kBatched, 19, 37, 21, 3);
+    }
+  }
+}
+
+TEST(Library_GemmHostOperation, rejects_split_k_parallel) {
+
+  Manifest manifest;
+  initialize_host_operations(manifest);
+
+  std::vector<Operation const *> operations = find_host_gemms(manifest, NumericTypeID::kF64, NumericTypeID::kF64);
+  ASSERT_FALSE(operations.empty());
+
+  GemmUniversalConfiguration config;
+  config.mode = GemmUniversalMode::kGemmSplitKParallel;
+  config.problem_size = cutlass::gemm::GemmCoord(16, 16, 16);
+
+  GemmUniversalArguments args;
+
+  EXPECT_EQ(operations.front()->can_implement(&config, &args), cutlass::Status::kErrorNotSupported);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
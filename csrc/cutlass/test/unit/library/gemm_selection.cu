@@ -0,0 +1,196 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/gemm_selection.h"
+
+#include "synthetic_gemm_operation.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::library;
+
+using test::library::SyntheticGemmOperation;
+
+/// Synthetic manifest listing a wide tile first, as the generated manifests do
+struct SyntheticManifest {
+
+  std::vector<std::unique_ptr<SyntheticGemmOperation>> storage;
+  std::vector<Operation const *> operations;
+
+  SyntheticManifest() {
+    add("gemm_256x128_32x3", 256, 128, 32);
+    add("gemm_128x256_32x3", 128, 256, 32);
+    add("gemm_128x128_32x3", 128, 128, 32);
+    add("gemm_128x64_32x3", 128, 64, 32);
+    add("gemm_64x64_64x3", 64, 64, 64);
+  }
+
+  void add(std::string const &name, int tile_m, int tile_n, int tile_k) {
+    storage.emplace_back(new SyntheticGemmOperation(name, tile_m, tile_n, tile_k));
+    operations.push_back(storage.back().get());
+  }
+
+  GemmDescription const &desc(int idx) const {
+    return static_cast<GemmDescription const &>(operations.at(idx)->description());
+  }
+};
+
+std::string name_of(GemmSelectionCandidate const &candidate) {
+  return candidate.operation->description().name;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GemmSelection, wave_and_tile_efficiency) {
+
+  SyntheticManifest manifest;
+  GemmPerformanceModel model;
+
+  // 12 x 12 tiles of 128 x 128 fill 108 multiprocessors in two waves.
+  GemmCostEstimate estimate = model.estimate(manifest.desc(2), GemmSelectionProblem(1536, 1536, 4096, 1, 1, 108));
+
+  EXPECT_EQ(estimate.tiles, 144);
+  EXPECT_EQ(estimate.waves, 2);
+  EXPECT_DOUBLE_EQ(estimate.wave_efficiency, 144.0 / 216.0);
+  EXPECT_DOUBLE_EQ(estimate.tile_efficiency, 1.0);
+
+  // Padding M to one tile and K to one k-block
+  estimate = model.estimate(manifest.desc(2), GemmSelectionProblem(64, 128, 48, 1, 1, 108));
+
+  EXPECT_EQ(estimate.tiles, 1);
+  EXPECT_DOUBLE_EQ(estimate.tile_efficiency, (64.0 * 128 * 48) / (128.0 * 128 * 64));
+
+  // Batches and split-K slices are tiles too.
+  estimate = model.estimate(manifest.desc(2), GemmSelectionProblem(128, 128, 4096, 3, 4, 108));
+
+  EXPECT_EQ(estimate.tiles, 12);
+  EXPECT_EQ(estimate.waves, 1);
+}
+
+TEST(GemmSelection, split_k_need) {
+
+  SyntheticManifest manifest;
+  GemmPerformanceModel model;
+
+  // A single output tile with long K leaves the device idle without split-K.
+  GemmCostEstimate small_mn = model.estimate(manifest.desc(2), GemmSelectionProblem(128, 128, 16384));
+  EXPECT_GT(small_mn.split_k_slices, 1);
+  EXPECT_LE(small_mn.split_k_slices, model.max_split_k_slices);
+
+  // Many output tiles already fill the device.
+  GemmCostEstimate large_mn = model.estimate(manifest.desc(2), GemmSelectionProblem(8192, 8192, 1024));
+  EXPECT_EQ(large_mn.split_k_slices, 1);
+}
+
+TEST(GemmSelection, model_ranking) {
+
+  SyntheticManifest manifest;
+  GemmModelSelector selector;
+
+  // Tall-skinny: the first-listed 256 x 128 tile wastes half of each tile along N.
+  std::vector<GemmSelectionCandidate> ranked =
+    selector.rank(GemmSelectionProblem(8192, 64, 4096), manifest.operations);
+
+  ASSERT_EQ(ranked.size(), manifest.operations.size());
+  EXPECT_LE(static_cast<GemmDescription const &>(ranked.front().operation->description())
+    .tile_description.threadblock_shape.n(), 64);
+  for (size_t idx = 1; idx < ranked.size(); ++idx) {
+    EXPECT_FALSE(ranked[idx].measured);
+    EXPECT_LE(ranked[idx - 1].runtime, ranked[idx].runtime);
+  }
+
+  // Short-wide: the 256 x 128 tile wastes half of each tile along M.
+  ranked = selector.rank(GemmSelectionProblem(128, 16384, 4096), manifest.operations);
+  EXPECT_LE(static_cast<GemmDescription const &>(ranked.front().operation->description())
+    .tile_description.threadblock_shape.m(), 128);
+
+  // The first-fit selector keeps manifest order.
+  GemmFirstFitSelector first_fit;
+  ranked = first_fit.rank(GemmSelectionProblem(8192, 64, 4096), manifest.operations);
+  ASSERT_EQ(ranked.size(), manifest.operations.size());
+  EXPECT_EQ(ranked.front().operation, manifest.operations.front());
+}
+
+TEST(GemmSelection, measured_table) {
+
+  SyntheticManifest manifest;
+
+  std::stringstream csv;
+  csv << "Problem,Provider,OperationKind,Operation,Disposition,Status,gemm_kind,m,n,k,"
+         "split_k_slices,batch_count,Bytes,Flops,Flops/Byte,Runtime,GB/s,GFLOPs\n"
+      << "0,CUTLASS,gemm,gemm_256x128_32x3,passed,success,universal,8192,64,4096,1,1,0,0,0,0.05,1,1\n"
+      << "0,CUTLASS,gemm,gemm_64x64_64x3,passed,success,universal,8192,64,4096,1,1,0,0,0,0.08,1,1\n"
+      << "0,CUTLASS,gemm,gemm_64x64_64x3,passed,success,universal,8192,64,4096,1,1,0,0,0,0.07,1,1\n"
+      << "0,cuBLAS,gemm,gemm_128x64_32x3,passed,success,universal,8192,64,4096,1,1,0,0,0,0.01,1,1\n"
+      << "0,CUTLASS,gemm,gemm_128x64_32x3,failed,error_internal,universal,8192,64,4096,1,1,0,0,0,0.01,,\n"
+      << "0,CUTLASS,gemm,gemm_128x128_32x3,passed,success,universal,8192,64,8192,1,1,0,0,0,0.02,1,1\n";
+
+  auto table = std::make_shared<GemmPerformanceTable>();
+  EXPECT_EQ(table->load_csv(csv), 4);
+  EXPECT_EQ(table->size(), 3);
+
+  double runtime = 0;
+  ASSERT_TRUE(table->find("gemm_64x64_64x3", GemmSelectionProblem(8192, 64, 4096), runtime));
+  EXPECT_DOUBLE_EQ(runtime, 0.07);
+  EXPECT_FALSE(table->find("gemm_128x64_32x3", GemmSelectionProblem(8192, 64, 4096), runtime));
+
+  // Measured operations rank ahead of modeled ones, fastest first.
+  GemmModelSelector selector(GemmPerformanceModel(), table);
+  std::vector<GemmSelectionCandidate> ranked =
+    selector.rank(GemmSelectionProblem(8192, 64, 4096), manifest.operations);
+
+  ASSERT_EQ(ranked.size(), manifest.operations.size());
+  EXPECT_EQ(name_of(ranked[0]), "gemm_256x128_32x3");
+  EXPECT_TRUE(ranked[0].measured);
+  EXPECT_EQ(name_of(ranked[1]), "gemm_64x64_64x3");
+  EXPECT_TRUE(ranked[1].measured);
+  EXPECT_FALSE(ranked[2].measured);
+
+  // Other problems fall back to the model.
+  ranked = selector.rank(GemmSelectionProblem(8192, 64, 2048), manifest.operations);
+  EXPECT_FALSE(ranked.front().measured);
+
+  std::stringstream bad_csv("Problem,Provider,Status\n0,CUTLASS,success\n");
+  EXPECT_EQ(GemmPerformanceTable().load_csv(bad_csv), -1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
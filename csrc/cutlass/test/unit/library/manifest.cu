@@ -0,0 +1,316 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/operation_index.h"
+#include "cutlass/library/operation_table.h"
+#include "cutlass/library/util.h"
+
+#include "synthetic_gemm_operation.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::library;
+
+using test::library::SyntheticGemmOperation;
+
+/// Operation of the given kind and minimum compute capability
+SyntheticGemmOperation *make_operation(char const *name, OperationKind kind, int min_cc) {
+  auto *operation = new SyntheticGemmOperation(name, 128, 128, 32, 8, min_cc);
+  operation->set_kind(kind);
+  return operation;
+}
+
+void initialize_sm80_gemm_nt(Manifest &manifest) {
+  manifest.append(make_operation("cutlass_tensorop_h16816gemm_128x128_32x3_nt_align8", OperationKind::kGemm, 80));
+  manifest.append(make_operation("cutlass_tensorop_h16816gemm_128x128_32x3_nt_align4", OperationKind::kGemm, 80));
+}
+
+void initialize_sm90_gemm_tn(Manifest &manifest) {
+  manifest.append(make_operation("cutlass3x_sm90_tensorop_h64x128x16gemm_f16_f16_f16_f16_f16_tn_align8", OperationKind::kGemm, 90));
+}
+
+void initialize_sm80_fprop(Manifest &manifest) {
+  manifest.append(make_operation("cutlass_tensorop_h16816fprop_optimized_f16_128x128_32x3_nhwc_align8", OperationKind::kConv2d, 80));
+}
+
+/// Registers the synthetic configurations as a generated library does
+void register_configurations(Manifest &manifest) {
+  manifest.register_configuration({
+    OperationKind::kGemm, 80,
+    "cutlass_tensorop_h16816gemm_128x128_32x3_nt_align8,cutlass_tensorop_h16816gemm_128x128_32x3_nt_align4",
+    initialize_sm80_gemm_nt});
+  manifest.register_configuration({
+    OperationKind::kGemm, 90,
+    "cutlass3x_sm90_tensorop_h64x128x16gemm_f16_f16_f16_f16_f16_tn_align8",
+    initialize_sm90_gemm_tn});
+  manifest.register_configuration({
+    OperationKind::kConv2d, 80,
+    "cutlass_tensorop_h16816fprop_optimized_f16_128x128_32x3_nhwc_align8",
+    initialize_sm80_fprop});
+}
+
+void initialize_sm80_sgemm(Manifest &manifest) {
+  SyntheticGemmOperation *operation = make_operation("cutlass_simt_sgemm_128x128_8x2_nn_align1", OperationKind::kGemm, 80);
+  operation->set_element(NumericTypeID::kF32);
+  manifest.append(operation);
+}
+
+void initialize_sm80_gemm_reference(Manifest &manifest) {
+  manifest.append(make_operation("gemm_reference", OperationKind::kGemm, 0));
+}
+
+/// Registers configurations under the functional keys of their operations. The last configuration
+/// has no key.
+void register_keyed_configurations(Manifest &manifest) {
+  manifest.register_configuration({
+    OperationKind::kGemm, 80,
+    "cutlass_tensorop_h16816gemm_128x128_32x3_nt_align8,cutlass_tensorop_h16816gemm_128x128_32x3_nt_align4",
+    initialize_sm80_gemm_nt, "f16,f16,f16"});
+  manifest.register_configuration({
+    OperationKind::kGemm, 90,
+    "cutlass3x_sm90_tensorop_h64x128x16gemm_f16_f16_f16_f16_f16_tn_align8",
+    initialize_sm90_gemm_tn, "f16,f16,f16"});
+  manifest.register_configuration({
+    OperationKind::kGemm, 80,
+    "cutlass_simt_sgemm_128x128_8x2_nn_align1",
+    initialize_sm80_sgemm, "f32,f32,f32"});
+  manifest.register_configuration({
+    OperationKind::kConv2d, 80,
+    "cutlass_tensorop_h16816fprop_optimized_f16_128x128_32x3_nhwc_align8",
+    initialize_sm80_fprop, "f16,f16,f16"});
+  manifest.register_configuration({
+    OperationKind::kGemm, 0,
+    "gemm_reference",
+    initialize_sm80_gemm_reference});
+}
+
+/// Functional key of the synthetic GEMM operations of an element type
+GemmFunctionalKey gemm_key(NumericTypeID element) {
+  return GemmFunctionalKey(
+    Provider::kCUTLASS,
+    GemmKind::kUniversal,
+    NumericTypeID::kF32,
+    NumericTypeID::kF32,
+    element,
+    LayoutTypeID::kColumnMajor,
+    ComplexTransform::kNone,
+    element,
+    LayoutTypeID::kColumnMajor,
+    ComplexTransform::kNone,
+    element,
+    LayoutTypeID::kColumnMajor,
+    element,
+    LayoutTypeID::kColumnMajor);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(Manifest, filter_matches) {
+
+  std::string name = "cutlass_tensorop_h16816gemm_128x128_32x3_nt_align8";
+
+  EXPECT_TRUE(matches_operation_name("h16816gemm", name));
+  EXPECT_TRUE(matches_operation_name("tensorop*gemm*nt", name));
+  EXPECT_TRUE(matches_operation_name("", name));
+  EXPECT_FALSE(matches_operation_name("gemm*tensorop", name));
+  EXPECT_FALSE(matches_operation_name("tn_align8", name));
+}
+
+TEST(Manifest, lazy_construction) {
+
+  SyntheticGemmOperation::constructed() = 0;
+
+  Manifest manifest;
+  register_configurations(manifest);
+
+  // Registering constructs nothing
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 0);
+  EXPECT_EQ(manifest.pending_configuration_count(), size_t(3));
+
+  // The first access constructs every operation
+  EXPECT_EQ(manifest.operations().size(), size_t(4));
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 4);
+  EXPECT_EQ(manifest.pending_configuration_count(), size_t(0));
+
+  // Later accesses construct nothing more
+  size_t count = 0;
+  for (auto const &operation : manifest) {
+    EXPECT_TRUE(operation != nullptr);
+    ++count;
+  }
+  EXPECT_EQ(count, size_t(4));
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 4);
+
+  manifest.release();
+  EXPECT_TRUE(manifest.operations().empty());
+}
+
+TEST(Manifest, filtered_construction) {
+
+  // By kind
+  {
+    SyntheticGemmOperation::constructed() = 0;
+
+    ManifestFilter filter;
+    filter.kinds = {OperationKind::kConv2d};
+
+    Manifest manifest(Provider::kCUTLASS, filter);
+    register_configurations(manifest);
+
+    // Operations appended directly are filtered by kind
+    manifest.append(make_operation("gemm_reference", OperationKind::kGemm, 0));
+
+    ASSERT_EQ(manifest.operations().size(), size_t(1));
+    EXPECT_EQ(manifest.operations().front()->description().kind, OperationKind::kConv2d);
+  }
+
+  // By compute capability
+  {
+    SyntheticGemmOperation::constructed() = 0;
+
+    ManifestFilter filter;
+    filter.compute_capability = 86;
+
+    Manifest manifest(Provider::kCUTLASS, filter);
+    register_configurations(manifest);
+
+    EXPECT_EQ(manifest.operations().size(), size_t(3));
+    EXPECT_EQ(SyntheticGemmOperation::constructed(), 3);
+  }
+
+  // By name. A configuration is constructed whole if any of its operations match.
+  {
+    SyntheticGemmOperation::constructed() = 0;
+
+    ManifestFilter filter;
+    filter.names = {"gemm*align4", "fprop"};
+    filter.excluded_names = {"nhwc"};
+
+    Manifest manifest(Provider::kCUTLASS, filter);
+    register_configurations(manifest);
+
+    EXPECT_EQ(manifest.operations().size(), size_t(2));
+    EXPECT_EQ(SyntheticGemmOperation::constructed(), 2);
+    for (auto const &operation : manifest) {
+      EXPECT_EQ(operation->description().kind, OperationKind::kGemm);
+      EXPECT_EQ(operation->description().tile_description.minimum_compute_capability, 80);
+    }
+  }
+}
+
+TEST(Manifest, construction_by_functional_key) {
+
+  SyntheticGemmOperation::constructed() = 0;
+
+  Manifest manifest;
+  register_keyed_configurations(manifest);
+
+  EXPECT_EQ(configuration_key(NumericTypeID::kF16, NumericTypeID::kF16, NumericTypeID::kF32), "f16,f16,f32");
+
+  // Configurations of the kind and key, and those of the kind without a key, are constructed
+  std::vector<Operation const *> operations = manifest.materialize(OperationKind::kGemm, "f16,f16,f16");
+  EXPECT_EQ(operations.size(), size_t(4));
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 4);
+  EXPECT_EQ(manifest.pending_configuration_count(), size_t(2));
+
+  // Operations are returned from the given index on
+  operations = manifest.materialize(OperationKind::kGemm, "f32,f32,f32", 4);
+  ASSERT_EQ(operations.size(), size_t(1));
+  EXPECT_EQ(std::string(operations.front()->description().name), "cutlass_simt_sgemm_128x128_8x2_nn_align1");
+  EXPECT_EQ(manifest.pending_configuration_count(), size_t(1));
+
+  // Accessing the operations constructs the rest
+  EXPECT_EQ(manifest.operations().size(), size_t(6));
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 6);
+  EXPECT_EQ(manifest.pending_configuration_count(), size_t(0));
+}
+
+TEST(Manifest, construction_on_lookup) {
+
+  SyntheticGemmOperation::constructed() = 0;
+
+  ManifestFilter filter;
+  filter.compute_capability = 86;
+
+  Manifest manifest(Provider::kCUTLASS, filter);
+  register_keyed_configurations(manifest);
+
+  OperationTable table;
+  table.attach(manifest);
+
+  OperationIndex index;
+  index.attach(manifest);
+
+  // Attaching constructs nothing
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 0);
+
+  // An index lookup constructs the configurations of its key passing the filter, and the
+  // configuration without a key
+  GemmOperationIndexVector const *entries = index.find_gemm_operations(gemm_key(NumericTypeID::kF16));
+  ASSERT_TRUE(entries != nullptr);
+  EXPECT_EQ(entries->size(), size_t(3));
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 3);
+
+  // The table picks up operations its lookups did not construct. Operations of equal compute
+  // capability and alignment share a preference key.
+  GemmOperationVectorMap const *gemm_operations = table.find_gemm_operations(gemm_key(NumericTypeID::kF16));
+  ASSERT_TRUE(gemm_operations != nullptr);
+  EXPECT_EQ(gemm_operations->size(), size_t(2));
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 3);
+
+  // The synthetic convolution is only ever described as a GEMM, so it is not looked up
+  ConvFunctionalKey conv_key(Provider::kCUTLASS, ConvKind::kFprop, NumericTypeID::kS8,
+    LayoutTypeID::kTensorNHWC, NumericTypeID::kS8, LayoutTypeID::kTensorNHWC, NumericTypeID::kS8);
+  EXPECT_TRUE(table.find_conv2d_operations(conv_key) == nullptr);
+
+  // Lookups of other keys construct their own configurations only
+  EXPECT_TRUE(table.find_gemm_operations(gemm_key(NumericTypeID::kF32)) != nullptr);
+  EXPECT_EQ(SyntheticGemmOperation::constructed(), 4);
+
+  entries = index.find_gemm_operations(gemm_key(NumericTypeID::kF32));
+  ASSERT_TRUE(entries != nullptr);
+  EXPECT_EQ(entries->size(), size_t(1));
+  EXPECT_EQ(manifest.pending_configuration_count(), size_t(1));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
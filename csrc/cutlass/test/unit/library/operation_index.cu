@@ -0,0 +1,189 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/operation_index.h"
+
+#include "synthetic_gemm_operation.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::library;
+
+using test::library::SyntheticGemmOperation;
+
+GemmFunctionalKey indexed_key() {
+  return GemmFunctionalKey(
+    Provider::kCUTLASS,
+    GemmKind::kUniversal,
+    NumericTypeID::kF32,
+    NumericTypeID::kF32,
+    NumericTypeID::kF16,
+    LayoutTypeID::kColumnMajor,
+    ComplexTransform::kNone,
+    NumericTypeID::kF16,
+    LayoutTypeID::kColumnMajor,
+    ComplexTransform::kNone,
+    NumericTypeID::kF16,
+    LayoutTypeID::kColumnMajor,
+    NumericTypeID::kF16,
+    LayoutTypeID::kColumnMajor);
+}
+
+/// Operations of several compute capabilities and alignments, listed out of preference order
+OperationVector indexed_operations() {
+  OperationVector operations;
+  operations.emplace_back(new SyntheticGemmOperation("sm70_align8_128", 128, 128, 32, 8, 70, 1024));
+  operations.emplace_back(new SyntheticGemmOperation("sm80_align1_128", 128, 128, 32, 1, 80, 1024));
+  operations.emplace_back(new SyntheticGemmOperation("sm80_align8_256", 256, 128, 32, 8, 80, 1024));
+  operations.emplace_back(new SyntheticGemmOperation("sm80_align8_128", 128, 128, 32, 8, 80, 1024));
+  operations.emplace_back(new SyntheticGemmOperation("sm90_align8_128", 128, 128, 32, 8, 90, 90));
+  return operations;
+}
+
+std::string name_of(Operation const *operation) {
+  return operation ? operation->description().name : "";
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(OperationIndex, preference_order) {
+
+  OperationVector operations = indexed_operations();
+  OperationIndex index;
+  index.build(operations);
+
+  GemmOperationIndexVector const *entries = index.find_gemm_operations(indexed_key());
+  ASSERT_TRUE(entries != nullptr);
+  ASSERT_EQ(entries->size(), operations.size());
+
+  // Descending compute capability, then alignment. Equal keys keep manifest order.
+  std::vector<std::string> expected = {
+    "sm90_align8_128", "sm80_align8_256", "sm80_align8_128", "sm80_align1_128", "sm70_align8_128"
+  };
+
+  for (size_t idx = 0; idx < expected.size(); ++idx) {
+    EXPECT_EQ(name_of(entries->at(idx).operation), expected[idx]);
+  }
+  EXPECT_EQ(entries->front().maximum_compute_capability, 90);
+  EXPECT_EQ(entries->back().alignment, 8);
+
+  EXPECT_TRUE(index.find_gemm_operations(GemmFunctionalKey(Provider::kCUBLAS)) == nullptr);
+
+  index.clear();
+  EXPECT_TRUE(index.find_gemm_operations(indexed_key()) == nullptr);
+}
+
+TEST(OperationIndex, find_gemm_operation) {
+
+  OperationVector operations = indexed_operations();
+  OperationIndex index;
+  index.build(operations);
+
+  GemmFirstFitSelector first_fit;
+  GemmSelectionProblem problem(4096, 4096, 4096);
+
+  // The most preferred group of eligible operations, ranked by the selector
+  EXPECT_EQ(name_of(index.find_gemm_operation(indexed_key(), 80, 8, problem, first_fit)), "sm80_align8_256");
+  EXPECT_EQ(name_of(index.find_gemm_operation(indexed_key(), 86, 8, problem, first_fit)), "sm80_align8_256");
+
+  // Unaligned problems fall back to the operations of lower alignment
+  EXPECT_EQ(name_of(index.find_gemm_operation(indexed_key(), 80, 4, problem, first_fit)), "sm80_align1_128");
+
+  // Operations of a later compute capability run on the device they were built for
+  EXPECT_EQ(name_of(index.find_gemm_operation(indexed_key(), 90, 8, problem, first_fit)), "sm90_align8_128");
+  EXPECT_EQ(name_of(index.find_gemm_operation(indexed_key(), 100, 8, problem, first_fit)), "sm80_align8_256");
+
+  EXPECT_EQ(index.find_gemm_operation(indexed_key(), 70, 4, problem, first_fit), nullptr);
+  EXPECT_EQ(index.find_gemm_operation(indexed_key(), 60, 8, problem, first_fit), nullptr);
+
+  // Matching by tile description, as split-K parallel reduction does
+  TileDescription tile = operations.at(3)->description().tile_description;
+  EXPECT_EQ(index.find_gemm_operation(indexed_key(), 80, 8, tile), operations.at(3).get());
+  EXPECT_EQ(index.find_gemm_operation(indexed_key(), 80, 1, tile), operations.at(1).get());
+  EXPECT_EQ(index.find_gemm_operation(indexed_key(), 90, 1, tile), nullptr);
+}
+
+TEST(OperationIndex, cache) {
+
+  OperationVector operations = indexed_operations();
+  GemmOperationCache cache;
+
+  GemmOperationCache::Key key(indexed_key(), 80, 8, GemmSelectionProblem(1024, 1024, 1024));
+  Operation const *operation = nullptr;
+
+  EXPECT_FALSE(cache.find(key, operation));
+
+  cache.insert(key, operations.at(2).get());
+  ASSERT_TRUE(cache.find(key, operation));
+  EXPECT_EQ(operation, operations.at(2).get());
+
+  // Problems differing in any extent are distinct
+  GemmOperationCache::Key other(indexed_key(), 80, 8, GemmSelectionProblem(1024, 1024, 1024, 2));
+  EXPECT_FALSE(cache.find(other, operation));
+
+  // Unsupported problems are cached too
+  cache.insert(other, nullptr);
+  operation = operations.at(0).get();
+  ASSERT_TRUE(cache.find(other, operation));
+  EXPECT_EQ(operation, nullptr);
+
+  EXPECT_EQ(cache.hits(), 2);
+  EXPECT_EQ(cache.misses(), 2);
+
+  // Filling the cache with many problems evicts earlier ones
+  for (int idx = 1; idx <= 4 * GemmOperationCache::kCapacity; ++idx) {
+    cache.insert(GemmOperationCache::Key(indexed_key(), 80, 8, GemmSelectionProblem(idx * 8, 64, 64)), nullptr);
+  }
+
+  int cached = 0;
+  for (int idx = 1; idx <= 4 * GemmOperationCache::kCapacity; ++idx) {
+    cached += cache.find(GemmOperationCache::Key(indexed_key(), 80, 8, GemmSelectionProblem(idx * 8, 64, 64)), operation);
+  }
+  EXPECT_LE(cached, GemmOperationCache::kCapacity);
+  EXPECT_GT(cached, 0);
+
+  cache.clear();
+  EXPECT_FALSE(cache.find(key, operation));
+  EXPECT_EQ(cache.hits(), 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
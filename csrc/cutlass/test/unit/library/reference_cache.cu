@@ -0,0 +1,221 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/reference_cache.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using cutlass::library::ReferenceCache;
+
+ReferenceCache::Key key_of(std::vector<uint8_t> const &bytes) {
+  return ReferenceCache::KeyBuilder().append(bytes.data(), bytes.size()).key();
+}
+
+ReferenceCache::Key key_of(int id) {
+  return ReferenceCache::KeyBuilder().append_value(id).key();
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceCache, key_hashes_content) {
+
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = uint8_t(i * 7);
+  }
+
+  EXPECT_TRUE(key_of(data) == key_of(std::vector<uint8_t>(data)));
+
+  // Every byte, including those of the partial trailing word, changes the key
+  for (size_t i : {size_t(0), size_t(15), size_t(16), size_t(999)}) {
+    std::vector<uint8_t> other(data);
+    other[i] ^= 1;
+    EXPECT_FALSE(key_of(data) == key_of(other));
+  }
+
+  // Trailing zeros are not padding
+  std::vector<uint8_t> padded(data);
+  padded.push_back(0);
+  EXPECT_FALSE(key_of(data) == key_of(padded));
+
+  // Strings are length-prefixed, so their boundaries matter
+  ReferenceCache::Key ab_c = ReferenceCache::KeyBuilder().append(std::string("ab")).append(std::string("c")).key();
+  ReferenceCache::Key a_bc = ReferenceCache::KeyBuilder().append(std::string("a")).append(std::string("bc")).key();
+  EXPECT_FALSE(ab_c == a_bc);
+}
+
+TEST(ReferenceCache, disabled_by_default) {
+
+  ReferenceCache cache;
+  EXPECT_FALSE(cache.enabled());
+
+  int computed = 0;
+  int result = 0;
+  auto compute = [&]() {
+    result = ++computed;
+    return cutlass::Status::kSuccess;
+  };
+
+  cache.cached(key_of(1), &result, sizeof(result), compute);
+  cache.cached(key_of(1), &result, sizeof(result), compute);
+
+  EXPECT_EQ(computed, 2);
+  EXPECT_EQ(cache.bytes(), size_t(0));
+  EXPECT_EQ(cache.hits() + cache.misses(), size_t(0));
+}
+
+TEST(ReferenceCache, hits_and_misses) {
+
+  ReferenceCache cache;
+  cache.set_enabled(true);
+
+  int computed = 0;
+  int result = 0;
+  auto compute = [&]() {
+    result = 42 + computed++;
+    return cutlass::Status::kSuccess;
+  };
+
+  EXPECT_EQ(cache.cached(key_of(1), &result, sizeof(result), compute), cutlass::Status::kSuccess);
+  result = 0;
+  EXPECT_EQ(cache.cached(key_of(1), &result, sizeof(result), compute), cutlass::Status::kSuccess);
+
+  EXPECT_EQ(computed, 1);
+  EXPECT_EQ(result, 42);
+  EXPECT_EQ(cache.misses(), size_t(1));
+  EXPECT_EQ(cache.hits(), size_t(1));
+
+  // An entry of another size does not match
+  int64_t wide = 0;
+  EXPECT_FALSE(cache.find(key_of(1), &wide, sizeof(wide)));
+  EXPECT_EQ(cache.misses(), size_t(2));
+
+  // Failed computations are not cached
+  auto fail = [&]() {
+    ++computed;
+    return cutlass::Status::kErrorInternal;
+  };
+  EXPECT_EQ(cache.cached(key_of(2), &result, sizeof(result), fail), cutlass::Status::kErrorInternal);
+  EXPECT_EQ(cache.cached(key_of(2), &result, sizeof(result), fail), cutlass::Status::kErrorInternal);
+  EXPECT_EQ(computed, 3);
+
+  cache.clear();
+  EXPECT_EQ(cache.hits(), size_t(0));
+  EXPECT_EQ(cache.misses(), size_t(0));
+  EXPECT_EQ(cache.bytes(), size_t(0));
+  EXPECT_FALSE(cache.find(key_of(1), &result, sizeof(result)));
+}
+
+TEST(ReferenceCache, evicts_least_recently_used_by_bytes) {
+
+  ReferenceCache cache;
+  cache.set_enabled(true);
+  cache.set_capacity(3000);
+
+  std::vector<uint8_t> entry(1000);
+  for (int id = 0; id < 3; ++id) {
+    cache.insert(key_of(id), entry.data(), entry.size());
+  }
+  EXPECT_EQ(cache.bytes(), size_t(3000));
+
+  // Using entry 0 leaves entry 1 as the least recently used
+  EXPECT_TRUE(cache.find(key_of(0), entry.data(), entry.size()));
+
+  std::vector<uint8_t> larger(1500);
+  cache.insert(key_of(3), larger.data(), larger.size());
+
+  EXPECT_EQ(cache.bytes(), size_t(2500));
+  EXPECT_TRUE(cache.find(key_of(0), entry.data(), entry.size()));
+  EXPECT_FALSE(cache.find(key_of(1), entry.data(), entry.size()));
+  EXPECT_FALSE(cache.find(key_of(2), entry.data(), entry.size()));
+  EXPECT_TRUE(cache.find(key_of(3), larger.data(), larger.size()));
+
+  // Entries larger than the capacity are never held
+  std::vector<uint8_t> huge(4000);
+  cache.insert(key_of(4), huge.data(), huge.size());
+  EXPECT_FALSE(cache.find(key_of(4), huge.data(), huge.size()));
+  EXPECT_EQ(cache.bytes(), size_t(2500));
+
+  // Shrinking the capacity evicts down to it, least recently used first
+  EXPECT_TRUE(cache.find(key_of(0), entry.data(), entry.size()));
+  cache.set_capacity(1000);
+  EXPECT_EQ(cache.bytes(), size_t(1000));
+  EXPECT_TRUE(cache.find(key_of(0), entry.data(), entry.size()));
+  EXPECT_FALSE(cache.find(key_of(3), larger.data(), larger.size()));
+}
+
+TEST(ReferenceCache, directory_round_trip) {
+
+  std::string directory = ::testing::TempDir() + "cutlass_test_reference_cache";
+
+  std::vector<uint8_t> data(333);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = uint8_t(i);
+  }
+  ReferenceCache::Key key = key_of(data);
+
+  {
+    ReferenceCache writer;
+    writer.set_enabled(true);
+    writer.set_directory(directory);
+    writer.insert(key, data.data(), data.size());
+  }
+
+  // A cache with no in-memory entries finds the entry on disk and then holds it in memory
+  ReferenceCache reader;
+  reader.set_enabled(true);
+  reader.set_directory(directory);
+
+  std::vector<uint8_t> result(data.size());
+  EXPECT_FALSE(reader.find(key, result.data(), result.size() - 1));
+  EXPECT_TRUE(reader.find(key, result.data(), result.size()));
+  EXPECT_TRUE(result == data);
+  EXPECT_EQ(reader.bytes(), data.size());
+  EXPECT_EQ(reader.hits(), size_t(1));
+  EXPECT_EQ(reader.misses(), size_t(1));
+
+  std::remove((directory + "/" + key.to_string() + ".ref").c_str());
+  std::remove(directory.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
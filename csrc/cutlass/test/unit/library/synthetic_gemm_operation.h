@@ -0,0 +1,130 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief GEMM operation descriptions for tests of the manifest, operation selection and indexing
+*/
+
+#pragma once
+
+#include <string>
+
+#include "cutlass/library/library.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// F16 column-major GEMM operation with a given name, tile shape, alignment and compute capability
+/// range that is only ever described, never run
+class SyntheticGemmOperation : public cutlass::library::Operation {
+public:
+
+  SyntheticGemmOperation(
+    std::string const &name,
+    int tile_m,
+    int tile_n,
+    int tile_k,
+    int alignment = 8,
+    int min_cc = 0,
+    int max_cc = 1024):
+    name_(name) {
+
+    using namespace cutlass::library;
+
+    desc_.name = name_.c_str();
+    desc_.provider = Provider::kCUTLASS;
+    desc_.kind = OperationKind::kGemm;
+    desc_.gemm_kind = GemmKind::kUniversal;
+    desc_.element_epilogue = NumericTypeID::kF32;
+    desc_.tile_description.threadblock_shape = cutlass::gemm::GemmCoord(tile_m, tile_n, tile_k);
+    desc_.tile_description.threadblock_stages = 3;
+    desc_.tile_description.minimum_compute_capability = min_cc;
+    desc_.tile_description.maximum_compute_capability = max_cc;
+    desc_.tile_description.math_instruction.element_accumulator = NumericTypeID::kF32;
+    desc_.tile_description.math_instruction.opcode_class = OpcodeClassID::kTensorOp;
+    desc_.A = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kColumnMajor, alignment);
+    desc_.B = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kColumnMajor, alignment);
+    desc_.C = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kColumnMajor, alignment);
+    desc_.D = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kColumnMajor, alignment);
+
+    ++constructed();
+  }
+
+  /// Number of operations constructed, for tests of when operations are constructed
+  static int &constructed() {
+    static int count = 0;
+    return count;
+  }
+
+  /// Describes the operation as another kind, for tests of filters by kind
+  void set_kind(cutlass::library::OperationKind kind) {
+    desc_.kind = kind;
+  }
+
+  /// Describes the operands as another element type, for tests of functional keys
+  void set_element(cutlass::library::NumericTypeID element) {
+    desc_.A.element = element;
+    desc_.B.element = element;
+    desc_.C.element = element;
+    desc_.D.element = element;
+  }
+
+  cutlass::library::OperationDescription const & description() const override { return desc_; }
+
+  cutlass::Status can_implement(void const *, void const *) const override { return cutlass::Status::kSuccess; }
+
+  uint64_t get_host_workspace_size(void const *) const override { return 0; }
+
+  uint64_t get_device_workspace_size(void const *, void const *) const override { return 0; }
+
+  cutlass::Status initialize(void const *, void *, void *, cudaStream_t) const override {
+    return cutlass::Status::kErrorNotSupported;
+  }
+
+  cutlass::Status run(void const *, void *, void *, cudaStream_t) const override {
+    return cutlass::Status::kErrorNotSupported;
+  }
+
+private:
+
+  std::string name_;
+  cutlass::library::GemmDescription desc_;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,220 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/profiler/results_database.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::profiler;
+
+/// Database recorded by a baseline run of two GEMM operations on one problem
+char const *kBaselineFixture =
+  "# cutlass_profiler results v1\n"
+  "2024-05-01T10:00:00Z\tNVIDIA A100 (sm_80)\tCUTLASS\tgemm_a\t--k=4096 --m=4096 --n=4096\t1.0\t"
+    "1.00,1.01,0.99,1.02,0.98,1.00,1.01,0.99\n"
+  "2024-05-01T10:00:00Z\tNVIDIA A100 (sm_80)\tCUTLASS\tgemm_b\t--k=4096 --m=4096 --n=4096\t2.0\t"
+    "2.00,2.02,1.98,2.01,1.99,2.00,2.03,1.97\n"
+  "2024-05-01T10:00:00Z\tNVIDIA A100 (sm_80)\tCUTLASS\tgemm_c\t--k=4096 --m=4096 --n=4096\t3.0\t"
+    "3.00,3.01,2.99,3.02,2.98,3.00,3.01,2.99\n"
+  "\n"
+  "# cutlass_profiler results v1\n"
+  "2024-05-02T10:00:00Z\tNVIDIA A100 (sm_80)\tCUTLASS\tgemm_a\t--k=4096 --m=4096 --n=4096\t1.0\t"
+    "1.00,1.02,0.98,1.01,0.99,1.00,1.01,0.99\n";
+
+ResultRecord make_record(std::string const &operation, std::vector<double> const &samples) {
+
+  ResultRecord record;
+
+  record.timestamp = "2024-05-03T10:00:00Z";
+  record.device = "NVIDIA A100 (sm_80)";
+  record.provider = "CUTLASS";
+  record.operation = operation;
+  record.problem = ResultRecord::problem_string({{"n", "4096"}, {"m", "4096"}, {"k", "4096"}, {"split_k_mode", ""}});
+  record.samples = samples;
+  record.runtime = SampleStatistics::compute(samples).mean;
+
+  return record;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ProfilerResultsDatabase, problem_string) {
+
+  EXPECT_EQ(
+    ResultRecord::problem_string({{"n", "64"}, {"m", "32"}, {"A", "f16:column"}, {"beta", ""}}),
+    std::string("--A=f16:column --m=32 --n=64"));
+}
+
+TEST(ProfilerResultsDatabase, load_fixture) {
+
+  std::istringstream in(kBaselineFixture);
+
+  ResultsDatabase database;
+  EXPECT_EQ(database.load(in), 4);
+  EXPECT_EQ(database.size(), size_t(4));
+
+  ResultRecord const *latest = database.find(ResultsDatabase::key(make_record("gemm_a", {})));
+  ASSERT_NE(latest, nullptr);
+  EXPECT_EQ(latest->timestamp, std::string("2024-05-02T10:00:00Z"));
+  EXPECT_EQ(latest->samples.size(), size_t(8));
+
+  auto const *history = database.history(ResultsDatabase::key(make_record("gemm_a", {})));
+  ASSERT_NE(history, nullptr);
+  EXPECT_EQ(history->size(), size_t(2));
+  EXPECT_EQ(history->front().timestamp, std::string("2024-05-01T10:00:00Z"));
+
+  EXPECT_EQ(database.find(ResultsDatabase::key(make_record("gemm_d", {}))), nullptr);
+}
+
+TEST(ProfilerResultsDatabase, reject_malformed) {
+
+  ResultsDatabase database;
+
+  std::istringstream no_header("2024-05-01T10:00:00Z\tdevice\tCUTLASS\tgemm_a\t--m=1\t1.0\t\n");
+  EXPECT_EQ(database.load(no_header), -1);
+
+  std::istringstream bad_runtime(
+    "# cutlass_profiler results v1\n"
+    "2024-05-01T10:00:00Z\tdevice\tCUTLASS\tgemm_a\t--m=1\tfast\t\n");
+  EXPECT_EQ(database.load(bad_runtime), -1);
+
+  std::istringstream missing_field(
+    "# cutlass_profiler results v1\n"
+    "2024-05-01T10:00:00Z\tdevice\tCUTLASS\tgemm_a\t1.0\n");
+  EXPECT_EQ(database.load(missing_field), -1);
+}
+
+TEST(ProfilerResultsDatabase, write_and_load) {
+
+  std::vector<ResultRecord> records = {
+    make_record("gemm_a", {0.5, 0.25, 0.125}),
+    make_record("gemm_b", {})
+  };
+  records[1].operation = "gemm\twith\ttabs";
+  records[1].runtime = 3.5;
+
+  std::stringstream stream;
+  ResultsDatabase::write_header(stream);
+  for (auto const &record : records) {
+    ResultsDatabase::write(stream, record);
+  }
+
+  ResultsDatabase database;
+  EXPECT_EQ(database.load(stream), 2);
+
+  ResultRecord const *a = database.find(ResultsDatabase::key(records[0]));
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(a->samples, records[0].samples);
+  EXPECT_EQ(a->problem, records[0].problem);
+
+  records[1].operation = "gemm with tabs";
+  ResultRecord const *b = database.find(ResultsDatabase::key(records[1]));
+  ASSERT_NE(b, nullptr);
+  EXPECT_DOUBLE_EQ(b->runtime, 3.5);
+  EXPECT_TRUE(b->samples.empty());
+}
+
+TEST(ProfilerResultsDatabase, rank_sum_test) {
+
+  // Disjoint samples: U = 0, z = 12 / sqrt(275 / 12)
+  EXPECT_NEAR(rank_sum_test({1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}), 0.01218, 1e-4);
+
+  // Interleaved samples are indistinguishable
+  EXPECT_GT(rank_sum_test({1, 3, 5, 7, 9}, {2, 4, 6, 8, 10}), 0.5);
+
+  // Fully tied samples carry no evidence
+  EXPECT_DOUBLE_EQ(rank_sum_test({1, 1, 1}, {1, 1, 1}), 1.0);
+  EXPECT_DOUBLE_EQ(rank_sum_test({}, {1, 2}), 1.0);
+}
+
+TEST(ProfilerResultsDatabase, compare_fixture) {
+
+  std::istringstream in(kBaselineFixture);
+
+  ResultsDatabase baseline;
+  ASSERT_EQ(baseline.load(in), 4);
+
+  std::vector<ResultRecord> current = {
+    // 10% slower
+    make_record("gemm_a", {1.10, 1.11, 1.09, 1.12, 1.08, 1.10, 1.11, 1.09}),
+    // 10% faster
+    make_record("gemm_b", {1.80, 1.82, 1.78, 1.81, 1.79, 1.80, 1.83, 1.77}),
+    // Within noise
+    make_record("gemm_c", {3.01, 2.99, 3.00, 3.02, 2.98, 3.00, 3.01, 2.99}),
+    // Not in the baseline
+    make_record("gemm_d", {1.0, 1.0, 1.0, 1.0, 1.0})
+  };
+
+  std::vector<ResultComparison> comparisons = compare_results(current, baseline, ComparisonOptions(0.02, 0.01));
+
+  ASSERT_EQ(comparisons.size(), size_t(4));
+
+  EXPECT_EQ(comparisons[0].verdict, ComparisonVerdict::kRegression);
+  EXPECT_NEAR(comparisons[0].change, 0.10, 1e-6);
+  EXPECT_LT(comparisons[0].p_value, 0.01);
+  EXPECT_EQ(comparisons[0].baseline.timestamp, std::string("2024-05-02T10:00:00Z"));
+
+  EXPECT_EQ(comparisons[1].verdict, ComparisonVerdict::kImprovement);
+  EXPECT_EQ(comparisons[2].verdict, ComparisonVerdict::kUnchanged);
+  EXPECT_EQ(comparisons[3].verdict, ComparisonVerdict::kNew);
+
+  std::ostringstream out;
+  print_comparisons(out, comparisons);
+
+  EXPECT_NE(out.str().find("regression: 1"), std::string::npos);
+  EXPECT_EQ(out.str().find("gemm_c"), std::string::npos);
+}
+
+TEST(ProfilerResultsDatabase, compare_thresholds) {
+
+  ResultRecord baseline = make_record("gemm_a", {1.00, 1.01, 0.99, 1.00, 1.01, 0.99, 1.00, 1.01});
+
+  // Significant, but smaller than the threshold
+  ResultRecord slightly_slower = make_record("gemm_a", {1.01, 1.02, 1.00, 1.01, 1.02, 1.00, 1.01, 1.02});
+  EXPECT_EQ(compare_result(slightly_slower, &baseline, ComparisonOptions(0.02, 0.01)).verdict, ComparisonVerdict::kUnchanged);
+  EXPECT_EQ(compare_result(slightly_slower, &baseline, ComparisonOptions(0.005, 0.05)).verdict, ComparisonVerdict::kRegression);
+
+  // Too few samples to test the change
+  ResultRecord unsampled = make_record("gemm_a", {1.5, 1.5});
+  EXPECT_EQ(compare_result(unsampled, &baseline).verdict, ComparisonVerdict::kInconclusive);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
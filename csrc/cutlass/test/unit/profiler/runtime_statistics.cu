@@ -0,0 +1,182 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/profiler/runtime_statistics.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::profiler;
+
+/// Runtimes of a kernel taking 1 ms with normally distributed noise of the given relative size
+std::vector<double> make_samples(size_t count, double noise, unsigned seed = 2024) {
+
+  std::mt19937 generator(seed);
+  std::normal_distribution<double> distribution(1.0, noise);
+
+  std::vector<double> samples;
+  for (size_t i = 0; i < count; ++i) {
+    samples.push_back(distribution(generator));
+  }
+
+  return samples;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ProfilerRuntimeStatistics, order_statistics) {
+
+  std::vector<double> samples;
+  for (int i = 10; i >= 1; --i) {
+    samples.push_back(double(i));
+  }
+
+  RuntimeStatistics stats = RuntimeStatistics::compute(samples);
+
+  EXPECT_EQ(stats.count, size_t(10));
+  EXPECT_EQ(stats.rejected, size_t(0));
+  EXPECT_DOUBLE_EQ(stats.min, 1.0);
+  EXPECT_DOUBLE_EQ(stats.median, 5.5);
+  EXPECT_DOUBLE_EQ(stats.p90, 9.1);
+
+  // Ranks 2 and 9 bound the median of 10 samples with 95% confidence
+  EXPECT_DOUBLE_EQ(stats.median_lower, 2.0);
+  EXPECT_DOUBLE_EQ(stats.median_upper, 9.0);
+  EXPECT_NEAR(stats.relative_width(), 7.0 / 5.5, 1e-12);
+}
+
+TEST(ProfilerRuntimeStatistics, empty) {
+
+  RuntimeStatistics stats = RuntimeStatistics::compute({});
+
+  EXPECT_EQ(stats.count, size_t(0));
+  EXPECT_TRUE(std::isinf(stats.relative_width()));
+}
+
+TEST(ProfilerRuntimeStatistics, rejects_outliers) {
+
+  std::vector<double> samples = make_samples(200, 0.01);
+
+  // Iterations disturbed by a clock change
+  samples[50] = 1.4;
+  samples[51] = 1.5;
+  samples[120] = 0.6;
+
+  RuntimeStatistics stats = RuntimeStatistics::compute(samples);
+
+  EXPECT_EQ(stats.rejected, size_t(3));
+  EXPECT_EQ(stats.count, size_t(197));
+  EXPECT_GT(stats.min, 0.9);
+  EXPECT_LT(stats.p90, 1.05);
+  EXPECT_NEAR(stats.median, 1.0, 0.005);
+  EXPECT_LE(stats.median_lower, stats.median);
+  EXPECT_GE(stats.median_upper, stats.median);
+
+  // Identical samples are all kept
+  stats = RuntimeStatistics::compute(std::vector<double>(20, 2.0));
+
+  EXPECT_EQ(stats.rejected, size_t(0));
+  EXPECT_DOUBLE_EQ(stats.relative_width(), 0.0);
+}
+
+TEST(ProfilerRuntimeSampler, fixed_iterations) {
+
+  RuntimeSampler sampler(100);
+
+  EXPECT_EQ(sampler.next_batch(), 100);
+
+  sampler.add(make_samples(100, 0.5));
+
+  EXPECT_EQ(sampler.next_batch(), 0);
+  EXPECT_EQ(sampler.samples().size(), size_t(100));
+}
+
+TEST(ProfilerRuntimeSampler, stops_when_converged) {
+
+  std::vector<double> samples = make_samples(100000, 0.02);
+
+  RuntimeSampler sampler(0, 0.01, 1.0e6);
+
+  size_t count = 0;
+  for (int batch = sampler.next_batch(); batch > 0; batch = sampler.next_batch()) {
+    sampler.add(std::vector<double>(samples.begin() + count, samples.begin() + count + batch));
+    count += size_t(batch);
+  }
+
+  EXPECT_TRUE(sampler.converged());
+  EXPECT_LE(sampler.statistics().relative_width(), 0.01);
+
+  // Doubling batches overshoot the needed number of samples by at most a factor of two
+  EXPECT_GE(count, size_t(10));
+  EXPECT_LT(count, size_t(2000));
+}
+
+TEST(ProfilerRuntimeSampler, stops_at_duration) {
+
+  // Noisy kernel taking 1 ms with a budget of 50 ms
+  std::vector<double> samples = make_samples(100000, 0.5);
+
+  RuntimeSampler sampler(0, 0.001, 50);
+
+  size_t count = 0;
+  for (int batch = sampler.next_batch(); batch > 0; batch = sampler.next_batch()) {
+    sampler.add(std::vector<double>(samples.begin() + count, samples.begin() + count + batch));
+    count += size_t(batch);
+  }
+
+  EXPECT_FALSE(sampler.converged());
+  EXPECT_GE(count, size_t(45));
+  EXPECT_LE(count, size_t(60));
+}
+
+TEST(ProfilerRuntimeSampler, long_kernel) {
+
+  // A kernel taking longer than the budget is profiled for the minimum number of iterations
+  RuntimeSampler sampler(0, 0.01, 1000, 10);
+
+  EXPECT_EQ(sampler.next_batch(), 10);
+
+  sampler.add(std::vector<double>(10, 500.0));
+
+  EXPECT_EQ(sampler.next_batch(), 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,237 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/profiler/sweep.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::profiler;
+
+/// Path of a temporary file removed when the object goes out of scope
+struct TemporaryFile {
+  std::string path;
+
+  explicit TemporaryFile(char const *name):
+    path((std::filesystem::temp_directory_path() / name).string()) {
+    std::remove(path.c_str());
+  }
+
+  ~TemporaryFile() {
+    std::remove(path.c_str());
+  }
+
+  std::string contents() const {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+};
+
+char const *kReportHeader =
+  "Problem,Provider,OperationKind,Operation,Disposition,Status,m,n,k,Bytes,Flops,Flops/Byte,Runtime,GB/s,GFLOPs";
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ProfilerSweep, parse_shard) {
+
+  SweepShard shard;
+
+  EXPECT_TRUE(SweepShard::parse("2/8", shard));
+  EXPECT_EQ(shard.index, 2);
+  EXPECT_EQ(shard.count, 8);
+
+  EXPECT_FALSE(SweepShard::parse("8/8", shard));
+  EXPECT_FALSE(SweepShard::parse("-1/4", shard));
+  EXPECT_FALSE(SweepShard::parse("1/0", shard));
+  EXPECT_FALSE(SweepShard::parse("1", shard));
+  EXPECT_FALSE(SweepShard::parse("1/4x", shard));
+  EXPECT_FALSE(SweepShard::parse("/4", shard));
+}
+
+TEST(ProfilerSweep, shards_partition_pairs) {
+
+  int const kShards = 4;
+
+  std::vector<int> assigned(kShards, 0);
+
+  for (int op = 0; op < 50; ++op) {
+    for (int m = 128; m <= 4096; m *= 2) {
+
+      std::string operation = "cutlass_tensorop_gemm_" + std::to_string(op);
+      std::string problem = "m: " + std::to_string(m) + "; n: 4096; k: 4096";
+
+      // Each pair is assigned to exactly one shard
+      int count = 0;
+      for (int index = 0; index < kShards; ++index) {
+        if (SweepShard(index, kShards).contains(operation, problem)) {
+          ++assigned[index];
+          ++count;
+        }
+      }
+      EXPECT_EQ(count, 1);
+
+      EXPECT_TRUE(SweepShard().contains(operation, problem));
+    }
+  }
+
+  // 300 pairs are spread roughly evenly
+  for (int index = 0; index < kShards; ++index) {
+    EXPECT_GT(assigned[index], 40);
+  }
+}
+
+TEST(ProfilerSweep, checkpoint_resumes) {
+
+  TemporaryFile file("cutlass_test_sweep_checkpoint.txt");
+
+  {
+    SweepCheckpoint checkpoint;
+    ASSERT_TRUE(checkpoint.open(file.path));
+    EXPECT_EQ(checkpoint.size(), size_t(0));
+
+    checkpoint.record("gemm_a", "m: 128");
+    checkpoint.record("gemm_b", "m: 128");
+    checkpoint.record("gemm_a", "m: 128");
+  }
+
+  // Simulates a crash while recording a pair
+  {
+    std::ofstream out(file.path, std::ios::app);
+    out << "gemm_c\tm: 1";
+  }
+
+  {
+    SweepCheckpoint checkpoint;
+    ASSERT_TRUE(checkpoint.open(file.path));
+    EXPECT_EQ(checkpoint.size(), size_t(2));
+    EXPECT_TRUE(checkpoint.completed("gemm_a", "m: 128"));
+    EXPECT_TRUE(checkpoint.completed("gemm_b", "m: 128"));
+    EXPECT_FALSE(checkpoint.completed("gemm_a", "m: 256"));
+    EXPECT_FALSE(checkpoint.completed("gemm_c", "m: 1"));
+
+    checkpoint.record("gemm_c", "m: 128");
+  }
+
+  SweepCheckpoint checkpoint;
+  ASSERT_TRUE(checkpoint.open(file.path));
+  EXPECT_EQ(checkpoint.size(), size_t(3));
+  EXPECT_TRUE(checkpoint.completed("gemm_c", "m: 128"));
+
+  // Files that are not checkpoints are not overwritten
+  TemporaryFile other("cutlass_test_sweep_not_checkpoint.txt");
+  {
+    std::ofstream out(other.path);
+    out << kReportHeader << "\n";
+  }
+
+  EXPECT_FALSE(SweepCheckpoint().open(other.path));
+  EXPECT_EQ(other.contents(), std::string(kReportHeader) + "\n");
+}
+
+TEST(ProfilerSweep, merge_reports) {
+
+  std::string header(kReportHeader);
+
+  std::istringstream shard0(
+    header + "\n" +
+    "1,CUTLASS,gemm,gemm_a,passed,success,128,128,128,1,2,2,0.1,1,1\n"
+    "2,CUTLASS,gemm,gemm_a,passed,success,256,256,256,1,2,2,0.2,1,1\n");
+
+  // A resumed shard appends a header and repeats a result whose pair was not recorded
+  std::istringstream shard1(
+    header + "\n" +
+    "1,CUTLASS,gemm,gemm_b,passed,success,256,256,256,1,2,2,0.3,1,1\n"
+    "1,CUTLASS,gemm,gemm_b,passed,success,256,256,256,1,2,2,0.4,1,1\n" +
+    header + "\n" +
+    "1,CUTLASS,gemm,gemm_b,passed,success,128,128,128,1,2,2,0.5,1,1\n"
+    "1,CUTLASS,gemm,gemm_b,passed,succ");
+
+  std::istringstream empty_shard("");
+
+  std::ostringstream merged;
+  std::string error;
+
+  int rows = merge_reports({&shard0, &shard1, &empty_shard}, merged, &error);
+
+  EXPECT_EQ(rows, 4) << error;
+  EXPECT_EQ(merged.str(),
+    header + "\n" +
+    "1,CUTLASS,gemm,gemm_a,passed,success,128,128,128,1,2,2,0.1,1,1\n"
+    "2,CUTLASS,gemm,gemm_a,passed,success,256,256,256,1,2,2,0.2,1,1\n"
+    "2,CUTLASS,gemm,gemm_b,passed,success,256,256,256,1,2,2,0.4,1,1\n"
+    "1,CUTLASS,gemm,gemm_b,passed,success,128,128,128,1,2,2,0.5,1,1\n");
+
+  // Reports of different operation kinds are not merged
+  std::istringstream gemm(header + "\n");
+  std::istringstream conv("Problem,Provider,OperationKind,Operation,Disposition,Status,n,h,w,Bytes\n");
+
+  EXPECT_EQ(merge_reports({&gemm, &conv}, merged, &error), -1);
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(ProfilerSweep, merge_report_files) {
+
+  TemporaryFile shard0("cutlass_test_sweep_shard0.gemm.csv");
+  TemporaryFile shard1("cutlass_test_sweep_shard1.gemm.csv");
+  TemporaryFile output("cutlass_test_sweep_merged.gemm.csv");
+
+  std::string header(kReportHeader);
+
+  std::ofstream(shard0.path) << header << "\n"
+    << "1,CUTLASS,gemm,gemm_a,passed,success,128,128,128,1,2,2,0.1,1,1\n";
+  std::ofstream(shard1.path) << header << "\n"
+    << "1,CUTLASS,gemm,gemm_b,passed,success,128,128,128,1,2,2,0.2,1,1\n";
+
+  EXPECT_EQ(merge_reports({shard0.path, shard1.path}, output.path), 2);
+  EXPECT_EQ(output.contents(), header + "\n" +
+    "1,CUTLASS,gemm,gemm_a,passed,success,128,128,128,1,2,2,0.1,1,1\n"
+    "1,CUTLASS,gemm,gemm_b,passed,success,128,128,128,1,2,2,0.2,1,1\n");
+
+  std::string error;
+  EXPECT_EQ(merge_reports({shard0.path, shard0.path + ".missing"}, output.path, &error), -1);
+  EXPECT_NE(error.find(".missing"), std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
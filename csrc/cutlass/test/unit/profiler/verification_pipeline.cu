@@ -0,0 +1,183 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/profiler/verification_pipeline.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::profiler;
+
+/// Results of one operation with a single result awaiting host verification
+PerformanceResultVector make_results(std::string const &operation) {
+
+  PerformanceResult result;
+
+  result.operation_name = operation;
+  result.disposition = Disposition::kNotVerified;
+  result.verification_map[cutlass::library::Provider::kReferenceHost] = Disposition::kNotVerified;
+
+  return PerformanceResultVector{result};
+}
+
+DeferredVerificationVector make_verification(size_t bytes, std::function<Disposition()> verify) {
+  return DeferredVerificationVector{
+    DeferredVerification{0, cutlass::library::Provider::kReferenceHost, bytes, std::move(verify)}};
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ProfilerVerificationPipeline, update_disposition) {
+
+  PerformanceResult result;
+
+  result.verification_map[cutlass::library::Provider::kReferenceHost] = Disposition::kPassed;
+  result.verification_map[cutlass::library::Provider::kCUBLAS] = Disposition::kNotSupported;
+  update_disposition(result);
+  EXPECT_EQ(result.disposition, Disposition::kPassed);
+
+  result.verification_map[cutlass::library::Provider::kCUBLAS] = Disposition::kIncorrect;
+  update_disposition(result);
+  EXPECT_EQ(result.disposition, Disposition::kIncorrect);
+}
+
+TEST(ProfilerVerificationPipeline, reports_in_submission_order) {
+
+  std::vector<std::pair<std::string, size_t>> reported;
+  std::vector<Disposition> dispositions;
+
+  VerificationPipeline pipeline(4, size_t(1) << 20,
+    [&](PerformanceResultVector const &results, size_t problem_index) {
+      reported.emplace_back(results.front().operation_name, problem_index);
+      dispositions.push_back(results.front().disposition);
+    });
+
+  // Earlier verifications take longer, so they complete after later ones
+  for (int i = 0; i < 8; ++i) {
+    pipeline.submit(
+      make_results("gemm_" + std::to_string(i)),
+      size_t(i / 4),
+      make_verification(16, [i]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 * (8 - i)));
+        return i == 5 ? Disposition::kIncorrect : Disposition::kPassed;
+      }));
+  }
+
+  // Results without deferred verifications are reported once preceding results are
+  pipeline.submit(make_results("gemm_unverified"), 2, DeferredVerificationVector());
+
+  pipeline.finish();
+
+  ASSERT_EQ(reported.size(), size_t(9));
+
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(reported[i].first, "gemm_" + std::to_string(i));
+    EXPECT_EQ(reported[i].second, size_t(i / 4));
+    EXPECT_EQ(dispositions[i], i == 5 ? Disposition::kIncorrect : Disposition::kPassed);
+  }
+
+  EXPECT_EQ(reported[8].first, "gemm_unverified");
+  EXPECT_EQ(dispositions[8], Disposition::kNotVerified);
+}
+
+TEST(ProfilerVerificationPipeline, failed_verification) {
+
+  Disposition disposition = Disposition::kInvalid;
+
+  VerificationPipeline pipeline(1, size_t(1) << 20,
+    [&](PerformanceResultVector const &results, size_t) {
+      disposition = results.front().verification_map.at(cutlass::library::Provider::kReferenceHost);
+    });
+
+  pipeline.submit(make_results("gemm"), 0, make_verification(16, []() -> Disposition {
+    throw std::runtime_error("out of memory");
+  }));
+
+  pipeline.finish();
+
+  EXPECT_EQ(disposition, Disposition::kFailed);
+}
+
+TEST(ProfilerVerificationPipeline, bounded_capacity) {
+
+  std::atomic<size_t> queued_bytes(0);
+  std::atomic<size_t> max_queued_bytes(0);
+  size_t reported = 0;
+
+  VerificationPipeline pipeline(2, 64,
+    [&](PerformanceResultVector const &, size_t) {
+      ++reported;
+    });
+
+  for (int i = 0; i < 16; ++i) {
+
+    // Submitting blocks until the bytes of queued verifications fit the capacity
+    size_t bytes = queued_bytes += 32;
+    size_t max_bytes = max_queued_bytes;
+    while (bytes > max_bytes && !max_queued_bytes.compare_exchange_weak(max_bytes, bytes)) { }
+
+    pipeline.submit(make_results("gemm"), 0, make_verification(32, [&queued_bytes]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      queued_bytes -= 32;
+      return Disposition::kPassed;
+    }));
+  }
+
+  pipeline.finish();
+
+  EXPECT_EQ(reported, size_t(16));
+  EXPECT_LE(max_queued_bytes.load(), size_t(64 + 32));
+
+  // A verification larger than the capacity still runs
+  pipeline.submit(make_results("gemm"), 0, make_verification(128, []() {
+    return Disposition::kPassed;
+  }));
+
+  pipeline.finish();
+
+  EXPECT_EQ(reported, size_t(17));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,136 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <cstdint>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/util/host_memory.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostMemory, allocation_alignment_and_zero_fill) {
+
+  for (size_t alignment : {size_t(1), size_t(64), size_t(100), size_t(4096)}) {
+    for (bool first_touch : {false, true}) {
+      cutlass::HostAllocationPolicy policy(alignment, false, first_touch);
+      cutlass::HostAllocation<float> allocation(100003, policy);
+
+      EXPECT_EQ(allocation.size(), size_t(100003));
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation.get()) % policy.alignment_for(1), 0u);
+      EXPECT_GE(policy.alignment_for(1), alignment);
+
+      size_t nonzero = 0;
+      for (size_t i = 0; i < allocation.size(); ++i) {
+        nonzero += (allocation.get()[i] != 0.0f);
+      }
+      EXPECT_EQ(nonzero, 0u);
+    }
+  }
+
+  // Huge-page policies align large allocations to huge pages
+  cutlass::HostAllocationPolicy huge(64, true);
+  cutlass::HostAllocation<uint8_t> large(cutlass::HostAllocationPolicy::kHugePageSize, huge);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(large.get()) % cutlass::HostAllocationPolicy::kHugePageSize, 0u);
+}
+
+TEST(HostMemory, arena_reuse) {
+
+  cutlass::HostArena arena;
+  cutlass::HostAllocationPolicy policy;
+
+  float *first = nullptr;
+  {
+    cutlass::HostAllocation<float> allocation(1000, policy, &arena);
+    first = allocation.get();
+    allocation.get()[7] = 3.0f;
+  }
+  EXPECT_EQ(arena.misses(), 1u);
+  EXPECT_GE(arena.cached_bytes(), 1000 * sizeof(float));
+
+  // A somewhat smaller request reuses the block and is zero-initialized again
+  {
+    cutlass::HostAllocation<float> allocation(700, policy, &arena);
+    EXPECT_EQ(allocation.get(), first);
+    EXPECT_EQ(allocation.get()[7], 0.0f);
+  }
+  EXPECT_EQ(arena.hits(), 1u);
+
+  // Much smaller requests and stricter alignment do not
+  {
+    cutlass::HostAllocation<float> small(100, policy, &arena);
+    EXPECT_NE(small.get(), first);
+
+    cutlass::HostAllocation<float> aligned(1000, cutlass::HostAllocationPolicy(8192), &arena);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.get()) % 8192, 0u);
+  }
+  EXPECT_EQ(arena.hits(), 1u);
+
+  arena.trim();
+  EXPECT_EQ(arena.cached_bytes(), 0u);
+}
+
+TEST(HostMemory, host_tensor_arena) {
+
+  cutlass::HostArena arena;
+
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::RowMajor> tensor;
+  tensor.set_host_allocation(cutlass::HostAllocationPolicy(4096), &arena);
+
+  std::vector<cutlass::half_t *> pointers;
+  for (int problem = 0; problem < 4; ++problem) {
+    tensor.reset({96 - problem * 8, 80}, false);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(tensor.host_data()) % 4096, 0u);
+    EXPECT_FALSE(tensor.device_backed());
+
+    cutlass::reference::host::TensorFillRandomUniform(tensor.host_view(), problem, 4, -4, 0);
+    pointers.push_back(tensor.host_data());
+  }
+  EXPECT_EQ(arena.misses(), 1u);
+  EXPECT_EQ(arena.hits(), 3u);
+  EXPECT_EQ(pointers[0], pointers[3]);
+
+  // Copies share the placement and arena of the source
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::RowMajor> copy(tensor);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(copy.host_data()) % 4096, 0u);
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(copy.host_view(), tensor.host_view()));
+
+  copy.reset();
+  EXPECT_EQ(arena.misses(), 2u);
+  EXPECT_GT(arena.cached_bytes(), 0u);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,186 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <cstring>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/numeric_types.h"
+#include "cutlass/util/host_numeric_conversion.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Instruction sets available on this processor, narrowest first
+std::vector<cutlass::HostSimdIsa> available_isas() {
+  std::vector<cutlass::HostSimdIsa> isas = {cutlass::HostSimdIsa::kScalar};
+
+  if (int(cutlass::host_simd_isa()) >= int(cutlass::HostSimdIsa::kAvx2)) {
+    isas.push_back(cutlass::HostSimdIsa::kAvx2);
+  }
+  if (int(cutlass::host_simd_isa()) >= int(cutlass::HostSimdIsa::kAvx512)) {
+    isas.push_back(cutlass::HostSimdIsa::kAvx512);
+  }
+  return isas;
+}
+
+/// fp32 inputs covering every sign, exponent and upper mantissa bit pattern, each paired with
+/// low-order bits below, at and above the rounding points of 16-bit and 8-bit destinations
+std::vector<float> float_sweep() {
+  uint32_t const low_bits[] = {
+    0x0000, 0x0001, 0x0fff, 0x1000, 0x1001, 0x2000, 0x3000, 0x7fff, 0x8000, 0x8001, 0xffff
+  };
+
+  std::vector<float> values;
+  for (uint32_t high = 0; high < 0x10000; ++high) {
+    for (uint32_t low : low_bits) {
+      uint32_t bits = (high << 16) | low;
+      float x;
+      std::memcpy(&x, &bits, sizeof(x));
+      values.push_back(x);
+    }
+  }
+  return values;
+}
+
+/// Compares the raw encodings produced by each instruction set with the element-wise scalar
+/// conversion. An odd element count exercises the scalar remainder as well.
+template <typename T, typename S>
+bool verify_array_conversion(std::vector<S> const &src) {
+
+  std::vector<T> expected(src.size());
+  for (size_t i = 0; i < src.size(); ++i) {
+    expected[i] = cutlass::NumericConverter<T, S>()(src[i]);
+  }
+
+  bool passed = true;
+  for (cutlass::HostSimdIsa isa : available_isas()) {
+    for (size_t count : {src.size(), src.size() - 5}) {
+      std::vector<T> dst(count);
+      cutlass::HostArrayConverter<T, S>::convert(dst.data(), src.data(), count, isa);
+
+      if (std::memcmp(dst.data(), expected.data(), count * sizeof(T))) {
+        EXPECT_TRUE(false) << "Mismatch for instruction set " << int(isa) << " and count " << count;
+        passed = false;
+      }
+    }
+  }
+  return passed;
+}
+
+/// Every encoding of a 16-bit or 8-bit type, plus the remainder handling
+template <typename Element>
+std::vector<Element> all_encodings() {
+  size_t count = size_t(1) << cutlass::sizeof_bits<Element>::value;
+
+  std::vector<Element> values(count + 7);
+  for (size_t i = 0; i < values.size(); ++i) {
+    using Storage = decltype(values[i].storage);
+    values[i].storage = Storage(i % count);
+  }
+  return values;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostNumericConversion, f16_to_f32_exhaustive) {
+  EXPECT_TRUE((verify_array_conversion<float, cutlass::half_t>(all_encodings<cutlass::half_t>())));
+}
+
+TEST(HostNumericConversion, bf16_to_f32_exhaustive) {
+  EXPECT_TRUE((verify_array_conversion<float, cutlass::bfloat16_t>(all_encodings<cutlass::bfloat16_t>())));
+}
+
+TEST(HostNumericConversion, e4m3_to_f32_exhaustive) {
+  EXPECT_TRUE((verify_array_conversion<float, cutlass::float_e4m3_t>(all_encodings<cutlass::float_e4m3_t>())));
+}
+
+TEST(HostNumericConversion, e5m2_to_f32_exhaustive) {
+  EXPECT_TRUE((verify_array_conversion<float, cutlass::float_e5m2_t>(all_encodings<cutlass::float_e5m2_t>())));
+}
+
+TEST(HostNumericConversion, f32_to_f16) {
+  EXPECT_TRUE((verify_array_conversion<cutlass::half_t, float>(float_sweep())));
+}
+
+TEST(HostNumericConversion, f32_to_bf16) {
+  EXPECT_TRUE((verify_array_conversion<cutlass::bfloat16_t, float>(float_sweep())));
+}
+
+TEST(HostNumericConversion, f32_to_e4m3) {
+  EXPECT_TRUE((verify_array_conversion<cutlass::float_e4m3_t, float>(float_sweep())));
+}
+
+TEST(HostNumericConversion, f32_to_e5m2) {
+  EXPECT_TRUE((verify_array_conversion<cutlass::float_e5m2_t, float>(float_sweep())));
+}
+
+/// Encoding then decoding every value of each type must reproduce it exactly, NaNs aside
+TEST(HostNumericConversion, round_trip_exhaustive) {
+
+  auto halves = all_encodings<cutlass::half_t>();
+  std::vector<float> wide(halves.size());
+  std::vector<cutlass::half_t> narrow(halves.size());
+
+  cutlass::host_convert_array(wide.data(), halves.data(), halves.size());
+  cutlass::host_convert_array(narrow.data(), wide.data(), wide.size());
+
+  int errors = 0;
+  for (size_t i = 0; i < halves.size(); ++i) {
+    bool nan = (halves[i].storage & 0x7fff) > 0x7c00;
+    if (!nan && narrow[i].storage != halves[i].storage) {
+      ++errors;
+    }
+  }
+  EXPECT_EQ(errors, 0);
+
+  auto e4m3 = all_encodings<cutlass::float_e4m3_t>();
+  std::vector<float> wide8(e4m3.size());
+  std::vector<cutlass::float_e4m3_t> narrow8(e4m3.size());
+
+  cutlass::host_convert_array(wide8.data(), e4m3.data(), e4m3.size());
+  cutlass::host_convert_array(narrow8.data(), wide8.data(), wide8.size());
+
+  errors = 0;
+  for (size_t i = 0; i < e4m3.size(); ++i) {
+    bool nan = (e4m3[i].storage & 0x7f) == 0x7f;
+    if (!nan && narrow8[i].storage != e4m3[i].storage) {
+      ++errors;
+    }
+  }
+  EXPECT_EQ(errors, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
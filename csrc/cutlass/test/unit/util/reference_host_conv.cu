@@ -0,0 +1,320 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/conv/conv2d_problem_size.h"
+#include "cutlass/conv/conv3d_problem_size.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/conv.hpp"
+#include "cutlass/util/reference/host/convolution.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Problem sizes covering padding, stride, dilation, convolution mode, groups and depthwise.
+std::vector<cutlass::conv::Conv2dProblemSize> conv2d_problem_sizes() {
+  using cutlass::conv::Mode;
+  std::vector<cutlass::conv::Conv2dProblemSize> sizes;
+
+  sizes.push_back(cutlass::conv::Conv2dProblemSize(
+    {2, 9, 11, 24}, {40, 3, 3, 24}, {1, 1, 1, 1}, {1, 1}, {1, 1}, Mode::kCrossCorrelation));
+  sizes.push_back(cutlass::conv::Conv2dProblemSize(
+    {1, 17, 13, 8}, {19, 3, 5, 8}, {2, 2, 1, 1}, {2, 3}, {1, 2}, Mode::kConvolution));
+  sizes.push_back(cutlass::conv::Conv2dProblemSize(
+    {3, 7, 7, 5}, {300, 1, 1, 5}, {0, 0, 0, 0}, {1, 1}, {1, 1}, Mode::kCrossCorrelation));
+  sizes.push_back(cutlass::conv::Conv2dProblemSize(
+    {1, 15, 15, 96}, {64, 7, 7, 96}, {3, 3, 3, 3}, {2, 2}, {1, 1}, Mode::kCrossCorrelation));
+
+  return sizes;
+}
+
+/// Grouped and depthwise problem sizes (fprop only, as in Conv2dFpropDirect).
+std::vector<cutlass::conv::Conv2dProblemSize> conv2d_grouped_problem_sizes() {
+  using cutlass::conv::Mode;
+  std::vector<cutlass::conv::Conv2dProblemSize> sizes;
+
+  sizes.push_back(cutlass::conv::Conv2dProblemSize(
+    {2, 9, 9, 32}, {64, 3, 3, 8}, {1, 1, 1, 1}, {1, 1}, {1, 1}, Mode::kCrossCorrelation, 1, 4));
+  sizes.push_back(cutlass::conv::Conv2dProblemSize(
+    {2, 12, 10, 48}, {48, 5, 5, 1}, {2, 2, 2, 2}, {2, 2}, {1, 1}, Mode::kCrossCorrelation, 1, 48));
+
+  return sizes;
+}
+
+/// 3D problem sizes covering padding, stride, dilation and convolution mode.
+std::vector<cutlass::conv::Conv3dProblemSize> conv3d_problem_sizes() {
+  using cutlass::conv::Mode;
+  std::vector<cutlass::conv::Conv3dProblemSize> sizes;
+
+  sizes.push_back(cutlass::conv::Conv3dProblemSize(
+    {2, 5, 7, 6, 16}, {24, 3, 3, 3, 16}, cutlass::make_Coord(1, 1, 1),
+    cutlass::make_Coord(1, 1, 1), cutlass::make_Coord(1, 1, 1), Mode::kCrossCorrelation));
+  sizes.push_back(cutlass::conv::Conv3dProblemSize(
+    {1, 9, 8, 11, 8}, {12, 3, 2, 3, 8}, cutlass::make_Coord(2, 1, 0),
+    cutlass::make_Coord(2, 1, 2), cutlass::make_Coord(1, 2, 1), Mode::kConvolution));
+
+  return sizes;
+}
+
+/// Runs one operator through the implicit GEMM and the direct references and requires
+/// bitwise-identical results. Operands hold small integers so both paths are exact.
+template <typename Element, typename ElementAccumulator>
+bool verify_conv2d_implicit_gemm(
+  cutlass::conv::Operator conv_operator,
+  cutlass::conv::Conv2dProblemSize const &problem_size) {
+
+  using Layout = cutlass::layout::TensorNHWC;
+
+  cutlass::HostTensor<Element, Layout> tensor_a(
+    cutlass::conv::implicit_gemm_tensor_a_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_b(
+    cutlass::conv::implicit_gemm_tensor_b_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_c(
+    cutlass::conv::implicit_gemm_tensor_c_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_d(tensor_c.extent(), false);
+  cutlass::HostTensor<Element, Layout> tensor_d_direct(tensor_c.extent(), false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_a.host_view(), 2023, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_b.host_view(), 2024, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_c.host_view(), 2025, 3, -3, 0);
+
+  ElementAccumulator alpha = ElementAccumulator(2);
+  ElementAccumulator beta = ElementAccumulator(-1);
+
+  switch (conv_operator) {
+  case cutlass::conv::Operator::kFprop:
+    cutlass::reference::host::Conv2dFpropImplicitGemm<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d.host_ref(), alpha, beta);
+    cutlass::reference::host::Conv2dFpropDirect<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta);
+    break;
+  case cutlass::conv::Operator::kDeconv:
+  case cutlass::conv::Operator::kDgrad:
+    cutlass::reference::host::Conv2dDgradImplicitGemm<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d.host_ref(), alpha, beta,
+        conv_operator == cutlass::conv::Operator::kDeconv);
+    cutlass::reference::host::Conv2dDgradDirect<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta,
+        conv_operator == cutlass::conv::Operator::kDeconv);
+    break;
+  case cutlass::conv::Operator::kWgrad:
+    cutlass::reference::host::Conv2dWgradImplicitGemm<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d.host_ref(), alpha, beta);
+    cutlass::reference::host::Conv2dWgradDirect<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta);
+    break;
+  default:
+    return false;
+  }
+
+  return cutlass::reference::host::TensorEquals(tensor_d.host_view(), tensor_d_direct.host_view());
+}
+
+/// 3D counterpart of verify_conv2d_implicit_gemm.
+template <typename Element, typename ElementAccumulator>
+bool verify_conv3d_implicit_gemm(
+  cutlass::conv::Operator conv_operator,
+  cutlass::conv::Conv3dProblemSize const &problem_size) {
+
+  using Layout = cutlass::layout::TensorNDHWC;
+
+  cutlass::HostTensor<Element, Layout> tensor_a(
+    cutlass::conv::implicit_gemm_tensor_a_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_b(
+    cutlass::conv::implicit_gemm_tensor_b_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_c(
+    cutlass::conv::implicit_gemm_tensor_c_extent(conv_operator, problem_size), false);
+  cutlass::HostTensor<Element, Layout> tensor_d(tensor_c.extent(), false);
+  cutlass::HostTensor<Element, Layout> tensor_d_direct(tensor_c.extent(), false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_a.host_view(), 2023, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_b.host_view(), 2024, 3, -3, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_c.host_view(), 2025, 3, -3, 0);
+
+  ElementAccumulator alpha = ElementAccumulator(2);
+  ElementAccumulator beta = ElementAccumulator(-1);
+
+  switch (conv_operator) {
+  case cutlass::conv::Operator::kFprop:
+    cutlass::reference::host::Conv3dFpropImplicitGemm<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d.host_ref(), alpha, beta);
+    cutlass::reference::host::Conv3dFpropDirect<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta);
+    break;
+  case cutlass::conv::Operator::kDeconv:
+  case cutlass::conv::Operator::kDgrad:
+    cutlass::reference::host::Conv3dDgradImplicitGemm<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d.host_ref(), alpha, beta,
+        conv_operator == cutlass::conv::Operator::kDeconv);
+    cutlass::reference::host::Conv3dDgradDirect<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta,
+        conv_operator == cutlass::conv::Operator::kDeconv);
+    break;
+  case cutlass::conv::Operator::kWgrad:
+    cutlass::reference::host::Conv3dWgradImplicitGemm<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d.host_ref(), alpha, beta);
+    cutlass::reference::host::Conv3dWgradDirect<
+      Element, Layout, Element, Layout, Element, Layout, ElementAccumulator>(
+        problem_size, tensor_a.host_ref(), tensor_b.host_ref(),
+        tensor_c.host_ref(), tensor_d_direct.host_ref(), alpha, beta);
+    break;
+  default:
+    return false;
+  }
+
+  return cutlass::reference::host::TensorEquals(tensor_d.host_view(), tensor_d_direct.host_view());
+}
+
+/// Runs the CuTe-based 2D reference through compute_reference() and compute_reference_direct().
+template <cutlass::conv::Operator ConvOp>
+bool verify_conv_reference_impl_2d(cutlass::conv::Conv2dProblemSize const &ps) {
+
+  using namespace cute;
+
+  // Mode orders as in the CuTe reference: activation (C,W,H,N), filter (C,S,R,K), output (K,Q,P,N).
+  auto act = make_layout(make_shape(ps.C, ps.W, ps.H, ps.N));
+  auto flt = make_layout(make_shape(ps.C, ps.S, ps.R, ps.K));
+  auto out = make_layout(make_shape(ps.K, ps.Q, ps.P, ps.N));
+
+  auto layout_a = ConvOp == cutlass::conv::Operator::kFprop ? act : out;
+  auto layout_b = ConvOp == cutlass::conv::Operator::kWgrad ? act : flt;
+  auto layout_c = ConvOp == cutlass::conv::Operator::kFprop ? out :
+                  ConvOp == cutlass::conv::Operator::kDgrad ? act : flt;
+
+  std::vector<float> a(size(layout_a)), b(size(layout_b)), c(size(layout_c));
+  std::vector<float> d(size(layout_c)), d_direct(size(layout_c));
+  for (size_t i = 0; i < a.size(); ++i) { a[i] = float(int(i * 7 % 5) - 2); }
+  for (size_t i = 0; i < b.size(); ++i) { b[i] = float(int(i * 3 % 7) - 3); }
+  for (size_t i = 0; i < c.size(); ++i) { c[i] = float(int(i % 3) - 1); }
+
+  auto tensor_a = make_tensor(a.data(), layout_a);
+  auto tensor_b = make_tensor(b.data(), layout_b);
+  auto tensor_c = make_tensor(c.data(), layout_c);
+  auto tensor_d = make_tensor(d.data(), layout_c);
+  auto tensor_d_direct = make_tensor(d_direct.data(), layout_c);
+
+  auto padding = make_shape(ps.pad_w, ps.pad_h);
+  auto tstride = make_shape(ps.stride_w, ps.stride_h);
+  auto dilation = make_shape(ps.dilation_w, ps.dilation_h);
+
+  auto params_layout = make_layout(make_shape(0));
+  using TensorScale = decltype(make_tensor(static_cast<float *>(nullptr), params_layout));
+  cutlass::reference::host::ConvEpilogueFusionParams<
+    float, float, float, float, float, TensorScale, TensorScale, TensorScale> epilogue_params{};
+  epilogue_params.alpha = 2.0f;
+  epilogue_params.beta = -1.0f;
+
+  using Reference = cutlass::reference::host::ConvReferenceImpl<
+    ConvOp, 2,
+    decltype(tensor_a), decltype(tensor_b), decltype(tensor_c), decltype(tensor_d),
+    decltype(padding), decltype(tstride), decltype(dilation), decltype(epilogue_params)>;
+
+  Reference(tensor_a, tensor_b, tensor_c, tensor_d, padding, tstride, dilation, epilogue_params)
+    .compute_reference();
+  Reference(tensor_a, tensor_b, tensor_c, tensor_d_direct, padding, tstride, dilation, epilogue_params)
+    .compute_reference_direct();
+
+  return d == d_direct;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostConv, conv2d_fprop_implicit_gemm_f32) {
+  for (auto const &problem_size : conv2d_problem_sizes()) {
+    EXPECT_TRUE((verify_conv2d_implicit_gemm<float, float>(cutlass::conv::Operator::kFprop, problem_size)));
+  }
+  for (auto const &problem_size : conv2d_grouped_problem_sizes()) {
+    EXPECT_TRUE((verify_conv2d_implicit_gemm<float, float>(cutlass::conv::Operator::kFprop, problem_size)));
+  }
+}
+
+TEST(ReferenceHostConv, conv2d_dgrad_implicit_gemm_f32) {
+  for (auto const &problem_size : conv2d_problem_sizes()) {
+    EXPECT_TRUE((verify_conv2d_implicit_gemm<float, float>(cutlass::conv::Operator::kDgrad, problem_size)));
+    EXPECT_TRUE((verify_conv2d_implicit_gemm<float, float>(cutlass::conv::Operator::kDeconv, problem_size)));
+  }
+}
+
+TEST(ReferenceHostConv, conv2d_wgrad_implicit_gemm_f64) {
+  for (auto const &problem_size : conv2d_problem_sizes()) {
+    EXPECT_TRUE((verify_conv2d_implicit_gemm<double, double>(cutlass::conv::Operator::kWgrad, problem_size)));
+  }
+}
+
+TEST(ReferenceHostConv, conv3d_implicit_gemm_f32) {
+  for (auto const &problem_size : conv3d_problem_sizes()) {
+    EXPECT_TRUE((verify_conv3d_implicit_gemm<float, float>(cutlass::conv::Operator::kFprop, problem_size)));
+    EXPECT_TRUE((verify_conv3d_implicit_gemm<float, float>(cutlass::conv::Operator::kDgrad, problem_size)));
+    EXPECT_TRUE((verify_conv3d_implicit_gemm<float, float>(cutlass::conv::Operator::kDeconv, problem_size)));
+    EXPECT_TRUE((verify_conv3d_implicit_gemm<float, float>(cutlass::conv::Operator::kWgrad, problem_size)));
+  }
+}
+
+TEST(ReferenceHostConv, conv_reference_impl_2d_implicit_gemm_f32) {
+  for (auto const &problem_size : conv2d_problem_sizes()) {
+    EXPECT_TRUE(verify_conv_reference_impl_2d<cutlass::conv::Operator::kFprop>(problem_size));
+    EXPECT_TRUE(verify_conv_reference_impl_2d<cutlass::conv::Operator::kDgrad>(problem_size));
+    EXPECT_TRUE(verify_conv_reference_impl_2d<cutlass::conv::Operator::kWgrad>(problem_size));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
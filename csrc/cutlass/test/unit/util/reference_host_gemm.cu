@@ -0,0 +1,221 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference/host/gett.hpp"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Runs compute_gemm (packed path) and compute_gemm_generic on the same operands and requires
+/// bitwise-identical outputs. Operands hold small integers so both paths are exact.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ComputeType
+>
+bool verify_packed_gemm(int m, int n, int k) {
+
+  cutlass::gemm::GemmCoord problem_size(m, n, k);
+
+  cutlass::HostTensor<ElementA, LayoutA> tensor_a(problem_size.mk(), false);
+  cutlass::HostTensor<ElementB, LayoutB> tensor_b(problem_size.kn(), false);
+  cutlass::HostTensor<ElementC, LayoutC> tensor_c(problem_size.mn(), false);
+  cutlass::HostTensor<ElementC, LayoutC> tensor_d(problem_size.mn(), false);
+  cutlass::HostTensor<ElementC, LayoutC> tensor_d_generic(problem_size.mn(), false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_a.host_view(), 2019, 4, -4, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_b.host_view(), 2020, 4, -4, 0);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_c.host_view(), 2021, 4, -4, 0);
+
+  ComputeType alpha = ComputeType(2);
+  ComputeType beta = ComputeType(-1);
+
+  cutlass::reference::host::compute_gemm<
+    ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ComputeType, ComputeType>(
+      problem_size, alpha, tensor_a.host_ref(), tensor_b.host_ref(),
+      beta, tensor_c.host_ref(), tensor_d.host_ref(), ComputeType(0));
+
+  cutlass::reference::host::compute_gemm_generic<
+    ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ComputeType, ComputeType>(
+      problem_size, alpha, tensor_a.host_ref(), tensor_b.host_ref(),
+      beta, tensor_c.host_ref(), tensor_d_generic.host_ref(), ComputeType(0));
+
+  return cutlass::reference::host::TensorEquals(tensor_d.host_view(), tensor_d_generic.host_view());
+}
+
+/// Runs Gett on (M, K, L) A and (N, K, L) B with the given strides, a column-major (M, N, L) C and
+/// D, per-row alpha and bias and a ReLU, and compares D against a plain loop. Operands hold small
+/// integers so every path is exact.
+template <typename ElementA, typename ElementB, typename ElementAccumulator, typename StrideA, typename StrideB>
+bool verify_gett(int m, int n, int k, int l, StrideA stride_a, StrideB stride_b, bool fused) {
+
+  using ElementD = ElementAccumulator;
+
+  int64_t const cosize_a = cute::cosize(cute::make_layout(cute::make_shape(m, k, l), stride_a));
+  int64_t const cosize_b = cute::cosize(cute::make_layout(cute::make_shape(n, k, l), stride_b));
+
+  std::vector<ElementA> a(cosize_a);
+  std::vector<ElementB> b(cosize_b);
+  std::vector<ElementD> c(size_t(m) * n * l);
+  std::vector<ElementD> d(size_t(m) * n * l);
+  std::vector<ElementD> bias(m);
+  std::vector<ElementD> valpha(m);
+
+  for (size_t i = 0; i < a.size(); ++i) { a[i] = ElementA(int(i * 7 % 9) - 4); }
+  for (size_t i = 0; i < b.size(); ++i) { b[i] = ElementB(int(i * 5 % 7) - 3); }
+  for (size_t i = 0; i < c.size(); ++i) { c[i] = ElementD(int(i * 3 % 5) - 2); }
+  for (int i = 0; i < m; ++i) { bias[i] = ElementD(i % 11 - 5); valpha[i] = ElementD(i % 3 + 1); }
+
+  auto A = cute::make_tensor(a.data(), cute::make_layout(cute::make_shape(m, k, l), stride_a));
+  auto B = cute::make_tensor(b.data(), cute::make_layout(cute::make_shape(n, k, l), stride_b));
+  auto layout_D = cute::make_layout(cute::make_shape(m, n, l), cute::make_stride(cute::_1{}, m, m * n));
+  auto C = cute::make_tensor(c.data(), layout_D);
+  auto D = cute::make_tensor(d.data(), layout_D);
+  auto Vector = cute::make_tensor(bias.data(), cute::make_layout(cute::make_shape(m, cute::_1{})));
+  auto Valpha = cute::make_tensor(valpha.data(), cute::make_layout(cute::make_shape(m, cute::_1{})));
+
+  cutlass::reference::host::GettMainloopParams<ElementAccumulator, decltype(A), decltype(B)> mainloop_params{};
+  mainloop_params.A = A;
+  mainloop_params.B = B;
+
+  cutlass::reference::host::GettEpilogueParams<
+    ElementD, ElementD, ElementAccumulator, ElementAccumulator,
+    decltype(C), decltype(D), decltype(Vector), decltype(D), decltype(Valpha), decltype(Valpha),
+    cutlass::epilogue::thread::ReLu<ElementAccumulator>> epilogue_params{};
+  epilogue_params.C = C;
+  epilogue_params.D = D;
+  epilogue_params.alpha = ElementD(2);
+  epilogue_params.beta = ElementD(-1);
+  if (fused) {
+    epilogue_params.Bias = Vector;
+    epilogue_params.Valpha = Valpha;
+  }
+
+  cutlass::reference::host::Gett(mainloop_params, epilogue_params);
+
+  for (int batch = 0; batch < l; ++batch) {
+    for (int row = 0; row < m; ++row) {
+      for (int col = 0; col < n; ++col) {
+        ElementAccumulator accum = ElementAccumulator(0);
+        for (int kk = 0; kk < k; ++kk) {
+          accum += ElementAccumulator(A(row, kk, batch)) * ElementAccumulator(B(col, kk, batch));
+        }
+        ElementAccumulator expected = (fused ? valpha[row] : ElementD(2)) * accum;
+        if (fused) {
+          expected += bias[row];
+        }
+        expected += ElementD(-1) * C(row, col, batch);
+        expected = std::max(expected, ElementAccumulator(0));
+        if (D(row, col, batch) != expected) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostGemm, packed_f16n_f16t_f32n) {
+
+  using Layout = cutlass::layout::ColumnMajor;
+  using LayoutT = cutlass::layout::RowMajor;
+
+  EXPECT_TRUE((verify_packed_gemm<cutlass::half_t, Layout, cutlass::half_t, LayoutT, float, Layout, float>(131, 257, 300)));
+  EXPECT_TRUE((verify_packed_gemm<cutlass::half_t, Layout, cutlass::half_t, LayoutT, float, Layout, float>(1, 1, 1)));
+  EXPECT_TRUE((verify_packed_gemm<cutlass::half_t, Layout, cutlass::half_t, LayoutT, float, Layout, float>(64, 16, 0)));
+}
+
+TEST(ReferenceHostGemm, packed_f64t_f64n_f64t) {
+
+  using Layout = cutlass::layout::ColumnMajor;
+  using LayoutT = cutlass::layout::RowMajor;
+
+  EXPECT_TRUE((verify_packed_gemm<double, LayoutT, double, Layout, double, LayoutT, double>(200, 130, 517)));
+  EXPECT_TRUE((verify_packed_gemm<double, LayoutT, double, Layout, double, LayoutT, double>(3, 300, 7)));
+}
+
+TEST(ReferenceHostGemm, packed_s8t_s8n_s32t) {
+
+  using Layout = cutlass::layout::ColumnMajor;
+  using LayoutT = cutlass::layout::RowMajor;
+
+  EXPECT_TRUE((verify_packed_gemm<int8_t, LayoutT, int8_t, Layout, int32_t, LayoutT, int32_t>(129, 65, 257)));
+  EXPECT_TRUE((verify_packed_gemm<int8_t, LayoutT, int8_t, Layout, int32_t, LayoutT, int32_t>(17, 271, 33)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ReferenceHostGett, packed_f32_k_major) {
+
+  using namespace cute;
+
+  // Unit stride along K for both operands, statically known.
+  EXPECT_TRUE((verify_gett<float, float, float>(
+    131, 70, 300, 3, make_stride(300, _1{}, 131 * 300), make_stride(300, _1{}, 70 * 300), true)));
+  EXPECT_TRUE((verify_gett<float, float, float>(
+    1, 1, 1, 1, make_stride(1, _1{}, 1), make_stride(1, _1{}, 1), false)));
+}
+
+TEST(ReferenceHostGett, packed_f64_mn_major) {
+
+  using namespace cute;
+
+  // Unit stride along M and N, statically known.
+  EXPECT_TRUE((verify_gett<double, double, double>(
+    97, 130, 257, 2, make_stride(_1{}, 97, 97 * 257), make_stride(_1{}, 130, 130 * 257), true)));
+}
+
+TEST(ReferenceHostGett, packed_s8_s32_strided) {
+
+  // Padded, dynamic strides take the indexed packing loop.
+  EXPECT_TRUE((verify_gett<int8_t, int8_t, int32_t>(
+    65, 129, 33, 2,
+    cute::make_stride(int64_t(40), int64_t(1), int64_t(65 * 40)),
+    cute::make_stride(int64_t(2), int64_t(2 * 131), int64_t(2 * 131 * 33)), true)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
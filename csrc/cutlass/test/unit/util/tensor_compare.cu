@@ -0,0 +1,273 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/error_metrics.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_copy.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Perturbs a tensor at every stride-th linearized coordinate and compares the report of
+/// TensorRelativelyEqualsReport against a serial loop over the index space.
+template <typename Layout>
+void TestTensorCompareReport(cutlass::HostTensor<float, Layout> &computed, int stride) {
+
+  auto extent = computed.extent();
+
+  cutlass::HostTensor<float, Layout> reference(extent, computed.layout(), false);
+  cutlass::reference::host::TensorFillRandomUniform(reference.host_view(), 2029, 4, -4);
+  cutlass::reference::host::TensorCopy(computed.host_view(), reference.host_view());
+
+  auto view = computed.host_view();
+  auto ref_view = reference.host_view();
+
+  int64_t idx = 0;
+  cutlass::reference::host::TensorForEachLambda(extent, [&](typename Layout::TensorCoord const &coord) {
+    if (idx % stride == 3) {
+      view.at(coord) = ref_view.at(coord) * 1.5f + float(idx % 7);
+    }
+    ++idx;
+  });
+
+  float epsilon = 0.05f;
+  float nonzero_floor = 1e-6f;
+
+  int64_t expected_mismatches = 0;
+  double max_abs_error = 0;
+  typename Layout::TensorCoord max_abs_error_coord;
+  std::vector<typename Layout::TensorCoord> first;
+
+  cutlass::reference::host::TensorForEachLambda(extent, [&](typename Layout::TensorCoord const &coord) {
+    float a = view.at(coord);
+    float b = ref_view.at(coord);
+    if (!cutlass::relatively_equal(a, b, epsilon, nonzero_floor)) {
+      ++expected_mismatches;
+      if (first.size() < 5) {
+        first.push_back(coord);
+      }
+    }
+    if (std::abs(double(a) - double(b)) > max_abs_error) {
+      max_abs_error = std::abs(double(a) - double(b));
+      max_abs_error_coord = coord;
+    }
+  });
+
+  auto report = cutlass::reference::host::TensorRelativelyEqualsReport(
+    view, ref_view, epsilon, nonzero_floor, cutlass::reference::host::TensorCompareOptions(5));
+
+  EXPECT_FALSE(report.passed());
+  EXPECT_EQ(report.count, cutlass::reference::host::detail::TensorForEachSize(extent));
+  EXPECT_EQ(report.mismatch_count, expected_mismatches);
+  EXPECT_EQ(report.max_abs_error, max_abs_error);
+  EXPECT_TRUE(report.max_abs_error_coord == max_abs_error_coord);
+  EXPECT_FALSE(report.stopped_early);
+
+  int64_t histogram_total = 0;
+  for (int64_t bucket_count : report.ulp_histogram) {
+    histogram_total += bucket_count;
+  }
+  EXPECT_EQ(histogram_total, report.count);
+
+  // Without a contiguous rank, mismatches are recorded in the order of the linearized index space
+  ASSERT_EQ(report.mismatches.size(), first.size());
+  if (cutlass::reference::host::detail::TensorCompareContiguousRank<Layout>::value < 0) {
+    for (size_t i = 0; i < first.size(); ++i) {
+      EXPECT_TRUE(report.mismatches[i].coord == first[i]);
+    }
+  }
+
+  for (auto const &mismatch : report.mismatches) {
+    EXPECT_EQ(mismatch.lhs, view.at(mismatch.coord));
+    EXPECT_EQ(mismatch.rhs, ref_view.at(mismatch.coord));
+  }
+
+  double metric = cutlass::reference::host::TensorNormDiff(view, ref_view) /
+    cutlass::reference::host::TensorNorm(ref_view);
+
+  EXPECT_EQ(cutlass::reference::host::TensorRelativeErrorMetric(view, ref_view), metric);
+  EXPECT_LT(std::abs(report.relative_error() - metric), 1e-12 * metric);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(TensorCompare, report_rowmajor_padded) {
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> tensor(
+    {301, 257}, cutlass::layout::RowMajor(263), false);
+  TestTensorCompareReport(tensor, 997);
+}
+
+TEST(TensorCompare, report_columnmajor) {
+  cutlass::HostTensor<float, cutlass::layout::ColumnMajor> tensor({259, 311}, false);
+  TestTensorCompareReport(tensor, 1009);
+}
+
+TEST(TensorCompare, report_nchw) {
+  cutlass::HostTensor<float, cutlass::layout::TensorNCHW> tensor({3, 17, 29, 31}, false);
+  TestTensorCompareReport(tensor, 613);
+}
+
+/// With early exit, the report holds the first mismatch regardless of the number of threads.
+TEST(TensorCompare, early_exit_first_mismatch_nhwc) {
+
+  cutlass::Tensor4DCoord extent(4, 37, 41, 64);
+
+  cutlass::HostTensor<int8_t, cutlass::layout::TensorNHWC> tensor_a(extent, false);
+  cutlass::HostTensor<int8_t, cutlass::layout::TensorNHWC> tensor_b(extent, false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_a.host_view(), 2030, 100, -100, 0);
+  cutlass::reference::host::TensorCopy(tensor_b.host_view(), tensor_a.host_view());
+
+  cutlass::Tensor4DCoord first(2, 5, 40, 17);
+  cutlass::Tensor4DCoord second(2, 6, 0, 3);
+  cutlass::Tensor4DCoord last(3, 36, 40, 63);
+
+  for (auto const &coord : {last, second, first}) {
+    tensor_b.host_view().at(coord) = int8_t(tensor_a.host_view().at(coord) + 1);
+  }
+
+  cutlass::reference::host::TensorCompareOptions options(4, true);
+
+  // Elements preceding the first mismatch in the linearized index space
+  int64_t preceding =
+    ((int64_t(first.n()) * extent.h() + first.h()) * extent.w() + first.w()) * extent.c() + first.c();
+
+  auto check = [&]() {
+    auto report = cutlass::reference::host::TensorEqualsReport(
+      tensor_a.host_view(), tensor_b.host_view(), options);
+
+    EXPECT_FALSE(report.passed());
+    EXPECT_TRUE(report.stopped_early);
+    EXPECT_EQ(report.mismatch_count, 1);
+    EXPECT_EQ(report.count, preceding + 1);
+    ASSERT_EQ(report.mismatches.size(), size_t(1));
+    EXPECT_TRUE(report.mismatches[0].coord == first);
+  };
+
+#if defined(_OPENMP)
+  int max_threads = omp_get_max_threads();
+  for (int threads : {1, 3, 8}) {
+    omp_set_num_threads(threads);
+    check();
+  }
+  omp_set_num_threads(max_threads);
+#else
+  check();
+#endif
+
+  auto report = cutlass::reference::host::TensorEqualsReport(tensor_a.host_view(), tensor_b.host_view());
+  EXPECT_FALSE(report.stopped_early);
+  EXPECT_EQ(report.mismatch_count, 3);
+  ASSERT_EQ(report.mismatches.size(), size_t(3));
+  EXPECT_TRUE(report.mismatches[0].coord == first);
+  EXPECT_TRUE(report.mismatches[1].coord == second);
+  EXPECT_TRUE(report.mismatches[2].coord == last);
+
+  EXPECT_FALSE(cutlass::reference::host::TensorEquals(tensor_a.host_view(), tensor_b.host_view()));
+}
+
+TEST(TensorCompare, ulp_histogram_half) {
+
+  int const kCount = 6;
+
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::PackedVectorLayout> lhs(cutlass::make_Coord(kCount), false);
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::PackedVectorLayout> rhs(cutlass::make_Coord(kCount), false);
+
+  uint16_t lhs_bits[kCount] = {0x3c00, 0x3c01, 0x3c05, 0x8000, 0x0001, 0x7e00};
+  uint16_t rhs_bits[kCount] = {0x3c00, 0x3c00, 0x3c00, 0x0000, 0x8001, 0x3c00};
+
+  for (int i = 0; i < kCount; ++i) {
+    lhs.host_data()[i] = cutlass::half_t::bitcast(lhs_bits[i]);
+    rhs.host_data()[i] = cutlass::half_t::bitcast(rhs_bits[i]);
+  }
+
+  auto report = cutlass::reference::host::TensorEqualsReport(lhs.host_view(), rhs.host_view());
+
+  // +0 and -0 compare equal; the smallest subnormals of opposite sign are two units apart
+  EXPECT_EQ(report.mismatch_count, 4);
+  EXPECT_EQ(report.ulp_histogram[0], 2);
+  EXPECT_EQ(report.ulp_histogram[1], 1);
+  EXPECT_EQ(report.ulp_histogram[2], 1);
+  EXPECT_EQ(report.ulp_histogram[3], 1);
+  EXPECT_EQ(report.ulp_histogram[cutlass::reference::host::kTensorCompareUlpBuckets - 1], 1);
+  EXPECT_EQ(report.max_abs_error, std::numeric_limits<double>::infinity());
+  EXPECT_EQ(report.max_abs_error_coord[0], 5);
+}
+
+TEST(TensorCompare, ulp_bucket_bounds) {
+
+  int const kLast = cutlass::reference::host::kTensorCompareUlpBuckets - 1;
+
+  EXPECT_EQ(cutlass::reference::host::detail::TensorCompareUlpBucket(0), 0);
+
+  // Bucket i holds [2^(i-1), 2^i), including the distances float can't represent exactly
+  for (int i = 1; i < kLast; ++i) {
+    uint64_t lower = uint64_t(1) << (i - 1);
+    uint64_t upper = (uint64_t(1) << i) - 1;
+    EXPECT_EQ(cutlass::reference::host::detail::TensorCompareUlpBucket(lower), i);
+    EXPECT_EQ(cutlass::reference::host::detail::TensorCompareUlpBucket(upper), i);
+  }
+
+  EXPECT_EQ(cutlass::reference::host::detail::TensorCompareUlpBucket(uint64_t(1) << (kLast - 1)), kLast);
+  EXPECT_EQ(cutlass::reference::host::detail::TensorCompareUlpBucket(~uint64_t(0)), kLast);
+}
+
+TEST(TensorCompare, extent_mismatch) {
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> tensor_a({16, 16}, false);
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> tensor_b({16, 17}, false);
+
+  auto report = cutlass::reference::host::TensorEqualsReport(tensor_a.host_view(), tensor_b.host_view());
+
+  EXPECT_FALSE(report.extent_equal);
+  EXPECT_FALSE(report.passed());
+  EXPECT_EQ(report.count, 0);
+  EXPECT_FALSE(cutlass::reference::host::TensorEquals(tensor_a.host_view(), tensor_b.host_view()));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
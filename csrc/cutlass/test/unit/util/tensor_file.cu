@@ -0,0 +1,212 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/tensor_file.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Path of a temporary file removed when the object goes out of scope
+struct TemporaryFile {
+  std::string path;
+
+  explicit TemporaryFile(char const *name):
+    path((std::filesystem::temp_directory_path() / name).string()) { }
+
+  ~TemporaryFile() {
+    std::remove(path.c_str());
+  }
+
+  std::string contents() const {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+};
+
+/// Writes a tensor to a .npy file, reads it back through NpyTensor and HostTensorReadNpy and
+/// verifies both against the original
+template <typename Element, typename Layout>
+void TestNpyRoundTrip(
+  cutlass::HostTensor<Element, Layout> &tensor,
+  char const *name,
+  bool expect_mapped) {
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor.host_view(), 2024, 8, -8, 0);
+
+  TemporaryFile file(name);
+  cutlass::HostTensorWriteNpy(file.path, tensor);
+
+  cutlass::NpyTensor<Element, Layout> loaded(file.path);
+  EXPECT_EQ(loaded.is_mapped(), expect_mapped);
+  EXPECT_EQ(loaded.extent(), tensor.extent());
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(loaded.host_view(), tensor.host_view()));
+
+  cutlass::HostTensor<Element, Layout> read;
+  cutlass::HostTensorReadNpy(read, file.path, false);
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(read.host_view(), tensor.host_view()));
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(TensorFile, header_matches_numpy) {
+
+  // Preamble written by numpy.save(np.zeros((2, 3), dtype=np.float32))
+  std::string expected("\x93NUMPY\x01\x00\x76\x00", 10);
+  expected += "{'descr': '<f4', 'fortran_order': False, 'shape': (2, 3), }";
+  expected.append(128 - 1 - expected.size(), ' ');
+  expected += '\n';
+
+  cutlass::NpyHeader header;
+  header.descr = "<f4";
+  header.shape = {2, 3};
+  EXPECT_EQ(header.encode(), expected);
+
+  std::istringstream in(expected);
+  cutlass::NpyHeader decoded = cutlass::NpyHeader::decode(in);
+  EXPECT_EQ(decoded.descr, "<f4");
+  EXPECT_FALSE(decoded.fortran_order);
+  EXPECT_EQ(decoded.shape, std::vector<int64_t>({2, 3}));
+  EXPECT_EQ(decoded.data_offset, 128);
+
+  // Keys in any order, vectors and structured dtypes
+  decoded = cutlass::NpyHeader::parse(
+    "{'shape': (7,), 'fortran_order': True, 'descr': [('bfloat16', '<u2')], }");
+  EXPECT_EQ(decoded.descr, "[('bfloat16', '<u2')]");
+  EXPECT_TRUE(decoded.fortran_order);
+  EXPECT_EQ(decoded.shape, std::vector<int64_t>({7}));
+
+  decoded = cutlass::NpyHeader::parse(decoded.encode().substr(10));
+  EXPECT_EQ(decoded.descr, "[('bfloat16', '<u2')]");
+  EXPECT_EQ(decoded.shape, std::vector<int64_t>({7}));
+}
+
+TEST(TensorFile, rowmajor_padded_float) {
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> tensor(
+    {37, 53}, cutlass::layout::RowMajor(64), false);
+  TestNpyRoundTrip(tensor, "cutlass_tensor_file_rowmajor.npy", true);
+}
+
+TEST(TensorFile, columnmajor_half) {
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::ColumnMajor> tensor({19, 45}, false);
+  TestNpyRoundTrip(tensor, "cutlass_tensor_file_columnmajor.npy", true);
+
+  // Column-major tensors are stored in Fortran order; a row-major load transposes storage
+  TemporaryFile file("cutlass_tensor_file_columnmajor_rowmajor.npy");
+  cutlass::HostTensorWriteNpy(file.path, tensor);
+
+  cutlass::NpyTensor<cutlass::half_t, cutlass::layout::RowMajor> loaded(file.path);
+  EXPECT_FALSE(loaded.is_mapped());
+  for (int r = 0; r < 19; ++r) {
+    for (int c = 0; c < 45; ++c) {
+      EXPECT_EQ(loaded.host_view().at({r, c}), tensor.host_view().at({r, c}));
+    }
+  }
+}
+
+TEST(TensorFile, nchw_bfloat16) {
+  cutlass::HostTensor<cutlass::bfloat16_t, cutlass::layout::TensorNCHW> tensor({3, 5, 7, 9}, false);
+  TestNpyRoundTrip(tensor, "cutlass_tensor_file_nchw.npy", false);
+
+  // NCHW has no NumPy order and is written in C order of its logical extent (N, H, W, C)
+  TemporaryFile file("cutlass_tensor_file_nchw_nhwc.npy");
+  cutlass::HostTensorWriteNpy(file.path, tensor);
+
+  cutlass::NpyTensor<cutlass::bfloat16_t, cutlass::layout::TensorNHWC> nhwc(file.path);
+  EXPECT_TRUE(nhwc.is_mapped());
+  for (int n = 0; n < 3; ++n) {
+    for (int h = 0; h < 5; ++h) {
+      for (int w = 0; w < 7; ++w) {
+        for (int c = 0; c < 9; ++c) {
+          EXPECT_EQ(nhwc.host_view().at({n, h, w, c}), tensor.host_view().at({n, h, w, c}));
+        }
+      }
+    }
+  }
+}
+
+TEST(TensorFile, streaming_writer) {
+  cutlass::HostTensor<int32_t, cutlass::layout::RowMajor> tensor({29, 31}, false);
+  cutlass::reference::host::TensorFillSequential(tensor.host_view());
+
+  TemporaryFile whole("cutlass_tensor_file_whole.npy");
+  cutlass::TensorViewWriteNpy(whole.path, tensor.host_view());
+
+  // Write in uneven pieces
+  TemporaryFile streamed("cutlass_tensor_file_streamed.npy");
+  cutlass::NpyWriter<int32_t> writer(streamed.path, {29, 31});
+  int64_t offset = 0;
+  for (int64_t piece = 1; writer.remaining(); piece = piece * 3 + 1) {
+    int64_t count = std::min(piece, writer.remaining());
+    writer.write(tensor.host_data() + offset, count);
+    offset += count;
+  }
+  writer.close();
+
+  EXPECT_EQ(streamed.contents(), whole.contents());
+  EXPECT_EQ(whole.contents().size(), size_t(128 + 29 * 31 * 4));
+
+  TemporaryFile incomplete("cutlass_tensor_file_incomplete.npy");
+  cutlass::NpyWriter<int32_t> short_writer(incomplete.path, {4});
+  short_writer.write(tensor.host_data(), 3);
+  EXPECT_THROW(short_writer.close(), std::runtime_error);
+}
+
+TEST(TensorFile, mismatched_element_or_rank) {
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> tensor({4, 4}, false);
+  cutlass::reference::host::TensorFill(tensor.host_view(), 1.0f);
+
+  TemporaryFile file("cutlass_tensor_file_mismatch.npy");
+  cutlass::HostTensorWriteNpy(file.path, tensor);
+
+  using NpyHalf = cutlass::NpyTensor<cutlass::half_t, cutlass::layout::RowMajor>;
+  using NpyNHWC = cutlass::NpyTensor<float, cutlass::layout::TensorNHWC>;
+  EXPECT_THROW(NpyHalf{file.path}, std::runtime_error);
+  EXPECT_THROW(NpyNHWC{file.path}, std::runtime_error);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,225 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/detail/philox.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Fills a packed row-major matrix element by element through the tensor path and block-wise
+/// through the batched path. Both key each element by its offset, so they must agree bitwise.
+template <typename Element, typename FillTensor, typename FillBlock>
+bool verify_block_matches_tensor(int rows, int columns, FillTensor fill_tensor, FillBlock fill_block) {
+
+  cutlass::HostTensor<Element, cutlass::layout::RowMajor> tensor({rows, columns}, false);
+  cutlass::HostTensor<Element, cutlass::layout::RowMajor> block({rows, columns}, false);
+
+  fill_tensor(tensor.host_view());
+  fill_block(block.host_data(), block.capacity());
+
+  return cutlass::reference::host::TensorEquals(tensor.host_view(), block.host_view());
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Known-answer vectors of the Random123 reference implementation
+TEST(TensorFill, philox4x32_known_answers) {
+
+  using Philox = cutlass::reference::detail::Philox4x32;
+
+  uint32_t const counters[3][4] = {
+    {0, 0, 0, 0},
+    {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+    {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}
+  };
+
+  uint64_t const keys[3] = {0, 0xffffffffffffffffull, 0x299f31d0a4093822ull};
+
+  uint32_t const expected[3][4] = {
+    {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u},
+    {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu},
+    {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    Philox::Result counter;
+    for (int j = 0; j < 4; ++j) {
+      counter[j] = counters[i][j];
+    }
+
+    Philox::Result result = Philox(keys[i])(counter);
+
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_EQ(result[j], expected[i][j]);
+    }
+  }
+}
+
+TEST(TensorFill, philox4x32_batched_matches_scalar) {
+
+  using Philox = cutlass::reference::detail::Philox4x32;
+
+  Philox philox(2023);
+  uint64_t index = (uint64_t(1) << 32) - 17;
+
+  uint32_t bits[4][64];
+  philox.generate(index, 3, bits);
+
+  int errors = 0;
+  for (int lane = 0; lane < 64; ++lane) {
+    Philox::Result scalar = philox(index + lane, 3);
+    for (int j = 0; j < 4; ++j) {
+      if (scalar[j] != bits[j][lane]) {
+        ++errors;
+      }
+    }
+  }
+
+  EXPECT_EQ(errors, 0);
+}
+
+TEST(TensorFill, random_block_matches_tensor) {
+
+  using namespace cutlass::reference::host;
+
+  EXPECT_TRUE((verify_block_matches_tensor<float>(
+    301, 257,
+    [](auto view) { TensorFillRandomGaussian(view, 2019, 1.5, 2.0); },
+    [](float *ptr, size_t capacity) { BlockFillRandomGaussian(ptr, capacity, 2019, 1.5, 2.0); })));
+
+  EXPECT_TRUE((verify_block_matches_tensor<cutlass::half_t>(
+    131, 517,
+    [](auto view) { TensorFillRandomGaussian(view, 2020, 0, 1, 2, 50.0); },
+    [](cutlass::half_t *ptr, size_t capacity) { BlockFillRandomGaussian(ptr, capacity, 2020, 0, 1, 2, 50.0); })));
+
+  EXPECT_TRUE((verify_block_matches_tensor<int8_t>(
+    257, 129,
+    [](auto view) { TensorFillRandomUniform(view, 2021, 4, -4, 0); },
+    [](int8_t *ptr, size_t capacity) { BlockFillRandomUniform(ptr, capacity, 2021, 4, -4, 0); })));
+
+  EXPECT_TRUE((verify_block_matches_tensor<cutlass::complex<double>>(
+    67, 93,
+    [](auto view) { TensorFillRandomUniform(view, 2022, 1, -1); },
+    [](cutlass::complex<double> *ptr, size_t capacity) { BlockFillRandomUniform(ptr, capacity, 2022, 1, -1); })));
+}
+
+/// Values are keyed by logical coordinate, so they do not depend on the layout or thread count
+TEST(TensorFill, random_layout_and_thread_invariant) {
+
+  int rows = 513;
+  int columns = 127;
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> row_major({rows, columns}, false);
+  cutlass::HostTensor<float, cutlass::layout::ColumnMajor> column_major({rows, columns}, false);
+
+#if defined(_OPENMP)
+  int max_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+
+  cutlass::reference::host::TensorFillRandomGaussian(row_major.host_view(), 2024, 0, 1, -1, 75.0);
+
+#if defined(_OPENMP)
+  omp_set_num_threads(4);
+#endif
+
+  cutlass::reference::host::TensorFillRandomGaussian(column_major.host_view(), 2024, 0, 1, -1, 75.0);
+
+#if defined(_OPENMP)
+  omp_set_num_threads(max_threads);
+#endif
+
+  int errors = 0;
+  for (int row = 0; row < rows; ++row) {
+    for (int column = 0; column < columns; ++column) {
+      if (row_major.at({row, column}) != column_major.at({row, column})) {
+        ++errors;
+      }
+    }
+  }
+
+  EXPECT_EQ(errors, 0);
+}
+
+TEST(TensorFill, random_distribution_moments) {
+
+  size_t capacity = 1 << 20;
+
+  std::vector<double> gaussian(capacity);
+  cutlass::reference::host::BlockFillRandomGaussian(gaussian.data(), capacity, 2025, 3.0, 2.0);
+
+  double sum = 0;
+  double sum_sq = 0;
+  for (double x : gaussian) {
+    sum += x;
+    sum_sq += x * x;
+  }
+
+  double mean = sum / double(capacity);
+  double stddev = std::sqrt(sum_sq / double(capacity) - mean * mean);
+
+  EXPECT_LT(std::abs(mean - 3.0), 0.01);
+  EXPECT_LT(std::abs(stddev - 2.0), 0.01);
+
+  std::vector<float> uniform(capacity);
+  cutlass::reference::host::BlockFillRandomUniform(uniform.data(), capacity, 2026, 5.0, -3.0);
+
+  float min = uniform[0];
+  float max = uniform[0];
+  sum = 0;
+  for (float x : uniform) {
+    min = std::min(min, x);
+    max = std::max(max, x);
+    sum += x;
+  }
+
+  EXPECT_TRUE(min >= -3.0f && max <= 5.0f);
+  EXPECT_LT(std::abs(sum / double(capacity) - 1.0), 0.01);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
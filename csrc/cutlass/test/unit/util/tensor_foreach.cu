@@ -0,0 +1,182 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include <cmath>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_copy.h"
+#include "cutlass/util/reference/host/tensor_elementwise.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
+#include "cutlass/util/reference/host/tensor_reduce.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(TensorForEach, parallel_fill_linear_nhwc) {
+
+  cutlass::Tensor4DCoord extent(3, 37, 41, 67);
+  cutlass::HostTensor<int32_t, cutlass::layout::TensorNHWC> tensor(extent, false);
+
+  cutlass::Array<int32_t, 4> v;
+  v[0] = 1000000;
+  v[1] = 10000;
+  v[2] = 100;
+  v[3] = 1;
+
+  cutlass::reference::host::TensorFillLinear(tensor.host_view(), v, int32_t(7));
+
+  int errors = 0;
+  auto view = tensor.host_view();
+  cutlass::reference::host::TensorForEachLambda(extent, [&](cutlass::Tensor4DCoord const &coord) {
+    int32_t expected = 7 + coord.n() * v[0] + coord.h() * v[1] + coord.w() * v[2] + coord.c() * v[3];
+    if (view.at(coord) != expected) {
+      ++errors;
+    }
+  });
+
+  EXPECT_EQ(errors, 0);
+}
+
+TEST(TensorForEach, parallel_fill_padded_rowmajor) {
+
+  int rows = 301;
+  int columns = 257;
+  int ldm = 263;
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> tensor(
+    {rows, columns}, cutlass::layout::RowMajor(ldm), false);
+
+  cutlass::reference::host::BlockFill(tensor.host_data(), tensor.capacity(), -1.0f);
+  cutlass::reference::host::TensorFill(tensor.host_view(), 5.0f);
+
+  int errors = 0;
+  for (int row = 0; row < rows; ++row) {
+    for (int column = 0; column < ldm; ++column) {
+      float expected = (column < columns ? 5.0f : -1.0f);
+      if (tensor.host_data()[row * ldm + column] != expected) {
+        ++errors;
+      }
+    }
+  }
+
+  EXPECT_EQ(errors, 0);
+}
+
+TEST(TensorForEach, parallel_copy_add_nhwc) {
+
+  cutlass::Tensor4DCoord extent(2, 33, 65, 40);
+
+  cutlass::HostTensor<float, cutlass::layout::TensorNHWC> tensor_a(extent, false);
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::TensorNHWC> tensor_b(extent, false);
+  cutlass::HostTensor<float, cutlass::layout::TensorNHWC> tensor_c(extent, false);
+  cutlass::HostTensor<float, cutlass::layout::TensorNHWC> tensor_d(extent, false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_a.host_view(), 2023, 8, -8, 0);
+  cutlass::reference::host::TensorCopy(tensor_b.host_view(), tensor_a.host_view());
+  cutlass::reference::host::TensorCopy(tensor_c.host_view(), tensor_b.host_view());
+  cutlass::reference::host::TensorAdd(tensor_d.host_view(), tensor_a.host_ref(), tensor_c.host_ref());
+
+  int errors = 0;
+  auto view_a = tensor_a.host_view();
+  auto view_c = tensor_c.host_view();
+  auto view_d = tensor_d.host_view();
+  cutlass::reference::host::TensorForEachLambda(extent, [&](cutlass::Tensor4DCoord const &coord) {
+    if (view_c.at(coord) != view_a.at(coord) || view_d.at(coord) != 2 * view_a.at(coord)) {
+      ++errors;
+    }
+  });
+
+  EXPECT_EQ(errors, 0);
+}
+
+TEST(TensorForEach, parallel_equals_detects_single_mismatch) {
+
+  cutlass::Tensor4DCoord extent(4, 31, 29, 64);
+
+  cutlass::HostTensor<int8_t, cutlass::layout::TensorNHWC> tensor_a(extent, false);
+  cutlass::HostTensor<int8_t, cutlass::layout::TensorNHWC> tensor_b(extent, false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_a.host_view(), 2024, 100, -100, 0);
+  cutlass::reference::host::TensorCopy(tensor_b.host_view(), tensor_a.host_view());
+
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(tensor_a.host_view(), tensor_b.host_view()));
+
+  cutlass::Tensor4DCoord last(3, 30, 28, 63);
+  tensor_b.host_view().at(last) = int8_t(tensor_a.host_view().at(last) + 1);
+
+  EXPECT_FALSE(cutlass::reference::host::TensorEquals(tensor_a.host_view(), tensor_b.host_view()));
+  EXPECT_TRUE(cutlass::reference::host::TensorNotEquals(tensor_a.host_view(), tensor_b.host_view()));
+}
+
+/// The chunked reduction combines partials in a fixed order, so sums are bitwise reproducible
+/// regardless of the number of threads.
+TEST(TensorReduce, parallel_sum_reproducible_f32) {
+
+  cutlass::Tensor4DCoord extent(5, 43, 47, 33);
+  cutlass::HostTensor<float, cutlass::layout::TensorNHWC> tensor(extent, false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor.host_view(), 2025, 1, -1);
+
+  double expected = 0;
+  for (int64_t i = 0; i < tensor.capacity(); ++i) {
+    expected += double(tensor.host_data()[i]);
+  }
+
+#if defined(_OPENMP)
+  int max_threads = omp_get_max_threads();
+
+  omp_set_num_threads(1);
+  float sum_serial = cutlass::reference::host::TensorSum(tensor.host_view());
+
+  omp_set_num_threads(4);
+  float sum_parallel = cutlass::reference::host::TensorSum(tensor.host_view());
+
+  omp_set_num_threads(max_threads);
+
+  EXPECT_EQ(sum_serial, sum_parallel);
+#else
+  float sum_parallel = cutlass::reference::host::TensorSum(tensor.host_view());
+#endif
+
+  EXPECT_EQ(sum_parallel, cutlass::reference::host::TensorSum(tensor.host_view()));
+  EXPECT_LT(std::abs(double(sum_parallel) - expected), 1e-2);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
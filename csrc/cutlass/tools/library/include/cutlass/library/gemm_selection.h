@@ -0,0 +1,268 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Selection of GEMM operations for a problem
+
+    Handle ranks the operations that can run a problem instead of taking the first one in the
+    manifest. The default selector estimates runtimes with an analytical model of wave
+    quantization, tile padding and split-K, and prefers runtimes measured by the CUTLASS profiler
+    when a table of them has been loaded for the problem.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "cutlass/library/library.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Problem and device for which a GEMM operation is selected
+struct GemmSelectionProblem {
+
+  /// GEMM problem size
+  int m;
+  int n;
+  int k;
+
+  /// Number of independent GEMMs
+  int batch_count;
+
+  /// Number of slices K is split into by the caller
+  int split_k_slices;
+
+  /// Number of multiprocessors of the device
+  int sm_count;
+
+  GemmSelectionProblem(
+    int m = 0,
+    int n = 0,
+    int k = 0,
+    int batch_count = 1,
+    int split_k_slices = 1,
+    int sm_count = 108
+  ):
+    m(m), n(n), k(k), batch_count(batch_count), split_k_slices(split_k_slices), sm_count(sm_count) { }
+};
+
+/// Estimate of the analytical model for one operation and problem
+struct GemmCostEstimate {
+
+  /// Threadblock tiles launched, including split-K slices and batches
+  int64_t tiles;
+
+  /// Number of waves of tiles over the device
+  int64_t waves;
+
+  /// Fraction of the tile slots of all waves that hold a tile
+  double wave_efficiency;
+
+  /// Fraction of the padded M x N x K volume covered by tiles that is part of the problem
+  double tile_efficiency;
+
+  /// Split-K slice count up to GemmPerformanceModel::max_split_k_slices that minimizes the
+  /// modeled runtime
+  int split_k_slices;
+
+  /// Modeled runtime in multiprocessor cycles for the problem's own split-K slice count
+  double cycles;
+
+  GemmCostEstimate():
+    tiles(0), waves(0), wave_efficiency(0), tile_efficiency(0), split_k_slices(1), cycles(0) { }
+};
+
+/// Analytical GEMM performance model. A tile walks K in threadblock-sized steps, each bound by
+/// either math throughput or operand traffic, and tiles run in waves of one tile per
+/// multiprocessor. Split-K slices add a reduction over the partial outputs.
+class GemmPerformanceModel {
+public:
+
+  /// Multiply-adds per cycle and multiprocessor of tensor core operations on 16-bit operands.
+  /// Narrower operands scale it up and wider operands scale it down.
+  double tensor_op_rate;
+
+  /// Multiply-adds per cycle and multiprocessor of SIMT operations
+  double simt_rate;
+
+  /// Operand bytes per cycle and multiprocessor delivered by the memory hierarchy
+  double bandwidth;
+
+  /// Fixed cycles per tile for launch, prologue and epilogue
+  double tile_overhead;
+
+  /// Largest split-K slice count considered by GemmCostEstimate::split_k_slices
+  int max_split_k_slices;
+
+  GemmPerformanceModel(
+    double tensor_op_rate = 1024,
+    double simt_rate = 64,
+    double bandwidth = 64,
+    double tile_overhead = 2000,
+    int max_split_k_slices = 16
+  ):
+    tensor_op_rate(tensor_op_rate),
+    simt_rate(simt_rate),
+    bandwidth(bandwidth),
+    tile_overhead(tile_overhead),
+    max_split_k_slices(max_split_k_slices) { }
+
+  /// Estimates the runtime of an operation on a problem
+  GemmCostEstimate estimate(GemmDescription const &desc, GemmSelectionProblem const &problem) const;
+
+  /// Modeled cycles of an operation on a problem split into split_k_slices slices
+  double cycles(GemmDescription const &desc, GemmSelectionProblem const &problem, int split_k_slices) const;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Runtimes of GEMM operations measured by the CUTLASS profiler, keyed by operation name and
+/// problem size
+class GemmPerformanceTable {
+public:
+
+  /// Problem size of a measurement: m, n, k, batch count and split-K slices
+  using ProblemKey = std::tuple<int, int, int, int, int>;
+
+  static ProblemKey problem_key(GemmSelectionProblem const &problem);
+
+  /// Records a runtime in milliseconds, keeping the fastest of repeated measurements
+  void insert(std::string const &operation_name, GemmSelectionProblem const &problem, double runtime);
+
+  /// Finds the runtime in milliseconds of an operation on a problem
+  bool find(std::string const &operation_name, GemmSelectionProblem const &problem, double &runtime) const;
+
+  /// Imports successful GEMM results from CSV written by the profiler's --output option. Returns
+  /// the number of measurements imported, or -1 if the header lacks the required columns.
+  int load_csv(std::istream &in);
+
+  /// Imports a profiler CSV file. Returns -1 if it cannot be opened or parsed.
+  int load_csv(std::string const &path);
+
+  /// Number of measurements
+  size_t size() const;
+
+  /// Removes all measurements
+  void clear();
+
+private:
+
+  std::map<std::string, std::map<ProblemKey, double>> runtimes_;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Candidate operation with the estimate it was ranked by
+struct GemmSelectionCandidate {
+
+  Operation const *operation;
+
+  /// True if runtime was measured by the profiler, in milliseconds. Otherwise runtime is the
+  /// modeled cycle count.
+  bool measured;
+
+  double runtime;
+
+  /// Split-K slice count favored by the model
+  int split_k_slices;
+
+  GemmSelectionCandidate(
+    Operation const *operation = nullptr,
+    bool measured = false,
+    double runtime = 0,
+    int split_k_slices = 1
+  ):
+    operation(operation), measured(measured), runtime(runtime), split_k_slices(split_k_slices) { }
+};
+
+/// Orders the GEMM operations eligible for a problem
+class GemmOperationSelector {
+public:
+
+  virtual ~GemmOperationSelector() { }
+
+  /// Returns the candidates from most to least preferred. Candidates arrive in manifest order.
+  virtual std::vector<GemmSelectionCandidate> rank(
+    GemmSelectionProblem const &problem,
+    std::vector<Operation const *> const &candidates) const = 0;
+};
+
+/// Prefers the operation listed first in the manifest
+class GemmFirstFitSelector : public GemmOperationSelector {
+public:
+
+  std::vector<GemmSelectionCandidate> rank(
+    GemmSelectionProblem const &problem,
+    std::vector<Operation const *> const &candidates) const override;
+};
+
+/// Ranks operations measured on the problem by their measured runtime ahead of the rest, which
+/// are ranked by modeled runtime. Ties keep manifest order.
+class GemmModelSelector : public GemmOperationSelector {
+public:
+
+  GemmModelSelector(
+    GemmPerformanceModel const &model = GemmPerformanceModel(),
+    std::shared_ptr<GemmPerformanceTable const> table = nullptr
+  ):
+    model_(model), table_(table) { }
+
+  GemmPerformanceModel const &model() const { return model_; }
+
+  std::shared_ptr<GemmPerformanceTable const> table() const { return table_; }
+
+  std::vector<GemmSelectionCandidate> rank(
+    GemmSelectionProblem const &problem,
+    std::vector<Operation const *> const &candidates) const override;
+
+private:
+
+  GemmPerformanceModel model_;
+  std::shared_ptr<GemmPerformanceTable const> table_;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
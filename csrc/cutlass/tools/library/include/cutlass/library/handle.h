@@ -36,6 +36,8 @@
 
 #include <memory>
 #include "cutlass/library/library.h"
+#include "cutlass/library/gemm_selection.h"
+#include "cutlass/library/operation_index.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -72,9 +74,22 @@ private:
   /// Pointer to the most recently executed operation
   Operation const *last_operation_;
 
+  /// Ranks the GEMM operations eligible for a problem
+  std::shared_ptr<GemmOperationSelector const> gemm_selector_;
+
+  /// GEMM operations selected for recent problems
+  GemmOperationCache gemm_cache_;
+
+  /// Finds the best kernel for a problem of a given alignment
+  Operation const *find_gemm_operation_(
+    GemmFunctionalKey const &key,
+    int alignment,
+    GemmSelectionProblem const &problem);
+
 public:
 
-  /// Constructor
+  /// Constructor. Without a CUDA device, no workspace is allocated and only operations with a
+  /// minimum compute capability of zero, such as host references, are found.
   Handle(cudaStream_t stream = nullptr, size_t workspace_size = (4<<20));
 
   /// Destructor
@@ -123,6 +138,13 @@ public:
   /// Gets the most recently executed operation
   Operation const *get_last_operation() const;
 
+  /// Gets the selector ranking GEMM operations
+  std::shared_ptr<GemmOperationSelector const> get_gemm_selector() const;
+
+  /// Sets the selector ranking GEMM operations. A null selector restores the default
+  /// GemmModelSelector.
+  void set_gemm_selector(std::shared_ptr<GemmOperationSelector const> selector);
+
   //
   // Computations
   //
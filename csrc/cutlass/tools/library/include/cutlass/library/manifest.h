@@ -32,14 +32,25 @@
 /*! \file
     \brief Manifest of CUTLASS Library
 
-    This is the root of the data structure containing CUTLASS objects
+    This is the root of the data structure containing CUTLASS objects.
+
+    Generated libraries register a lightweight descriptor for each configuration of operations.
+    The manifest constructs the operations of the configurations passing its filter when its
+    operations are first accessed, so operations that are filtered out are never constructed.
+    Registrations are indexed by kind and functional key, so that operation tables constructed
+    from the manifest build only the configurations their lookups reach.
 */
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -65,6 +76,74 @@ void initialize_all_reduction_op(Manifest &manifest);
 /// List of operations
 using OperationVector = std::vector<std::unique_ptr<Operation>>;
 
+/// Function appending the operations of a generated configuration to the manifest
+using ConfigurationInitializer = void (*)(Manifest &manifest);
+
+/// Descriptor of a generated configuration, registered in place of its operations
+struct ConfigurationRegistration {
+
+  /// Kind of the operations of the configuration
+  OperationKind kind;
+
+  /// Minimum compute capability of the operations of the configuration
+  int minimum_compute_capability;
+
+  /// Comma-separated names of the operations of the configuration
+  char const *operation_names;
+
+  /// Appends the operations of the configuration
+  ConfigurationInitializer initializer;
+
+  /// Semicolon-separated functional keys of the operations of the configuration, in the form of
+  /// configuration_key(). If null or empty, the configuration is constructed by the first lookup
+  /// of its kind.
+  char const *functional_keys = nullptr;
+};
+
+/// Functional key under which configurations are registered: the element types of the A, B and
+/// C operands (e.g. "f16,f16,f32"), which generated libraries know without constructing their
+/// operations. A lookup constructs every configuration of its kind sharing them.
+std::string configuration_key(
+  NumericTypeID element_A,
+  NumericTypeID element_B,
+  NumericTypeID element_C);
+
+/// Selects the operations a manifest constructs
+struct ManifestFilter {
+
+  /// Kinds of operations constructed. If empty, operations of all kinds are constructed.
+  std::vector<OperationKind> kinds;
+
+  /// If positive, generated configurations requiring a later compute capability are not
+  /// constructed
+  int compute_capability;
+
+  /// Name patterns of the form "gemm*f16*nt", matched as the profiler's --kernels option. If not
+  /// empty, generated configurations are constructed only if one of their operations matches.
+  std::vector<std::string> names;
+
+  /// Name patterns excluding the generated configurations of operations matching them
+  std::vector<std::string> excluded_names;
+
+  ManifestFilter(): compute_capability(0) { }
+
+  /// Returns true if operations of a kind are constructed
+  bool kind_enabled(OperationKind kind) const {
+    if (kinds.empty()) {
+      return true;
+    }
+    for (OperationKind enabled : kinds) {
+      if (enabled == kind) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Returns true if the operations of a generated configuration are constructed
+  bool accepts(ConfigurationRegistration const &registration) const;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Manifest of CUTLASS Library
@@ -77,26 +156,93 @@ private:
   /// Global list of operations
   OperationVector operations_;
 
+  /// Selects the operations constructed
+  ManifestFilter filter_;
+
+  /// Generated configurations registered
+  std::vector<ConfigurationRegistration> registrations_;
+
+  /// Number of registrations checked against the filter and indexed
+  size_t indexed_count_ = 0;
+
+  /// Registrations passing the filter whose operations have not been constructed, by kind and
+  /// functional key
+  std::map<std::pair<OperationKind, std::string>, std::vector<size_t>> registration_index_;
+
+  /// True for registrations whose operations have been constructed or that the filter rejects
+  std::vector<bool> resolved_;
+
+  /// Guards construction of registered configurations on first access
+  mutable std::mutex mutex_;
+
+  /// True if configurations have been registered since operations were last accessed
+  mutable std::atomic<bool> pending_{false};
+
+  /// Indexes the registrations passing the filter. Requires mutex_ to be held.
+  void index_registrations_();
+
+  /// Constructs the operations of a registration unless already constructed. Requires mutex_ to
+  /// be held.
+  void construct_(size_t registration);
+
+  /// Constructs the operations of registered configurations passing the filter
+  void materialize_() const;
+
 public:
-  Manifest (Provider provider = library::Provider::kCUTLASS) : provider_(provider) { }
+  Manifest (
+    Provider provider = library::Provider::kCUTLASS,
+    ManifestFilter const &filter = ManifestFilter()
+  ) : provider_(provider), filter_(filter) { }
 
   /// Top-level initialization
   Status initialize();
 
+  /// Replaces the filter and initializes the manifest
+  Status initialize(ManifestFilter const &filter);
+
+  /// Filter selecting the operations constructed
+  ManifestFilter const &filter() const {
+    return filter_;
+  }
+
   /// Used for initialization
   void reserve(size_t operation_count);
 
   /// Graceful shutdown
   Status release();
 
-  /// Appends an operation and takes ownership
+  /// Appends an operation and takes ownership. Operations of kinds the filter disables are
+  /// destroyed.
   void append(Operation *operation_ptr) {\
     // This function is inline s.t. it is present in generated libraries
     // without having to compile or link in manifest.cpp
-    operations_.emplace_back(operation_ptr);
+    std::unique_ptr<Operation> operation(operation_ptr);
+    if (filter_.kind_enabled(operation->description().kind)) {
+      operations_.push_back(std::move(operation));
+    }
   }
 
-  /// Returns an iterator to the first operation
+  /// Registers a generated configuration, whose operations are appended when the manifest's
+  /// operations are first accessed
+  void register_configuration(ConfigurationRegistration const &registration) {
+    // Inline for the same reason as append()
+    registrations_.push_back(registration);
+    pending_.store(true, std::memory_order_release);
+  }
+
+  /// Number of registered configurations passing the filter whose operations have not been
+  /// constructed yet
+  size_t pending_configuration_count() const;
+
+  /// Constructs the operations of the registered configurations of a kind whose functional key
+  /// is the given configuration_key(), then returns the operations of the manifest from index
+  /// `first` on. Other registered configurations stay pending.
+  std::vector<Operation const *> materialize(
+    OperationKind kind,
+    std::string const &functional_key,
+    size_t first = 0) const;
+
+  /// Returns the operations, constructing those of registered configurations first
   OperationVector const &operations() const;
 
   /// Returns a const iterator
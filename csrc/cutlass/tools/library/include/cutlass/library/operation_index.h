@@ -0,0 +1,236 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Immutable index of the operations in the manifest used to select GEMM operations
+
+    The index is built from every operation of a manifest, or attached to a manifest and filled
+    on lookup, constructing the configurations of the functional keys looked up. It hashes each
+    GEMM functional key onto the operations implementing it, with the compute capabilities and alignment that decide
+    their eligibility precomputed and ordered by preference. GemmOperationCache memoizes the
+    selection for problems a Handle sees repeatedly, such as those of a serving loop.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/operation_table.h"
+#include "cutlass/library/gemm_selection.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Properties of a GEMM operation deciding whether it is eligible for a problem
+struct GemmOperationIndexEntry {
+
+  Operation const *operation;
+
+  int minimum_compute_capability;
+  int maximum_compute_capability;
+
+  /// Largest alignment required of the A, B and C operands
+  int alignment;
+
+  GemmOperationIndexEntry(
+    Operation const *operation = nullptr,
+    int minimum_compute_capability = 0,
+    int maximum_compute_capability = 0,
+    int alignment = 0
+  ):
+    operation(operation),
+    minimum_compute_capability(minimum_compute_capability),
+    maximum_compute_capability(maximum_compute_capability),
+    alignment(alignment) { }
+};
+
+/// Operations of one functional key, in descending order of minimum compute capability, then of
+/// alignment. Operations with equal compute capability and alignment keep manifest order.
+using GemmOperationIndexVector = std::vector<GemmOperationIndexEntry>;
+
+/// Maps a GemmFunctionalKey onto the operations implementing it
+using GemmOperationIndexMap = std::unordered_map<
+  GemmFunctionalKey,
+  GemmOperationIndexVector,
+  GemmFunctionalKeyHasher
+>;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Index of the operations of a manifest. The index refers to the operations without owning them.
+class OperationIndex {
+public:
+
+  /// Indexes the operations
+  void build(OperationVector const &operations);
+
+  /// Indexes the operations of the manifest on lookup. The manifest must outlive the index.
+  void attach(Manifest const &manifest);
+
+  /// Removes all operations
+  void clear();
+
+  /// Returns the operations of a functional key, or nullptr if there are none
+  GemmOperationIndexVector const *find_gemm_operations(GemmFunctionalKey const &key) const;
+
+  /// Returns the operation a selector ranks first among those of the highest compute capability,
+  /// then alignment, that run on the device and whose alignment the problem satisfies. Returns
+  /// nullptr if no operation is eligible.
+  Operation const *find_gemm_operation(
+    GemmFunctionalKey const &key,
+    int compute_capability,
+    int alignment,
+    GemmSelectionProblem const &problem,
+    GemmOperationSelector const &selector) const;
+
+  /// Returns the operation of the given compute capability and alignment whose tile description
+  /// matches, or nullptr if there is none
+  Operation const *find_gemm_operation(
+    GemmFunctionalKey const &key,
+    int minimum_compute_capability,
+    int alignment,
+    TileDescription const &tile_description) const;
+
+private:
+
+  /// Indexes operations, then restores the preference order of the functional keys they extend
+  void insert_(std::vector<Operation const *> const &operations);
+
+  GemmOperationIndexMap gemm_operations_;
+
+  /// Manifest the index is filled from on lookup, if attached
+  Manifest const *manifest_ = nullptr;
+
+  /// Number of operations of the attached manifest indexed
+  size_t indexed_count_ = 0;
+
+  /// Guards lookups filling the index
+  mutable std::mutex mutex_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Fixed-capacity cache of the GEMM operations selected for recent problems. Lookups neither
+/// allocate nor rank candidates. Problems are keyed by their exact extents, as rankings depend on
+/// them. A cached selection becomes stale when the selector changes; the owner then clears it.
+class GemmOperationCache {
+public:
+
+  /// Number of problems held. Problems mapping onto the same slot replace each other.
+  static constexpr int kCapacity = 64;
+
+  struct Key {
+
+    GemmFunctionalKey functional_key;
+    int compute_capability;
+    int alignment;
+    int m;
+    int n;
+    int k;
+    int batch_count;
+    int split_k_slices;
+
+    Key(
+      GemmFunctionalKey const &functional_key = GemmFunctionalKey(Provider::kInvalid),
+      int compute_capability = 0,
+      int alignment = 0,
+      GemmSelectionProblem const &problem = GemmSelectionProblem()
+    ):
+      functional_key(functional_key),
+      compute_capability(compute_capability),
+      alignment(alignment),
+      m(problem.m),
+      n(problem.n),
+      k(problem.k),
+      batch_count(problem.batch_count),
+      split_k_slices(problem.split_k_slices) { }
+
+    bool operator==(Key const &rhs) const {
+      return functional_key == rhs.functional_key &&
+        compute_capability == rhs.compute_capability &&
+        alignment == rhs.alignment &&
+        m == rhs.m && n == rhs.n && k == rhs.k &&
+        batch_count == rhs.batch_count &&
+        split_k_slices == rhs.split_k_slices;
+    }
+
+    size_t hash() const;
+  };
+
+  GemmOperationCache();
+
+  /// Returns true and the selected operation, which may be nullptr, if the key is cached
+  bool find(Key const &key, Operation const *&operation) const;
+
+  /// Caches the operation selected for a key
+  void insert(Key const &key, Operation const *operation);
+
+  /// Removes all selections
+  void clear();
+
+  /// Number of lookups that found their key
+  int64_t hits() const { return hits_; }
+
+  /// Number of lookups that did not find their key
+  int64_t misses() const { return misses_; }
+
+private:
+
+  struct Slot {
+    bool valid;
+    Key key;
+    Operation const *operation;
+
+    Slot(): valid(false), operation(nullptr) { }
+  };
+
+  std::array<Slot, kCapacity> slots_;
+
+  mutable int64_t hits_;
+  mutable int64_t misses_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
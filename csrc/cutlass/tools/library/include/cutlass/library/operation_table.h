@@ -37,6 +37,8 @@
 #pragma once
 #include <fstream>
 #include <iosfwd>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <algorithm>
 
@@ -501,7 +503,9 @@ using ReductionOperationFunctionalMap = std::unordered_map<
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Table of cutlass::library::Operation instances
+/// Table of cutlass::library::Operation instances. A table filled by append() holds every
+/// operation of the manifest. A table attached to a manifest holds, once a lookup returns, the
+/// operations of the functional keys looked up, and constructs their configurations on demand.
 class OperationTable {
 public:
 
@@ -523,8 +527,41 @@ public:
 
 public:
 
+  /// Inserts every operation of the manifest
   void append(Manifest const &manifest);
 
+  /// Fills the table from the manifest on lookup. The manifest must outlive the table.
+  void attach(Manifest const &manifest);
+
+  /// Returns the operations of a functional key, or nullptr if there are none
+  GemmOperationVectorMap const *find_gemm_operations(GemmFunctionalKey const &key) const;
+
+  /// Returns the operations of a functional key, or nullptr if there are none
+  ConvOperationVectorMap const *find_conv2d_operations(ConvFunctionalKey const &key) const;
+
+  /// Returns the operations of a functional key, or nullptr if there are none
+  ConvOperationVectorMap const *find_conv3d_operations(ConvFunctionalKey const &key) const;
+
+  /// Returns the operation of a functional key, or nullptr if there is none
+  Operation const *find_reduction_operation(ReductionFunctionalKey const &key) const;
+
+private:
+
+  /// Inserts an operation into the map of its kind
+  void insert_(Operation const *operation);
+
+  /// Constructs the configurations of a kind and functional key in the attached manifest and
+  /// inserts the operations constructed since the last update
+  void update_(OperationKind kind, std::string const &functional_key) const;
+
+  /// Manifest the table is filled from on lookup, if attached
+  Manifest const *manifest_ = nullptr;
+
+  /// Number of operations of the attached manifest inserted
+  size_t inserted_count_ = 0;
+
+  /// Guards lookups filling the table
+  mutable std::mutex mutex_;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,204 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+/*! \file
+    \brief Cache of host reference results
+
+    Host reference operations store their outputs under a hash of everything that determines
+    them: the operation, its configuration and scalars, and the contents of its input tensors.
+    Verifying many kernels of one problem computes the host reference once; since inputs are
+    hashed rather than described, any change of initialization distribution or seed is a miss.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cutlass/cutlass.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Content-addressed cache of host reference outputs, held in memory up to a capacity and
+/// optionally backed by a directory shared between processes
+class ReferenceCache {
+public:
+
+  /// 128-bit content hash
+  struct Key {
+    uint64_t lo{0};
+    uint64_t hi{0};
+
+    bool operator==(Key const &rhs) const {
+      return lo == rhs.lo && hi == rhs.hi;
+    }
+
+    /// Hexadecimal representation, used as the file name of the on-disk entry
+    std::string to_string() const;
+  };
+
+  /// Accumulates the hash of a key
+  class KeyBuilder {
+  private:
+    uint64_t state_[2];
+    uint64_t length_;
+
+  public:
+    KeyBuilder();
+
+    /// Appends bytes
+    KeyBuilder &append(void const *data, size_t bytes);
+
+    /// Appends a string, including its length
+    KeyBuilder &append(std::string const &str);
+
+    /// Appends the object representation of a trivially copyable value
+    template <typename T>
+    KeyBuilder &append_value(T const &value) {
+      return append(&value, sizeof(value));
+    }
+
+    /// Returns the key of everything appended so far
+    Key key() const;
+  };
+
+private:
+
+  struct KeyHash {
+    size_t operator()(Key const &key) const {
+      return size_t(key.lo);
+    }
+  };
+
+  struct Entry {
+    Key key;
+    std::vector<uint8_t> data;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  /// Guards all members
+  mutable std::mutex mutex_;
+
+  bool enabled_;
+  size_t capacity_;
+  std::string directory_;
+
+  /// Entries from most to least recently used
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+  size_t bytes_;
+
+  size_t hits_;
+  size_t misses_;
+
+  /// Evicts least recently used entries until bytes_ fits the capacity. Requires mutex_.
+  void evict_();
+
+  /// Inserts an entry as most recently used. Requires mutex_.
+  void insert_(Key const &key, void const *data, size_t bytes);
+
+public:
+
+  /// Disabled, with a capacity of 1 GiB once enabled and no on-disk backing
+  ReferenceCache();
+
+  /// Process-wide cache used by the host reference operations. Library users keep no results
+  /// unless they enable it, as the profiler does for --reference-cache.
+  static ReferenceCache &get();
+
+  /// Enables or disables lookups and insertions
+  void set_enabled(bool enabled);
+
+  /// True if lookups and insertions are enabled
+  bool enabled() const;
+
+  /// Limits the total size of in-memory entries, evicting the least recently used
+  void set_capacity(size_t bytes);
+
+  /// Stores entries in a directory, which is created if needed, and finds entries there that
+  /// are not in memory. An empty path disables the on-disk backing.
+  void set_directory(std::string const &path);
+
+  /// If an entry of exactly \p bytes bytes exists for \p key, copies it to \p data and returns
+  /// true
+  bool find(Key const &key, void *data, size_t bytes);
+
+  /// Stores \p bytes bytes under \p key
+  void insert(Key const &key, void const *data, size_t bytes);
+
+  /// Removes all in-memory entries and resets statistics
+  void clear();
+
+  /// Number of lookups satisfied from memory or disk
+  size_t hits() const;
+
+  /// Number of lookups that were not satisfied
+  size_t misses() const;
+
+  /// Total size of in-memory entries
+  size_t bytes() const;
+
+  /// Writes the output of \p compute to \p data, or copies it from the cache if present. Only
+  /// successful results are cached.
+  template <typename Compute>
+  Status cached(Key const &key, void *data, size_t bytes, Compute compute) {
+    if (!enabled()) {
+      return compute();
+    }
+    if (find(key, data, bytes)) {
+      return Status::kSuccess;
+    }
+    Status status = compute();
+    if (status == Status::kSuccess) {
+      insert(key, data, bytes);
+    }
+    return status;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
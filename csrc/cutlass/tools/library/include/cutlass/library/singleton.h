@@ -34,6 +34,7 @@
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
 #include "cutlass/library/operation_table.h"
+#include "cutlass/library/operation_index.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -49,14 +50,21 @@ public:
   /// Manifest object
   Manifest manifest;
 
-  /// Operation table referencing the Manifest
+  /// Operation table referencing the Manifest, filled on lookup
   OperationTable operation_table;
 
+  /// Index of the Manifest used to select operations, filled on lookup
+  OperationIndex operation_index;
+
 public:
 
   Singleton();
 
   static Singleton const &get();
+
+  /// Selects the operations the manifest constructs when the singleton is created by the first
+  /// call to get(). Returns false, without effect, if the singleton has already been created.
+  static bool set_filter(ManifestFilter const &filter);
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -123,6 +123,7 @@ enum class Provider {
   kReferenceDevice,
   kCUBLAS,
   kCUDNN,
+  kHost,
   kInvalid
 };
 
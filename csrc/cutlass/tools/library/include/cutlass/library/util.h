@@ -195,6 +195,10 @@ bool cast_from_uint64(std::vector<uint8_t> &bytes, NumericTypeID type, uint64_t
 /// Casts from a real value represented as a double to the destination type. Returns true if successful.
 bool cast_from_double(std::vector<uint8_t> &bytes, NumericTypeID type, double src);
 
+/// Returns true if the substrings of a pattern of the form "gemm*f32*nt" appear in an operation
+/// name in order. The profiler's --kernels option and ManifestFilter match names this way.
+bool matches_operation_name(std::string const &pattern, std::string const &operation_name);
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 } // namespace library
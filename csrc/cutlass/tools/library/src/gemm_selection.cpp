@@ -0,0 +1,359 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Selection of GEMM operations for a problem
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "cutlass/library/gemm_selection.h"
+#include "cutlass/library/util.h"
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+int64_t ceil_div(int64_t a, int64_t b) {
+  return (a + b - 1) / b;
+}
+
+/// Threadblock shape of an operation, substituting a typical shape if it is not described
+gemm::GemmCoord selection_tile_shape(GemmDescription const &desc) {
+  gemm::GemmCoord tile = desc.tile_description.threadblock_shape;
+  if (tile.m() <= 0 || tile.n() <= 0 || tile.k() <= 0) {
+    return gemm::GemmCoord(128, 128, 32);
+  }
+  return tile;
+}
+
+/// Multiply-adds per cycle and multiprocessor of an operation
+double selection_math_rate(GemmPerformanceModel const &model, GemmDescription const &desc) {
+
+  int bits = std::max(int(library::sizeof_bits(desc.A.element)), int(library::sizeof_bits(desc.B.element)));
+  bits = std::max(bits, 1);
+
+  switch (desc.tile_description.math_instruction.opcode_class) {
+  case OpcodeClassID::kTensorOp:
+  case OpcodeClassID::kSparseTensorOp:
+  case OpcodeClassID::kWmmaTensorOp:
+    return model.tensor_op_rate * 16.0 / std::max(bits, 4);
+  default:
+    return model.simt_rate * std::min(1.0, 32.0 / bits);
+  }
+}
+
+/// Splits a line of CSV written by the profiler, which does not quote fields
+std::vector<std::string> split_csv_line(std::string const &line) {
+  std::vector<std::string> fields;
+  std::stringstream ss(line);
+  std::string field;
+  while (std::getline(ss, field, ',')) {
+    if (!field.empty() && field.back() == '\r') {
+      field.pop_back();
+    }
+    fields.push_back(field);
+  }
+  if (!line.empty() && line.back() == ',') {
+    fields.push_back(std::string());
+  }
+  return fields;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+double GemmPerformanceModel::cycles(
+  GemmDescription const &desc,
+  GemmSelectionProblem const &problem,
+  int split_k_slices) const {
+
+  gemm::GemmCoord tile = selection_tile_shape(desc);
+
+  int64_t const sm_count = std::max(problem.sm_count, 1);
+  int64_t const batch_count = std::max(problem.batch_count, 1);
+  int64_t const slices = std::max(split_k_slices, 1);
+
+  int64_t const tiles =
+    ceil_div(problem.m, tile.m()) * ceil_div(problem.n, tile.n()) * batch_count * slices;
+  int64_t const waves = ceil_div(tiles, sm_count);
+  int64_t const k_iterations = ceil_div(ceil_div(problem.k, slices), tile.k());
+
+  double const bits_A = double(library::sizeof_bits(desc.A.element));
+  double const bits_B = double(library::sizeof_bits(desc.B.element));
+  double const bits_C = double(library::sizeof_bits(desc.C.element));
+  double const bits_D = double(library::sizeof_bits(desc.D.element));
+  double const bits_accum = double(library::sizeof_bits(desc.tile_description.math_instruction.element_accumulator));
+
+  // Each mainloop iteration is bound by the slower of math and operand traffic.
+  double const math = double(tile.m()) * tile.n() * tile.k() / selection_math_rate(*this, desc);
+  double const memory = (tile.m() * bits_A + tile.n() * bits_B) / 8 * tile.k() / bandwidth;
+  double const epilogue = double(tile.m()) * tile.n() * (bits_C + bits_D) / 8 / bandwidth;
+
+  double result = double(waves) * (tile_overhead + double(k_iterations) * std::max(math, memory) + epilogue);
+
+  // Partial outputs of all slices are written and read back by the reduction.
+  if (slices > 1) {
+    double const partials = double(problem.m) * problem.n * batch_count * slices * std::max(bits_accum, 32.0) / 8;
+    result += 2 * partials / (bandwidth * sm_count) + tile_overhead;
+  }
+
+  return result;
+}
+
+GemmCostEstimate GemmPerformanceModel::estimate(
+  GemmDescription const &desc,
+  GemmSelectionProblem const &problem) const {
+
+  GemmCostEstimate estimate;
+
+  gemm::GemmCoord tile = selection_tile_shape(desc);
+
+  int64_t const sm_count = std::max(problem.sm_count, 1);
+  int64_t const batch_count = std::max(problem.batch_count, 1);
+  int64_t const slices = std::max(problem.split_k_slices, 1);
+
+  int64_t const tiles_m = ceil_div(problem.m, tile.m());
+  int64_t const tiles_n = ceil_div(problem.n, tile.n());
+  int64_t const k_iterations = ceil_div(ceil_div(problem.k, slices), tile.k());
+
+  estimate.tiles = tiles_m * tiles_n * batch_count * slices;
+  estimate.waves = ceil_div(estimate.tiles, sm_count);
+  estimate.wave_efficiency = estimate.waves ?
+    double(estimate.tiles) / double(estimate.waves * sm_count) : 0;
+
+  double const padded_volume =
+    double(tiles_m * tile.m()) * double(tiles_n * tile.n()) * double(slices * k_iterations * tile.k());
+  estimate.tile_efficiency = padded_volume > 0 ?
+    double(problem.m) * problem.n * problem.k / padded_volume : 0;
+
+  estimate.cycles = cycles(desc, problem, int(slices));
+
+  // Split-K pays off when too few tiles fill the device and K is long enough to divide.
+  double best = cycles(desc, problem, 1);
+  int64_t const max_slices = std::min<int64_t>(max_split_k_slices, ceil_div(problem.k, tile.k()));
+  for (int64_t candidate = 2; candidate <= max_slices; candidate *= 2) {
+    double candidate_cycles = cycles(desc, problem, int(candidate));
+    if (candidate_cycles < best) {
+      best = candidate_cycles;
+      estimate.split_k_slices = int(candidate);
+    }
+  }
+
+  return estimate;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+GemmPerformanceTable::ProblemKey GemmPerformanceTable::problem_key(GemmSelectionProblem const &problem) {
+  return ProblemKey(
+    problem.m, problem.n, problem.k, std::max(problem.batch_count, 1), std::max(problem.split_k_slices, 1));
+}
+
+void GemmPerformanceTable::insert(
+  std::string const &operation_name,
+  GemmSelectionProblem const &problem,
+  double runtime) {
+
+  auto &runtimes = runtimes_[operation_name];
+  auto result = runtimes.insert({problem_key(problem), runtime});
+  if (!result.second) {
+    result.first->second = std::min(result.first->second, runtime);
+  }
+}
+
+bool GemmPerformanceTable::find(
+  std::string const &operation_name,
+  GemmSelectionProblem const &problem,
+  double &runtime) const {
+
+  auto operation_it = runtimes_.find(operation_name);
+  if (operation_it == runtimes_.end()) {
+    return false;
+  }
+
+  auto it = operation_it->second.find(problem_key(problem));
+  if (it == operation_it->second.end()) {
+    return false;
+  }
+
+  runtime = it->second;
+  return true;
+}
+
+int GemmPerformanceTable::load_csv(std::istream &in) {
+
+  std::string line;
+  if (!std::getline(in, line)) {
+    return -1;
+  }
+
+  std::vector<std::string> header = split_csv_line(line);
+
+  auto column = [&](char const *name) {
+    auto it = std::find(header.begin(), header.end(), name);
+    return it == header.end() ? -1 : int(it - header.begin());
+  };
+
+  int const col_provider = column("Provider");
+  int const col_kind = column("OperationKind");
+  int const col_operation = column("Operation");
+  int const col_status = column("Status");
+  int const col_m = column("m");
+  int const col_n = column("n");
+  int const col_k = column("k");
+  int const col_batch_count = column("batch_count");
+  int const col_split_k_slices = column("split_k_slices");
+  int const col_runtime = column("Runtime");
+
+  if (col_operation < 0 || col_m < 0 || col_n < 0 || col_k < 0 || col_runtime < 0) {
+    return -1;
+  }
+
+  int imported = 0;
+
+  while (std::getline(in, line)) {
+    std::vector<std::string> fields = split_csv_line(line);
+    if (fields.size() != header.size()) {
+      continue;
+    }
+
+    if (col_provider >= 0 && from_string<Provider>(fields[col_provider]) != Provider::kCUTLASS) {
+      continue;
+    }
+    if (col_kind >= 0 && from_string<OperationKind>(fields[col_kind]) != OperationKind::kGemm) {
+      continue;
+    }
+    if (col_status >= 0 && fields[col_status] != to_string(Status::kSuccess)) {
+      continue;
+    }
+
+    try {
+      GemmSelectionProblem problem(
+        std::stoi(fields[col_m]),
+        std::stoi(fields[col_n]),
+        std::stoi(fields[col_k]),
+        col_batch_count >= 0 ? std::stoi(fields[col_batch_count]) : 1,
+        col_split_k_slices >= 0 ? std::stoi(fields[col_split_k_slices]) : 1);
+
+      double runtime = std::stod(fields[col_runtime]);
+
+      if (runtime > 0 && std::isfinite(runtime)) {
+        insert(fields[col_operation], problem, runtime);
+        ++imported;
+      }
+    }
+    catch (std::exception const &) {
+      // Skip rows with missing or malformed numbers.
+    }
+  }
+
+  return imported;
+}
+
+int GemmPerformanceTable::load_csv(std::string const &path) {
+  std::ifstream file(path);
+  if (!file.good()) {
+    return -1;
+  }
+  return load_csv(file);
+}
+
+size_t GemmPerformanceTable::size() const {
+  size_t count = 0;
+  for (auto const &runtimes : runtimes_) {
+    count += runtimes.second.size();
+  }
+  return count;
+}
+
+void GemmPerformanceTable::clear() {
+  runtimes_.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<GemmSelectionCandidate> GemmFirstFitSelector::rank(
+  GemmSelectionProblem const &,
+  std::vector<Operation const *> const &candidates) const {
+
+  std::vector<GemmSelectionCandidate> ranked;
+  for (auto const *operation : candidates) {
+    ranked.emplace_back(operation);
+  }
+  return ranked;
+}
+
+std::vector<GemmSelectionCandidate> GemmModelSelector::rank(
+  GemmSelectionProblem const &problem,
+  std::vector<Operation const *> const &candidates) const {
+
+  std::vector<GemmSelectionCandidate> ranked;
+
+  for (auto const *operation : candidates) {
+    GemmDescription const &desc = static_cast<GemmDescription const &>(operation->description());
+
+    GemmCostEstimate estimate = model_.estimate(desc, problem);
+    GemmSelectionCandidate candidate(operation, false, estimate.cycles, estimate.split_k_slices);
+
+    double runtime = 0;
+    if (table_ && table_->find(desc.name, problem, runtime)) {
+      candidate.measured = true;
+      candidate.runtime = runtime;
+    }
+
+    ranked.push_back(candidate);
+  }
+
+  std::stable_sort(ranked.begin(), ranked.end(),
+    [](GemmSelectionCandidate const &lhs, GemmSelectionCandidate const &rhs) {
+      if (lhs.measured != rhs.measured) {
+        return lhs.measured;
+      }
+      return lhs.runtime < rhs.runtime;
+    });
+
+  return ranked;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstdint>
+#include <cstring>
 
 #include "cutlass/library/handle.h"
 #include "cutlass/library/singleton.h"
@@ -55,11 +56,23 @@ Handle::Handle(
   workspace_(nullptr),
   workspace_size_(0),
   scalar_pointer_mode_(ScalarPointerMode::kHost),
-  last_operation_(nullptr) {
+  last_operation_(nullptr),
+  gemm_selector_(std::make_shared<GemmModelSelector>()) {
 
   int device_idx = -1;
 
   cudaError_t error = cudaGetDevice(&device_idx);
+
+  // Without a CUDA device, the handle only runs operations executed on the host
+  if (error == cudaErrorNoDevice || error == cudaErrorInsufficientDriver) {
+    cudaGetLastError();
+
+    std::memset(&device_, 0, sizeof(device_));
+
+    Singleton::get();
+    return;
+  }
+
   if (error != cudaSuccess) {
     throw std::runtime_error("cudaGetDevice() failed");
   }
@@ -94,6 +107,8 @@ Handle::Handle(Handle && handle) {
   workspace_ = handle.workspace_;
   stream_ = handle.stream_;
   scalar_pointer_mode_ = handle.scalar_pointer_mode_;
+  gemm_selector_ = handle.gemm_selector_;
+  gemm_cache_ = handle.gemm_cache_;
 
   handle.workspace_ = nullptr;
   handle.workspace_size_ = 0;
@@ -108,6 +123,8 @@ Handle & Handle::operator=(Handle && handle) {
   workspace_ = handle.workspace_;
   stream_ = handle.stream_;
   scalar_pointer_mode_ = handle.scalar_pointer_mode_;
+  gemm_selector_ = handle.gemm_selector_;
+  gemm_cache_ = handle.gemm_cache_;
 
   handle.workspace_ = nullptr;
   handle.workspace_size_ = 0;
@@ -194,14 +211,19 @@ Operation const *Handle::get_last_operation() const {
   return last_operation_;
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Gets the selector ranking GEMM operations
+std::shared_ptr<GemmOperationSelector const> Handle::get_gemm_selector() const {
+  return gemm_selector_;
+}
 
-/// Returns the maximum required alignment for each operator
-static int maximum_alignment_requirement(GemmDescription const &desc) {
-  return std::max(
-    std::max(desc.A.alignment, desc.B.alignment), desc.C.alignment);
+/// Sets the selector ranking GEMM operations
+void Handle::set_gemm_selector(std::shared_ptr<GemmOperationSelector const> selector) {
+  gemm_selector_ = selector ? selector : std::make_shared<GemmModelSelector>();
+  gemm_cache_.clear();
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Returns the largest alignment (in units of elements) the problem satisfies, starting from a
 /// given upper limit.
 static int gemm_problem_alignment(
@@ -284,42 +306,24 @@ static int gemm_problem_alignment(
   return 0;
 }
 
-/// Find the best kernel in descending order of preference.
-static Operation const * find_gemm_operation(
-  GemmOperationFunctionalMap::const_iterator operators_it,
-  GemmPreferenceKey const preference_key) {
-
-  auto cc_it = operators_it->second.upper_bound(preference_key);
+/// Finds the best kernel for a problem, consulting the selections cached for recent problems first
+Operation const *Handle::find_gemm_operation_(
+  GemmFunctionalKey const &key,
+  int alignment,
+  GemmSelectionProblem const &problem) {
 
-  if (cc_it == operators_it->second.begin()) {
-    return nullptr;
-  }
+  GemmOperationCache::Key cache_key(key, compute_capability(), alignment, problem);
 
   Operation const *operation = nullptr;
 
-  // Search in descending order of compute capability
-  do {
-    --cc_it;
-
-    // Search tile sizes in order, for now.
-    for (auto const * op : cc_it->second) {
-
-      GemmDescription const &desc = static_cast<GemmDescription const &>(op->description());
-
-      int min_cc = desc.tile_description.minimum_compute_capability;
-      int max_cc = desc.tile_description.maximum_compute_capability;
-
-      int op_alignment = maximum_alignment_requirement(desc);
+  if (gemm_cache_.find(cache_key, operation)) {
+    return operation;
+  }
 
-      if ((min_cc <= preference_key.compute_capability) &&
-        (preference_key.compute_capability <= max_cc) &&
-        (op_alignment <= preference_key.alignment)) {
+  operation = Singleton::get().operation_index.find_gemm_operation(
+    key, compute_capability(), alignment, problem, *gemm_selector_);
 
-        operation = op;
-        break;
-      }
-    }
-  } while (!operation && cc_it != operators_it->second.begin());
+  gemm_cache_.insert(cache_key, operation);
 
   return operation;
 }
@@ -385,13 +389,7 @@ Status Handle::gemm(
     LayoutTypeID::kColumnMajor
   );
 
-  auto operators_it = Singleton::get().operation_table.gemm_operations.find(key);
-
-  if (operators_it == Singleton::get().operation_table.gemm_operations.end()) {
-    return cutlass::Status::kErrorNotSupported;
-  }
-
-  if (operators_it->second.empty()) {
+  if (!Singleton::get().operation_index.find_gemm_operations(key)) {
     return cutlass::Status::kErrorNotSupported;
   }
 
@@ -414,9 +412,9 @@ Status Handle::gemm(
   // Find the best kernel in descending order of preference.
   //
 
-  GemmPreferenceKey preference_key(compute_capability(), alignment);
+  GemmSelectionProblem problem(M, N, K, 1, 1, device_.multiProcessorCount);
 
-  Operation const *operation = find_gemm_operation(operators_it, preference_key);
+  Operation const *operation = find_gemm_operation_(key, alignment, problem);
 
   if (!operation) {
     return cutlass::Status::kErrorNotSupported;
@@ -550,13 +548,7 @@ Status Handle::gemm_universal(
     layout_D
   );
 
-  auto operators_it = Singleton::get().operation_table.gemm_operations.find(key);
-
-  if (operators_it == Singleton::get().operation_table.gemm_operations.end()) {
-    return cutlass::Status::kErrorNotSupported;
-  }
-
-  if (operators_it->second.empty()) {
+  if (!Singleton::get().operation_index.find_gemm_operations(key)) {
     return cutlass::Status::kErrorNotSupported;
   }
 
@@ -593,9 +585,17 @@ Status Handle::gemm_universal(
   // Find the best kernel in descending order of preference.
   //
 
-  GemmPreferenceKey preference_key(compute_capability(), alignment);
 
-  Operation const *operation = find_gemm_operation(operators_it, preference_key);
+  // In the kGemm and kGemmSplitKParallel modes, batch_count is the number of split-K slices.
+  bool const split_k = (mode == GemmUniversalMode::kGemm || mode == GemmUniversalMode::kGemmSplitKParallel);
+
+  GemmSelectionProblem problem(
+    M, N, K,
+    split_k ? 1 : batch_count,
+    split_k ? batch_count : 1,
+    device_.multiProcessorCount);
+
+  Operation const *operation = find_gemm_operation_(key, alignment, problem);
 
   if (!operation) {
     return cutlass::Status::kErrorNotSupported;
@@ -752,13 +752,7 @@ Status Handle::gemm_planar_complex(
     LayoutTypeID::kColumnMajor
   );
 
-  auto operators_it = Singleton::get().operation_table.gemm_operations.find(key);
-
-  if (operators_it == Singleton::get().operation_table.gemm_operations.end()) {
-    return cutlass::Status::kErrorNotSupported;
-  }
-
-  if (operators_it->second.empty()) {
+  if (!Singleton::get().operation_index.find_gemm_operations(key)) {
     return cutlass::Status::kErrorNotSupported;
   }
 
@@ -790,9 +784,9 @@ Status Handle::gemm_planar_complex(
   // Find the best kernel in descending order of preference.
   //
 
-  GemmPreferenceKey preference_key(compute_capability(), alignment);
+  GemmSelectionProblem problem(M, N, K, batch_count, 1, device_.multiProcessorCount);
 
-  Operation const *operation = find_gemm_operation(operators_it, preference_key);
+  Operation const *operation = find_gemm_operation_(key, alignment, problem);
 
   if (!operation) {
     return cutlass::Status::kErrorNotSupported;
@@ -949,13 +943,7 @@ Status Handle::gemm_planar_complex_array(
     LayoutTypeID::kColumnMajor
   );
 
-  auto operators_it = Singleton::get().operation_table.gemm_operations.find(key);
-
-  if (operators_it == Singleton::get().operation_table.gemm_operations.end()) {
-    return cutlass::Status::kErrorNotSupported;
-  }
-
-  if (operators_it->second.empty()) {
+  if (!Singleton::get().operation_index.find_gemm_operations(key)) {
     return cutlass::Status::kErrorNotSupported;
   }
 
@@ -987,9 +975,9 @@ Status Handle::gemm_planar_complex_array(
   // Find the best kernel in descending order of preference.
   //
 
-  GemmPreferenceKey preference_key(compute_capability(), alignment);
+  GemmSelectionProblem problem(expected_M, expected_N, expected_K, batch_count, 1, device_.multiProcessorCount);
 
-  Operation const *operation = find_gemm_operation(operators_it, preference_key);
+  Operation const *operation = find_gemm_operation_(key, alignment, problem);
 
   if (!operation) {
     return cutlass::Status::kErrorNotSupported;
@@ -1086,19 +1074,12 @@ Operation const* find_conv_operation_for_parallel_reduction(Operation const *ope
     conv_desc.tile_description.math_instruction.element_accumulator,
     conv_desc.element_epilogue);
 
-  // conv operation table for conv2d or conv3d
-  auto conv_operations = (conv_desc.kind == OperationKind::kConv2d) ?
-                          Singleton::get().operation_table.conv2d_operations :
-                          Singleton::get().operation_table.conv3d_operations;
+  // find ConvFunctionalKey in the conv2d or conv3d operation table
+  ConvOperationVectorMap const *conv_operations = (conv_desc.kind == OperationKind::kConv2d) ?
+                          Singleton::get().operation_table.find_conv2d_operations(key) :
+                          Singleton::get().operation_table.find_conv3d_operations(key);
 
-  // find ConvFunctionalKey in convolution operation table
-  auto operators_it = conv_operations.find(key);
-
-  if (operators_it == conv_operations.end()) {
-    return nullptr;
-  }
-
-  if (operators_it->second.empty()) {
+  if (!conv_operations) {
     return nullptr;
   }
 
@@ -1107,9 +1088,9 @@ Operation const* find_conv_operation_for_parallel_reduction(Operation const *ope
     conv_desc.tile_description.minimum_compute_capability,
     conv_desc.iterator_algorithm);
 
-  auto it = operators_it->second.find(preference_key);
+  auto it = conv_operations->find(preference_key);
 
-  if(it == operators_it->second.end()) {
+  if(it == conv_operations->end()) {
     return nullptr;
   }
 
@@ -1153,44 +1134,18 @@ Operation const* find_gemm_operation_for_parallel_reduction(Operation const *ope
     gemm_desc.tile_description.math_instruction.element_accumulator,
     LayoutTypeID::kColumnMajor);
 
-  // gemm operation table
-  auto gemm_operations = Singleton::get().operation_table.gemm_operations;
-
-  // find ConvFunctionalKey in gemm operation table
-  auto operators_it = gemm_operations.find(key);
-
-  if (operators_it == gemm_operations.end()) {
-    return nullptr;
-  }
-
-  if (operators_it->second.empty()) {
-    return nullptr;
-  }
-
   // gemm operation for same compute capability and max operand alignment
   int alignment = std::max(
     gemm_desc.A.alignment,
     gemm_desc.B.alignment);
 
-  GemmPreferenceKey preference_key(
+  // return matching gemm opertion (same tile shape, stages, warp count, and instruction), or
+  // nullptr if no matching gemm operation found for parallel split-k reduction
+  return Singleton::get().operation_index.find_gemm_operation(
+    key,
     gemm_desc.tile_description.minimum_compute_capability,
-    alignment);
-
-  auto it = operators_it->second.find(preference_key);
-
-  if(it == operators_it->second.end()) {
-    return nullptr;
-  }
-
-  // return matching gemm opertion (same tile shape, stages, warp count, and instruction)
-  for (auto op : it->second) {
-    if (op->description().tile_description == operation->description().tile_description) {
-      return op;
-    }
-  }
-
-  // return nullptr if no matching gemm operation found for parallel split-k reduction
-  return nullptr;
+    alignment,
+    operation->description().tile_description);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,329 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+  \brief Defines convolution operations executed on the host in CUTLASS Library
+
+  These operations are backed by the implicit GEMM host convolution references. They let the
+  profiler enumerate, run, verify and report Conv2d and Conv3d operations on machines without a
+  CUDA device.
+*/
+
+#pragma once
+
+#include <sstream>
+#include <cstring>
+
+#include "cutlass/cutlass.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/util.h"
+#include "library_internal.h"
+
+#include "cutlass/conv/convolution.h"
+#include "cutlass/util/reference/host/convolution.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Convolution executed on the host. Operands, workspace and results reside in host memory.
+template <
+  cutlass::conv::Operator ConvolutionalOperator,
+  int ConvDim,
+  typename ElementA_,
+  typename LayoutA_,
+  typename ElementB_,
+  typename LayoutB_,
+  typename ElementC_,
+  typename LayoutC_,
+  typename ElementCompute_,
+  typename ElementAccumulator_ = ElementCompute_,
+  typename ConvertOp_ = NumericConverter<ElementC_, ElementCompute_>
+>
+class ConvHostOperation : public Operation {
+public:
+  static cutlass::conv::Operator const kConvolutionalOperator = ConvolutionalOperator;
+  static int const kConvDim = ConvDim;
+
+  using ElementA = ElementA_;
+  using LayoutA = LayoutA_;
+  using ElementB = ElementB_;
+  using LayoutB = LayoutB_;
+  using ElementC = ElementC_;
+  using LayoutC = LayoutC_;
+  using ElementCompute = ElementCompute_;
+  using ElementAccumulator = ElementAccumulator_;
+  using ConvertOp = ConvertOp_;
+
+  using Configuration = typename platform::conditional<
+    kConvDim == 2, Conv2dConfiguration, Conv3dConfiguration>::type;
+
+protected:
+
+  /// Storage for the name string
+  std::string name_;
+
+  ///
+  ConvDescription description_;
+
+public:
+
+  /// Constructor
+  ConvHostOperation() {
+
+    // Basic information
+    description_.provider = Provider::kHost;
+    description_.kind = (kConvDim == 2 ? OperationKind::kConv2d : OperationKind::kConv3d);
+    description_.conv_kind = ConvKindMap<kConvolutionalOperator>::kId;
+    description_.conv_dim = kConvDim;
+
+    // Tensor description
+    description_.A = make_TensorDescription<ElementA, LayoutA>();
+    description_.B = make_TensorDescription<ElementB, LayoutB>();
+    description_.C = make_TensorDescription<ElementC, LayoutC>();
+
+    // Epilogue compute and accumulator type description
+    description_.element_epilogue = NumericTypeMap<ElementCompute>::kId;
+
+    description_.tile_description.math_instruction.element_accumulator =
+      NumericTypeMap<ElementAccumulator>::kId;
+
+    // Operands are gathered by the host reference rather than by an iterator
+    description_.iterator_algorithm = IteratorAlgorithmID::kNone;
+
+    // Host operations run regardless of the device
+    description_.tile_description.minimum_compute_capability = 0;
+    description_.tile_description.maximum_compute_capability = 1024;
+
+    // Procedural name
+    std::stringstream ss;
+
+    ss << "conv" << kConvDim << "d_" << to_string(description_.conv_kind)
+      << "_" << to_string(description_.provider)
+      << "_" << to_string(description_.A.element) << to_string(description_.A.layout)
+      << "_" << to_string(description_.B.element) << to_string(description_.B.layout)
+      << "_" << to_string(description_.C.element) << to_string(description_.C.layout)
+      << "_" << to_string(description_.tile_description.math_instruction.element_accumulator);
+
+    name_ = ss.str();
+
+    description_.name = name_.c_str();
+  }
+
+  /// Returns the description of the convolution operation
+  virtual OperationDescription const & description() const {
+    return description_;
+  }
+
+  virtual Status can_implement(
+    void const *configuration,
+    void const *arguments) const {
+
+    Configuration const &config = *static_cast<Configuration const *>(configuration);
+
+    // The parallel split-K reduction runs on the device
+    if (config.split_k_mode == conv::SplitKMode::kParallel) {
+      return Status::kErrorNotSupported;
+    }
+
+    // Only the forward reference partitions channels into groups
+    if (config.problem_size.groups != 1 && kConvolutionalOperator != conv::Operator::kFprop) {
+      return Status::kErrorNotSupported;
+    }
+
+    if constexpr (kConvDim == 2) {
+      if (config.stride_a.size() < 3 || config.stride_b.size() < 3 || config.stride_c.size() < 3) {
+        return Status::kErrorInvalidProblem;
+      }
+    }
+
+    return Status::kSuccess;
+  }
+
+  virtual uint64_t get_host_workspace_size(
+    void const *configuration) const {
+
+    return sizeof(Configuration);
+  }
+
+  virtual uint64_t get_device_workspace_size(
+    void const *configuration,
+    void const *arguments = nullptr) const {
+
+    return 0;
+  }
+
+  virtual Status initialize(
+    void const *configuration,
+    void *host_workspace,
+    void *device_workspace = nullptr,
+    cudaStream_t stream = nullptr) const {
+
+    std::memcpy(host_workspace, configuration, get_host_workspace_size(configuration));
+
+    return Status::kSuccess;
+  }
+
+  virtual Status run(
+    void const *arguments,
+    void *host_workspace,
+    void *device_workspace = nullptr,
+    cudaStream_t stream = nullptr) const {
+
+    Configuration const &config = *static_cast<Configuration const *>(host_workspace);
+    ConvArguments const &args = *static_cast<ConvArguments const *>(arguments);
+
+    ElementA *ptr_A = static_cast<ElementA *>(const_cast<void *>(args.A));
+    ElementB *ptr_B = static_cast<ElementB *>(const_cast<void *>(args.B));
+    ElementC *ptr_C = static_cast<ElementC *>(const_cast<void *>(args.C));
+    ElementC *ptr_D = static_cast<ElementC *>(args.D);
+
+    ElementCompute alpha = *static_cast<ElementCompute const *>(args.alpha);
+    ElementCompute beta = *static_cast<ElementCompute const *>(args.beta);
+
+    if constexpr (kConvDim == 2) {
+
+      // Strides of the NHWC tensors as set by the caller
+      LayoutA layout_a;
+      LayoutB layout_b;
+      LayoutC layout_c;
+
+      layout_a.stride() =
+        make_Coord(int32_t(config.stride_a[0]), int32_t(config.stride_a[1]), int32_t(config.stride_a[2]));
+      layout_b.stride() =
+        make_Coord(int32_t(config.stride_b[0]), int32_t(config.stride_b[1]), int32_t(config.stride_b[2]));
+      layout_c.stride() =
+        make_Coord(int32_t(config.stride_c[0]), int32_t(config.stride_c[1]), int32_t(config.stride_c[2]));
+
+      cutlass::reference::host::Conv2d<
+        ElementA, LayoutA,
+        ElementB, LayoutB,
+        ElementC, LayoutC,
+        ElementCompute,
+        ElementAccumulator,
+        ElementC,
+        ConvertOp
+      >(
+        kConvolutionalOperator,
+        config.problem_size,
+        {ptr_A, layout_a},
+        {ptr_B, layout_b},
+        {ptr_C, layout_c},
+        {ptr_D, layout_c},
+        alpha,
+        beta);
+    }
+    else {
+
+      ConvKind const conv_kind = ConvKindMap<kConvolutionalOperator>::kId;
+
+      cutlass::reference::host::Conv3d<
+        ElementA, LayoutA,
+        ElementB, LayoutB,
+        ElementC, LayoutC,
+        ElementCompute,
+        ElementAccumulator,
+        ConvertOp
+      >(
+        kConvolutionalOperator,
+        config.problem_size,
+        {ptr_A, config.layout_a(conv_kind)},
+        {ptr_B, config.layout_b(conv_kind)},
+        {ptr_C, config.layout_c(conv_kind)},
+        {ptr_D, config.layout_c(conv_kind)},
+        alpha,
+        beta);
+    }
+
+    return Status::kSuccess;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Helper to create host Fprop operations
+template <
+  int kConvDim,
+  typename ElementA_,
+  typename LayoutA_,
+  typename ElementB_,
+  typename LayoutB_,
+  typename ElementC_,
+  typename LayoutC_,
+  typename ElementCompute_,
+  typename ElementAccumulator_ = ElementCompute_,
+  typename ConvertOp_ = NumericConverter<ElementC_, ElementCompute_>
+>
+void make_conv_host_fprop(Manifest &manifest) {
+
+  manifest.append(new ConvHostOperation<cutlass::conv::Operator::kFprop, kConvDim,
+    ElementA_, LayoutA_, ElementB_, LayoutB_, ElementC_, LayoutC_,
+    ElementCompute_, ElementAccumulator_, ConvertOp_>);
+}
+
+/// Helper to create host Fprop, Dgrad and Wgrad operations
+template <
+  int kConvDim,
+  typename ElementA_,
+  typename LayoutA_,
+  typename ElementB_,
+  typename LayoutB_,
+  typename ElementC_,
+  typename LayoutC_,
+  typename ElementCompute_,
+  typename ElementAccumulator_ = ElementCompute_,
+  typename ConvertOp_ = NumericConverter<ElementC_, ElementCompute_>
+>
+void make_conv_host_all(Manifest &manifest) {
+
+  make_conv_host_fprop<kConvDim,
+    ElementA_, LayoutA_, ElementB_, LayoutB_, ElementC_, LayoutC_,
+    ElementCompute_, ElementAccumulator_, ConvertOp_>(manifest);
+
+  manifest.append(new ConvHostOperation<cutlass::conv::Operator::kDgrad, kConvDim,
+    ElementA_, LayoutA_, ElementB_, LayoutB_, ElementC_, LayoutC_,
+    ElementCompute_, ElementAccumulator_, ConvertOp_>);
+
+  manifest.append(new ConvHostOperation<cutlass::conv::Operator::kWgrad, kConvDim,
+    ElementA_, LayoutA_, ElementB_, LayoutB_, ElementC_, LayoutC_,
+    ElementCompute_, ElementAccumulator_, ConvertOp_>);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,300 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+  \brief Defines GEMM operations executed on the host in CUTLASS Library
+
+  These operations are backed by the blocked host GETT reference. They let the profiler enumerate,
+  run, verify and report GEMMs on machines without a CUDA device.
+*/
+
+#pragma once
+
+#include <sstream>
+#include <cstring>
+
+#include "cutlass/cutlass.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/util.h"
+#include "library_internal.h"
+
+#include "cute/tensor.hpp"
+#include "cutlass/util/reference/host/gett.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Stride of an (M, K, L) operand stored in a column-major or row-major matrix
+template <typename Layout>
+auto make_host_gemm_stride(int64_t ld, int64_t batch_stride) {
+  if constexpr (platform::is_same<Layout, layout::ColumnMajor>::value) {
+    return cute::make_stride(cute::Int<1>{}, ld, batch_stride);
+  }
+  else {
+    return cute::make_stride(ld, cute::Int<1>{}, batch_stride);
+  }
+}
+
+/// B is stored K-by-N but addressed as (N, K, L), so its strides are those of the transposed layout
+template <typename Layout>
+auto make_host_gemm_stride_B(int64_t ld, int64_t batch_stride) {
+  if constexpr (platform::is_same<Layout, layout::ColumnMajor>::value) {
+    return cute::make_stride(ld, cute::Int<1>{}, batch_stride);
+  }
+  else {
+    return cute::make_stride(cute::Int<1>{}, ld, batch_stride);
+  }
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// GEMM executed on the host. Operands, workspace and results reside in host memory.
+template <
+  typename ElementA_,
+  typename LayoutA_,
+  typename ElementB_,
+  typename LayoutB_,
+  typename ElementC_,
+  typename LayoutC_,
+  typename ElementCompute_,
+  typename ElementAccumulator_ = ElementCompute_,
+  typename ElementD_ = ElementC_
+>
+class GemmHostOperation : public Operation {
+public:
+
+  using ElementA = ElementA_;
+  using LayoutA = LayoutA_;
+  using ElementB = ElementB_;
+  using LayoutB = LayoutB_;
+  using ElementC = ElementC_;
+  using LayoutC = LayoutC_;
+  using ElementD = ElementD_;
+  using ElementCompute = ElementCompute_;
+  using ElementAccumulator = ElementAccumulator_;
+
+protected:
+
+  /// Storage for the name string
+  std::string name_;
+
+  ///
+  GemmDescription description_;
+
+public:
+
+  /// Constructor
+  GemmHostOperation() {
+
+    // Basic information
+    description_.provider = Provider::kHost;
+    description_.kind = OperationKind::kGemm;
+    description_.gemm_kind = GemmKind::kUniversal;
+
+    // Tensor description
+    description_.A = make_TensorDescription<ElementA, LayoutA>();
+    description_.transform_A = ComplexTransform::kNone;
+    description_.B = make_TensorDescription<ElementB, LayoutB>();
+    description_.transform_B = ComplexTransform::kNone;
+    description_.C = make_TensorDescription<ElementC, LayoutC>();
+    description_.D = make_TensorDescription<ElementD, LayoutC>();
+
+    // Epilogue compute and accumulator type description
+    description_.element_epilogue = NumericTypeMap<ElementCompute>::kId;
+
+    description_.tile_description.math_instruction.element_accumulator =
+      NumericTypeMap<ElementAccumulator>::kId;
+
+    // Host operations run regardless of the device
+    description_.tile_description.minimum_compute_capability = 0;
+    description_.tile_description.maximum_compute_capability = 1024;
+
+    // Procedural name
+    std::stringstream ss;
+
+    ss << "gemm_" << to_string(description_.provider)
+      << "_" << to_string(description_.A.element) << to_string(description_.A.layout)
+      << "_" << to_string(description_.B.element) << to_string(description_.B.layout)
+      << "_" << to_string(description_.C.element) << to_string(description_.C.layout)
+      << "_" << to_string(description_.tile_description.math_instruction.element_accumulator);
+
+    name_ = ss.str();
+
+    description_.name = name_.c_str();
+  }
+
+  /// Returns the description of the GEMM operation
+  virtual OperationDescription const & description() const {
+    return description_;
+  }
+
+  virtual Status can_implement(
+    void const *configuration,
+    void const *arguments) const {
+
+    GemmUniversalConfiguration const &config = *static_cast<GemmUniversalConfiguration const *>(configuration);
+
+    if (config.mode != GemmUniversalMode::kGemm && config.mode != GemmUniversalMode::kBatched) {
+      return Status::kErrorNotSupported;
+    }
+
+    return Status::kSuccess;
+  }
+
+  virtual uint64_t get_host_workspace_size(
+    void const *configuration) const {
+
+    return sizeof(GemmUniversalConfiguration);
+  }
+
+  virtual uint64_t get_device_workspace_size(
+    void const *configuration,
+    void const *arguments = nullptr) const {
+
+    return 0;
+  }
+
+  virtual Status initialize(
+    void const *configuration,
+    void *host_workspace,
+    void *device_workspace = nullptr,
+    cudaStream_t stream = nullptr) const {
+
+    std::memcpy(host_workspace, configuration, get_host_workspace_size(configuration));
+
+    return Status::kSuccess;
+  }
+
+  virtual Status run(
+    void const *arguments,
+    void *host_workspace,
+    void *device_workspace = nullptr,
+    cudaStream_t stream = nullptr) const {
+
+    GemmUniversalConfiguration const &config = *static_cast<GemmUniversalConfiguration const *>(host_workspace);
+    GemmUniversalArguments const &args = *static_cast<GemmUniversalArguments const *>(arguments);
+
+    if (config.mode != GemmUniversalMode::kGemm && config.mode != GemmUniversalMode::kBatched) {
+      return Status::kErrorNotSupported;
+    }
+
+    int m = config.problem_size.m();
+    int n = config.problem_size.n();
+    int k = config.problem_size.k();
+    int l = (config.mode == GemmUniversalMode::kBatched ? config.batch_count : 1);
+
+    auto A = cute::make_tensor(
+      static_cast<ElementA const *>(args.A),
+      cute::make_layout(cute::make_shape(m, k, l), detail::make_host_gemm_stride<LayoutA>(config.lda, args.batch_stride_A)));
+
+    auto B = cute::make_tensor(
+      static_cast<ElementB const *>(args.B),
+      cute::make_layout(cute::make_shape(n, k, l), detail::make_host_gemm_stride_B<LayoutB>(config.ldb, args.batch_stride_B)));
+
+    auto C = cute::make_tensor(
+      static_cast<ElementC const *>(args.C),
+      cute::make_layout(cute::make_shape(m, n, l), detail::make_host_gemm_stride<LayoutC>(config.ldc, args.batch_stride_C)));
+
+    auto D = cute::make_tensor(
+      static_cast<ElementD *>(args.D),
+      cute::make_layout(cute::make_shape(m, n, l), detail::make_host_gemm_stride<LayoutC>(config.ldd, args.batch_stride_D)));
+
+    cutlass::reference::host::GettMainloopParams<ElementAccumulator, decltype(A), decltype(B)> mainloop_params{};
+    mainloop_params.A = A;
+    mainloop_params.B = B;
+
+    cutlass::reference::host::GettEpilogueParams<
+      ElementCompute, ElementCompute, ElementAccumulator, ElementCompute, decltype(C), decltype(D)
+    > epilogue_params{};
+
+    epilogue_params.C = C;
+    epilogue_params.D = D;
+    epilogue_params.alpha = *static_cast<ElementCompute const *>(args.alpha);
+    epilogue_params.beta = *static_cast<ElementCompute const *>(args.beta);
+
+    cutlass::reference::host::Gett(mainloop_params, epilogue_params);
+
+    return Status::kSuccess;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Helper to create host GEMMs for each combination of column-major and row-major operands
+template <
+  typename ElementA_,
+  typename ElementB_,
+  typename ElementC_,
+  typename ElementCompute_,
+  typename ElementAccumulator_ = ElementCompute_,
+  typename ElementD_ = ElementC_
+>
+void make_gemm_host_canonical_layouts(Manifest &manifest) {
+
+  using ColumnMajor = cutlass::layout::ColumnMajor;
+  using RowMajor = cutlass::layout::RowMajor;
+
+  // M Major outputs
+  manifest.append(new GemmHostOperation<ElementA_, ColumnMajor, ElementB_, ColumnMajor, ElementC_, ColumnMajor,
+    ElementCompute_, ElementAccumulator_, ElementD_>);
+  manifest.append(new GemmHostOperation<ElementA_, ColumnMajor, ElementB_, RowMajor, ElementC_, ColumnMajor,
+    ElementCompute_, ElementAccumulator_, ElementD_>);
+  manifest.append(new GemmHostOperation<ElementA_, RowMajor, ElementB_, ColumnMajor, ElementC_, ColumnMajor,
+    ElementCompute_, ElementAccumulator_, ElementD_>);
+  manifest.append(new GemmHostOperation<ElementA_, RowMajor, ElementB_, RowMajor, ElementC_, ColumnMajor,
+    ElementCompute_, ElementAccumulator_, ElementD_>);
+
+  // N Major outputs
+  manifest.append(new GemmHostOperation<ElementA_, ColumnMajor, ElementB_, ColumnMajor, ElementC_, RowMajor,
+    ElementCompute_, ElementAccumulator_, ElementD_>);
+  manifest.append(new GemmHostOperation<ElementA_, ColumnMajor, ElementB_, RowMajor, ElementC_, RowMajor,
+    ElementCompute_, ElementAccumulator_, ElementD_>);
+  manifest.append(new GemmHostOperation<ElementA_, RowMajor, ElementB_, ColumnMajor, ElementC_, RowMajor,
+    ElementCompute_, ElementAccumulator_, ElementD_>);
+  manifest.append(new GemmHostOperation<ElementA_, RowMajor, ElementB_, RowMajor, ElementC_, RowMajor,
+    ElementCompute_, ElementAccumulator_, ElementD_>);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,141 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Instantiates operations executed on the host.
+*/
+
+#include "cutlass/cutlass.h"
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+
+#include "gemm_host_operation.h"
+#include "conv_host_operation.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Host Conv2d or Conv3d operations for the element types of the host GEMMs that have a
+/// convolution reference to verify against
+template <int kConvDim, typename Layout>
+void initialize_conv_host_operations(Manifest &manifest) {
+  make_conv_host_all<
+    kConvDim,
+    float, Layout,                        // ElementA, LayoutA
+    float, Layout,                        // ElementB, LayoutB
+    float, Layout,                        // ElementC, LayoutC
+    float,                                // ElementScalar
+    float                                 // ElementAccumulator
+  >(manifest);
+
+  make_conv_host_all<
+    kConvDim,
+    half_t, Layout,
+    half_t, Layout,
+    half_t, Layout,
+    float,
+    float
+  >(manifest);
+
+  make_conv_host_all<
+    kConvDim,
+    bfloat16_t, Layout,
+    bfloat16_t, Layout,
+    bfloat16_t, Layout,
+    float,
+    float
+  >(manifest);
+
+  make_conv_host_fprop<
+    kConvDim,
+    int8_t, Layout,
+    int8_t, Layout,
+    int32_t, Layout,
+    int32_t,
+    int32_t,
+    NumericConverterClamp<int32_t, int32_t>
+  >(manifest);
+}
+
+void initialize_host_operations(Manifest &manifest) {
+  make_gemm_host_canonical_layouts<
+    float,                                // ElementA
+    float,                                // ElementB
+    float,                                // ElementC
+    float,                                // ElementScalar
+    float                                 // ElementAccumulator
+  >(manifest);
+
+  make_gemm_host_canonical_layouts<
+    double,
+    double,
+    double,
+    double,
+    double
+  >(manifest);
+
+  make_gemm_host_canonical_layouts<
+    half_t,
+    half_t,
+    half_t,
+    float,
+    float
+  >(manifest);
+
+  make_gemm_host_canonical_layouts<
+    bfloat16_t,
+    bfloat16_t,
+    bfloat16_t,
+    float,
+    float
+  >(manifest);
+
+  make_gemm_host_canonical_layouts<
+    int8_t,
+    int8_t,
+    int32_t,
+    int32_t,
+    int32_t
+  >(manifest);
+
+  initialize_conv_host_operations<2, cutlass::layout::TensorNHWC>(manifest);
+  initialize_conv_host_operations<3, cutlass::layout::TensorNDHWC>(manifest);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
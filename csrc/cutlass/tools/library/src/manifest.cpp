@@ -35,8 +35,11 @@
     This is the root of the data structure containing CUTLASS objects
 */
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include "cutlass/library/manifest.h"
+#include "cutlass/library/util.h"
 
 namespace cutlass {
 namespace library {
@@ -44,28 +47,211 @@ namespace library {
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void initialize_reference_operations(Manifest &manifest);
+void initialize_host_operations(Manifest &manifest);
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Returns true if the operations of a generated configuration are constructed
+bool ManifestFilter::accepts(ConfigurationRegistration const &registration) const {
+
+  if (!kind_enabled(registration.kind)) {
+    return false;
+  }
+
+  if (compute_capability > 0 && registration.minimum_compute_capability > compute_capability) {
+    return false;
+  }
+
+  if (names.empty() && excluded_names.empty()) {
+    return true;
+  }
+
+  std::string operation_name;
+  std::istringstream operation_names(registration.operation_names ? registration.operation_names : "");
+
+  while (std::getline(operation_names, operation_name, ',')) {
+
+    bool enabled = names.empty();
+
+    for (auto const &pattern : names) {
+      if (matches_operation_name(pattern, operation_name)) {
+        enabled = true;
+        break;
+      }
+    }
+
+    for (auto const &pattern : excluded_names) {
+      if (matches_operation_name(pattern, operation_name)) {
+        enabled = false;
+        break;
+      }
+    }
+
+    if (enabled) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/// Functional key under which configurations are registered
+std::string configuration_key(
+  NumericTypeID element_A,
+  NumericTypeID element_B,
+  NumericTypeID element_C) {
+
+  std::string key = to_string(element_A);
+  key += ',';
+  key += to_string(element_B);
+  key += ',';
+  key += to_string(element_C);
+  return key;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Replaces the filter and initializes the manifest
+Status Manifest::initialize(ManifestFilter const &filter) {
+  filter_ = filter;
+  return initialize();
+}
+
 /// Top-level initialization
 Status Manifest::initialize() {
 
-  if (!operations_.empty()) {
-    operations_.clear();
-  }
+  release();
 
-  // initialize procedurally generated cutlass op in manifest object
+  // register procedurally generated cutlass op in manifest object
   initialize_all(*this);
 
   // initialize manually instanced reference op in manifest object
   initialize_reference_operations(*this);
 
+  // initialize operations executed on the host in manifest object
+  initialize_host_operations(*this);
+
   // initialize manually instanced reduction reference op in manifest object
-  initialize_all_reduction_op(*this);
+  if (filter_.kind_enabled(OperationKind::kReduction)) {
+    initialize_all_reduction_op(*this);
+  }
 
   return Status::kSuccess;
 }
 
+/// Indexes the registrations passing the filter
+void Manifest::index_registrations_() {
+
+  resolved_.resize(registrations_.size(), false);
+
+  for (; indexed_count_ < registrations_.size(); ++indexed_count_) {
+
+    ConfigurationRegistration const &registration = registrations_[indexed_count_];
+
+    if (!filter_.accepts(registration)) {
+      resolved_[indexed_count_] = true;
+      continue;
+    }
+
+    std::string functional_key;
+    std::istringstream functional_keys(registration.functional_keys ? registration.functional_keys : "");
+
+    bool keyed = false;
+    while (std::getline(functional_keys, functional_key, ';')) {
+      registration_index_[{registration.kind, functional_key}].push_back(indexed_count_);
+      keyed = true;
+    }
+
+    if (!keyed) {
+      registration_index_[{registration.kind, std::string()}].push_back(indexed_count_);
+    }
+  }
+}
+
+/// Constructs the operations of a registration unless already constructed
+void Manifest::construct_(size_t registration) {
+  if (!resolved_[registration]) {
+    resolved_[registration] = true;
+    registrations_[registration].initializer(*this);
+  }
+}
+
+/// Constructs the operations of registered configurations passing the filter
+void Manifest::materialize_() const {
+
+  if (!pending_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Operations are constructed on first access through a const reference to a manifest that is
+  // itself never const
+  Manifest &manifest = const_cast<Manifest &>(*this);
+
+  manifest.index_registrations_();
+
+  for (auto const &entry : manifest.registration_index_) {
+    for (size_t registration : entry.second) {
+      manifest.construct_(registration);
+    }
+  }
+
+  manifest.registration_index_.clear();
+
+  pending_.store(false, std::memory_order_release);
+}
+
+/// Constructs the operations of the registered configurations of a kind and functional key
+std::vector<Operation const *> Manifest::materialize(
+  OperationKind kind,
+  std::string const &functional_key,
+  size_t first) const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Manifest &manifest = const_cast<Manifest &>(*this);
+
+  if (pending_.load(std::memory_order_acquire)) {
+
+    manifest.index_registrations_();
+
+    // Configurations registered without a functional key are constructed by any lookup of their
+    // kind
+    for (std::string const &key : {functional_key, std::string()}) {
+
+      auto it = manifest.registration_index_.find({kind, key});
+
+      if (it != manifest.registration_index_.end()) {
+        for (size_t registration : it->second) {
+          manifest.construct_(registration);
+        }
+        manifest.registration_index_.erase(it);
+      }
+    }
+  }
+
+  std::vector<Operation const *> operations;
+
+  for (size_t idx = first; idx < operations_.size(); ++idx) {
+    operations.push_back(operations_[idx].get());
+  }
+
+  return operations;
+}
+
+/// Number of registered configurations passing the filter whose operations have not been
+/// constructed yet
+size_t Manifest::pending_configuration_count() const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Manifest &manifest = const_cast<Manifest &>(*this);
+  manifest.index_registrations_();
+
+  return std::count(resolved_.begin(), resolved_.end(), false);
+}
+
 /// Used for initialization
 void Manifest::reserve(size_t operation_count) {
   operations_.reserve(operation_count);
@@ -73,22 +259,31 @@ void Manifest::reserve(size_t operation_count) {
 
 /// Graceful shutdown
 Status Manifest::release() {
+  std::lock_guard<std::mutex> lock(mutex_);
   operations_.clear();
+  registrations_.clear();
+  indexed_count_ = 0;
+  registration_index_.clear();
+  resolved_.clear();
+  pending_.store(false, std::memory_order_release);
   return Status::kSuccess;
 }
 
-/// Returns an iterator to the first operation
+/// Returns the operations, constructing those of registered configurations first
 OperationVector const & Manifest::operations() const {
+  materialize_();
   return operations_;
 }
 
 /// Returns a const iterator
 OperationVector::const_iterator Manifest::begin() const {
+  materialize_();
   return operations_.begin();
 }
 
 /// Returns a const iterator
 OperationVector::const_iterator Manifest::end() const {
+  materialize_();
   return operations_.end();
 }
 
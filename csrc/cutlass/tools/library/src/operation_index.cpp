@@ -0,0 +1,299 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+/*! \file
+    \brief Immutable index of the operations in the manifest used to select GEMM operations
+*/
+
+#include <algorithm>
+
+#include "cutlass/library/operation_index.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OperationIndex::insert_(std::vector<Operation const *> const &operations) {
+
+  std::vector<GemmOperationIndexVector *> extended;
+
+  for (Operation const *operation : operations) {
+
+    OperationDescription const &desc = operation->description();
+
+    if (desc.kind != OperationKind::kGemm) {
+      continue;
+    }
+
+    GemmDescription const &gemm_desc = static_cast<GemmDescription const &>(desc);
+
+    GemmFunctionalKey functional_key(
+      gemm_desc.provider,
+      gemm_desc.gemm_kind,
+      gemm_desc.tile_description.math_instruction.element_accumulator,
+      gemm_desc.element_epilogue,
+      gemm_desc.A.element,
+      gemm_desc.A.layout,
+      gemm_desc.transform_A,
+      gemm_desc.B.element,
+      gemm_desc.B.layout,
+      gemm_desc.transform_B,
+      gemm_desc.C.element,
+      gemm_desc.C.layout,
+      gemm_desc.D.element,
+      gemm_desc.D.layout
+    );
+
+    int alignment = std::max(std::max(
+      gemm_desc.A.alignment, gemm_desc.B.alignment), gemm_desc.C.alignment);
+
+    GemmOperationIndexVector &entries = gemm_operations_[functional_key];
+
+    if (std::find(extended.begin(), extended.end(), &entries) == extended.end()) {
+      extended.push_back(&entries);
+    }
+
+    entries.emplace_back(
+      operation,
+      gemm_desc.tile_description.minimum_compute_capability,
+      gemm_desc.tile_description.maximum_compute_capability,
+      alignment);
+  }
+
+  // Order by preference, as GemmPreferenceKey orders the operation table. Entries already indexed
+  // precede the new ones in manifest order, which the stable sort keeps among equals.
+  for (GemmOperationIndexVector *entries : extended) {
+    std::stable_sort(entries->begin(), entries->end(),
+      [](GemmOperationIndexEntry const &lhs, GemmOperationIndexEntry const &rhs) {
+        return GemmPreferenceKey(rhs.minimum_compute_capability, rhs.alignment) <
+          GemmPreferenceKey(lhs.minimum_compute_capability, lhs.alignment);
+      });
+
+    entries->shrink_to_fit();
+  }
+}
+
+void OperationIndex::build(OperationVector const &operations) {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  gemm_operations_.clear();
+  manifest_ = nullptr;
+
+  std::vector<Operation const *> indexed;
+  for (auto const &operation : operations) {
+    indexed.push_back(operation.get());
+  }
+
+  insert_(indexed);
+}
+
+void OperationIndex::attach(Manifest const &manifest) {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  gemm_operations_.clear();
+  manifest_ = &manifest;
+  indexed_count_ = 0;
+}
+
+void OperationIndex::clear() {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  gemm_operations_.clear();
+  manifest_ = nullptr;
+}
+
+GemmOperationIndexVector const *OperationIndex::find_gemm_operations(GemmFunctionalKey const &key) const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (manifest_) {
+
+    // The index is filled on lookup through a const reference to an index that is itself never
+    // const, as the manifest constructs its operations
+    OperationIndex &index = const_cast<OperationIndex &>(*this);
+
+    std::vector<Operation const *> operations = manifest_->materialize(
+      OperationKind::kGemm,
+      configuration_key(key.element_A, key.element_B, key.element_C),
+      indexed_count_);
+
+    index.indexed_count_ += operations.size();
+    index.insert_(operations);
+  }
+
+  auto it = gemm_operations_.find(key);
+
+  if (it == gemm_operations_.end() || it->second.empty()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+Operation const *OperationIndex::find_gemm_operation(
+  GemmFunctionalKey const &key,
+  int compute_capability,
+  int alignment,
+  GemmSelectionProblem const &problem,
+  GemmOperationSelector const &selector) const {
+
+  GemmOperationIndexVector const *entries = find_gemm_operations(key);
+
+  if (!entries) {
+    return nullptr;
+  }
+
+  std::vector<Operation const *> candidates;
+
+  // Candidates are the eligible operations of the most preferred (compute capability, alignment)
+  // group holding any
+  GemmPreferenceKey preference_key(compute_capability, alignment);
+  GemmPreferenceKey group;
+
+  for (auto const &entry : *entries) {
+
+    GemmPreferenceKey entry_key(entry.minimum_compute_capability, entry.alignment);
+
+    // Skip groups preferred over the problem's own compute capability and alignment
+    if (preference_key < entry_key) {
+      continue;
+    }
+
+    if (!candidates.empty() &&
+      (entry_key.compute_capability != group.compute_capability || entry_key.alignment != group.alignment)) {
+      break;
+    }
+
+    if (entry.minimum_compute_capability <= compute_capability &&
+      compute_capability <= entry.maximum_compute_capability &&
+      entry.alignment <= alignment) {
+
+      group = entry_key;
+      candidates.push_back(entry.operation);
+    }
+  }
+
+  if (candidates.empty()) {
+    return nullptr;
+  }
+
+  std::vector<GemmSelectionCandidate> ranked = selector.rank(problem, candidates);
+
+  return ranked.empty() ? nullptr : ranked.front().operation;
+}
+
+Operation const *OperationIndex::find_gemm_operation(
+  GemmFunctionalKey const &key,
+  int minimum_compute_capability,
+  int alignment,
+  TileDescription const &tile_description) const {
+
+  GemmOperationIndexVector const *entries = find_gemm_operations(key);
+
+  if (!entries) {
+    return nullptr;
+  }
+
+  for (auto const &entry : *entries) {
+    if (entry.minimum_compute_capability == minimum_compute_capability &&
+      entry.alignment == alignment &&
+      entry.operation->description().tile_description == tile_description) {
+
+      return entry.operation;
+    }
+  }
+
+  return nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t GemmOperationCache::Key::hash() const {
+
+  size_t hash = GemmFunctionalKeyHasher()(functional_key);
+
+  int64_t const fields[] = {
+    compute_capability, alignment, m, n, k, batch_count, split_k_slices
+  };
+
+  for (int64_t field : fields) {
+    hash = (hash ^ static_cast<size_t>(field)) * 1099511628211ull;
+  }
+
+  return hash ^ (hash >> 29);
+}
+
+GemmOperationCache::GemmOperationCache(): hits_(0), misses_(0) { }
+
+bool GemmOperationCache::find(Key const &key, Operation const *&operation) const {
+
+  Slot const &slot = slots_[key.hash() % kCapacity];
+
+  if (slot.valid && slot.key == key) {
+    operation = slot.operation;
+    ++hits_;
+    return true;
+  }
+
+  ++misses_;
+  return false;
+}
+
+void GemmOperationCache::insert(Key const &key, Operation const *operation) {
+
+  Slot &slot = slots_[key.hash() % kCapacity];
+
+  slot.valid = true;
+  slot.key = key;
+  slot.operation = operation;
+}
+
+void GemmOperationCache::clear() {
+  for (auto &slot : slots_) {
+    slot.valid = false;
+  }
+  hits_ = 0;
+  misses_ = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
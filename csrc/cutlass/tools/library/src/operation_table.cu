@@ -43,96 +43,156 @@ namespace library {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+void OperationTable::insert_(Operation const *operation) {
+
+  OperationDescription const &desc = operation->description();
+  // insert all gemm operation into operation table
+  if (desc.kind == OperationKind::kGemm) {
+    GemmDescription const &gemm_desc = static_cast<GemmDescription const &>(desc);
+  
+
+    GemmFunctionalKey functional_key(
+      gemm_desc.provider,
+      gemm_desc.gemm_kind,
+      gemm_desc.tile_description.math_instruction.element_accumulator,
+      gemm_desc.element_epilogue,
+      gemm_desc.A.element,
+      gemm_desc.A.layout,
+      gemm_desc.transform_A,
+      gemm_desc.B.element,
+      gemm_desc.B.layout,
+      gemm_desc.transform_B,
+      gemm_desc.C.element,
+      gemm_desc.C.layout,
+      gemm_desc.D.element,
+      gemm_desc.D.layout
+    );
+
+    int cc = gemm_desc.tile_description.minimum_compute_capability;
+      
+    int alignment = std::max(std::max(
+      gemm_desc.A.alignment, gemm_desc.B.alignment), gemm_desc.C.alignment);
+
+    GemmPreferenceKey preference_key(cc, alignment);
+
+    gemm_operations[functional_key][preference_key].push_back(operation);
+  }
+
+  // insert all conv2d or conv3d operation into operation table
+  if (desc.kind == OperationKind::kConv2d || desc.kind == OperationKind::kConv3d) {
+    auto &conv_desc = static_cast<library::ConvDescription const &>(desc);
+
+    ConvFunctionalKey functional_key(
+      conv_desc.provider,
+      conv_desc.conv_kind,
+      conv_desc.A.element,
+      conv_desc.A.layout,
+      conv_desc.B.element,
+      conv_desc.B.layout,
+      conv_desc.C.element,
+      conv_desc.C.layout,
+      conv_desc.tile_description.math_instruction.element_accumulator, 
+      conv_desc.element_epilogue
+    );
+
+    int cc = conv_desc.tile_description.minimum_compute_capability;
+
+    ConvPreferenceKey preference_key(cc, conv_desc.iterator_algorithm);
+
+    // insert conv operation to conv2d_operations or conv3d_operations map
+    (desc.kind == OperationKind::kConv2d) ?
+      conv2d_operations[functional_key][preference_key].push_back(operation) : 
+      conv3d_operations[functional_key][preference_key].push_back(operation);
+  }
+
+  // insert all reduction operation into operation table
+  if (desc.kind == OperationKind::kReduction) {
+    auto &reduce_desc = static_cast<library::ReductionDescription const &>(desc);
+
+    ReductionFunctionalKey functional_key(
+      reduce_desc.provider,
+      reduce_desc.element_workspace,
+      reduce_desc.tile_description.math_instruction.element_accumulator,
+      reduce_desc.element_output,
+      reduce_desc.element_epilogue,
+      library::MathOperationID::kAdd,
+      library::EpilogueKind::kLinearCombination
+    );
+
+    reduction_operations[functional_key] = operation;
+
+  }
+}
+
 void OperationTable::append(Manifest const &manifest) {
 
   // Insert operations into appropriate data structure
   for (auto const & operation : manifest) {
-    OperationDescription const &desc = operation->description();
-    // insert all gemm operation into operation table
-    if (desc.kind == OperationKind::kGemm) {
-      GemmDescription const &gemm_desc = static_cast<GemmDescription const &>(desc);
-    
-
-      GemmFunctionalKey functional_key(
-        gemm_desc.provider,
-        gemm_desc.gemm_kind,
-        gemm_desc.tile_description.math_instruction.element_accumulator,
-        gemm_desc.element_epilogue,
-        gemm_desc.A.element,
-        gemm_desc.A.layout,
-        gemm_desc.transform_A,
-        gemm_desc.B.element,
-        gemm_desc.B.layout,
-        gemm_desc.transform_B,
-        gemm_desc.C.element,
-        gemm_desc.C.layout,
-        gemm_desc.D.element,
-        gemm_desc.D.layout
-      );
-
-      Operation const *op = operation.get();
-
-      int cc = gemm_desc.tile_description.minimum_compute_capability;
-        
-      int alignment = std::max(std::max(
-        gemm_desc.A.alignment, gemm_desc.B.alignment), gemm_desc.C.alignment);
-
-      GemmPreferenceKey preference_key(cc, alignment);
-
-      gemm_operations[functional_key][preference_key].push_back(op);
-    }
-
-    // insert all conv2d or conv3d operation into operation table
-    if (desc.kind == OperationKind::kConv2d || desc.kind == OperationKind::kConv3d) {
-      auto &conv_desc = static_cast<library::ConvDescription const &>(desc);
-
-      ConvFunctionalKey functional_key(
-        conv_desc.provider,
-        conv_desc.conv_kind,
-        conv_desc.A.element,
-        conv_desc.A.layout,
-        conv_desc.B.element,
-        conv_desc.B.layout,
-        conv_desc.C.element,
-        conv_desc.C.layout,
-        conv_desc.tile_description.math_instruction.element_accumulator, 
-        conv_desc.element_epilogue
-      );
-
-      Operation const *op = operation.get();
-
-      int cc = conv_desc.tile_description.minimum_compute_capability;
-
-      ConvPreferenceKey preference_key(cc, conv_desc.iterator_algorithm);
-
-      // insert conv operation to conv2d_operations or conv3d_operations map
-      (desc.kind == OperationKind::kConv2d) ?
-        conv2d_operations[functional_key][preference_key].push_back(op) : 
-        conv3d_operations[functional_key][preference_key].push_back(op);
-    }
-
-    // insert all reduction operation into operation table
-    if (desc.kind == OperationKind::kReduction) {
-      auto &reduce_desc = static_cast<library::ReductionDescription const &>(desc);
-
-      ReductionFunctionalKey functional_key(
-        reduce_desc.provider,
-        reduce_desc.element_workspace,
-        reduce_desc.tile_description.math_instruction.element_accumulator,
-        reduce_desc.element_output,
-        reduce_desc.element_epilogue,
-        library::MathOperationID::kAdd,
-        library::EpilogueKind::kLinearCombination
-      );
-
-      Operation const *op = operation.get();
-
-      reduction_operations[functional_key] = op;
-
-    }
+    insert_(operation.get());
+  }
+}
+
+void OperationTable::attach(Manifest const &manifest) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  manifest_ = &manifest;
+  inserted_count_ = 0;
+}
+
+void OperationTable::update_(OperationKind kind, std::string const &functional_key) const {
 
+  if (!manifest_) {
+    return;
   }
 
+  // The table is filled on lookup through a const reference to a table that is itself never
+  // const, as the manifest constructs its operations
+  OperationTable &table = const_cast<OperationTable &>(*this);
+
+  for (Operation const *operation : manifest_->materialize(kind, functional_key, inserted_count_)) {
+    table.insert_(operation);
+    ++table.inserted_count_;
+  }
+}
+
+GemmOperationVectorMap const *OperationTable::find_gemm_operations(GemmFunctionalKey const &key) const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  update_(OperationKind::kGemm, configuration_key(key.element_A, key.element_B, key.element_C));
+
+  auto it = gemm_operations.find(key);
+  return (it == gemm_operations.end() || it->second.empty()) ? nullptr : &it->second;
+}
+
+ConvOperationVectorMap const *OperationTable::find_conv2d_operations(ConvFunctionalKey const &key) const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  update_(OperationKind::kConv2d, configuration_key(key.element_A, key.element_B, key.element_C));
+
+  auto it = conv2d_operations.find(key);
+  return (it == conv2d_operations.end() || it->second.empty()) ? nullptr : &it->second;
+}
+
+ConvOperationVectorMap const *OperationTable::find_conv3d_operations(ConvFunctionalKey const &key) const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  update_(OperationKind::kConv3d, configuration_key(key.element_A, key.element_B, key.element_C));
+
+  auto it = conv3d_operations.find(key);
+  return (it == conv3d_operations.end() || it->second.empty()) ? nullptr : &it->second;
+}
+
+Operation const *OperationTable::find_reduction_operation(ReductionFunctionalKey const &key) const {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Reduction operations are appended to the manifest directly rather than registered
+  update_(OperationKind::kReduction, std::string());
+
+  auto it = reduction_operations.find(key);
+  return it == reduction_operations.end() ? nullptr : it->second;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
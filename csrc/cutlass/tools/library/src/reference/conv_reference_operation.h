@@ -34,15 +34,18 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <sstream>
 #include <cstring>
+#include <type_traits>
 
 #include "cutlass/cutlass.h"
 
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
 #include "cutlass/library/util.h"
+#include "cutlass/library/reference_cache.h"
 #include "library_internal.h"
 
 #include "cutlass/conv/convolution.h"
@@ -287,6 +290,65 @@ struct ConvReferenceDispatcher<
   }
 };
 
+/// Appends a Conv2d configuration to a reference cache key and returns the number of elements
+/// spanned by the A, B and C tensors
+template <cutlass::conv::Operator kConvolutionalOperator>
+std::array<int64_t, 3> conv_reference_capacity(
+  Conv2dConfiguration const &config,
+  ReferenceCache::KeyBuilder &key) {
+
+  std::vector<int64_t> const *strides[] = {&config.stride_a, &config.stride_b, &config.stride_c};
+  Tensor4DCoord extents[] = {
+    cutlass::conv::implicit_gemm_tensor_a_extent(kConvolutionalOperator, config.problem_size),
+    cutlass::conv::implicit_gemm_tensor_b_extent(kConvolutionalOperator, config.problem_size),
+    cutlass::conv::implicit_gemm_tensor_c_extent(kConvolutionalOperator, config.problem_size)
+  };
+
+  key.append_value(config.problem_size);
+
+  std::array<int64_t, 3> capacity;
+  for (int i = 0; i < 3; ++i) {
+    std::vector<int64_t> const &stride = *strides[i];
+    if (stride.size() < 3) {
+      return {-1, -1, -1};
+    }
+
+    layout::TensorNHWC layout;
+    layout.stride() = make_Coord(int32_t(stride[0]), int32_t(stride[1]), int32_t(stride[2]));
+
+    key.append_value(layout.stride());
+    capacity[i] = layout.capacity(extents[i]);
+  }
+  return capacity;
+}
+
+/// Appends a Conv3d configuration to a reference cache key and returns the number of elements
+/// spanned by the A, B and C tensors
+template <cutlass::conv::Operator kConvolutionalOperator>
+std::array<int64_t, 3> conv_reference_capacity(
+  Conv3dConfiguration const &config,
+  ReferenceCache::KeyBuilder &key) {
+
+  ConvKind const conv_kind = ConvKindMap<kConvolutionalOperator>::kId;
+
+  layout::TensorNDHWC layouts[] = {
+    config.layout_a(conv_kind), config.layout_b(conv_kind), config.layout_c(conv_kind)};
+  Tensor5DCoord extents[] = {
+    cutlass::conv::implicit_gemm_tensor_a_extent(kConvolutionalOperator, config.problem_size),
+    cutlass::conv::implicit_gemm_tensor_b_extent(kConvolutionalOperator, config.problem_size),
+    cutlass::conv::implicit_gemm_tensor_c_extent(kConvolutionalOperator, config.problem_size)
+  };
+
+  key.append_value(config.problem_size);
+
+  std::array<int64_t, 3> capacity;
+  for (int i = 0; i < 3; ++i) {
+    key.append_value(layouts[i].stride());
+    capacity[i] = layouts[i].capacity(extents[i]);
+  }
+  return capacity;
+}
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -445,30 +507,64 @@ public:
     // TODO - respect pointer mode
 
     // Invoke 2D or 3D convolution
-    return detail::ConvReferenceDispatcher<
-      kProvider,
-      kConvolutionalOperator,
-      kConvDim,
-      ElementA,
-      LayoutA,
-      ElementB,
-      LayoutB,
-      ElementC,
-      LayoutC,
-      ElementCompute,
-      ElementAccumulator,
-      ConvertOp,
-      InnerProductOp
-    >::dispatch(
-      host_workspace,
-      static_cast<ElementA *>(const_cast<void *>(args.A)),
-      static_cast<ElementB *>(const_cast<void *>(args.B)),
-      static_cast<ElementC *>(const_cast<void *>(args.C)),
-      static_cast<ElementC *>(args.D),
-      alpha,
-      beta,
-      stream
-    );
+    auto compute = [&]() {
+      return detail::ConvReferenceDispatcher<
+        kProvider,
+        kConvolutionalOperator,
+        kConvDim,
+        ElementA,
+        LayoutA,
+        ElementB,
+        LayoutB,
+        ElementC,
+        LayoutC,
+        ElementCompute,
+        ElementAccumulator,
+        ConvertOp,
+        InnerProductOp
+      >::dispatch(
+        host_workspace,
+        static_cast<ElementA *>(const_cast<void *>(args.A)),
+        static_cast<ElementB *>(const_cast<void *>(args.B)),
+        static_cast<ElementC *>(const_cast<void *>(args.C)),
+        static_cast<ElementC *>(args.D),
+        alpha,
+        beta,
+        stream
+      );
+    };
+
+    if (kProvider != Provider::kReferenceHost || !args.A || !args.B || !args.C || !args.D) {
+      return compute();
+    }
+
+    // The result is cached under everything it depends on, including the prior contents of D
+    // outside the problem, so replaying it is indistinguishable from recomputing it
+    using Configuration = typename std::conditional<
+      kConvDim == 2, Conv2dConfiguration, Conv3dConfiguration>::type;
+
+    ReferenceCache::KeyBuilder key;
+    key.append(name_)
+      .append_value(alpha)
+      .append_value(beta);
+
+    std::array<int64_t, 3> capacity = detail::conv_reference_capacity<kConvolutionalOperator>(
+      *static_cast<Configuration const *>(host_workspace), key);
+
+    if (capacity[0] < 0) {
+      return compute();
+    }
+
+    size_t bytes_A = size_t((capacity[0] * cutlass::sizeof_bits<ElementA>::value + 7) / 8);
+    size_t bytes_B = size_t((capacity[1] * cutlass::sizeof_bits<ElementB>::value + 7) / 8);
+    size_t bytes_C = size_t((capacity[2] * cutlass::sizeof_bits<ElementC>::value + 7) / 8);
+
+    key.append(args.A, bytes_A)
+      .append(args.B, bytes_B)
+      .append(args.C, bytes_C)
+      .append(args.D, bytes_C);
+
+    return ReferenceCache::get().cached(key.key(), args.D, bytes_C, compute);
   }
 };
 
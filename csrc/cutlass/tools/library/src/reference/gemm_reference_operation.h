@@ -43,6 +43,7 @@
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
 #include "cutlass/library/util.h"
+#include "cutlass/library/reference_cache.h"
 #include "library_internal.h"
 
 #include "cutlass/util/reference/host/gemm_complex.h"
@@ -55,6 +56,19 @@ namespace library {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Number of bytes spanned by a batch of tensors
+template <typename Element>
+size_t reference_tensor_bytes(int64_t capacity, int batch_count, int64_t batch_stride) {
+  int64_t elements = capacity + int64_t(batch_count - 1) * batch_stride;
+  return size_t((elements * cutlass::sizeof_bits<Element>::value + 7) / 8);
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 template <
   Provider Provider_,
   typename ElementA_,
@@ -204,37 +218,79 @@ public:
 
     if (kProvider == Provider::kReferenceHost) {
 
-      cutlass::reference::host::GemmComplex<
-        ElementA,
-        LayoutA,
-        ElementB,
-        LayoutB,
-        ElementC,
-        LayoutC,
-        ElementCompute,
-        ElementAccumulator,
-        ElementD,
-        ConvertOp,
-        InnerProductOp
-      >(
-        config.problem_size,
-        *static_cast<ElementCompute const *>(args.alpha),
-        ref_A,
-        kTransformA,
-        ref_B,
-        kTransformB,
-        *static_cast<ElementCompute const *>(args.beta),
-        ref_C,
-        ref_D,
-        ElementAccumulator(),
-        ((config.mode == library::GemmUniversalMode::kBatched) ? config.batch_count : 1),
-        args.batch_stride_A,
-        args.batch_stride_B,
-        args.batch_stride_C,
-        args.batch_stride_D
-      );
-
-      return Status::kSuccess;
+      auto compute = [&]() {
+        cutlass::reference::host::GemmComplex<
+          ElementA,
+          LayoutA,
+          ElementB,
+          LayoutB,
+          ElementC,
+          LayoutC,
+          ElementCompute,
+          ElementAccumulator,
+          ElementD,
+          ConvertOp,
+          InnerProductOp
+        >(
+          config.problem_size,
+          *static_cast<ElementCompute const *>(args.alpha),
+          ref_A,
+          kTransformA,
+          ref_B,
+          kTransformB,
+          *static_cast<ElementCompute const *>(args.beta),
+          ref_C,
+          ref_D,
+          ElementAccumulator(),
+          ((config.mode == library::GemmUniversalMode::kBatched) ? config.batch_count : 1),
+          args.batch_stride_A,
+          args.batch_stride_B,
+          args.batch_stride_C,
+          args.batch_stride_D
+        );
+
+        return Status::kSuccess;
+      };
+
+      if (!args.A || !args.B || !args.C || !args.D) {
+        return compute();
+      }
+
+      // The result is cached under everything it depends on, including the prior contents of D
+      // outside the problem, so replaying it is indistinguishable from recomputing it
+      int batch_count = (config.mode == library::GemmUniversalMode::kBatched) ? config.batch_count : 1;
+
+      gemm::GemmCoord problem_size = config.problem_size;
+
+      size_t bytes_A = detail::reference_tensor_bytes<ElementA>(
+        ref_A.layout().capacity({problem_size.m(), problem_size.k()}), batch_count, args.batch_stride_A);
+      size_t bytes_B = detail::reference_tensor_bytes<ElementB>(
+        ref_B.layout().capacity({problem_size.k(), problem_size.n()}), batch_count, args.batch_stride_B);
+      size_t bytes_C = detail::reference_tensor_bytes<ElementC>(
+        ref_C.layout().capacity({problem_size.m(), problem_size.n()}), batch_count, args.batch_stride_C);
+      size_t bytes_D = detail::reference_tensor_bytes<ElementD>(
+        ref_D.layout().capacity({problem_size.m(), problem_size.n()}), batch_count, args.batch_stride_D);
+
+      ReferenceCache::KeyBuilder key;
+      key.append(name_)
+        .append_value(problem_size)
+        .append_value(batch_count)
+        .append_value(config.lda)
+        .append_value(config.ldb)
+        .append_value(config.ldc)
+        .append_value(config.ldd)
+        .append_value(args.batch_stride_A)
+        .append_value(args.batch_stride_B)
+        .append_value(args.batch_stride_C)
+        .append_value(args.batch_stride_D)
+        .append(args.alpha, sizeof(ElementCompute))
+        .append(args.beta, sizeof(ElementCompute))
+        .append(args.A, bytes_A)
+        .append(args.B, bytes_B)
+        .append(args.C, bytes_C)
+        .append(args.D, bytes_D);
+
+      return ReferenceCache::get().cached(key.key(), args.D, bytes_D, compute);
     }
     else if (kProvider == Provider::kReferenceDevice) {
 
@@ -0,0 +1,331 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+
+/*! \file
+    \brief Cache of host reference results
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#include "cutlass/library/reference_cache.h"
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+uint64_t const kMultiplier0 = 0x9e3779b97f4a7c15ull;
+uint64_t const kMultiplier1 = 0xc2b2ae3d27d4eb4full;
+
+/// Magic number preceding on-disk entries
+char const kFileMagic[8] = {'C', 'U', 'T', 'L', 'R', 'E', 'F', '1'};
+
+inline uint64_t rotl(uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+/// Finalization of MurmurHash3
+inline uint64_t fmix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+  return x;
+}
+
+inline void make_directory(std::string const &path) {
+#if defined(_WIN32)
+  _mkdir(path.c_str());
+#else
+  mkdir(path.c_str(), 0755);
+#endif
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string ReferenceCache::Key::to_string() const {
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0') << std::setw(16) << hi << std::setw(16) << lo;
+  return ss.str();
+}
+
+ReferenceCache::KeyBuilder::KeyBuilder(): state_{kMultiplier0, kMultiplier1}, length_(0) { }
+
+ReferenceCache::KeyBuilder &ReferenceCache::KeyBuilder::append(void const *data, size_t bytes) {
+
+  uint8_t const *ptr = static_cast<uint8_t const *>(data);
+  length_ += bytes;
+
+  // Two independent lanes over alternating words
+  uint64_t s0 = state_[0];
+  uint64_t s1 = state_[1];
+
+  for (; bytes >= 16; ptr += 16, bytes -= 16) {
+    uint64_t w[2];
+    std::memcpy(w, ptr, 16);
+    s0 = rotl(s0 ^ (w[0] * kMultiplier1), 31) * kMultiplier0;
+    s1 = rotl(s1 ^ (w[1] * kMultiplier0), 29) * kMultiplier1;
+  }
+
+  if (bytes) {
+    uint64_t w[2] = {0, 0};
+    std::memcpy(w, ptr, bytes);
+    s0 = rotl(s0 ^ (w[0] * kMultiplier1), 31) * kMultiplier0;
+    s1 = rotl(s1 ^ ((w[1] + bytes) * kMultiplier0), 29) * kMultiplier1;
+  }
+
+  state_[0] = s0;
+  state_[1] = s1;
+  return *this;
+}
+
+ReferenceCache::KeyBuilder &ReferenceCache::KeyBuilder::append(std::string const &str) {
+  uint64_t size = str.size();
+  append(&size, sizeof(size));
+  return append(str.data(), str.size());
+}
+
+ReferenceCache::Key ReferenceCache::KeyBuilder::key() const {
+  Key key;
+  uint64_t h0 = state_[0] ^ length_;
+  uint64_t h1 = state_[1] ^ rotl(length_, 32);
+  h0 += h1;
+  h1 += h0;
+  key.lo = fmix(h0);
+  key.hi = fmix(h1 ^ key.lo);
+  return key;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+ReferenceCache::ReferenceCache():
+  enabled_(false), capacity_(size_t(1) << 30), bytes_(0), hits_(0), misses_(0) { }
+
+ReferenceCache &ReferenceCache::get() {
+  static ReferenceCache instance;
+  return instance;
+}
+
+void ReferenceCache::set_enabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_ = enabled;
+}
+
+bool ReferenceCache::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return enabled_;
+}
+
+void ReferenceCache::set_capacity(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = bytes;
+  evict_();
+}
+
+void ReferenceCache::set_directory(std::string const &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  directory_ = path;
+  if (!directory_.empty()) {
+    make_directory(directory_);
+  }
+}
+
+void ReferenceCache::evict_() {
+  while (bytes_ > capacity_ && !entries_.empty()) {
+    bytes_ -= entries_.back().data.size();
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+void ReferenceCache::insert_(Key const &key, void const *data, size_t bytes) {
+  if (bytes > capacity_) {
+    return;
+  }
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    bytes_ -= it->second->data.size();
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  uint8_t const *ptr = static_cast<uint8_t const *>(data);
+  entries_.push_front(Entry{key, std::vector<uint8_t>(ptr, ptr + bytes)});
+  index_[key] = entries_.begin();
+  bytes_ += bytes;
+
+  evict_();
+}
+
+bool ReferenceCache::find(Key const &key, void *data, size_t bytes) {
+
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = index_.find(key);
+    if (it != index_.end() && it->second->data.size() == bytes) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      if (bytes) {
+        std::memcpy(data, it->second->data.data(), bytes);
+      }
+      ++hits_;
+      return true;
+    }
+
+    if (directory_.empty()) {
+      ++misses_;
+      return false;
+    }
+    path = directory_ + "/" + key.to_string() + ".ref";
+  }
+
+  // Disk lookups are made without holding the lock. Entries are read in full before any byte
+  // of the output is written.
+  std::ifstream file(path, std::ios::binary);
+
+  char magic[sizeof(kFileMagic)];
+  uint64_t size = 0;
+  std::vector<uint8_t> entry;
+
+  bool found = file &&
+    file.read(magic, sizeof(magic)) && !std::memcmp(magic, kFileMagic, sizeof(magic)) &&
+    file.read(reinterpret_cast<char *>(&size), sizeof(size)) && size == bytes;
+
+  if (found) {
+    entry.resize(bytes);
+    found = bool(file.read(reinterpret_cast<char *>(entry.data()), std::streamsize(bytes)));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (found) {
+    if (bytes) {
+      std::memcpy(data, entry.data(), bytes);
+    }
+    ++hits_;
+    insert_(key, data, bytes);
+  }
+  else {
+    ++misses_;
+  }
+  return found;
+}
+
+void ReferenceCache::insert(Key const &key, void const *data, size_t bytes) {
+
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    insert_(key, data, bytes);
+
+    if (directory_.empty()) {
+      return;
+    }
+    path = directory_ + "/" + key.to_string() + ".ref";
+  }
+
+  // Entries are written under a unique name and renamed, so concurrent readers never see a
+  // partial file
+  std::ostringstream temporary;
+  temporary << path << ".tmp" << std::hex
+    << std::chrono::steady_clock::now().time_since_epoch().count() << "_"
+    << reinterpret_cast<uintptr_t>(data);
+
+  {
+    uint64_t size = bytes;
+    std::ofstream file(temporary.str(), std::ios::binary | std::ios::trunc);
+    file.write(kFileMagic, sizeof(kFileMagic));
+    file.write(reinterpret_cast<char const *>(&size), sizeof(size));
+    file.write(static_cast<char const *>(data), std::streamsize(bytes));
+    if (!file) {
+      file.close();
+      std::remove(temporary.str().c_str());
+      return;
+    }
+  }
+
+#if defined(_WIN32)
+  std::remove(path.c_str());
+#endif
+  if (std::rename(temporary.str().c_str(), path.c_str())) {
+    std::remove(temporary.str().c_str());
+  }
+}
+
+void ReferenceCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  bytes_ = 0;
+  hits_ = 0;
+  misses_ = 0;
+}
+
+size_t ReferenceCache::hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+size_t ReferenceCache::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+size_t ReferenceCache::bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
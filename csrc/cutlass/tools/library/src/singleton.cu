@@ -30,6 +30,7 @@
  **************************************************************************************************/
 
 #include <memory>
+#include <mutex>
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
 #include "cutlass/library/operation_table.h"
@@ -42,11 +43,42 @@ namespace library {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Guards the filter and creation flag
+std::mutex &singleton_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// Filter applied when the singleton is created
+ManifestFilter &singleton_filter() {
+  static ManifestFilter filter;
+  return filter;
+}
+
+/// True once the singleton has begun to be created
+bool singleton_created = false;
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 Singleton::Singleton() {
 
-  manifest.initialize();
+  ManifestFilter filter;
+  {
+    std::lock_guard<std::mutex> lock(singleton_mutex());
+    singleton_created = true;
+    filter = singleton_filter();
+  }
+
+  manifest.initialize(filter);
 
-  operation_table.append(manifest);
+  // Configurations are constructed when the table or index first looks up their functional key
+  operation_table.attach(manifest);
+
+  operation_index.attach(manifest);
 }
 
 Singleton const & Singleton::get() {
@@ -54,6 +86,15 @@ Singleton const & Singleton::get() {
   return instance;
 }
 
+bool Singleton::set_filter(ManifestFilter const &filter) {
+  std::lock_guard<std::mutex> lock(singleton_mutex());
+  if (singleton_created) {
+    return false;
+  }
+  singleton_filter() = filter;
+  return true;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 } // namespace library
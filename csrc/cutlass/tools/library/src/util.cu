@@ -31,6 +31,8 @@
 
 #include <iosfwd>
 #include <complex>
+#include <sstream>
+#include <string>
 #include "cutlass/cutlass.h"
 #include "cutlass/numeric_types.h"
 #include "cutlass/complex.h"
@@ -58,6 +60,7 @@ Provider_enumerants[] = {
   {"device", "reference_device", Provider::kReferenceDevice},
   {"cublas", "cuBLAS", Provider::kCUBLAS},
   {"cudnn", "cuDNN", Provider::kCUDNN},                           
+  {"cpu", "CPU", Provider::kHost},
 };
 
 /// Converts a Provider enumerant to a string
@@ -1703,6 +1706,36 @@ bool cast_from_double(std::vector<uint8_t> &bytes, NumericTypeID type, double sr
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Returns true if the substrings of a pattern of the form "gemm*f32*nt" appear in an operation
+/// name in order
+bool matches_operation_name(std::string const &pattern, std::string const &operation_name) {
+
+  std::string token;
+  std::istringstream tokens(pattern);
+
+  size_t start = 0;
+
+  while (std::getline(tokens, token, '*')) {
+
+    // Tokens following the end of the name match
+    if (start >= operation_name.length()) {
+      break;
+    }
+
+    size_t idx = operation_name.find(token, start);
+
+    if (idx == std::string::npos) {
+      return false;
+    }
+
+    start = idx + token.length();
+  }
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace library
 } // namespace cutlass
 
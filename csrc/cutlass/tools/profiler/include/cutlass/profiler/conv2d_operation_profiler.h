@@ -430,7 +430,19 @@ public:
 protected:
   /// Method to profile an initialized CUTLASS operation
   virtual Status profile_cutlass_(
-    double &runtime,
+    PerformanceResult &result,
+    Options const &options,
+    library::Operation const *operation,
+    void *arguments,
+    void *host_workspace,
+    void *device_workspace);
+
+  /// Method to profile a CUTLASS operation with a GpuTimer or, for operations executed on the
+  /// host, a HostTimer
+  template <typename Timer>
+  Status profile_cutlass_(
+    Timer &timer,
+    PerformanceResult &result,
     Options const &options,
     library::Operation const *operation,
     void *arguments,
@@ -76,9 +76,16 @@ private:
   /// Enumerates all operations
   void enumerate_();
 
+  /// Returns a filter restricting the operations the library constructs to those the options
+  /// select for profiling
+  library::ManifestFilter manifest_filter_() const;
+
   /// Profiles all operations
   int profile_();
 
+  /// Merges reports written by the shards of a sweep
+  int merge_();
+
 public:
 
   CutlassProfiler(Options const &options);
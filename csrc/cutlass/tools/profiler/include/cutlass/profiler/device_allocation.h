@@ -50,7 +50,8 @@ namespace profiler {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Device memory allocation
+/// Device memory allocation. Allocations made for operations executed on the host reside in host
+/// memory instead, and their device-side methods fall back to host implementations.
 class DeviceAllocation {
 private:
 
@@ -66,6 +67,9 @@ private:
   /// Pointer to device memory
   void *pointer_;
 
+  /// If true, the allocation resides in host memory
+  bool host_resident_;
+
   /// Layout type ID
   library::LayoutTypeID layout_;
 
@@ -81,6 +85,12 @@ private:
   /// Buffer holding TensorRef instance to recently allocated memory
   std::vector<uint8_t> tensor_ref_buffer_;
 
+  /// Allocates pointer_ in device or host memory
+  void allocate_(size_t bytes);
+
+  /// Frees pointer_
+  void free_();
+
 public:
   //
   // Static member functions
@@ -117,6 +127,22 @@ public:
     double epsilon,
     double nonzero_floor);
 
+  /// Returns true if two blocks in host memory have exactly the same value
+  static bool block_compare_equal_host(
+    library::NumericTypeID numeric_type, 
+    void const *ptr_A, 
+    void const *ptr_B, 
+    size_t capacity);
+
+  /// Returns true if two blocks in host memory have approximately the same value
+  static bool block_compare_relatively_equal_host(
+    library::NumericTypeID numeric_type, 
+    void const *ptr_A, 
+    void const *ptr_B, 
+    size_t capacity,
+    double epsilon,
+    double nonzero_floor);
+
 public:
   //
   // Methods
@@ -124,19 +150,27 @@ public:
 
   DeviceAllocation();
   
-  DeviceAllocation(library::NumericTypeID type, size_t capacity);
+  DeviceAllocation(library::NumericTypeID type, size_t capacity, bool host_resident = false);
   
   DeviceAllocation(
     library::NumericTypeID type, 
     library::LayoutTypeID layout_id, 
     std::vector<int> const &extent, 
     std::vector<int64_t> const &stride = std::vector<int64_t>(),
-    int batch_count = 1);
+    int batch_count = 1,
+    bool host_resident = false);
 
   ~DeviceAllocation();
 
+  /// Frees memory. Later allocations remain in the same memory space.
   DeviceAllocation &reset();
 
+  /// Frees memory and selects whether later allocations reside in host memory
+  DeviceAllocation &set_host_resident(bool host_resident);
+
+  /// Returns true if the allocation resides in host memory
+  bool host_resident() const;
+
   /// Allocates device memory of a given type and capacity
   DeviceAllocation &reset(library::NumericTypeID type, size_t capacity);
 
@@ -68,6 +68,9 @@ private:
 
   /// Non-owning set of named allocations
   AllocationMap allocations_;
+
+  /// If true, new allocations reside in host memory
+  bool host_resident_ = false;
   
 public:
 
@@ -118,6 +121,12 @@ public:
   /// Gets the allocation by name
   DeviceAllocation &at(std::string const &name);
 
+  /// Selects whether new allocations reside in host memory, as needed by host-executed operations
+  void set_host_resident(bool host_resident);
+
+  /// Returns true if new allocations reside in host memory
+  bool host_resident() const;
+
   size_t size() const;
 
   AllocationMap::iterator begin();
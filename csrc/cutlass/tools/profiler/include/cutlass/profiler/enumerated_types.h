@@ -58,6 +58,7 @@ enum class ExecutionMode {
   kDryRun,      ///< no kernels are launched or workspaces allocated; used to assess what operators might be launched
   kEnumerate,   ///< no kernels launched or workspaces allocated; lists all operation kind and operations
   kTrace,       ///< executes a single device-side computation with no other kernel launches
+  kMerge,       ///< merges reports written by the shards of a sweep
   kInvalid
 };
 
@@ -242,9 +242,31 @@ protected:
     cutlass::library::NumericTypeID element_A,
     cutlass::library::NumericTypeID element_B);
 
+  /// Verifies the computed result against the host reference while later operations are profiled
+  void defer_host_reference_(
+    Options const &options,
+    library::GemmDescription const &gemm_desc,
+    library::NumericTypeID element_A,
+    library::NumericTypeID element_B,
+    std::vector<uint8_t> host_data_A,
+    std::vector<uint8_t> host_data_B,
+    std::vector<uint8_t> host_data_C);
+
   /// Method to profile a CUTLASS Operation
   Status profile_cutlass_(
-    double &runtime,
+    PerformanceResult &result,
+    Options const &options,
+    library::Operation const *operation,
+    void *arguments,
+    void *host_workspace,
+    void *device_workspace);
+
+  /// Method to profile a CUTLASS Operation with a GpuTimer or, for operations executed on the
+  /// host, a HostTimer
+  template <typename Timer>
+  Status profile_cutlass_(
+    Timer &timer,
+    PerformanceResult &result,
     Options const &options,
     library::Operation const *operation,
     void *arguments,
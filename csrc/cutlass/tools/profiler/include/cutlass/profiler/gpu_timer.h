@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <cuda_runtime.h>
 #include "cutlass/cutlass.h"
 
@@ -46,6 +48,9 @@ struct GpuTimer {
 
   cudaEvent_t events[2];
 
+  /// Events recorded at the end of each sampled iteration
+  std::vector<cudaEvent_t> sample_events;
+
   //
   // Methods
   //
@@ -64,6 +69,15 @@ struct GpuTimer {
 
   /// Returns the duration in milliseconds
   double duration(int iterations = 1) const;
+
+  /// Creates events to time each of the first `iterations` iterations after start()
+  void enable_samples(int iterations);
+
+  /// Records the end of an iteration in the stream. Does nothing if the iteration is not sampled.
+  void sample(int iteration, cudaStream_t stream = nullptr);
+
+  /// Returns the duration in milliseconds of each sampled iteration among the first `iterations`
+  std::vector<double> samples(int iterations) const;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,88 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Wall-clock timer for operations executed on the host
+*/
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include <cuda_runtime.h>
+#include "cutlass/cutlass.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Times host-executed operations with the same interface as GpuTimer. Operations run to
+/// completion before returning, so streams are ignored and each time point is taken immediately.
+struct HostTimer {
+
+  using Clock = std::chrono::steady_clock;
+
+  Clock::time_point events[2];
+
+  /// Time points taken at the end of each sampled iteration
+  std::vector<Clock::time_point> sample_events;
+
+  //
+  // Methods
+  //
+
+  /// Takes the start time point
+  void start(cudaStream_t stream = nullptr);
+
+  /// Takes the stop time point
+  void stop(cudaStream_t stream = nullptr);
+
+  /// Takes the stop time point
+  void stop_and_wait(cudaStream_t stream = nullptr);
+
+  /// Returns the duration in milliseconds
+  double duration(int iterations = 1) const;
+
+  /// Reserves time points for each of the first `iterations` iterations after start()
+  void enable_samples(int iterations);
+
+  /// Takes the time point ending an iteration. Does nothing if the iteration is not sampled.
+  void sample(int iteration, cudaStream_t stream = nullptr);
+
+  /// Returns the duration in milliseconds of each sampled iteration among the first `iterations`
+  std::vector<double> samples(int iterations) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
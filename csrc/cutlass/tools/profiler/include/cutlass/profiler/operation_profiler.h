@@ -37,6 +37,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
 #include <unordered_map>
 
 // CUTLASS includes
@@ -53,6 +54,7 @@
 #include "performance_result.h"
 #include "performance_report.h"
 #include "problem_space.h"
+#include "verification_pipeline.h"
 #include "debug.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -91,6 +93,12 @@ protected:
   /// Performance result vector constructed by profiling the operation
   PerformanceResultVector results_;
 
+  /// Verifications of results_ that complete after the operation is profiled
+  DeferredVerificationVector deferred_verifications_;
+
+  /// Runs deferred verifications. Null if results are verified before they are profiled.
+  VerificationPipeline *verification_pipeline_ = nullptr;
+
 public:
 
   //
@@ -188,6 +196,9 @@ public:
   /// Sleep for a given duration in ms
   static void sleep(int sleep_duration);
 
+  /// Returns a string identifying a problem by its argument values
+  static std::string problem_string_(ProblemSpace::Problem const &problem);
+
   /// Returns true if the current operation description satisfies the problem space
   static bool satisfies(
     library::OperationDescription const &op_desc,
@@ -201,6 +212,14 @@ public:
     DeviceAllocation &reference,
     int64_t count = 0);
 
+  /// Compares tensors in host memory for equality
+  static Disposition compare_host_tensors(
+    Options const &options,
+    library::NumericTypeID type,
+    void const *experimental,
+    void const *reference,
+    int64_t count);
+
   static void save_workspace(
     DeviceContext &device_context,
     Options const &options,
@@ -232,18 +251,97 @@ protected:
 
   /// Method to profile an initialized CUTLASS operation
   virtual Status profile_cutlass_(
-    double &runtime,
+    PerformanceResult &result,
     Options const &options,
     library::Operation const *operation,
     void *arguments,
     void *host_workspace,
     void *device_workspace);
 
+  /// Profiles batches of iterations chosen by the sampler of the profiling options.
+  /// run_iteration(iteration) launches one iteration and returns its status. Each iteration is
+  /// timed only if the sampler adapts the iteration count or the results database records the
+  /// samples. Otherwise the fixed number of iterations is timed as a single batch, so no event is
+  /// recorded between them.
+  template <typename Timer, typename RunIteration>
+  static Status profile_iterations_(
+    PerformanceResult &result,
+    Options const &options,
+    Timer &timer,
+    RunIteration run_iteration) {
+
+    RuntimeSampler sampler = options.profiling.sampler();
+
+    bool const record_samples = options.profiling.iterations <= 0 || options.report.record_samples();
+
+    Status status = Status::kSuccess;
+
+    double total_runtime = 0;
+    int iteration = 0;
+
+    for (int batch = sampler.next_batch(); batch > 0; batch = sampler.next_batch()) {
+
+      if (record_samples) {
+        timer.enable_samples(batch);
+      }
+
+      timer.start();
+
+      for (int idx = 0; idx < batch; ++idx) {
+
+        status = run_iteration(iteration + idx);
+
+        if (status != Status::kSuccess) {
+          return status;
+        }
+
+        if (record_samples) {
+          timer.sample(idx);
+        }
+      }
+
+      timer.stop_and_wait();
+
+      total_runtime += timer.duration(1);
+      iteration += batch;
+
+      // A fixed number of iterations is a single batch
+      if (!record_samples) {
+        break;
+      }
+
+      sampler.add(timer.samples(batch));
+    }
+
+    result.runtime = (iteration ? total_runtime / double(iteration) : 0);
+    result.iterations = iteration;
+    result.samples = sampler.samples();
+    result.statistics = sampler.statistics();
+
+    return status;
+  }
+
+  /// Returns true if verification against the host reference may complete after the operation
+  /// is profiled. Verification is not deferred if its workspace may be saved, if it is required,
+  /// or if the operation itself runs on the host and would compete with it.
+  bool defer_verification_(Options const &options, DeviceContext const &device_context) const;
+
+  /// Defers a verification of the most recent result. The verification function must only
+  /// access host memory it owns.
+  void defer_verification_(
+    library::Provider provider,
+    size_t bytes,
+    std::function<Disposition()> verify);
+
+  /// Appends results_ to the report, or queues them behind pending verifications
+  void append_results_(PerformanceReport &report);
+
 private:
-  /// finds string matches filter_string in operation_name
-  bool find_string_matches_(
-    std::string const &filter_string, 
-    std::string const &operation_name);
+  /// Returns the operations of the manifest passing the kind, provider, compute capability and
+  /// name filters
+  std::vector<library::Operation const *> filter_operations_(
+    Options const &options,
+    library::Manifest const &manifest);
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
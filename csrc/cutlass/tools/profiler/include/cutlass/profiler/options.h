@@ -45,6 +45,8 @@
 #include "cutlass/library/library.h"
 
 #include "enumerated_types.h"
+#include "runtime_statistics.h"
+#include "sweep.h"
 
 namespace cutlass {
 namespace profiler {
@@ -81,7 +83,7 @@ public:
   /// Options related to the selected device
   struct Device {
 
-    /// Device ID
+    /// Device ID. Negative if no CUDA device is present.
     int device;
 
     /// CUDA Device properties
@@ -102,6 +104,11 @@ public:
 
     /// Returns the compute capability of the listed device (e.g. 61, 60, 70, 75)
     int compute_capability() const;
+
+    /// Returns true if no CUDA device is present and only operations executed on the host run
+    bool host_only() const {
+      return device < 0;
+    }
   };
 
   /// Options related to initializing input tensors
@@ -166,6 +173,22 @@ public:
     /// Indicates when to save the workspace
     SaveWorkspace save_workspace;
 
+    /// If true, host reference results are cached across kernels verified on the same inputs
+    bool reference_cache;
+
+    /// Capacity of the in-memory reference cache in MiB
+    size_t reference_cache_capacity;
+
+    /// Directory backing the reference cache, if not empty
+    std::string reference_cache_dir;
+
+    /// Number of threads verifying results against the host reference while later kernels are
+    /// profiled. If zero, verification completes before each kernel is profiled.
+    int threads;
+
+    /// Capacity in MiB of host memory held by results awaiting verification
+    size_t queue_capacity;
+
     //
     // Methods
     //
@@ -197,6 +220,13 @@ public:
     /// Number of ms to sleep between profiling periods (ms)
     int sleep_duration;
 
+    /// Number of ms to profile each kernel if iterations is 0
+    int duration;
+
+    /// Relative width of the confidence interval of the median runtime at which profiling stops
+    /// if iterations is 0
+    double confidence_width;
+
     /// If true, profiling is actually conducted.
     bool enabled;
 
@@ -206,6 +236,9 @@ public:
     /// List of providers of each functionality to be profiled
     ProviderVector providers;
 
+    /// Shard of the (operation, problem) pairs profiled by this process
+    SweepShard shard;
+
     //
     // Methods
     //
@@ -220,6 +253,11 @@ public:
 
     /// Returns the index of a provider if its enabled
     size_t index(library::Provider provider) const;
+
+    /// Returns a sampler deciding how many iterations to profile
+    RuntimeSampler sampler() const {
+      return RuntimeSampler(iterations, confidence_width, double(duration));
+    }
   };
   
   /// Options related to reporting
@@ -251,6 +289,25 @@ public:
     /// This is useful for determining which kernel is causing a run of the profiler to hang
     bool print_kernel_before_running;
 
+    /// Path to a results database to which results are appended
+    std::string results_db_path;
+
+    /// Path to a results database holding baseline results
+    std::string compare_path;
+
+    /// Smallest relative change of the median runtime reported by the comparison
+    double compare_threshold;
+
+    /// Significance level of the comparison
+    double compare_alpha;
+
+    /// Path to a file recording completed (operation, problem) pairs, which are skipped when the
+    /// profiler is run again
+    std::string checkpoint_path;
+
+    /// Paths to reports merged if the execution mode is merge
+    std::vector<std::string> merge_inputs;
+
     //
     // Methods
     //
@@ -259,6 +316,11 @@ public:
     
     void print_usage(std::ostream &out) const;
     void print_options(std::ostream &out, int indent = 0) const;
+
+    /// Returns true if the runtime of each profiled iteration is recorded
+    bool record_samples() const {
+      return !results_db_path.empty() || !compare_path.empty();
+    }
   };
 
   /// Options related to printing usage and version information
@@ -41,6 +41,8 @@
 #include "options.h"
 #include "enumerated_types.h"
 #include "performance_result.h"
+#include "results_database.h"
+#include "sweep.h"
 
 // CUTLASS Library includes
 #include "cutlass/library/library.h"
@@ -83,6 +85,21 @@ private:
   /// Collection of all results
   PerformanceResultVector concatenated_results_;
 
+  /// Device and compute capability identifying records of the results database
+  std::string device_name_;
+
+  /// Time the report was created
+  std::string timestamp_;
+
+  /// Records of profiled results, kept for the results database and comparison
+  std::vector<ResultRecord> records_;
+
+  /// Completed (operation, problem) pairs of this and earlier runs
+  SweepCheckpoint checkpoint_;
+
+  /// Problem strings identifying problems in the checkpoint, indexed by problem index
+  std::vector<std::string> problem_keys_;
+
 public:
 
   PerformanceReport(Options const &options, std::vector<std::string> const &argument_names, library::OperationKind const &op_kind);
@@ -90,11 +107,27 @@ public:
 
   bool good() const { return good_; }
 
-  void next_problem();
+  /// Advances to the next problem, which the checkpoint identifies by problem_key
+  void next_problem(std::string const &problem_key = std::string());
   void append_result(PerformanceResult result);
   void sort_results(PerformanceResultVector &results);
   void append_results(PerformanceResultVector const &results);
 
+  /// Index of the current problem
+  size_t problem_index() const { return problem_index_; }
+
+  /// Returns true if the checkpoint records results of the operation on the current problem
+  bool completed(std::string const &operation_name) const;
+
+  /// Appends results of a problem that may precede the current one
+  void append_result(PerformanceResult result, size_t problem_index);
+  void append_results(PerformanceResultVector const &results, size_t problem_index);
+
+  /// Appends profiled results to the results database and compares them against the baseline,
+  /// if it exists. Returns the number of significant regressions, or -1 if a database cannot be
+  /// used. The results are appended even if the baseline cannot be read.
+  int record_results();
+
 public:
 
   /// Prints the CSV header
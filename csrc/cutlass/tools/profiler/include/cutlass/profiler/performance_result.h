@@ -40,6 +40,7 @@
 
 // CUTLASS Profiler includes
 #include "enumerated_types.h"
+#include "runtime_statistics.h"
 
 // CUTLASS Library includes
 #include "cutlass/library/library.h"
@@ -86,6 +87,15 @@ struct PerformanceResult {
   /// Average runtime in ms
   double runtime;
 
+  /// Number of profiled iterations
+  int iterations;
+
+  /// Runtime of each profiled iteration in ms, if iterations were timed individually
+  std::vector<double> samples;
+
+  /// Statistics of the samples
+  RuntimeStatistics statistics;
+
   //
   // Members
   //
@@ -99,7 +109,8 @@ struct PerformanceResult {
     status(Status::kInvalid),
     bytes(0), 
     flops(0), 
-    runtime(0)
+    runtime(0),
+    iterations(0)
   { }
 
   /// Returns true if the runtime is valid
@@ -0,0 +1,225 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Persistent database of profiler results and comparison of runs against a baseline
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Result of one operation on one problem and device recorded by a profiler run
+struct ResultRecord {
+
+  /// Time the run started (UTC, ISO 8601)
+  std::string timestamp;
+
+  /// Device name and compute capability
+  std::string device;
+
+  /// Provider of the operation (e.g. CUTLASS, cuBLAS)
+  std::string provider;
+
+  /// Operation name
+  std::string operation;
+
+  /// Problem arguments as '--name=value' sorted by name
+  std::string problem;
+
+  /// Average runtime in ms
+  double runtime;
+
+  /// Runtime of each profiled iteration in ms
+  std::vector<double> samples;
+
+  ResultRecord(): runtime(0) { }
+
+  /// Formats problem arguments, ignoring empty values
+  static std::string problem_string(std::vector<std::pair<std::string, std::string>> const &arguments);
+};
+
+/// Append-only database of results indexed by device, provider, operation and problem.
+///
+/// The file holds a header line followed by one tab-separated record per line, so runs append
+/// results without rewriting earlier ones.
+class ResultsDatabase {
+public:
+
+  /// Device, provider, operation and problem
+  using Key = std::tuple<std::string, std::string, std::string, std::string>;
+
+  static Key key(ResultRecord const &record);
+
+  /// Writes the header line of a database file
+  static std::ostream &write_header(std::ostream &out);
+
+  /// Writes one record as a line
+  static std::ostream &write(std::ostream &out, ResultRecord const &record);
+
+  /// Appends records to the database file at path, creating it if needed. Returns false if the
+  /// file cannot be written.
+  static bool append(std::string const &path, std::vector<ResultRecord> const &records);
+
+  /// Reads records from a database stream. Returns the number of records read, or -1 if the
+  /// stream does not start with a database header or holds a malformed record.
+  int load(std::istream &in);
+
+  /// Reads a database file. Returns -1 if it cannot be opened or parsed.
+  int load(std::string const &path);
+
+  /// Adds a record after all records with the same key
+  void insert(ResultRecord const &record);
+
+  /// Returns the most recently added record with a key, or nullptr
+  ResultRecord const *find(Key const &key) const;
+
+  /// Returns all records with a key, oldest first
+  std::vector<ResultRecord> const *history(Key const &key) const;
+
+  /// Number of records
+  size_t size() const { return size_; }
+
+  /// Removes all records
+  void clear();
+
+private:
+
+  std::map<Key, std::vector<ResultRecord>> index_;
+  size_t size_ = 0;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Summary statistics of a set of runtime samples
+struct SampleStatistics {
+
+  size_t count;
+  double mean;
+  double median;
+  double stddev;
+
+  SampleStatistics(): count(0), mean(0), median(0), stddev(0) { }
+
+  static SampleStatistics compute(std::vector<double> const &samples);
+};
+
+/// Two-sided p-value of the Mann-Whitney U (Wilcoxon rank-sum) test that two sets of samples are
+/// drawn from the same distribution. Uses the normal approximation with tie and continuity
+/// corrections. Returns 1 if either set is empty or all samples are tied.
+double rank_sum_test(std::vector<double> const &a, std::vector<double> const &b);
+
+/// Outcome of comparing a result against its baseline
+enum class ComparisonVerdict {
+  kUnchanged,       ///< change is below the threshold or not significant
+  kRegression,      ///< significantly slower by more than the threshold
+  kImprovement,     ///< significantly faster by more than the threshold
+  kInconclusive,    ///< changed by more than the threshold, but too few samples to test
+  kNew,             ///< no baseline result
+  kInvalid
+};
+
+char const *to_string(ComparisonVerdict verdict);
+
+/// Parameters of a comparison
+struct ComparisonOptions {
+
+  /// Smallest relative change of the median runtime that is reported
+  double threshold;
+
+  /// Significance level of the rank-sum test
+  double alpha;
+
+  /// Fewest samples in each run for the test to be applied
+  size_t min_samples;
+
+  ComparisonOptions(double threshold = 0.02, double alpha = 0.01, size_t min_samples = 5):
+    threshold(threshold), alpha(alpha), min_samples(min_samples) { }
+};
+
+/// Comparison of a result against its baseline
+struct ResultComparison {
+
+  ResultRecord current;
+
+  /// True if a baseline result was found
+  bool has_baseline;
+
+  ResultRecord baseline;
+
+  /// Median runtimes in ms. The average runtime stands in when there are no samples.
+  double current_median;
+  double baseline_median;
+
+  /// Relative change of the median runtime, positive if the current run is slower
+  double change;
+
+  /// p-value of the rank-sum test, or 1 if it was not applied
+  double p_value;
+
+  ComparisonVerdict verdict;
+
+  ResultComparison():
+    has_baseline(false), current_median(0), baseline_median(0), change(0), p_value(1),
+    verdict(ComparisonVerdict::kInvalid) { }
+};
+
+/// Compares a result against a baseline result, which may be null
+ResultComparison compare_result(
+  ResultRecord const &current,
+  ResultRecord const *baseline,
+  ComparisonOptions const &options = ComparisonOptions());
+
+/// Compares results against the latest records with the same key in a baseline database
+std::vector<ResultComparison> compare_results(
+  std::vector<ResultRecord> const &current,
+  ResultsDatabase const &baseline,
+  ComparisonOptions const &options = ComparisonOptions());
+
+/// Prints the comparisons that did not find a result unchanged as a table, followed by the
+/// number of results with each verdict
+std::ostream &print_comparisons(std::ostream &out, std::vector<ResultComparison> const &comparisons);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
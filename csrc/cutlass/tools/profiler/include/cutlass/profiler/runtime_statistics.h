@@ -0,0 +1,133 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Statistics of profiled runtimes and the number of iterations needed to measure them
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Order statistics of runtime samples after rejecting outliers
+struct RuntimeStatistics {
+
+  /// Number of samples kept
+  size_t count;
+
+  /// Number of samples rejected as outliers
+  size_t rejected;
+
+  /// Runtimes in ms
+  double min;
+  double median;
+  double p90;
+
+  /// Bounds of the confidence interval of the median in ms
+  double median_lower;
+  double median_upper;
+
+  RuntimeStatistics():
+    count(0), rejected(0), min(0), median(0), p90(0), median_lower(0), median_upper(0) { }
+
+  /// Width of the confidence interval of the median relative to the median
+  double relative_width() const;
+
+  /// Computes statistics of samples, rejecting samples further than outlier_threshold scaled
+  /// median absolute deviations from the median. Such samples are typically disturbed by clock
+  /// changes or preemption. The confidence interval is distribution-free and built from order
+  /// statistics.
+  static RuntimeStatistics compute(
+    std::vector<double> const &samples,
+    double confidence = 0.95,
+    double outlier_threshold = 5);
+};
+
+/// Decides how many iterations of an operation to profile.
+///
+/// With a fixed number of iterations, they are profiled in a single batch. Otherwise, batches of
+/// growing size are profiled until the confidence interval of the median runtime is narrower than
+/// a relative width or the profiled time exceeds a budget.
+class RuntimeSampler {
+public:
+
+  /// If iterations is positive, profiles exactly that many iterations. Otherwise samples
+  /// adaptively, profiling at least min_iterations and at most max_iterations for about
+  /// duration ms.
+  explicit RuntimeSampler(
+    int iterations,
+    double relative_width = 0.01,
+    double duration = 1000,
+    int min_iterations = 10,
+    int max_iterations = 100000);
+
+  /// Number of iterations of the next batch, or zero if profiling is complete
+  int next_batch() const;
+
+  /// Adds the runtime of each iteration of a batch in ms
+  void add(std::vector<double> const &samples);
+
+  /// True if the confidence interval of the median is narrower than the requested width
+  bool converged() const;
+
+  std::vector<double> const &samples() const { return samples_; }
+
+  RuntimeStatistics const &statistics() const { return statistics_; }
+
+private:
+
+  int iterations_;
+  double relative_width_;
+  double duration_;
+  int min_iterations_;
+  int max_iterations_;
+
+  /// Number of batches added
+  int batches_;
+
+  /// Sum of all samples in ms
+  double elapsed_;
+
+  std::vector<double> samples_;
+  RuntimeStatistics statistics_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,124 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Sharding, checkpointing and merging of profiler sweeps
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <iosfwd>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Deterministic partition of the (operation, problem) pairs of a sweep among processes. Pairs are
+/// assigned by a hash of the operation name and problem, so every process running the same sweep
+/// agrees on the assignment regardless of which operations its device supports.
+struct SweepShard {
+
+  /// Index of this shard
+  int index;
+
+  /// Number of shards
+  int count;
+
+  SweepShard(int index = 0, int count = 1): index(index), count(count) { }
+
+  /// Parses '<index>/<count>'. Returns false if the string is malformed or index is not in
+  /// [0, count).
+  static bool parse(std::string const &str, SweepShard &shard);
+
+  /// Returns true if the pair is assigned to this shard
+  bool contains(std::string const &operation, std::string const &problem) const;
+};
+
+/// Append-only file recording the (operation, problem) pairs whose results have been reported,
+/// so an interrupted sweep may resume where it stopped.
+///
+/// The file holds a header line followed by one tab-separated pair per line. A line left
+/// incomplete by a crash is ignored.
+class SweepCheckpoint {
+public:
+
+  /// Reads the pairs recorded at path and opens it for appending, creating it if needed. Returns
+  /// false if the file cannot be written or is not a checkpoint.
+  bool open(std::string const &path);
+
+  /// True if the checkpoint file is open
+  bool is_open() const { return file_.is_open(); }
+
+  /// Returns true if the pair has been recorded
+  bool completed(std::string const &operation, std::string const &problem) const;
+
+  /// Records a pair, flushing it to the file
+  void record(std::string const &operation, std::string const &problem);
+
+  /// Number of recorded pairs
+  size_t size() const { return completed_.size(); }
+
+private:
+
+  std::set<std::pair<std::string, std::string>> completed_;
+  std::ofstream file_;
+};
+
+/// Merges CSV reports of the same operation kind written by the shards of a sweep.
+///
+/// The header is written once, and problems are renumbered in order of first appearance, since
+/// each shard numbers its own problems. If a pair was reported more than once, for example by a
+/// sweep resumed after a crash, its last rows are kept. Returns the number of rows written, or -1
+/// if the reports have different headers. If error is not null, it describes the failure.
+int merge_reports(
+  std::vector<std::istream *> const &inputs,
+  std::ostream &out,
+  std::string *error = nullptr);
+
+/// Merges the CSV reports at paths into a report at output_path. Returns the number of rows
+/// written, or -1 if a file cannot be read or written or the reports have different headers.
+int merge_reports(
+  std::vector<std::string> const &paths,
+  std::string const &output_path,
+  std::string *error = nullptr);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,154 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Verification of profiled results on worker threads
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cutlass/library/library.h"
+
+#include "enumerated_types.h"
+#include "performance_result.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Verification of a result that is deferred until after its operation has been profiled. The
+/// verification works on host copies of the tensors it needs, so it may run while later kernels
+/// overwrite the device workspace.
+struct DeferredVerification {
+
+  /// Index of the verified result among the results of its operation
+  size_t result_index;
+
+  /// Verification provider whose entry in the result's verification map is set
+  library::Provider provider;
+
+  /// Bytes of host memory held by the verification until it completes
+  size_t bytes;
+
+  /// Verifies the result
+  std::function<Disposition()> verify;
+};
+
+using DeferredVerificationVector = std::vector<DeferredVerification>;
+
+/// Sets the disposition of a verified result to the worst outcome of its verification providers
+void update_disposition(PerformanceResult &result);
+
+/// Runs deferred verifications on a pool of worker threads and reports results in the order they
+/// were submitted, once all their verifications have completed
+class VerificationPipeline {
+public:
+
+  /// Reports the results of an operation on the given problem
+  using ReportFunction = std::function<void(PerformanceResultVector const &, size_t)>;
+
+  /// Starts thread_count workers. Submitting waits while queued verifications hold more than
+  /// capacity bytes.
+  VerificationPipeline(int thread_count, size_t capacity, ReportFunction report);
+
+  /// Completes queued verifications and stops the workers
+  ~VerificationPipeline();
+
+  /// Queues the results of an operation along with their deferred verifications, and reports
+  /// results that are no longer awaiting verification. Called from a single thread.
+  void submit(
+    PerformanceResultVector const &results,
+    size_t problem_index,
+    DeferredVerificationVector verifications);
+
+  /// Waits for all queued verifications and reports the remaining results
+  void finish();
+
+private:
+
+  /// Results of an operation
+  struct Entry {
+    PerformanceResultVector results;
+
+    /// Index of the problem in the report
+    size_t problem_index;
+
+    /// Number of verifications not yet completed
+    size_t pending;
+  };
+
+  /// Verification queued for a worker
+  struct Task {
+    std::shared_ptr<Entry> entry;
+    DeferredVerification verification;
+  };
+
+  /// Worker thread body
+  void work_();
+
+  /// Reports completed entries at the front of the queue
+  void report_completed_(std::unique_lock<std::mutex> &lock);
+
+  size_t capacity_;
+
+  ReportFunction report_;
+
+  /// Bytes held by queued verifications
+  size_t queued_bytes_;
+
+  bool stopping_;
+
+  /// Results in submission order
+  std::deque<std::shared_ptr<Entry>> entries_;
+
+  /// Verifications not yet started
+  std::deque<Task> tasks_;
+
+  std::mutex mutex_;
+  std::condition_variable task_queued_;
+  std::condition_variable task_completed_;
+
+  std::vector<std::thread> workers_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
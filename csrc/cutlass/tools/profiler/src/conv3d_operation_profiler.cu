@@ -37,11 +37,13 @@
 #include <stdexcept>
 #include <iomanip>
 #include <ios>
+#include <memory>
 
 #include "cutlass/core_io.h"
 
 #include "cutlass/profiler/conv3d_operation_profiler.h"
 #include "cutlass/profiler/gpu_timer.h"
+#include "cutlass/profiler/host_timer.h"
 /////////////////////////////////////////////////////////////////////////////////////////////////
 using namespace cutlass::library;
 
@@ -120,7 +122,11 @@ void Conv3dOperationProfiler::print_examples(std::ostream &out) const {
             " --n=32 --d=16 --h=14 --w=14 --c=8 --k=64 --t=3 --r=3 --s=3"
             " --pad_d=1 --pad_h=1 --pad_w=1"
             " --stride_d=1 --stride::h=1 --stride::w=1"
-            " --dilation_d=1 --dilation::h=1 --dilation::w=1\n\n";
+            " --dilation_d=1 --dilation::h=1 --dilation::w=1\n\n"
+
+      << "Profile convolutions executed on the host, as done by default when no CUDA device is present:\n"
+      << " $ cutlass_profiler --operation=Conv3d --conv_kind=fprop"
+            " --n=2 --d=8 --h=14 --w=14 --c=32 --k=32 --t=3 --r=3 --s=3 --providers=cpu\n\n";
 }
 
 #if 0
@@ -456,6 +462,12 @@ Status Conv3dOperationProfiler::initialize_configuration(
 
   // initialize reduction operation for parallel splitKMode not supported for conv3d
   if(conv_workspace_.configuration.split_k_mode == conv::SplitKMode::kParallel) {
+
+    // The reduction runs on the device
+    if (operation_desc.provider == library::Provider::kHost) {
+      return Status::kErrorNotSupported;
+    }
+
     if(!initialize_reduction_configuration_(options, report, device_context, operation, problem_space, problem)) {
       return Status::kErrorInternal;
     }
@@ -473,7 +485,7 @@ void Conv3dOperationProfiler::initialize_result_(
   library::ConvDescription const &operation_desc,
   ProblemSpace const &problem_space) {
 
-  result.provider = library::Provider::kCUTLASS;
+  result.provider = operation_desc.provider;
   result.disposition = Disposition::kNotRun;
   result.status = Status::kSuccess;
   result.operation_name = operation_desc.name;
@@ -597,15 +609,16 @@ bool Conv3dOperationProfiler::initialize_reduction_configuration_(
 #if 0// debug print to check which reduction instance is selected
     std::cout << reduction_key << "\n";
 #endif
-  auto reduction_it = Singleton::get().operation_table.reduction_operations.find(reduction_key);
+  library::Operation const *reduction_op =
+    Singleton::get().operation_table.find_reduction_operation(reduction_key);
 
-  if(reduction_it == Singleton::get().operation_table.reduction_operations.end()) {
+  if(!reduction_op) {
 
     return false;
   }    
 
   // initialize reduction operation required for parallel split-k conv2d operator
-  reduction_op_ = reduction_it->second;
+  reduction_op_ = reduction_op;
 
   // reduction operation found and initialized
   return true;
@@ -709,7 +722,7 @@ Status Conv3dOperationProfiler::initialize_workspace(
   //
   Status status = Status::kSuccess;
 
-  if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+  if (options.profiling.provider_enabled(operation_desc.provider)) {
 
     if (options.execution_mode != ExecutionMode::kDryRun) {
 
@@ -717,6 +730,7 @@ Status Conv3dOperationProfiler::initialize_workspace(
       conv_workspace_.host_workspace.resize(workspace_size, 0);
 
       workspace_size = underlying_operation->get_device_workspace_size(&conv_workspace_.configuration);
+      conv_workspace_.device_workspace.set_host_resident(device_context.host_resident());
       conv_workspace_.device_workspace.reset(library::NumericTypeID::kU8, workspace_size);
 
       status = underlying_operation->initialize(
@@ -747,7 +761,7 @@ Status Conv3dOperationProfiler::initialize_workspace(
     // If CUTLASS is enabled, generate a result for it
     //
     results_.push_back(model_result_);
-    results_.back().provider = library::Provider::kCUTLASS;
+    results_.back().provider = operation_desc.provider;
     results_.back().op_kind = library::OperationKind::kConv3d;
     results_.back().disposition = Disposition::kNotRun;
 
@@ -770,7 +784,7 @@ bool Conv3dOperationProfiler::verify_cutlass(
   ProblemSpace const &problem_space,
   ProblemSpace::Problem const &problem) {
 
-  if (!options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+  if (!options.profiling.provider_enabled(operation->description().provider)) {
     return true;
   }
 
@@ -778,7 +792,7 @@ bool Conv3dOperationProfiler::verify_cutlass(
     return true;
   }
 
-  cudaError_t result;
+  bool host_resident = device_context.host_resident();
 
   // Initialize structure containing Conv arguments
   set_cutlass_operator_arguments_();
@@ -832,10 +846,12 @@ bool Conv3dOperationProfiler::verify_cutlass(
   }
 
   // Synchronize before running device reference
-  result = cudaDeviceSynchronize();
-  if (result != cudaSuccess) {
-    results_.back().disposition = Disposition::kFailed;
-    return false;
+  if (!host_resident) {
+    cudaError_t result = cudaDeviceSynchronize();
+    if (result != cudaSuccess) {
+      results_.back().disposition = Disposition::kFailed;
+      return false;
+    }
   }
 
   // CUTLASS op ran the but not yet verified against any verification provider
@@ -859,7 +875,12 @@ bool Conv3dOperationProfiler::verify_cutlass(
       // Initialize reference data to the source data 
       conv_workspace_.Reference->copy_from_device(conv_workspace_.C->data());
 
-      if (status == Status::kSuccess) {
+      if (host_resident) {
+        // cuDNN cannot read tensors in host memory
+        results_.back().verification_map[library::Provider::kCUDNN] = Disposition::kNotSupported;
+      }
+
+      else if (status == Status::kSuccess) {
         // call cudnn verification if supported
         verify_with_cudnn_(
           options,
@@ -953,9 +974,9 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
     std::cout << conv_key << "\n";
 #endif
 
-  auto operators_it = Singleton::get().operation_table.conv3d_operations.find(conv_key);
+  library::ConvOperationVectorMap const *operators = Singleton::get().operation_table.find_conv3d_operations(conv_key);
 
-  if(operators_it == Singleton::get().operation_table.conv3d_operations.end()) {
+  if(!operators) {
 
     results_.back().verification_map[library::Provider::kReferenceHost] = Disposition::kNotRun;
     return true;
@@ -963,9 +984,9 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
 
   // conv3d host reference minimum cc is 0 (CPU) and no iterator algorithm
   library::ConvPreferenceKey preference_key(0, library::IteratorAlgorithmID::kNone);
-  auto cc_it = operators_it->second.find(preference_key);
+  auto cc_it = operators->find(preference_key);
   
-  if(cc_it == operators_it->second.end()) {
+  if(cc_it == operators->end()) {
     results_.back().verification_map[library::Provider::kReferenceHost] = Disposition::kNotRun;
     return true;
   }
@@ -973,6 +994,73 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
   // host reference has only one instances in ConvOperationVectorMap
   library::Operation const *reference_op = cc_it->second[0];
 
+  //
+  // Verify on a worker thread while later operations are profiled
+  //
+  if (defer_verification_(options, device_context)) {
+
+    // The verification owns copies of every tensor and argument it reads
+    auto host_data = std::make_shared<std::vector<std::vector<uint8_t>>>(4);
+
+    (*host_data)[0].resize(conv_workspace_.A->bytes());
+    (*host_data)[1].resize(conv_workspace_.B->bytes());
+    (*host_data)[2].resize(conv_workspace_.C->bytes());
+    (*host_data)[3].resize(conv_workspace_.Computed->bytes());
+
+    conv_workspace_.A->copy_to_host((*host_data)[0].data());
+    conv_workspace_.B->copy_to_host((*host_data)[1].data());
+    conv_workspace_.C->copy_to_host((*host_data)[2].data());
+    conv_workspace_.Computed->copy_to_host((*host_data)[3].data());
+
+    size_t bytes = 0;
+    for (auto const &data : *host_data) {
+      bytes += data.size();
+    }
+
+    auto alpha = std::make_shared<std::vector<uint8_t>>(problem_.alpha);
+    auto beta = std::make_shared<std::vector<uint8_t>>(problem_.beta);
+
+    library::Conv3dConfiguration configuration = conv_workspace_.configuration;
+    library::NumericTypeID element_C = conv_desc.C.element;
+    int64_t count = conv_workspace_.Computed->batch_stride();
+
+    defer_verification_(
+      library::Provider::kReferenceHost,
+      bytes,
+      [&options, reference_op, host_data, alpha, beta, configuration, element_C, count]() -> Disposition {
+
+        std::vector<uint8_t> host_tensor_d((*host_data)[2]);
+
+        library::ConvArguments arguments;
+
+        arguments.A = (*host_data)[0].data();
+        arguments.B = (*host_data)[1].data();
+        arguments.C = (*host_data)[2].data();
+        arguments.D = host_tensor_d.data();
+        arguments.alpha = alpha->data();
+        arguments.beta = beta->data();
+        arguments.pointer_mode = library::ScalarPointerMode::kHost;
+
+        std::vector<uint8_t> host_workspace_reference_op(
+          reference_op->get_host_workspace_size(&configuration), 0);
+
+        reference_op->initialize(&configuration, host_workspace_reference_op.data());
+
+        if (reference_op->run(&arguments, host_workspace_reference_op.data()) != Status::kSuccess) {
+          return Disposition::kNotVerified;
+        }
+
+        return compare_host_tensors(
+          options,
+          element_C,
+          (*host_data)[3].data(),
+          host_tensor_d.data(),
+          count);
+      });
+
+    return true;
+  }
+
   //
   // Copy input tensors A, B, and C from device to host buffers
   //
@@ -1042,7 +1130,7 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
       device_context,
       options,
       static_cast<library::ConvDescription const &>(operation->description()),
-      library::Provider::kCUTLASS,
+      operation->description().provider,
       library::Provider::kReferenceHost);
   }
 
@@ -1076,12 +1164,12 @@ bool Conv3dOperationProfiler::profile(
   ProblemSpace::Problem const &problem) {
 
   
-  if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+  if (options.profiling.provider_enabled(operation->description().provider)) {
 
     set_cutlass_operator_arguments_();
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &conv_workspace_.arguments,
@@ -1123,14 +1211,34 @@ void Conv3dOperationProfiler::set_cutlass_operator_arguments_(int problem_idx) {
 
 /// Method to profile a CUTLASS Operation
 Status Conv3dOperationProfiler::profile_cutlass_(
-  double &runtime,
+  PerformanceResult &result,
   Options const &options,
   library::Operation const *operation,
   void *arguments,
   void *host_workspace,
   void *device_workspace) {
 
+  // Operations executed on the host are timed by the wall clock, which also keeps CUDA events
+  // from being created on machines without a device
+  if (operation->description().provider == library::Provider::kHost) {
+    HostTimer timer;
+    return profile_cutlass_(timer, result, options, operation, arguments, host_workspace, device_workspace);
+  }
+
   GpuTimer timer;
+  return profile_cutlass_(timer, result, options, operation, arguments, host_workspace, device_workspace);
+}
+
+/// Method to profile a CUTLASS Operation with a given timer
+template <typename Timer>
+Status Conv3dOperationProfiler::profile_cutlass_(
+  Timer &timer,
+  PerformanceResult &result,
+  Options const &options,
+  library::Operation const *operation,
+  void *arguments,
+  void *host_workspace,
+  void *device_workspace) {
 
   // initialize conv2d underlying operation to handle parallel reduction
   library::Operation const* underlying_operation = operation;
@@ -1181,20 +1289,11 @@ Status Conv3dOperationProfiler::profile_cutlass_(
     }
   }
   
-  //
-  // Initialize GPU timer
-  //
-
-  timer.start();
-
   //
   // Profiling loop
   //
 
-  int Iterations = options.profiling.iterations;
-
-  int iteration = 0;
-  for (; iteration < Iterations; ++iteration) {
+  return profile_iterations_(result, options, timer, [&](int iteration) {
 
     // Setup rotating workspace
     int problem_idx = (iteration % conv_workspace_.problem_count);
@@ -1202,7 +1301,7 @@ Status Conv3dOperationProfiler::profile_cutlass_(
     set_cutlass_operator_arguments_(problem_idx);
  
     // Run underlying conv2d operation
-    status = underlying_operation->run(
+    Status status = underlying_operation->run(
       arguments,
       host_workspace,
       device_workspace);
@@ -1215,24 +1314,8 @@ Status Conv3dOperationProfiler::profile_cutlass_(
         nullptr);
     }
 
-    if (status != Status::kSuccess) {
-      return status;
-    }
-  }
-
-  //
-  // Wait for completion
-  //
-
-  timer.stop_and_wait();
-
-  //
-  // Update performance result
-  //
-  
-  runtime = timer.duration(iteration);
-
-  return status;
+    return status;
+  });
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1330,7 +1413,7 @@ bool Conv3dOperationProfiler::verify_with_cudnn_(
         device_context,
         options,
         conv_desc,
-        library::Provider::kCUTLASS,
+        conv_desc.provider,
         library::Provider::kCUDNN);
     }
   }
@@ -35,6 +35,8 @@
 #include <iostream>
 #include <stdexcept>
 
+#include "cutlass/library/reference_cache.h"
+
 // Profiler includes
 #include "cutlass/profiler/cutlass_profiler.h"
 #include "cutlass/profiler/gemm_operation_profiler.h"
@@ -73,6 +75,12 @@ CutlassProfiler::CutlassProfiler(
   operation_profilers_.emplace_back(new TrmmOperationProfiler(options));
 
   operation_profilers_.emplace_back(new SymmOperationProfiler(options));
+
+  library::ReferenceCache &reference_cache = library::ReferenceCache::get();
+
+  reference_cache.set_enabled(options.verification.reference_cache);
+  reference_cache.set_capacity(options.verification.reference_cache_capacity << 20);
+  reference_cache.set_directory(options.verification.reference_cache_dir);
 }
 
 CutlassProfiler::~CutlassProfiler() {
@@ -130,6 +138,10 @@ int CutlassProfiler::operator()() {
     // Enumerates all operations
     enumerate_();
   }
+  else if (options_.execution_mode == ExecutionMode::kMerge) {
+    // Merges reports of sweep shards
+    return merge_();
+  }
   return 0;
 }
 
@@ -140,9 +152,48 @@ void CutlassProfiler::enumerate_() {
 
 }
 
+/// Returns a filter restricting the operations the library constructs to those the options
+/// select for profiling
+library::ManifestFilter CutlassProfiler::manifest_filter_() const {
+
+  library::ManifestFilter filter;
+
+  // Parallel split-K reductions are kernels of their own kind
+  if (options_.operation_kind != library::OperationKind::kInvalid) {
+    filter.kinds = {options_.operation_kind, library::OperationKind::kReduction};
+  }
+
+  if (!options_.device.host_only()) {
+    filter.compute_capability = options_.device.compute_capability();
+  }
+
+  // Parallel split-K GEMMs run a GEMM writing the accumulator type, which the kernel filters may
+  // exclude, so kernels are filtered by name only after the manifest is initialized
+  bool parallel_split_k = false;
+  for (char const *arg : {"split_k_mode", "split-k-mode"}) {
+
+    std::vector<std::string> split_k_modes;
+    options_.cmdline.get_cmd_line_arguments(arg, split_k_modes);
+
+    for (auto const &mode : split_k_modes) {
+      parallel_split_k = parallel_split_k || mode.find("parallel") != std::string::npos;
+    }
+  }
+
+  if (!parallel_split_k) {
+    filter.names = options_.operation_names;
+    filter.excluded_names = options_.excluded_operation_names;
+  }
+
+  return filter;
+}
+
 /// Profiles all operations
 int CutlassProfiler::profile_() {
 
+  // Operations the options do not select are never constructed
+  library::Singleton::set_filter(manifest_filter_());
+
   int result = 0;
   DeviceContext device_context;
   // For all profilers
@@ -162,6 +213,31 @@ int CutlassProfiler::profile_() {
   return result;
 }
 
+/// Merges reports written by the shards of a sweep
+int CutlassProfiler::merge_() {
+
+  if (options_.report.merge_inputs.empty() || options_.report.output_path.empty()) {
+    std::cerr << "Merging reports requires --merge-inputs and --output." << std::endl;
+    return 1;
+  }
+
+  std::string error;
+
+  int rows = merge_reports(options_.report.merge_inputs, options_.report.output_path, &error);
+
+  if (rows < 0) {
+    std::cerr << "Could not merge reports: " << error << std::endl;
+    return 1;
+  }
+
+  if (options_.report.verbose) {
+    std::cout << "Merged " << rows << " results from " << options_.report.merge_inputs.size()
+      << " reports into '" << options_.report.output_path << "'" << std::endl;
+  }
+
+  return 0;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Prints all options
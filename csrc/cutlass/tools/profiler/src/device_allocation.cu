@@ -33,10 +33,12 @@
 */
 
 #include <cstring>
+#include <new>
 
 #include "cutlass/numeric_types.h"
 #include "cutlass/layout/matrix.h"
 #include "cutlass/layout/tensor.h"
+#include "cutlass/relatively_equal.h"
 
 #include "cutlass/util/reference/device/tensor_compare.h"
 #include "cutlass/util/reference/device/tensor_fill.h"
@@ -284,11 +286,49 @@ size_t DeviceAllocation::construct_layout(
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Alignment of allocations in host memory
+static std::align_val_t const kHostAllocationAlignment = std::align_val_t(128);
+
+/// Allocates pointer_ in device or host memory
+void DeviceAllocation::allocate_(size_t bytes) {
+
+  pointer_ = nullptr;
+
+  if (!bytes) {
+    return;
+  }
+
+  if (host_resident_) {
+    pointer_ = ::operator new(bytes, kHostAllocationAlignment);
+    return;
+  }
+
+  cudaError_t result = cudaMalloc((void **)&pointer_, bytes);
+  if (result != cudaSuccess) {
+    pointer_ = nullptr;
+    throw std::bad_alloc();
+  }
+}
+
+/// Frees pointer_
+void DeviceAllocation::free_() {
+  if (pointer_) {
+    if (host_resident_) {
+      ::operator delete(pointer_, kHostAllocationAlignment);
+    }
+    else {
+      cudaFree(pointer_);
+    }
+  }
+  pointer_ = nullptr;
+}
+
 DeviceAllocation::DeviceAllocation(): 
   type_(library::NumericTypeID::kInvalid), 
   batch_stride_(0),
   capacity_(0), 
   pointer_(nullptr),
+  host_resident_(false),
   layout_(library::LayoutTypeID::kUnknown),
   batch_count_(1) {
 
@@ -296,18 +336,19 @@ DeviceAllocation::DeviceAllocation():
 
 DeviceAllocation::DeviceAllocation(
   library::NumericTypeID type, 
-  size_t capacity
+  size_t capacity,
+  bool host_resident
 ):
   type_(type), batch_stride_(capacity), capacity_(capacity), pointer_(nullptr), 
-  layout_(library::LayoutTypeID::kUnknown), batch_count_(1) {
+  host_resident_(host_resident), layout_(library::LayoutTypeID::kUnknown), batch_count_(1) {
 
-  cudaError_t result = cudaMalloc((void **)&pointer_, bytes(type, capacity));
-
-  if (result != cudaSuccess) {
+  try {
+    allocate_(bytes(type, capacity));
+  }
+  catch (std::bad_alloc const &) {
     type_ = library::NumericTypeID::kInvalid;
     capacity_ = 0;
-    pointer_ = nullptr;
-    throw std::bad_alloc();
+    throw;
   }
 }
 
@@ -316,23 +357,33 @@ DeviceAllocation::DeviceAllocation(
   library::LayoutTypeID layout_id, 
   std::vector<int> const &extent, 
   std::vector<int64_t> const &stride,
-  int batch_count
+  int batch_count,
+  bool host_resident
 ):
-  type_(type), batch_stride_(size_t(0)), capacity_(size_t(0)), pointer_(nullptr), batch_count_(1) {
+  type_(type), batch_stride_(size_t(0)), capacity_(size_t(0)), pointer_(nullptr),
+  host_resident_(host_resident), batch_count_(1) {
 
   reset(type, layout_id, extent, stride, batch_count);
 }
 
 DeviceAllocation::~DeviceAllocation() {
-  if (pointer_) {
-    cudaFree(pointer_);
-  }
+  free_();
+}
+
+/// Frees memory and selects whether later allocations reside in host memory
+DeviceAllocation &DeviceAllocation::set_host_resident(bool host_resident) {
+  reset();
+  host_resident_ = host_resident;
+  return *this;
+}
+
+/// Returns true if the allocation resides in host memory
+bool DeviceAllocation::host_resident() const {
+  return host_resident_;
 }
 
 DeviceAllocation &DeviceAllocation::reset() {
-  if (pointer_) {
-    cudaFree(pointer_);
-  }
+  free_();
 
   type_ = library::NumericTypeID::kInvalid;
   batch_stride_ = 0;
@@ -355,10 +406,7 @@ DeviceAllocation &DeviceAllocation::reset(library::NumericTypeID type, size_t ca
   batch_stride_ = capacity;
   capacity_ = capacity;
 
-  cudaError_t result = cudaMalloc((void **)&pointer_, bytes(type_, capacity_));
-  if (result != cudaSuccess) {
-    throw std::bad_alloc();
-  }
+  allocate_(bytes(type_, capacity_));
 
   layout_ = library::LayoutTypeID::kUnknown;
   stride_.clear();
@@ -398,10 +446,7 @@ DeviceAllocation &DeviceAllocation::reset(
 
   capacity_ = batch_stride_ * batch_count_;
 
-  cudaError_t result = cudaMalloc((void **)&pointer_, bytes(type, capacity_));
-  if (result != cudaSuccess) {
-    throw std::bad_alloc();
-  }
+  allocate_(bytes(type, capacity_));
 
   std::memcpy(tensor_ref_buffer_.data(), &pointer_, sizeof(pointer_));
 
@@ -469,6 +514,11 @@ void DeviceAllocation::copy_from_device(void const *ptr) {
     return;
   }
 
+  if (host_resident_) {
+    std::memcpy(data(), ptr, bytes());
+    return;
+  }
+
   cudaError_t result = cudaMemcpy(data(), ptr, bytes(), cudaMemcpyDeviceToDevice);
   if (result != cudaSuccess) {
     throw std::runtime_error("Failed device-to-device copy");
@@ -484,6 +534,11 @@ void DeviceAllocation::copy_from_host(void const *ptr) {
     return;
   }
 
+  if (host_resident_) {
+    std::memcpy(data(), ptr, bytes());
+    return;
+  }
+
   cudaError_t result = cudaMemcpy(data(), ptr, bytes(), cudaMemcpyHostToDevice);
   if (result != cudaSuccess) {
     throw std::runtime_error("Failed host-to-device copy");
@@ -499,6 +554,11 @@ void DeviceAllocation::copy_to_host(void *ptr) {
     return;
   }
 
+  if (host_resident_) {
+    std::memcpy(ptr, data(), bytes());
+    return;
+  }
+
   cudaError_t result = cudaMemcpy(ptr, data(), bytes(), cudaMemcpyDeviceToHost);
   if (result != cudaSuccess) {
     throw std::runtime_error("Failed device-to-host copy");
@@ -517,6 +577,11 @@ void DeviceAllocation::initialize_random_device(int seed, Distribution dist) {
     throw std::runtime_error("Attempting to initialize invalid allocation.");
   }
 
+  if (host_resident_) {
+    initialize_random_host(seed, dist);
+    return;
+  }
+
   // Instantiate calls to CURAND here. This file takes a long time to compile for
   // this reason.
 
@@ -950,6 +1015,11 @@ void DeviceAllocation::initialize_sequential_device(Distribution dist) {
     throw std::runtime_error("Attempting to initialize invalid allocation.");
   }
 
+  if (host_resident_) {
+    initialize_sequential_host(dist);
+    return;
+  }
+
   switch (type_) {
   case library::NumericTypeID::kFE4M3:
     cutlass::reference::device::BlockFillSequential<cutlass::float_e4m3_t>(
@@ -1409,6 +1479,11 @@ void DeviceAllocation::initialize_random_sparsemeta_device(int seed, int MetaSiz
     throw std::runtime_error("Attempting to initialize invalid allocation.");
   }
 
+  if (host_resident_) {
+    initialize_random_sparsemeta_host(seed, MetaSizeInBits);
+    return;
+  }
+
   // Instantiate calls to CURAND here. This file takes a long time to compile for
   // this reason.
 
@@ -1837,6 +1912,137 @@ bool DeviceAllocation::block_compare_relatively_equal(
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Returns true if two blocks in host memory have exactly the same value
+template <typename Element>
+bool host_block_compare_equal(void const *ptr_A, void const *ptr_B, size_t capacity) {
+
+  Element const *block_A = static_cast<Element const *>(ptr_A);
+  Element const *block_B = static_cast<Element const *>(ptr_B);
+
+  for (size_t i = 0; i < capacity; ++i) {
+    if (!(block_A[i] == block_B[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Returns true if two blocks in host memory have approximately the same value
+template <typename Element>
+bool host_block_compare_relatively_equal(
+  void const *ptr_A, 
+  void const *ptr_B, 
+  size_t capacity,
+  double epsilon,
+  double nonzero_floor) {
+
+  Element const *block_A = static_cast<Element const *>(ptr_A);
+  Element const *block_B = static_cast<Element const *>(ptr_B);
+
+  for (size_t i = 0; i < capacity; ++i) {
+    if (!relatively_equal(
+      block_A[i], block_B[i], static_cast<Element>(epsilon), static_cast<Element>(nonzero_floor))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+/// Returns true if two blocks in host memory have exactly the same value
+bool DeviceAllocation::block_compare_equal_host(
+  library::NumericTypeID numeric_type, 
+  void const *ptr_A, 
+  void const *ptr_B, 
+  size_t capacity) {
+
+  switch (numeric_type) {
+  case library::NumericTypeID::kFE4M3: return host_block_compare_equal<float_e4m3_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kFE5M2: return host_block_compare_equal<float_e5m2_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kF16: return host_block_compare_equal<half_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kBF16: return host_block_compare_equal<bfloat16_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kTF32: return host_block_compare_equal<tfloat32_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kF32: return host_block_compare_equal<float>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kF64: return host_block_compare_equal<double>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kCF16: return host_block_compare_equal<complex<half_t>>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kCBF16: return host_block_compare_equal<complex<bfloat16_t>>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kCTF32: return host_block_compare_equal<complex<tfloat32_t>>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kCF32: return host_block_compare_equal<complex<float>>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kCF64: return host_block_compare_equal<complex<double>>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kS8: return host_block_compare_equal<int8_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kS16: return host_block_compare_equal<int16_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kS32: return host_block_compare_equal<int32_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kS64: return host_block_compare_equal<int64_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kU8: return host_block_compare_equal<uint8_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kU16: return host_block_compare_equal<uint16_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kU32: return host_block_compare_equal<uint32_t>(ptr_A, ptr_B, capacity);
+  case library::NumericTypeID::kU64: return host_block_compare_equal<uint64_t>(ptr_A, ptr_B, capacity);
+
+  // Sub-byte elements are packed, so equal blocks have equal bytes
+  case library::NumericTypeID::kB1:
+  case library::NumericTypeID::kS2:
+  case library::NumericTypeID::kS4:
+  case library::NumericTypeID::kU2:
+  case library::NumericTypeID::kU4:
+    return !std::memcmp(ptr_A, ptr_B, bytes(numeric_type, capacity));
+
+  default:
+    throw std::runtime_error(std::string("Unsupported numeric type: ") + to_string(numeric_type));
+  }
+}
+
+/// Returns true if two blocks in host memory have approximately the same value
+bool DeviceAllocation::block_compare_relatively_equal_host(
+  library::NumericTypeID numeric_type, 
+  void const *ptr_A, 
+  void const *ptr_B, 
+  size_t capacity,
+  double epsilon,
+  double nonzero_floor) {
+
+  switch (numeric_type) {
+  case library::NumericTypeID::kFE4M3:
+    return host_block_compare_relatively_equal<float_e4m3_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kFE5M2:
+    return host_block_compare_relatively_equal<float_e5m2_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kF16:
+    return host_block_compare_relatively_equal<half_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kBF16:
+    return host_block_compare_relatively_equal<bfloat16_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kTF32:
+    return host_block_compare_relatively_equal<tfloat32_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kF32:
+    return host_block_compare_relatively_equal<float>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kF64:
+    return host_block_compare_relatively_equal<double>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kS8:
+    return host_block_compare_relatively_equal<int8_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kS16:
+    return host_block_compare_relatively_equal<int16_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kS32:
+    return host_block_compare_relatively_equal<int32_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kS64:
+    return host_block_compare_relatively_equal<int64_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kU8:
+    return host_block_compare_relatively_equal<uint8_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kU16:
+    return host_block_compare_relatively_equal<uint16_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kU32:
+    return host_block_compare_relatively_equal<uint32_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+  case library::NumericTypeID::kU64:
+    return host_block_compare_relatively_equal<uint64_t>(ptr_A, ptr_B, capacity, epsilon, nonzero_floor);
+
+  // As with block_compare_relatively_equal(), complex and sub-byte elements require bitwise equality.
+  default:
+    return block_compare_equal_host(numeric_type, ptr_A, ptr_B, capacity);
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Permits copying dynamic vectors into static-length vectors 
 template <typename TensorCoord, int Rank>
 struct vector_to_coord {
@@ -1913,9 +2119,16 @@ static void write_tensor_csv_static_tensor_view(
     throw std::runtime_error("Unexpected capacity to equal.");
   }
 
-  host_tensor.copy_in_device_to_host(
-    static_cast<Element const *>(allocation.data()), 
-    allocation.batch_stride());
+  if (allocation.host_resident()) {
+    host_tensor.copy_in_host_to_host(
+      static_cast<Element const *>(allocation.data()), 
+      allocation.batch_stride());
+  }
+  else {
+    host_tensor.copy_in_device_to_host(
+      static_cast<Element const *>(allocation.data()), 
+      allocation.batch_stride());
+  }
 
   TensorViewWrite(out, host_tensor.host_view());
 
@@ -2162,6 +2375,11 @@ static void tensor_fill(DeviceAllocation &allocation, Element val = Element()) {
 /// Fills a tensor uniformly with a value (most frequently used to clear the tensor)
 void DeviceAllocation::fill_device(double val = 0.0) {
 
+  if (host_resident_) {
+    fill_host(val);
+    return;
+  }
+
   switch (this->type()) {
   case library::NumericTypeID::kFE4M3:
     tensor_fill<float_e4m3_t>(*this, static_cast<float_e4m3_t>(val));
@@ -45,7 +45,7 @@ DeviceAllocation *DeviceContext::allocate_block(
   library::NumericTypeID type, 
   size_t capacity) {
 
-  device_memory_.emplace_back(type, capacity);
+  device_memory_.emplace_back(type, capacity, host_resident_);
   DeviceAllocation *allocation = &device_memory_.back();
   
   allocations_[name] = allocation;
@@ -61,7 +61,7 @@ DeviceAllocation *DeviceContext::allocate_tensor(
   std::vector<int64_t> const &stride,
   int batch_count) {
 
-  device_memory_.emplace_back(type, layout_id, extent, stride, batch_count);
+  device_memory_.emplace_back(type, layout_id, extent, stride, batch_count, host_resident_);
   DeviceAllocation *allocation = &device_memory_.back();
   
   allocations_[name] = allocation;
@@ -216,6 +216,16 @@ DeviceAllocation &DeviceContext::at(std::string const &name) {
   return *allocations_.at(name);
 }
 
+/// Selects whether new allocations reside in host memory
+void DeviceContext::set_host_resident(bool host_resident) {
+  host_resident_ = host_resident;
+}
+
+/// Returns true if new allocations reside in host memory
+bool DeviceContext::host_resident() const {
+  return host_resident_;
+}
+
 size_t DeviceContext::size() const {
   return allocations_.size();
 }
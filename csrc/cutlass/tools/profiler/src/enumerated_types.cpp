@@ -49,7 +49,8 @@ ExecutionMode_enumerants[] = {
   {"dry_run", "Dry run", ExecutionMode::kDryRun},
   {"dry", "dry run", ExecutionMode::kDryRun},
   {"trace", "Trace", ExecutionMode::kTrace},
-  {"enumerate", "Enumerate", ExecutionMode::kEnumerate}
+  {"enumerate", "Enumerate", ExecutionMode::kEnumerate},
+  {"merge", "Merge", ExecutionMode::kMerge}
 };
 
 /// Converts a ExecutionMode enumerant to a string
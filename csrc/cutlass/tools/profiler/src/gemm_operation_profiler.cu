@@ -43,6 +43,7 @@
 #include "cutlass/profiler/cublas_helpers.h"
 #include "cutlass/profiler/gemm_operation_profiler.h"
 #include "cutlass/profiler/gpu_timer.h"
+#include "cutlass/profiler/host_timer.h"
 #include "cutlass/library/singleton.h"
 #include "cutlass/library/library.h"
 #include "cutlass/library/handle.h"
@@ -127,7 +128,10 @@ void GemmOperationProfiler::print_examples(std::ostream &out) const {
     << "   --n=8,56,120,136,256,264,512,520,1024,1032,4096,8192,16384 \\ \n"
     << "   --k=8,16,32,64,128,256,288,384,504,512,520 \\ \n"
     << "   --beta=0,1,2 --profiling-iterations=1 \\ \n"
-    << "   --providers=cutlass --output=functional-test.csv\n\n";
+    << "   --providers=cutlass --output=functional-test.csv\n\n"
+
+    << "Profile GEMMs executed on the host, as done by default when no CUDA device is present:\n"
+    << " $ cutlass_profiler --operation=Gemm --m=512 --n=512 --k=512 --providers=cpu\n\n";
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -386,6 +390,12 @@ Status GemmOperationProfiler::initialize_configuration(
   gemm_workspace_.arguments.raster_order = problem_.raster_order;
   // initialize reduction operation for parallel splitKMode
   if (problem_.split_k_mode == library::SplitKMode::kParallel) {
+
+    // The reduction runs on the device
+    if (operation_desc.provider == library::Provider::kHost) {
+      return Status::kErrorNotSupported;
+    }
+
     if (!initialize_reduction_configuration_(operation, problem)) {
       return Status::kErrorInternal;
     }
@@ -403,7 +413,7 @@ void GemmOperationProfiler::initialize_result_(
   library::GemmDescription const &operation_desc,
   ProblemSpace const &problem_space) {
 
-  result.provider = library::Provider::kCUTLASS;
+  result.provider = operation_desc.provider;
   result.disposition = Disposition::kNotRun;
   result.status = Status::kSuccess;
   result.operation_name = operation_desc.name;
@@ -451,14 +461,15 @@ bool GemmOperationProfiler::initialize_reduction_configuration_(
     gemm_desc.element_epilogue                                          // element compute
   );
 
-  auto reduction_it = library::Singleton::get().operation_table.reduction_operations.find(reduction_key);
+  library::Operation const *reduction_op =
+    library::Singleton::get().operation_table.find_reduction_operation(reduction_key);
 
-  if (reduction_it == library::Singleton::get().operation_table.reduction_operations.end()) {
+  if (!reduction_op) {
     return false;
   }
 
   // initialize reduction operation required for parallel split-k operator
-  reduction_op_ = reduction_it->second;
+  reduction_op_ = reduction_op;
 
   // reduction operation found and initialized
   return true;
@@ -576,7 +587,7 @@ Status GemmOperationProfiler::initialize_workspace(
   //
   Status status = Status::kSuccess;
 
-  if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+  if (options.profiling.provider_enabled(operation_desc.provider)) {
 
     if (options.execution_mode != ExecutionMode::kDryRun) {
       uint64_t workspace_size = underlying_operation->get_host_workspace_size(&gemm_workspace_.configuration);
@@ -584,6 +595,7 @@ Status GemmOperationProfiler::initialize_workspace(
 
       workspace_size = underlying_operation->get_device_workspace_size(&gemm_workspace_.configuration,
                                                             &gemm_workspace_.arguments);
+      gemm_workspace_.device_workspace.set_host_resident(device_context.host_resident());
       gemm_workspace_.device_workspace.reset(library::NumericTypeID::kU8, workspace_size);
 
       status = underlying_operation->initialize(
@@ -613,7 +625,7 @@ Status GemmOperationProfiler::initialize_workspace(
     // If CUTLASS is enabled, generate a result for it
     //
     results_.push_back(model_result_);
-    results_.back().provider = library::Provider::kCUTLASS;
+    results_.back().provider = operation_desc.provider;
     results_.back().op_kind = library::OperationKind::kGemm;
     results_.back().disposition = Disposition::kNotRun;
 
@@ -635,7 +647,7 @@ bool GemmOperationProfiler::verify_cutlass(
   ProblemSpace const &problem_space,
   ProblemSpace::Problem const &problem) {
 
-  if (!options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+  if (!options.profiling.provider_enabled(operation->description().provider)) {
     return true;
   }
 
@@ -643,6 +655,8 @@ bool GemmOperationProfiler::verify_cutlass(
     return true;
   }
 
+  bool host_resident = device_context.host_resident();
+
   // Initialize structure containing GEMM arguments
   gemm_workspace_.arguments.A = gemm_workspace_.A->data();
   gemm_workspace_.arguments.B = gemm_workspace_.B->data();
@@ -706,10 +720,12 @@ bool GemmOperationProfiler::verify_cutlass(
     }
   }
 
-  cudaError_t result = cudaDeviceSynchronize();
-  if (result != cudaSuccess) {
-    results_.back().disposition = Disposition::kFailed;
-    return false;
+  if (!host_resident) {
+    cudaError_t result = cudaDeviceSynchronize();
+    if (result != cudaSuccess) {
+      results_.back().disposition = Disposition::kFailed;
+      return false;
+    }
   }
 
   // CUTLASS op ran the but not yet verified against any verification provider
@@ -727,7 +743,7 @@ bool GemmOperationProfiler::verify_cutlass(
       // Guard against unsupported cases
       auto const & gemm_desc = static_cast<library::GemmDescription const &>(operation->description());
 
-      if (cublas_satisfies(gemm_desc) == Status::kSuccess) {
+      if (!host_resident && cublas_satisfies(gemm_desc) == Status::kSuccess) {
 
         // call cublas verification if supported
         verify_with_cublas_(
@@ -895,7 +911,7 @@ bool GemmOperationProfiler::verify_with_cublas_(
         device_context,
         options,
         gemm_desc,
-        library::Provider::kCUTLASS,
+        gemm_desc.provider,
         library::Provider::kCUBLAS);
     }
   }
@@ -936,6 +952,12 @@ bool GemmOperationProfiler::verify_with_reference_(
       continue;
     }
 
+    // Device references cannot read tensors in host memory
+    if (provider == library::Provider::kReferenceDevice && device_context.host_resident()) {
+      results_.back().verification_map[provider] = Disposition::kNotSupported;
+      continue;
+    }
+
     void *ptr_A = gemm_workspace_.A->data();
     void *ptr_B = gemm_workspace_.B->data();
     void *ptr_C = gemm_workspace_.C->data();
@@ -964,6 +986,18 @@ bool GemmOperationProfiler::verify_with_reference_(
 
       host_data_D.resize(gemm_workspace_.Reference->bytes());
       ptr_D = host_data_D.data();
+
+      if (defer_verification_(options, device_context)) {
+        defer_host_reference_(
+          options,
+          gemm_desc,
+          element_A,
+          element_B,
+          std::move(host_data_A),
+          std::move(host_data_B),
+          std::move(host_data_C));
+        continue;
+      }
     }
 
     //
@@ -1043,7 +1077,7 @@ bool GemmOperationProfiler::verify_with_reference_(
         device_context,
         options,
         gemm_desc,
-        library::Provider::kCUTLASS,
+        gemm_desc.provider,
         provider);
     }
   }
@@ -1051,6 +1085,104 @@ bool GemmOperationProfiler::verify_with_reference_(
   return true;
 }
 
+/// Verifies the computed result against the host reference while later operations are profiled
+void GemmOperationProfiler::defer_host_reference_(
+  Options const &options,
+  library::GemmDescription const &gemm_desc,
+  library::NumericTypeID element_A,
+  library::NumericTypeID element_B,
+  std::vector<uint8_t> host_data_A,
+  std::vector<uint8_t> host_data_B,
+  std::vector<uint8_t> host_data_C) {
+
+  // The verification owns copies of every tensor and argument it reads
+  auto host_data = std::make_shared<std::vector<std::vector<uint8_t>>>();
+
+  host_data->push_back(std::move(host_data_A));
+  host_data->push_back(std::move(host_data_B));
+  host_data->push_back(std::move(host_data_C));
+  host_data->emplace_back(gemm_workspace_.Computed->bytes());
+  gemm_workspace_.Computed->copy_to_host(host_data->back().data());
+
+  size_t bytes = 0;
+  for (auto const &data : *host_data) {
+    bytes += data.size();
+  }
+
+  GemmProblem problem = problem_;
+  library::GemmUniversalConfiguration configuration = gemm_workspace_.configuration;
+
+  int64_t batch_stride_A = gemm_workspace_.A->batch_stride();
+  int64_t batch_stride_B = gemm_workspace_.B->batch_stride();
+  int64_t batch_stride_C = gemm_workspace_.C->batch_stride();
+  int64_t batch_stride_D = gemm_workspace_.Reference->batch_stride();
+  int64_t count = gemm_workspace_.Computed->batch_stride();
+
+  defer_verification_(
+    library::Provider::kReferenceHost,
+    bytes,
+    [&options, gemm_desc, element_A, element_B, host_data, problem, configuration,
+      batch_stride_A, batch_stride_B, batch_stride_C, batch_stride_D, count]() -> Disposition {
+
+      std::vector<uint8_t> host_data_D(host_data->back().size());
+
+      library::Handle handle(nullptr, 0);
+
+      handle.set_provider(library::Provider::kReferenceHost);
+
+      Status status = handle.gemm_universal(
+        problem.mode,
+        configuration.problem_size.m(),
+        configuration.problem_size.n(),
+        configuration.problem_size.k(),
+        gemm_desc.tile_description.math_instruction.element_accumulator,
+        gemm_desc.element_epilogue,
+
+        problem.alpha.data(),
+
+        element_A,
+        gemm_desc.A.layout,
+        gemm_desc.transform_A,
+        (*host_data)[0].data(),
+        int(configuration.lda),
+
+        element_B,
+        gemm_desc.B.layout,
+        gemm_desc.transform_B,
+        (*host_data)[1].data(),
+        int(configuration.ldb),
+
+        problem.beta.data(),
+
+        gemm_desc.C.element,
+        gemm_desc.C.layout,
+        (*host_data)[2].data(),
+        int(configuration.ldc),
+
+        gemm_desc.D.element,
+        gemm_desc.D.layout,
+        host_data_D.data(),
+        int(configuration.ldd),
+
+        configuration.batch_count,
+        batch_stride_A,
+        batch_stride_B,
+        batch_stride_C,
+        batch_stride_D);
+
+      if (status != Status::kSuccess) {
+        return Disposition::kNotRun;
+      }
+
+      return compare_host_tensors(
+        options,
+        gemm_desc.D.element,
+        (*host_data)[3].data(),
+        host_data_D.data(),
+        count);
+    });
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Measures performance results
@@ -1062,7 +1194,7 @@ bool GemmOperationProfiler::profile(
   ProblemSpace const &problem_space,
   ProblemSpace::Problem const &problem) {
 
-  if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+  if (options.profiling.provider_enabled(operation->description().provider)) {
 
     // Initialize structure containing GEMM arguments
     gemm_workspace_.arguments.A = gemm_workspace_.A->data();
@@ -1091,7 +1223,7 @@ bool GemmOperationProfiler::profile(
     }
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &gemm_workspace_.arguments,
@@ -1106,14 +1238,35 @@ bool GemmOperationProfiler::profile(
 
 /// Method to profile a CUTLASS Operation
 Status GemmOperationProfiler::profile_cutlass_(
-  double &runtime,
+  PerformanceResult &result,
   Options const &options,
   library::Operation const *operation,
   void *arguments,
   void *host_workspace,
   void *device_workspace) {
 
+  // Operations executed on the host are timed by the wall clock, which also keeps CUDA events
+  // from being created on machines without a device
+  if (operation->description().provider == library::Provider::kHost) {
+    HostTimer timer;
+    return profile_cutlass_(timer, result, options, operation, arguments, host_workspace, device_workspace);
+  }
+
   GpuTimer timer;
+  return profile_cutlass_(timer, result, options, operation, arguments, host_workspace, device_workspace);
+}
+
+/// Method to profile a CUTLASS Operation with a given timer
+template <typename Timer>
+Status GemmOperationProfiler::profile_cutlass_(
+  Timer &timer,
+  PerformanceResult &result,
+  Options const &options,
+  library::Operation const *operation,
+  void *arguments,
+  void *host_workspace,
+  void *device_workspace) {
+
   // initialize gemm underlying operation to handle parallel reduction
   library::Operation const * underlying_operation = operation;
 
@@ -1175,20 +1328,11 @@ Status GemmOperationProfiler::profile_cutlass_(
     }
   }
 
-  //
-  // Initialize GPU timer
-  //
-
-  timer.start();
-
   //
   // Profiling loop
   //
 
-  int Iterations = options.profiling.iterations;
-
-  int iteration = 0;
-  for (; iteration < Iterations; ++iteration) {
+  return profile_iterations_(result, options, timer, [&](int iteration) {
 
     // Iterate over copies of the problem in memory
     int workspace_idx = options.profiling.warmup_iterations + iteration;
@@ -1207,40 +1351,21 @@ Status GemmOperationProfiler::profile_cutlass_(
       gemm_workspace_.reduction_arguments.destination = gemm_workspace_.Computed->batch_data(problem_idx);
     }
 
-    status = underlying_operation->run(
+    Status status = underlying_operation->run(
       arguments,
       host_workspace,
       device_workspace);
 
-    if (status != Status::kSuccess) {
-      return status;
-    }
-
     // Run parallel reduction kernel for parallel split_k_mode
-    if (problem_.split_k_mode == library::SplitKMode::kParallel) {
+    if (status == Status::kSuccess && problem_.split_k_mode == library::SplitKMode::kParallel) {
       status = reduction_op_->run(
         &gemm_workspace_.reduction_arguments,
         gemm_workspace_.reduction_host_workspace.data(),
         nullptr);
-
-      if (status != Status::kSuccess) {
-        return status;
-      }
     }
-  }
 
-  //
-  // Wait for completion
-  //
-
-  timer.stop_and_wait();
-  //
-  // Update performance result
-  //
-
-  runtime = timer.duration(iteration);
-
-  return status;
+    return status;
+  });
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
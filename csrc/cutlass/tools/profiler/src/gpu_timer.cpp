@@ -32,6 +32,7 @@
    \brief Defines a math function
 */
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "cutlass/profiler/gpu_timer.h"
@@ -56,6 +57,9 @@ GpuTimer::~GpuTimer() {
   for (auto & event : events) {
     cudaEventDestroy(event);
   }
+  for (auto & event : sample_events) {
+    cudaEventDestroy(event);
+  }
 }
 
 /// Records a start event in the stream
@@ -107,6 +111,56 @@ double GpuTimer::duration(int iterations) const {
   return double(avg_ms) / double(iterations);
 }
 
+/// Creates events to time each of the first `iterations` iterations after start()
+void GpuTimer::enable_samples(int iterations) {
+
+  while (int(sample_events.size()) < iterations) {
+    cudaEvent_t event;
+    cudaError_t result = cudaEventCreate(&event);
+    if (result != cudaSuccess) {
+      throw std::runtime_error("Failed to create CUDA event");
+    }
+    sample_events.push_back(event);
+  }
+}
+
+/// Records the end of an iteration in the stream
+void GpuTimer::sample(int iteration, cudaStream_t stream) {
+
+  if (iteration < 0 || iteration >= int(sample_events.size())) {
+    return;
+  }
+
+  cudaError_t result = cudaEventRecord(sample_events[iteration], stream);
+  if (result != cudaSuccess) {
+    throw std::runtime_error("Failed to record sample event.");
+  }
+}
+
+/// Returns the duration in milliseconds of each sampled iteration
+std::vector<double> GpuTimer::samples(int iterations) const {
+
+  std::vector<double> durations;
+
+  int count = std::min(iterations, int(sample_events.size()));
+
+  for (int iteration = 0; iteration < count; ++iteration) {
+
+    float ms;
+
+    cudaEvent_t begin = (iteration ? sample_events[iteration - 1] : events[0]);
+
+    cudaError_t result = cudaEventElapsedTime(&ms, begin, sample_events[iteration]);
+    if (result != cudaSuccess) {
+      throw std::runtime_error("Failed to query elapsed time from CUDA events.");
+    }
+
+    durations.push_back(double(ms));
+  }
+
+  return durations;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 } // namespace profiler
@@ -0,0 +1,108 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Wall-clock timer for operations executed on the host
+*/
+
+#include <algorithm>
+
+#include "cutlass/profiler/host_timer.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Milliseconds elapsed between two time points
+double elapsed_ms(HostTimer::Clock::time_point begin, HostTimer::Clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+} // namespace
+
+/// Takes the start time point
+void HostTimer::start(cudaStream_t stream) {
+  events[0] = Clock::now();
+}
+
+/// Takes the stop time point
+void HostTimer::stop(cudaStream_t stream) {
+  events[1] = Clock::now();
+}
+
+/// Takes the stop time point
+void HostTimer::stop_and_wait(cudaStream_t stream) {
+  stop(stream);
+}
+
+/// Returns the duration in milliseconds
+double HostTimer::duration(int iterations) const {
+  return elapsed_ms(events[0], events[1]) / double(iterations);
+}
+
+/// Reserves time points for each of the first `iterations` iterations after start()
+void HostTimer::enable_samples(int iterations) {
+  if (int(sample_events.size()) < iterations) {
+    sample_events.resize(iterations);
+  }
+}
+
+/// Takes the time point ending an iteration
+void HostTimer::sample(int iteration, cudaStream_t stream) {
+
+  if (iteration < 0 || iteration >= int(sample_events.size())) {
+    return;
+  }
+
+  sample_events[iteration] = Clock::now();
+}
+
+/// Returns the duration in milliseconds of each sampled iteration
+std::vector<double> HostTimer::samples(int iterations) const {
+
+  std::vector<double> durations;
+
+  int count = std::min(iterations, int(sample_events.size()));
+
+  for (int iteration = 0; iteration < count; ++iteration) {
+    Clock::time_point begin = (iteration ? sample_events[iteration - 1] : events[0]);
+    durations.push_back(elapsed_ms(begin, sample_events[iteration]));
+  }
+
+  return durations;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
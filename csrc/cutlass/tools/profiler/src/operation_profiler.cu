@@ -33,6 +33,7 @@
 */
 
 #include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include <iomanip>
 #include <cstring>
@@ -274,6 +275,9 @@ std::ostream& operator<<(std::ostream& out, library::Provider provider) {
   else if (provider == library::Provider::kCUDNN) {
     out << "kCUDNN";
   }
+  else if (provider == library::Provider::kHost) {
+    out << "kHost";
+  }
   else {
     out << "kInvalid";
   }
@@ -338,90 +342,90 @@ int OperationProfiler::profile_all(
   bool continue_profiling = true;
   int retval = 0;
 
+  // Verify against the host reference on worker threads while later operations are profiled
+  std::unique_ptr<VerificationPipeline> verification_pipeline;
+
+  if (options.verification.enabled && options.verification.threads > 0 &&
+    options.execution_mode == ExecutionMode::kProfile) {
+
+    verification_pipeline.reset(new VerificationPipeline(
+      options.verification.threads,
+      options.verification.queue_capacity << 20,
+      [&report](PerformanceResultVector const &results, size_t problem_index) {
+        report.append_results(results, problem_index);
+      }));
+  }
+
+  verification_pipeline_ = verification_pipeline.get();
+
+  // Operations passing the kind, provider, compute capability and name filters are the same for
+  // every problem
+  std::vector<library::Operation const *> operations = filter_operations_(options, manifest);
+
   // For each problem in problem space
   for (; continue_profiling && problem_it != problem_end; ++problem_it) {
     ProblemSpace::Problem problem = problem_it.at();
-    report.next_problem();
+    std::string problem_key = problem_string_(problem);
+    report.next_problem(problem_key);
 
-    // For each operation in manifest
+    // For each operation passing the filters
     int matched_operation_count = 0;
-    for (auto const& operation_ptr : manifest) {
+    for (library::Operation const *operation : operations) {
 
-      library::Operation const *operation = operation_ptr.get();
-#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
-      std::cerr << "  Operation: " << typeid(*operation).name() << "\n"
-                << "    name: " << operation->description().name << "\n"
-                << "    kind: " << operation->description().kind << "\n"
-                << "    provider: " << operation->description().provider << "\n";
-#endif // CUTLASS_DEBUG_TRACE_LEVEL
+      // Clear named allocations
+      device_context.free();
 
-      auto min_cc = operation->description().tile_description.minimum_compute_capability;
-      auto max_cc = operation->description().tile_description.maximum_compute_capability;
+      library::Provider provider = operation->description().provider;
 
-#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
-      std::cerr << "    min_cc: " << min_cc << "\n";
-      std::cerr << "    max_cc: " << min_cc << "\n";
-#endif
+      // Operations executed on the host read and write host memory
+      device_context.set_host_resident(provider == library::Provider::kHost);
 
-      // Clear named allocations
-      device_context.free();
+      std::string operation_name(operation->description().name);
 
-#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
-      if (operation->description().kind != kind_) {
-        std::cerr << "    @ kind " << operation->description().kind
-                  << " != kind_ " << kind_ << "\n";
+      if (!satisfies(operation->description(), problem_space, problem)) {
+        continue;
       }
-      if (operation->description().provider != library::Provider::kCUTLASS) {
-        std::cerr << "    @ provider " << operation->description().provider
-                  << " != library::Provider::kCUTLASS\n";
+
+      // we have found a kernel match, so increment the counter for match kernels
+      ++matched_operation_count;
+
+      // Skip pairs assigned to other shards or completed by an earlier run of the sweep
+      if (!options.profiling.shard.contains(operation_name, problem_key) ||
+        report.completed(operation_name)) {
+        continue;
       }
-      if (options.device.compute_capability() < min_cc) {
-        std::cerr << "    @ compute_capability "
-                  << options.device.compute_capability()
-                  << " < min_cc " << min_cc << "\n";
+
+      // A. Initialize configuration
+      Status status = this->initialize_configuration(
+        options,
+        report,
+        device_context,
+        operation,
+        problem_space,
+        problem);
+
+      if (status == Status::kErrorInternal) {
+
+        // If there was an internal error, consume the CUDA error and move to the next operation.
+        (void)cudaGetLastError();
+
+        append_results_(report);
+        continue;
       }
-      if (options.device.compute_capability() > max_cc) {
-        std::cerr << "    @ compute_capability "
-                  << options.device.compute_capability()
-                  << " > max_cc " << max_cc << "\n";
+      else if (status != Status::kSuccess) {
+        // If the workspace could not be initialized for any other reason, continue to
+        // the next operation.
+        continue;
       }
-#endif
 
-      // Execute compatible cutlass operations if they satisfy the current device's compute capability
-      if (operation->description().kind == kind_ &&
-          operation->description().provider == library::Provider::kCUTLASS &&
-          options.device.compute_capability() >= min_cc &&
-          options.device.compute_capability() <= max_cc) {
-
-        std::string operation_name(operation->description().name);
-        // Filter kernels by name
-        bool filtered_by_name = options.operation_names.empty();
-        if (!filtered_by_name) {
-
-          for (auto const & op_name : options.operation_names) {
-            if (find_string_matches_(op_name, operation_name)) {
-              filtered_by_name = true;
-              break;
-            }
-          }
-        }
-
-        for (auto const & op_name : options.excluded_operation_names) {
-          if (find_string_matches_(op_name, operation_name)) {
-            filtered_by_name = false;
-            break;
-          }
-        }
+      if (continue_profiling) {
 
-        if (!filtered_by_name || !satisfies(operation->description(), problem_space, problem)) {
-          continue;
+        if (options.report.print_kernel_before_running) {
+          std::cout << "Profiling kernel for JUnit test " << options.report.junit_output_path << ": "
+                    << operation_name << std::endl;
         }
 
-        // we have found a kernel match, so increment the counter for match kernels
-        ++matched_operation_count;
-
-        // A. Initialize configuration
-        Status status = this->initialize_configuration(
+        status = this->initialize_workspace(
           options,
           report,
           device_context,
@@ -434,7 +438,7 @@ int OperationProfiler::profile_all(
           // If there was an internal error, consume the CUDA error and move to the next operation.
           (void)cudaGetLastError();
 
-          report.append_results(results_);
+          append_results_(report);
           continue;
         }
         else if (status != Status::kSuccess) {
@@ -442,92 +446,62 @@ int OperationProfiler::profile_all(
           // the next operation.
           continue;
         }
+      }
 
-        if (continue_profiling) {
-
-          if (options.report.print_kernel_before_running) {
-            std::cout << "Profiling kernel for JUnit test " << options.report.junit_output_path << ": "
-                      << operation_name << std::endl;
-          }
-
-          status = this->initialize_workspace(
-            options,
-            report,
-            device_context,
-            operation,
-            problem_space,
-            problem);
-
-          if (status == Status::kErrorInternal) {
-
-            // If there was an internal error, consume the CUDA error and move to the next operation.
-            (void)cudaGetLastError();
-
-            report.append_results(results_);
-            continue;
-          }
-          else if (status != Status::kSuccess) {
-            // If the workspace could not be initialized for any other reason, continue to
-            // the next operation.
-            continue;
-          }
-        }
-
-        //
-        // Profile CUTLASS if it is enabled
-        //
-
-        // B. Verify CUTLASS
-        if (continue_profiling && options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+      //
+      // Profile CUTLASS if it is enabled
+      //
 
-          continue_profiling = this->verify_cutlass(
-            options,
-            report,
-            device_context,
-            operation,
-            problem_space,
-            problem);
+      // B. Verify CUTLASS
+      if (continue_profiling && options.profiling.provider_enabled(provider)) {
 
-          retval |= (not continue_profiling);
-        }
+        continue_profiling = this->verify_cutlass(
+          options,
+          report,
+          device_context,
+          operation,
+          problem_space,
+          problem);
 
-        if (options.execution_mode == ExecutionMode::kDryRun) {
-          report.append_results(results_);
-          results_.clear();
-          continue;
-        }
+        retval |= (not continue_profiling);
+      }
 
-        //
-        // C. Optionally save workspace
-        //
+      if (options.execution_mode == ExecutionMode::kDryRun) {
+        append_results_(report);
+        results_.clear();
+        continue;
+      }
 
-        if (options.verification.save_workspace == SaveWorkspace::kAlways) {
-          save_workspace(
-            device_context,
-            options,
-            operation->description(),
-            library::Provider::kCUTLASS);
-        }
+      //
+      // C. Optionally save workspace
+      //
 
-        //
-        // D. Profile
-        //
+      if (options.verification.save_workspace == SaveWorkspace::kAlways) {
+        save_workspace(
+          device_context,
+          options,
+          operation->description(),
+          provider);
+      }
 
-        if (continue_profiling && options.profiling.enabled) {
+      //
+      // D. Profile
+      //
 
-          continue_profiling = this->profile(
-            options,
-            report,
-            device_context,
-            operation,
-            problem_space,
-            problem);
-        }
+      if (continue_profiling && options.profiling.enabled) {
 
-        report.append_results(results_);
-        results_.clear();
+        continue_profiling = this->profile(
+          options,
+          report,
+          device_context,
+          operation,
+          problem_space,
+          problem);
       }
 
+      append_results_(report);
+      results_.clear();
+
       if (!continue_profiling) {
         break;
       }
@@ -542,11 +516,121 @@ int OperationProfiler::profile_all(
     }
   }
 
+  // Wait for pending verifications
+  if (verification_pipeline) {
+    verification_pipeline->finish();
+  }
+  verification_pipeline_ = nullptr;
+
+  // 3. Record results and compare them against the baseline, failing on regressions
+  if (report.record_results() != 0) {
+    retval = 1;
+  }
+
   return retval;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Returns the operations of the manifest of this kind that are executed on the device, or on the
+/// host if that provider is enabled, and that pass the name filters
+std::vector<library::Operation const *> OperationProfiler::filter_operations_(
+  Options const &options,
+  library::Manifest const &manifest) {
+
+  std::vector<library::Operation const *> operations;
+
+  for (auto const& operation_ptr : manifest) {
+
+    library::Operation const *operation = operation_ptr.get();
+#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
+    std::cerr << "  Operation: " << typeid(*operation).name() << "\n"
+              << "    name: " << operation->description().name << "\n"
+              << "    kind: " << operation->description().kind << "\n"
+              << "    provider: " << operation->description().provider << "\n";
+#endif // CUTLASS_DEBUG_TRACE_LEVEL
+
+    auto min_cc = operation->description().tile_description.minimum_compute_capability;
+    auto max_cc = operation->description().tile_description.maximum_compute_capability;
+
+#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
+    std::cerr << "    min_cc: " << min_cc << "\n";
+    std::cerr << "    max_cc: " << min_cc << "\n";
+
+    if (operation->description().kind != kind_) {
+      std::cerr << "    @ kind " << operation->description().kind
+                << " != kind_ " << kind_ << "\n";
+    }
+    if (operation->description().provider != library::Provider::kCUTLASS) {
+      std::cerr << "    @ provider " << operation->description().provider
+                << " != library::Provider::kCUTLASS\n";
+    }
+    if (options.device.compute_capability() < min_cc) {
+      std::cerr << "    @ compute_capability "
+                << options.device.compute_capability()
+                << " < min_cc " << min_cc << "\n";
+    }
+    if (options.device.compute_capability() > max_cc) {
+      std::cerr << "    @ compute_capability "
+                << options.device.compute_capability()
+                << " > max_cc " << max_cc << "\n";
+    }
+#endif
+
+    library::Provider provider = operation->description().provider;
+
+    // Execute compatible cutlass operations if they satisfy the current device's compute capability.
+    // Operations executed on the host run if their provider is enabled.
+    if (operation->description().kind != kind_ ||
+        !(provider == library::Provider::kCUTLASS ||
+          (provider == library::Provider::kHost && options.profiling.provider_enabled(provider))) ||
+        options.device.compute_capability() < min_cc ||
+        options.device.compute_capability() > max_cc) {
+      continue;
+    }
+
+    std::string operation_name(operation->description().name);
+    // Filter kernels by name
+    bool filtered_by_name = options.operation_names.empty();
+    if (!filtered_by_name) {
+
+      for (auto const & op_name : options.operation_names) {
+        if (library::matches_operation_name(op_name, operation_name)) {
+          filtered_by_name = true;
+          break;
+        }
+      }
+    }
+
+    for (auto const & op_name : options.excluded_operation_names) {
+      if (library::matches_operation_name(op_name, operation_name)) {
+        filtered_by_name = false;
+        break;
+      }
+    }
+
+    if (filtered_by_name) {
+      operations.push_back(operation);
+    }
+  }
+
+  return operations;
+}
+
+/// Returns a string identifying a problem by its argument values
+std::string OperationProfiler::problem_string_(ProblemSpace::Problem const &problem) {
+
+  std::ostringstream out;
+
+  int idx = 0;
+  for (auto const &value : problem) {
+    out << (idx++ ? "; " : "");
+    value->print(out);
+  }
+
+  return out.str();
+}
+
 /// Sleep for a given duration in ms
 void OperationProfiler::sleep(int sleep_duration) {
   if (sleep_duration) {
@@ -561,6 +645,42 @@ void OperationProfiler::sleep(int sleep_duration) {
 }
 
 
+/// Returns true if verification against the host reference may complete after the operation is
+/// profiled
+bool OperationProfiler::defer_verification_(
+  Options const &options,
+  DeviceContext const &device_context) const {
+
+  return verification_pipeline_ &&
+    !options.verification.required &&
+    options.verification.save_workspace != SaveWorkspace::kIncorrect &&
+    !device_context.host_resident();
+}
+
+/// Defers a verification of the most recent result
+void OperationProfiler::defer_verification_(
+  library::Provider provider,
+  size_t bytes,
+  std::function<Disposition()> verify) {
+
+  results_.back().verification_map[provider] = Disposition::kNotVerified;
+
+  deferred_verifications_.push_back(
+    DeferredVerification{results_.size() - 1, provider, bytes, std::move(verify)});
+}
+
+/// Appends results_ to the report, or queues them behind pending verifications
+void OperationProfiler::append_results_(PerformanceReport &report) {
+
+  if (verification_pipeline_) {
+    verification_pipeline_->submit(results_, report.problem_index(), std::move(deferred_verifications_));
+    deferred_verifications_.clear();
+  }
+  else {
+    report.append_results(results_);
+  }
+}
+
 /// Compares tensors for equality
 Disposition OperationProfiler::compare_tensors(
   Options const &options,
@@ -578,7 +698,11 @@ Disposition OperationProfiler::compare_tensors(
     count = reference.capacity();
   }
 
-  if (options.verification.epsilon == 0) {
+  if (experimental.host_resident() && reference.host_resident()) {
+    return compare_host_tensors(
+      options, experimental.type(), experimental.data(), reference.data(), count);
+  }
+  else if (options.verification.epsilon == 0) {
 
     // bit-level equality
     passed = DeviceAllocation::block_compare_equal(
@@ -602,6 +726,36 @@ Disposition OperationProfiler::compare_tensors(
   return passed ? Disposition::kPassed : Disposition::kIncorrect;
 }
 
+/// Compares tensors in host memory for equality
+Disposition OperationProfiler::compare_host_tensors(
+  Options const &options,
+  library::NumericTypeID type,
+  void const *experimental,
+  void const *reference,
+  int64_t count) {
+
+  bool passed = false;
+
+  if (options.verification.epsilon == 0) {
+    passed = DeviceAllocation::block_compare_equal_host(
+      type,
+      experimental,
+      reference,
+      count);
+  }
+  else {
+    passed = DeviceAllocation::block_compare_relatively_equal_host(
+      type,
+      experimental,
+      reference,
+      count,
+      options.verification.epsilon,
+      options.verification.nonzero_floor);
+  }
+
+  return passed ? Disposition::kPassed : Disposition::kIncorrect;
+}
+
 /// Saves the workspace
 void OperationProfiler::save_workspace(
   DeviceContext &device_context,
@@ -640,7 +794,7 @@ void OperationProfiler::save_workspace(
 
 /// Method to profile a CUTLASS Operation
 Status OperationProfiler::profile_cutlass_(
-  double &runtime,
+  PerformanceResult &result,
   Options const &options,
   library::Operation const *operation,
   void *arguments,
@@ -673,44 +827,16 @@ Status OperationProfiler::profile_cutlass_(
     }
   }
 
-  //
-  // Initialize GPU timer
-  //
-
-  timer.start();
-
   //
   // Profiling loop
   //
 
-  int Iterations = options.profiling.iterations;
-
-  int iteration = 0;
-  for (; iteration < Iterations; ++iteration) {
-
-    status = operation->run(
+  return profile_iterations_(result, options, timer, [&](int iteration) {
+    return operation->run(
       arguments,
       host_workspace,
       device_workspace);
-
-    if (status != Status::kSuccess) {
-      return status;
-    }
-  }
-
-  //
-  // Wait for completion
-  //
-
-  timer.stop_and_wait();
-
-  //
-  // Update performance result
-  //
-
-  runtime = timer.duration(iteration);
-
-  return status;
+  });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -764,38 +890,6 @@ void OperationProfiler::set_argument(
 }
 
 
-/// finds string matches filter_string in operation_name
-bool OperationProfiler::find_string_matches_(
-  std::string const &filter_string,
-  std::string const &operation_name) {
-  // Returns true if all substrings appear in the operation_name in order
-
-  // Split filter_string of the format "gemm*f32*nt" to tokens ["gemm", "f32", "nt"]
-  std::string item;
-  std::istringstream iss(filter_string);
-  std::vector<std::string> filter_tokens;
-  while (std::getline(iss, item, '*')) {
-    filter_tokens.push_back(item);
-  }
-
-  // Search filter_tokens in operation_name in order
-  size_t start = 0, idx = 0;
-  for (auto & token : filter_tokens) {
-    // Check if characters left to be parsed in operation_name
-    if (start < operation_name.length()) {
-      // Find token in operation_name[start:]
-      idx = operation_name.substr(start).find(token);
-      if (idx == std::string::npos) {
-        return false;
-      }
-    }
-    start += (idx + token.length());
-  }
-
-  // All tokens in filter_string found in operation_name
-  return true;
-}
-
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 } // namespace profiler
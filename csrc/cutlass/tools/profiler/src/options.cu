@@ -33,6 +33,7 @@
 */
 
 #include <algorithm>
+#include <cstring>
 
 #include "cutlass/cutlass.h"
 #include "cutlass/version.h"
@@ -60,6 +61,16 @@ Options::Device::Device(cutlass::CommandLine const &cmdline) {
   cudaError_t result;
   result = cudaGetDeviceProperties(&properties, device);
 
+  // Without a usable CUDA device, only operations executed on the host are profiled
+  if (result == cudaErrorNoDevice || result == cudaErrorInsufficientDriver) {
+    cudaGetLastError();
+
+    device = -1;
+    std::memset(&properties, 0, sizeof(properties));
+    std::strncpy(properties.name, "Host", sizeof(properties.name) - 1);
+    return;
+  }
+
   if (result != cudaSuccess) {
     throw std::runtime_error("cudaGetDeviceProperties() failed for given device");
   }
@@ -400,6 +411,8 @@ Options::Profiling::Profiling(cutlass::CommandLine const &cmdline) {
   cmdline.get_cmd_line_argument("warmup-iterations", warmup_iterations, 10);
   cmdline.get_cmd_line_argument("profiling-iterations", iterations, 100);
   cmdline.get_cmd_line_argument("sleep-duration", sleep_duration, 50);
+  cmdline.get_cmd_line_argument("profiling-duration", duration, 1000);
+  cmdline.get_cmd_line_argument("profiling-ci-width", confidence_width, 0.01);
   cmdline.get_cmd_line_argument("profiling-enabled", enabled, true);
   
   if (cmdline.check_cmd_line_flag("providers")) {
@@ -418,6 +431,15 @@ Options::Profiling::Profiling(cutlass::CommandLine const &cmdline) {
     providers.push_back(library::Provider::kCUBLAS);
     providers.push_back(library::Provider::kCUDNN);      
   }
+
+  if (cmdline.check_cmd_line_flag("shard")) {
+    std::string token;
+    cmdline.get_cmd_line_argument("shard", token);
+
+    if (!SweepShard::parse(token, shard)) {
+      throw std::runtime_error("Invalid --shard argument. Expected <index>/<count> with 0 <= index < count.");
+    }
+  }
 }
 
 void Options::Profiling::print_usage(std::ostream &out) const {
@@ -431,7 +453,17 @@ void Options::Profiling::print_usage(std::ostream &out) const {
 
     << "  --profiling-iterations=<iterations>          "
     << "    Number of iterations to profile each kernel. If zero, kernels" << end_of_line
-    << "      are launched up to the profiling duration.\n\n"
+    << "      are launched until the confidence interval of the median runtime" << end_of_line
+    << "      is narrow enough or up to the profiling duration. (default: 100)\n\n"
+
+    << "  --profiling-duration=<duration>              "
+    << "    Number of ms to profile each kernel if --profiling-iterations=0." << end_of_line
+    << "      (default: 1000)\n\n"
+
+    << "  --profiling-ci-width=<width>                 "
+    << "    Width of the 95% confidence interval of the median runtime, relative" << end_of_line
+    << "      to the median, at which profiling stops if --profiling-iterations=0." << end_of_line
+    << "      (default: 0.01)\n\n"
 
     << "  --warmup-iterations=<iterations>             "
     << "    Number of iterations to execute each kernel prior to profiling.\n\n"
@@ -442,6 +474,16 @@ void Options::Profiling::print_usage(std::ostream &out) const {
     << "  --profiling-enabled=<bool>                   "
     << "    If true, profiling is actually conducted.\n\n"
 
+    << "  --providers=<providers>                      "
+    << "    List of providers to profile {cutlass*, cublas*, cudnn*, cpu}. The 'cpu'" << end_of_line
+    << "      provider executes operations on the host and is the only one profiled" << end_of_line
+    << "      when no CUDA device is present. (default: '*')\n\n"
+
+    << "  --shard=<index>/<count>                      "
+    << "    Profiles only the (operation, problem) pairs assigned to shard index" << end_of_line
+    << "      of count. Every process of a sweep agrees on the assignment, so" << end_of_line
+    << "      shards may run on different machines. (default: 0/1)\n\n"
+
   ;
 }
 
@@ -450,7 +492,10 @@ void Options::Profiling::print_options(std::ostream &out, int indent) const {
   out
     << indent_str(indent) << "profiling_iterations: " << iterations << "\n"
     << indent_str(indent) << "sleep_duration: " << sleep_duration << "\n"
+    << indent_str(indent) << "profiling_duration: " << duration << "\n"
+    << indent_str(indent) << "profiling_ci_width: " << confidence_width << "\n"
     << indent_str(indent) << "profiling_enabled: " << enabled << "\n"
+    << indent_str(indent) << "shard: " << shard.index << "/" << shard.count << "\n"
     << indent_str(indent) << "providers: [";
 
   int j = 0;
@@ -499,6 +544,13 @@ Options::Verification::Verification(cutlass::CommandLine const &cmdline) {
     save_workspace = SaveWorkspace::kNever;
   }
 
+  cmdline.get_cmd_line_argument("reference-cache", reference_cache, true);
+  cmdline.get_cmd_line_argument("reference-cache-capacity", reference_cache_capacity, size_t(1024));
+  cmdline.get_cmd_line_argument("reference-cache-dir", reference_cache_dir, std::string());
+
+  cmdline.get_cmd_line_argument("verification-threads", threads, 1);
+  cmdline.get_cmd_line_argument("verification-queue-capacity", queue_capacity, size_t(1024));
+
   if (cmdline.check_cmd_line_flag("verification-providers")) {
     
     std::vector<std::string> tokens;
@@ -545,7 +597,27 @@ void Options::Verification::print_usage(std::ostream &out) const {
     << "    List of providers used to verify result. (default: '*')" << end_of_line
     << "      Gemm verification-providers {cublas*}" << end_of_line
     << "      Conv2d verification-providers {cudnn*, device*, host}"
-    << "\n\n";
+    << "\n\n"
+
+    << "  --reference-cache=<bool>                     "
+    << "    Whether host reference results are reused by kernels verified on" << end_of_line
+    << "      the same inputs. (default: true)\n\n"
+
+    << "  --reference-cache-capacity=<MiB>             "
+    << "    Memory held by cached host reference results. (default: 1024)\n\n"
+
+    << "  --reference-cache-dir=<path>                 "
+    << "    Directory in which host reference results are also stored, so" << end_of_line
+    << "      later profiler runs reuse them.\n\n"
+
+    << "  --verification-threads=<int>                 "
+    << "    Number of threads verifying against the host reference while later" << end_of_line
+    << "      kernels are profiled. If zero, kernels are verified before they" << end_of_line
+    << "      are profiled. (default: 1)\n\n"
+
+    << "  --verification-queue-capacity=<MiB>          "
+    << "    Memory held by results awaiting verification. Profiling waits for" << end_of_line
+    << "      queued verifications to finish once this is exceeded. (default: 1024)\n\n";
 }
 
 void Options::Verification::print_options(std::ostream &out, int indent) const {
@@ -554,6 +626,11 @@ void Options::Verification::print_options(std::ostream &out, int indent) const {
     << indent_str(indent) << "verification_enabled: " << enabled << "\n"
     << indent_str(indent) << "epsilon: " << epsilon << "\n"
     << indent_str(indent) << "save_workspace: " << to_string(save_workspace) << "\n"
+    << indent_str(indent) << "reference_cache: " << reference_cache << "\n"
+    << indent_str(indent) << "reference_cache_capacity: " << reference_cache_capacity << "\n"
+    << indent_str(indent) << "reference_cache_dir: " << reference_cache_dir << "\n"
+    << indent_str(indent) << "verification_threads: " << threads << "\n"
+    << indent_str(indent) << "verification_queue_capacity: " << queue_capacity << "\n"
     << indent_str(indent) << "verification_providers: [";
 
   int j = 0;
@@ -599,6 +676,22 @@ Options::Report::Report(cutlass::CommandLine const &cmdline) {
   cmdline.get_cmd_line_argument("sort-results", sort_results, false);
 
   cmdline.get_cmd_line_argument("print-kernel-before-running", print_kernel_before_running, false);
+
+  cmdline.get_cmd_line_argument("results-db", results_db_path);
+  cmdline.get_cmd_line_argument("compare", compare_path);
+  cmdline.get_cmd_line_argument("compare-threshold", compare_threshold, 0.02);
+  cmdline.get_cmd_line_argument("compare-alpha", compare_alpha, 0.01);
+
+  cmdline.get_cmd_line_argument("checkpoint", checkpoint_path);
+
+  // Pairs are checkpointed once their results are written, which requires an output file
+  if (!checkpoint_path.empty() && output_path.empty()) {
+    throw std::runtime_error("--checkpoint requires --output.");
+  }
+
+  if (cmdline.check_cmd_line_flag("merge-inputs")) {
+    cmdline.get_cmd_line_arguments("merge-inputs", merge_inputs);
+  }
 }
 
 void Options::Report::print_usage(std::ostream &out) const {
@@ -631,7 +724,33 @@ void Options::Report::print_usage(std::ostream &out) const {
     << "    Prints human-readable text to stdout. If false, nothing is written to stdout.\n\n"
 
     << "  --sort-results=<bool>                        "
-    << "    Sorts results (by flops-per-byte).\n\n";
+    << "    Sorts results (by flops-per-byte).\n\n"
+
+    << "  --results-db=<path>                          "
+    << "    Appends the runtime of each profiled iteration to a results database" << end_of_line
+    << "      keyed by device, operation and problem.\n\n"
+
+    << "  --compare=<path>                             "
+    << "    Compares results against the latest matching records of a results" << end_of_line
+    << "      database and returns an error code if any result regressed. A missing" << end_of_line
+    << "      database is skipped with a warning, so it may also be the --results-db.\n\n"
+
+    << "  --compare-threshold=<fraction>               "
+    << "    Smallest relative change of the median runtime reported as a" << end_of_line
+    << "      regression or improvement. (default: 0.02)\n\n"
+
+    << "  --compare-alpha=<p-value>                    "
+    << "    Significance level of the rank-sum test on per-iteration runtimes." << end_of_line
+    << "      (default: 0.01)\n\n"
+
+    << "  --checkpoint=<path>                          "
+    << "    Records each reported (operation, problem) pair. Pairs recorded by an" << end_of_line
+    << "      earlier run are skipped and results are appended to the output, so" << end_of_line
+    << "      an interrupted sweep resumes where it stopped. Requires --output.\n\n"
+
+    << "  --merge-inputs=<path,...>                    "
+    << "    Reports merged into --output if --mode=merge. Problems are renumbered" << end_of_line
+    << "      and results reported more than once keep their last rows.\n\n";
 }
 
 void Options::Report::print_options(std::ostream &out, int indent) const {
@@ -649,7 +768,12 @@ void Options::Report::print_options(std::ostream &out, int indent) const {
   }
 
   out
-    << indent_str(indent) << "verbose: " << verbose << "\n";
+    << indent_str(indent) << "verbose: " << verbose << "\n"
+    << indent_str(indent) << "results-db: " << results_db_path << "\n"
+    << indent_str(indent) << "compare: " << compare_path << "\n"
+    << indent_str(indent) << "compare-threshold: " << compare_threshold << "\n"
+    << indent_str(indent) << "compare-alpha: " << compare_alpha << "\n"
+    << indent_str(indent) << "checkpoint: " << checkpoint_path << "\n";
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -740,6 +864,20 @@ Options::Options(cutlass::CommandLine const &cmdline):
     verification.providers = {library::Provider::kReferenceHost};
     profiling.enabled = false;
   }
+
+  // Without a CUDA device, operations are executed, initialized and verified on the host
+  if (device.host_only()) {
+    profiling.providers = {library::Provider::kHost};
+    initialization.provider = library::Provider::kReferenceHost;
+    verification.providers = {library::Provider::kReferenceHost};
+  }
+
+  // Operations executed on the host are verified against the host reference
+  if (profiling.provider_enabled(library::Provider::kHost) &&
+    !verification.provider_enabled(library::Provider::kReferenceHost)) {
+
+    verification.providers.push_back(library::Provider::kReferenceHost);
+  }
 }
 
 void Options::print_usage(std::ostream &out) const {
@@ -756,7 +894,9 @@ void Options::print_usage(std::ostream &out) const {
     << "       --mode=dry_run    no kernels are launched or workspaces allocated" << end_of_line
     << "       --mode=enumerate  lists all operation kind and operations" << end_of_line
     << "       --mode=trace      executes a single device-side computation with" << end_of_line
-    << "                          no other kernel launches\n\n"
+    << "                          no other kernel launches" << end_of_line
+    << "       --mode=merge      merges the reports of sweep shards given by" << end_of_line
+    << "                          --merge-inputs into --output\n\n"
 
     << "  --device-info                                "
     << "    Prints information on all GPUs present in the system\n\n"
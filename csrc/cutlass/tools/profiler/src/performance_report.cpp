@@ -37,6 +37,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <cstring>
+#include <ctime>
 
 #include "cutlass/library/util.h"
 
@@ -74,6 +75,17 @@ PerformanceReport::PerformanceReport(
 ):
   options_(options), argument_names_(argument_names), problem_index_(0), good_(true), op_kind_(op_kind) {
 
+  if (options_.report.record_samples()) {
+
+    device_name_ = std::string(options_.device.properties.name) +
+      " (sm_" + std::to_string(options_.device.compute_capability()) + ")";
+
+    char timestamp[32] = {0};
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    timestamp_ = timestamp;
+  }
+
   // Strip '.csv' if present
   std::string base_path = options_.report.output_path;
   base_path = base_path.substr(0, base_path.rfind(".csv"));
@@ -84,6 +96,24 @@ PerformanceReport::PerformanceReport(
   base_path = base_path.substr(0, base_path.rfind(".junit"));
   op_junit_file_name_ = base_path + "." + to_string(op_kind_) + ".junit.xml";
 
+  //
+  // Open the checkpoint of a sweep. Results of a resumed sweep are appended to its output.
+  //
+  bool append = options_.report.append;
+
+  if (!options_.report.checkpoint_path.empty() && options_.execution_mode == ExecutionMode::kProfile) {
+
+    if (!checkpoint_.open(options_.report.checkpoint_path)) {
+
+      std::cerr << "Could not open checkpoint file at path '"
+         << options_.report.checkpoint_path << "'" << std::endl;
+
+      good_ = false;
+    }
+
+    append = append || checkpoint_.size();
+  }
+
   //
   // Open output file for operation of PerformanceReport::op_kind
   //
@@ -91,7 +121,7 @@ PerformanceReport::PerformanceReport(
 
     bool print_header = true;
 
-    if (options_.report.append) {
+    if (append) {
 
       std::ifstream test_output_file(op_file_name_);
       
@@ -135,13 +165,26 @@ PerformanceReport::PerformanceReport(
   }
 }
 
-void PerformanceReport::next_problem() {
+void PerformanceReport::next_problem(std::string const &problem_key) {
   ++problem_index_;
+
+  if (checkpoint_.is_open()) {
+    problem_keys_.resize(problem_index_ + 1);
+    problem_keys_[problem_index_] = problem_key;
+  }
+}
+
+bool PerformanceReport::completed(std::string const &operation_name) const {
+  return checkpoint_.is_open() && checkpoint_.completed(operation_name, problem_keys_.at(problem_index_));
 }
 
 void PerformanceReport::append_result(PerformanceResult result) {
+  append_result(result, problem_index_);
+}
+
+void PerformanceReport::append_result(PerformanceResult result, size_t problem_index) {
 
-  result.problem_index = problem_index_;
+  result.problem_index = problem_index;
 
   if (options_.report.verbose) {
     std::cout << "\n";
@@ -158,6 +201,21 @@ void PerformanceReport::append_result(PerformanceResult result) {
   else {
     concatenated_results_.push_back(result);
   }
+
+  if (options_.report.record_samples() && result.good()) {
+
+    ResultRecord record;
+
+    record.timestamp = timestamp_;
+    record.device = device_name_;
+    record.provider = library::to_string(result.provider, true);
+    record.operation = result.operation_name;
+    record.problem = ResultRecord::problem_string(result.arguments);
+    record.runtime = result.runtime;
+    record.samples = result.samples;
+
+    records_.push_back(record);
+  }
 }
 
 void PerformanceReport::sort_results(PerformanceResultVector &results) {
@@ -177,6 +235,10 @@ void PerformanceReport::sort_results(PerformanceResultVector &results) {
 }
 
 void PerformanceReport::append_results(PerformanceResultVector const &results) {
+  append_results(results, problem_index_);
+}
+
+void PerformanceReport::append_results(PerformanceResultVector const &results, size_t problem_index) {
 
   if (options_.report.verbose) {
     std::cout << "\n\n";
@@ -184,10 +246,85 @@ void PerformanceReport::append_results(PerformanceResultVector const &results) {
 
   // For each result
   for (auto const & result : results) {
-    append_result(result);
+    append_result(result, problem_index);
+  }
+
+  // Record pairs once their results are written and flushed to the output file
+  if (checkpoint_.is_open() && output_file_.is_open()) {
+    for (auto const & result : results) {
+      checkpoint_.record(result.operation_name, problem_keys_.at(problem_index));
+    }
   }
 }
 
+/// Appends profiled results to the results database and compares them against the baseline
+int PerformanceReport::record_results() {
+
+  if (records_.empty()) {
+    return 0;
+  }
+
+  int regressions = 0;
+
+  // Compare before appending, so a run may use the same database as its baseline. The first
+  // such run has no baseline yet: it only creates the database.
+  bool has_baseline = false;
+  ResultsDatabase baseline;
+
+  if (!options_.report.compare_path.empty()) {
+
+    if (!std::ifstream(options_.report.compare_path).is_open()) {
+      std::cerr << "Warning: no results database at path '"
+        << options_.report.compare_path << "', skipping the comparison" << std::endl;
+    }
+    else if (baseline.load(options_.report.compare_path) < 0) {
+      std::cerr << "Could not read results database at path '"
+        << options_.report.compare_path << "'" << std::endl;
+      regressions = -1;
+    }
+    else {
+      has_baseline = true;
+    }
+  }
+
+  if (has_baseline) {
+
+    std::vector<ResultComparison> comparisons = compare_results(
+      records_,
+      baseline,
+      ComparisonOptions(options_.report.compare_threshold, options_.report.compare_alpha));
+
+    for (auto const &comparison : comparisons) {
+      if (comparison.verdict == ComparisonVerdict::kRegression) {
+        ++regressions;
+      }
+    }
+
+    std::cout << "\n=============================\n\n"
+      << "Comparison of " << library::to_string(op_kind_) << " results against '"
+      << options_.report.compare_path << "':\n\n";
+
+    print_comparisons(std::cout, comparisons) << std::endl;
+  }
+
+  if (!options_.report.results_db_path.empty()) {
+
+    if (!ResultsDatabase::append(options_.report.results_db_path, records_)) {
+      std::cerr << "Could not write results database at path '"
+        << options_.report.results_db_path << "'" << std::endl;
+      regressions = -1;
+    }
+    else if (options_.report.verbose) {
+      std::cout << "\nAppended " << records_.size() << " results to '"
+        << options_.report.results_db_path << "'" << std::endl;
+    }
+  }
+
+  records_.clear();
+
+  return regressions;
+}
+
 PerformanceReport::~PerformanceReport() {
 
   //
@@ -305,7 +442,23 @@ std::ostream & PerformanceReport::print_result_pretty_(
   if (result.good()) {
 
     out
-      << "         Runtime: " << result.runtime << "  ms\n"
+      << "         Runtime: " << result.runtime << "  ms\n";
+
+    if (result.statistics.count) {
+      out
+        << "  Min/Median/P90: " << result.statistics.min << " / " << result.statistics.median
+          << " / " << result.statistics.p90 << "  ms\n";
+    }
+
+    out
+      << "      Iterations: " << result.iterations;
+
+    if (result.statistics.rejected) {
+      out << " (" << result.statistics.rejected << " outliers rejected)";
+    }
+
+    out
+      << "\n"
       << "          Memory: " << result.gbytes_per_sec() << " GiB/s\n"
       << "\n            Math: " << result.gflops_per_sec() << " GFLOP/s\n";
 
@@ -340,6 +493,10 @@ std::ostream & PerformanceReport::print_csv_header_(
     << ",Runtime"
     << ",GB/s"
     << ",GFLOPs"
+    << ",RuntimeMin"
+    << ",RuntimeMedian"
+    << ",RuntimeP90"
+    << ",Iterations"
     ;
 
   return out;
@@ -390,6 +547,18 @@ std::ostream & PerformanceReport::print_result_csv_(
     ); 
   }
 
+  if (result.statistics.count) {
+    out
+      << "," << result.statistics.min
+      << "," << result.statistics.median
+      << "," << result.statistics.p90;
+  }
+  else {
+    out << std::string(3, ',');
+  }
+
+  out << "," << result.iterations;
+
   return out;
 }
 
@@ -713,7 +713,7 @@ bool Rank2KOperationProfiler::profile(
     rank_k_workspace_.arguments.pointer_mode = library::ScalarPointerMode::kHost;
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &rank_k_workspace_.arguments,
@@ -699,7 +699,7 @@ bool RankKOperationProfiler::profile(
     rank_k_workspace_.arguments.pointer_mode = library::ScalarPointerMode::kHost;
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &rank_k_workspace_.arguments,
@@ -0,0 +1,497 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Persistent database of profiler results and comparison of runs against a baseline
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "cutlass/profiler/results_database.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// First line of every database file
+char const *kResultsDatabaseHeader = "# cutlass_profiler results v1";
+
+/// Replaces the field and record separators within a field
+std::string sanitize_field(std::string field) {
+  for (char &c : field) {
+    if (c == '\t' || c == '\n' || c == '\r') {
+      c = ' ';
+    }
+  }
+  return field;
+}
+
+/// Splits a line into tab-separated fields
+std::vector<std::string> split_fields(std::string const &line, char separator) {
+  std::vector<std::string> fields;
+  std::string field;
+  std::istringstream ss(line);
+  while (std::getline(ss, field, separator)) {
+    fields.push_back(field);
+  }
+  if (!line.empty() && line.back() == separator) {
+    fields.push_back(std::string());
+  }
+  return fields;
+}
+
+bool parse_double(std::string const &str, double &value) {
+  char *end = nullptr;
+  value = std::strtod(str.c_str(), &end);
+  return !str.empty() && end == str.c_str() + str.size();
+}
+
+double median_runtime(ResultRecord const &record) {
+  if (record.samples.empty()) {
+    return record.runtime;
+  }
+  return SampleStatistics::compute(record.samples).median;
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Formats problem arguments, ignoring empty values
+std::string ResultRecord::problem_string(std::vector<std::pair<std::string, std::string>> const &arguments) {
+
+  std::vector<std::pair<std::string, std::string>> sorted(arguments);
+  std::sort(sorted.begin(), sorted.end());
+
+  std::string problem;
+  for (auto const &arg : sorted) {
+    if (!arg.second.empty()) {
+      problem += (problem.empty() ? "--" : " --") + arg.first + "=" + arg.second;
+    }
+  }
+  return problem;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+ResultsDatabase::Key ResultsDatabase::key(ResultRecord const &record) {
+  return Key(record.device, record.provider, record.operation, record.problem);
+}
+
+/// Writes the header line of a database file
+std::ostream &ResultsDatabase::write_header(std::ostream &out) {
+  return out << kResultsDatabaseHeader << "\n";
+}
+
+/// Writes one record as a line
+std::ostream &ResultsDatabase::write(std::ostream &out, ResultRecord const &record) {
+
+  std::ostringstream line;
+  line << std::setprecision(9);
+
+  line
+    << sanitize_field(record.timestamp) << "\t"
+    << sanitize_field(record.device) << "\t"
+    << sanitize_field(record.provider) << "\t"
+    << sanitize_field(record.operation) << "\t"
+    << sanitize_field(record.problem) << "\t"
+    << record.runtime << "\t";
+
+  for (size_t i = 0; i < record.samples.size(); ++i) {
+    line << (i ? "," : "") << record.samples[i];
+  }
+
+  return out << line.str() << "\n";
+}
+
+/// Appends records to the database file at path, creating it if needed
+bool ResultsDatabase::append(std::string const &path, std::vector<ResultRecord> const &records) {
+
+  bool write_header_line = true;
+  {
+    std::ifstream existing(path);
+    if (existing.is_open() && existing.peek() != std::ifstream::traits_type::eof()) {
+      write_header_line = false;
+    }
+  }
+
+  std::ofstream out(path, std::ios::app);
+  if (!out.good()) {
+    return false;
+  }
+
+  if (write_header_line) {
+    write_header(out);
+  }
+
+  for (auto const &record : records) {
+    write(out, record);
+  }
+
+  out.flush();
+  return out.good();
+}
+
+/// Reads records from a database stream
+int ResultsDatabase::load(std::istream &in) {
+
+  std::string line;
+
+  if (!std::getline(in, line) || line != kResultsDatabaseHeader) {
+    return -1;
+  }
+
+  int count = 0;
+  while (std::getline(in, line)) {
+
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+
+    // Blank lines and headers of appended databases are skipped
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::vector<std::string> fields = split_fields(line, '\t');
+    if (fields.size() != 7) {
+      return -1;
+    }
+
+    ResultRecord record;
+    record.timestamp = fields[0];
+    record.device = fields[1];
+    record.provider = fields[2];
+    record.operation = fields[3];
+    record.problem = fields[4];
+
+    if (!parse_double(fields[5], record.runtime)) {
+      return -1;
+    }
+
+    if (!fields[6].empty()) {
+      for (auto const &field : split_fields(fields[6], ',')) {
+        double sample;
+        if (!parse_double(field, sample)) {
+          return -1;
+        }
+        record.samples.push_back(sample);
+      }
+    }
+
+    insert(record);
+    ++count;
+  }
+
+  return count;
+}
+
+/// Reads a database file
+int ResultsDatabase::load(std::string const &path) {
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    return -1;
+  }
+  return load(in);
+}
+
+/// Adds a record after all records with the same key
+void ResultsDatabase::insert(ResultRecord const &record) {
+  index_[key(record)].push_back(record);
+  ++size_;
+}
+
+/// Returns the most recently added record with a key, or nullptr
+ResultRecord const *ResultsDatabase::find(Key const &key) const {
+  auto it = index_.find(key);
+  if (it == index_.end() || it->second.empty()) {
+    return nullptr;
+  }
+  return &it->second.back();
+}
+
+/// Returns all records with a key, oldest first
+std::vector<ResultRecord> const *ResultsDatabase::history(Key const &key) const {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+/// Removes all records
+void ResultsDatabase::clear() {
+  index_.clear();
+  size_ = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+SampleStatistics SampleStatistics::compute(std::vector<double> const &samples) {
+
+  SampleStatistics stats;
+  stats.count = samples.size();
+
+  if (samples.empty()) {
+    return stats;
+  }
+
+  std::vector<double> sorted(samples);
+  std::sort(sorted.begin(), sorted.end());
+
+  size_t half = sorted.size() / 2;
+  stats.median = (sorted.size() % 2) ? sorted[half] : 0.5 * (sorted[half - 1] + sorted[half]);
+
+  double sum = 0;
+  for (double x : sorted) {
+    sum += x;
+  }
+  stats.mean = sum / double(stats.count);
+
+  if (stats.count > 1) {
+    double sum_sq = 0;
+    for (double x : sorted) {
+      sum_sq += (x - stats.mean) * (x - stats.mean);
+    }
+    stats.stddev = std::sqrt(sum_sq / double(stats.count - 1));
+  }
+
+  return stats;
+}
+
+/// Two-sided p-value of the Mann-Whitney U test
+double rank_sum_test(std::vector<double> const &a, std::vector<double> const &b) {
+
+  double n1 = double(a.size());
+  double n2 = double(b.size());
+
+  if (a.empty() || b.empty()) {
+    return 1;
+  }
+
+  // Pool the samples, remembering which set each came from
+  std::vector<std::pair<double, int>> pooled;
+  pooled.reserve(a.size() + b.size());
+  for (double x : a) {
+    pooled.emplace_back(x, 0);
+  }
+  for (double x : b) {
+    pooled.emplace_back(x, 1);
+  }
+  std::sort(pooled.begin(), pooled.end());
+
+  // Sum the ranks of the first set, giving tied samples their average rank
+  double rank_sum = 0;
+  double tie_correction = 0;
+
+  for (size_t i = 0; i < pooled.size(); ) {
+    size_t j = i;
+    while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+      ++j;
+    }
+
+    double ties = double(j - i);
+    double rank = 0.5 * double(i + j + 1);
+
+    for (size_t k = i; k < j; ++k) {
+      if (pooled[k].second == 0) {
+        rank_sum += rank;
+      }
+    }
+
+    tie_correction += ties * ties * ties - ties;
+    i = j;
+  }
+
+  double n = n1 + n2;
+  double u = rank_sum - n1 * (n1 + 1) / 2;
+  double mean = n1 * n2 / 2;
+  double variance = n1 * n2 / 12 * ((n + 1) - tie_correction / (n * (n - 1)));
+
+  if (!(variance > 0)) {
+    return 1;
+  }
+
+  double deviation = std::max(std::abs(u - mean) - 0.5, 0.0);
+  double z = deviation / std::sqrt(variance);
+
+  return std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+}
+
+char const *to_string(ComparisonVerdict verdict) {
+  switch (verdict) {
+    case ComparisonVerdict::kUnchanged: return "unchanged";
+    case ComparisonVerdict::kRegression: return "regression";
+    case ComparisonVerdict::kImprovement: return "improvement";
+    case ComparisonVerdict::kInconclusive: return "inconclusive";
+    case ComparisonVerdict::kNew: return "new";
+    default: break;
+  }
+  return "invalid";
+}
+
+/// Compares a result against a baseline result, which may be null
+ResultComparison compare_result(
+  ResultRecord const &current,
+  ResultRecord const *baseline,
+  ComparisonOptions const &options) {
+
+  ResultComparison comparison;
+  comparison.current = current;
+  comparison.current_median = median_runtime(current);
+
+  if (!baseline) {
+    comparison.verdict = ComparisonVerdict::kNew;
+    return comparison;
+  }
+
+  comparison.has_baseline = true;
+  comparison.baseline = *baseline;
+  comparison.baseline_median = median_runtime(*baseline);
+
+  if (comparison.baseline_median > 0) {
+    comparison.change = comparison.current_median / comparison.baseline_median - 1;
+  }
+
+  bool exceeds_threshold = std::abs(comparison.change) > options.threshold;
+
+  if (current.samples.size() < options.min_samples ||
+    baseline->samples.size() < options.min_samples) {
+
+    comparison.verdict = exceeds_threshold ?
+      ComparisonVerdict::kInconclusive : ComparisonVerdict::kUnchanged;
+
+    return comparison;
+  }
+
+  comparison.p_value = rank_sum_test(current.samples, baseline->samples);
+
+  if (exceeds_threshold && comparison.p_value < options.alpha) {
+    comparison.verdict = comparison.change > 0 ?
+      ComparisonVerdict::kRegression : ComparisonVerdict::kImprovement;
+  }
+  else {
+    comparison.verdict = ComparisonVerdict::kUnchanged;
+  }
+
+  return comparison;
+}
+
+/// Compares results against the latest records with the same key in a baseline database
+std::vector<ResultComparison> compare_results(
+  std::vector<ResultRecord> const &current,
+  ResultsDatabase const &baseline,
+  ComparisonOptions const &options) {
+
+  std::vector<ResultComparison> comparisons;
+  comparisons.reserve(current.size());
+
+  for (auto const &record : current) {
+    comparisons.push_back(compare_result(record, baseline.find(ResultsDatabase::key(record)), options));
+  }
+
+  return comparisons;
+}
+
+/// Prints comparisons as a table followed by the number of results with each verdict
+std::ostream &print_comparisons(std::ostream &out, std::vector<ResultComparison> const &comparisons) {
+
+  std::map<ComparisonVerdict, int> counts;
+
+  out << std::left
+    << std::setw(14) << "Verdict"
+    << std::setw(14) << "Baseline(ms)"
+    << std::setw(14) << "Current(ms)"
+    << std::setw(10) << "Change"
+    << std::setw(10) << "p-value"
+    << "Provider,Operation,Problem\n";
+
+  for (auto const &comparison : comparisons) {
+
+    ++counts[comparison.verdict];
+
+    if (comparison.verdict == ComparisonVerdict::kUnchanged) {
+      continue;
+    }
+
+    std::ostringstream baseline_median, change, p_value;
+
+    if (comparison.has_baseline) {
+      baseline_median << std::setprecision(4) << comparison.baseline_median;
+      change << std::showpos << std::fixed << std::setprecision(1) << comparison.change * 100 << "%";
+      p_value << std::setprecision(2) << comparison.p_value;
+    }
+
+    std::ostringstream current_median;
+    current_median << std::setprecision(4) << comparison.current_median;
+
+    out
+      << std::setw(14) << to_string(comparison.verdict)
+      << std::setw(14) << (comparison.has_baseline ? baseline_median.str() : "-")
+      << std::setw(14) << current_median.str()
+      << std::setw(10) << (comparison.has_baseline ? change.str() : "-")
+      << std::setw(10) << (comparison.has_baseline ? p_value.str() : "-")
+      << comparison.current.provider << ","
+      << comparison.current.operation << ","
+      << comparison.current.problem << "\n";
+  }
+
+  out << std::right << "\n";
+
+  ComparisonVerdict const verdicts[] = {
+    ComparisonVerdict::kRegression,
+    ComparisonVerdict::kImprovement,
+    ComparisonVerdict::kInconclusive,
+    ComparisonVerdict::kNew,
+    ComparisonVerdict::kUnchanged
+  };
+
+  for (auto verdict : verdicts) {
+    out << "  " << to_string(verdict) << ": " << counts[verdict] << "\n";
+  }
+
+  return out;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
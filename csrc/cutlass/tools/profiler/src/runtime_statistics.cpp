@@ -0,0 +1,210 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Statistics of profiled runtimes and the number of iterations needed to measure them
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "cutlass/profiler/runtime_statistics.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Median of sorted values
+double sorted_median(std::vector<double> const &sorted) {
+  size_t half = sorted.size() / 2;
+  return (sorted.size() % 2) ? sorted[half] : 0.5 * (sorted[half - 1] + sorted[half]);
+}
+
+/// Quantile of sorted values, interpolating between the closest ranks
+double sorted_quantile(std::vector<double> const &sorted, double q) {
+
+  double h = q * double(sorted.size() - 1);
+  size_t lower = size_t(std::floor(h));
+  size_t upper = std::min(lower + 1, sorted.size() - 1);
+
+  return sorted[lower] + (h - double(lower)) * (sorted[upper] - sorted[lower]);
+}
+
+/// Two-sided critical value of the standard normal distribution for a confidence level
+double normal_critical_value(double confidence) {
+
+  double lower = 0;
+  double upper = 10;
+
+  for (int i = 0; i < 64; ++i) {
+    double z = 0.5 * (lower + upper);
+    if (std::erf(z / std::sqrt(2.0)) < confidence) {
+      lower = z;
+    }
+    else {
+      upper = z;
+    }
+  }
+
+  return 0.5 * (lower + upper);
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Width of the confidence interval of the median relative to the median
+double RuntimeStatistics::relative_width() const {
+  if (!(median > 0)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return (median_upper - median_lower) / median;
+}
+
+/// Computes statistics of samples after rejecting outliers
+RuntimeStatistics RuntimeStatistics::compute(
+  std::vector<double> const &samples,
+  double confidence,
+  double outlier_threshold) {
+
+  RuntimeStatistics stats;
+
+  if (samples.empty()) {
+    return stats;
+  }
+
+  std::vector<double> sorted(samples);
+  std::sort(sorted.begin(), sorted.end());
+
+  // Reject samples far from the median in units of the median absolute deviation, scaled to
+  // estimate the standard deviation of normally distributed samples
+  double median = sorted_median(sorted);
+
+  std::vector<double> deviations;
+  deviations.reserve(sorted.size());
+  for (double sample : sorted) {
+    deviations.push_back(std::abs(sample - median));
+  }
+  std::sort(deviations.begin(), deviations.end());
+
+  double limit = outlier_threshold * 1.4826 * sorted_median(deviations);
+
+  if (limit > 0) {
+    auto first = std::lower_bound(sorted.begin(), sorted.end(), median - limit);
+    auto last = std::upper_bound(sorted.begin(), sorted.end(), median + limit);
+
+    stats.rejected = sorted.size() - size_t(last - first);
+    sorted = std::vector<double>(first, last);
+  }
+
+  size_t n = sorted.size();
+
+  stats.count = n;
+  stats.min = sorted.front();
+  stats.median = sorted_median(sorted);
+  stats.p90 = sorted_quantile(sorted, 0.9);
+
+  // The ranks bounding the median with the given confidence follow from the normal
+  // approximation of the binomial distribution of the number of samples below the median
+  double spread = 0.5 * normal_critical_value(confidence) * std::sqrt(double(n));
+
+  double lower_rank = std::round(0.5 * double(n) - spread);
+  double upper_rank = std::round(0.5 * double(n) + spread) + 1;
+
+  stats.median_lower = sorted[size_t(std::max(lower_rank, 1.0)) - 1];
+  stats.median_upper = sorted[size_t(std::min(upper_rank, double(n))) - 1];
+
+  return stats;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+RuntimeSampler::RuntimeSampler(
+  int iterations,
+  double relative_width,
+  double duration,
+  int min_iterations,
+  int max_iterations):
+  iterations_(iterations),
+  relative_width_(relative_width),
+  duration_(duration),
+  min_iterations_(std::max(min_iterations, 1)),
+  max_iterations_(std::max(max_iterations, min_iterations_)),
+  batches_(0),
+  elapsed_(0) { }
+
+/// Number of iterations of the next batch, or zero if profiling is complete
+int RuntimeSampler::next_batch() const {
+
+  int count = int(samples_.size());
+
+  if (!batches_) {
+    return iterations_ > 0 ? iterations_ : min_iterations_;
+  }
+
+  if (iterations_ > 0 || !count || count >= max_iterations_ || elapsed_ >= duration_ || converged()) {
+    return 0;
+  }
+
+  // Double the number of samples, without exceeding the time budget at the observed rate
+  double remaining = (duration_ - elapsed_) / (elapsed_ / double(count));
+  double batch = std::min(double(count), std::ceil(remaining));
+
+  return std::max(1, std::min(int(batch), max_iterations_ - count));
+}
+
+/// Adds the runtime of each iteration of a batch in ms
+void RuntimeSampler::add(std::vector<double> const &samples) {
+
+  for (double sample : samples) {
+    elapsed_ += sample;
+  }
+
+  ++batches_;
+  samples_.insert(samples_.end(), samples.begin(), samples.end());
+  statistics_ = RuntimeStatistics::compute(samples_);
+}
+
+/// True if the confidence interval of the median is narrower than the requested width
+bool RuntimeSampler::converged() const {
+  return int(statistics_.count) >= min_iterations_ &&
+    statistics_.relative_width() <= relative_width_;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
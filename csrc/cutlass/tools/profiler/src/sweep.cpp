@@ -0,0 +1,408 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Sharding, checkpointing and merging of profiler sweeps
+*/
+
+#include <cstdint>
+#include <exception>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <sstream>
+
+#include "cutlass/profiler/sweep.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// First line of every checkpoint file
+char const *kSweepCheckpointHeader = "# cutlass_profiler checkpoint v1";
+
+/// 64-bit FNV-1a hash, which is identical on every platform
+uint64_t fnv1a(std::string const &str, uint64_t hash = 0xcbf29ce484222325ull) {
+  for (char c : str) {
+    hash ^= uint64_t(uint8_t(c));
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+/// Splits a line into comma-separated fields
+std::vector<std::string> split_csv(std::string const &line) {
+  std::vector<std::string> fields;
+  std::string field;
+  std::istringstream ss(line);
+  while (std::getline(ss, field, ',')) {
+    fields.push_back(field);
+  }
+  if (!line.empty() && line.back() == ',') {
+    fields.push_back(std::string());
+  }
+  return fields;
+}
+
+/// Reads a line, removing a trailing carriage return
+bool read_line(std::istream &in, std::string &line) {
+  if (!std::getline(in, line)) {
+    return false;
+  }
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();
+  }
+  return true;
+}
+
+/// Sets the error message if requested
+void set_error(std::string *error, std::string const &message) {
+  if (error) {
+    *error = message;
+  }
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Parses '<index>/<count>'
+bool SweepShard::parse(std::string const &str, SweepShard &shard) {
+
+  size_t slash = str.find('/');
+  if (slash == std::string::npos || slash == 0 || slash + 1 == str.size()) {
+    return false;
+  }
+
+  try {
+    size_t end = 0;
+    int index = std::stoi(str.substr(0, slash), &end);
+    if (end != slash) {
+      return false;
+    }
+
+    std::string count_str = str.substr(slash + 1);
+    int count = std::stoi(count_str, &end);
+    if (end != count_str.size()) {
+      return false;
+    }
+
+    if (count < 1 || index < 0 || index >= count) {
+      return false;
+    }
+
+    shard = SweepShard(index, count);
+  }
+  catch (std::exception const &) {
+    return false;
+  }
+
+  return true;
+}
+
+/// Returns true if the pair is assigned to this shard
+bool SweepShard::contains(std::string const &operation, std::string const &problem) const {
+  if (count <= 1) {
+    return true;
+  }
+  uint64_t hash = fnv1a(problem, fnv1a("\t", fnv1a(operation)));
+  return int(hash % uint64_t(count)) == index;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Reads the pairs recorded at path and opens it for appending
+bool SweepCheckpoint::open(std::string const &path) {
+
+  completed_.clear();
+
+  if (file_.is_open()) {
+    file_.close();
+  }
+
+  bool write_header_line = true;
+
+  {
+    std::ifstream in(path, std::ios::binary);
+
+    if (in.is_open() && in.peek() != std::ifstream::traits_type::eof()) {
+
+      std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+      std::istringstream lines(contents);
+      std::string line;
+
+      if (!read_line(lines, line) || line != kSweepCheckpointHeader) {
+        return false;
+      }
+
+      write_header_line = false;
+
+      bool terminated = (contents.back() == '\n');
+
+      while (read_line(lines, line)) {
+
+        // The last line is incomplete if the file does not end with a newline
+        if (lines.eof() && !terminated) {
+          break;
+        }
+
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos) {
+          continue;
+        }
+
+        completed_.emplace(line.substr(0, tab), line.substr(tab + 1));
+      }
+
+      // Drop the incomplete line, so pairs are appended after the last complete one
+      if (!terminated) {
+        in.close();
+
+        size_t end = contents.rfind('\n');
+        write_header_line = (end == std::string::npos);
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << contents.substr(0, write_header_line ? 0 : end + 1);
+        if (!out.good()) {
+          return false;
+        }
+      }
+    }
+  }
+
+  file_.open(path, std::ios::app);
+  if (!file_.good()) {
+    return false;
+  }
+
+  if (write_header_line) {
+    file_ << kSweepCheckpointHeader << "\n";
+  }
+
+  file_.flush();
+  return file_.good();
+}
+
+/// Returns true if the pair has been recorded
+bool SweepCheckpoint::completed(std::string const &operation, std::string const &problem) const {
+  return completed_.count(std::make_pair(operation, problem)) != 0;
+}
+
+/// Records a pair, flushing it to the file
+void SweepCheckpoint::record(std::string const &operation, std::string const &problem) {
+
+  if (!completed_.emplace(operation, problem).second) {
+    return;
+  }
+
+  if (file_.is_open()) {
+    file_ << operation << "\t" << problem << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Merges CSV reports of the same operation kind written by the shards of a sweep
+int merge_reports(
+  std::vector<std::istream *> const &inputs,
+  std::ostream &out,
+  std::string *error) {
+
+  std::string header;
+  std::vector<std::string> columns;
+
+  // Columns identifying the problem and the result within it
+  size_t problem_column = 0;
+  std::vector<size_t> argument_columns;
+  std::vector<size_t> result_columns;
+
+  // Rows in order of first appearance, keyed by result
+  std::vector<std::vector<std::string>> rows;
+  std::map<std::string, size_t> row_index;
+
+  for (size_t input_idx = 0; input_idx < inputs.size(); ++input_idx) {
+
+    std::istream &in = *inputs[input_idx];
+    std::string line;
+
+    // Empty reports are written by shards assigned no results
+    if (!read_line(in, line)) {
+      continue;
+    }
+
+    if (header.empty()) {
+
+      header = line;
+      columns = split_csv(header);
+
+      size_t status_column = columns.size();
+      size_t bytes_column = columns.size();
+
+      for (size_t idx = 0; idx < columns.size(); ++idx) {
+        if (columns[idx] == "Problem") {
+          problem_column = idx;
+        }
+        else if (columns[idx] == "Status") {
+          status_column = idx;
+        }
+        else if (columns[idx] == "Bytes") {
+          bytes_column = idx;
+        }
+      }
+
+      if (status_column >= bytes_column || columns[problem_column] != "Problem") {
+        set_error(error, "input " + std::to_string(input_idx) + " is not a profiler report");
+        return -1;
+      }
+
+      for (size_t idx = status_column + 1; idx < bytes_column; ++idx) {
+        argument_columns.push_back(idx);
+      }
+
+      // Pivot tags, provider, operation kind and operation
+      for (size_t idx = 0; idx < status_column; ++idx) {
+        if (idx != problem_column && columns[idx] != "Disposition") {
+          result_columns.push_back(idx);
+        }
+      }
+    }
+    else if (line != header) {
+      set_error(error, "input " + std::to_string(input_idx) + " has a different header");
+      return -1;
+    }
+
+    while (read_line(in, line)) {
+
+      // Headers of appended reports are skipped
+      if (line.empty() || line == header) {
+        continue;
+      }
+
+      std::vector<std::string> row = split_csv(line);
+
+      // Rows left incomplete by a crash are skipped
+      if (row.size() != columns.size()) {
+        continue;
+      }
+
+      std::string key;
+      for (size_t idx : result_columns) {
+        key += row[idx] + ",";
+      }
+      for (size_t idx : argument_columns) {
+        key += row[idx] + ",";
+      }
+
+      auto it = row_index.find(key);
+      if (it == row_index.end()) {
+        row_index.emplace(key, rows.size());
+        rows.push_back(row);
+      }
+      else {
+        rows[it->second] = row;
+      }
+    }
+  }
+
+  if (header.empty()) {
+    return 0;
+  }
+
+  out << header << "\n";
+
+  // Renumber problems by their arguments in order of first appearance
+  std::map<std::string, size_t> problem_index;
+
+  for (auto &row : rows) {
+
+    std::string problem;
+    for (size_t idx : argument_columns) {
+      problem += row[idx] + ",";
+    }
+
+    auto it = problem_index.emplace(problem, problem_index.size() + 1).first;
+    row[problem_column] = std::to_string(it->second);
+
+    for (size_t idx = 0; idx < row.size(); ++idx) {
+      out << (idx ? "," : "") << row[idx];
+    }
+    out << "\n";
+  }
+
+  return int(rows.size());
+}
+
+/// Merges the CSV reports at paths into a report at output_path
+int merge_reports(
+  std::vector<std::string> const &paths,
+  std::string const &output_path,
+  std::string *error) {
+
+  std::vector<std::ifstream> files(paths.size());
+  std::vector<std::istream *> inputs;
+
+  for (size_t idx = 0; idx < paths.size(); ++idx) {
+    files[idx].open(paths[idx]);
+    if (!files[idx].is_open()) {
+      set_error(error, "could not read '" + paths[idx] + "'");
+      return -1;
+    }
+    inputs.push_back(&files[idx]);
+  }
+
+  std::ostringstream merged;
+
+  int rows = merge_reports(inputs, merged, error);
+  if (rows < 0) {
+    return rows;
+  }
+
+  std::ofstream out(output_path);
+  out << merged.str();
+  out.flush();
+
+  if (!out.good()) {
+    set_error(error, "could not write '" + output_path + "'");
+    return -1;
+  }
+
+  return rows;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,202 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Verification of profiled results on worker threads
+*/
+
+#include <exception>
+
+#include "cutlass/profiler/verification_pipeline.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Sets the disposition of a verified result to the worst outcome of its verification providers
+void update_disposition(PerformanceResult &result) {
+
+  bool is_any_verification_run_passed = false;
+
+  for (auto const &m : result.verification_map) {
+    if (m.second == Disposition::kFailed || m.second == Disposition::kIncorrect) {
+      result.disposition = m.second;
+      return;
+    }
+    if (m.second == Disposition::kPassed) {
+      is_any_verification_run_passed = true;
+    }
+  }
+
+  if (is_any_verification_run_passed) {
+    result.disposition = Disposition::kPassed;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+VerificationPipeline::VerificationPipeline(
+  int thread_count,
+  size_t capacity,
+  ReportFunction report):
+  capacity_(capacity), report_(std::move(report)), queued_bytes_(0), stopping_(false) {
+
+  for (int i = 0; i < thread_count; ++i) {
+    workers_.emplace_back(&VerificationPipeline::work_, this);
+  }
+}
+
+VerificationPipeline::~VerificationPipeline() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  task_queued_.notify_all();
+
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+/// Worker thread body
+void VerificationPipeline::work_() {
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    task_queued_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+
+    if (tasks_.empty()) {
+      return;
+    }
+
+    Task task = std::move(tasks_.front());
+    tasks_.pop_front();
+
+    lock.unlock();
+
+    Disposition disposition;
+    try {
+      disposition = task.verification.verify();
+    }
+    catch (std::exception const &) {
+      disposition = Disposition::kFailed;
+    }
+
+    // Release host copies before reporting the memory as free
+    task.verification.verify = nullptr;
+
+    lock.lock();
+
+    PerformanceResult &result = task.entry->results.at(task.verification.result_index);
+
+    result.verification_map[task.verification.provider] = disposition;
+    update_disposition(result);
+
+    --task.entry->pending;
+    queued_bytes_ -= task.verification.bytes;
+
+    task_completed_.notify_all();
+  }
+}
+
+/// Reports completed entries at the front of the queue
+void VerificationPipeline::report_completed_(std::unique_lock<std::mutex> &lock) {
+
+  while (!entries_.empty() && !entries_.front()->pending) {
+
+    std::shared_ptr<Entry> entry = entries_.front();
+    entries_.pop_front();
+
+    // Completed entries are no longer touched by workers
+    lock.unlock();
+    report_(entry->results, entry->problem_index);
+    lock.lock();
+  }
+}
+
+/// Queues the results of an operation along with their deferred verifications
+void VerificationPipeline::submit(
+  PerformanceResultVector const &results,
+  size_t problem_index,
+  DeferredVerificationVector verifications) {
+
+  size_t bytes = 0;
+  for (auto const &verification : verifications) {
+    bytes += verification.bytes;
+  }
+
+  std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+  entry->results = results;
+  entry->problem_index = problem_index;
+  entry->pending = verifications.size();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  report_completed_(lock);
+
+  // Bound the memory held by queued verifications. A verification larger than the capacity
+  // is queued once the pipeline is otherwise empty.
+  while (queued_bytes_ && queued_bytes_ + bytes > capacity_) {
+    task_completed_.wait(lock);
+    report_completed_(lock);
+  }
+
+  entries_.push_back(entry);
+
+  for (auto &verification : verifications) {
+    tasks_.push_back(Task{entry, std::move(verification)});
+  }
+  queued_bytes_ += bytes;
+
+  report_completed_(lock);
+
+  lock.unlock();
+  task_queued_.notify_all();
+}
+
+/// Waits for all queued verifications and reports the remaining results
+void VerificationPipeline::finish() {
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  report_completed_(lock);
+
+  while (!entries_.empty()) {
+    task_completed_.wait(lock);
+    report_completed_(lock);
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
@@ -0,0 +1,462 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#pragma once
+
+/**
+ * \file
+ * \brief Host memory allocations with configurable alignment, transparent huge pages and
+ *   first-touch placement, and an arena that recycles them.
+ *
+ * Memory is zero-initialized by the threads that later work on it: each task of
+ * TensorForEachParallel touches the same chunk of a packed tensor, so on NUMA hosts the pages of
+ * a chunk are placed on the node of the thread that fills and compares it.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "cutlass/numeric_types.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
+
+namespace cutlass {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Placement of a host allocation
+struct HostAllocationPolicy {
+
+  /// Alignment in bytes of the allocation. Rounded up to a power of two of at least
+  /// alignof(std::max_align_t).
+  size_t alignment;
+
+  /// If true, allocations of at least kHugePageSize bytes are aligned to huge pages and
+  /// advised to be backed by transparent huge pages (Linux only)
+  bool huge_pages;
+
+  /// If true, memory is zero-initialized in parallel with the chunking of TensorForEachParallel
+  /// rather than by the allocating thread
+  bool first_touch;
+
+  /// Size of a transparent huge page
+  static constexpr size_t kHugePageSize = (size_t(2) << 20);
+
+  HostAllocationPolicy(
+    size_t alignment_ = 64,
+    bool huge_pages_ = false,
+    bool first_touch_ = true
+  ):
+    alignment(alignment_), huge_pages(huge_pages_), first_touch(first_touch_) { }
+
+  /// Alignment used for an allocation of a given size
+  size_t alignment_for(size_t bytes) const {
+    size_t result = alignof(std::max_align_t);
+    while (result < alignment) {
+      result *= 2;
+    }
+    if (huge_pages && bytes >= kHugePageSize) {
+      result = std::max(result, kHugePageSize);
+    }
+    return result;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace host_memory {
+
+/// Allocates at least \p bytes bytes, updating \p bytes to the size of the allocation. Throws
+/// std::bad_alloc on failure.
+inline void *allocate(size_t &bytes, HostAllocationPolicy const &policy = HostAllocationPolicy()) {
+
+  size_t alignment = policy.alignment_for(bytes);
+  bytes = (std::max(bytes, size_t(1)) + alignment - 1) / alignment * alignment;
+
+  void *ptr = nullptr;
+
+#if defined(_WIN32)
+  ptr = _aligned_malloc(bytes, alignment);
+#else
+  if (posix_memalign(&ptr, alignment, bytes)) {
+    ptr = nullptr;
+  }
+#endif
+
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (alignment >= HostAllocationPolicy::kHugePageSize) {
+    madvise(ptr, bytes, MADV_HUGEPAGE);
+  }
+#endif
+
+  return ptr;
+}
+
+/// Frees memory obtained from allocate()
+inline void free(void *ptr) {
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+/// Zero-fills \p bytes bytes, distributing consecutive chunks of \p chunk_bytes bytes over
+/// OpenMP threads exactly as TensorForEachParallel distributes chunks of a tensor
+inline void first_touch(void *ptr, size_t bytes, size_t chunk_bytes) {
+
+  char *data = static_cast<char *>(ptr);
+  int64_t chunk_count = int64_t((bytes + chunk_bytes - 1) / chunk_bytes);
+
+  if (chunk_count <= 1) {
+    std::memset(data, 0, bytes);
+    return;
+  }
+
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int64_t chunk = 0; chunk < chunk_count; ++chunk) {
+    size_t begin = size_t(chunk) * chunk_bytes;
+    std::memset(data + begin, 0, std::min(chunk_bytes, bytes - begin));
+  }
+}
+
+/// Number of bytes occupied by \p count elements of type T
+template <typename T>
+size_t bytes(size_t count) {
+  size_t result = count * sizeof_bits<T>::value / 8;
+  return (result == 0 && count > 0) ? 1 : result;
+}
+
+/// Copies \p count elements between host buffers
+template <typename T>
+void copy(T *dst, T const *src, size_t count = 1) {
+  size_t result = bytes<T>(count);
+  if (result) {
+    std::memcpy(static_cast<void *>(dst), static_cast<void const *>(src), result);
+  }
+}
+
+}  // namespace host_memory
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Recycles host allocations. Test suites sharing an arena across problems reuse the buffers
+/// of earlier problems instead of returning them to the system and faulting in new pages.
+///
+/// An arena must outlive the allocations taken from it. Its methods may be called concurrently.
+class HostArena {
+private:
+
+  struct Block {
+    void *ptr;
+    size_t alignment;
+  };
+
+  /// Cached blocks by size in bytes
+  std::multimap<size_t, Block> blocks_;
+
+  /// Guards all members
+  mutable std::mutex mutex_;
+
+  size_t cached_bytes_;
+  size_t hits_;
+  size_t misses_;
+
+public:
+
+  HostArena(): cached_bytes_(0), hits_(0), misses_(0) { }
+
+  HostArena(HostArena const &) = delete;
+  HostArena &operator=(HostArena const &) = delete;
+
+  ~HostArena() { trim(); }
+
+  /// Returns a cached block of at least \p bytes and at most twice as many bytes placed
+  /// according to \p policy, or allocates a new one. Updates \p bytes to the size of the block
+  /// and \p alignment to its alignment.
+  void *acquire(size_t &bytes, size_t &alignment, HostAllocationPolicy const &policy) {
+
+    alignment = policy.alignment_for(bytes);
+    bool huge_pages = (alignment >= HostAllocationPolicy::kHugePageSize);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      for (auto it = blocks_.lower_bound(bytes);
+        it != blocks_.end() && it->first <= 2 * std::max(bytes, size_t(1)); ++it) {
+
+        bool block_huge_pages = (it->second.alignment >= HostAllocationPolicy::kHugePageSize);
+
+        if (it->second.alignment % alignment == 0 && block_huge_pages == huge_pages) {
+          void *ptr = it->second.ptr;
+          bytes = it->first;
+          alignment = it->second.alignment;
+          cached_bytes_ -= bytes;
+          ++hits_;
+          blocks_.erase(it);
+          return ptr;
+        }
+      }
+      ++misses_;
+    }
+
+    return host_memory::allocate(bytes, policy);
+  }
+
+  /// Returns a block obtained from acquire() to the arena
+  void release(void *ptr, size_t bytes, size_t alignment) {
+    if (!ptr) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    blocks_.insert({bytes, Block{ptr, alignment}});
+    cached_bytes_ += bytes;
+  }
+
+  /// Frees all cached blocks
+  void trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto const &block : blocks_) {
+      host_memory::free(block.second.ptr);
+    }
+    blocks_.clear();
+    cached_bytes_ = 0;
+  }
+
+  /// Number of bytes held in cached blocks
+  size_t cached_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cached_bytes_;
+  }
+
+  /// Number of acquisitions served from cached blocks
+  size_t hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  /// Number of acquisitions that allocated a new block
+  size_t misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Zero-initialized host allocation of objects of type T, optionally recycled through a HostArena.
+/// T must be trivially copyable; sub-byte types are allocated as whole storage objects.
+template <typename T>
+class HostAllocation {
+private:
+
+  T *ptr_;
+  size_t capacity_;
+
+  /// Size, alignment and owning arena of the current block
+  size_t bytes_;
+  size_t alignment_;
+  HostArena *owner_;
+
+  /// Placement and arena of subsequent allocations
+  HostAllocationPolicy policy_;
+  HostArena *arena_;
+
+public:
+
+  /// Constructor: allocates no memory
+  HostAllocation(
+    HostAllocationPolicy const &policy = HostAllocationPolicy(),
+    HostArena *arena = nullptr
+  ):
+    ptr_(nullptr), capacity_(0), bytes_(0), alignment_(0), owner_(nullptr),
+    policy_(policy), arena_(arena) { }
+
+  /// Constructor: allocates \p capacity elements
+  explicit HostAllocation(
+    size_t capacity,
+    HostAllocationPolicy const &policy = HostAllocationPolicy(),
+    HostArena *arena = nullptr
+  ):
+    HostAllocation(policy, arena) {
+
+    reset(capacity);
+  }
+
+  /// Copy constructor: allocates with the policy and arena of \p p
+  HostAllocation(HostAllocation const &p): HostAllocation(p.policy_, p.arena_) {
+    reset(p.capacity_);
+    if (capacity_) {
+      std::memcpy(static_cast<void *>(ptr_), p.ptr_, capacity_ * sizeof(T));
+    }
+  }
+
+  /// Move constructor
+  HostAllocation(HostAllocation &&p): HostAllocation(p.policy_, p.arena_) {
+    swap(p);
+  }
+
+  /// Destructor
+  ~HostAllocation() { reset(); }
+
+  /// Copies a host-side allocation
+  HostAllocation &operator=(HostAllocation const &p) {
+    if (this != &p) {
+      if (capacity_ != p.capacity_) {
+        reset(p.capacity_);
+      }
+      if (capacity_) {
+        std::memcpy(static_cast<void *>(ptr_), p.ptr_, capacity_ * sizeof(T));
+      }
+    }
+    return *this;
+  }
+
+  /// Move assignment
+  HostAllocation &operator=(HostAllocation &&p) {
+    swap(p);
+    return *this;
+  }
+
+  void swap(HostAllocation &p) {
+    std::swap(ptr_, p.ptr_);
+    std::swap(capacity_, p.capacity_);
+    std::swap(bytes_, p.bytes_);
+    std::swap(alignment_, p.alignment_);
+    std::swap(owner_, p.owner_);
+    std::swap(policy_, p.policy_);
+    std::swap(arena_, p.arena_);
+  }
+
+  /// Sets the placement and arena of subsequent allocations. The current allocation, if any, is
+  /// still returned to the arena it was taken from.
+  void set_policy(HostAllocationPolicy const &policy, HostArena *arena = nullptr) {
+    policy_ = policy;
+    arena_ = arena;
+  }
+
+  /// Placement of allocations
+  HostAllocationPolicy const &policy() const {
+    return policy_;
+  }
+
+  /// Arena of allocations, if any
+  HostArena *arena() const {
+    return arena_;
+  }
+
+  /// Releases the allocation and resets capacity to zero
+  void reset() {
+    if (ptr_) {
+      if (owner_) {
+        owner_->release(ptr_, bytes_, alignment_);
+      }
+      else {
+        host_memory::free(ptr_);
+      }
+    }
+    ptr_ = nullptr;
+    capacity_ = 0;
+    bytes_ = 0;
+  }
+
+  /// Releases the allocation and allocates \p capacity zero-initialized elements
+  void reset(size_t capacity) {
+    reset();
+    if (!capacity) {
+      return;
+    }
+
+    size_t bytes = capacity * sizeof(T);
+    size_t alignment = 0;
+    void *ptr = (arena_ ?
+      arena_->acquire(bytes, alignment, policy_) : host_memory::allocate(bytes, policy_));
+
+    // Blocks may be larger than requested, but only the elements are touched
+    if (policy_.first_touch) {
+      host_memory::first_touch(ptr, capacity * sizeof(T),
+        host_memory::bytes<T>(size_t(reference::host::detail::kTensorForEachChunkSize)));
+    }
+    else {
+      std::memset(ptr, 0, capacity * sizeof(T));
+    }
+
+    ptr_ = static_cast<T *>(ptr);
+    capacity_ = capacity;
+    bytes_ = bytes;
+    alignment_ = alignment;
+    owner_ = arena_;
+  }
+
+  /// Returns a pointer to the elements
+  T *get() const { return ptr_; }
+
+  /// Returns the number of elements
+  size_t size() const { return capacity_; }
+
+  /// Returns the number of bytes of the elements
+  size_t bytes() const { return capacity_ * sizeof(T); }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace host_memory {
+
+/// Host allocation abstraction that tracks size and placement
+template <typename T>
+using allocation = cutlass::HostAllocation<T>;
+
+}  // namespace host_memory
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
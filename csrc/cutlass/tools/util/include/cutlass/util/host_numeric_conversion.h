@@ -0,0 +1,618 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Bulk host-side conversion between fp32 and half_t, bfloat16_t, float_e4m3_t and
+      float_e5m2_t.
+
+    The SIMD paths (AVX2/F16C and AVX-512, using AVX512-BF16 where present) are selected at
+    runtime from CPUID and are bit-exact with the software scalar conversions of each element
+    type, including round-to-nearest-even, saturation of float8 and canonical NaN encodings.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cutlass/numeric_types.h"
+#include "cutlass/numeric_conversion.h"
+
+#ifndef CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+#if !defined(__CUDACC_RTC__) && !defined(__CUDA_ARCH__) && (defined(__x86_64__) || defined(_M_X64))
+#define CUTLASS_ENABLE_HOST_SIMD_CONVERSION 1
+#else
+#define CUTLASS_ENABLE_HOST_SIMD_CONVERSION 0
+#endif
+#endif
+
+#if defined(__CUDA_ARCH__)
+#undef CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+#define CUTLASS_ENABLE_HOST_SIMD_CONVERSION 0
+#endif
+
+#if CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CUTLASS_HOST_SIMD_TARGET(isa)
+#else
+#include <cpuid.h>
+#define CUTLASS_HOST_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// AVX512-BF16 intrinsics are available from GCC 10 and Clang 9
+#if (defined(__clang__) && (__clang_major__ >= 9)) || \
+    (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ >= 10))
+#define CUTLASS_HOST_SIMD_AVX512_BF16 1
+#else
+#define CUTLASS_HOST_SIMD_AVX512_BF16 0
+#endif
+
+#endif // CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+
+namespace cutlass {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Instruction set used by host array conversions
+enum class HostSimdIsa {
+  kScalar,
+  kAvx2,          ///< AVX2 and F16C
+  kAvx512         ///< AVX-512 F, BW and VL, plus AVX512-BF16 if present
+};
+
+namespace detail {
+
+/// x86 extensions usable by host array conversions, queried once
+class HostSimdFeatures {
+
+  bool avx2_;
+  bool avx512_;
+  bool avx512_bf16_;
+
+  HostSimdFeatures(): avx2_(false), avx512_(false), avx512_bf16_(false) {
+  #if CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+    unsigned leaf1[4] = {0, 0, 0, 0};
+    unsigned leaf7[4] = {0, 0, 0, 0};
+    unsigned leaf7_1[4] = {0, 0, 0, 0};
+    unsigned long long xcr0 = 0;
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+      int regs[4];
+      __cpuid(regs, 0);
+      int max_leaf = regs[0];
+
+      __cpuidex(regs, 1, 0);
+      for (int i = 0; i < 4; ++i) { leaf1[i] = unsigned(regs[i]); }
+
+      if (max_leaf >= 7) {
+        __cpuidex(regs, 7, 0);
+        for (int i = 0; i < 4; ++i) { leaf7[i] = unsigned(regs[i]); }
+        __cpuidex(regs, 7, 1);
+        for (int i = 0; i < 4; ++i) { leaf7_1[i] = unsigned(regs[i]); }
+      }
+
+      if (leaf1[2] & (1u << 27)) {
+        xcr0 = _xgetbv(0);
+      }
+    #else
+      unsigned max_leaf = __get_cpuid_max(0, nullptr);
+
+      __cpuid_count(1, 0, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+
+      if (max_leaf >= 7) {
+        __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+        __cpuid_count(7, 1, leaf7_1[0], leaf7_1[1], leaf7_1[2], leaf7_1[3]);
+      }
+
+      if (leaf1[2] & (1u << 27)) {
+        unsigned eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+      }
+    #endif
+
+    // The OS must save the YMM state, and additionally the opmask and ZMM state for AVX-512
+    bool ymm_state = (xcr0 & 0x6) == 0x6;
+    bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+
+    bool f16c = (leaf1[2] & (1u << 29)) != 0;
+    bool avx2 = (leaf7[1] & (1u << 5)) != 0;
+    bool avx512f = (leaf7[1] & (1u << 16)) != 0;
+    bool avx512bw = (leaf7[1] & (1u << 30)) != 0;
+    bool avx512vl = (leaf7[1] & (1u << 31)) != 0;
+    bool avx512bf16 = (leaf7_1[0] & (1u << 5)) != 0;
+
+    avx2_ = ymm_state && avx2 && f16c;
+    avx512_ = avx2_ && zmm_state && avx512f && avx512bw && avx512vl;
+    avx512_bf16_ = avx512_ && avx512bf16 && CUTLASS_HOST_SIMD_AVX512_BF16;
+  #endif
+  }
+
+public:
+
+  bool avx2() const {
+    return avx2_;
+  }
+
+  bool avx512() const {
+    return avx512_;
+  }
+
+  bool avx512_bf16() const {
+    return avx512_bf16_;
+  }
+
+  static HostSimdFeatures const &instance() {
+    static HostSimdFeatures features;
+    return features;
+  }
+};
+
+} // namespace detail
+
+/// Returns the widest instruction set available to host array conversions
+inline HostSimdIsa host_simd_isa() {
+  detail::HostSimdFeatures const &features = detail::HostSimdFeatures::instance();
+
+  if (features.avx512()) {
+    return HostSimdIsa::kAvx512;
+  }
+  if (features.avx2()) {
+    return HostSimdIsa::kAvx2;
+  }
+  return HostSimdIsa::kScalar;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Converts elements one at a time with the scalar conversion
+template <typename T, typename S>
+void host_convert_array_scalar(T *dst, S const *src, size_t count) {
+  NumericConverter<T, S> converter;
+
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = converter(src[i]);
+  }
+}
+
+/// Constants of the fp32 -> float8 conversion. Finite values round to nearest even and saturate
+/// to the largest finite value, infinities saturate, and NaN maps to the positive NaN encoding.
+template <typename Float8>
+struct HostFloat8Encoding {
+
+  static int const kMantissaBits = Float8::FP8_NUM_MANTISSA_BITS;
+  static int const kShift = 23 - kMantissaBits;
+
+  /// Rounding bias added below the round bit
+  static int32_t const kRoundBias = (1 << (kShift - 1)) - 1;
+
+  /// Difference of the fp32 and float8 exponent biases, aligned with the float8 exponent
+  static int32_t const kRebias = (127 - Float8::FP8_EXPONENT_BIAS) << kMantissaBits;
+
+  /// Bits of the smallest normal float8 value as fp32
+  static int32_t const kMinNormal = (Float8::FP8_MIN_EXPONENT + 127) << 23;
+
+  /// Bits of an fp32 value whose ulp equals the float8 subnormal spacing. Adding it to a magnitude
+  /// below kMinNormal rounds to the nearest subnormal with a single hardware rounding.
+  static int32_t const kSubnormalMagic = (Float8::FP8_MIN_EXPONENT - kMantissaBits + 23 + 127) << 23;
+
+  static int32_t const kMaxFinite = Float8::FP8_MAX_FLT;
+  static int32_t const kNaN = 0x7f;
+};
+
+/// Lookup table of the float values of all 256 float8 encodings
+template <typename Float8>
+struct HostFloat8Table {
+
+  float values[256];
+
+  HostFloat8Table() {
+    for (int i = 0; i < 256; ++i) {
+      values[i] = float(Float8::bitcast(uint8_t(i)));
+    }
+  }
+
+  static float const *instance() {
+    static HostFloat8Table table;
+    return table.values;
+  }
+};
+
+#if CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+
+//
+// AVX2 and F16C
+//
+
+CUTLASS_HOST_SIMD_TARGET("avx2,f16c")
+inline size_t host_convert_f32_to_f16_avx2(half_t *dst, float const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 x = _mm256_loadu_ps(src + i);
+    __m128i h = _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+    // The software conversion produces a single positive NaN
+    __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+    __m128i nan16 = _mm_packs_epi32(_mm256_castsi256_si128(nan), _mm256_extracti128_si256(nan, 1));
+    h = _mm_blendv_epi8(h, _mm_set1_epi16(0x7fff), nan16);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+  }
+  return i;
+}
+
+CUTLASS_HOST_SIMD_TARGET("avx2,f16c")
+inline size_t host_convert_f16_to_f32_avx2(float *dst, half_t const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    __m256 x = _mm256_cvtph_ps(h);
+
+    __m256i magnitude = _mm256_and_si256(_mm256_cvtepu16_epi32(h), _mm256_set1_epi32(0x7fff));
+    __m256i nan = _mm256_cmpgt_epi32(magnitude, _mm256_set1_epi32(0x7c00));
+    x = _mm256_blendv_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)), _mm256_castsi256_ps(nan));
+
+    _mm256_storeu_ps(dst + i, x);
+  }
+  return i;
+}
+
+/// Rounds fp32 bits to bfloat16 bits held in the low half of each lane
+CUTLASS_HOST_SIMD_TARGET("avx2,f16c")
+inline __m256i host_round_f32_to_bf16_avx2(__m256i bits) {
+  __m256i magnitude = _mm256_and_si256(bits, _mm256_set1_epi32(0x7fffffff));
+  __m256i nan = _mm256_cmpgt_epi32(magnitude, _mm256_set1_epi32(0x7f800000));
+
+  __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+  __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(_mm256_set1_epi32(0x7fff), odd));
+  rounded = _mm256_srli_epi32(rounded, 16);
+
+  return _mm256_blendv_epi8(rounded, _mm256_set1_epi32(0x7fff), nan);
+}
+
+CUTLASS_HOST_SIMD_TARGET("avx2,f16c")
+inline size_t host_convert_f32_to_bf16_avx2(bfloat16_t *dst, float const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    __m256i rounded = host_round_f32_to_bf16_avx2(bits);
+
+    __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(rounded), _mm256_extracti128_si256(rounded, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+  }
+  return i;
+}
+
+CUTLASS_HOST_SIMD_TARGET("avx2,f16c")
+inline size_t host_convert_bf16_to_f32_avx2(float *dst, bfloat16_t const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    __m256i bits = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), bits);
+  }
+  return i;
+}
+
+template <typename Float8>
+CUTLASS_HOST_SIMD_TARGET("avx2,f16c")
+inline size_t host_convert_f32_to_fp8_avx2(Float8 *dst, float const *src, size_t count) {
+  using Encoding = HostFloat8Encoding<Float8>;
+
+  __m256i const magic = _mm256_set1_epi32(Encoding::kSubnormalMagic);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    __m256i sign = _mm256_srli_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(int32_t(0x80000000u))), 24);
+    __m256i magnitude = _mm256_and_si256(bits, _mm256_set1_epi32(0x7fffffff));
+    __m256i nan = _mm256_cmpgt_epi32(magnitude, _mm256_set1_epi32(0x7f800000));
+
+    // Normal range: round the fp32 mantissa to nearest even and rebias the exponent
+    __m256i odd = _mm256_and_si256(_mm256_srli_epi32(magnitude, Encoding::kShift), _mm256_set1_epi32(1));
+    __m256i normal = _mm256_add_epi32(magnitude, _mm256_add_epi32(_mm256_set1_epi32(Encoding::kRoundBias), odd));
+    normal = _mm256_sub_epi32(_mm256_srli_epi32(normal, Encoding::kShift), _mm256_set1_epi32(Encoding::kRebias));
+
+    // Subnormal range: let the floating-point adder round to the subnormal spacing
+    __m256i subnormal = _mm256_sub_epi32(
+      _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(magnitude), _mm256_castsi256_ps(magic))), magic);
+
+    __m256i is_subnormal = _mm256_cmpgt_epi32(_mm256_set1_epi32(Encoding::kMinNormal), magnitude);
+    __m256i u = _mm256_blendv_epi8(normal, subnormal, is_subnormal);
+
+    u = _mm256_min_epi32(u, _mm256_set1_epi32(Encoding::kMaxFinite));
+    u = _mm256_or_si256(u, sign);
+    u = _mm256_blendv_epi8(u, _mm256_set1_epi32(Encoding::kNaN), nan);
+
+    __m128i u16 = _mm_packus_epi32(_mm256_castsi256_si128(u), _mm256_extracti128_si256(u, 1));
+    __m128i u8 = _mm_packus_epi16(u16, u16);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i), u8);
+  }
+  return i;
+}
+
+template <typename Float8>
+CUTLASS_HOST_SIMD_TARGET("avx2,f16c")
+inline size_t host_convert_fp8_to_f32_avx2(float *dst, Float8 const *src, size_t count) {
+  float const *table = HostFloat8Table<Float8>::instance();
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i u8 = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(src + i));
+    __m256 x = _mm256_i32gather_ps(table, _mm256_cvtepu8_epi32(u8), 4);
+    _mm256_storeu_ps(dst + i, x);
+  }
+  return i;
+}
+
+//
+// AVX-512
+//
+
+#define CUTLASS_HOST_SIMD_AVX512 "avx2,f16c,avx512f,avx512bw,avx512vl"
+
+CUTLASS_HOST_SIMD_TARGET(CUTLASS_HOST_SIMD_AVX512)
+inline size_t host_convert_f32_to_f16_avx512(half_t *dst, float const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512 x = _mm512_loadu_ps(src + i);
+    __m256i h = _mm512_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+    __mmask16 nan = _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+    h = _mm256_mask_mov_epi16(h, nan, _mm256_set1_epi16(0x7fff));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), h);
+  }
+  return i;
+}
+
+CUTLASS_HOST_SIMD_TARGET(CUTLASS_HOST_SIMD_AVX512)
+inline size_t host_convert_f16_to_f32_avx512(float *dst, half_t const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    __m512 x = _mm512_cvtph_ps(h);
+
+    __m512i magnitude = _mm512_and_si512(_mm512_cvtepu16_epi32(h), _mm512_set1_epi32(0x7fff));
+    __mmask16 nan = _mm512_cmpgt_epi32_mask(magnitude, _mm512_set1_epi32(0x7c00));
+    x = _mm512_mask_mov_ps(x, nan, _mm512_castsi512_ps(_mm512_set1_epi32(0x7fffffff)));
+
+    _mm512_storeu_ps(dst + i, x);
+  }
+  return i;
+}
+
+/// Rounds fp32 bits to bfloat16 bits held in the low half of each lane
+CUTLASS_HOST_SIMD_TARGET(CUTLASS_HOST_SIMD_AVX512)
+inline __m512i host_round_f32_to_bf16_avx512(__m512i bits) {
+  __m512i magnitude = _mm512_and_si512(bits, _mm512_set1_epi32(0x7fffffff));
+  __mmask16 nan = _mm512_cmpgt_epi32_mask(magnitude, _mm512_set1_epi32(0x7f800000));
+
+  __m512i odd = _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1));
+  __m512i rounded = _mm512_add_epi32(bits, _mm512_add_epi32(_mm512_set1_epi32(0x7fff), odd));
+  rounded = _mm512_srli_epi32(rounded, 16);
+
+  return _mm512_mask_mov_epi32(rounded, nan, _mm512_set1_epi32(0x7fff));
+}
+
+CUTLASS_HOST_SIMD_TARGET(CUTLASS_HOST_SIMD_AVX512)
+inline size_t host_convert_f32_to_bf16_avx512(bfloat16_t *dst, float const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512i bits = _mm512_loadu_si512(src + i);
+    __m256i packed = _mm512_cvtepi32_epi16(host_round_f32_to_bf16_avx512(bits));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), packed);
+  }
+  return i;
+}
+
+#if CUTLASS_HOST_SIMD_AVX512_BF16
+
+/// VCVTNEPS2BF16 rounds to nearest even but treats subnormal inputs as zero and quiets NaN
+/// payloads, so those lanes fall back to the integer rounding of the software conversion.
+CUTLASS_HOST_SIMD_TARGET(CUTLASS_HOST_SIMD_AVX512 ",avx512bf16")
+inline size_t host_convert_f32_to_bf16_avx512_bf16(bfloat16_t *dst, float const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512 x = _mm512_loadu_ps(src + i);
+    __m512i bits = _mm512_castps_si512(x);
+
+    __m256bh converted = _mm512_cvtneps_pbh(x);
+    __m256i packed;
+    __builtin_memcpy(&packed, &converted, sizeof(packed));
+
+    __m512i exponent = _mm512_and_si512(bits, _mm512_set1_epi32(0x7f800000));
+    __m512i magnitude = _mm512_and_si512(bits, _mm512_set1_epi32(0x7fffffff));
+    __mmask16 special =
+      _mm512_mask_cmpneq_epi32_mask(_mm512_cmpeq_epi32_mask(exponent, _mm512_setzero_si512()), magnitude, _mm512_setzero_si512()) |
+      _mm512_cmpgt_epi32_mask(magnitude, _mm512_set1_epi32(0x7f800000));
+
+    if (special) {
+      __m256i fallback = _mm512_cvtepi32_epi16(host_round_f32_to_bf16_avx512(bits));
+      packed = _mm256_mask_mov_epi16(packed, special, fallback);
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), packed);
+  }
+  return i;
+}
+
+#endif // CUTLASS_HOST_SIMD_AVX512_BF16
+
+CUTLASS_HOST_SIMD_TARGET(CUTLASS_HOST_SIMD_AVX512)
+inline size_t host_convert_bf16_to_f32_avx512(float *dst, bfloat16_t const *src, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + i));
+    __m512i bits = _mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16);
+    _mm512_storeu_si512(dst + i, bits);
+  }
+  return i;
+}
+
+template <typename Float8>
+CUTLASS_HOST_SIMD_TARGET(CUTLASS_HOST_SIMD_AVX512)
+inline size_t host_convert_f32_to_fp8_avx512(Float8 *dst, float const *src, size_t count) {
+  using Encoding = HostFloat8Encoding<Float8>;
+
+  __m512i const magic = _mm512_set1_epi32(Encoding::kSubnormalMagic);
+
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512i bits = _mm512_loadu_si512(src + i);
+    __m512i sign = _mm512_srli_epi32(_mm512_and_si512(bits, _mm512_set1_epi32(int32_t(0x80000000u))), 24);
+    __m512i magnitude = _mm512_and_si512(bits, _mm512_set1_epi32(0x7fffffff));
+    __mmask16 nan = _mm512_cmpgt_epi32_mask(magnitude, _mm512_set1_epi32(0x7f800000));
+
+    // Normal range: round the fp32 mantissa to nearest even and rebias the exponent
+    __m512i odd = _mm512_and_si512(_mm512_srli_epi32(magnitude, Encoding::kShift), _mm512_set1_epi32(1));
+    __m512i u = _mm512_add_epi32(magnitude, _mm512_add_epi32(_mm512_set1_epi32(Encoding::kRoundBias), odd));
+    u = _mm512_sub_epi32(_mm512_srli_epi32(u, Encoding::kShift), _mm512_set1_epi32(Encoding::kRebias));
+
+    // Subnormal range: let the floating-point adder round to the subnormal spacing
+    __mmask16 is_subnormal = _mm512_cmplt_epi32_mask(magnitude, _mm512_set1_epi32(Encoding::kMinNormal));
+    __m512i subnormal = _mm512_sub_epi32(
+      _mm512_castps_si512(_mm512_add_ps(_mm512_castsi512_ps(magnitude), _mm512_castsi512_ps(magic))), magic);
+    u = _mm512_mask_mov_epi32(u, is_subnormal, subnormal);
+
+    u = _mm512_min_epi32(u, _mm512_set1_epi32(Encoding::kMaxFinite));
+    u = _mm512_or_si512(u, sign);
+    u = _mm512_mask_mov_epi32(u, nan, _mm512_set1_epi32(Encoding::kNaN));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm512_cvtepi32_epi8(u));
+  }
+  return i;
+}
+
+template <typename Float8>
+CUTLASS_HOST_SIMD_TARGET(CUTLASS_HOST_SIMD_AVX512)
+inline size_t host_convert_fp8_to_f32_avx512(float *dst, Float8 const *src, size_t count) {
+  float const *table = HostFloat8Table<Float8>::instance();
+
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i u8 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + i));
+    __m512 x = _mm512_i32gather_ps(_mm512_cvtepu8_epi32(u8), table, 4);
+    _mm512_storeu_ps(dst + i, x);
+  }
+  return i;
+}
+
+#undef CUTLASS_HOST_SIMD_AVX512
+
+#endif // CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Converts arrays of elements on the host. The general case converts one element at a time with
+/// NumericConverter; specializations below vectorize conversions to and from fp32.
+template <typename T, typename S>
+struct HostArrayConverter {
+
+  static void convert(T *dst, S const *src, size_t count, HostSimdIsa = host_simd_isa()) {
+    detail::host_convert_array_scalar(dst, src, count);
+  }
+};
+
+#if CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+
+/// Defines a HostArrayConverter whose SIMD kernels convert a prefix of the array and return its
+/// length; the scalar conversion finishes the remainder.
+#define CUTLASS_HOST_ARRAY_CONVERTER(T, S, AVX2_FUNC, AVX512_FUNC)                          \
+template <>                                                                                 \
+struct HostArrayConverter<T, S> {                                                           \
+                                                                                            \
+  static void convert(T *dst, S const *src, size_t count, HostSimdIsa isa = host_simd_isa()) { \
+    size_t converted = 0;                                                                   \
+    if (isa == HostSimdIsa::kAvx512) {                                                      \
+      converted = AVX512_FUNC(dst, src, count);                                             \
+    }                                                                                       \
+    else if (isa == HostSimdIsa::kAvx2) {                                                   \
+      converted = AVX2_FUNC(dst, src, count);                                               \
+    }                                                                                       \
+    detail::host_convert_array_scalar(dst + converted, src + converted, count - converted); \
+  }                                                                                         \
+};
+
+namespace detail {
+
+/// Selects the AVX512-BF16 conversion when the processor supports it
+inline size_t host_convert_f32_to_bf16_avx512_dispatch(bfloat16_t *dst, float const *src, size_t count) {
+#if CUTLASS_HOST_SIMD_AVX512_BF16
+  if (HostSimdFeatures::instance().avx512_bf16()) {
+    return host_convert_f32_to_bf16_avx512_bf16(dst, src, count);
+  }
+#endif
+  return host_convert_f32_to_bf16_avx512(dst, src, count);
+}
+
+} // namespace detail
+
+CUTLASS_HOST_ARRAY_CONVERTER(half_t, float,
+  detail::host_convert_f32_to_f16_avx2, detail::host_convert_f32_to_f16_avx512)
+CUTLASS_HOST_ARRAY_CONVERTER(float, half_t,
+  detail::host_convert_f16_to_f32_avx2, detail::host_convert_f16_to_f32_avx512)
+CUTLASS_HOST_ARRAY_CONVERTER(bfloat16_t, float,
+  detail::host_convert_f32_to_bf16_avx2, detail::host_convert_f32_to_bf16_avx512_dispatch)
+CUTLASS_HOST_ARRAY_CONVERTER(float, bfloat16_t,
+  detail::host_convert_bf16_to_f32_avx2, detail::host_convert_bf16_to_f32_avx512)
+CUTLASS_HOST_ARRAY_CONVERTER(float_e4m3_t, float,
+  detail::host_convert_f32_to_fp8_avx2<float_e4m3_t>, detail::host_convert_f32_to_fp8_avx512<float_e4m3_t>)
+CUTLASS_HOST_ARRAY_CONVERTER(float, float_e4m3_t,
+  detail::host_convert_fp8_to_f32_avx2<float_e4m3_t>, detail::host_convert_fp8_to_f32_avx512<float_e4m3_t>)
+CUTLASS_HOST_ARRAY_CONVERTER(float_e5m2_t, float,
+  detail::host_convert_f32_to_fp8_avx2<float_e5m2_t>, detail::host_convert_f32_to_fp8_avx512<float_e5m2_t>)
+CUTLASS_HOST_ARRAY_CONVERTER(float, float_e5m2_t,
+  detail::host_convert_fp8_to_f32_avx2<float_e5m2_t>, detail::host_convert_fp8_to_f32_avx512<float_e5m2_t>)
+
+#undef CUTLASS_HOST_ARRAY_CONVERTER
+
+#endif // CUTLASS_ENABLE_HOST_SIMD_CONVERSION
+
+/// Converts count elements from src to dst on the host
+template <typename T, typename S>
+void host_convert_array(T *dst, S const *src, size_t count) {
+  HostArrayConverter<T, S>::convert(dst, src, count);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -39,9 +39,15 @@
 
   Call {host, device}_{data, ref, view}() for accessing host or device memory.
 
+  Host memory is placed according to a HostAllocationPolicy and may be recycled through a
+  HostArena (see host_memory.h). Defining CUTLASS_HOST_TENSOR_HOST_ONLY to 1 makes every
+  HostTensor host-only: requests for device memory are ignored and no CUDA runtime functions are
+  called, so test programs run on hosts without a GPU.
+
   See cutlass/tensor_ref.h and cutlass/tensor_view.h for more details.
 */
 
+#include <type_traits>
 #include <vector>
 
 #include "cutlass/cutlass.h"
@@ -50,6 +56,11 @@
 #include "cutlass/fast_math.h"
 
 #include "device_memory.h"
+#include "host_memory.h"
+
+#ifndef CUTLASS_HOST_TENSOR_HOST_ONLY
+#define CUTLASS_HOST_TENSOR_HOST_ONLY 0
+#endif
 
 namespace cutlass {
 
@@ -120,6 +131,9 @@ public:
   static_assert(kElementsPerStoredVec != 0, "kElementsPerStoredVec can not be zero");
   static_assert(kNumStoragePerStoredVec != 0, "kNumStoragePerStoredVec can not be zero");
 
+  /// If true, device memory is never allocated
+  static constexpr bool kHostOnly = (CUTLASS_HOST_TENSOR_HOST_ONLY != 0);
+
  private:
 
   //
@@ -133,8 +147,7 @@ public:
   Layout layout_;
 
   /// Host-side memory allocation
-  /// avoid the std::vector<bool> specialization
-  std::vector<std::conditional_t<std::is_same_v<Element,bool>, uint8_t, Element>> host_;
+  host_memory::allocation<Element> host_;
 
   /// Device-side memory
   device_memory::allocation<Element> device_;
@@ -173,23 +186,35 @@ public:
     extent_ = TensorCoord();
     layout_ = Layout::packed(extent_);
 
-    host_.clear();
+    host_.reset();
     device_.reset();
   }
 
+  /// Sets the alignment, huge-page and first-touch placement of subsequent host allocations and,
+  /// if \p arena is not null, recycles them through an arena that must outlive the tensor.
+  void set_host_allocation(
+    HostAllocationPolicy const &policy,                  ///< placement of host memory
+    HostArena *arena = nullptr) {                        ///< arena recycling host memory
+
+    host_.set_policy(policy, arena);
+  }
+
   /// Resizes internal memory allocations without affecting layout or extent
   void reserve(
     size_t count,                                        ///< size of tensor in elements
     bool device_backed_ = true) {                        ///< if true, device memory is also allocated
 
     device_.reset();
-    host_.clear();
+    host_.reset();
 
     count = (count + kElementsPerStoredVec - 1) / kElementsPerStoredVec * kNumStoragePerStoredVec;
-    host_.resize(count);
+    host_.reset(count);
 
     // Allocate memory
     Element* device_memory = nullptr;
+    if (kHostOnly) {
+      device_backed_ = false;
+    }
     if (device_backed_) {
       device_memory = device_memory::allocate<Element>(count);
     }
@@ -230,7 +255,7 @@ public:
 
     LongIndex new_size = size_t(layout_.capacity(extent_));
 
-    if (static_cast<decltype(host_.size())>(new_size) > host_.size()) {
+    if (static_cast<size_t>(new_size) > host_.size()) {
       reserve(new_size, device_backed_);
     }
   }
@@ -255,7 +280,7 @@ public:
   }
 
   /// Gets pointer to host data
-  Element * host_data() { return reinterpret_cast<Element *>(host_.data()); }
+  Element * host_data() { return reinterpret_cast<Element *>(host_.get()); }
 
   /// Gets pointer to host data with a pointer offset
   Element * host_data_ptr_offset(LongIndex ptr_element_offset) { return &ReferenceFactory<Element>::get(host_data(), ptr_element_offset); }
@@ -266,7 +291,7 @@ public:
   }
 
   /// Gets pointer to host data
-  Element const * host_data() const { return reinterpret_cast<Element const *>(host_.data()); }
+  Element const * host_data() const { return reinterpret_cast<Element const *>(host_.get()); }
 
   /// Gets pointer to host data with a pointer offset
   Element const * host_data_ptr_offset(LongIndex ptr_element_offset) const { return &ReferenceFactory<Element>::get(host_data(), ptr_element_offset); }
@@ -457,7 +482,7 @@ public:
     else {
       count = __NV_STD_MIN(capacity(), count);
     }
-    device_memory::copy_host_to_host(
+    host_memory::copy(
       host_data(), ptr_host, count);
   }
 
@@ -517,7 +542,7 @@ public:
     else {
       count = __NV_STD_MIN(capacity(), count);
     }
-    device_memory::copy_host_to_host(
+    host_memory::copy(
       ptr_host, host_data(), count);
   }
 };
@@ -86,6 +86,26 @@ struct LinearToCoordinate {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Inverse of LinearToCoordinate: index of coord in the row-major enumeration of extent
+template <int Rank>
+struct CoordinateToLinear {
+
+  CUTLASS_HOST_DEVICE
+  int64_t operator()(Coord<Rank> const &coord, Coord<Rank> const &extent) const {
+
+    int64_t idx = int64_t(coord[0]);
+
+    CUTLASS_PRAGMA_UNROLL
+    for (int i = 1; i < Rank; ++i) {
+      idx = idx * int64_t(extent[i]) + int64_t(coord[i]);
+    }
+
+    return idx;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace detail
 } // namespace reference
 } // namespace cutlass
@@ -0,0 +1,159 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Counter-based Philox4x32-10 random number generator.
+*/
+#pragma once
+
+#include "cutlass/cutlass.h"
+#include "cutlass/array.h"
+
+namespace cutlass {
+namespace reference {
+namespace detail {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as
+/// 1, 2, 3", SC'11). Maps a 128-bit counter under a 64-bit key to 128 random bits with no
+/// sequential state, so the values for any element index may be generated independently and in
+/// any order.
+struct Philox4x32 {
+
+  static uint32_t const kMultiplier0 = 0xD2511F53u;
+  static uint32_t const kMultiplier1 = 0xCD9E8D57u;
+  static uint32_t const kWeyl0 = 0x9E3779B9u;
+  static uint32_t const kWeyl1 = 0xBB67AE85u;
+  static int const kRounds = 10;
+
+  using Result = Array<uint32_t, 4>;
+
+  uint32_t key[2];
+
+  CUTLASS_HOST_DEVICE
+  Philox4x32(uint64_t seed = 0) {
+    key[0] = uint32_t(seed);
+    key[1] = uint32_t(seed >> 32);
+  }
+
+  /// Applies the ten rounds to a raw counter
+  CUTLASS_HOST_DEVICE
+  Result operator()(Result counter) const {
+
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    CUTLASS_PRAGMA_UNROLL
+    for (int round = 0; round < kRounds; ++round) {
+      uint64_t product0 = uint64_t(kMultiplier0) * counter[0];
+      uint64_t product1 = uint64_t(kMultiplier1) * counter[2];
+
+      Result next;
+      next[0] = uint32_t(product1 >> 32) ^ counter[1] ^ k0;
+      next[1] = uint32_t(product1);
+      next[2] = uint32_t(product0 >> 32) ^ counter[3] ^ k1;
+      next[3] = uint32_t(product0);
+      counter = next;
+
+      k0 += kWeyl0;
+      k1 += kWeyl1;
+    }
+
+    return counter;
+  }
+
+  /// Returns the random bits of one element. Elements needing more than 128 bits draw further
+  /// blocks from distinct streams.
+  CUTLASS_HOST_DEVICE
+  Result operator()(uint64_t index, uint32_t stream = 0) const {
+    Result counter;
+    counter[0] = uint32_t(index);
+    counter[1] = uint32_t(index >> 32);
+    counter[2] = stream;
+    counter[3] = 0;
+    return (*this)(counter);
+  }
+
+  /// Returns the random bits of kCount consecutive elements starting at index, bitwise identical
+  /// to kCount scalar calls. Lanes are kept in separate arrays so the rounds vectorize.
+  template <int kCount>
+  void generate(uint64_t index, uint32_t stream, uint32_t (&bits)[4][kCount]) const {
+
+    for (int lane = 0; lane < kCount; ++lane) {
+      uint64_t lane_index = index + uint64_t(lane);
+      bits[0][lane] = uint32_t(lane_index);
+      bits[1][lane] = uint32_t(lane_index >> 32);
+      bits[2][lane] = stream;
+      bits[3][lane] = 0;
+    }
+
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    for (int round = 0; round < kRounds; ++round) {
+      for (int lane = 0; lane < kCount; ++lane) {
+        uint64_t product0 = uint64_t(kMultiplier0) * bits[0][lane];
+        uint64_t product1 = uint64_t(kMultiplier1) * bits[2][lane];
+
+        uint32_t next0 = uint32_t(product1 >> 32) ^ bits[1][lane] ^ k0;
+        uint32_t next2 = uint32_t(product0 >> 32) ^ bits[3][lane] ^ k1;
+
+        bits[0][lane] = next0;
+        bits[1][lane] = uint32_t(product1);
+        bits[2][lane] = next2;
+        bits[3][lane] = uint32_t(product0);
+      }
+
+      k0 += kWeyl0;
+      k1 += kWeyl1;
+    }
+  }
+};
+
+/// Maps 32 random bits to a double uniformly distributed in [0, 1)
+CUTLASS_HOST_DEVICE
+double philox_uniform(uint32_t bits) {
+  return double(bits) * (1.0 / 4294967296.0);
+}
+
+/// Maps 32 random bits to a double uniformly distributed in (0, 1], safe to pass to log()
+CUTLASS_HOST_DEVICE
+double philox_uniform_nonzero(uint32_t bits) {
+  return (double(bits) + 1.0) * (1.0 / 4294967296.0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace detail
+} // namespace reference
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,11 +38,14 @@
 #include "cutlass/complex.h"
 #include "cutlass/numeric_conversion.h"
 #include "cutlass/epilogue/thread/activation.h"
+#include "cutlass/util/reference/host/gemm.h"
 
 #include "cute/tensor.hpp"
 
 #include <cuda_runtime.h>
 
+#include <type_traits>
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace cutlass::reference::host {
@@ -56,11 +59,11 @@ bool
 is_activation_in_bounds(
     cute::Tensor<EngineAct, LayoutAct> const& activation,
     int32_t n_, int32_t d_, int32_t h_, int32_t w_, int32_t c_) {
-  return ((n_ >= 0 && n_ < size<4>(activation)) &&
-          (d_ >= 0 && d_ < size<3>(activation)) &&
-          (h_ >= 0 && h_ < size<2>(activation)) &&
-          (w_ >= 0 && w_ < size<1>(activation)) &&
-          (c_ >= 0 && c_ < size<0>(activation)));
+  return ((n_ >= 0 && n_ < cute::size<4>(activation)) &&
+          (d_ >= 0 && d_ < cute::size<3>(activation)) &&
+          (h_ >= 0 && h_ < cute::size<2>(activation)) &&
+          (w_ >= 0 && w_ < cute::size<1>(activation)) &&
+          (c_ >= 0 && c_ < cute::size<0>(activation)));
 }
 
 template<class EngineAct, class LayoutAct>
@@ -68,10 +71,10 @@ bool
 is_activation_in_bounds(
     cute::Tensor<EngineAct, LayoutAct> const& activation,
     int32_t n_, int32_t h_, int32_t w_, int32_t c_) {
-  return ((n_ >= 0 && n_ < size<3>(activation)) &&
-          (h_ >= 0 && h_ < size<2>(activation)) &&
-          (w_ >= 0 && w_ < size<1>(activation)) &&
-          (c_ >= 0 && c_ < size<0>(activation)));
+  return ((n_ >= 0 && n_ < cute::size<3>(activation)) &&
+          (h_ >= 0 && h_ < cute::size<2>(activation)) &&
+          (w_ >= 0 && w_ < cute::size<1>(activation)) &&
+          (c_ >= 0 && c_ < cute::size<0>(activation)));
 }
 
 template<class EngineAct, class LayoutAct>
@@ -79,11 +82,22 @@ bool
 is_activation_in_bounds(
     cute::Tensor<EngineAct, LayoutAct> const& activation,
     int32_t n_, int32_t w_, int32_t c_) {
-  return ((n_ >= 0 && n_ < size<2>(activation)) &&
-          (w_ >= 0 && w_ < size<1>(activation)) &&
-          (c_ >= 0 && c_ < size<0>(activation)));
+  return ((n_ >= 0 && n_ < cute::size<2>(activation)) &&
+          (w_ >= 0 && w_ < cute::size<1>(activation)) &&
+          (c_ >= 0 && c_ < cute::size<0>(activation)));
 }
 
+// Whether ElementAcc(a * b) can be accumulated by the packed host GEMM, which converts both
+// operands to ElementAcc before multiplying. This holds when the product is already formed in
+// ElementAcc, or when narrow integers promote to an int that ElementAcc holds exactly.
+template<class ElementA, class ElementB, class ElementAcc>
+constexpr bool is_conv_implicit_gemm_supported_v =
+  (std::is_same_v<ElementA, ElementAcc> && std::is_same_v<ElementB, ElementAcc> &&
+   (std::is_same_v<ElementAcc, float> || std::is_same_v<ElementAcc, double>)) ||
+  (std::is_integral_v<ElementA> && std::is_integral_v<ElementB> &&
+   sizeof(ElementA) < sizeof(int32_t) && sizeof(ElementB) < sizeof(int32_t) &&
+   std::is_same_v<ElementAcc, int32_t>);
+
 } // namespace detail
 
 template<
@@ -179,7 +193,33 @@ struct ConvReferenceImpl {
     static_assert(rank(ShapePadding{}) == rank(StrideTraversal{}));
   }
 
+  // 2D convolutions of supported element types are computed as implicit GEMMs on the packed host
+  // GEMM unless CUTLASS_REFERENCE_HOST_CONV_DIRECT is defined. Each output accumulates the same
+  // products in the same order as compute_reference_direct().
   void compute_reference() {
+#if !defined(CUTLASS_REFERENCE_HOST_CONV_DIRECT)
+    using ElementA = cute::remove_cvref_t<typename TensorA::value_type>;
+    using ElementB = cute::remove_cvref_t<typename TensorB::value_type>;
+
+    if constexpr (NumSpatialDims == 2 && detail::is_conv_implicit_gemm_supported_v<ElementA, ElementB, ElementAcc>) {
+      if constexpr (ConvOp == cutlass::conv::Operator::kFprop) {
+        fprop_implicit_gemm();
+      }
+      else if constexpr (ConvOp == cutlass::conv::Operator::kDgrad) {
+        dgrad_implicit_gemm();
+      }
+      else {
+        wgrad_implicit_gemm();
+      }
+      return;
+    }
+#endif
+
+    compute_reference_direct();
+  }
+
+  // Computes the reference with one accumulator per output element.
+  void compute_reference_direct() {
     if constexpr (ConvOp == cutlass::conv::Operator::kFprop) {
       fprop_reference(cute::Int<NumSpatialDims>{});
     }
@@ -192,13 +232,189 @@ struct ConvReferenceImpl {
   }
 
 private:
+  // Applies the fused epilogue to one accumulator of output channel k.
+  ElementOut apply_epilogue(int32_t k, ElementAcc accumulator, ElementC residual) {
+    ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
+      epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
+    ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
+      epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
+    ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
+                            scale_converter(beta) * residual_converter(residual);
+    if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+      output += bias_converter(epi_fusion_params_.tensor_bias[k]);
+    }
+    output = epi_activation(output);
+    return output_converter(output);
+  }
+
+  // 2D fprop as an implicit GEMM: rows (n, p, q), columns k, reduction over (r, s, c)
+  void fprop_implicit_gemm() {
+    int32_t N = cute::size<3>(tensor_d_);
+    int32_t P = cute::size<2>(tensor_d_);
+    int32_t Q = cute::size<1>(tensor_d_);
+    int32_t K = cute::size<0>(tensor_d_);
+    int32_t R = cute::size<2>(tensor_b_);
+    int32_t S = cute::size<1>(tensor_b_);
+    int32_t C = cute::size<0>(tensor_b_);
+
+    detail::gemm_packed_tiles(
+      1, N * P * Q, K, R * S * C, ElementAcc(0),
+      [&](int, int row, int k_begin, int depth, ElementAcc *dst, int dst_stride) {
+        int32_t q = row % Q;
+        int32_t p = (row / Q) % P;
+        int32_t n = row / (Q * P);
+        int32_t c = k_begin % C;
+        int32_t s = (k_begin / C) % S;
+        int32_t r = k_begin / (C * S);
+        for (int kk = 0; kk < depth; ++kk) {
+          int32_t w =  q * cute::get<0>(tstride_) - cute::get<0>(padding_) + s * cute::get<0>(dilation_);
+          int32_t h =  p * cute::get<1>(tstride_) - cute::get<1>(padding_) + r * cute::get<1>(dilation_);
+          dst[kk * dst_stride] = detail::is_activation_in_bounds(tensor_a_, n, h, w, c) ?
+            ElementAcc(tensor_a_(c, w, h, n)) : ElementAcc(0);
+          if (++c == C) {
+            c = 0;
+            if (++s == S) {
+              s = 0;
+              ++r;
+            }
+          }
+        }
+      },
+      [&](int, int k_idx, int col_begin, int cols, ElementAcc *dst) {
+        int32_t c = k_idx % C;
+        int32_t s = (k_idx / C) % S;
+        int32_t r = k_idx / (C * S);
+        for (int j = 0; j < cols; ++j) {
+          dst[j] = ElementAcc(tensor_b_(c, s, r, col_begin + j));
+        }
+      },
+      [&](int, int row, int k, ElementAcc accumulator) {
+        int32_t q = row % Q;
+        int32_t p = (row / Q) % P;
+        int32_t n = row / (Q * P);
+        tensor_d_(k, q, p, n) = apply_epilogue(k, accumulator, tensor_c_(k, q, p, n));
+      });
+  }
+
+  // 2D dgrad as an implicit GEMM: rows (n, h, w), columns c, reduction over (k, r, s)
+  void dgrad_implicit_gemm() {
+    int32_t N = cute::size<3>(tensor_d_);
+    int32_t H = cute::size<2>(tensor_d_);
+    int32_t W = cute::size<1>(tensor_d_);
+    int32_t C = cute::size<0>(tensor_d_);
+    int32_t K = cute::size<3>(tensor_b_);
+    int32_t R = cute::size<2>(tensor_b_);
+    int32_t S = cute::size<1>(tensor_b_);
+
+    detail::gemm_packed_tiles(
+      1, N * H * W, C, K * R * S, ElementAcc(0),
+      [&](int, int row, int k_begin, int depth, ElementAcc *dst, int dst_stride) {
+        int32_t w = row % W;
+        int32_t h = (row / W) % H;
+        int32_t n = row / (W * H);
+        int32_t s = k_begin % S;
+        int32_t r = (k_begin / S) % R;
+        int32_t k = k_begin / (S * R);
+        for (int kk = 0; kk < depth; ++kk) {
+          int32_t q = w + cute::get<0>(padding_) - s * cute::get<0>(dilation_);
+          int32_t p = h + cute::get<1>(padding_) - r * cute::get<1>(dilation_);
+          ElementAcc a = ElementAcc(0);
+          if (q % cute::get<0>(tstride_) == 0 && p % cute::get<1>(tstride_) == 0) {
+            q /= cute::get<0>(tstride_);
+            p /= cute::get<1>(tstride_);
+            if (detail::is_activation_in_bounds(tensor_a_, n, p, q, k)) {
+              a = ElementAcc(tensor_a_(k, q, p, n));
+            }
+          }
+          dst[kk * dst_stride] = a;
+          if (++s == S) {
+            s = 0;
+            if (++r == R) {
+              r = 0;
+              ++k;
+            }
+          }
+        }
+      },
+      [&](int, int k_idx, int col_begin, int cols, ElementAcc *dst) {
+        int32_t s = k_idx % S;
+        int32_t r = (k_idx / S) % R;
+        int32_t k = k_idx / (S * R);
+        for (int j = 0; j < cols; ++j) {
+          dst[j] = ElementAcc(tensor_b_(col_begin + j, s, r, k));
+        }
+      },
+      [&](int, int row, int c, ElementAcc accumulator) {
+        int32_t w = row % W;
+        int32_t h = (row / W) % H;
+        int32_t n = row / (W * H);
+        tensor_d_(c, w, h, n) = apply_epilogue(c, accumulator, tensor_c_(c, w, h, n));
+      });
+  }
+
+  // 2D wgrad as an implicit GEMM: rows k, columns (r, s, c), reduction over (n, p, q)
+  void wgrad_implicit_gemm() {
+    int32_t N = cute::size<3>(tensor_a_);
+    int32_t P = cute::size<2>(tensor_a_);
+    int32_t Q = cute::size<1>(tensor_a_);
+    int32_t K = cute::size<0>(tensor_a_);
+    int32_t R = cute::size<2>(tensor_d_);
+    int32_t S = cute::size<1>(tensor_d_);
+    int32_t C = cute::size<0>(tensor_d_);
+
+    detail::gemm_packed_tiles(
+      1, K, R * S * C, N * P * Q, ElementAcc(0),
+      [&](int, int k, int k_begin, int depth, ElementAcc *dst, int dst_stride) {
+        int32_t q = k_begin % Q;
+        int32_t p = (k_begin / Q) % P;
+        int32_t n = k_begin / (Q * P);
+        for (int kk = 0; kk < depth; ++kk) {
+          dst[kk * dst_stride] = ElementAcc(tensor_a_(k, q, p, n));
+          if (++q == Q) {
+            q = 0;
+            if (++p == P) {
+              p = 0;
+              ++n;
+            }
+          }
+        }
+      },
+      [&](int, int k_idx, int col_begin, int cols, ElementAcc *dst) {
+        int32_t q = k_idx % Q;
+        int32_t p = (k_idx / Q) % P;
+        int32_t n = k_idx / (Q * P);
+        int32_t c = col_begin % C;
+        int32_t s = (col_begin / C) % S;
+        int32_t r = col_begin / (C * S);
+        for (int j = 0; j < cols; ++j) {
+          int32_t w =  q * cute::get<0>(tstride_) - cute::get<0>(padding_) + s * cute::get<0>(dilation_);
+          int32_t h =  p * cute::get<1>(tstride_) - cute::get<1>(padding_) + r * cute::get<1>(dilation_);
+          dst[j] = detail::is_activation_in_bounds(tensor_b_, n, h, w, c) ?
+            ElementAcc(tensor_b_(c, w, h, n)) : ElementAcc(0);
+          if (++c == C) {
+            c = 0;
+            if (++s == S) {
+              s = 0;
+              ++r;
+            }
+          }
+        }
+      },
+      [&](int, int k, int col, ElementAcc accumulator) {
+        int32_t c = col % C;
+        int32_t s = (col / C) % S;
+        int32_t r = col / (C * S);
+        tensor_d_(c, s, r, k) = apply_epilogue(k, accumulator, tensor_c_(c, s, r, k));
+      });
+  }
+
   // Specialization for 1D fprop kernel
   void fprop_reference(cute::Int<1> spatial_dims) {
-    int32_t N = size<2>(tensor_d_);
-    int32_t Q = size<1>(tensor_d_);
-    int32_t K = size<0>(tensor_d_);
-    int32_t S = size<1>(tensor_b_);
-    int32_t C = size<0>(tensor_b_);
+    int32_t N = cute::size<2>(tensor_d_);
+    int32_t Q = cute::size<1>(tensor_d_);
+    int32_t K = cute::size<0>(tensor_d_);
+    int32_t S = cute::size<1>(tensor_b_);
+    int32_t C = cute::size<0>(tensor_b_);
 
 #if defined(_OPENMP)
   #pragma omp parallel for collapse(2)
@@ -215,13 +431,13 @@ private:
               }
             }
           }
-          ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
+          ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
             epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-          ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
+          ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
             epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
           ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                   scale_converter(beta) * residual_converter(tensor_c_(k, q, n));
-          if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+          if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
             output += bias_converter(epi_fusion_params_.tensor_bias[k]);
           }
           output = epi_activation(output);
@@ -234,13 +450,13 @@ private:
 
   // Specialization for 2D fprop kernel
   void fprop_reference(cute::Int<2> spatial_dims) {
-    int32_t N = size<3>(tensor_d_);
-    int32_t P = size<2>(tensor_d_);
-    int32_t Q = size<1>(tensor_d_);
-    int32_t K = size<0>(tensor_d_);
-    int32_t R = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
-    int32_t C = size<0>(tensor_b_);
+    int32_t N = cute::size<3>(tensor_d_);
+    int32_t P = cute::size<2>(tensor_d_);
+    int32_t Q = cute::size<1>(tensor_d_);
+    int32_t K = cute::size<0>(tensor_d_);
+    int32_t R = cute::size<2>(tensor_b_);
+    int32_t S = cute::size<1>(tensor_b_);
+    int32_t C = cute::size<0>(tensor_b_);
 
 #if defined(_OPENMP)
     #pragma omp parallel for collapse(3)
@@ -261,13 +477,13 @@ private:
                 }
               }
             }
-            ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
+            ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
               epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-            ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
+            ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
               epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
             ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                     scale_converter(beta) * residual_converter(tensor_c_(k, q, p, n));
-            if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+            if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
               output += bias_converter(epi_fusion_params_.tensor_bias[k]);
             }
             output = epi_activation(output);
@@ -281,15 +497,15 @@ private:
 
   // Specialization for 3D fprop kernel
   void fprop_reference(cute::Int<3> spatial_dims) {
-    int32_t N = size<4>(tensor_d_);
-    int32_t Z = size<3>(tensor_d_);
-    int32_t P = size<2>(tensor_d_);
-    int32_t Q = size<1>(tensor_d_);
-    int32_t K = size<0>(tensor_d_);
-    int32_t T = size<3>(tensor_b_);
-    int32_t R = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
-    int32_t C = size<0>(tensor_b_);
+    int32_t N = cute::size<4>(tensor_d_);
+    int32_t Z = cute::size<3>(tensor_d_);
+    int32_t P = cute::size<2>(tensor_d_);
+    int32_t Q = cute::size<1>(tensor_d_);
+    int32_t K = cute::size<0>(tensor_d_);
+    int32_t T = cute::size<3>(tensor_b_);
+    int32_t R = cute::size<2>(tensor_b_);
+    int32_t S = cute::size<1>(tensor_b_);
+    int32_t C = cute::size<0>(tensor_b_);
 
 #if defined(_OPENMP)
     #pragma omp parallel for collapse(3)
@@ -314,13 +530,13 @@ private:
                   }
                 }
               }
-              ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
+              ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
                 epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-              ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
+              ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
                 epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
               ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                       scale_converter(beta) * residual_converter(tensor_c_(k, q, p, z, n));
-              if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+              if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
                 output += bias_converter(epi_fusion_params_.tensor_bias[k]);
               }
               output = epi_activation(output);
@@ -335,11 +551,11 @@ private:
 
   // Specialization for 1D dgrad kernel
   void dgrad_reference(cute::Int<1> spatial_dims) {
-    int32_t N = size<2>(tensor_d_);
-    int32_t W = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-    int32_t K = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
+    int32_t N = cute::size<2>(tensor_d_);
+    int32_t W = cute::size<1>(tensor_d_);
+    int32_t C = cute::size<0>(tensor_d_);
+    int32_t K = cute::size<2>(tensor_b_);
+    int32_t S = cute::size<1>(tensor_b_);
 
 #if defined(_OPENMP)
    #pragma omp parallel for collapse(2)
@@ -363,13 +579,13 @@ private:
               }
             }
           }
-          ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
+          ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
             ? epi_fusion_params_.tensor_alpha[c] : epi_fusion_params_.alpha;
-          ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
+          ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
             ? epi_fusion_params_.tensor_beta[c] : epi_fusion_params_.beta;
           ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                   scale_converter(beta) * residual_converter(tensor_c_(c, w, n));
-          if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+          if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
             output += bias_converter(epi_fusion_params_.tensor_bias[c]);
           }
           output = epi_activation(output);
@@ -382,13 +598,13 @@ private:
 
   // Specialization for 2D dgrad kernel
   void dgrad_reference(cute::Int<2> spatial_dims) {
-    int32_t N = size<3>(tensor_d_);
-    int32_t H = size<2>(tensor_d_);
-    int32_t W = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-    int32_t K = size<3>(tensor_b_);
-    int32_t R = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
+    int32_t N = cute::size<3>(tensor_d_);
+    int32_t H = cute::size<2>(tensor_d_);
+    int32_t W = cute::size<1>(tensor_d_);
+    int32_t C = cute::size<0>(tensor_d_);
+    int32_t K = cute::size<3>(tensor_b_);
+    int32_t R = cute::size<2>(tensor_b_);
+    int32_t S = cute::size<1>(tensor_b_);
 
 #if defined(_OPENMP)
     #pragma omp parallel for collapse(3)
@@ -422,13 +638,13 @@ private:
                 }
               }
             }
-            ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
+            ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
               ? epi_fusion_params_.tensor_alpha[c] : epi_fusion_params_.alpha;
-            ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
+            ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
               ? epi_fusion_params_.tensor_beta[c] : epi_fusion_params_.beta;
             ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                     scale_converter(beta) * residual_converter(tensor_c_(c, w, h, n));
-            if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+            if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
               output += bias_converter(epi_fusion_params_.tensor_bias[c]);
             }
             output = epi_activation(output);
@@ -443,15 +659,15 @@ private:
 
   // Specialization for 3D dgrad kernel
   void dgrad_reference(cute::Int<3> spatial_dims) {
-    int32_t N = size<4>(tensor_d_);
-    int32_t D = size<3>(tensor_d_);
-    int32_t H = size<2>(tensor_d_);
-    int32_t W = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-    int32_t K = size<4>(tensor_b_);
-    int32_t T = size<3>(tensor_b_);
-    int32_t R = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
+    int32_t N = cute::size<4>(tensor_d_);
+    int32_t D = cute::size<3>(tensor_d_);
+    int32_t H = cute::size<2>(tensor_d_);
+    int32_t W = cute::size<1>(tensor_d_);
+    int32_t C = cute::size<0>(tensor_d_);
+    int32_t K = cute::size<4>(tensor_b_);
+    int32_t T = cute::size<3>(tensor_b_);
+    int32_t R = cute::size<2>(tensor_b_);
+    int32_t S = cute::size<1>(tensor_b_);
 
 #if defined(_OPENMP)
     #pragma omp parallel for collapse(3)
@@ -495,13 +711,13 @@ private:
                   }
                 }
               }
-              ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
+              ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
                 ? epi_fusion_params_.tensor_alpha[c] : epi_fusion_params_.alpha;
-              ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
+              ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
                 ? epi_fusion_params_.tensor_beta[c] : epi_fusion_params_.beta;
               ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                       scale_converter(beta) * residual_converter(tensor_c_(c, w, h, d, n));
-              if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+              if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
                 output += bias_converter(epi_fusion_params_.tensor_bias[c]);
               }
               output = epi_activation(output);
@@ -516,20 +732,16 @@ private:
 
   // Specialization for 1D wgrad kernel
   void wgrad_reference(cute::Int<1> spatial_dims) {
-    int32_t N = size<2>(tensor_a_);
-    int32_t Q = size<1>(tensor_a_);
-    int32_t K = size<0>(tensor_a_);
-    int32_t S = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
+    int32_t N = cute::size<2>(tensor_a_);
+    int32_t Q = cute::size<1>(tensor_a_);
+    int32_t K = cute::size<0>(tensor_a_);
+    int32_t S = cute::size<1>(tensor_d_);
+    int32_t C = cute::size<0>(tensor_d_);
 
 #if defined(_OPENMP)
     #pragma omp parallel for collapse(2)
 #endif
     for (int32_t k = 0; k < K; ++k) {
-      ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-        epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-      ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-        epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
       for (int32_t s = 0; s < S; ++s) {
         for (int32_t c = 0; c < C; ++c) {
           auto accumulator = ElementAcc(0);
@@ -541,9 +753,13 @@ private:
               }
             }
           }
+          ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
+            epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
+          ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
+            epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
           ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                   scale_converter(beta) * residual_converter(tensor_c_(c, s, k));
-          if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+          if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
             output += bias_converter(epi_fusion_params_.tensor_bias[k]);
           }
           output = epi_activation(output);
@@ -555,22 +771,18 @@ private:
 
   // Specialization for 2D wgrad kernel
   void wgrad_reference(cute::Int<2> spatial_dims) {
-    int32_t N = size<3>(tensor_a_);
-    int32_t P = size<2>(tensor_a_);
-    int32_t Q = size<1>(tensor_a_);
-    int32_t K = size<0>(tensor_a_);
-    int32_t R = size<2>(tensor_d_);
-    int32_t S = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
+    int32_t N = cute::size<3>(tensor_a_);
+    int32_t P = cute::size<2>(tensor_a_);
+    int32_t Q = cute::size<1>(tensor_a_);
+    int32_t K = cute::size<0>(tensor_a_);
+    int32_t R = cute::size<2>(tensor_d_);
+    int32_t S = cute::size<1>(tensor_d_);
+    int32_t C = cute::size<0>(tensor_d_);
 
 #if defined(_OPENMP)
     #pragma omp parallel for collapse(3)
 #endif
     for (int32_t k = 0; k < K; ++k) {
-      ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-        epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-      ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-        epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
       for (int32_t r = 0; r < R; ++r) {
         for (int32_t s = 0; s < S; ++s) {
           for (int32_t c = 0; c < C; ++c) {
@@ -586,9 +798,13 @@ private:
                 }
               }
             }
+            ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
+              epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
+            ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
+              epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
             ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                     scale_converter(beta) * residual_converter(tensor_c_(c, s, r, k));
-            if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+            if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
               output += bias_converter(epi_fusion_params_.tensor_bias[k]);
             }
             output = epi_activation(output);
@@ -601,24 +817,20 @@ private:
 
   // Specialization for 3D wgrad kernel
   void wgrad_reference(cute::Int<3> spatial_dims) {
-    int32_t N = size<4>(tensor_a_);
-    int32_t Z = size<3>(tensor_a_);
-    int32_t P = size<2>(tensor_a_);
-    int32_t Q = size<1>(tensor_a_);
-    int32_t K = size<0>(tensor_a_);
-    int32_t T = size<3>(tensor_d_);
-    int32_t R = size<2>(tensor_d_);
-    int32_t S = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
+    int32_t N = cute::size<4>(tensor_a_);
+    int32_t Z = cute::size<3>(tensor_a_);
+    int32_t P = cute::size<2>(tensor_a_);
+    int32_t Q = cute::size<1>(tensor_a_);
+    int32_t K = cute::size<0>(tensor_a_);
+    int32_t T = cute::size<3>(tensor_d_);
+    int32_t R = cute::size<2>(tensor_d_);
+    int32_t S = cute::size<1>(tensor_d_);
+    int32_t C = cute::size<0>(tensor_d_);
 
 #if defined(_OPENMP)
     #pragma omp parallel for collapse(3)
 #endif
     for (int32_t k = 0; k < K; ++k) {
-      ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-        epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-      ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-        epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
       for (int32_t t = 0; t < T; ++t) {
         for (int32_t r = 0; r < R; ++r) {
           for (int32_t s = 0; s < S; ++s) {
@@ -638,9 +850,13 @@ private:
                   }
                 }
               }
+              ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
+                epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
+              ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
+                epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
               ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
                                       scale_converter(beta) * residual_converter(tensor_c_(c, s, r, t, k));
-              if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+              if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
                 output += bias_converter(epi_fusion_params_.tensor_bias[k]);
               }
               output = epi_activation(output);
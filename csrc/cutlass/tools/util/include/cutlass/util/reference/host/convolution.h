@@ -45,6 +45,7 @@
 #include "cutlass/conv/convolution.h"
 #include "cutlass/conv/conv2d_problem_size.h"
 #include "cutlass/conv/conv3d_problem_size.h"
+#include "cutlass/util/reference/host/gemm.h"
 #include <iostream>
 
 namespace cutlass {
@@ -55,7 +56,7 @@ namespace host {
 /// Forward propagation
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// y = conv2d(x, w)
+/// y = conv2d(x, w), accumulating each output element directly
 template <
   typename ElementA,
   typename LayoutA,
@@ -69,7 +70,7 @@ template <
   typename ConvertOp = NumericConverter<ElementD, ElementCompute>,
   typename InnerProductOp = multiply_add<ElementAccumulator>
 >
-void Conv2dFprop(
+void Conv2dFpropDirect(
   conv::Conv2dProblemSize problem_size,
   TensorRef<ElementA, LayoutA> tensor_x,
   TensorRef<ElementB, LayoutB> tensor_w,
@@ -200,7 +201,7 @@ void Depsep_Fprop(cutlass::TensorView<ElementA, LayoutA> tensor_A,
 /// Dgrad / Deconv
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// dx = dgrad(dy, w)
+/// dx = dgrad(dy, w), accumulating each output element directly
 template <
   typename ElementA,
   typename LayoutA,
@@ -214,7 +215,7 @@ template <
   typename ConvertOp = NumericConverter<ElementD, ElementCompute>,
   typename InnerProductOp = multiply_add<ElementAccumulator>
 >
-void Conv2dDgrad(
+void Conv2dDgradDirect(
   cutlass::conv::Conv2dProblemSize problem_size,
   TensorRef<ElementA, LayoutA> tensor_dy,
   TensorRef<ElementB, LayoutB> tensor_w,
@@ -304,7 +305,7 @@ void Conv2dDgrad(
 /// Wgrad
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// dw = wgrad(dy, x)
+/// dw = wgrad(dy, x), accumulating each output element directly
 template <
   typename ElementA,
   typename LayoutA,
@@ -318,7 +319,7 @@ template <
   typename ConvertOp = NumericConverter<ElementD, ElementCompute>,
   typename InnerProductOp = multiply_add<ElementAccumulator>
 >
-void Conv2dWgrad(
+void Conv2dWgradDirect(
   cutlass::conv::Conv2dProblemSize problem_size,
   TensorRef<ElementA, LayoutA> tensor_dy,
   TensorRef<ElementB, LayoutB> tensor_x,
@@ -385,6 +386,451 @@ void Conv2dWgrad(
   } // for (K)
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implicit GEMM
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// y = conv2d(x, w) as an implicit GEMM per group: rows are output pixels (n, p, q), columns are
+/// output channels and the reduction runs over (r, s, c) in the same order as Conv2dFpropDirect.
+/// Operand tiles are gathered into the packed host GEMM, so taps that fall into the padding
+/// contribute an exact zero instead of being skipped.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ElementD = ElementC,
+  typename ConvertOp = NumericConverter<ElementD, ElementCompute>
+>
+void Conv2dFpropImplicitGemm(
+  conv::Conv2dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_x,
+  TensorRef<ElementB, LayoutB> tensor_w,
+  TensorRef<ElementC, LayoutC> tensor_y_in,
+  TensorRef<ElementD, LayoutC> tensor_y_out,
+  ElementCompute alpha,
+  ElementCompute beta) {
+
+  conv::Conv2dProblemSize const &ps = problem_size;
+  ConvertOp convert_op;
+
+  int const channels_per_group = ps.C / ps.groups;
+  int const k_per_group = ps.K / ps.groups;
+
+  detail::gemm_packed_tiles(
+    ps.groups, ps.N * ps.P * ps.Q, k_per_group, ps.R * ps.S * channels_per_group, ElementAccumulator(),
+    [&](int group, int row, int k_begin, int depth, ElementAccumulator *dst, int dst_stride) {
+      int const q = row % ps.Q;
+      int const p = (row / ps.Q) % ps.P;
+      int const n = row / (ps.Q * ps.P);
+      int c = k_begin % channels_per_group;
+      int s = (k_begin / channels_per_group) % ps.S;
+      int r = k_begin / (channels_per_group * ps.S);
+
+      for (int kk = 0; kk < depth; ++kk) {
+        int filter_r = r;
+        int filter_s = s;
+
+        if (ps.mode == cutlass::conv::Mode::kConvolution) {
+          filter_r = ps.R - 1 - r;
+          filter_s = ps.S - 1 - s;
+        }
+
+        int h = p * ps.stride_h - ps.pad_h + filter_r * ps.dilation_h;
+        int w = q * ps.stride_w - ps.pad_w + filter_s * ps.dilation_w;
+
+        dst[kk * dst_stride] = (h >= 0 && h < ps.H && w >= 0 && w < ps.W)
+          ? ElementAccumulator(tensor_x.at({n, h, w, c + group * channels_per_group}))
+          : ElementAccumulator(0);
+
+        if (++c == channels_per_group) {
+          c = 0;
+          if (++s == ps.S) {
+            s = 0;
+            ++r;
+          }
+        }
+      }
+    },
+    [&](int group, int k_idx, int col_begin, int cols, ElementAccumulator *dst) {
+      int const c = k_idx % channels_per_group;
+      int const s = (k_idx / channels_per_group) % ps.S;
+      int const r = k_idx / (channels_per_group * ps.S);
+
+      for (int j = 0; j < cols; ++j) {
+        dst[j] = ElementAccumulator(tensor_w.at({group * k_per_group + col_begin + j, r, s, c}));
+      }
+    },
+    [&](int group, int row, int col, ElementAccumulator acc) {
+      int const q = row % ps.Q;
+      int const p = (row / ps.Q) % ps.P;
+      int const n = row / (ps.Q * ps.P);
+      int const k = group * k_per_group + col;
+
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_y_in.at(cutlass::make_Coord(n, p, q, k));
+      }
+
+      tensor_y_out.at(cutlass::make_Coord(n, p, q, k)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    });
+}
+
+/// dx = dgrad(dy, w) as an implicit GEMM: rows are input pixels (n, h, w), columns are input
+/// channels and the reduction runs over (r, s, k) in the same order as Conv2dDgradDirect.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ElementD = ElementC,
+  typename ConvertOp = NumericConverter<ElementD, ElementCompute>
+>
+void Conv2dDgradImplicitGemm(
+  cutlass::conv::Conv2dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_dy,
+  TensorRef<ElementB, LayoutB> tensor_w,
+  TensorRef<ElementC, LayoutC> tensor_dx_in,
+  TensorRef<ElementD, LayoutC> tensor_dx_out,
+  ElementCompute alpha,
+  ElementCompute beta,
+  bool is_deconv = false) {
+
+  conv::Conv2dProblemSize const &ps = problem_size;
+  ConvertOp convert_op;
+
+  detail::gemm_packed_tiles(
+    1, ps.N * ps.H * ps.W, ps.C, ps.R * ps.S * ps.K, ElementAccumulator(),
+    [&](int, int row, int k_begin, int depth, ElementAccumulator *dst, int dst_stride) {
+      int const w = row % ps.W;
+      int const h = (row / ps.W) % ps.H;
+      int const n = row / (ps.W * ps.H);
+      int k = k_begin % ps.K;
+      int s = (k_begin / ps.K) % ps.S;
+      int r = k_begin / (ps.K * ps.S);
+
+      for (int kk = 0; kk < depth; ++kk) {
+        int filter_r = r;
+        int filter_s = s;
+
+        if (ps.mode == cutlass::conv::Mode::kConvolution) {
+          filter_r = ps.R - 1 - r;
+          filter_s = ps.S - 1 - s;
+        }
+
+        int p = h + ps.pad_h - filter_r * ps.dilation_h;
+        int q = w + ps.pad_w - filter_s * ps.dilation_w;
+
+        ElementAccumulator a = ElementAccumulator(0);
+
+        if (p >= 0 && (p % ps.stride_h) == 0 &&
+            q >= 0 && (q % ps.stride_w) == 0) {
+
+          p = p / ps.stride_h;
+          q = q / ps.stride_w;
+
+          if (p < ps.P && q < ps.Q) {
+            a = ElementAccumulator(tensor_dy.at(cutlass::make_Coord(n, p, q, k)));
+          }
+        }
+
+        dst[kk * dst_stride] = a;
+
+        if (++k == ps.K) {
+          k = 0;
+          if (++s == ps.S) {
+            s = 0;
+            ++r;
+          }
+        }
+      }
+    },
+    [&](int, int k_idx, int col_begin, int cols, ElementAccumulator *dst) {
+      int const k = k_idx % ps.K;
+      int const s = (k_idx / ps.K) % ps.S;
+      int const r = k_idx / (ps.K * ps.S);
+
+      for (int j = 0; j < cols; ++j) {
+        int const c = col_begin + j;
+        dst[j] = ElementAccumulator(is_deconv ? tensor_w.at(cutlass::make_Coord(c, r, s, k))
+                                              : tensor_w.at(cutlass::make_Coord(k, r, s, c)));
+      }
+    },
+    [&](int, int row, int c, ElementAccumulator acc) {
+      int const w = row % ps.W;
+      int const h = (row / ps.W) % ps.H;
+      int const n = row / (ps.W * ps.H);
+
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_dx_in.at(cutlass::make_Coord(n, h, w, c));
+      }
+
+      tensor_dx_out.at(cutlass::make_Coord(n, h, w, c)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    });
+}
+
+/// dw = wgrad(dy, x) as an implicit GEMM: rows are output channels, columns are filter positions
+/// (r, s, c) and the reduction runs over (n, p, q) in the same order as Conv2dWgradDirect.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ElementD = ElementC,
+  typename ConvertOp = NumericConverter<ElementD, ElementCompute>
+>
+void Conv2dWgradImplicitGemm(
+  cutlass::conv::Conv2dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_dy,
+  TensorRef<ElementB, LayoutB> tensor_x,
+  TensorRef<ElementC, LayoutC> tensor_dw_in,
+  TensorRef<ElementD, LayoutC> tensor_dw_out,
+  ElementCompute alpha,
+  ElementCompute beta) {
+
+  conv::Conv2dProblemSize const &ps = problem_size;
+  ConvertOp convert_op;
+
+  detail::gemm_packed_tiles(
+    1, ps.K, ps.R * ps.S * ps.C, ps.N * ps.P * ps.Q, ElementAccumulator(),
+    [&](int, int k, int k_begin, int depth, ElementAccumulator *dst, int dst_stride) {
+      int q = k_begin % ps.Q;
+      int p = (k_begin / ps.Q) % ps.P;
+      int n = k_begin / (ps.Q * ps.P);
+
+      for (int kk = 0; kk < depth; ++kk) {
+        dst[kk * dst_stride] = ElementAccumulator(tensor_dy.at(cutlass::make_Coord(n, p, q, k)));
+
+        if (++q == ps.Q) {
+          q = 0;
+          if (++p == ps.P) {
+            p = 0;
+            ++n;
+          }
+        }
+      }
+    },
+    [&](int, int k_idx, int col_begin, int cols, ElementAccumulator *dst) {
+      int const q = k_idx % ps.Q;
+      int const p = (k_idx / ps.Q) % ps.P;
+      int const n = k_idx / (ps.Q * ps.P);
+      int c = col_begin % ps.C;
+      int s = (col_begin / ps.C) % ps.S;
+      int r = col_begin / (ps.C * ps.S);
+
+      for (int j = 0; j < cols; ++j) {
+        int filter_r = r;
+        int filter_s = s;
+
+        if (ps.mode == cutlass::conv::Mode::kConvolution) {
+          filter_r = ps.R - 1 - r;
+          filter_s = ps.S - 1 - s;
+        }
+
+        int h = p * ps.stride_h - ps.pad_h + filter_r * ps.dilation_h;
+        int w = q * ps.stride_w - ps.pad_w + filter_s * ps.dilation_w;
+
+        dst[j] = (h >= 0 && h < ps.H && w >= 0 && w < ps.W)
+          ? ElementAccumulator(tensor_x.at(cutlass::make_Coord(n, h, w, c)))
+          : ElementAccumulator(0);
+
+        if (++c == ps.C) {
+          c = 0;
+          if (++s == ps.S) {
+            s = 0;
+            ++r;
+          }
+        }
+      }
+    },
+    [&](int, int k, int col, ElementAccumulator acc) {
+      int const c = col % ps.C;
+      int const s = (col / ps.C) % ps.S;
+      int const r = col / (ps.C * ps.S);
+
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_dw_in.at(cutlass::make_Coord(k, r, s, c));
+      }
+
+      tensor_dw_out.at(cutlass::make_Coord(k, r, s, c)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// y = conv2d(x, w). Plain multiply-adds of real scalars take the implicit GEMM path unless
+/// CUTLASS_REFERENCE_HOST_CONV_DIRECT is defined; everything else is computed directly. Depthwise
+/// problems (one output channel per group) are also computed directly, since each output reduces
+/// over only R x S products and a GEMM of width one gains nothing from tiling.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ElementD = ElementC,
+  typename ConvertOp = NumericConverter<ElementD, ElementCompute>,
+  typename InnerProductOp = multiply_add<ElementAccumulator>
+>
+void Conv2dFprop(
+  conv::Conv2dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_x,
+  TensorRef<ElementB, LayoutB> tensor_w,
+  TensorRef<ElementC, LayoutC> tensor_y_in,
+  TensorRef<ElementD, LayoutC> tensor_y_out,
+  ElementCompute alpha,
+  ElementCompute beta) {
+
+#if !defined(CUTLASS_REFERENCE_HOST_CONV_DIRECT)
+  if constexpr (detail::GemmPackedSupported<ElementA, ElementB, ElementAccumulator, InnerProductOp>::value) {
+    if (problem_size.K != problem_size.groups) {
+      Conv2dFpropImplicitGemm<
+        ElementA, LayoutA,
+        ElementB, LayoutB,
+        ElementC, LayoutC,
+        ElementCompute,
+        ElementAccumulator,
+        ElementD,
+        ConvertOp
+      >(problem_size, tensor_x, tensor_w, tensor_y_in, tensor_y_out, alpha, beta);
+      return;
+    }
+  }
+#endif
+
+  Conv2dFpropDirect<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ElementCompute,
+    ElementAccumulator,
+    ElementD,
+    ConvertOp, InnerProductOp
+  >(problem_size, tensor_x, tensor_w, tensor_y_in, tensor_y_out, alpha, beta);
+}
+
+/// dx = dgrad(dy, w). Dispatches like Conv2dFprop.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ElementD = ElementC,
+  typename ConvertOp = NumericConverter<ElementD, ElementCompute>,
+  typename InnerProductOp = multiply_add<ElementAccumulator>
+>
+void Conv2dDgrad(
+  cutlass::conv::Conv2dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_dy,
+  TensorRef<ElementB, LayoutB> tensor_w,
+  TensorRef<ElementC, LayoutC> tensor_dx_in,
+  TensorRef<ElementD, LayoutC> tensor_dx_out,
+  ElementCompute alpha,
+  ElementCompute beta,
+  bool is_deconv = false) {
+
+#if !defined(CUTLASS_REFERENCE_HOST_CONV_DIRECT)
+  if constexpr (detail::GemmPackedSupported<ElementA, ElementB, ElementAccumulator, InnerProductOp>::value) {
+    Conv2dDgradImplicitGemm<
+      ElementA, LayoutA,
+      ElementB, LayoutB,
+      ElementC, LayoutC,
+      ElementCompute,
+      ElementAccumulator,
+      ElementD,
+      ConvertOp
+    >(problem_size, tensor_dy, tensor_w, tensor_dx_in, tensor_dx_out, alpha, beta, is_deconv);
+    return;
+  }
+#endif
+
+  Conv2dDgradDirect<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ElementCompute,
+    ElementAccumulator,
+    ElementD,
+    ConvertOp, InnerProductOp
+  >(problem_size, tensor_dy, tensor_w, tensor_dx_in, tensor_dx_out, alpha, beta, is_deconv);
+}
+
+/// dw = wgrad(dy, x). Dispatches like Conv2dFprop.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ElementD = ElementC,
+  typename ConvertOp = NumericConverter<ElementD, ElementCompute>,
+  typename InnerProductOp = multiply_add<ElementAccumulator>
+>
+void Conv2dWgrad(
+  cutlass::conv::Conv2dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_dy,
+  TensorRef<ElementB, LayoutB> tensor_x,
+  TensorRef<ElementC, LayoutC> tensor_dw_in,
+  TensorRef<ElementD, LayoutC> tensor_dw_out,
+  ElementCompute alpha,
+  ElementCompute beta) {
+
+#if !defined(CUTLASS_REFERENCE_HOST_CONV_DIRECT)
+  if constexpr (detail::GemmPackedSupported<ElementA, ElementB, ElementAccumulator, InnerProductOp>::value) {
+    Conv2dWgradImplicitGemm<
+      ElementA, LayoutA,
+      ElementB, LayoutB,
+      ElementC, LayoutC,
+      ElementCompute,
+      ElementAccumulator,
+      ElementD,
+      ConvertOp
+    >(problem_size, tensor_dy, tensor_x, tensor_dw_in, tensor_dw_out, alpha, beta);
+    return;
+  }
+#endif
+
+  Conv2dWgradDirect<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ElementCompute,
+    ElementAccumulator,
+    ElementD,
+    ConvertOp, InnerProductOp
+  >(problem_size, tensor_dy, tensor_x, tensor_dw_in, tensor_dw_out, alpha, beta);
+}
+
 /// Generic 2D convolution targeting Conv2dFprop, Conv2dDgrad, and Conv2dWgrad.
 template <
   typename ElementA,
@@ -456,7 +902,7 @@ void Conv2d(
 /// 3D convolution 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// y = conv3d(x, w)
+/// y = conv3d(x, w), accumulating each output element directly
 template <
   typename ElementA,
   typename LayoutA,
@@ -469,7 +915,7 @@ template <
   typename ConvertOp = NumericConverter<ElementC, ElementCompute>,
   typename InnerProductOp = multiply_add<ElementAccumulator>
 >
-void Conv3dFprop(
+void Conv3dFpropDirect(
   conv::Conv3dProblemSize problem_size,
   TensorRef<ElementA, LayoutA> tensor_x,
   TensorRef<ElementB, LayoutB> tensor_w,
@@ -543,7 +989,7 @@ void Conv3dFprop(
 /// Dgrad / Deconv
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// dx = dgrad(dy, w)
+/// dx = dgrad(dy, w), accumulating each output element directly
 template <
   typename ElementA,
   typename LayoutA,
@@ -556,7 +1002,7 @@ template <
   typename ConvertOp = NumericConverter<ElementC, ElementCompute>,
   typename InnerProductOp = multiply_add<ElementAccumulator>
 >
-void Conv3dDgrad(
+void Conv3dDgradDirect(
   cutlass::conv::Conv3dProblemSize problem_size,
   TensorRef<ElementA, LayoutA> tensor_dy,
   TensorRef<ElementB, LayoutB> tensor_w,
@@ -640,7 +1086,7 @@ void Conv3dDgrad(
 /// Wgrad
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// dw = wgrad(dy, x)
+/// dw = wgrad(dy, x), accumulating each output element directly
 template <
   typename ElementA,
   typename LayoutA,
@@ -653,7 +1099,7 @@ template <
   typename ConvertOp = NumericConverter<ElementC, ElementCompute>,
   typename InnerProductOp = multiply_add<ElementAccumulator>
 >
-void Conv3dWgrad(
+void Conv3dWgradDirect(
   cutlass::conv::Conv3dProblemSize problem_size,
   TensorRef<ElementA, LayoutA> tensor_dy,
   TensorRef<ElementB, LayoutB> tensor_x,
@@ -727,6 +1173,464 @@ void Conv3dWgrad(
   } // for (K)
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implicit GEMM
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// y = conv3d(x, w) as an implicit GEMM: rows are output voxels (n, z, p, q), columns are output
+/// channels and the reduction runs over (t, r, s, c) in the same order as Conv3dFpropDirect.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ConvertOp = NumericConverter<ElementC, ElementCompute>
+>
+void Conv3dFpropImplicitGemm(
+  conv::Conv3dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_x,
+  TensorRef<ElementB, LayoutB> tensor_w,
+  TensorRef<ElementC, LayoutC> tensor_y_in,
+  TensorRef<ElementC, LayoutC> tensor_y_out,
+  ElementCompute alpha,
+  ElementCompute beta) {
+
+  conv::Conv3dProblemSize const &ps = problem_size;
+  ConvertOp convert_op;
+
+  detail::gemm_packed_tiles(
+    1, ps.N * ps.Z * ps.P * ps.Q, ps.K, ps.T * ps.R * ps.S * ps.C, ElementAccumulator(),
+    [&](int, int row, int k_begin, int depth, ElementAccumulator *dst, int dst_stride) {
+      int const q = row % ps.Q;
+      int const p = (row / ps.Q) % ps.P;
+      int const z = (row / (ps.Q * ps.P)) % ps.Z;
+      int const n = row / (ps.Q * ps.P * ps.Z);
+      int c = k_begin % ps.C;
+      int s = (k_begin / ps.C) % ps.S;
+      int r = (k_begin / (ps.C * ps.S)) % ps.R;
+      int t = k_begin / (ps.C * ps.S * ps.R);
+
+      for (int kk = 0; kk < depth; ++kk) {
+        int filter_t = t;
+        int filter_r = r;
+        int filter_s = s;
+
+        if (ps.mode == cutlass::conv::Mode::kConvolution) {
+          filter_t = ps.T - 1 - t;
+          filter_r = ps.R - 1 - r;
+          filter_s = ps.S - 1 - s;
+        }
+
+        int d = z * ps.stride_d - ps.pad_d + filter_t * ps.dilation_d;
+        int h = p * ps.stride_h - ps.pad_h + filter_r * ps.dilation_h;
+        int w = q * ps.stride_w - ps.pad_w + filter_s * ps.dilation_w;
+
+        dst[kk * dst_stride] = (d >= 0 && d < ps.D && h >= 0 && h < ps.H && w >= 0 && w < ps.W)
+          ? ElementAccumulator(tensor_x.at({n, d, h, w, c}))
+          : ElementAccumulator(0);
+
+        if (++c == ps.C) {
+          c = 0;
+          if (++s == ps.S) {
+            s = 0;
+            if (++r == ps.R) {
+              r = 0;
+              ++t;
+            }
+          }
+        }
+      }
+    },
+    [&](int, int k_idx, int col_begin, int cols, ElementAccumulator *dst) {
+      int const c = k_idx % ps.C;
+      int const s = (k_idx / ps.C) % ps.S;
+      int const r = (k_idx / (ps.C * ps.S)) % ps.R;
+      int const t = k_idx / (ps.C * ps.S * ps.R);
+
+      for (int j = 0; j < cols; ++j) {
+        dst[j] = ElementAccumulator(tensor_w.at({col_begin + j, t, r, s, c}));
+      }
+    },
+    [&](int, int row, int k, ElementAccumulator acc) {
+      int const q = row % ps.Q;
+      int const p = (row / ps.Q) % ps.P;
+      int const z = (row / (ps.Q * ps.P)) % ps.Z;
+      int const n = row / (ps.Q * ps.P * ps.Z);
+
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_y_in.at(cutlass::make_Coord(n, z, p, q, k));
+      }
+
+      tensor_y_out.at(cutlass::make_Coord(n, z, p, q, k)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    });
+}
+
+/// dx = dgrad(dy, w) as an implicit GEMM: rows are input voxels (n, d, h, w), columns are input
+/// channels and the reduction runs over (t, r, s, k) in the same order as Conv3dDgradDirect.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ConvertOp = NumericConverter<ElementC, ElementCompute>
+>
+void Conv3dDgradImplicitGemm(
+  cutlass::conv::Conv3dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_dy,
+  TensorRef<ElementB, LayoutB> tensor_w,
+  TensorRef<ElementC, LayoutC> tensor_dx_in,
+  TensorRef<ElementC, LayoutC> tensor_dx_out,
+  ElementCompute alpha,
+  ElementCompute beta,
+  bool is_deconv = false) {
+
+  conv::Conv3dProblemSize const &ps = problem_size;
+  ConvertOp convert_op;
+
+  detail::gemm_packed_tiles(
+    1, ps.N * ps.D * ps.H * ps.W, ps.C, ps.T * ps.R * ps.S * ps.K, ElementAccumulator(),
+    [&](int, int row, int k_begin, int depth, ElementAccumulator *dst, int dst_stride) {
+      int const w = row % ps.W;
+      int const h = (row / ps.W) % ps.H;
+      int const d = (row / (ps.W * ps.H)) % ps.D;
+      int const n = row / (ps.W * ps.H * ps.D);
+      int k = k_begin % ps.K;
+      int s = (k_begin / ps.K) % ps.S;
+      int r = (k_begin / (ps.K * ps.S)) % ps.R;
+      int t = k_begin / (ps.K * ps.S * ps.R);
+
+      for (int kk = 0; kk < depth; ++kk) {
+        int filter_t = t;
+        int filter_r = r;
+        int filter_s = s;
+
+        if (ps.mode == cutlass::conv::Mode::kConvolution) {
+          filter_t = ps.T - 1 - t;
+          filter_r = ps.R - 1 - r;
+          filter_s = ps.S - 1 - s;
+        }
+
+        int z = d + ps.pad_d - filter_t * ps.dilation_d;
+        int p = h + ps.pad_h - filter_r * ps.dilation_h;
+        int q = w + ps.pad_w - filter_s * ps.dilation_w;
+
+        ElementAccumulator a = ElementAccumulator(0);
+
+        if (z >= 0 && (z % ps.stride_d) == 0 &&
+            p >= 0 && (p % ps.stride_h) == 0 &&
+            q >= 0 && (q % ps.stride_w) == 0) {
+
+          z = z / ps.stride_d;
+          p = p / ps.stride_h;
+          q = q / ps.stride_w;
+
+          if (z < ps.Z && p < ps.P && q < ps.Q) {
+            a = ElementAccumulator(tensor_dy.at(cutlass::make_Coord(n, z, p, q, k)));
+          }
+        }
+
+        dst[kk * dst_stride] = a;
+
+        if (++k == ps.K) {
+          k = 0;
+          if (++s == ps.S) {
+            s = 0;
+            if (++r == ps.R) {
+              r = 0;
+              ++t;
+            }
+          }
+        }
+      }
+    },
+    [&](int, int k_idx, int col_begin, int cols, ElementAccumulator *dst) {
+      int const k = k_idx % ps.K;
+      int const s = (k_idx / ps.K) % ps.S;
+      int const r = (k_idx / (ps.K * ps.S)) % ps.R;
+      int const t = k_idx / (ps.K * ps.S * ps.R);
+
+      for (int j = 0; j < cols; ++j) {
+        int const c = col_begin + j;
+        dst[j] = ElementAccumulator(is_deconv ? tensor_w.at(cutlass::make_Coord(c, t, r, s, k))
+                                              : tensor_w.at(cutlass::make_Coord(k, t, r, s, c)));
+      }
+    },
+    [&](int, int row, int c, ElementAccumulator acc) {
+      int const w = row % ps.W;
+      int const h = (row / ps.W) % ps.H;
+      int const d = (row / (ps.W * ps.H)) % ps.D;
+      int const n = row / (ps.W * ps.H * ps.D);
+
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_dx_in.at(cutlass::make_Coord(n, d, h, w, c));
+      }
+
+      tensor_dx_out.at(cutlass::make_Coord(n, d, h, w, c)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    });
+}
+
+/// dw = wgrad(dy, x) as an implicit GEMM: rows are output channels, columns are filter positions
+/// (t, r, s, c) and the reduction runs over (n, z, p, q) in the same order as Conv3dWgradDirect.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ConvertOp = NumericConverter<ElementC, ElementCompute>
+>
+void Conv3dWgradImplicitGemm(
+  cutlass::conv::Conv3dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_dy,
+  TensorRef<ElementB, LayoutB> tensor_x,
+  TensorRef<ElementC, LayoutC> tensor_dw_in,
+  TensorRef<ElementC, LayoutC> tensor_dw_out,
+  ElementCompute alpha,
+  ElementCompute beta) {
+
+  conv::Conv3dProblemSize const &ps = problem_size;
+  ConvertOp convert_op;
+
+  detail::gemm_packed_tiles(
+    1, ps.K, ps.T * ps.R * ps.S * ps.C, ps.N * ps.Z * ps.P * ps.Q, ElementAccumulator(),
+    [&](int, int k, int k_begin, int depth, ElementAccumulator *dst, int dst_stride) {
+      int q = k_begin % ps.Q;
+      int p = (k_begin / ps.Q) % ps.P;
+      int z = (k_begin / (ps.Q * ps.P)) % ps.Z;
+      int n = k_begin / (ps.Q * ps.P * ps.Z);
+
+      for (int kk = 0; kk < depth; ++kk) {
+        dst[kk * dst_stride] = ElementAccumulator(tensor_dy.at(cutlass::make_Coord(n, z, p, q, k)));
+
+        if (++q == ps.Q) {
+          q = 0;
+          if (++p == ps.P) {
+            p = 0;
+            if (++z == ps.Z) {
+              z = 0;
+              ++n;
+            }
+          }
+        }
+      }
+    },
+    [&](int, int k_idx, int col_begin, int cols, ElementAccumulator *dst) {
+      int const q = k_idx % ps.Q;
+      int const p = (k_idx / ps.Q) % ps.P;
+      int const z = (k_idx / (ps.Q * ps.P)) % ps.Z;
+      int const n = k_idx / (ps.Q * ps.P * ps.Z);
+      int c = col_begin % ps.C;
+      int s = (col_begin / ps.C) % ps.S;
+      int r = (col_begin / (ps.C * ps.S)) % ps.R;
+      int t = col_begin / (ps.C * ps.S * ps.R);
+
+      for (int j = 0; j < cols; ++j) {
+        int filter_t = t;
+        int filter_r = r;
+        int filter_s = s;
+
+        if (ps.mode == cutlass::conv::Mode::kConvolution) {
+          filter_t = ps.T - 1 - t;
+          filter_r = ps.R - 1 - r;
+          filter_s = ps.S - 1 - s;
+        }
+
+        int d = z * ps.stride_d - ps.pad_d + filter_t * ps.dilation_d;
+        int h = p * ps.stride_h - ps.pad_h + filter_r * ps.dilation_h;
+        int w = q * ps.stride_w - ps.pad_w + filter_s * ps.dilation_w;
+
+        dst[j] = (d >= 0 && d < ps.D && h >= 0 && h < ps.H && w >= 0 && w < ps.W)
+          ? ElementAccumulator(tensor_x.at(cutlass::make_Coord(n, d, h, w, c)))
+          : ElementAccumulator(0);
+
+        if (++c == ps.C) {
+          c = 0;
+          if (++s == ps.S) {
+            s = 0;
+            if (++r == ps.R) {
+              r = 0;
+              ++t;
+            }
+          }
+        }
+      }
+    },
+    [&](int, int k, int col, ElementAccumulator acc) {
+      int const c = col % ps.C;
+      int const s = (col / ps.C) % ps.S;
+      int const r = (col / (ps.C * ps.S)) % ps.R;
+      int const t = col / (ps.C * ps.S * ps.R);
+
+      ElementC c_ref = ElementC();
+
+      if (beta != ElementCompute()) {
+        c_ref = tensor_dw_in.at(cutlass::make_Coord(k, t, r, s, c));
+      }
+
+      tensor_dw_out.at(cutlass::make_Coord(k, t, r, s, c)) =
+          convert_op(alpha * ElementCompute(acc) + beta * ElementCompute(c_ref));
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// y = conv3d(x, w). Plain multiply-adds of real scalars take the implicit GEMM path unless
+/// CUTLASS_REFERENCE_HOST_CONV_DIRECT is defined; everything else is computed directly.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ConvertOp = NumericConverter<ElementC, ElementCompute>,
+  typename InnerProductOp = multiply_add<ElementAccumulator>
+>
+void Conv3dFprop(
+  conv::Conv3dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_x,
+  TensorRef<ElementB, LayoutB> tensor_w,
+  TensorRef<ElementC, LayoutC> tensor_y_in,
+  TensorRef<ElementC, LayoutC> tensor_y_out,
+  ElementCompute alpha,
+  ElementCompute beta) {
+
+#if !defined(CUTLASS_REFERENCE_HOST_CONV_DIRECT)
+  if constexpr (detail::GemmPackedSupported<ElementA, ElementB, ElementAccumulator, InnerProductOp>::value) {
+    Conv3dFpropImplicitGemm<
+      ElementA, LayoutA,
+      ElementB, LayoutB,
+      ElementC, LayoutC,
+      ElementCompute,
+      ElementAccumulator,
+      ConvertOp
+    >(problem_size, tensor_x, tensor_w, tensor_y_in, tensor_y_out, alpha, beta);
+    return;
+  }
+#endif
+
+  Conv3dFpropDirect<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ElementCompute,
+    ElementAccumulator,
+    ConvertOp, InnerProductOp
+  >(problem_size, tensor_x, tensor_w, tensor_y_in, tensor_y_out, alpha, beta);
+}
+
+/// dx = dgrad(dy, w). Dispatches like Conv3dFprop.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ConvertOp = NumericConverter<ElementC, ElementCompute>,
+  typename InnerProductOp = multiply_add<ElementAccumulator>
+>
+void Conv3dDgrad(
+  cutlass::conv::Conv3dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_dy,
+  TensorRef<ElementB, LayoutB> tensor_w,
+  TensorRef<ElementC, LayoutC> tensor_dx_in,
+  TensorRef<ElementC, LayoutC> tensor_dx_out,
+  ElementCompute alpha,
+  ElementCompute beta,
+  bool is_deconv = false) {
+
+#if !defined(CUTLASS_REFERENCE_HOST_CONV_DIRECT)
+  if constexpr (detail::GemmPackedSupported<ElementA, ElementB, ElementAccumulator, InnerProductOp>::value) {
+    Conv3dDgradImplicitGemm<
+      ElementA, LayoutA,
+      ElementB, LayoutB,
+      ElementC, LayoutC,
+      ElementCompute,
+      ElementAccumulator,
+      ConvertOp
+    >(problem_size, tensor_dy, tensor_w, tensor_dx_in, tensor_dx_out, alpha, beta, is_deconv);
+    return;
+  }
+#endif
+
+  Conv3dDgradDirect<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ElementCompute,
+    ElementAccumulator,
+    ConvertOp, InnerProductOp
+  >(problem_size, tensor_dy, tensor_w, tensor_dx_in, tensor_dx_out, alpha, beta, is_deconv);
+}
+
+/// dw = wgrad(dy, x). Dispatches like Conv3dFprop.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ElementCompute,
+  typename ElementAccumulator = ElementCompute,
+  typename ConvertOp = NumericConverter<ElementC, ElementCompute>,
+  typename InnerProductOp = multiply_add<ElementAccumulator>
+>
+void Conv3dWgrad(
+  cutlass::conv::Conv3dProblemSize problem_size,
+  TensorRef<ElementA, LayoutA> tensor_dy,
+  TensorRef<ElementB, LayoutB> tensor_x,
+  TensorRef<ElementC, LayoutC> tensor_dw_in,
+  TensorRef<ElementC, LayoutC> tensor_dw_out,
+  ElementCompute alpha,
+  ElementCompute beta) {
+
+#if !defined(CUTLASS_REFERENCE_HOST_CONV_DIRECT)
+  if constexpr (detail::GemmPackedSupported<ElementA, ElementB, ElementAccumulator, InnerProductOp>::value) {
+    Conv3dWgradImplicitGemm<
+      ElementA, LayoutA,
+      ElementB, LayoutB,
+      ElementC, LayoutC,
+      ElementCompute,
+      ElementAccumulator,
+      ConvertOp
+    >(problem_size, tensor_dy, tensor_x, tensor_dw_in, tensor_dw_out, alpha, beta);
+    return;
+  }
+#endif
+
+  Conv3dWgradDirect<
+    ElementA, LayoutA,
+    ElementB, LayoutB,
+    ElementC, LayoutC,
+    ElementCompute,
+    ElementAccumulator,
+    ConvertOp, InnerProductOp
+  >(problem_size, tensor_dy, tensor_x, tensor_dw_in, tensor_dw_out, alpha, beta);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Generic 3D convolution targeting Conv2dFprop, Conv2dDgrad, and Conv2dWgrad.
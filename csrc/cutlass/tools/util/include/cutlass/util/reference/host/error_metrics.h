@@ -34,6 +34,7 @@
 #include <cmath>
 
 #include "cutlass/cutlass.h"
+#include "cutlass/array.h"
 #include "cutlass/complex.h"
 #include "cutlass/util/reference/host/tensor_reduce.h"
 #include "cutlass/core_io.h"
@@ -42,7 +43,24 @@ namespace cutlass  {
 namespace reference {
 namespace host {
 
-/// Helper to compute the relative error metric for tensor A_computed  w.r.t. to tensor A_reference
+namespace detail {
+
+/// Transforms a pair of elements into the squared magnitudes of their difference and of the
+/// reference element
+template <typename Element, typename ComputeType>
+struct TensorRelativeErrorTransform {
+  Array<ComputeType, 2> operator()(Element computed, Element reference) const {
+    Array<ComputeType, 2> result;
+    result[0] = magnitude_squared_difference<Element, ComputeType>()(computed, reference);
+    result[1] = magnitude_squared<Element, ComputeType>()(reference);
+    return result;
+  }
+};
+
+} // namespace detail
+
+/// Helper to compute the relative error metric for tensor A_computed  w.r.t. to tensor A_reference.
+/// Both norms are reduced in a single pass over the tensors.
 template <
   typename Element,
   typename Layout,
@@ -54,10 +72,18 @@ ComputeType TensorRelativeErrorMetric(
   ComputeType identity = ComputeType()
 ) {
 
-  return cutlass::reference::host::TensorNormDiff(view_A_computed, view_B_reference, identity) /
-   cutlass::reference::host::TensorNorm(view_B_reference, identity);
-}
+  Array<ComputeType, 2> identity_pair;
+  identity_pair.fill(identity);
+
+  Array<ComputeType, 2> sum_sq = cutlass::reference::host::TensorTransformReduce(
+    view_A_computed,
+    view_B_reference,
+    identity_pair,
+    plus<Array<ComputeType, 2>>(),
+    detail::TensorRelativeErrorTransform<Element, ComputeType>());
 
+  return std::sqrt(sum_sq[0]) / std::sqrt(sum_sq[1]);
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
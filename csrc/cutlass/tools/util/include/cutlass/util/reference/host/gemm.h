@@ -34,10 +34,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include "cutlass/coord.h"
 #include "cutlass/numeric_types.h"
 #include "cutlass/functional.h"
 #include "cutlass/numeric_conversion.h"
+#include "cutlass/complex.h"
 
 #include "cutlass/tensor_view.h"
 #include "cutlass/gemm/gemm.h"
@@ -80,7 +85,7 @@ Out cast_if_scalar(In in) {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
-/// objects.
+/// objects. Generic element-by-element loop, valid for any InnerProductOp and element type.
 template <
   typename ElementA,
   typename LayoutA,
@@ -93,7 +98,7 @@ template <
   typename InnerProductOp = multiply_add<ComputeType>,
   typename ConvertOp = NumericConverter<ElementC, ScalarType>
 >
-void compute_gemm(
+void compute_gemm_generic(
   gemm::GemmCoord problem_size,
   ScalarType alpha,
   TensorRef<ElementA, LayoutA> tensor_a,
@@ -171,6 +176,271 @@ void compute_gemm(
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Whether compute_gemm may use the packed path: a plain multiply-add of real scalars accumulated in
+/// float, double or int32_t.
+template <typename ElementA, typename ElementB, typename ComputeType, typename InnerProductOp>
+struct GemmPackedSupported {
+  static bool const value =
+    (std::is_same<ComputeType, float>::value ||
+     std::is_same<ComputeType, double>::value ||
+     std::is_same<ComputeType, int32_t>::value) &&
+    std::is_same<InnerProductOp, multiply_add<ComputeType>>::value &&
+    !is_complex<ElementA>::value &&
+    !is_complex<ElementB>::value;
+};
+
+/// Blocking of the packed path. Each thread owns a kBlockM x kBlockN tile of accumulators and packs
+/// kBlockM x kBlockK panels of A and kBlockK x kBlockN panels of B into it. The micro-kernel keeps a
+/// kMicroM x kMicroN block of accumulators local so that its innermost loop vectorizes.
+template <typename ComputeType>
+struct GemmPackedShape {
+  static int const kBlockM = 128;
+  static int const kBlockN = 256;
+  static int const kBlockK = 256;
+  static int const kMicroM = 4;
+  static int const kMicroN = 32;
+};
+
+/// Accumulates a packed kMicroM x k panel of A times a packed k x kMicroN panel of B into the
+/// kMicroM x kMicroN block of accum with leading dimension ldc, in increasing k like the generic loop.
+template <typename ComputeType, int kMicroM, int kMicroN>
+inline void gemm_packed_micro_kernel(
+  int k,
+  ComputeType const * __restrict packed_a,
+  ComputeType const * __restrict packed_b,
+  ComputeType * __restrict accum,
+  int ldc) {
+
+  ComputeType block[kMicroM * kMicroN];
+
+  for (int i = 0; i < kMicroM; ++i) {
+    for (int j = 0; j < kMicroN; ++j) {
+      block[i * kMicroN + j] = accum[i * ldc + j];
+    }
+  }
+
+  for (int kk = 0; kk < k; ++kk) {
+    ComputeType const *a = packed_a + kk * kMicroM;
+    ComputeType const *b = packed_b + kk * kMicroN;
+    for (int i = 0; i < kMicroM; ++i) {
+      for (int j = 0; j < kMicroN; ++j) {
+        block[i * kMicroN + j] = a[i] * b[j] + block[i * kMicroN + j];
+      }
+    }
+  }
+
+  for (int i = 0; i < kMicroM; ++i) {
+    for (int j = 0; j < kMicroN; ++j) {
+      accum[i * ldc + j] = block[i * kMicroN + j];
+    }
+  }
+}
+
+/// Tiled driver shared by the packed GEMM and the implicit-GEMM convolution references. Computes
+/// batch_count independent M x N x K products whose operands are supplied by callbacks:
+///
+///   pack_a(batch, row, k_begin, depth, dst, dst_stride) writes A(row, k_begin + kk) to
+///     dst[kk * dst_stride] for kk in [0, depth)
+///   pack_b(batch, k, col_begin, cols, dst) writes B(k, col_begin + j) to dst[j] for j in [0, cols)
+///   epilogue(batch, row, col, accum) consumes one finished accumulator
+///
+/// Output tiles of all batches are distributed over OpenMP threads when available. Every
+/// accumulator starts from initial_accum and adds its products in increasing k.
+template <typename ComputeType, typename PackA, typename PackB, typename Epilogue>
+void gemm_packed_tiles(
+  int batch_count,
+  int M,
+  int N,
+  int K,
+  ComputeType initial_accum,
+  PackA const &pack_a,
+  PackB const &pack_b,
+  Epilogue const &epilogue) {
+
+  using Shape = GemmPackedShape<ComputeType>;
+  int const kBlockM = Shape::kBlockM;
+  int const kBlockN = Shape::kBlockN;
+  int const kBlockK = Shape::kBlockK;
+  int const kMicroM = Shape::kMicroM;
+  int const kMicroN = Shape::kMicroN;
+
+  int const tiles_m = (M + kBlockM - 1) / kBlockM;
+  int const tiles_n = (N + kBlockN - 1) / kBlockN;
+
+#if defined(_OPENMP)
+  #pragma omp parallel
+#endif
+  {
+    std::vector<ComputeType> packed_a(size_t(kBlockM) * kBlockK);
+    std::vector<ComputeType> packed_b(size_t(kBlockK) * kBlockN);
+    std::vector<ComputeType> accum(size_t(kBlockM) * kBlockN);
+
+#if defined(_OPENMP)
+    #pragma omp for collapse(3) schedule(static)
+#endif
+    for (int batch = 0; batch < batch_count; ++batch) {
+      for (int tile_m = 0; tile_m < tiles_m; ++tile_m) {
+        for (int tile_n = 0; tile_n < tiles_n; ++tile_n) {
+
+          int const row_begin = tile_m * kBlockM;
+          int const col_begin = tile_n * kBlockN;
+          int const rows = std::min(kBlockM, M - row_begin);
+          int const cols = std::min(kBlockN, N - col_begin);
+          // Rows and columns are padded to whole micro-kernel blocks with zeros.
+          int const rows_padded = (rows + kMicroM - 1) / kMicroM * kMicroM;
+          int const cols_padded = (cols + kMicroN - 1) / kMicroN * kMicroN;
+
+          std::fill(accum.begin(), accum.end(), initial_accum);
+
+          for (int k_begin = 0; k_begin < K; k_begin += kBlockK) {
+            int const depth = std::min(kBlockK, K - k_begin);
+
+            // Pack A as [row / kMicroM][k][row % kMicroM].
+            for (int i = 0; i < rows_padded; ++i) {
+              ComputeType *dst = packed_a.data() + size_t(i / kMicroM) * depth * kMicroM + i % kMicroM;
+              if (i < rows) {
+                pack_a(batch, row_begin + i, k_begin, depth, dst, kMicroM);
+              }
+              else {
+                for (int kk = 0; kk < depth; ++kk) {
+                  dst[kk * kMicroM] = ComputeType(0);
+                }
+              }
+            }
+
+            // Pack B as [col / kMicroN][k][col % kMicroN].
+            for (int kk = 0; kk < depth; ++kk) {
+              for (int j = 0; j < cols_padded; j += kMicroN) {
+                ComputeType *dst = packed_b.data() + size_t(j) * depth + kk * kMicroN;
+                int const valid = std::max(0, std::min(kMicroN, cols - j));
+                if (valid) {
+                  pack_b(batch, k_begin + kk, col_begin + j, valid, dst);
+                }
+                std::fill(dst + valid, dst + kMicroN, ComputeType(0));
+              }
+            }
+
+            for (int j = 0; j < cols_padded; j += kMicroN) {
+              for (int i = 0; i < rows_padded; i += kMicroM) {
+                gemm_packed_micro_kernel<ComputeType, kMicroM, kMicroN>(
+                  depth,
+                  packed_a.data() + size_t(i) * depth,
+                  packed_b.data() + size_t(j) * depth,
+                  accum.data() + size_t(i) * kBlockN + j,
+                  kBlockN);
+              }
+            }
+          }
+
+          for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+              epilogue(batch, row_begin + i, col_begin + j, accum[size_t(i) * kBlockN + j]);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/// Computes a general matrix product with cache-blocked tiles. The operands are converted to
+/// ComputeType once per panel instead of once per multiply, and the output tiles are distributed
+/// over OpenMP threads when available. Every element of D accumulates its products in increasing k
+/// starting from initial_accum, as compute_gemm_generic does.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>
+>
+void compute_gemm_packed(
+  gemm::GemmCoord problem_size,
+  ScalarType alpha,
+  TensorRef<ElementA, LayoutA> tensor_a,
+  TensorRef<ElementB, LayoutB> tensor_b,
+  ScalarType beta,
+  TensorRef<ElementC, LayoutC> tensor_c,
+  TensorRef<ElementC, LayoutC> tensor_d,
+  ComputeType initial_accum) {
+
+  ConvertOp convert_op;
+
+  // Note: batch is ignored.
+  detail::gemm_packed_tiles(
+    1, problem_size.m(), problem_size.n(), problem_size.k(), initial_accum,
+    [&](int, int row, int k_begin, int depth, ComputeType *dst, int dst_stride) {
+      for (int kk = 0; kk < depth; ++kk) {
+        dst[kk * dst_stride] = cast_if_scalar<ComputeType>(tensor_a.at(MatrixCoord(row, k_begin + kk)));
+      }
+    },
+    [&](int, int k, int col_begin, int cols, ComputeType *dst) {
+      for (int j = 0; j < cols; ++j) {
+        dst[j] = cast_if_scalar<ComputeType>(tensor_b.at(MatrixCoord(k, col_begin + j)));
+      }
+    },
+    [&](int, int row, int col, ComputeType accum) {
+      MatrixCoord coord = MatrixCoord(row, col);
+      tensor_d.at(coord) = convert_op(alpha * ScalarType(accum) + beta * ScalarType(tensor_c.at(coord)));
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
+/// objects. Plain multiply-adds of real scalars take the packed path unless
+/// CUTLASS_REFERENCE_HOST_GEMM_GENERIC is defined; everything else uses the generic loop.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ElementC,
+  typename LayoutC,
+  typename ScalarType,
+  typename ComputeType,
+  typename InnerProductOp = multiply_add<ComputeType>,
+  typename ConvertOp = NumericConverter<ElementC, ScalarType>
+>
+void compute_gemm(
+  gemm::GemmCoord problem_size,
+  ScalarType alpha,
+  TensorRef<ElementA, LayoutA> tensor_a,
+  TensorRef<ElementB, LayoutB> tensor_b,
+  ScalarType beta,
+  TensorRef<ElementC, LayoutC> tensor_c,
+  TensorRef<ElementC, LayoutC> tensor_d,
+  ComputeType initial_accum) {
+
+  static_assert(
+    LayoutA::kRank == 2 &&
+    LayoutB::kRank == 2 &&
+    LayoutC::kRank == 2, "Tensors must be of rank 2");
+
+#if !defined(CUTLASS_REFERENCE_HOST_GEMM_GENERIC)
+  if constexpr (detail::GemmPackedSupported<ElementA, ElementB, ComputeType, InnerProductOp>::value) {
+    compute_gemm_packed<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                        ScalarType, ComputeType, ConvertOp>(
+      problem_size, alpha, tensor_a, tensor_b, beta, tensor_c, tensor_d, initial_accum);
+    return;
+  }
+#endif
+
+  compute_gemm_generic<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
+                       ScalarType, ComputeType, InnerProductOp, ConvertOp>(
+    problem_size, alpha, tensor_a, tensor_b, beta, tensor_c, tensor_d, initial_accum);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
 /// objects.
 template <
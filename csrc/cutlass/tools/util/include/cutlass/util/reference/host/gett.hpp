@@ -43,6 +43,9 @@
 
 #include "cute/tensor.hpp"
 
+#include <algorithm>
+#include <vector>
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace cutlass::reference::host {
@@ -143,6 +146,169 @@ struct GettEpilogueParams {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Whether Gett may take the packed path: real operands accumulated in float, double or int32_t.
+/// Complex transforms are no-ops on real operands.
+template <class MainloopParams>
+struct GettPackedSupported {
+  using ElementAccumulator = typename MainloopParams::ElementAccumulator;
+  using ElementA = typename ElementTraits<typename MainloopParams::EngineA::value_type>::type;
+  using ElementB = typename ElementTraits<typename MainloopParams::EngineB::value_type>::type;
+
+  static bool const value =
+    (cute::is_same_v<ElementAccumulator, float> ||
+     cute::is_same_v<ElementAccumulator, double> ||
+     cute::is_same_v<ElementAccumulator, int32_t>) &&
+    !is_complex<ElementA>::value &&
+    !is_complex<ElementB>::value;
+};
+
+/// Whether mode kMode of a tensor has a static unit stride and addressable elements, so that a run
+/// of coordinates along it can be read through a plain pointer.
+template <class Tensor, int kMode>
+struct GettContiguousMode {
+  using StrideType = decltype(cute::stride<kMode>(std::declval<typename Tensor::layout_type>()));
+
+  static bool const value =
+    cute::is_constant<1, StrideType>::value &&
+    std::is_lvalue_reference_v<typename Tensor::reference>;
+};
+
+/// An (M|N, K, L) operand converted to ElementAccumulator once, as k-major panels of kBlock rows:
+/// panel(row, l)[k * kBlock + i] holds the operand at (row + i, k, l). Rows past the extent are
+/// zero, so the micro-kernel never needs a bounds check.
+template <class ElementAccumulator, int kBlock>
+struct GettPackedOperand {
+
+  int64_t rows = 0;
+  int64_t depth = 0;
+  int64_t tiles = 0;
+  std::vector<ElementAccumulator> data;
+
+  template <class Tensor>
+  explicit GettPackedOperand(Tensor const& tensor):
+    rows(cute::size<0>(tensor.layout())),
+    depth(cute::size<1>(tensor.layout())),
+    tiles((rows + kBlock - 1) / kBlock),
+    data(size_t(cute::size<2>(tensor.layout()) * tiles * depth * kBlock)) {
+
+    using Element = typename ElementTraits<typename Tensor::value_type>::type;
+
+    if (depth == 0) {
+      return;
+    }
+
+#if defined(_OPENMP)
+    #pragma omp parallel for collapse(2)
+#endif
+    for (int64_t l = 0; l < cute::size<2>(tensor.layout()); ++l) {
+      for (int64_t row = 0; row < rows; row += kBlock) {
+        ElementAccumulator *dst = data.data() + size_t((l * tiles + row / kBlock) * depth) * kBlock;
+        int const valid = int(std::min<int64_t>(kBlock, rows - row));
+
+        if constexpr (GettContiguousMode<Tensor, 0>::value) {
+          for (int64_t k = 0; k < depth; ++k) {
+            auto const *src = &tensor(row, k, l);
+            for (int i = 0; i < valid; ++i) {
+              dst[k * kBlock + i] = static_cast<ElementAccumulator>(Element(src[i]));
+            }
+          }
+        }
+        else if constexpr (GettContiguousMode<Tensor, 1>::value) {
+          for (int i = 0; i < valid; ++i) {
+            auto const *src = &tensor(row + i, 0, l);
+            for (int64_t k = 0; k < depth; ++k) {
+              dst[k * kBlock + i] = static_cast<ElementAccumulator>(Element(src[k]));
+            }
+          }
+        }
+        else {
+          for (int64_t k = 0; k < depth; ++k) {
+            for (int i = 0; i < valid; ++i) {
+              dst[k * kBlock + i] = static_cast<ElementAccumulator>(Element(tensor(row + i, k, l)));
+            }
+          }
+        }
+
+        for (int64_t k = 0; k < depth; ++k) {
+          std::fill(dst + k * kBlock + valid, dst + (k + 1) * kBlock, ElementAccumulator(0));
+        }
+      }
+    }
+  }
+
+  ElementAccumulator const *panel(int64_t row, int64_t l) const {
+    return data.data() + size_t((l * tiles + row / kBlock) * depth) * kBlock;
+  }
+};
+
+/// GETT - Mainloop over packed operands. A register-blocked micro-kernel walks k in blocks of
+/// kBlockK; every accumulator adds its products in increasing k exactly as gett_mainloop does.
+template <class ElementAccumulator, int kBlockM, int kBlockN>
+void gett_mainloop_packed(
+    GettPackedOperand<ElementAccumulator, kBlockM> const& A,
+    GettPackedOperand<ElementAccumulator, kBlockN> const& B,
+    int64_t m,
+    int64_t n,
+    int64_t l,
+    ElementAccumulator (&acc)[kBlockM][kBlockN])
+{
+  static int constexpr kBlockK = 128;
+  static int constexpr kMicroM = 2;
+  static int constexpr kMicroN = 32;
+  static_assert(kBlockM % kMicroM == 0 && kBlockN % kMicroN == 0, "Block must tile by micro-kernel");
+
+  ElementAccumulator const *panel_a = A.panel(m, l);
+  ElementAccumulator const *panel_b = B.panel(n, l);
+
+  // Skip micro-kernel blocks that lie entirely outside the problem.
+  int const m_end = int((std::min<int64_t>(kBlockM, A.rows - m) + kMicroM - 1) / kMicroM * kMicroM);
+  int const n_end = int((std::min<int64_t>(kBlockN, B.rows - n) + kMicroN - 1) / kMicroN * kMicroN);
+
+  for (int m_b = 0; m_b < kBlockM; ++m_b) {
+    for (int n_b = 0; n_b < kBlockN; ++n_b) {
+      acc[m_b][n_b] = ElementAccumulator(0); // RingOp::AdditionIdentity
+    }
+  }
+
+  for (int64_t k_begin = 0; k_begin < A.depth; k_begin += kBlockK) {
+    int64_t const k_end = std::min<int64_t>(k_begin + kBlockK, A.depth);
+
+    for (int m_b = 0; m_b < m_end; m_b += kMicroM) {
+      for (int n_b = 0; n_b < n_end; n_b += kMicroN) {
+        ElementAccumulator block[kMicroM][kMicroN];
+
+        for (int i = 0; i < kMicroM; ++i) {
+          for (int j = 0; j < kMicroN; ++j) {
+            block[i][j] = acc[m_b + i][n_b + j];
+          }
+        }
+
+        for (int64_t k = k_begin; k < k_end; ++k) {
+          ElementAccumulator const *a = panel_a + k * kBlockM + m_b;
+          ElementAccumulator const *b = panel_b + k * kBlockN + n_b;
+          for (int i = 0; i < kMicroM; ++i) {
+            for (int j = 0; j < kMicroN; ++j) {
+              block[i][j] = a[i] * b[j] + block[i][j];
+            }
+          }
+        }
+
+        for (int i = 0; i < kMicroM; ++i) {
+          for (int j = 0; j < kMicroN; ++j) {
+            acc[m_b + i][n_b + j] = block[i][j];
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// GETT - General Tensor-Tensor contraction reference kernel
 template <
   class MainloopParams,
@@ -156,6 +322,30 @@ void Gett(
   static int constexpr kBlockM = 64;
   static int constexpr kBlockN = 64;
 
+#if !defined(CUTLASS_REFERENCE_HOST_GETT_GENERIC)
+  // Real operands are converted to the accumulator type once up front rather than once per block.
+  if constexpr (detail::GettPackedSupported<MainloopParams>::value) {
+    using ElementAccumulator = typename MainloopParams::ElementAccumulator;
+
+    detail::GettPackedOperand<ElementAccumulator, kBlockM> packed_A(mainloop_params.A);
+    detail::GettPackedOperand<ElementAccumulator, kBlockN> packed_B(mainloop_params.B);
+
+#if defined(_OPENMP)
+    #pragma omp parallel for collapse(3)
+#endif
+    for (int64_t l = 0; l < cute::size<2>(mainloop_params.A.layout()); ++l) {
+      for (int64_t m = 0; m < cute::size<0>(mainloop_params.A.layout()); m += kBlockM) {
+        for (int64_t n = 0; n < cute::size<0>(mainloop_params.B.layout()); n += kBlockN) {
+          ElementAccumulator acc[kBlockM][kBlockN];
+          detail::gett_mainloop_packed(packed_A, packed_B, m, n, l, acc);
+          gett_epilogue(epilogue_params, m, n, l, acc);
+        }
+      }
+    }
+    return;
+  }
+#endif
+
 #if defined(_OPENMP)
   #pragma omp parallel for collapse(3)
 #endif
@@ -332,89 +522,104 @@ void gett_epilogue(
 
   ElementCompute inter_accum[kBlockM][kBlockN];
 
-  for (int m_b = 0; m_b < kBlockM; ++m_b) {
+  // Operand presence and the block extent are fixed for the whole block, and per-row scalars are
+  // converted once per row rather than once per element.
+  bool const has_C = cute::raw_pointer_cast(epilogue_params.C.data()) != nullptr;
+  bool const has_Bias = cute::raw_pointer_cast(epilogue_params.Bias.data()) != nullptr;
+  bool const has_Aux = cute::raw_pointer_cast(epilogue_params.Aux.data()) != nullptr;
+  bool const has_Valpha = cute::raw_pointer_cast(epilogue_params.Valpha.data()) != nullptr;
+  bool const has_Vbeta = cute::raw_pointer_cast(epilogue_params.Vbeta.data()) != nullptr;
+
+  int const m_end = int(std::max<int64_t>(0, std::min<int64_t>(kBlockM, cute::size<0>(epilogue_params.D.layout()) - m)));
+  int const n_end = int(std::max<int64_t>(0, std::min<int64_t>(kBlockN, cute::size<1>(epilogue_params.D.layout()) - n)));
+
+  for (int m_b = 0; m_b < m_end; ++m_b) {
     ElementCompute local_dBias = ElementCompute(0);
 
-    for (int n_b = 0; n_b < kBlockN; ++n_b) {
-      if (m + m_b < cute::size<0>(epilogue_params.D.layout()) && n + n_b < cute::size<1>(epilogue_params.D.layout())) {
-        // Convert every type to ElementCompute first, do compute, convert to output type, write it out
-        ElementCompute converted_acc = accumulator_converter(acc[m_b][n_b]);
-        // per-row alpha
-        if (raw_pointer_cast(epilogue_params.Valpha.data())) {
-          converted_alpha = scale_converter(epilogue_params.Valpha(m + m_b));
-        }
-        ElementCompute output = mul(converted_alpha, converted_acc);
+    // per-row alpha and beta
+    if (has_Valpha) {
+      converted_alpha = scale_converter(epilogue_params.Valpha(m + m_b));
+    }
+    if (has_C && has_Vbeta) {
+      converted_beta = scale_converter(epilogue_params.Vbeta(m + m_b));
+    }
 
-        if (raw_pointer_cast(epilogue_params.Bias.data()) && not IsBackpropFusion) {
-          ElementCompute converted_bias = bias_converter(epilogue_params.Bias(PerColBias ? n + n_b : m + m_b));
-          output = bias_op(output, converted_bias);
-        }
+    [[maybe_unused]] ElementCompute converted_row_bias = ElementCompute(0);
+    if constexpr (not PerColBias and not IsBackpropFusion) {
+      if (has_Bias) {
+        converted_row_bias = bias_converter(epilogue_params.Bias(m + m_b));
+      }
+    }
 
-        if (raw_pointer_cast(epilogue_params.C.data())) {
-          ElementCompute converted_src = source_converter(epilogue_params.C(m + m_b, n + n_b, l));
-          // per-row beta
-          if (epilogue_params.Vbeta.data()) {
-            converted_beta = scale_converter(epilogue_params.Vbeta(m + m_b));
-          }
-          output = epilogue_fma(converted_beta, converted_src, output);
-        }
+    for (int n_b = 0; n_b < n_end; ++n_b) {
+      // Convert every type to ElementCompute first, do compute, convert to output type, write it out
+      ElementCompute converted_acc = accumulator_converter(acc[m_b][n_b]);
+      ElementCompute output = mul(converted_alpha, converted_acc);
 
-        if constexpr (IsBackpropFusion) {
-          ElementAux aux_input = ElementAux(0);
-          if (raw_pointer_cast(epilogue_params.Aux.data())) {
-            aux_input = epilogue_params.Aux(m + m_b, n + n_b, l);
-          }
+      if (has_Bias && not IsBackpropFusion) {
+        ElementCompute converted_bias = PerColBias ?
+            bias_converter(epilogue_params.Bias(n + n_b)) : converted_row_bias;
+        output = bias_op(output, converted_bias);
+      }
 
-          output = activation(output, aux_source_converter(aux_input));
-          local_dBias = add(local_dBias, output);
+      if (has_C) {
+        ElementCompute converted_src = source_converter(epilogue_params.C(m + m_b, n + n_b, l));
+        output = epilogue_fma(converted_beta, converted_src, output);
+      }
+
+      if constexpr (IsBackpropFusion) {
+        ElementAux aux_input = ElementAux(0);
+        if (has_Aux) {
+          aux_input = epilogue_params.Aux(m + m_b, n + n_b, l);
         }
-        else {
-          if (raw_pointer_cast(epilogue_params.Aux.data())) {
-            auto aux_output = output;
-            if constexpr (IsScalingAndAmaxAuxOutputNeeded) {
-              maximum_absolute_value_reduction<ElementCompute, true> amax_op;
-              local_abs_max_aux_output = amax_op(local_abs_max_aux_output, aux_output);
-              aux_output = epilogue_fma(converted_scale_aux, aux_output, ElementCompute(0));
-            }
 
-            if constexpr (IsReLUAuxNeeded) {
-              epilogue_params.Aux(m + m_b, n + n_b, l) = not (aux_output < 0) ? uint1b_t(1) : uint1b_t(0);
-            } else {
-              epilogue_params.Aux(m + m_b, n + n_b, l) = aux_destination_converter(aux_output);
-            }
+        output = activation(output, aux_source_converter(aux_input));
+        local_dBias = add(local_dBias, output);
+      }
+      else {
+        if (has_Aux) {
+          auto aux_output = output;
+          if constexpr (IsScalingAndAmaxAuxOutputNeeded) {
+            maximum_absolute_value_reduction<ElementCompute, true> amax_op;
+            local_abs_max_aux_output = amax_op(local_abs_max_aux_output, aux_output);
+            aux_output = epilogue_fma(converted_scale_aux, aux_output, ElementCompute(0));
           }
 
-          if constexpr (IsClamp) { // Treat Clamp as ReLU
-            output = activation(output, {0, std::numeric_limits<ElementCompute>::max()});
-          }
-          else {
-            output = activation(output);
+          if constexpr (IsReLUAuxNeeded) {
+            epilogue_params.Aux(m + m_b, n + n_b, l) = not (aux_output < 0) ? uint1b_t(1) : uint1b_t(0);
+          } else {
+            epilogue_params.Aux(m + m_b, n + n_b, l) = aux_destination_converter(aux_output);
           }
         }
 
-        if constexpr (IsScalingAndAmaxOutputNeeded) {
-          maximum_absolute_value_reduction<ElementCompute, true> amax_op;
-          local_abs_max_output = amax_op(local_abs_max_output, output);
-          output = epilogue_fma(converted_scale_d, output, ElementCompute(0));
+        if constexpr (IsClamp) { // Treat Clamp as ReLU
+          output = activation(output, {0, std::numeric_limits<ElementCompute>::max()});
         }
+        else {
+          output = activation(output);
+        }
+      }
 
-        inter_accum[m_b][n_b] = ElementCompute(output);
+      if constexpr (IsScalingAndAmaxOutputNeeded) {
+        maximum_absolute_value_reduction<ElementCompute, true> amax_op;
+        local_abs_max_output = amax_op(local_abs_max_output, output);
+        output = epilogue_fma(converted_scale_d, output, ElementCompute(0));
       }
+
+      inter_accum[m_b][n_b] = ElementCompute(output);
     } // n_b
 
-    if (m + m_b < cute::size<0>(epilogue_params.D.layout()) && n < cute::size<1>(epilogue_params.D.layout())) {
-      if (raw_pointer_cast(epilogue_params.Bias.data()) && IsBackpropFusion) {
+    if (n_end > 0) {
+      if (has_Bias && IsBackpropFusion) {
         ElementCompute converted_dBias = bias_converter(epilogue_params.Bias(m + m_b));
         local_dBias = add(local_dBias, converted_dBias);
         epilogue_params.Bias(m + m_b) = dBias_converter(local_dBias);
       }
     }
   } // m_b
-  for (int m_b = 0; m_b < kBlockM; ++m_b) {
-    for (int n_b = 0; n_b < kBlockN; ++n_b) {
-      if (m + m_b < cute::size<0>(epilogue_params.D.layout()) && n + n_b < cute::size<1>(epilogue_params.D.layout())) {
-        epilogue_params.D(m + m_b, n + n_b, l) = destination_converter(inter_accum[m_b][n_b]);
-      }
+  for (int m_b = 0; m_b < m_end; ++m_b) {
+    for (int n_b = 0; n_b < n_end; ++n_b) {
+      epilogue_params.D(m + m_b, n + n_b, l) = destination_converter(inter_accum[m_b][n_b]);
     }
   }
 #if defined(_OPENMP)
@@ -35,10 +35,27 @@
 #pragma once
 
 // Standard Library includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 // Cutlass includes
 #include "cutlass/cutlass.h"
+#include "cutlass/complex.h"
+#include "cutlass/core_io.h"
+#include "cutlass/functional.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/layout/vector.h"
+#include "cutlass/numeric_types.h"
 #include "cutlass/relatively_equal.h"
 #include "cutlass/tensor_view.h"
 #include "cutlass/tensor_view_planar_complex.h"
@@ -53,97 +70,721 @@ namespace host {
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-namespace detail {
+/// Number of buckets in the ULP histogram of a TensorCompareReport. Bucket 0 counts elements whose
+/// values are identical, bucket i counts distances in [2^(i-1), 2^i), and the last bucket also
+/// counts all larger distances and comparisons involving NaN.
+static int const kTensorCompareUlpBuckets = 32;
+
+/// Controls what a tensor comparison records and when it stops
+struct TensorCompareOptions {
+
+  /// Number of mismatching elements whose coordinates and values are recorded
+  int max_mismatches;
+
+  /// If true, the comparison stops at the first mismatching element
+  bool early_exit;
+
+  /// Ctor
+  TensorCompareOptions(int max_mismatches_ = 16, bool early_exit_ = false):
+    max_mismatches(max_mismatches_), early_exit(early_exit_) { }
+};
 
+/// Result of comparing a computed tensor (lhs) against a reference tensor (rhs)
 template <
   typename Element,               ///< Element type
   typename Layout>                ///< Layout function
-struct TensorEqualsFunc {
+struct TensorCompareReport {
+
+  using TensorCoord = typename Layout::TensorCoord;
+
+  /// Mismatching element
+  struct Mismatch {
+    TensorCoord coord;
+    Element lhs;
+    Element rhs;
+  };
 
   //
   // Data members
   //
 
-  TensorView<Element, Layout> lhs;
-  TensorView<Element, Layout> rhs;
-  bool result;
+  /// False if the extents of the tensors differ, in which case no elements are compared
+  bool extent_equal;
 
-  /// Ctor
-  TensorEqualsFunc(): result(true) { }
+  /// True if the comparison stopped at the first mismatch. All statistics then cover only the
+  /// elements visited up to and including it.
+  bool stopped_early;
+
+  /// Number of elements compared
+  int64_t count;
+
+  /// Number of mismatching elements
+  int64_t mismatch_count;
+
+  /// Largest absolute difference and its location. NaN differences count as infinite.
+  double max_abs_error;
+  TensorCoord max_abs_error_coord;
+
+  /// Largest difference relative to the magnitude of rhs and its location
+  double max_rel_error;
+  TensorCoord max_rel_error_coord;
+
+  /// Sums of the squared magnitudes of (lhs - rhs) and of rhs
+  double sum_sq_error;
+  double sum_sq_reference;
+
+  /// Histogram of the distances between lhs and rhs in units in the last place of Element
+  std::array<int64_t, kTensorCompareUlpBuckets> ulp_histogram;
+
+  /// First mismatching elements in the order in which they were visited
+  std::vector<Mismatch> mismatches;
+
+  //
+  // Methods
+  //
 
   /// Ctor
-  TensorEqualsFunc(
-    TensorView<Element, Layout> const &lhs_,
-    TensorView<Element, Layout> const &rhs_
-  ) :
-    lhs(lhs_), rhs(rhs_), result(true) { }
+  TensorCompareReport():
+    extent_equal(true),
+    stopped_early(false),
+    count(0),
+    mismatch_count(0),
+    max_abs_error(0),
+    max_abs_error_coord(),
+    max_rel_error(0),
+    max_rel_error_coord(),
+    sum_sq_error(0),
+    sum_sq_reference(0) {
+
+    ulp_histogram.fill(0);
+  }
 
-  /// Visits a coordinate
-  void operator()(Coord<Layout::kRank> const &coord) {
+  /// Returns true if the extents match and no element mismatches
+  bool passed() const {
+    return extent_equal && !mismatch_count;
+  }
+
+  /// Returns true if the extents match and no element mismatches
+  explicit operator bool() const {
+    return passed();
+  }
 
-    Element lhs_ = lhs.at(coord);
-    Element rhs_ = rhs.at(coord);
+  /// Norm of (lhs - rhs) relative to the norm of rhs, the metric of TensorRelativeErrorMetric
+  double relative_error() const {
+    return std::sqrt(sum_sq_error) / std::sqrt(sum_sq_reference);
+  }
+};
 
-    if (lhs_ != rhs_) {
-      result = false;
+/// Prints a summary of a tensor comparison
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+std::ostream &operator<<(std::ostream &out, TensorCompareReport<Element, Layout> const &report) {
+
+  if (!report.extent_equal) {
+    return out << "extents differ";
+  }
+
+  out << report.mismatch_count << " of " << report.count << " elements mismatch"
+    << (report.stopped_early ? " (stopped at first mismatch)" : "") << "\n"
+    << "max abs error: " << report.max_abs_error << " at " << report.max_abs_error_coord << "\n"
+    << "max rel error: " << report.max_rel_error << " at " << report.max_rel_error_coord << "\n"
+    << "relative error: " << report.relative_error() << "\n"
+    << "ulp histogram:";
+
+  for (int bucket = 0; bucket < kTensorCompareUlpBuckets; ++bucket) {
+    if (report.ulp_histogram[bucket]) {
+      out << " [" << (bucket ? (int64_t(1) << (bucket - 1)) : 0) << ", ";
+      if (bucket + 1 < kTensorCompareUlpBuckets) {
+        out << (int64_t(1) << bucket) << ")=";
+      }
+      else {
+        out << "inf)=";
+      }
+      out << report.ulp_histogram[bucket];
     }
   }
 
-  /// Returns true if equal
-  operator bool() const {
-    return result;
+  for (auto const &mismatch : report.mismatches) {
+    out << "\n  " << mismatch.coord << ": " << ScalarIO<Element>(mismatch.lhs)
+      << " vs " << ScalarIO<Element>(mismatch.rhs);
   }
+
+  return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Rank along which consecutive coordinates of a layout are adjacent in memory, or -1
+template <typename Layout>
+struct TensorCompareContiguousRank {
+  static int const value = -1;
 };
 
+template <>
+struct TensorCompareContiguousRank<layout::RowMajor> {
+  static int const value = 1;
+};
+
+template <>
+struct TensorCompareContiguousRank<layout::ColumnMajor> {
+  static int const value = 0;
+};
+
+template <>
+struct TensorCompareContiguousRank<layout::TensorNHWC> {
+  static int const value = 3;
+};
+
+template <>
+struct TensorCompareContiguousRank<layout::TensorNDHWC> {
+  static int const value = 4;
+};
+
+template <>
+struct TensorCompareContiguousRank<layout::PackedVectorLayout> {
+  static int const value = 0;
+};
+
+/// ULP distance of values that cannot be ordered
+static uint64_t const kTensorCompareUlpUnordered = ~uint64_t(0);
+
+/// Distance between two values in units in the last place. Types without a defined ordering only
+/// distinguish equal from unequal values.
+template <typename T, typename Enable = void>
+struct TensorCompareUlp {
+  uint64_t operator()(T a, T b) const {
+    return (a == b) ? 0 : kTensorCompareUlpUnordered;
+  }
+};
+
+/// Integers are one unit apart per representable value
+template <typename T>
+struct TensorCompareUlp<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+  uint64_t operator()(T a, T b) const {
+    return (a < b) ? uint64_t(b) - uint64_t(a) : uint64_t(a) - uint64_t(b);
+  }
+};
+
+template <int Bits, bool Signed>
+struct TensorCompareUlp<integer_subbyte<Bits, Signed>> {
+  uint64_t operator()(integer_subbyte<Bits, Signed> a, integer_subbyte<Bits, Signed> b) const {
+    int64_t x = int64_t(a);
+    int64_t y = int64_t(b);
+    return uint64_t(x < y ? y - x : x - y);
+  }
+};
+
+/// Floating-point values are ordered by mapping their sign-magnitude encodings onto integers, so
+/// adjacent representable values are one unit apart and +0 and -0 coincide.
+template <typename T, typename Storage>
+struct TensorCompareUlpFloat {
+
+  /// Negates the magnitude of negative values without branching, as signs are unpredictable
+  static int64_t ordered(Storage bits) {
+    int const kSignBit = int(sizeof(Storage) * 8 - 1);
+    int64_t magnitude = int64_t(bits & Storage(~(Storage(1) << kSignBit)));
+    int64_t negative = -int64_t(bits >> kSignBit);
+    return (magnitude ^ negative) - negative;
+  }
+
+  uint64_t operator()(T a, T b) const {
+    Storage bits_a;
+    Storage bits_b;
+    std::memcpy(&bits_a, &a, sizeof(Storage));
+    std::memcpy(&bits_b, &b, sizeof(Storage));
+
+    int64_t x = ordered(bits_a);
+    int64_t y = ordered(bits_b);
+
+    // The distance is below 2^64, so the wrapped unsigned difference holds it exactly
+    uint64_t distance = uint64_t(std::max(x, y)) - uint64_t(std::min(x, y));
+    uint64_t unordered = uint64_t(std::isnan(float(a)) | std::isnan(float(b)));
+
+    // Selects kTensorCompareUlpUnordered with a mask, so that loops over elements vectorize
+    return distance | (uint64_t(0) - unordered);
+  }
+};
+
+template <>
+struct TensorCompareUlp<float> : TensorCompareUlpFloat<float, uint32_t> { };
+
+template <>
+struct TensorCompareUlp<double> : TensorCompareUlpFloat<double, uint64_t> { };
+
+template <>
+struct TensorCompareUlp<half_t> : TensorCompareUlpFloat<half_t, uint16_t> { };
+
+template <>
+struct TensorCompareUlp<bfloat16_t> : TensorCompareUlpFloat<bfloat16_t, uint16_t> { };
+
+template <>
+struct TensorCompareUlp<tfloat32_t> : TensorCompareUlpFloat<tfloat32_t, uint32_t> { };
+
+template <>
+struct TensorCompareUlp<float_e4m3_t> : TensorCompareUlpFloat<float_e4m3_t, uint8_t> { };
+
+template <>
+struct TensorCompareUlp<float_e5m2_t> : TensorCompareUlpFloat<float_e5m2_t, uint8_t> { };
+
+/// Complex values are as far apart as their furthest component
+template <typename T>
+struct TensorCompareUlp<complex<T>> {
+  uint64_t operator()(complex<T> a, complex<T> b) const {
+    TensorCompareUlp<T> ulp;
+    return std::max(ulp(a.real(), b.real()), ulp(a.imag(), b.imag()));
+  }
+};
+
+/// Histogram bucket of a ULP distance: its bit length, clamped to the last bucket
+inline int TensorCompareUlpBucket(uint64_t ulp) {
+  if (!ulp) {
+    return 0;
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  int bit_length = 64 - __builtin_clzll(ulp);
+#else
+  int bit_length = 0;
+  for (; ulp; ulp >>= 1) {
+    ++bit_length;
+  }
+#endif
+  return std::min(bit_length, kTensorCompareUlpBuckets - 1);
+}
+
+/// Elements match if they compare equal
+template <typename Element>
+struct TensorCompareEqualsPredicate {
+  bool operator()(Element lhs, Element rhs) const {
+    return !(lhs != rhs);
+  }
+};
+
+/// Elements match if they are relatively equal
+template <typename Element>
+struct TensorCompareRelativelyEqualsPredicate {
+  Element epsilon;
+  Element nonzero_floor;
+
+  bool operator()(Element lhs, Element rhs) const {
+    return relatively_equal(lhs, rhs, epsilon, nonzero_floor);
+  }
+};
+
+/// Accumulates a TensorCompareReport over part of the index space. Without statistics, only
+/// mismatches are counted and recorded.
 template <
   typename Element,               ///< Element type
-  typename Layout>                ///< Layout function
-struct TensorRelativelyEqualsFunc {
+  typename Layout,                ///< Layout function
+  typename Predicate,             ///< returns true if two elements match
+  bool Statistics>                ///< if true, error statistics are accumulated
+struct TensorCompareVisitor {
+
+  using Report = TensorCompareReport<Element, Layout>;
+  using TensorCoord = typename Layout::TensorCoord;
+  using Index = typename Layout::Index;
+
+  static int const kRank = Layout::kRank;
+
+  /// Elements tested for a mismatch before the first failing element is located
+  static int const kBlockSize = 64;
+
+  /// Independent partial sums of squares, so that sums over contiguous elements vectorize
+  static int const kLanes = 8;
 
   //
   // Data members
   //
 
-  TensorView<Element, Layout> lhs;
-  TensorView<Element, Layout> rhs;
-  Element epsilon;
-  Element nonzero_floor;
-  bool result;
+  Report &report;
+  Predicate const &predicate;
+  TensorCompareOptions const &options;
 
-  /// Ctor
-  TensorRelativelyEqualsFunc(
-    TensorView<Element, Layout> const &lhs_,
-    TensorView<Element, Layout> const &rhs_,
-    Element epsilon_,
-    Element nonzero_floor_
-  ) :
-    lhs(lhs_),
-    rhs(rhs_),
-    epsilon(epsilon_),
-    nonzero_floor(nonzero_floor_),
-    result(true) { }
+  /// Squares of the largest absolute and relative errors
+  double max_abs_error_sq;
+  double max_rel_error_sq;
 
-  /// Visits a coordinate
-  void operator()(Coord<Layout::kRank> const &coord) {
+  //
+  // Methods
+  //
+
+  TensorCompareVisitor(Report &report_, Predicate const &predicate_, TensorCompareOptions const &options_):
+    report(report_), predicate(predicate_), options(options_), max_abs_error_sq(0), max_rel_error_sq(0) { }
+
+  /// Coordinate i elements past row along rank
+  static TensorCoord coord(Coord<kRank> const &row, int rank, Index i) {
+    Coord<kRank> result = row;
+    result[rank] += i;
+    return TensorCoord(result);
+  }
+
+  /// Accumulates the error statistics of the elements [begin, end) of a span starting at
+  /// coordinate row and advancing along rank. Elements are loaded by load(i).
+  template <typename Load>
+  void accumulate(Load const &load, Coord<kRank> const &row, int rank, Index begin, Index end) {
+
+    double sum_sq_error[kLanes] = {0};
+    double sum_sq_reference[kLanes] = {0};
+
+    double error_sq[kBlockSize];
+    double reference_sq[kBlockSize];
+    double rel_error_sq[kBlockSize];
+    int bucket[kBlockSize];
+
+    for (Index block = begin; block < end; block += kBlockSize) {
+      int count = int(std::min(Index(end - block), Index(kBlockSize)));
+
+      // Branch-free passes over the block
+      for (int i = 0; i < count; ++i) {
+        std::pair<Element, Element> x = load(block + i);
+
+        error_sq[i] = magnitude_squared_difference<Element, double>()(x.first, x.second);
+        reference_sq[i] = magnitude_squared<Element, double>()(x.second);
+        rel_error_sq[i] = error_sq[i] / reference_sq[i];
+        bucket[i] = TensorCompareUlpBucket(TensorCompareUlp<Element>()(x.first, x.second));
+      }
+
+      int i = 0;
+      for (; i + kLanes <= count; i += kLanes) {
+        for (int lane = 0; lane < kLanes; ++lane) {
+          sum_sq_error[lane] += error_sq[i + lane];
+          sum_sq_reference[lane] += reference_sq[i + lane];
+        }
+      }
+      for (int lane = 0; i < count; ++i, ++lane) {
+        sum_sq_error[lane] += error_sq[i];
+        sum_sq_reference[lane] += reference_sq[i];
+      }
+
+      for (i = 0; i < count; ++i) {
+        ++report.ulp_histogram[bucket[i]];
+      }
+
+      // New maxima are rare, so these branches are predictable. Zero errors yield NaN relative
+      // errors, which are never the maximum.
+      for (i = 0; i < count; ++i) {
+        if (!(error_sq[i] <= max_abs_error_sq)) {
+          if (std::isnan(error_sq[i])) {
+            error_sq[i] = std::numeric_limits<double>::infinity();
+            rel_error_sq[i] = error_sq[i];
+          }
+          max_abs_error_sq = error_sq[i];
+          report.max_abs_error_coord = coord(row, rank, block + i);
+        }
+        if (rel_error_sq[i] > max_rel_error_sq) {
+          max_rel_error_sq = rel_error_sq[i];
+          report.max_rel_error_coord = coord(row, rank, block + i);
+        }
+      }
+    }
+
+    for (int lane = 0; lane < kLanes; ++lane) {
+      report.sum_sq_error += sum_sq_error[lane];
+      report.sum_sq_reference += sum_sq_reference[lane];
+    }
+  }
+
+  /// Counts and records a mismatch at coordinate row + i along rank. Returns true if the
+  /// comparison stops.
+  bool mismatch(Element lhs, Element rhs, Coord<kRank> const &row, int rank, Index i) {
 
-    Element lhs_ = lhs.at(coord);
-    Element rhs_ = rhs.at(coord);
+    ++report.mismatch_count;
 
-    if (!relatively_equal(lhs_, rhs_, epsilon, nonzero_floor)) {
-      result = false;
+    if (int64_t(report.mismatches.size()) < int64_t(options.max_mismatches)) {
+      report.mismatches.push_back({coord(row, rank, i), lhs, rhs});
     }
+
+    if (options.early_exit) {
+      report.stopped_early = true;
+      return true;
+    }
+
+    return false;
   }
 
-  /// Returns true if equal
-  operator bool() const {
-    return result;
+  /// Visits one element at coordinate row. Returns true if the comparison stops.
+  bool visit(Element lhs, Element rhs, Coord<kRank> const &row) {
+
+    ++report.count;
+
+    if (Statistics) {
+      accumulate([&](Index) { return std::make_pair(lhs, rhs); }, row, 0, 0, 1);
+    }
+
+    return !predicate(lhs, rhs) && mismatch(lhs, rhs, row, 0, 0);
+  }
+
+  /// Visits count elements adjacent in memory, starting at coordinate row and advancing along
+  /// rank. Returns true if the comparison stops.
+  bool visit_contiguous(
+    Element const *lhs,
+    Element const *rhs,
+    Coord<kRank> const &row,
+    int rank,
+    Index count) {
+
+    auto load = [lhs, rhs](Index i) { return std::make_pair(lhs[i], rhs[i]); };
+
+    // Test blocks of elements without branching so the loop vectorizes, and only revisit
+    // the elements of a block containing a mismatch.
+    for (Index block = 0; block < count; block += kBlockSize) {
+      Index block_end = std::min(Index(block + kBlockSize), count);
+
+      bool match = true;
+      for (Index i = block; i < block_end; ++i) {
+        match &= predicate(lhs[i], rhs[i]);
+      }
+
+      if (match || !options.early_exit) {
+        if (Statistics) {
+          accumulate(load, row, rank, block, block_end);
+        }
+        report.count += block_end - block;
+      }
+
+      if (match) {
+        continue;
+      }
+
+      for (Index i = block; i < block_end; ++i) {
+
+        if (options.early_exit) {
+          // Statistics stop at the mismatch that ends the comparison
+          ++report.count;
+          if (Statistics) {
+            accumulate(load, row, rank, i, i + 1);
+          }
+        }
+
+        if (!predicate(lhs[i], rhs[i]) && mismatch(lhs[i], rhs[i], row, rank, i)) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /// Stores the largest errors in the report
+  void finish() {
+    report.max_abs_error = std::sqrt(max_abs_error_sq);
+    report.max_rel_error = std::sqrt(max_rel_error_sq);
   }
 };
 
+/// Appends the report of a later part of the index space to an accumulated report
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+void TensorCompareMerge(
+  TensorCompareReport<Element, Layout> &report,
+  TensorCompareReport<Element, Layout> const &part,
+  int max_mismatches) {
+
+  report.stopped_early = report.stopped_early || part.stopped_early;
+  report.count += part.count;
+  report.mismatch_count += part.mismatch_count;
+
+  if (part.max_abs_error > report.max_abs_error) {
+    report.max_abs_error = part.max_abs_error;
+    report.max_abs_error_coord = part.max_abs_error_coord;
+  }
+
+  if (part.max_rel_error > report.max_rel_error) {
+    report.max_rel_error = part.max_rel_error;
+    report.max_rel_error_coord = part.max_rel_error_coord;
+  }
+
+  report.sum_sq_error += part.sum_sq_error;
+  report.sum_sq_reference += part.sum_sq_reference;
+
+  for (int bucket = 0; bucket < kTensorCompareUlpBuckets; ++bucket) {
+    report.ulp_histogram[bucket] += part.ulp_histogram[bucket];
+  }
+
+  for (auto const &mismatch : part.mismatches) {
+    if (int64_t(report.mismatches.size()) >= int64_t(max_mismatches)) {
+      break;
+    }
+    report.mismatches.push_back(mismatch);
+  }
+}
+
+/// Compares two tensor views in a single pass.
+///
+/// The index space is visited in fixed-size chunks of the linearized index space, in parallel when
+/// OpenMP is enabled, and the chunk reports are merged in order, so the report does not depend on
+/// the number of threads. Layouts with a contiguous rank are visited along that rank innermost so
+/// that elements are read directly from memory. With early exit, chunks past the first one holding
+/// a mismatch are abandoned, and the report covers the elements up to that mismatch.
+template <
+  bool Statistics,                ///< if true, error statistics are accumulated
+  typename Element,               ///< Element type
+  typename Layout,                ///< Layout function
+  typename Predicate>             ///< returns true if two elements match
+TensorCompareReport<Element, Layout> TensorCompare(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  Predicate const &predicate,
+  TensorCompareOptions const &options) {
+
+  using Report = TensorCompareReport<Element, Layout>;
+  using Visitor = TensorCompareVisitor<Element, Layout, Predicate, Statistics>;
+  using Index = typename Layout::Index;
+
+  static int const kRank = Layout::kRank;
+
+  // Sub-byte elements are not individually addressable
+  static int const kContiguousRank = (sizeof_bits<Element>::value % 8 == 0) ?
+    TensorCompareContiguousRank<Layout>::value : -1;
+
+  Report report;
+
+  if (lhs.extent() != rhs.extent()) {
+    report.extent_equal = false;
+    return report;
+  }
+
+  // Visit the contiguous rank innermost: rank order[i] varies i-th slowest
+  Coord<kRank> extent = lhs.extent();
+  Coord<kRank> order;
+  Coord<kRank> order_extent;
+
+  for (int i = 0, rank = 0; rank < kRank; ++rank) {
+    if (rank != kContiguousRank) {
+      order[i++] = rank;
+    }
+  }
+
+  if (kContiguousRank >= 0) {
+    order[kRank - 1] = kContiguousRank;
+  }
+
+  for (int i = 0; i < kRank; ++i) {
+    order_extent[i] = extent[order[i]];
+  }
+
+  int64_t size = TensorForEachSize(extent);
+  int64_t chunk_count = (size + kTensorForEachChunkSize - 1) / kTensorForEachChunkSize;
+
+  if (chunk_count == 0) {
+    return report;
+  }
+
+  std::vector<Report> parts(static_cast<size_t>(chunk_count));
+  std::atomic<int64_t> first_stopped(chunk_count);
+
+  auto compare_chunk = [&](int64_t chunk) {
+
+    if (options.early_exit && first_stopped.load(std::memory_order_relaxed) < chunk) {
+      return;
+    }
+
+    Visitor visitor(parts[chunk], predicate, options);
+
+    int64_t begin = chunk * kTensorForEachChunkSize;
+    int64_t end = std::min(begin + kTensorForEachChunkSize, size);
+
+    Coord<kRank> order_coord;
+    cutlass::reference::detail::LinearToCoordinate<kRank>()(order_coord, begin, order_extent);
+
+    for (int64_t idx = begin; idx < end; ) {
+
+      Coord<kRank> coord;
+      for (int i = 0; i < kRank; ++i) {
+        coord[order[i]] = order_coord[i];
+      }
+
+      Index count = 1;
+      bool stop;
+
+      if (kContiguousRank >= 0) {
+        count = Index(std::min(int64_t(order_extent[kRank - 1] - order_coord[kRank - 1]), end - idx));
+        stop = visitor.visit_contiguous(
+          lhs.data() + lhs.offset(coord), rhs.data() + rhs.offset(coord), coord, kContiguousRank, count);
+      }
+      else {
+        stop = visitor.visit(lhs.at(coord), rhs.at(coord), coord);
+      }
+
+      if (stop) {
+        int64_t stopped = first_stopped.load(std::memory_order_relaxed);
+        while (chunk < stopped && !first_stopped.compare_exchange_weak(stopped, chunk)) { }
+        break;
+      }
+
+      idx += count;
+      order_coord[kRank - 1] += count - 1;
+      TensorForEachIncrement(order_coord, order_extent);
+
+      if (options.early_exit && first_stopped.load(std::memory_order_relaxed) < chunk) {
+        break;
+      }
+    }
+
+    visitor.finish();
+  };
+
+  if (chunk_count == 1) {
+    compare_chunk(0);
+  }
+  else {
+#if defined(_OPENMP)
+    #pragma omp parallel for schedule(static)
+#endif
+    for (int64_t chunk = 0; chunk < chunk_count; ++chunk) {
+      compare_chunk(chunk);
+    }
+  }
+
+  int64_t last_chunk = options.early_exit ? std::min(first_stopped.load(), chunk_count - 1) : chunk_count - 1;
+
+  report = std::move(parts[0]);
+  for (int64_t chunk = 1; chunk <= last_chunk; ++chunk) {
+    TensorCompareMerge(report, parts[chunk], options.max_mismatches);
+  }
+
+  return report;
+}
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Compares two tensor views elementwise for equality in a single pass, recording error
+/// statistics and the first mismatching elements.
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+TensorCompareReport<Element, Layout> TensorEqualsReport(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  TensorCompareOptions const &options = TensorCompareOptions()) {
+
+  return detail::TensorCompare<true>(lhs, rhs, detail::TensorCompareEqualsPredicate<Element>(), options);
+}
+
+/// Compares two tensor views elementwise for relative equality in a single pass, recording error
+/// statistics and the first mismatching elements.
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+TensorCompareReport<Element, Layout> TensorRelativelyEqualsReport(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  Element epsilon,
+  Element nonzero_floor,
+  TensorCompareOptions const &options = TensorCompareOptions()) {
+
+  return detail::TensorCompare<true>(
+    lhs, rhs, detail::TensorCompareRelativelyEqualsPredicate<Element>{epsilon, nonzero_floor}, options);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Returns true if two tensor views are equal.
 template <
   typename Element,               ///< Element type
@@ -152,18 +793,8 @@ bool TensorEquals(
   TensorView<Element, Layout> const &lhs,
   TensorView<Element, Layout> const &rhs) {
 
-  // Extents must be identical
-  if (lhs.extent() != rhs.extent()) {
-    return false;
-  }
-
-  detail::TensorEqualsFunc<Element, Layout> func(lhs, rhs);
-  TensorForEach(
-    lhs.extent(),
-    func
-  );
-
-  return bool(func);
+  return detail::TensorCompare<false>(
+    lhs, rhs, detail::TensorCompareEqualsPredicate<Element>(), TensorCompareOptions(0, true)).passed();
 }
 
 /// Returns true if two tensor views are equal.
@@ -179,31 +810,16 @@ bool TensorEquals(
     return false;
   }
 
-  detail::TensorEqualsFunc<Element, Layout> real_func(
-    {lhs.data(), lhs.layout(), lhs.extent()},
-    {rhs.data(), rhs.layout(), rhs.extent()}
-  );
+  if (!TensorEquals(
+    TensorView<Element, Layout>(lhs.data(), lhs.layout(), lhs.extent()),
+    TensorView<Element, Layout>(rhs.data(), rhs.layout(), rhs.extent()))) {
 
-  TensorForEach(
-    lhs.extent(),
-    real_func
-  );
-
-  if (!bool(real_func)) {
     return false;
   }
 
-  detail::TensorEqualsFunc<Element, Layout> imag_func(
-    {lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()}, 
-    {rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()}
-    );
-
-  TensorForEach(
-    lhs.extent(),
-    imag_func
-  );
-
-  return bool(imag_func);
+  return TensorEquals(
+    TensorView<Element, Layout>(lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()),
+    TensorView<Element, Layout>(rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -219,18 +835,11 @@ bool TensorRelativelyEquals(
   Element epsilon,
   Element nonzero_floor) {
 
-  // Extents must be identical
-  if (lhs.extent() != rhs.extent()) {
-    return false;
-  }
-
-  detail::TensorRelativelyEqualsFunc<Element, Layout> func(lhs, rhs, epsilon, nonzero_floor);
-  TensorForEach(
-    lhs.extent(),
-    func
-  );
-
-  return bool(func);
+  return detail::TensorCompare<false>(
+    lhs,
+    rhs,
+    detail::TensorCompareRelativelyEqualsPredicate<Element>{epsilon, nonzero_floor},
+    TensorCompareOptions(0, true)).passed();
 }
 
 /// Returns true if two tensor views are relatively equal.
@@ -248,35 +857,20 @@ bool TensorRelativelyEquals(
     return false;
   }
 
-  detail::TensorRelativelyEqualsFunc<Element, Layout> real_func(
-    {lhs.data(), lhs.layout(), lhs.extent()},
-    {rhs.data(), rhs.layout(), rhs.extent()},
+  if (!TensorRelativelyEquals(
+    TensorView<Element, Layout>(lhs.data(), lhs.layout(), lhs.extent()),
+    TensorView<Element, Layout>(rhs.data(), rhs.layout(), rhs.extent()),
     epsilon,
-    nonzero_floor
-  );
+    nonzero_floor)) {
 
-  TensorForEach(
-    lhs.extent(),
-    real_func
-  );
-
-  if (!bool(real_func)) {
     return false;
   }
 
-  detail::TensorEqualsFunc<Element, Layout> imag_func(
-    {lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()},
-    {rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()},
+  return TensorRelativelyEquals(
+    TensorView<Element, Layout>(lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()),
+    TensorView<Element, Layout>(rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()),
     epsilon,
-    nonzero_floor
-  );
-
-  TensorForEach(
-    lhs.extent(),
-    imag_func
-  );
-
-  return bool(imag_func);
+    nonzero_floor);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -290,18 +884,7 @@ bool TensorNotEquals(
   TensorView<Element, Layout> const &lhs,
   TensorView<Element, Layout> const &rhs) {
 
-  // Extents must be identical
-  if (lhs.extent() != rhs.extent()) {
-    return true;
-  }
-
-  detail::TensorEqualsFunc<Element, Layout> func(lhs, rhs);
-  TensorForEach(
-    lhs.extent(),
-    func
-  );
-
-  return !bool(func);
+  return !TensorEquals(lhs, rhs);
 }
 
 /// Returns true if two tensor views are equal.
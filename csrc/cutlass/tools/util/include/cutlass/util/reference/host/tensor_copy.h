@@ -129,7 +129,7 @@ void TensorCopy(
 
   CopyIf copy_if(dst, src, transform);
 
-  TensorForEach(dst.extent(), copy_if);
+  TensorForEachWriting<DstElement>(dst.extent(), copy_if);
 }
 
 
@@ -160,7 +160,7 @@ void TensorCopy(
 
   CopyIf copy_if(dst, src_view, transform);
 
-  TensorForEach(dst.extent(), copy_if);
+  TensorForEachWriting<DstElement>(dst.extent(), copy_if);
 }
 
 /// Copies elements from a TensorRef into a TensorView. Assumes source tensor has sufficient extent
@@ -188,7 +188,7 @@ void TensorCopy(
 
   CopyIf copy_if(dst_view, src, transform);
 
-  TensorForEach(src.extent(), copy_if);
+  TensorForEachWriting<DstElement>(src.extent(), copy_if);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
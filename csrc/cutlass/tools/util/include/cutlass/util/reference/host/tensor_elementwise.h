@@ -127,7 +127,7 @@ void TensorAdd(
     cutlass::plus<ElementD>
   > func(d, a, b);
 
-  TensorForEach(
+  TensorForEachWriting<ElementD>(
     d.extent(),
     func); 
 }
@@ -173,7 +173,7 @@ void TensorSub(
     cutlass::minus<ElementD>
   > func(d, a, b);
 
-  TensorForEach(
+  TensorForEachWriting<ElementD>(
     d.extent(),
     func);
 }
@@ -222,7 +222,7 @@ void TensorMul(
     cutlass::multiplies<ElementD>
   > func(d, a, b);
 
-  TensorForEach(
+  TensorForEachWriting<ElementD>(
     d.extent(),
     func);
 }
@@ -268,7 +268,7 @@ void TensorDiv(
     cutlass::divides<ElementD>
   > func(d, a, b);
 
-  TensorForEach(
+  TensorForEachWriting<ElementD>(
     d.extent(),
     func);
 }
@@ -315,7 +315,7 @@ void TensorModulus(
     cutlass::divides<ElementD>
   > func(d, a, b);
 
-  TensorForEach(
+  TensorForEachWriting<ElementD>(
     d.extent(),
     func);
 }
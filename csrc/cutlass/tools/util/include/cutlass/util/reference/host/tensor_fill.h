@@ -35,6 +35,7 @@
 #pragma once
 
 // Standard Library includes
+#include <algorithm>
 #include <utility>
 #include <cstdlib>
 #include <cmath>
@@ -53,6 +54,8 @@
 #include "cutlass/blas3.h"
 
 #include "cutlass/util/distribution.h"
+#include "cutlass/util/reference/detail/linear_to_coordinate.h"
+#include "cutlass/util/reference/detail/philox.h"
 #include "tensor_foreach.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -66,6 +69,10 @@ namespace host {
 
 namespace detail {
 
+using cutlass::reference::detail::Philox4x32;
+using cutlass::reference::detail::philox_uniform;
+using cutlass::reference::detail::philox_uniform_nonzero;
+
 template <
   typename Element,               ///< Element type
   typename Layout>                ///< Layout function
@@ -101,18 +108,89 @@ struct BoxMullerFunc {
 
   void operator()(
     double* rnd,                     ///< Size-2 vector to be filled with random values
+    uint32_t bits0,                  ///< Random bits of the first uniform sample
+    uint32_t bits1,                  ///< Random bits of the second uniform sample
     double  mean = 0,                ///< Mean of the Gaussian distribution
     double  stddev = 1,              ///< Standard deviation of the Gaussian distribution
     double  pi = std::acos(-1)) const {
 
-    double u1 = double(std::rand()) / double(RAND_MAX);
-    double u2 = double(std::rand()) / double(RAND_MAX);
+    double u1 = philox_uniform_nonzero(bits0);
+    double u2 = philox_uniform(bits1);
     rnd[0] = std::sqrt(-2 * std::log(u1)) * std::cos(2 * pi * u2);
     rnd[1] = std::sqrt(-2 * std::log(u1)) * std::sin(2 * pi * u2);
     rnd[0] = mean + stddev * rnd[0];
     rnd[1] = mean + stddev * rnd[1];
   }
 };
+
+/// Fills the contiguous block [ptr, ptr + capacity) with a value, distributing chunks over OpenMP
+/// threads when they are enabled
+template <typename Element>
+void BlockFillValue(Element *ptr, int64_t capacity, Element value) {
+
+  int64_t chunk_count = (capacity + kTensorForEachChunkSize - 1) / kTensorForEachChunkSize;
+
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static) if(chunk_count > 1)
+#endif
+  for (int64_t chunk = 0; chunk < chunk_count; ++chunk) {
+    int64_t begin = chunk * kTensorForEachChunkSize;
+    int64_t end = std::min(begin + kTensorForEachChunkSize, capacity);
+    std::fill(ptr + begin, ptr + end, value);
+  }
+}
+
+/// Index of a coordinate in the row-major enumeration of a view's extent. Random fills key each
+/// element's value by this index, so values depend on neither the layout nor the visiting order.
+template <int Rank>
+uint64_t RandomFillIndex(Coord<Rank> const &coord, Coord<Rank> const &extent) {
+  return uint64_t(cutlass::reference::detail::CoordinateToLinear<Rank>()(coord, extent));
+}
+
+/// Fills the contiguous block [ptr, ptr + capacity) with the values random_func computes for each
+/// offset. Random bits for consecutive elements are generated in batches, and chunks are
+/// distributed over OpenMP threads when they are enabled. Chunks span whole bytes, so sub-byte
+/// elements are safe to write concurrently.
+template <typename Element, typename RandomFunc>
+void BlockFillRandomFunc(Element *ptr, size_t capacity, RandomFunc const &random_func) {
+
+  static int const kBatch = 64;
+
+  int64_t size = int64_t(capacity);
+  int64_t chunk_count = (size + kTensorForEachChunkSize - 1) / kTensorForEachChunkSize;
+  bool sparse = random_func.sparse();
+
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static) if(chunk_count > 1)
+#endif
+  for (int64_t chunk = 0; chunk < chunk_count; ++chunk) {
+    int64_t begin = chunk * kTensorForEachChunkSize;
+    int64_t end = std::min(begin + kTensorForEachChunkSize, size);
+
+    uint32_t bits[4][kBatch];
+    uint32_t nonzero_bits[4][kBatch];
+
+    for (int64_t idx = begin; idx < end; idx += kBatch) {
+      int count = int(std::min(int64_t(kBatch), end - idx));
+
+      random_func.philox.generate(uint64_t(idx), 0, bits);
+      if (sparse) {
+        random_func.philox.generate(uint64_t(idx), 1, nonzero_bits);
+      }
+
+      for (int lane = 0; lane < count; ++lane) {
+        Philox4x32::Result lane_bits;
+        lane_bits[0] = bits[0][lane];
+        lane_bits[1] = bits[1][lane];
+        lane_bits[2] = bits[2][lane];
+        lane_bits[3] = bits[3][lane];
+
+        ReferenceFactory<Element>::get(ptr, idx + lane) =
+          random_func(lane_bits, sparse ? nonzero_bits[0][lane] : 0u);
+      }
+    }
+  }
+}
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -125,9 +203,15 @@ void TensorFill(
   TensorView<Element, Layout> dst,    ///< destination tensor 
   Element val = Element(0)) {               ///< value to uniformly fill it with
 
+  // A packed view of byte-addressable elements covers its whole allocation
+  if (sizeof_bits<Element>::value >= 8 && int64_t(dst.capacity()) == int64_t(dst.size())) {
+    detail::BlockFillValue(dst.data(), int64_t(dst.capacity()), val);
+    return;
+  }
+
   detail::TensorFillFunc<Element, Layout> func(dst, val);
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -159,6 +243,7 @@ struct RandomGaussianFunc {
   int int_scale;
   double pi;
   double pnz;
+  Philox4x32 philox;
 
   //
   // Methods
@@ -170,38 +255,37 @@ struct RandomGaussianFunc {
     int int_scale_ = -1,
     double pnz_ = 100.0
   ):
-    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_) {
-      std::srand((unsigned)seed);
+    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_),
+    philox(seed_) {
   }
 
-  /// Compute random value and update RNG state
-  Element operator()() const {
+  /// Returns true if elements draw a second block of random bits to decide whether they are nonzero
+  bool sparse() const {
+    return pnz < 100.0;
+  }
 
-    // Box-Muller transform to generate random numbers with Normal distribution
-    double u1 = double(std::rand()) / double(RAND_MAX);
-    double u2 = double(std::rand()) / double(RAND_MAX);
+  /// Computes the value of an element from its random bits
+  Element operator()(Philox4x32::Result const &bits, uint32_t nonzero_bits) const {
 
-    // Compute Gaussian random value
-    double rnd = std::sqrt(-2 * std::log(u1)) * std::cos(2 * pi * u2);
-    rnd = mean + stddev * rnd;
+    // Box-Muller transform to generate random numbers with Normal distribution
+    double rnd[2];
+    detail::BoxMullerFunc func;
+    func(rnd, bits[0], bits[1], mean, stddev, pi);
 
     // Scale and convert final result
     Element result;
 
     // Sample from the Bernoulli distribution, and use the result to sample from the Gaussian
-    std::random_device rnd_device;
-    std::mt19937 bernoulli_rnd(rnd_device());
-    std::bernoulli_distribution bernoulli_dist(pnz / 100);
-    bool bernoulli_result = bernoulli_dist(bernoulli_rnd);
+    bool bernoulli_result = !sparse() || philox_uniform(nonzero_bits) < pnz / 100;
 
     // Sample from the Gaussian distribution for a nonzero element
     if (bernoulli_result) {
       if (int_scale >= 0) {
-        rnd = double(std::llround(rnd * double(1 << int_scale))) / double(1 << int_scale);
-        result = static_cast<Element>(rnd);
+        rnd[0] = double(std::llround(rnd[0] * double(1 << int_scale))) / double(1 << int_scale);
+        result = static_cast<Element>(rnd[0]);
       }
       else {
-        result = static_cast<Element>(rnd);
+        result = static_cast<Element>(rnd[0]);
       }
     }
     else {
@@ -210,6 +294,11 @@ struct RandomGaussianFunc {
 
     return result;
   }
+
+  /// Computes the random value of the element at a linear index
+  Element operator()(uint64_t index) const {
+    return (*this)(philox(index), sparse() ? philox(index, 1)[0] : 0u);
+  }
 };
 
 /// Partial specialization for initializing a complex value.
@@ -222,6 +311,7 @@ struct RandomGaussianFunc<complex<Element> > {
   int int_scale;
   double pi;
   double pnz;
+  Philox4x32 philox;
 
   //
   // Methods
@@ -233,24 +323,26 @@ struct RandomGaussianFunc<complex<Element> > {
     int int_scale_ = -1,
     double pnz_ = 100.0
   ):
-    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_) {
-      std::srand((unsigned)seed);
+    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_),
+    philox(seed_) {
   }
 
-  /// Compute random value and update RNG state
-  complex<Element> operator()() const {
+  /// Returns true if elements draw a second block of random bits to decide whether they are nonzero
+  bool sparse() const {
+    return pnz < 100.0;
+  }
+
+  /// Computes the value of an element from its random bits
+  complex<Element> operator()(Philox4x32::Result const &bits, uint32_t nonzero_bits) const {
 
     Element reals[2];
 
     double rnd[2];
     detail::BoxMullerFunc func;
-    func(rnd, mean, stddev, pi);
+    func(rnd, bits[0], bits[1], mean, stddev, pi);
 
     // Sample from the Bernoulli distribution, and use the result to sample from the Gaussian
-    std::random_device rnd_device;
-    std::mt19937 bernoulli_rnd(rnd_device());
-    std::bernoulli_distribution bernoulli_dist(pnz / 100);
-    bool bernoulli_result = bernoulli_dist(bernoulli_rnd);
+    bool bernoulli_result = !sparse() || philox_uniform(nonzero_bits) < pnz / 100;
 
     // Sample from the Gaussian distribution for a nonzero element
     if (bernoulli_result) {
@@ -272,6 +364,11 @@ struct RandomGaussianFunc<complex<Element> > {
 
     return complex<Element>(reals[0], reals[1]);
   }
+
+  /// Computes the random value of the element at a linear index
+  complex<Element> operator()(uint64_t index) const {
+    return (*this)(philox(index), sparse() ? philox(index, 1)[0] : 0u);
+  }
 };
 
 /// Partial specialization for initializing a complex value.
@@ -284,6 +381,7 @@ struct RandomGaussianFunc<Quaternion<Element> > {
   int int_scale;
   double pi;
   double pnz;
+  Philox4x32 philox;
 
   //
   // Methods
@@ -295,26 +393,28 @@ struct RandomGaussianFunc<Quaternion<Element> > {
     int int_scale_ = -1,
     double pnz_ = 100.0
   ):
-    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_) {
-      std::srand((unsigned)seed);
+    seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_),
+    philox(seed_) {
   }
 
-  /// Compute random value and update RNG state
-  Quaternion<Element> operator()() const {
+  /// Returns true if elements draw a second block of random bits to decide whether they are nonzero
+  bool sparse() const {
+    return pnz < 100.0;
+  }
+
+  /// Computes the value of an element from its random bits
+  Quaternion<Element> operator()(Philox4x32::Result const &bits, uint32_t nonzero_bits) const {
 
     Element reals[4];
 
     double rnd1[2];
     double rnd2[2];
     detail::BoxMullerFunc func;
-    func(rnd1, mean, stddev, pi);
-    func(rnd2, mean, stddev, pi);
+    func(rnd1, bits[0], bits[1], mean, stddev, pi);
+    func(rnd2, bits[2], bits[3], mean, stddev, pi);
 
     // Sample from the Bernoulli distribution, and use the result to sample from the Gaussian
-    std::random_device rnd_device;
-    std::mt19937 bernoulli_rnd(rnd_device());
-    std::bernoulli_distribution bernoulli_dist(pnz / 100);
-    bool bernoulli_result = bernoulli_dist(bernoulli_rnd);
+    bool bernoulli_result = !sparse() || philox_uniform(nonzero_bits) < pnz / 100;
 
     // Sample from the Gaussian distribution for a nonzero element
     if (bernoulli_result) {
@@ -345,6 +445,11 @@ struct RandomGaussianFunc<Quaternion<Element> > {
 
     return Quaternion<Element>(reals[0], reals[1], reals[2], reals[3]);
   }
+
+  /// Computes the random value of the element at a linear index
+  Quaternion<Element> operator()(uint64_t index) const {
+    return (*this)(philox(index), sparse() ? philox(index, 1)[0] : 0u);
+  }
 };
 
 /// Computes a random Gaussian distribution
@@ -377,7 +482,7 @@ struct TensorFillGaussianFunc {
 
   /// Compute random value and update RNG state
   void operator()(Coord<Layout::kRank> const &coord) const {
-    view.at(coord) = func();
+    view.at(coord) = func(RandomFillIndex(coord, view.extent()));
   }
 };
 
@@ -417,11 +522,11 @@ struct TensorFillSymmetricGaussianFunc {
     if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kLower &&
         coord[0] >= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(RandomFillIndex(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         coord[0] <= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(RandomFillIndex(coord, view.extent()));
     }
   }
 };
@@ -450,7 +555,7 @@ void TensorFillRandomGaussian(
     random_func
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -496,7 +601,7 @@ void TensorFillSymmetricRandomGaussian(
     fill_mode
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -521,9 +626,7 @@ void BlockFillRandomGaussian(
 
   detail::RandomGaussianFunc<Element> random_func(seed, mean, stddev, bits, pnz);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ReferenceFactory<Element>::get(ptr, i) = random_func();
-  }
+  detail::BlockFillRandomFunc(ptr, capacity, random_func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -541,6 +644,7 @@ struct RandomUniformFunc {
   double range;
   double min;
   int int_scale;
+  Philox4x32 philox;
 
   //
   // Methods
@@ -552,15 +656,18 @@ struct RandomUniformFunc {
     double min_ = 0,
     int int_scale_ = -1
   ):
-    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
+    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_), philox(seed_) {
     }
 
+  /// Uniform values need a single block of random bits
+  bool sparse() const {
+    return false;
+  }
 
-  /// Compute random value and update RNG state
-  Element operator()() const {
+  /// Computes the value of an element from its random bits
+  Element operator()(Philox4x32::Result const &bits, uint32_t = 0) const {
 
-    double rnd = double(std::rand()) / double(RAND_MAX);
+    double rnd = philox_uniform(bits[0]);
 
     rnd = min + range * rnd;
 
@@ -577,6 +684,11 @@ struct RandomUniformFunc {
 
     return result;
   }
+
+  /// Computes the random value of the element at a linear index
+  Element operator()(uint64_t index) const {
+    return (*this)(philox(index));
+  }
 };
 
 /// Partial specialization for initializing a complex value.
@@ -589,6 +701,7 @@ struct RandomUniformFunc<complex<Element> > {
   double range;
   double min;
   int int_scale;
+  Philox4x32 philox;
 
   //
   // Methods
@@ -600,18 +713,21 @@ struct RandomUniformFunc<complex<Element> > {
     double min_ = 0,
     int int_scale_ = -1
   ):
-    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
+    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_), philox(seed_) {
     }
 
+  /// Uniform values need a single block of random bits
+  bool sparse() const {
+    return false;
+  }
 
-  /// Compute random value and update RNG state
-  complex<Element> operator()() const {
+  /// Computes the value of an element from its random bits
+  complex<Element> operator()(Philox4x32::Result const &bits, uint32_t = 0) const {
 
     Element reals[2];
 
     for (int i = 0; i < 2; ++i) {
-      double rnd = double(std::rand()) / double(RAND_MAX);
+      double rnd = philox_uniform(bits[i]);
 
       rnd = min + range * rnd;
 
@@ -629,6 +745,11 @@ struct RandomUniformFunc<complex<Element> > {
 
     return complex<Element>(reals[0], reals[1]);
   }
+
+  /// Computes the random value of the element at a linear index
+  complex<Element> operator()(uint64_t index) const {
+    return (*this)(philox(index));
+  }
 };
 
 /// Partial specialization for initializing a Quaternion value.
@@ -641,6 +762,7 @@ struct RandomUniformFunc<Quaternion<Element> > {
   double range;
   double min;
   int int_scale;
+  Philox4x32 philox;
 
   //
   // Methods
@@ -652,18 +774,21 @@ struct RandomUniformFunc<Quaternion<Element> > {
     double min_ = 0,
     int int_scale_ = -1
   ):
-    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
+    seed(seed_), range(max - min_), min(min_), int_scale(int_scale_), philox(seed_) {
     }
 
+  /// Uniform values need a single block of random bits
+  bool sparse() const {
+    return false;
+  }
 
-  /// Compute random value and update RNG state
-  Quaternion<Element> operator()() const {
+  /// Computes the value of an element from its random bits
+  Quaternion<Element> operator()(Philox4x32::Result const &bits, uint32_t = 0) const {
 
     Element reals[4];
 
     for (int i = 0; i < 4; ++i) {
-      double rnd = double(std::rand()) / double(RAND_MAX);
+      double rnd = philox_uniform(bits[i]);
 
       rnd = min + range * rnd;
 
@@ -681,6 +806,11 @@ struct RandomUniformFunc<Quaternion<Element> > {
 
     return make_Quaternion(reals[0], reals[1], reals[2], reals[3]);
   }
+
+  /// Computes the random value of the element at a linear index
+  Quaternion<Element> operator()(uint64_t index) const {
+    return (*this)(philox(index));
+  }
 };
 
 /// Computes a random uniform distribution
@@ -714,7 +844,7 @@ struct TensorFillRandomUniformFunc {
   /// Compute random value and update RNG state
   void operator()(Coord<Layout::kRank> const &coord) const {
 
-    view.at(coord) = func();
+    view.at(coord) = func(RandomFillIndex(coord, view.extent()));
   }
 };
 
@@ -754,11 +884,11 @@ struct TensorFillSymmetricRandomUniformFunc {
     if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kLower &&
         coord[0] >= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(RandomFillIndex(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         coord[0] <= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(RandomFillIndex(coord, view.extent()));
     }
   }
 };
@@ -802,12 +932,12 @@ struct TensorFillPadDiagonalRandomUniformFunc {
         (fill_mode == cutlass::FillMode::kLower) &&
         (coord[0] >= coord[1]) || 
         ((coord[1] - coord[0]) >= alignment)) {
-      view.at(coord) = func();
+      view.at(coord) = func(RandomFillIndex(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         (coord[0] <= coord[1]) ||
         ((coord[0] - coord[1]) >= alignment)) {
-      view.at(coord) = func();
+      view.at(coord) = func(RandomFillIndex(coord, view.extent()));
     }
   }
 };
@@ -835,7 +965,7 @@ void TensorFillRandomUniform(
     random_func
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -878,7 +1008,7 @@ void TensorFillRandomUniform(
     random_func
   );
 
-  TensorForEach(
+  TensorForEachWriting<Quaternion<Element>>(
     dst.extent(),
     func
   );
@@ -908,7 +1038,7 @@ void TensorFillSymmetricRandomUniform(
     fill_mode
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -939,7 +1069,7 @@ void TensorFillPadDiagonalRandomUniform(
     alignment
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -977,9 +1107,7 @@ void BlockFillRandomUniform(
                                           ///  data.                 
   detail::RandomUniformFunc<Element> random_func(seed, max, min, bits);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ReferenceFactory<Element>::get(ptr, i) = random_func();
-  }
+  detail::BlockFillRandomFunc(ptr, capacity, random_func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1046,7 +1174,7 @@ void TensorFillDiagonal(
     other
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -1147,7 +1275,7 @@ void TensorUpdateOffDiagonal(
     other
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -1221,7 +1349,7 @@ void TensorFillLinear(
     s
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -1369,6 +1497,7 @@ struct RandomSparseMetaFunc {
   uint64_t seed;
   int range;
   int MetaSizeInBits;
+  Philox4x32 philox;
 
   //
   // Methods
@@ -1378,8 +1507,7 @@ struct RandomSparseMetaFunc {
     uint64_t seed_ = 0, 
     int MetaSizeInBits_ = 2
   ):
-    seed(seed_), MetaSizeInBits(MetaSizeInBits_) {
-      std::srand((unsigned)seed);
+    seed(seed_), MetaSizeInBits(MetaSizeInBits_), philox(seed_) {
       if (MetaSizeInBits_ == 2) {
         range = 6;
       }
@@ -1391,17 +1519,22 @@ struct RandomSparseMetaFunc {
       }
     }
 
-  /// Compute random value and update RNG state
-  Element operator()() const {
+  /// Computes the random value of the element at a linear index. Each 4-bit field draws one word
+  /// of random bits, four per stream.
+  Element operator()(uint64_t index) const {
     Element FourToTwoMeta[6] = {0x4, 0x8, 0x9, 0xc, 0xd, 0xe};
     Element TwoToOneMeta[2] = {0x4, 0xe};
 
     Element * MetaArray = (MetaSizeInBits == 2) ? FourToTwoMeta : TwoToOneMeta;
 
     Element result = 0x0;
+    Philox4x32::Result bits;
 
     for (int i = 0; i < cutlass::sizeof_bits<Element>::value / 4; ++i) {
-      int rnd = std::rand() % range;
+      if (i % 4 == 0) {
+        bits = philox(index, uint32_t(i / 4));
+      }
+      int rnd = int(bits[i % 4] % uint32_t(range));
       Element meta = MetaArray[rnd];
 
       result = (Element)(result | ((Element)(meta << (i * 4))));
@@ -1442,7 +1575,7 @@ struct TensorFillRandomSparseMetaFunc {
   /// Compute random value and update RNG state
   void operator()(Coord<Layout::kRank> const &coord) const {
 
-    view.at(coord) = func();
+    view.at(coord) = func(RandomFillIndex(coord, view.extent()));
   }
 };
 
@@ -1466,7 +1599,7 @@ void TensorFillRandomSparseMeta(
     random_func
   );
 
-  TensorForEach(
+  TensorForEachWriting<Element>(
     dst.extent(),
     func
   );
@@ -1486,8 +1619,11 @@ void BlockFillRandomSparseMeta(
 
   detail::RandomSparseMetaFunc<Element> random_func(seed, MetaSizeInBits);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ptr[i] = random_func();
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static) if(capacity > size_t(detail::kTensorForEachChunkSize))
+#endif
+  for (int64_t i = 0; i < int64_t(capacity); ++i) {
+    ptr[i] = random_func(uint64_t(i));
   }
 }
 
@@ -1503,10 +1639,24 @@ void TensorFillRandomEllIdx(
   uint64_t seed,                                   ///< seed for RNG
   int rows, int ell_cols, int cols) {              ///< dimension of the matrix 
 
-  std::srand((unsigned)seed);
+  detail::Philox4x32 philox(seed);
 
+  // Each row draws its column indices from its own counter, so rows are independent
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static)
+#endif
   for (int i = 0; i < rows; ++i) {
-    int col_idx = std::rand() % cols;
+    int draw = 0;
+    detail::Philox4x32::Result bits;
+
+    auto next_bits = [&]() {
+      if (draw % 4 == 0) {
+        bits = philox(uint64_t(i), uint32_t(draw / 4));
+      }
+      return bits[draw++ % 4];
+    };
+
+    int col_idx = int(next_bits() % uint32_t(cols));
    
     for (int j = 0; j < ell_cols; ++j) {
       dst.at({i, j}) = col_idx;
@@ -1515,7 +1665,7 @@ void TensorFillRandomEllIdx(
         if (col_idx == (cols - 1)) {
           col_idx = -1;
         } else {
-          col_idx = std::rand() % (cols - col_idx - 1) + col_idx + 1;
+          col_idx = int(next_bits() % uint32_t(cols - col_idx - 1)) + col_idx + 1;
         }
       }
     }
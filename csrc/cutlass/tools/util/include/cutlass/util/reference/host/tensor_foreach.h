@@ -30,8 +30,12 @@
  **************************************************************************************************/
 #pragma once
 
+#include <algorithm>
 #include <stdexcept>
 #include "cutlass/cutlass.h"
+#include "cutlass/coord.h"
+#include "cutlass/numeric_size.h"
+#include "cutlass/util/reference/detail/linear_to_coordinate.h"
 
 namespace cutlass  {
 namespace reference {
@@ -82,6 +86,44 @@ struct TensorForEachHelper<Func, Rank, 0> {
   }
 };
 
+/// Number of consecutive points of the linearized index space visited by one task of
+/// TensorForEachParallel. Index spaces no larger than this are visited serially.
+static int64_t const kTensorForEachChunkSize = 16384;
+
+/// Total number of points in an index space
+template <int Rank>
+int64_t TensorForEachSize(Coord<Rank> const &extent) {
+  int64_t size = 1;
+  for (int i = 0; i < Rank; ++i) {
+    size *= int64_t(extent[i]);
+  }
+  return size;
+}
+
+/// Advances coord to the next point of the index space, fastest changing rank last
+template <int Rank>
+void TensorForEachIncrement(Coord<Rank> &coord, Coord<Rank> const &extent) {
+  for (int i = Rank - 1; i > 0; --i) {
+    if (++coord[i] < extent[i]) {
+      return;
+    }
+    coord[i] = 0;
+  }
+  ++coord[0];
+}
+
+/// Visits the points [begin, end) of the linearized index space
+template <typename Func, int Rank>
+void TensorForEachRange(Func &func, Coord<Rank> const &extent, int64_t begin, int64_t end) {
+  Coord<Rank> coord;
+  cutlass::reference::detail::LinearToCoordinate<Rank>()(coord, begin, extent);
+
+  for (int64_t idx = begin; idx < end; ++idx) {
+    func(coord);
+    TensorForEachIncrement(coord, extent);
+  }
+}
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -108,6 +150,62 @@ void TensorForEachLambda(Coord<Rank> extent, Func func) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Iterates over the index space of a tensor, distributing contiguous chunks of the linearized
+/// index space (and hence of the outermost ranks) over OpenMP threads when they are enabled.
+/// func may be called concurrently for distinct coordinates.
+template <
+  typename Func,          ///< function applied to each point in a tensor's index space
+  int Rank>               ///< rank of index space
+void TensorForEachParallel(Coord<Rank> extent, Func & func) {
+
+  int64_t size = detail::TensorForEachSize(extent);
+  int64_t chunk_count = (size + detail::kTensorForEachChunkSize - 1) / detail::kTensorForEachChunkSize;
+
+  if (chunk_count <= 1) {
+    if (size > 0) {
+      TensorForEach(extent, func);
+    }
+    return;
+  }
+
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int64_t chunk = 0; chunk < chunk_count; ++chunk) {
+    int64_t begin = chunk * detail::kTensorForEachChunkSize;
+    int64_t end = std::min(begin + detail::kTensorForEachChunkSize, size);
+    detail::TensorForEachRange(func, extent, begin, end);
+  }
+}
+
+/// Iterates over the index space of a tensor in parallel and calls a C++ lambda
+template <
+  typename Func,          ///< function applied to each point in a tensor's index space
+  int Rank>               ///< rank of index space
+void TensorForEachLambdaParallel(Coord<Rank> extent, Func func) {
+  TensorForEachParallel(extent, func);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Iterates over the index space of a tensor whose elements func writes. Elements narrower than a
+/// byte share storage with their neighbors, so only byte-addressable elements are written in
+/// parallel.
+template <
+  typename Element,       ///< element written by func
+  typename Func,          ///< function applied to each point in a tensor's index space
+  int Rank>               ///< rank of index space
+void TensorForEachWriting(Coord<Rank> extent, Func & func) {
+  if (sizeof_bits<Element>::value >= 8) {
+    TensorForEachParallel(extent, func);
+  }
+  else {
+    TensorForEach(extent, func);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 template <typename Element, typename Func>
 struct BlockForEach {
 
@@ -30,13 +30,18 @@
  **************************************************************************************************/
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <vector>
 
 #include "cutlass/cutlass.h"
 #include "cutlass/complex.h"
+#include "cutlass/numeric_conversion.h"
 #include "cutlass/tensor_ref.h"
 
 #include "cutlass/util/reference/detail/linear_to_coordinate.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
 #include "cutlass/core_io.h"
 
 namespace cutlass  {
@@ -45,8 +50,92 @@ namespace host {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Transform-reduce operation over the elements of a tensor. This helper allocates the device-side
-/// workspace
+namespace detail {
+
+/// Reduces the points [begin, end) of the linearized index space of extent. Points outside the
+/// view are skipped; the partial starts from the first point's transformed value unless an
+/// initial value is supplied.
+template <
+  typename ComputeType,
+  typename ReduceOp,
+  typename Visit,
+  int Rank
+>
+bool TensorTransformReduceRange(
+  ComputeType &partial,
+  bool has_partial,
+  Coord<Rank> const &extent,
+  int64_t begin,
+  int64_t end,
+  ReduceOp &reduce,
+  Visit &visit) {
+
+  Coord<Rank> coord;
+  cutlass::reference::detail::LinearToCoordinate<Rank>()(coord, begin, extent);
+
+  for (int64_t idx = begin; idx < end; ++idx) {
+    visit(partial, has_partial, reduce, coord);
+    TensorForEachIncrement(coord, extent);
+  }
+
+  return has_partial;
+}
+
+/// Splits the linearized index space into fixed-size chunks, reduces them concurrently, and
+/// combines the partials in chunk order. The chunk size does not depend on the number of threads,
+/// so results are reproducible; index spaces that fit in a single chunk are reduced in exactly the
+/// order of a serial loop.
+template <
+  typename ComputeType,
+  typename ReduceOp,
+  typename Visit,
+  int Rank
+>
+ComputeType TensorTransformReduceChunked(
+  Coord<Rank> const &extent,
+  ComputeType identity,
+  ReduceOp reduce,
+  Visit visit) {
+
+  int64_t size = TensorForEachSize(extent);
+  int64_t chunk_count = (size + kTensorForEachChunkSize - 1) / kTensorForEachChunkSize;
+
+  if (chunk_count <= 1) {
+    if (size > 0) {
+      TensorTransformReduceRange(identity, true, extent, 0, size, reduce, visit);
+    }
+    return identity;
+  }
+
+  std::vector<ComputeType> partials(size_t(chunk_count), identity);
+  std::vector<char> valid(size_t(chunk_count), 0);
+
+#if defined(_OPENMP)
+  #pragma omp parallel for schedule(static)
+#endif
+  for (int64_t chunk = 0; chunk < chunk_count; ++chunk) {
+    int64_t begin = chunk * kTensorForEachChunkSize;
+    int64_t end = std::min(begin + kTensorForEachChunkSize, size);
+
+    ReduceOp chunk_reduce(reduce);
+    valid[chunk] = TensorTransformReduceRange(
+      partials[chunk], chunk == 0, extent, begin, end, chunk_reduce, visit);
+  }
+
+  ComputeType result = partials[0];
+  for (int64_t chunk = 1; chunk < chunk_count; ++chunk) {
+    if (valid[chunk]) {
+      result = reduce(result, partials[chunk]);
+    }
+  }
+
+  return result;
+}
+
+} // namespace detail
+
+/// Transform-reduce operation over the elements of a tensor. The index space is reduced in
+/// parallel chunks whose partials are combined in a fixed order, so reduce must be associative.
 template <
   typename Element,
   typename Layout,
@@ -61,21 +150,29 @@ ComputeType TensorTransformReduce(
   TransformOp transform
 ) {
 
-  for (int64_t idx = 0; idx < int64_t(view.size()); ++idx) {
-    typename Layout::TensorCoord coord;
-    cutlass::reference::detail::LinearToCoordinate<Layout::kRank>()(coord, idx, view.extent());
+  auto visit = [&view, &transform](
+    ComputeType &partial,
+    bool &has_partial,
+    ReduceOp &reduce_op,
+    typename Layout::TensorCoord const &coord) {
 
     if (view.contains(coord)) {
       Element x = view.at(coord);
-      identity = reduce(identity, transform(x));
+      if (has_partial) {
+        partial = reduce_op(partial, transform(x));
+      }
+      else {
+        partial = ComputeType(transform(x));
+        has_partial = true;
+      }
     }
-  }
+  };
 
-  return identity;
+  return detail::TensorTransformReduceChunked(view.extent(), identity, reduce, visit);
 }
 
-/// Transform-reduce operation over the elements of a tensor. This helper allocates the device-side
-/// workspace
+/// Transform-reduce operation over the elements of two tensors. The index space is reduced in
+/// parallel chunks whose partials are combined in a fixed order, so reduce must be associative.
 template <
   typename Element,
   typename Layout,
@@ -94,19 +191,26 @@ ComputeType TensorTransformReduce(
     throw std::runtime_error("Tensor extents must match.");
   }
 
-  for (int64_t idx = 0; idx < int64_t(view_A.size()); ++idx) {
-
-    typename Layout::TensorCoord coord;
-    cutlass::reference::detail::LinearToCoordinate<Layout::kRank>()(coord, idx, view_A.extent());
+  auto visit = [&view_A, &view_B, &transform](
+    ComputeType &partial,
+    bool &has_partial,
+    ReduceOp &reduce_op,
+    typename Layout::TensorCoord const &coord) {
 
     if (view_A.contains(coord)) {
       Element a = view_A.at(coord);
       Element b = view_B.at(coord);
-      identity = reduce(identity, transform(a, b));
+      if (has_partial) {
+        partial = reduce_op(partial, transform(a, b));
+      }
+      else {
+        partial = ComputeType(transform(a, b));
+        has_partial = true;
+      }
     }
-  }
+  };
 
-  return identity;
+  return detail::TensorTransformReduceChunked(view_A.extent(), identity, reduce, visit);
 }
 
 /// Helper to compute the sum of the elements of a tensor
@@ -0,0 +1,686 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Binary tensor files in the NumPy .npy format.
+
+    Files always hold the logical tensor: element (i0, i1, ..., iN) of the extent is stored in C
+    order, or in Fortran order for column-major layouts. Tensors with a padded stride are written
+    row by row, and layouts without a NumPy equivalent are gathered in C order. Element types
+    NumPy does not know (bfloat16_t, tfloat32_t and the float8 types) are described by a
+    single-field structured dtype over their storage integer, e.g. [('bfloat16', '<u2')].
+
+    NpyTensor maps a file into memory copy-on-write when its storage order matches the layout,
+    so large golden tensors are compared without being read or copied. NpyWriter streams a
+    tensor to disk in pieces, for tensors produced incrementally or larger than host memory.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "cutlass/cutlass.h"
+#include "cutlass/complex.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/tensor_view.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/layout/vector.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
+
+namespace cutlass {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// NumPy type descriptor of an element type. Only defined for byte-addressable element types.
+template <typename Element>
+struct NpyDescr;
+
+template <> struct NpyDescr<bool> { static constexpr char const *kValue = "|b1"; };
+template <> struct NpyDescr<int8_t> { static constexpr char const *kValue = "|i1"; };
+template <> struct NpyDescr<uint8_t> { static constexpr char const *kValue = "|u1"; };
+template <> struct NpyDescr<int16_t> { static constexpr char const *kValue = "<i2"; };
+template <> struct NpyDescr<uint16_t> { static constexpr char const *kValue = "<u2"; };
+template <> struct NpyDescr<int32_t> { static constexpr char const *kValue = "<i4"; };
+template <> struct NpyDescr<uint32_t> { static constexpr char const *kValue = "<u4"; };
+template <> struct NpyDescr<int64_t> { static constexpr char const *kValue = "<i8"; };
+template <> struct NpyDescr<uint64_t> { static constexpr char const *kValue = "<u8"; };
+template <> struct NpyDescr<half_t> { static constexpr char const *kValue = "<f2"; };
+template <> struct NpyDescr<float> { static constexpr char const *kValue = "<f4"; };
+template <> struct NpyDescr<double> { static constexpr char const *kValue = "<f8"; };
+template <> struct NpyDescr<complex<float>> { static constexpr char const *kValue = "<c8"; };
+template <> struct NpyDescr<complex<double>> { static constexpr char const *kValue = "<c16"; };
+
+template <> struct NpyDescr<bfloat16_t> {
+  static constexpr char const *kValue = "[('bfloat16', '<u2')]";
+};
+template <> struct NpyDescr<tfloat32_t> {
+  static constexpr char const *kValue = "[('tfloat32', '<u4')]";
+};
+template <> struct NpyDescr<float_e4m3_t> {
+  static constexpr char const *kValue = "[('float_e4m3', '|u1')]";
+};
+template <> struct NpyDescr<float_e5m2_t> {
+  static constexpr char const *kValue = "[('float_e5m2', '|u1')]";
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Order in which a layout stores the logical tensor when packed
+enum class NpyOrder {
+  kNone,        ///< no NumPy equivalent
+  kC,           ///< last rank contiguous
+  kFortran      ///< first rank contiguous
+};
+
+/// Maps a layout to the NumPy storage order of its packed tensors
+template <typename Layout>
+struct NpyLayoutOrder {
+  static NpyOrder const kValue = NpyOrder::kNone;
+};
+
+template <> struct NpyLayoutOrder<layout::RowMajor> {
+  static NpyOrder const kValue = NpyOrder::kC;
+};
+template <> struct NpyLayoutOrder<layout::ColumnMajor> {
+  static NpyOrder const kValue = NpyOrder::kFortran;
+};
+template <> struct NpyLayoutOrder<layout::TensorNHWC> {
+  static NpyOrder const kValue = NpyOrder::kC;
+};
+template <> struct NpyLayoutOrder<layout::TensorNDHWC> {
+  static NpyOrder const kValue = NpyOrder::kC;
+};
+template <> struct NpyLayoutOrder<layout::PackedVectorLayout> {
+  static NpyOrder const kValue = NpyOrder::kC;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Header of a .npy file
+struct NpyHeader {
+
+  /// NumPy type descriptor of the elements
+  std::string descr;
+
+  /// True if the first rank is contiguous
+  bool fortran_order;
+
+  /// Extent of the array
+  std::vector<int64_t> shape;
+
+  /// Offset in bytes of the array data from the start of the file
+  int64_t data_offset;
+
+  NpyHeader(): fortran_order(false), data_offset(0) { }
+
+  /// Number of elements
+  int64_t count() const {
+    int64_t count = 1;
+    for (int64_t extent : shape) {
+      count *= extent;
+    }
+    return count;
+  }
+
+  /// Returns the magic string, version, header length and header dictionary, padded such that
+  /// the array data is 64-byte aligned. Version 2.0 is used for headers larger than 64 KiB.
+  std::string encode() const {
+
+    std::ostringstream dict;
+    dict << "{'descr': ";
+    if (!descr.empty() && descr[0] == '[') {
+      dict << descr;
+    }
+    else {
+      dict << "'" << descr << "'";
+    }
+    dict << ", 'fortran_order': " << (fortran_order ? "True" : "False") << ", 'shape': (";
+    for (size_t i = 0; i < shape.size(); ++i) {
+      dict << (i ? ", " : "") << shape[i];
+    }
+    dict << (shape.size() == 1 ? ",), }" : "), }");
+
+    std::string text = dict.str();
+
+    for (int major = 1; major <= 2; ++major) {
+      size_t preamble = (major == 1 ? 10 : 12);
+      size_t length = text.size() + 1;
+      length += (64 - (preamble + length) % 64) % 64;
+
+      if (major == 1 && length > 0xffff) {
+        continue;
+      }
+
+      std::string result("\x93NUMPY", 6);
+      result += char(major);
+      result += char(0);
+      for (size_t i = 0; i < preamble - 8; ++i) {
+        result += char((length >> (8 * i)) & 0xff);
+      }
+      result += text;
+      result.append(length - text.size() - 1, ' ');
+      result += '\n';
+      return result;
+    }
+    return std::string();
+  }
+
+  /// Reads the header from the start of a stream. Throws std::runtime_error if the stream does
+  /// not hold a supported .npy file.
+  static NpyHeader decode(std::istream &in) {
+
+    char preamble[12];
+    if (!in.read(preamble, 8) || std::memcmp(preamble, "\x93NUMPY", 6)) {
+      throw std::runtime_error("not a .npy file");
+    }
+
+    int major = int(uint8_t(preamble[6]));
+    if (major < 1 || major > 3) {
+      throw std::runtime_error("unsupported .npy version " + std::to_string(major));
+    }
+
+    size_t length_bytes = (major == 1 ? 2 : 4);
+    if (!in.read(preamble + 8, length_bytes)) {
+      throw std::runtime_error("truncated .npy header");
+    }
+
+    size_t length = 0;
+    for (size_t i = 0; i < length_bytes; ++i) {
+      length |= size_t(uint8_t(preamble[8 + i])) << (8 * i);
+    }
+
+    std::string text(length, '\0');
+    if (!in.read(&text[0], length)) {
+      throw std::runtime_error("truncated .npy header");
+    }
+
+    NpyHeader header = parse(text);
+    header.data_offset = int64_t(8 + length_bytes + length);
+    return header;
+  }
+
+  /// Parses the header dictionary
+  static NpyHeader parse(std::string const &text) {
+
+    NpyHeader header;
+
+    auto value_of = [&](char const *key) -> size_t {
+      size_t pos = text.find(key);
+      if (pos == std::string::npos || (pos = text.find(':', pos)) == std::string::npos) {
+        throw std::runtime_error(std::string("missing ") + key + " in .npy header");
+      }
+      return text.find_first_not_of(" ", pos + 1);
+    };
+
+    // descr is either a quoted string or a list of fields
+    size_t pos = value_of("'descr'");
+    if (pos == std::string::npos) {
+      throw std::runtime_error("malformed descr in .npy header");
+    }
+    if (text[pos] == '[') {
+      int depth = 0;
+      size_t end = pos;
+      for (; end < text.size(); ++end) {
+        depth += (text[end] == '[') - (text[end] == ']');
+        if (!depth) {
+          break;
+        }
+      }
+      if (end == text.size()) {
+        throw std::runtime_error("malformed descr in .npy header");
+      }
+      header.descr = text.substr(pos, end + 1 - pos);
+    }
+    else {
+      size_t end = text.find(text[pos], pos + 1);
+      if (end == std::string::npos) {
+        throw std::runtime_error("malformed descr in .npy header");
+      }
+      header.descr = text.substr(pos + 1, end - pos - 1);
+    }
+
+    pos = value_of("'fortran_order'");
+    if (pos != std::string::npos && !text.compare(pos, 4, "True")) {
+      header.fortran_order = true;
+    }
+    else if (pos == std::string::npos || text.compare(pos, 5, "False")) {
+      throw std::runtime_error("malformed fortran_order in .npy header");
+    }
+
+    pos = value_of("'shape'");
+    size_t end = (pos == std::string::npos ? pos : text.find(')', pos));
+    if (end == std::string::npos || text[pos] != '(') {
+      throw std::runtime_error("malformed shape in .npy header");
+    }
+
+    std::istringstream shape(text.substr(pos + 1, end - pos - 1));
+    for (std::string token; std::getline(shape, token, ',');) {
+      if (token.find_first_not_of(" ") == std::string::npos) {
+        continue;
+      }
+      size_t used = 0;
+      int64_t extent = std::stoll(token, &used);
+      if (extent < 0 || token.find_first_not_of(" ", used) != std::string::npos) {
+        throw std::runtime_error("malformed shape in .npy header");
+      }
+      header.shape.push_back(extent);
+    }
+
+    return header;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Calls func(coord) with the first coordinate of each row of a tensor in file order. A row is
+/// the run of elements along the contiguous rank: the last one in C order, the first in Fortran
+/// order.
+template <int Rank, typename Index, typename Func>
+void NpyForEachRow(Coord<Rank, Index> const &extent, bool fortran_order, Func func) {
+
+  // Permute ranks such that file order is C order, then collapse the contiguous rank
+  Coord<Rank> rows;
+  int64_t count = 1;
+  for (int i = 0; i < Rank; ++i) {
+    rows[i] = int(extent[fortran_order ? Rank - 1 - i : i]);
+    count *= rows[i];
+  }
+  if (!count) {
+    return;
+  }
+  count /= rows[Rank - 1];
+  rows[Rank - 1] = 1;
+
+  Coord<Rank> row;
+  Coord<Rank, Index> coord;
+  for (int64_t idx = 0; idx < count; ++idx) {
+    for (int i = 0; i < Rank; ++i) {
+      coord[fortran_order ? Rank - 1 - i : i] = Index(row[i]);
+    }
+    func(coord);
+    reference::host::detail::TensorForEachIncrement(row, rows);
+  }
+}
+
+/// Contiguous rank of a tensor in file order
+template <int Rank>
+int NpyContiguousRank(bool fortran_order) {
+  return fortran_order ? 0 : Rank - 1;
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Writes a .npy file whose contents are streamed in file order through one or more calls to
+/// write(). Throws std::runtime_error on I/O errors and if close() is reached before the number
+/// of elements given by the shape has been written.
+template <typename Element>
+class NpyWriter {
+public:
+
+  static_assert(sizeof_bits<Element>::value % 8 == 0,
+    ".npy files require byte-addressable elements");
+
+private:
+
+  std::string path_;
+  std::ofstream out_;
+  int64_t remaining_;
+
+public:
+
+  NpyWriter(
+    std::string const &path,                      ///< file to create or truncate
+    std::vector<int64_t> const &shape,            ///< extent of the array
+    bool fortran_order = false                    ///< if true, the first rank is contiguous
+  ):
+    path_(path), out_(path, std::ios::binary | std::ios::trunc) {
+
+    NpyHeader header;
+    header.descr = NpyDescr<Element>::kValue;
+    header.fortran_order = fortran_order;
+    header.shape = shape;
+    remaining_ = header.count();
+
+    std::string preamble = header.encode();
+    if (!out_.write(preamble.data(), preamble.size())) {
+      throw std::runtime_error("failed to write " + path_);
+    }
+  }
+
+  NpyWriter(NpyWriter const &) = delete;
+  NpyWriter &operator=(NpyWriter const &) = delete;
+
+  ~NpyWriter() {
+    if (out_.is_open()) {
+      out_.close();
+    }
+  }
+
+  /// Number of elements still to be written
+  int64_t remaining() const {
+    return remaining_;
+  }
+
+  /// Appends count elements in file order
+  void write(Element const *data, int64_t count) {
+    if (count > remaining_) {
+      throw std::runtime_error("too many elements written to " + path_);
+    }
+    if (!out_.write(reinterpret_cast<char const *>(data), count * sizeof(Element))) {
+      throw std::runtime_error("failed to write " + path_);
+    }
+    remaining_ -= count;
+  }
+
+  /// Flushes and closes the file
+  void close() {
+    out_.close();
+    if (out_.fail()) {
+      throw std::runtime_error("failed to write " + path_);
+    }
+    if (remaining_) {
+      throw std::runtime_error(
+        std::to_string(remaining_) + " elements missing from " + path_);
+    }
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Writes the logical tensor of a TensorView to a .npy file
+template <typename Element, typename Layout>
+void TensorViewWriteNpy(std::string const &path, TensorView<Element, Layout> const &view) {
+
+  using TensorCoord = typename Layout::TensorCoord;
+  int const kRank = Layout::kRank;
+  NpyOrder const kOrder = NpyLayoutOrder<Layout>::kValue;
+
+  bool fortran_order = (kOrder == NpyOrder::kFortran);
+  int contiguous_rank = detail::NpyContiguousRank<kRank>(fortran_order);
+
+  std::vector<int64_t> shape;
+  for (int i = 0; i < kRank; ++i) {
+    shape.push_back(int64_t(view.extent()[i]));
+  }
+
+  NpyWriter<Element> writer(path, shape, fortran_order);
+
+  int row_length = int(view.extent()[contiguous_rank]);
+
+  // Rows of layouts without a NumPy equivalent are gathered and written in blocks
+  std::vector<Element> block;
+  size_t const kBlockSize = 65536;
+
+  detail::NpyForEachRow(view.extent(), fortran_order, [&](TensorCoord coord) {
+    if (kOrder != NpyOrder::kNone) {
+      writer.write(view.data() + view.offset(coord), row_length);
+      return;
+    }
+    for (int i = 0; i < row_length; ++i) {
+      coord[contiguous_rank] = i;
+      block.push_back(view.at(coord));
+    }
+    if (block.size() >= kBlockSize) {
+      writer.write(block.data(), int64_t(block.size()));
+      block.clear();
+    }
+  });
+
+  writer.write(block.data(), int64_t(block.size()));
+  writer.close();
+}
+
+/// Writes the logical tensor of a HostTensor's host allocation to a .npy file
+template <typename Element, typename Layout>
+void HostTensorWriteNpy(std::string const &path, HostTensor<Element, Layout> &tensor) {
+  TensorViewWriteNpy(path, tensor.host_view());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Tensor loaded from a .npy file.
+///
+/// The file is mapped into memory copy-on-write when its storage order matches the packed
+/// layout, in which case host_view() refers to the mapping and elements are paged in on first
+/// access; writes through the view are private and never reach the file. Otherwise, or on
+/// platforms without mmap, the elements are read into a packed host allocation.
+///
+/// Throws std::runtime_error if the file cannot be read, or if its element type or rank differ
+/// from those of the tensor.
+template <typename Element_, typename Layout_>
+class NpyTensor {
+public:
+
+  using Element = Element_;
+  using Layout = Layout_;
+  using TensorCoord = typename Layout::TensorCoord;
+  using TensorView = cutlass::TensorView<Element, Layout>;
+
+  static int const kRank = Layout::kRank;
+
+  static_assert(sizeof_bits<Element>::value % 8 == 0,
+    ".npy files require byte-addressable elements");
+
+private:
+
+  TensorCoord extent_;
+  Layout layout_;
+  Element *data_;
+
+  void *mapping_;
+  size_t mapping_size_;
+  std::vector<Element> host_;
+
+public:
+
+  explicit NpyTensor(std::string const &path):
+    layout_(Layout::packed(TensorCoord())), data_(nullptr), mapping_(nullptr), mapping_size_(0) {
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+      throw std::runtime_error("failed to open " + path);
+    }
+
+    NpyHeader header;
+    try {
+      header = NpyHeader::decode(in);
+    }
+    catch (std::exception const &e) {
+      throw std::runtime_error(path + ": " + e.what());
+    }
+
+    if (header.descr != NpyDescr<Element>::kValue) {
+      throw std::runtime_error(path + ": elements are " + header.descr + ", expected " +
+        NpyDescr<Element>::kValue);
+    }
+    if (header.shape.size() != size_t(kRank)) {
+      throw std::runtime_error(path + ": rank " + std::to_string(header.shape.size()) +
+        ", expected " + std::to_string(kRank));
+    }
+
+    for (int i = 0; i < kRank; ++i) {
+      if (header.shape[i] > std::numeric_limits<int>::max()) {
+        throw std::runtime_error(path + ": extent exceeds the range of a tensor coordinate");
+      }
+      extent_[i] = typename TensorCoord::Index(header.shape[i]);
+    }
+    layout_ = Layout::packed(extent_);
+
+    int64_t count = header.count();
+    if (!count) {
+      return;
+    }
+
+    NpyOrder const kOrder = NpyLayoutOrder<Layout>::kValue;
+    bool in_place = (kRank == 1 && kOrder != NpyOrder::kNone) ||
+      (kOrder == (header.fortran_order ? NpyOrder::kFortran : NpyOrder::kC));
+
+    size_t bytes = size_t(count) * sizeof(Element);
+
+#if !defined(_WIN32)
+    if (in_place && header.data_offset % alignof(Element) == 0) {
+      int fd = ::open(path.c_str(), O_RDONLY);
+      struct stat status;
+      if (fd >= 0 && !::fstat(fd, &status) &&
+          size_t(status.st_size) >= size_t(header.data_offset) + bytes) {
+
+        size_t length = size_t(header.data_offset) + bytes;
+        void *mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+          mapping_ = mapping;
+          mapping_size_ = length;
+          data_ = reinterpret_cast<Element *>(
+            static_cast<char *>(mapping) + header.data_offset);
+        }
+      }
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      if (mapping_) {
+        return;
+      }
+    }
+#endif
+
+    std::vector<Element> file(static_cast<size_t>(count));
+    if (!in.read(reinterpret_cast<char *>(file.data()), bytes)) {
+      throw std::runtime_error(path + ": truncated array data");
+    }
+
+    if (in_place) {
+      host_ = std::move(file);
+    }
+    else {
+      // Scatter rows of the file into the packed layout
+      host_.resize(size_t(layout_.capacity(extent_)));
+
+      int contiguous_rank = detail::NpyContiguousRank<kRank>(header.fortran_order);
+      int row_length = int(extent_[contiguous_rank]);
+      Element const *src = file.data();
+
+      detail::NpyForEachRow(extent_, header.fortran_order, [&](TensorCoord coord) {
+        for (int i = 0; i < row_length; ++i) {
+          coord[contiguous_rank] = i;
+          host_[size_t(layout_(coord))] = *src++;
+        }
+      });
+    }
+    data_ = host_.data();
+  }
+
+  NpyTensor(NpyTensor const &) = delete;
+  NpyTensor &operator=(NpyTensor const &) = delete;
+
+  ~NpyTensor() {
+#if !defined(_WIN32)
+    if (mapping_) {
+      ::munmap(mapping_, mapping_size_);
+    }
+#endif
+  }
+
+  /// True if the elements refer to a mapping of the file
+  bool is_mapped() const {
+    return mapping_ != nullptr;
+  }
+
+  /// Extent of the tensor
+  TensorCoord extent() const {
+    return extent_;
+  }
+
+  /// Packed layout of the tensor
+  Layout layout() const {
+    return layout_;
+  }
+
+  /// Pointer to the elements
+  Element *host_data() {
+    return data_;
+  }
+
+  /// View of the tensor
+  TensorView host_view() {
+    return TensorView(data_, layout_, extent_);
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Resets a HostTensor to the packed extent of a .npy file and loads its contents, including
+/// into device memory if the tensor is device backed.
+template <typename Element, typename Layout>
+void HostTensorReadNpy(
+  HostTensor<Element, Layout> &tensor,
+  std::string const &path,
+  bool device_backed = true) {
+
+  NpyTensor<Element, Layout> file(path);
+
+  tensor.reset(file.extent(), device_backed);
+
+  size_t capacity = size_t(file.layout().capacity(file.extent()));
+  if (capacity) {
+    std::memcpy(tensor.host_data(), file.host_data(), capacity * sizeof(Element));
+  }
+
+  if (device_backed) {
+    tensor.sync_device();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
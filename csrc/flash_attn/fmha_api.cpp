@@ -29,8 +29,10 @@
 #include <torch/extension.h>
 #include <torch/torch.h>
 #include <ATen/cuda/CUDAContext.h>
+#include <c10/util/accumulate.h>
 
 #include "fmha.h"
+#include "fmha_scheduler.h"
 
 
 #define CHECK_SHAPE(x, ...) TORCH_CHECK(x.sizes() == torch::IntArrayRef({__VA_ARGS__}), #x " must have shape (" #__VA_ARGS__ ")")
@@ -195,6 +197,341 @@ void set_params_dgrad(FMHA_dgrad_params &params,
     // Softmax sum
     params.dsoftmax_sum = dsoftmax_sum_d;
     params.attn_ds_ptr = attn_ds;
+
+    // set_params_fprop only resets the fprop part of the params. Callers that need the output
+    // gate or the deterministic dq reduction set these afterwards.
+    params.dgate_ptr = nullptr;
+    params.dq_partial_ptr = nullptr;
+    params.deterministic = false;
+}
+
+// Sums x over its first dim by adding halves pairwise, so that the order of the additions is fixed
+// by the shape alone and not by the reduction kernel the backend happens to pick.
+at::Tensor tree_sum_dim0(at::Tensor x) {
+    x = x.to(at::kFloat);
+    while (x.size(0) > 1) {
+        const int64_t half = x.size(0) / 2;
+        auto paired = x.narrow(0, 0, half) + x.narrow(0, half, half);
+        x = x.size(0) % 2 == 0 ? paired : torch::cat({paired, x.narrow(0, 2 * half, 1)});
+    }
+    return x.squeeze(0);
+}
+
+std::vector<at::Tensor>
+mha_fwd_cpu(const at::Tensor &q,         // total_q x num_heads x head_size, total_q := \sum_{i=0}^{b} s_i
+            const at::Tensor &k,         // total_k x num_heads x head_size, total_k := \sum_{i=0}^{b} s_i
+            const at::Tensor &v,         // total_k x num_heads x head_size, total_k := \sum_{i=0}^{b} s_i
+            const at::Tensor &cu_seqlens_q,  // b+1
+            const at::Tensor &cu_seqlens_k,  // b+1
+            const int max_seqlen_q_,
+            const int max_seqlen_k_,
+            const float p_dropout,
+            const float softmax_scale,
+            const bool zero_tensors,
+            const bool is_causal,
+            const bool return_softmax,
+            const c10::optional<at::Tensor> &attn_mask, // attn_mask
+            const c10::optional<at::Tensor> &attn_bias, // attn bias
+            const c10::optional<at::Tensor> &gate, // sigmoid output gate
+            const int64_t memory_budget // bytes per thread for the chunk plan, 0 for half of the L2 cache
+            ) {
+    TORCH_CHECK(p_dropout == 0.f, "Dropout is not supported on CPU");
+    TORCH_CHECK(memory_budget >= 0);
+    TORCH_CHECK(!return_softmax, "return_softmax is not supported on CPU");
+
+    auto q_dtype = q.dtype();
+    TORCH_CHECK(q_dtype == torch::kFloat16 || q_dtype == torch::kBFloat16);
+    TORCH_CHECK(k.dtype() == q_dtype);
+    TORCH_CHECK(v.dtype() == q_dtype);
+    TORCH_CHECK(cu_seqlens_q.dtype() == torch::kInt32);
+    TORCH_CHECK(cu_seqlens_k.dtype() == torch::kInt32);
+
+    TORCH_CHECK(k.is_cpu());
+    TORCH_CHECK(v.is_cpu());
+    TORCH_CHECK(cu_seqlens_q.is_cpu());
+    TORCH_CHECK(cu_seqlens_k.is_cpu());
+
+    TORCH_CHECK(q.stride(-1) == 1);
+    TORCH_CHECK(k.stride(-1) == 1);
+    TORCH_CHECK(v.stride(-1) == 1);
+    TORCH_CHECK(cu_seqlens_q.is_contiguous());
+    TORCH_CHECK(cu_seqlens_k.is_contiguous());
+
+    const auto sizes = q.sizes();
+
+    const int batch_size = cu_seqlens_q.numel() - 1;
+    const int total_q = sizes[TOTAL_DIM];
+    const int num_heads = sizes[H_DIM];
+    const int head_size = sizes[D_DIM];
+    const int total_k = k.size(TOTAL_DIM);
+    TORCH_CHECK(batch_size > 0);
+
+    CHECK_SHAPE(q, total_q, num_heads, head_size);
+    CHECK_SHAPE(k, total_k, num_heads, head_size);
+    CHECK_SHAPE(v, total_k, num_heads, head_size);
+    CHECK_SHAPE(cu_seqlens_q, batch_size + 1);
+    CHECK_SHAPE(cu_seqlens_k, batch_size + 1);
+
+    if (gate.has_value()) {
+        TORCH_CHECK(gate.value().is_cpu());
+        TORCH_CHECK(gate.value().dtype() == q_dtype);
+        TORCH_CHECK(gate.value().is_contiguous());
+        CHECK_SHAPE(gate.value(), total_q, num_heads, head_size);
+    }
+
+    int bias_mod_size = 0;
+    if (attn_bias.has_value()) {
+        TORCH_CHECK(attn_bias.value().is_cpu());
+        TORCH_CHECK(attn_bias.value().dtype() == q_dtype);
+        TORCH_CHECK(attn_bias.value().is_contiguous());
+
+        const auto bias_sizes = attn_bias->sizes();
+        bias_mod_size = bias_sizes[0];
+        TORCH_CHECK(bias_sizes[1] == num_heads);
+    }
+
+    int mask_head_mod_size = 0;
+    int mask_seq_mod_size = 0;
+    if (attn_mask.has_value()) {
+        TORCH_CHECK(attn_mask.value().is_cpu());
+        TORCH_CHECK(attn_mask.value().dtype() == q_dtype);
+        TORCH_CHECK(attn_mask.value().is_contiguous());
+
+        const auto mask_sizes = attn_mask->sizes();
+        mask_head_mod_size = mask_sizes[1];
+        mask_seq_mod_size = mask_sizes[2];
+        TORCH_CHECK(mask_sizes[1] == 1 || mask_sizes[1] == num_heads);
+        TORCH_CHECK(mask_sizes[2] == 1 || mask_sizes[2] == max_seqlen_q_);
+    }
+
+    // Keep the same padding of softmax_lse as the device path so the two can be mixed.
+    const int max_seqlen_k = ((max_seqlen_k_ + FMHA_CPU_BLOCK_N - 1) / FMHA_CPU_BLOCK_N) * FMHA_CPU_BLOCK_N;
+    const int max_seqlen_q = ((max_seqlen_q_ + 16 - 1) / 16) * 16;
+
+    auto opts = q.options();
+
+    auto o = torch::empty({ total_q, num_heads, head_size }, opts);
+    auto softmax_lse = torch::empty({batch_size, num_heads, max_seqlen_q}, opts.dtype(at::kFloat));
+
+    if( zero_tensors ) {
+        o.zero_();
+        softmax_lse.fill_(-std::numeric_limits<float>::infinity());
+    }
+
+    FMHA_fprop_params params;
+    set_params_fprop(params,
+                     batch_size,
+                     max_seqlen_q,
+                     max_seqlen_k,
+                     num_heads,
+                     head_size,
+                     q, k, v,
+                     cu_seqlens_q.data_ptr(),
+                     cu_seqlens_k.data_ptr(),
+                     o.data_ptr(),
+                     nullptr,
+                     nullptr,
+                     softmax_lse.data_ptr(),
+                     p_dropout,
+                     softmax_scale,
+                     is_causal,
+                     attn_mask ? attn_mask->data_ptr() : nullptr,
+                     attn_bias ? attn_bias->data_ptr() : nullptr,
+                     bias_mod_size,
+                     mask_head_mod_size,
+                     mask_seq_mod_size);
+    params.gate_ptr = gate ? gate->data_ptr() : nullptr;
+    const fmha::Chunk_plan plan = fmha::plan_cpu_chunks(head_size, q.element_size(), attn_mask.has_value(),
+                                                        attn_bias.has_value(), memory_budget);
+    params.cpu_block_m = plan.block_m;
+    params.cpu_block_n = plan.block_n;
+
+    run_fmha_fprop_cpu(params);
+
+    return {o, softmax_lse};
+}
+
+std::vector<at::Tensor>
+mha_bwd_cpu(const at::Tensor &dout,  // total_q x num_heads, x head_size
+            const at::Tensor &q,   // total_q x num_heads x head_size, total_q := \sum_{i=0}^{b} s_i
+            const at::Tensor &k,   // total_k x num_heads x head_size, total_k := \sum_{i=0}^{b} s_i
+            const at::Tensor &v,   // total_k x num_heads x head_size, total_k := \sum_{i=0}^{b} s_i
+            const at::Tensor &out,   // total_q x num_heads x head_size
+            const at::Tensor &softmax_lse_,     // b x h x s softmax logsumexp
+            at::Tensor &dq,   // total_q x num_heads x head_size, total_q := \sum_{i=0}^{b} s_i
+            at::Tensor &dk,   // total_k x num_heads x head_size, total_k := \sum_{i=0}^{b} s_i
+            at::Tensor &dv,   // total_k x num_heads x head_size, total_k := \sum_{i=0}^{b} s_i
+            const at::Tensor &cu_seqlens_q,  // b+1
+            const at::Tensor &cu_seqlens_k,  // b+1
+            const int max_seqlen_q_,
+            const int max_seqlen_k_,
+            const float p_dropout,
+            const float softmax_scale,
+            const bool zero_tensors,
+            const bool is_causal,
+            const c10::optional<at::Tensor> &attn_mask, // attn_mask
+            const c10::optional<at::Tensor> &attn_bias, // attn bias
+            const bool deterministic,
+            const c10::optional<at::Tensor> &gate // sigmoid output gate
+) {
+    TORCH_CHECK(p_dropout == 0.f, "Dropout is not supported on CPU");
+
+    auto q_dtype = q.dtype();
+    TORCH_CHECK(q_dtype == torch::kFloat16 || q_dtype == torch::kBFloat16);
+    TORCH_CHECK(k.dtype() == q_dtype);
+    TORCH_CHECK(v.dtype() == q_dtype);
+    TORCH_CHECK(out.dtype() == q_dtype);
+    TORCH_CHECK(dout.dtype() == q_dtype);
+    TORCH_CHECK(dq.dtype() == q_dtype);
+    TORCH_CHECK(dk.dtype() == q_dtype);
+    TORCH_CHECK(dv.dtype() == q_dtype);
+    TORCH_CHECK(cu_seqlens_q.dtype() == torch::kInt32);
+    TORCH_CHECK(cu_seqlens_k.dtype() == torch::kInt32);
+
+    TORCH_CHECK(k.is_cpu());
+    TORCH_CHECK(v.is_cpu());
+    TORCH_CHECK(out.is_cpu());
+    TORCH_CHECK(dout.is_cpu());
+    TORCH_CHECK(softmax_lse_.is_cpu());
+    TORCH_CHECK(cu_seqlens_q.is_cpu());
+    TORCH_CHECK(cu_seqlens_k.is_cpu());
+
+    TORCH_CHECK(q.stride(-1) == 1);
+    TORCH_CHECK(k.stride(-1) == 1);
+    TORCH_CHECK(v.stride(-1) == 1);
+    TORCH_CHECK(out.is_contiguous());
+    TORCH_CHECK(dout.is_contiguous());
+    TORCH_CHECK(dq.stride(-1) == 1);
+    TORCH_CHECK(dk.stride(-1) == 1);
+    TORCH_CHECK(dv.stride(-1) == 1);
+    TORCH_CHECK(cu_seqlens_q.is_contiguous());
+    TORCH_CHECK(cu_seqlens_k.is_contiguous());
+
+    const auto sizes = q.sizes();
+
+    const int batch_size = cu_seqlens_q.numel() - 1;
+    const int total_q = sizes[TOTAL_DIM];
+    const int num_heads = sizes[H_DIM];
+    const int head_size = sizes[D_DIM];
+    const int total_k = k.size(TOTAL_DIM);
+    TORCH_CHECK(batch_size > 0);
+
+    CHECK_SHAPE(q, total_q, num_heads, head_size);
+    CHECK_SHAPE(k, total_k, num_heads, head_size);
+    CHECK_SHAPE(v, total_k, num_heads, head_size);
+    CHECK_SHAPE(out, total_q, num_heads, head_size);
+    CHECK_SHAPE(dout, total_q, num_heads, head_size);
+    CHECK_SHAPE(dq, total_q, num_heads, head_size);
+    CHECK_SHAPE(dk, total_k, num_heads, head_size);
+    CHECK_SHAPE(dv, total_k, num_heads, head_size);
+    CHECK_SHAPE(cu_seqlens_q, batch_size + 1);
+    CHECK_SHAPE(cu_seqlens_k, batch_size + 1);
+
+    if (gate.has_value()) {
+        TORCH_CHECK(gate.value().is_cpu());
+        TORCH_CHECK(gate.value().dtype() == q_dtype);
+        TORCH_CHECK(gate.value().is_contiguous());
+        CHECK_SHAPE(gate.value(), total_q, num_heads, head_size);
+    }
+
+    int bias_mod_size = 0;
+    if (attn_bias.has_value()) {
+        TORCH_CHECK(attn_bias.value().is_cpu());
+        TORCH_CHECK(attn_bias.value().dtype() == q_dtype);
+        TORCH_CHECK(attn_bias.value().is_contiguous());
+
+        const auto bias_sizes = attn_bias->sizes();
+        bias_mod_size = bias_sizes[0];
+        TORCH_CHECK(bias_sizes[1] == num_heads);
+    }
+
+    int mask_head_mod_size = 0;
+    int mask_seq_mod_size = 0;
+    if (attn_mask.has_value()) {
+        TORCH_CHECK(attn_mask.value().is_cpu());
+        TORCH_CHECK(attn_mask.value().dtype() == q_dtype);
+        TORCH_CHECK(attn_mask.value().is_contiguous());
+
+        const auto mask_sizes = attn_mask->sizes();
+        mask_head_mod_size = mask_sizes[1];
+        mask_seq_mod_size = mask_sizes[2];
+        TORCH_CHECK(mask_sizes[1] == 1 || mask_sizes[1] == num_heads);
+        TORCH_CHECK(mask_sizes[2] == 1 || mask_sizes[2] == max_seqlen_q_);
+    }
+
+    auto opts = q.options();
+    at::Tensor ds;
+    if (attn_bias.has_value()) {
+        ds = torch::zeros({batch_size, num_heads, max_seqlen_q_, max_seqlen_k_}, opts.dtype(q_dtype));
+    }
+
+    const int max_seqlen_k = ((max_seqlen_k_ + FMHA_CPU_BLOCK_N - 1) / FMHA_CPU_BLOCK_N) * FMHA_CPU_BLOCK_N;
+    const int max_seqlen_q = ((max_seqlen_q_ + 16 - 1) / 16) * 16;
+    const int loop_steps = max_seqlen_k / FMHA_CPU_BLOCK_N;
+
+    auto softmax_lse = softmax_lse_.index({torch::indexing::Slice(), torch::indexing::Slice(), torch::indexing::Slice(torch::indexing::None, max_seqlen_q)}).contiguous();
+    auto softmax_d = torch::empty({batch_size, num_heads, max_seqlen_q}, opts.dtype(at::kFloat));
+    // Deterministic mode keeps one dQ partial per loop step and sums them in a fixed tree;
+    // otherwise the loop steps accumulate straight into dq_tmp as they finish.
+    at::Tensor dq_tmp, dq_partial;
+    if (deterministic) {
+        dq_partial = torch::zeros({loop_steps, total_q, num_heads, head_size}, opts.dtype(at::kFloat));
+    } else {
+        dq_tmp = torch::zeros({total_q, num_heads, head_size}, opts.dtype(at::kFloat));
+    }
+
+    if( zero_tensors ) {
+        dq.zero_();
+        dk.zero_();
+        dv.zero_();
+        softmax_d.zero_();
+    }
+
+    FMHA_dgrad_params params;
+
+    set_params_dgrad(params,
+                     batch_size,
+                     max_seqlen_q,
+                     max_seqlen_k,
+                     num_heads,
+                     head_size,
+                     q, k, v,
+                     dq, dk, dv,
+                     cu_seqlens_q.data_ptr(),
+                     cu_seqlens_k.data_ptr(),
+                     out.data_ptr(),
+                     deterministic ? nullptr : dq_tmp.data_ptr(),
+                     dout.data_ptr(),
+                     softmax_lse.data_ptr(),
+                     softmax_d.data_ptr(),
+                     p_dropout,
+                     softmax_scale,
+                     is_causal,
+                     attn_mask ? attn_mask->data_ptr() : nullptr,
+                     attn_bias ? attn_bias->data_ptr() : nullptr,
+                     attn_bias ? ds.data_ptr() : nullptr,
+                     bias_mod_size,
+                     mask_head_mod_size,
+                     mask_seq_mod_size);
+    params.dq_partial_ptr = deterministic ? dq_partial.data_ptr() : nullptr;
+    params.deterministic = deterministic;
+    at::Tensor dgate;
+    if (gate.has_value()) {
+        dgate = torch::empty_like(out);
+        params.gate_ptr = gate->data_ptr();
+        params.dgate_ptr = dgate.data_ptr();
+    }
+
+    run_fmha_dgrad_cpu(params);
+
+    std::vector<at::Tensor> result = { softmax_d };
+    if (attn_bias.has_value()) {
+        auto size = attn_bias->sizes();
+        auto ds_grouped = ds.reshape({ -1, size[0], size[1], size[2], size[3] });
+        result.push_back( deterministic ? tree_sum_dim0(ds_grouped).to(q_dtype) : ds_grouped.sum({ 0 }) );
+    }
+    if (gate.has_value()) { result.push_back(dgate); }
+    return result;
 }
 
 std::vector<at::Tensor>
@@ -212,8 +549,16 @@ mha_fwd(const at::Tensor &q,         // total_q x num_heads x head_size, total_q
         const bool return_softmax,
         c10::optional<at::Generator> gen_,
         const c10::optional<at::Tensor> &attn_mask, // attn_mask
-        const c10::optional<at::Tensor> &attn_bias // attn bias
+        const c10::optional<at::Tensor> &attn_bias, // attn bias
+        const bool lpt_schedule,  // split into query blocks run longest first by persistent CTAs
+        const c10::optional<at::Tensor> &gate,  // sigmoid output gate, fused into the epilogue
+        const int64_t cpu_memory_budget  // CPU only: bytes per thread the query chunks must fit in
         ) {
+    if (q.is_cpu()) {
+        return mha_fwd_cpu(q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q_, max_seqlen_k_,
+                           p_dropout, softmax_scale, zero_tensors, is_causal, return_softmax,
+                           attn_mask, attn_bias, gate, cpu_memory_budget);
+    }
 
     auto dprops = at::cuda::getCurrentDeviceProperties();
     bool is_sm75 = dprops->major == 7 && dprops->minor == 5;
@@ -259,6 +604,13 @@ mha_fwd(const at::Tensor &q,         // total_q x num_heads x head_size, total_q
     CHECK_SHAPE(cu_seqlens_q, batch_size + 1);
     CHECK_SHAPE(cu_seqlens_k, batch_size + 1);
 
+    if (gate.has_value()) {
+        TORCH_CHECK(gate.value().is_cuda());
+        TORCH_CHECK(gate.value().dtype() == q_dtype);
+        TORCH_CHECK(gate.value().is_contiguous());
+        CHECK_SHAPE(gate.value(), total_q, num_heads, head_size);
+    }
+
     int bias_mod_size = 0;
     if (attn_bias.has_value()) {
         TORCH_CHECK(attn_bias.value().is_cuda());
@@ -341,6 +693,33 @@ mha_fwd(const at::Tensor &q,         // total_q x num_heads x head_size, total_q
                      mask_head_mod_size,
                      mask_seq_mod_size
                      );
+    launch_params.params.gate_ptr = gate ? gate->data_ptr() : nullptr;
+
+    // The work queue has to outlive the launch.
+    std::vector<fmha::Work_item> schedule;
+    at::Tensor work_items, work_counter;
+    if (lpt_schedule) {
+        TORCH_CHECK(!is_dropout && !return_softmax, "lpt_schedule does not support dropout or return_softmax");
+        // One item covers as many rows as a CTA tile has keys, in steps of 16 rows.
+        const int rows_per_item = std::min(blocksize_c, max_seqlen_k);
+        const at::Tensor cu_seqlens_q_cpu = cu_seqlens_q.cpu();
+        const at::Tensor cu_seqlens_k_cpu = cu_seqlens_k.cpu();
+        schedule = fmha::make_query_schedule(cu_seqlens_q_cpu.data_ptr<int>(), cu_seqlens_k_cpu.data_ptr<int>(),
+                                             batch_size, num_heads, rows_per_item, is_causal);
+        work_items = torch::empty({int64_t(schedule.size()), 4}, torch::dtype(torch::kInt32));
+        auto items = work_items.accessor<int, 2>();
+        for (size_t i = 0; i < schedule.size(); ++i) {
+            items[i][0] = schedule[i].bidb;
+            items[i][1] = schedule[i].bidh;
+            items[i][2] = schedule[i].block * rows_per_item / 16;
+            items[i][3] = rows_per_item / 16;
+        }
+        work_items = work_items.to(q.device());
+        work_counter = torch::zeros({1}, opts.dtype(torch::kInt32));
+        launch_params.params.work_items = reinterpret_cast<int4 *>(work_items.data_ptr());
+        launch_params.params.num_work_items = schedule.size();
+        launch_params.params.work_counter = work_counter.data_ptr<int>();
+    }
 
     run_fmha_fp16_sm80(launch_params, /*configure=*/ true);
     // number of times random will be generated per thread, to offset philox counter in thc random
@@ -356,6 +735,10 @@ mha_fwd(const at::Tensor &q,         // total_q x num_heads x head_size, total_q
 
     run_fmha_fp16_sm80(launch_params, /*configure=*/false);
 
+    if (lpt_schedule) {
+        fmha::record_schedule_stats("fwd", fmha::simulate_schedule(schedule, launch_params.num_persistent_ctas));
+    }
+
     std::vector<at::Tensor> result = {o, softmax_lse};
     if (return_softmax) {result.push_back(s);}
     return result;
@@ -382,8 +765,16 @@ mha_bwd(const at::Tensor &dout,  // total_q x num_heads, x head_size
         const bool is_causal,
         c10::optional<at::Generator> gen_,
         const c10::optional<at::Tensor> &attn_mask, // attn_mask
-        const c10::optional<at::Tensor> &attn_bias // attn bias
+        const c10::optional<at::Tensor> &attn_bias, // attn bias
+        const bool deterministic,  // reduce dbias in a fixed order
+        const c10::optional<at::Tensor> &gate  // sigmoid output gate of the forward pass
 ) {
+    if (q.is_cpu()) {
+        return mha_bwd_cpu(dout, q, k, v, out, softmax_lse_, dq, dk, dv, cu_seqlens_q, cu_seqlens_k,
+                           max_seqlen_q_, max_seqlen_k_, p_dropout, softmax_scale, zero_tensors, is_causal,
+                           attn_mask, attn_bias, deterministic, gate);
+    }
+
     auto dprops = at::cuda::getCurrentDeviceProperties();
     bool is_sm75 = dprops->major == 7 && dprops->minor == 5;
     bool is_sm80 = dprops->major == 8 && dprops->minor == 0;
@@ -450,6 +841,13 @@ mha_bwd(const at::Tensor &dout,  // total_q x num_heads, x head_size
     CHECK_SHAPE(cu_seqlens_q, batch_size + 1);
     CHECK_SHAPE(cu_seqlens_k, batch_size + 1);
 
+    if (gate.has_value()) {
+        TORCH_CHECK(gate.value().is_cuda());
+        TORCH_CHECK(gate.value().dtype() == q_dtype);
+        TORCH_CHECK(gate.value().is_contiguous());
+        CHECK_SHAPE(gate.value(), total_q, num_heads, head_size);
+    }
+
     int bias_mod_size = 0;
     if (attn_bias.has_value()) {
         TORCH_CHECK(attn_bias.value().is_cuda());
@@ -537,6 +935,16 @@ mha_bwd(const at::Tensor &dout,  // total_q x num_heads, x head_size
                      mask_head_mod_size,
                      mask_seq_mod_size);
                     // used for dbias
+    // dq_tmp is already accumulated in loop step order within each CTA, so only the dbias
+    // reduction below depends on this flag.
+    params.deterministic = deterministic;
+    // dgate is written by the first loop step of the kernel, which visits every row of dO.
+    at::Tensor dgate;
+    if (gate.has_value()) {
+        dgate = torch::empty_like(out);
+        params.gate_ptr = gate->data_ptr();
+        params.dgate_ptr = dgate.data_ptr();
+    }
 
     auto gen = at::get_generator_or_default<at::CUDAGeneratorImpl>(
         gen_, at::cuda::detail::getDefaultCUDAGenerator());
@@ -558,9 +966,342 @@ mha_bwd(const at::Tensor &dout,  // total_q x num_heads, x head_size
     if (attn_bias.has_value()) {
         // compare block reduce
         auto size = attn_bias->sizes();
-        dbias = ds.reshape({ -1, size[0], size[1], size[2], size[3] }).sum({ 0 });
+        auto ds_grouped = ds.reshape({ -1, size[0], size[1], size[2], size[3] });
+        dbias = deterministic ? tree_sum_dim0(ds_grouped).to(q_dtype) : ds_grouped.sum({ 0 });
         result.push_back( dbias );
     }
+    if (gate.has_value()) { result.push_back(dgate); }
+    return result;
+}
+
+// Element offset of every entry of the leading (*) dims of x, with the dims broadcast against
+// batch_sizes (right aligned, stride 0 along size 1 dims), flattened in row-major order.
+at::Tensor batch_offsets(const at::Tensor &x, const at::IntArrayRef batch_sizes) {
+    const int64_t ndim = batch_sizes.size();
+    const int64_t x_ndim = x.dim() - 3;
+    TORCH_CHECK(x_ndim <= ndim, "too many batch dims");
+    auto index = torch::arange(c10::multiply_integers(batch_sizes), x.options().dtype(torch::kInt64));
+    auto offsets = torch::zeros_like(index);
+    for (int64_t i = ndim - 1; i >= 0; --i) {
+        const int64_t xi = i - (ndim - x_ndim);
+        if (xi >= 0 && x.size(xi) != 1) {
+            TORCH_CHECK(x.size(xi) == batch_sizes[i], "batch dim ", xi, " can't be broadcast to ", batch_sizes[i]);
+            offsets += index.remainder(batch_sizes[i]) * x.stride(xi);
+        }
+        index = index.div(batch_sizes[i], "floor");
+    }
+    return offsets;
+}
+
+// The additive (b, 1, 1, seqlen_k) mask of a (*, seqlen_k) key_padding_mask of the batched entry
+// points, where * are the batch dims of q and k.
+at::Tensor batched_attn_mask(const at::Tensor &key_padding_mask, const at::Tensor &q, const at::Tensor &k) {
+    TORCH_CHECK(key_padding_mask.device() == q.device());
+    TORCH_CHECK(key_padding_mask.sizes() == k.sizes().slice(0, k.dim() - 2), "key_padding_mask must be (*, seqlen_k)");
+    const int64_t batch_size = c10::multiply_integers(q.sizes().slice(0, q.dim() - 3));
+    const int64_t seqlen_k = k.size(-3);
+    const float lowest = q.dtype() == torch::kBFloat16 ? -3.38e38f : -65504.f;
+    return torch::zeros({batch_size, 1, 1, seqlen_k}, q.options()).masked_fill_(
+        key_padding_mask.logical_not().reshape({batch_size, 1, 1, seqlen_k}), lowest);
+}
+
+// The per sequence offsets of the (*b, num_heads, seqlen_q, seqlen_k) attn_bias of the batched entry
+// points, whose leading dims broadcast against the batch dims of q.
+at::Tensor batched_bias_offsets(const at::Tensor &attn_bias, const at::Tensor &q, const at::Tensor &k) {
+    const int64_t num_heads = q.size(-2);
+    const int64_t seqlen_q = q.size(-3);
+    const int64_t seqlen_k = k.size(-3);
+    TORCH_CHECK(attn_bias.device() == q.device());
+    TORCH_CHECK(attn_bias.dtype() == q.dtype());
+    TORCH_CHECK(attn_bias.dim() >= 3);
+    TORCH_CHECK(attn_bias.size(-3) == num_heads && attn_bias.size(-2) == seqlen_q && attn_bias.size(-1) == seqlen_k,
+                "attn_bias must be (*, num_heads, seqlen_q, seqlen_k)");
+    TORCH_CHECK(attn_bias.stride(-1) == 1 && attn_bias.stride(-2) == seqlen_k
+                && attn_bias.stride(-3) == seqlen_q * seqlen_k,
+                "the last three dims of attn_bias must be contiguous");
+    return batch_offsets(attn_bias, q.sizes().slice(0, q.dim() - 3));
+}
+
+// Sums ds (*, h, seqlen_q, seqlen_k) over the batch dims attn_bias is broadcast along.
+at::Tensor sum_to_bias(const at::Tensor &ds, const at::Tensor &attn_bias, const bool deterministic) {
+    if (!deterministic) { return ds.sum_to_size(attn_bias.sizes()); }
+    const int64_t lead = ds.dim() - attn_bias.dim();
+    std::vector<int64_t> reduced, kept;
+    for (int64_t i = 0; i < ds.dim() - 3; ++i) {
+        (i < lead || attn_bias.size(i - lead) == 1 ? reduced : kept).push_back(i);
+    }
+    std::vector<int64_t> order(reduced), sizes{-1};
+    for (int64_t i : kept) { order.push_back(i); sizes.push_back(ds.size(i)); }
+    for (int64_t i = ds.dim() - 3; i < ds.dim(); ++i) { order.push_back(i); sizes.push_back(ds.size(i)); }
+    return tree_sum_dim0(ds.permute(order).reshape(sizes)).reshape(attn_bias.sizes()).to(ds.dtype());
+}
+
+// Attention over (*, seqlen, num_heads, head_size) tensors with arbitrary strides along the leading
+// dims, e.g. the rows or the (transposed) columns of a pair representation. The sequences are read
+// in place through per sequence offsets instead of being packed, keys are masked with an additive
+// mask built from key_padding_mask instead of being unpadded, and attn_bias may have broadcast
+// (size 1 or missing) leading dims, e.g. one (h, s, s) bias shared by all rows in triangle attention.
+std::vector<at::Tensor>
+mha_fwd_batched(const at::Tensor &q,         // * x seqlen_q x num_heads x head_size
+                const at::Tensor &k,         // * x seqlen_k x num_heads x head_size
+                const at::Tensor &v,         // * x seqlen_k x num_heads x head_size
+                const float softmax_scale,
+                const bool is_causal,
+                const c10::optional<at::Tensor> &key_padding_mask, // * x seqlen_k, true means valid
+                const c10::optional<at::Tensor> &attn_bias // broadcastable to * x num_heads x seqlen_q x seqlen_k
+                ) {
+    const bool is_cpu = q.is_cpu();
+    auto q_dtype = q.dtype();
+    TORCH_CHECK(q_dtype == torch::kFloat16 || q_dtype == torch::kBFloat16);
+    TORCH_CHECK(k.dtype() == q_dtype);
+    TORCH_CHECK(v.dtype() == q_dtype);
+    TORCH_CHECK(k.device() == q.device());
+    TORCH_CHECK(v.device() == q.device());
+    TORCH_CHECK(q.dim() >= 3);
+    TORCH_CHECK(q.stride(-1) == 1);
+    TORCH_CHECK(k.stride(-1) == 1);
+    TORCH_CHECK(v.stride(-1) == 1);
+
+    const auto batch_sizes = q.sizes().slice(0, q.dim() - 3);
+    const int batch_size = c10::multiply_integers(batch_sizes);
+    const int seqlen_q = q.size(-3);
+    const int seqlen_k = k.size(-3);
+    const int num_heads = q.size(-2);
+    const int head_size = q.size(-1);
+    TORCH_CHECK(batch_size > 0);
+    TORCH_CHECK(k.sizes().slice(0, k.dim() - 3) == batch_sizes, "k must have the batch dims of q");
+    TORCH_CHECK(k.sizes().slice(k.dim() - 2) == q.sizes().slice(q.dim() - 2));
+    TORCH_CHECK(v.sizes() == k.sizes());
+
+    cudaDeviceProp *dprops = nullptr;
+    bool is_sm80 = false;
+    if (!is_cpu) {
+        dprops = at::cuda::getCurrentDeviceProperties();
+        const bool is_sm75 = dprops->major == 7 && dprops->minor == 5;
+        const bool is_sm8x = dprops->major == 8 && dprops->minor >= 0;
+        is_sm80 = dprops->major == 8 && dprops->minor == 0;
+        TORCH_CHECK(is_sm8x || is_sm75);
+        TORCH_CHECK(q_dtype == torch::kFloat16 || is_sm8x);
+        TORCH_CHECK(head_size == 16 || head_size == 32 || head_size == 64 || head_size == 128);
+    }
+
+    auto opts = q.options();
+    auto cu_seqlens_q = torch::arange(0, int64_t(batch_size + 1) * seqlen_q, seqlen_q, opts.dtype(torch::kInt32));
+    auto cu_seqlens_k = torch::arange(0, int64_t(batch_size + 1) * seqlen_k, seqlen_k, opts.dtype(torch::kInt32));
+    auto q_offsets = batch_offsets(q, batch_sizes);
+    auto k_offsets = batch_offsets(k, batch_sizes);
+    auto v_offsets = batch_offsets(v, batch_sizes);
+
+    at::Tensor attn_mask;
+    if (key_padding_mask.has_value()) { attn_mask = batched_attn_mask(*key_padding_mask, q, k); }
+
+    at::Tensor bias_offsets;
+    if (attn_bias.has_value()) { bias_offsets = batched_bias_offsets(*attn_bias, q, k); }
+
+    int blocksize_c = is_cpu ? FMHA_CPU_BLOCK_N : ((head_size == 128 && !is_sm80) ? 128 : 256);
+    int max_seqlen_k = ((seqlen_k + blocksize_c - 1) / blocksize_c) * blocksize_c;
+    if (!is_cpu && seqlen_k <= 128) {
+        max_seqlen_k = 128;
+    } else if (!is_cpu && seqlen_k <= 256) {
+        max_seqlen_k = 256;
+    }
+    const int max_seqlen_q = ((seqlen_q + 16 - 1) / 16) * 16;
+    const bool loop = !is_cpu && max_seqlen_k > blocksize_c;
+
+    std::vector<int64_t> o_sizes(batch_sizes.begin(), batch_sizes.end());
+    o_sizes.insert(o_sizes.end(), {seqlen_q, num_heads, head_size});
+    auto o = torch::empty(o_sizes, opts);
+    at::Tensor o_tmp;
+    if (loop) { o_tmp = torch::empty({int64_t(batch_size) * seqlen_q, num_heads, head_size}, opts.dtype(at::kFloat)); }
+    auto softmax_lse = torch::empty({batch_size, num_heads, max_seqlen_q}, opts.dtype(at::kFloat));
+
+    // Views with the row and head strides of the inputs; the per sequence offsets do the rest.
+    auto rows = [](const at::Tensor &x) {
+        return x.as_strided({x.size(-3), x.size(-2), x.size(-1)}, {x.stride(-3), x.stride(-2), 1});
+    };
+
+    Launch_params<FMHA_fprop_params> launch_params(dprops, is_cpu ? nullptr : at::cuda::getCurrentCUDAStream().stream(),
+                                                   /*is_dropout=*/false, /*return_softmax=*/false);
+    set_params_fprop(launch_params.params,
+                     batch_size,
+                     max_seqlen_q,
+                     max_seqlen_k,
+                     num_heads,
+                     head_size,
+                     rows(q), rows(k), rows(v),
+                     cu_seqlens_q.data_ptr(),
+                     cu_seqlens_k.data_ptr(),
+                     o.data_ptr(),
+                     loop ? o_tmp.data_ptr() : nullptr,
+                     nullptr,
+                     softmax_lse.data_ptr(),
+                     0.f,
+                     softmax_scale,
+                     is_causal,
+                     key_padding_mask ? attn_mask.data_ptr() : nullptr,
+                     attn_bias ? attn_bias->data_ptr() : nullptr,
+                     1,
+                     1,
+                     1);
+    launch_params.params.q_batch_offsets = q_offsets.data_ptr<int64_t>();
+    launch_params.params.k_batch_offsets = k_offsets.data_ptr<int64_t>();
+    launch_params.params.v_batch_offsets = v_offsets.data_ptr<int64_t>();
+    launch_params.params.bias_batch_offsets = attn_bias ? bias_offsets.data_ptr<int64_t>() : nullptr;
+
+    if (is_cpu) {
+        run_fmha_fprop_cpu(launch_params.params);
+    } else {
+        run_fmha_fp16_sm80(launch_params, /*configure=*/false);
+    }
+    return {o, softmax_lse};
+}
+
+std::vector<at::Tensor>
+mha_bwd_batched(const at::Tensor &dout,  // * x seqlen_q x num_heads x head_size
+                const at::Tensor &q,     // * x seqlen_q x num_heads x head_size
+                const at::Tensor &k,     // * x seqlen_k x num_heads x head_size
+                const at::Tensor &v,     // * x seqlen_k x num_heads x head_size
+                const at::Tensor &out,   // * x seqlen_q x num_heads x head_size, from mha_fwd_batched
+                const at::Tensor &softmax_lse_,  // b x h x s softmax logsumexp
+                const float softmax_scale,
+                const bool is_causal,
+                const c10::optional<at::Tensor> &key_padding_mask, // * x seqlen_k, true means valid
+                const c10::optional<at::Tensor> &attn_bias, // broadcastable to * x num_heads x seqlen_q x seqlen_k
+                const bool deterministic  // reduce dq and dbias in a fixed order
+                ) {
+    const bool is_cpu = q.is_cpu();
+    auto q_dtype = q.dtype();
+    TORCH_CHECK(q_dtype == torch::kFloat16 || q_dtype == torch::kBFloat16);
+    TORCH_CHECK(k.dtype() == q_dtype);
+    TORCH_CHECK(v.dtype() == q_dtype);
+    TORCH_CHECK(out.dtype() == q_dtype);
+    TORCH_CHECK(dout.dtype() == q_dtype);
+    TORCH_CHECK(softmax_lse_.dtype() == torch::kFloat32);
+    TORCH_CHECK(k.device() == q.device());
+    TORCH_CHECK(v.device() == q.device());
+    TORCH_CHECK(out.device() == q.device());
+    TORCH_CHECK(dout.device() == q.device());
+    TORCH_CHECK(softmax_lse_.device() == q.device());
+    TORCH_CHECK(q.dim() >= 3);
+    TORCH_CHECK(q.stride(-1) == 1);
+    TORCH_CHECK(k.stride(-1) == 1);
+    TORCH_CHECK(v.stride(-1) == 1);
+    TORCH_CHECK(out.is_contiguous());
+    TORCH_CHECK(dout.sizes() == q.sizes());
+    TORCH_CHECK(out.sizes() == q.sizes());
+
+    const auto batch_sizes = q.sizes().slice(0, q.dim() - 3);
+    const int batch_size = c10::multiply_integers(batch_sizes);
+    const int seqlen_q = q.size(-3);
+    const int seqlen_k = k.size(-3);
+    const int num_heads = q.size(-2);
+    const int head_size = q.size(-1);
+    TORCH_CHECK(batch_size > 0);
+    TORCH_CHECK(k.sizes().slice(0, k.dim() - 3) == batch_sizes, "k must have the batch dims of q");
+    TORCH_CHECK(k.sizes().slice(k.dim() - 2) == q.sizes().slice(q.dim() - 2));
+    TORCH_CHECK(v.sizes() == k.sizes());
+
+    bool is_sm75 = false;
+    if (!is_cpu) {
+        auto dprops = at::cuda::getCurrentDeviceProperties();
+        is_sm75 = dprops->major == 7 && dprops->minor == 5;
+        const bool is_sm80 = dprops->major == 8 && dprops->minor == 0;
+        TORCH_CHECK(head_size == 16 || head_size == 32 || head_size == 64 || head_size == 128);
+        if (head_size == 128) { TORCH_CHECK(is_sm80); }
+    }
+
+    auto opts = q.options();
+    auto cu_seqlens_q = torch::arange(0, int64_t(batch_size + 1) * seqlen_q, seqlen_q, opts.dtype(torch::kInt32));
+    auto cu_seqlens_k = torch::arange(0, int64_t(batch_size + 1) * seqlen_k, seqlen_k, opts.dtype(torch::kInt32));
+    auto q_offsets = batch_offsets(q, batch_sizes);
+    auto k_offsets = batch_offsets(k, batch_sizes);
+    auto v_offsets = batch_offsets(v, batch_sizes);
+
+    at::Tensor attn_mask;
+    if (key_padding_mask.has_value()) { attn_mask = batched_attn_mask(*key_padding_mask, q, k); }
+
+    at::Tensor bias_offsets, ds;
+    if (attn_bias.has_value()) {
+        bias_offsets = batched_bias_offsets(*attn_bias, q, k);
+        ds = torch::zeros({batch_size, num_heads, seqlen_q, seqlen_k}, opts);
+    }
+
+    int blocksize_c = is_cpu ? FMHA_CPU_BLOCK_N : ((head_size == 128 || (is_sm75 && head_size == 64)) ? 128 : 256);
+    int max_seqlen_k = ((seqlen_k + blocksize_c - 1) / blocksize_c) * blocksize_c;
+    if (!is_cpu && seqlen_k <= 128) {
+        max_seqlen_k = 128;
+    } else if (!is_cpu && seqlen_k <= 256) {
+        max_seqlen_k = 256;
+    }
+    const int max_seqlen_q = ((seqlen_q + 16 - 1) / 16) * 16;
+    const int loop_steps = max_seqlen_k / blocksize_c;
+    const int total_q = batch_size * seqlen_q;
+
+    TORCH_CHECK(softmax_lse_.dim() == 3 && softmax_lse_.size(0) == batch_size && softmax_lse_.size(1) == num_heads
+                && softmax_lse_.size(2) >= max_seqlen_q, "softmax_lse must be the one returned by fwd_batched");
+    auto softmax_lse = softmax_lse_.index({torch::indexing::Slice(), torch::indexing::Slice(), torch::indexing::Slice(torch::indexing::None, max_seqlen_q)}).contiguous();
+    auto softmax_d = torch::empty({batch_size, num_heads, max_seqlen_q}, opts.dtype(at::kFloat));
+    auto dq = torch::empty_like(out);
+    auto dk = torch::empty(k.sizes(), opts);
+    auto dv = torch::empty(k.sizes(), opts);
+    auto dout_c = dout.contiguous();
+    // The CPU backend accumulates dq in dq_tmp, or in per loop step partials when deterministic.
+    at::Tensor dq_tmp, dq_partial;
+    if (is_cpu && deterministic) {
+        dq_partial = torch::zeros({loop_steps, total_q, num_heads, head_size}, opts.dtype(at::kFloat));
+    } else if (is_cpu || loop_steps > 1) {
+        dq_tmp = torch::zeros({total_q, num_heads, head_size}, opts.dtype(at::kFloat));
+    }
+
+    auto rows = [](const at::Tensor &x) {
+        return x.as_strided({x.size(-3), x.size(-2), x.size(-1)}, {x.stride(-3), x.stride(-2), 1});
+    };
+    auto dq_rows = rows(dq), dk_rows = rows(dk), dv_rows = rows(dv);
+
+    FMHA_dgrad_params params;
+    set_params_dgrad(params,
+                     batch_size,
+                     max_seqlen_q,
+                     max_seqlen_k,
+                     num_heads,
+                     head_size,
+                     rows(q), rows(k), rows(v),
+                     dq_rows, dk_rows, dv_rows,
+                     cu_seqlens_q.data_ptr(),
+                     cu_seqlens_k.data_ptr(),
+                     out.data_ptr(),
+                     dq_tmp.defined() ? dq_tmp.data_ptr() : nullptr,
+                     dout_c.data_ptr(),
+                     softmax_lse.data_ptr(),
+                     softmax_d.data_ptr(),
+                     0.f,
+                     softmax_scale,
+                     is_causal,
+                     key_padding_mask ? attn_mask.data_ptr() : nullptr,
+                     attn_bias ? attn_bias->data_ptr() : nullptr,
+                     attn_bias ? ds.data_ptr() : nullptr,
+                     1,
+                     1,
+                     1);
+    params.q_batch_offsets = q_offsets.data_ptr<int64_t>();
+    params.k_batch_offsets = k_offsets.data_ptr<int64_t>();
+    params.v_batch_offsets = v_offsets.data_ptr<int64_t>();
+    params.bias_batch_offsets = attn_bias ? bias_offsets.data_ptr<int64_t>() : nullptr;
+    params.dq_partial_ptr = dq_partial.defined() ? dq_partial.data_ptr() : nullptr;
+    params.deterministic = deterministic;
+
+    if (is_cpu) {
+        run_fmha_dgrad_cpu(params);
+    } else {
+        run_fmha_dgrad_fp16_sm80(params, at::cuda::getCurrentCUDAStream().stream());
+    }
+
+    std::vector<at::Tensor> result = { dq, dk, dv, softmax_d };
+    if (attn_bias.has_value()) {
+        std::vector<int64_t> ds_sizes(batch_sizes.begin(), batch_sizes.end());
+        ds_sizes.insert(ds_sizes.end(), {num_heads, seqlen_q, seqlen_k});
+        result.push_back(sum_to_bias(ds.view(ds_sizes), *attn_bias, deterministic));
+    }
     return result;
 }
 
@@ -846,10 +1587,68 @@ mha_bwd_block(const at::Tensor &dout,  // total x num_heads, x head_size
     return { dq, dk, dv, softmax_d };
 }
 
+// The query chunk and key block sizes the CPU forward pass uses for a memory budget in bytes per
+// thread (0 for half of the L2 cache).
+pybind11::dict cpu_chunk_plan(const int head_size, const int element_size, const bool has_attn_mask,
+                              const bool has_attn_bias, const int64_t memory_budget) {
+    TORCH_CHECK(memory_budget >= 0);
+    const fmha::Chunk_plan plan = fmha::plan_cpu_chunks(head_size, element_size, has_attn_mask,
+                                                        has_attn_bias, memory_budget);
+    pybind11::dict result;
+    result["block_m"] = plan.block_m;
+    result["block_n"] = plan.block_n;
+    result["working_set_bytes"] = plan.working_set_bytes;
+    result["budget_bytes"] = plan.budget_bytes;
+    return result;
+}
+
+pybind11::dict schedule_stats_dict(const fmha::Schedule_stats &stats) {
+    pybind11::dict result;
+    result["num_items"] = stats.num_items;
+    result["num_workers"] = stats.num_workers;
+    result["num_steals"] = stats.num_steals;
+    result["total_cost"] = stats.total_cost;
+    result["max_worker_cost"] = stats.max_worker_cost;
+    result["imbalance"] = stats.imbalance;
+    return result;
+}
+
+// The load balance of the last call of `pass` ("fwd" or "bwd"), empty if there was none.
+pybind11::dict schedule_stats(const std::string &pass) {
+    fmha::Schedule_stats stats;
+    if (!fmha::last_schedule_stats(pass.c_str(), stats)) { return pybind11::dict(); }
+    return schedule_stats_dict(stats);
+}
+
+// The predicted load balance of a ragged batch on num_workers workers, for the LPT schedule of
+// query blocks of block_size rows, or for the (batch, head) grid when block_size is 0.
+pybind11::dict simulate_schedule(const at::Tensor &cu_seqlens_q, const at::Tensor &cu_seqlens_k,
+                                 const int num_heads, const int block_size, const bool is_causal,
+                                 const int num_workers) {
+    TORCH_CHECK(cu_seqlens_q.dtype() == torch::kInt32);
+    TORCH_CHECK(cu_seqlens_k.dtype() == torch::kInt32);
+    TORCH_CHECK(cu_seqlens_q.is_cpu() && cu_seqlens_k.is_cpu());
+    TORCH_CHECK(cu_seqlens_q.is_contiguous() && cu_seqlens_k.is_contiguous());
+    TORCH_CHECK(cu_seqlens_q.numel() == cu_seqlens_k.numel());
+    TORCH_CHECK(block_size >= 0 && num_workers > 0);
+    const int batch_size = cu_seqlens_q.numel() - 1;
+    const int *cu_q = cu_seqlens_q.data_ptr<int>();
+    const int *cu_k = cu_seqlens_k.data_ptr<int>();
+    const std::vector<fmha::Work_item> items = block_size > 0
+        ? fmha::make_query_schedule(cu_q, cu_k, batch_size, num_heads, block_size, is_causal)
+        : fmha::make_head_schedule(cu_q, cu_k, batch_size, num_heads, is_causal);
+    return schedule_stats_dict(fmha::simulate_schedule(items, num_workers));
+}
+
 PYBIND11_MODULE(TORCH_EXTENSION_NAME, m) {
     m.doc() = "Fused Multi-head Self-attention";
     m.def("fwd", &mha_fwd, "Forward pass");
     m.def("bwd", &mha_bwd, "Backward pass");
     m.def("fwd_block", &mha_fwd_block, "Forward pass (blocksparse)");
     m.def("bwd_block", &mha_bwd_block, "Backward pass (blocksparse)");
+    m.def("fwd_batched", &mha_fwd_batched, "Forward pass over strided (*, seqlen, num_heads, head_size) batches");
+    m.def("bwd_batched", &mha_bwd_batched, "Backward pass over strided (*, seqlen, num_heads, head_size) batches");
+    m.def("schedule_stats", &schedule_stats, "Load balance of the last scheduled call");
+    m.def("simulate_schedule", &simulate_schedule, "Predicted load balance of a ragged batch");
+    m.def("cpu_chunk_plan", &cpu_chunk_plan, "Tile sizes of the CPU forward pass for a memory budget");
 }
\ No newline at end of file
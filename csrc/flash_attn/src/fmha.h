@@ -45,6 +45,10 @@ constexpr int TOTAL_DIM = 0;
 constexpr int H_DIM = 1;
 constexpr int D_DIM = 2;
 
+// Keys per loop step of the CPU backward pass. The forward pass picks its tiles with
+// fmha::plan_cpu_chunks.
+constexpr int FMHA_CPU_BLOCK_N = 128;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 struct Qkv_params {
@@ -65,6 +69,12 @@ struct Qkv_params {
     uint32_t k_head_stride_in_elts;
     uint32_t v_head_stride_in_elts;
 
+    // The element offsets of the first row of every sequence, for (*, N, H, C) batches with
+    // arbitrary strides. nullptr for the packed layout, where it is cu_seqlens * row stride.
+    const int64_t *__restrict__ q_batch_offsets;
+    const int64_t *__restrict__ k_batch_offsets;
+    const int64_t *__restrict__ v_batch_offsets;
+
     // The number of heads.
     int h;
 };
@@ -81,6 +91,9 @@ struct FMHA_fprop_params : public Qkv_params {
     // The attn bias matrix
     void * __restrict__ attn_bias_ptr;
     int bias_mod_size;
+    // The element offset of the (h, seqlen_q, seqlen_k) bias of every sequence, so broadcast batch
+    // dims can have stride 0. nullptr to use bidb % bias_mod_size.
+    const int64_t *__restrict__ bias_batch_offsets;
 
     // The ds matrix
     void * __restrict__ attn_ds_ptr;
@@ -98,6 +111,10 @@ struct FMHA_fprop_params : public Qkv_params {
     // the loop;
     void *__restrict__ o_tmp_ptr;
 
+    // The optional sigmoid output gate, with the same shape and strides as O: the kernel writes
+    // O * sigmoid(gate). nullptr for no gating.
+    void *__restrict__ gate_ptr;
+
     // The pointer to the S matrix.
     void * __restrict__ s_ptr;
     // The stride between rows of the S matrix.
@@ -120,6 +137,17 @@ struct FMHA_fprop_params : public Qkv_params {
 
     int *__restrict__ blockmask;
 
+    // The work items (bidb, bidh, first step, steps) of the persistent kernel, sorted longest first,
+    // and the counter its CTAs dequeue them with. nullptr for the (batch, head) grid.
+    int4 *__restrict__ work_items;
+    int num_work_items;
+    int *__restrict__ work_counter;
+
+    // The query chunk and key block sizes of the CPU forward pass, picked by fmha::plan_cpu_chunks
+    // for a memory budget. 0 to plan for half of the L2 cache.
+    int cpu_block_m;
+    int cpu_block_n;
+
     // The dropout probability (probability of keeping an activation).
     float p_dropout;
     uint32_t p_dropout_in_uint;
@@ -161,8 +189,19 @@ struct FMHA_dgrad_params : public FMHA_fprop_params {
     // The dO matrix. We assume it is contiguous.
     void * __restrict__ do_ptr;
 
+    // The gradient of the output gate, with the same shape and strides as O. Only written when
+    // gate_ptr is set.
+    void * __restrict__ dgate_ptr;
+
     // The pointer to the softmax d sum.
     void * __restrict__ dsoftmax_sum;
+
+    // The per loop step partials of dQ, (loop_steps x total_q x h x d) in fp32. Only used by the
+    // CPU backend when deterministic is set: the partials are summed in a fixed pairwise tree
+    // instead of being accumulated into dq_tmp in whatever order the workers finish.
+    void * __restrict__ dq_partial_ptr;
+
+    bool deterministic;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -177,7 +216,8 @@ struct Launch_params{
         , props(props_)
         , stream(stream_)
         , is_dropout(is_dropout_)
-        , return_softmax(return_softmax_) {
+        , return_softmax(return_softmax_)
+        , num_persistent_ctas(0) {
     }
 
     size_t elts_per_thread;
@@ -195,6 +235,9 @@ struct Launch_params{
     int heads_last_wave;
     int main_steps;
     int rest_steps;
+
+    // The number of CTAs the persistent kernel was launched with.
+    int num_persistent_ctas;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -206,3 +249,7 @@ void run_fmha_dgrad_fp16_sm80(const FMHA_dgrad_params &params, cudaStream_t stre
 void run_fmha_block_fp16_sm80(Launch_params<FMHA_fprop_params> &launch_params, const bool configure);
 
 void run_fmha_block_dgrad_fp16_sm80(const FMHA_dgrad_params &params, cudaStream_t stream);
+
+void run_fmha_fprop_cpu(const FMHA_fprop_params &params);
+
+void run_fmha_dgrad_cpu(const FMHA_dgrad_params &params);
@@ -64,10 +64,12 @@ struct Gmem_tile_qkv {
     // The number of LDGs needed to load a chunk of the Q matrix.
     static constexpr int LDGS = DivUpConstexpr(ROWS, ROWS_PER_LDG);
 
-    // Ctor.
+    // Ctor. batch_offsets, if not nullptr, holds the element offset of the first row of every
+    // sequence, for batches that are not packed along the rows (see mha_fwd_batched).
     template< typename BInfo >
     inline __device__ Gmem_tile_qkv(void *ptr_, const uint32_t row_stride_in_elts,
-                                    const uint32_t head_stride_in_elts, const BInfo &binfo, const int tidx, bool use_seqlen_q)
+                                    const uint32_t head_stride_in_elts, const BInfo &binfo, const int tidx, bool use_seqlen_q,
+                                    const int64_t *batch_offsets = nullptr)
         : row_stride_in_bytes(row_stride_in_elts * BYTES_PER_ELEMENT)
         , actual_seqlen(use_seqlen_q ? binfo.actual_seqlen_q : binfo.actual_seqlen_k)
         , ptr(reinterpret_cast<char *>(ptr_))
@@ -84,7 +86,9 @@ struct Gmem_tile_qkv {
 
         // The row offset in the batched GEMM. For each seq element, we store QKV in that order.
         // int64_t row_offset = (int64_t)row * params.qkv_stride_in_bytes;
-        uint32_t row_offset = (uint32_t)(((use_seqlen_q ? binfo.sum_s_q : binfo.sum_s_k) + row) * row_stride_in_bytes);
+        uint32_t row_offset = batch_offsets == nullptr
+            ? (uint32_t)(((use_seqlen_q ? binfo.sum_s_q : binfo.sum_s_k) + row) * row_stride_in_bytes)
+            : (uint32_t)(batch_offsets[binfo.bidb] * BYTES_PER_ELEMENT + row * row_stride_in_bytes);
         // Add the block index.
       
         // row_offset += (int64_t)((binfo.sum_s * NUM_MATS + qkv_offset) * binfo.h + binfo.bidh) * BYTES_PER_ROW;
@@ -251,6 +255,31 @@ struct Gmem_tile_o {
         }
     }
 
+    // Scale the fp32 accumulators in src by the sigmoid of the gate values this tile points to.
+    template<typename elem_type=__half>
+    inline __device__ void apply_sigmoid_gate(uint4 (&src)[STGS_PER_LOOP], int mi) {
+        static_assert(BYTES_PER_ELEMENT == 2);
+        int row_ = tidx_ / THREADS_PER_ROW;
+        #pragma unroll
+        for( int ii = 0; ii < STGS_PER_LOOP; ++ii ) {
+            int jj = mi * STGS_PER_LOOP + ii;
+            if( row_ + jj * ROWS_PER_STG >= this->actual_seqlen_q ) {
+                break;
+            }
+
+            if( !HAS_INCOMPLETE_STG || (jj < STGS - 1 || this->is_active_for_last_stg_) ) {
+                uint2 gate;
+                fmha::ldg(gate, this->ptr_ + jj * ROWS_PER_STG * this->row_stride_in_bytes);
+                float2 g0 = fmha::half2_unpack<elem_type>(gate.x);
+                float2 g1 = fmha::half2_unpack<elem_type>(gate.y);
+                reinterpret_cast<float &>(src[ii].x) *= fmha::sigmoidf(g0.x);
+                reinterpret_cast<float &>(src[ii].y) *= fmha::sigmoidf(g0.y);
+                reinterpret_cast<float &>(src[ii].z) *= fmha::sigmoidf(g1.x);
+                reinterpret_cast<float &>(src[ii].w) *= fmha::sigmoidf(g1.y);
+            }
+        }
+    }
+
     // Load data from global memory.
     inline __device__ void load(uint4 (&dst)[STGS_PER_LOOP], int mi) {
         static_assert(BYTES_PER_ELEMENT == 4);
@@ -659,6 +688,11 @@ struct Gmem_tile_mma_bias {
 
         // the index of bs and head dim
         uint32_t row_offset = bidx * binfo.actual_seqlen_q * binfo.actual_seqlen_k * BYTES_PER_ELEMENT;
+        if (params.bias_batch_offsets != nullptr) {
+            // Broadcast batch dims: each sequence has its own offset, possibly shared with others.
+            row_offset = (uint32_t)((params.bias_batch_offsets[binfo.bidb]
+                + binfo.bidh * binfo.actual_seqlen_q * binfo.actual_seqlen_k) * BYTES_PER_ELEMENT);
+        }
         // row_offset = (uint32_t)(row * row_stride_in_bytes);
         row_offset += (uint32_t)(row * binfo.actual_seqlen_k * BYTES_PER_ELEMENT);   
 
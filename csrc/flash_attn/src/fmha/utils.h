@@ -590,6 +590,58 @@ inline __device__ float hmulsum8(const uint4 a, const uint4 b) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static inline __device__ float sigmoidf(const float x) {
+    return 1.f / (1.f + __expf(-x));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Multiply two half's or bf16's by the sigmoid of the matching gate values, in fp32.
+template<typename T>
+inline __device__ uint32_t hmul2_sigmoid(const uint32_t a, const uint32_t g) {
+    float2 af = fmha::half2_unpack<T>(a);
+    float2 gf = fmha::half2_unpack<T>(g);
+    return fmha::float2_pack<T>(af.x * sigmoidf(gf.x), af.y * sigmoidf(gf.y));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+inline __device__ uint4 hmul8_sigmoid(const uint4 a, const uint4 g) {
+    uint4 c;
+    c.x = fmha::hmul2_sigmoid<T>(a.x, g.x);
+    c.y = fmha::hmul2_sigmoid<T>(a.y, g.y);
+    c.z = fmha::hmul2_sigmoid<T>(a.z, g.z);
+    c.w = fmha::hmul2_sigmoid<T>(a.w, g.w);
+    return c;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The gradient of the gate for out = o * sigmoid(g), given dout and the gated out:
+// dg = dout * out * (1 - sigmoid(g)).
+template<typename T>
+inline __device__ uint32_t hdsigmoid2(const uint32_t dout, const uint32_t out, const uint32_t g) {
+    float2 df = fmha::half2_unpack<T>(dout);
+    float2 of = fmha::half2_unpack<T>(out);
+    float2 gf = fmha::half2_unpack<T>(g);
+    return fmha::float2_pack<T>(df.x * of.x * (1.f - sigmoidf(gf.x)), df.y * of.y * (1.f - sigmoidf(gf.y)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+inline __device__ uint4 hdsigmoid8(const uint4 dout, const uint4 out, const uint4 g) {
+    uint4 c;
+    c.x = fmha::hdsigmoid2<T>(dout.x, out.x, g.x);
+    c.y = fmha::hdsigmoid2<T>(dout.y, out.y, g.y);
+    c.z = fmha::hdsigmoid2<T>(dout.z, out.z, g.z);
+    c.w = fmha::hdsigmoid2<T>(dout.w, out.w, g.w);
+    return c;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 static inline __device__ uint4 fadd4(uint4 a, uint4 b) {
     float4 c;
     c.x = reinterpret_cast<const float&>(a.x) + reinterpret_cast<const float&>(b.x);
@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright (c) 2022, Tri Dao.
+ * Copyright (c) 2011-2021, NVIDIA CORPORATION.  All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <cuda_fp16.h>
+#include <cuda_bf16.h>
+
+#include <fmha.h>
+
+namespace fmha {
+namespace cpu {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline float to_float(const float x) { return x; }
+inline float to_float(const __half x) { return __half2float(x); }
+inline float to_float(const __nv_bfloat16 x) { return __bfloat162float(x); }
+
+template<typename elem_type> inline elem_type from_float(const float x);
+template<> inline __half from_float<__half>(const float x) { return __float2half_rn(x); }
+template<> inline __nv_bfloat16 from_float<__nv_bfloat16>(const float x) { return __float2bfloat16(x); }
+
+inline float sigmoid(const float x) { return 1.f / (1.f + std::exp(-x)); }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Host counterpart of BlockInfoPadded: the offsets and lengths of one sequence of the batch.
+struct Block_info {
+
+    template<typename Params>
+    Block_info(const Params &params, const int bidb, const int bidh)
+        : bidb(bidb), bidh(bidh), h(params.h) {
+        sum_s_q = params.cu_seqlens_q[bidb];
+        actual_seqlen_q = params.cu_seqlens_q[bidb + 1] - sum_s_q;
+        sum_s_k = params.cu_seqlens_k[bidb];
+        actual_seqlen_k = params.cu_seqlens_k[bidb + 1] - sum_s_k;
+        q_offset = seq_offset(params.q_batch_offsets, sum_s_q, params.q_row_stride_in_elts);
+        k_offset = seq_offset(params.k_batch_offsets, sum_s_k, params.k_row_stride_in_elts);
+        v_offset = seq_offset(params.v_batch_offsets, sum_s_k, params.v_row_stride_in_elts);
+    }
+
+    // Element offset of row 0 of the sequence in Q, K or V, as in Gmem_tile_qkv.
+    size_t seq_offset(const int64_t *batch_offsets, const int sum_s, const uint32_t row_stride_in_elts) const {
+        return batch_offsets != nullptr ? size_t(batch_offsets[bidb]) : size_t(sum_s) * row_stride_in_elts;
+    }
+
+    int actual_seqlen_q;
+    int actual_seqlen_k;
+    int sum_s_q;
+    int sum_s_k;
+    size_t q_offset;
+    size_t k_offset;
+    size_t v_offset;
+    int bidb;
+    int bidh;
+    int h;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Pointer to the head vector of token `row` (an index into the packed total_q / total_k dim).
+template<typename T>
+inline T *row_ptr(void *base, const uint32_t row_stride_in_elts, const uint32_t head_stride_in_elts,
+                  const int row, const int bidh) {
+    return static_cast<T *>(base) + size_t(row) * row_stride_in_elts + size_t(bidh) * head_stride_in_elts;
+}
+
+template<typename T, typename U>
+inline float dot(const T *a, const U *b, const int d) {
+    float sum = 0.f;
+    for( int i = 0; i < d; ++i ) { sum += to_float(a[i]) * to_float(b[i]); }
+    return sum;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The row of attn_mask and of attn_bias that query `row` adds to its logits, nullptr when absent.
+// They are indexed exactly as Gmem_tile_mma_mask and Gmem_tile_mma_bias do on the device.
+template<typename elem_type, typename Params>
+inline const elem_type *mask_row(const Params &params, const Block_info &binfo, const int row) {
+    if( params.attn_mask_ptr == nullptr ) { return nullptr; }
+    const size_t bidx = size_t(binfo.bidb) * params.mask_head_mod_size + binfo.bidh % params.mask_head_mod_size;
+    return static_cast<const elem_type *>(params.attn_mask_ptr)
+        + (bidx * params.mask_seq_mod_size + row % params.mask_seq_mod_size) * binfo.actual_seqlen_k;
+}
+
+template<typename elem_type, typename Params>
+inline const elem_type *bias_row(const Params &params, const Block_info &binfo, const int row) {
+    if( params.attn_bias_ptr == nullptr ) { return nullptr; }
+    const size_t head_size = size_t(binfo.actual_seqlen_q) * binfo.actual_seqlen_k;
+    const size_t offset = params.bias_batch_offsets != nullptr
+        ? size_t(params.bias_batch_offsets[binfo.bidb]) + binfo.bidh * head_size
+        : (size_t(binfo.bidb % params.bias_mod_size) * params.h + binfo.bidh) * head_size;
+    return static_cast<const elem_type *>(params.attn_bias_ptr) + offset + size_t(row) * binfo.actual_seqlen_k;
+}
+
+// Computes the logits S = Q K^T + attn_mask + attn_bias of query `row` against the keys
+// [col_begin, col_end) of the sequence, before scaling by scale_bmm1f. Causally masked positions
+// are set to -inf.
+template<typename elem_type, typename Params>
+inline void compute_logits(const Params &params, const Block_info &binfo, const int row,
+                           const int col_begin, const int col_end, float *s) {
+    const elem_type *q = row_ptr<elem_type>(params.q_ptr, params.q_row_stride_in_elts,
+                                            params.q_head_stride_in_elts, row, binfo.bidh) + binfo.q_offset;
+    const elem_type *mask = mask_row<elem_type>(params, binfo, row);
+    const elem_type *bias = bias_row<elem_type>(params, binfo, row);
+    for( int col = col_begin; col < col_end; ++col ) {
+        if( params.is_causal && col > row ) {
+            s[col - col_begin] = -std::numeric_limits<float>::infinity();
+            continue;
+        }
+        const elem_type *k = row_ptr<elem_type>(params.k_ptr, params.k_row_stride_in_elts,
+                                                params.k_head_stride_in_elts, col, binfo.bidh) + binfo.k_offset;
+        float value = dot(q, k, params.d);
+        if( mask != nullptr ) { value += to_float(mask[col]); }
+        if( bias != nullptr ) { value += to_float(bias[col]); }
+        s[col - col_begin] = value;
+    }
+}
+
+// Same as compute_logits for a query row and a block of keys [col_begin, col_end) already converted
+// to fp32, k_block holding (col_end - col_begin) x d values.
+template<typename elem_type, typename Params>
+inline void compute_logits(const Params &params, const Block_info &binfo, const int row, const float *q,
+                           const float *k_block, const int col_begin, const int col_end, float *s) {
+    const elem_type *mask = mask_row<elem_type>(params, binfo, row);
+    const elem_type *bias = bias_row<elem_type>(params, binfo, row);
+    for( int col = col_begin; col < col_end; ++col ) {
+        if( params.is_causal && col > row ) {
+            s[col - col_begin] = -std::numeric_limits<float>::infinity();
+            continue;
+        }
+        float value = dot(q, k_block + size_t(col - col_begin) * params.d, params.d);
+        if( mask != nullptr ) { value += to_float(mask[col]); }
+        if( bias != nullptr ) { value += to_float(bias[col]); }
+        s[col - col_begin] = value;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Loads dO of query `row` in fp32. With an output gate only O * sigmoid(gate) reaches the loss, so
+// dO is scaled by sigmoid(gate) as apply_output_gate does on the device.
+template<typename elem_type>
+inline void load_do(const FMHA_dgrad_params &params, const Block_info &binfo, const int row, float *d_o) {
+    const elem_type *src = row_ptr<elem_type>(params.do_ptr, params.o_row_stride_in_elts,
+                                              params.o_head_stride_in_elts, binfo.sum_s_q + row, binfo.bidh);
+    const elem_type *gate = nullptr;
+    if( params.gate_ptr != nullptr ) {
+        gate = row_ptr<elem_type>(params.gate_ptr, params.o_row_stride_in_elts,
+                                  params.o_head_stride_in_elts, binfo.sum_s_q + row, binfo.bidh);
+    }
+    for( int di = 0; di < params.d; ++di ) {
+        d_o[di] = to_float(src[di]) * (gate != nullptr ? sigmoid(to_float(gate[di])) : 1.f);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Sums the n vectors of length len found at data + i * stride into data[0 .. len), pairing them
+// in a fixed binary tree. The result only depends on n, never on the order in which the partials
+// were produced.
+inline void tree_reduce(float *data, const int n, const size_t stride, const int len) {
+    for( int width = 1; width < n; width *= 2 ) {
+        for( int i = 0; i + width < n; i += 2 * width ) {
+            float *dst = data + size_t(i) * stride;
+            const float *src = data + size_t(i + width) * stride;
+            for( int e = 0; e < len; ++e ) { dst[e] += src[e]; }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace cpu
+}  // namespace fmha
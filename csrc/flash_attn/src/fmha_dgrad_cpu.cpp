@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Copyright (c) 2022, Tri Dao.
+ * Copyright (c) 2011-2021, NVIDIA CORPORATION.  All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#include <mutex>
+#include <vector>
+
+#include <ATen/Parallel.h>
+
+#include "fp16_switch.h"
+#include "fmha.h"
+#include "fmha_cpu.h"
+#include "fmha_scheduler.h"
+
+// dsoftmax_sum = rowsum(dO * O), the D term of dS = P * (dP - D). With an output gate, O is the
+// gated output and dgate = dO * O * (1 - sigmoid(gate)) is written alongside.
+template<typename elem_type>
+void fmha_dgrad_cpu_dot_do_o(const FMHA_dgrad_params &params, const int bidb, const int bidh) {
+    const fmha::cpu::Block_info binfo(params, bidb, bidh);
+    float *dsoftmax_sum = static_cast<float *>(params.dsoftmax_sum) + (size_t(bidb) * params.h + bidh) * params.seqlen_q;
+    for( int row = 0; row < binfo.actual_seqlen_q; ++row ) {
+        const elem_type *o = fmha::cpu::row_ptr<elem_type>(params.o_ptr, params.o_row_stride_in_elts,
+                                                           params.o_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+        const elem_type *d_o = fmha::cpu::row_ptr<elem_type>(params.do_ptr, params.o_row_stride_in_elts,
+                                                             params.o_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+        dsoftmax_sum[row] = fmha::cpu::dot(d_o, o, params.d);
+        if( params.gate_ptr != nullptr ) {
+            const elem_type *gate = fmha::cpu::row_ptr<elem_type>(params.gate_ptr, params.o_row_stride_in_elts,
+                                                                  params.o_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+            elem_type *dgate = fmha::cpu::row_ptr<elem_type>(params.dgate_ptr, params.o_row_stride_in_elts,
+                                                             params.o_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+            for( int di = 0; di < params.d; ++di ) {
+                const float sig = fmha::cpu::sigmoid(fmha::cpu::to_float(gate[di]));
+                dgate[di] = fmha::cpu::from_float<elem_type>(
+                    fmha::cpu::to_float(d_o[di]) * fmha::cpu::to_float(o[di]) * (1.f - sig));
+            }
+        }
+    }
+}
+
+// Computes dK and dV of the keys [loop_step_idx * FMHA_CPU_BLOCK_N, +FMHA_CPU_BLOCK_N) of one
+// (batch, head) and the contribution of those keys to dQ. dK and dV are owned by this block, while
+// the dQ partial is either stored to its own slot of dq_partial_ptr (deterministic) or added to
+// dq_tmp under the lock of the (batch, head).
+template<typename elem_type>
+void fmha_dgrad_cpu_block(const FMHA_dgrad_params &params, const int bidb, const int bidh,
+                          const int loop_step_idx, std::mutex &dq_lock) {
+    const fmha::cpu::Block_info binfo(params, bidb, bidh);
+    const int col_begin = loop_step_idx * FMHA_CPU_BLOCK_N;
+    const int col_end = std::min(col_begin + FMHA_CPU_BLOCK_N, binfo.actual_seqlen_k);
+    if( col_begin >= col_end ) { return; }
+    const int cols = col_end - col_begin;
+    const int d = params.d;
+    const float scale = params.scale_bmm1f;
+    const float *lse = static_cast<const float *>(params.softmax_lse_ptr) + (size_t(bidb) * params.h + bidh) * params.seqlen_q;
+    const float *dsoftmax_sum = static_cast<const float *>(params.dsoftmax_sum) + (size_t(bidb) * params.h + bidh) * params.seqlen_q;
+    elem_type *ds_row = nullptr;
+    if( params.attn_ds_ptr != nullptr ) {
+        ds_row = static_cast<elem_type *>(params.attn_ds_ptr)
+            + (size_t(bidb) * params.h + bidh) * binfo.actual_seqlen_q * binfo.actual_seqlen_k;
+    }
+
+    std::vector<float> s(cols);
+    std::vector<float> d_o(d);
+    std::vector<float> acc_dk(size_t(cols) * d, 0.f);
+    std::vector<float> acc_dv(size_t(cols) * d, 0.f);
+    std::vector<float> acc_dq(size_t(binfo.actual_seqlen_q) * d, 0.f);
+    for( int row = 0; row < binfo.actual_seqlen_q; ++row ) {
+        fmha::cpu::compute_logits<elem_type>(params, binfo, row, col_begin, col_end, s.data());
+        const elem_type *q = fmha::cpu::row_ptr<elem_type>(params.q_ptr, params.q_row_stride_in_elts,
+                                                           params.q_head_stride_in_elts, row, bidh) + binfo.q_offset;
+        fmha::cpu::load_do<elem_type>(params, binfo, row, d_o.data());
+        float *dq = &acc_dq[size_t(row) * d];
+        for( int col = col_begin; col < col_end; ++col ) {
+            const int ci = col - col_begin;
+            const float p = std::exp(s[ci] * scale - lse[row]);
+            const elem_type *k = fmha::cpu::row_ptr<elem_type>(params.k_ptr, params.k_row_stride_in_elts,
+                                                               params.k_head_stride_in_elts, col, bidh) + binfo.k_offset;
+            const elem_type *v = fmha::cpu::row_ptr<elem_type>(params.v_ptr, params.v_row_stride_in_elts,
+                                                               params.v_head_stride_in_elts, col, bidh) + binfo.v_offset;
+            const float dp = fmha::cpu::dot(d_o.data(), v, d);
+            // dS w.r.t. the unscaled logits, i.e. also the gradient of attn_bias.
+            const float ds = p * (dp - dsoftmax_sum[row]) * scale;
+            for( int di = 0; di < d; ++di ) {
+                acc_dv[size_t(ci) * d + di] += p * d_o[di];
+                acc_dk[size_t(ci) * d + di] += ds * fmha::cpu::to_float(q[di]);
+                dq[di] += ds * fmha::cpu::to_float(k[di]);
+            }
+            if( ds_row != nullptr ) {
+                ds_row[size_t(row) * binfo.actual_seqlen_k + col] = fmha::cpu::from_float<elem_type>(ds);
+            }
+        }
+    }
+
+    for( int col = col_begin; col < col_end; ++col ) {
+        const int ci = col - col_begin;
+        elem_type *dk = fmha::cpu::row_ptr<elem_type>(params.dk_ptr, params.dk_row_stride_in_elts,
+                                                      params.dk_head_stride_in_elts, binfo.sum_s_k + col, bidh);
+        elem_type *dv = fmha::cpu::row_ptr<elem_type>(params.dv_ptr, params.dv_row_stride_in_elts,
+                                                      params.dv_head_stride_in_elts, binfo.sum_s_k + col, bidh);
+        for( int di = 0; di < d; ++di ) {
+            dk[di] = fmha::cpu::from_float<elem_type>(acc_dk[size_t(ci) * d + di]);
+            dv[di] = fmha::cpu::from_float<elem_type>(acc_dv[size_t(ci) * d + di]);
+        }
+    }
+
+    if( params.deterministic ) {
+        void *slot = static_cast<float *>(params.dq_partial_ptr)
+            + size_t(loop_step_idx) * params.cu_seqlens_q[params.b] * params.o_row_stride_in_elts;
+        for( int row = 0; row < binfo.actual_seqlen_q; ++row ) {
+            float *dq = fmha::cpu::row_ptr<float>(slot, params.o_row_stride_in_elts, params.o_head_stride_in_elts,
+                                                  binfo.sum_s_q + row, bidh);
+            std::copy_n(&acc_dq[size_t(row) * d], d, dq);
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(dq_lock);
+        for( int row = 0; row < binfo.actual_seqlen_q; ++row ) {
+            float *dq = fmha::cpu::row_ptr<float>(params.o_tmp_ptr, params.o_row_stride_in_elts, params.o_head_stride_in_elts,
+                                                  binfo.sum_s_q + row, bidh);
+            for( int di = 0; di < d; ++di ) { dq[di] += acc_dq[size_t(row) * d + di]; }
+        }
+    }
+}
+
+// Writes dQ of one (batch, head) from the fp32 accumulators.
+template<typename elem_type>
+void fmha_dgrad_cpu_store_dq(const FMHA_dgrad_params &params, const int bidb, const int bidh, const int loop_steps) {
+    const fmha::cpu::Block_info binfo(params, bidb, bidh);
+    const size_t slot_stride = size_t(params.cu_seqlens_q[params.b]) * params.o_row_stride_in_elts;
+    for( int row = 0; row < binfo.actual_seqlen_q; ++row ) {
+        float *acc;
+        if( params.deterministic ) {
+            acc = fmha::cpu::row_ptr<float>(params.dq_partial_ptr, params.o_row_stride_in_elts,
+                                            params.o_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+            fmha::cpu::tree_reduce(acc, loop_steps, slot_stride, params.d);
+        } else {
+            acc = fmha::cpu::row_ptr<float>(params.o_tmp_ptr, params.o_row_stride_in_elts,
+                                            params.o_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+        }
+        elem_type *dq = fmha::cpu::row_ptr<elem_type>(params.dq_ptr, params.dq_row_stride_in_elts,
+                                                      params.dq_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+        for( int di = 0; di < params.d; ++di ) { dq[di] = fmha::cpu::from_float<elem_type>(acc[di]); }
+    }
+}
+
+void run_fmha_dgrad_cpu(const FMHA_dgrad_params &params) {
+    const int loop_steps = (params.seqlen_k + FMHA_CPU_BLOCK_N - 1) / FMHA_CPU_BLOCK_N;
+    const int64_t num_heads = int64_t(params.b) * params.h;
+    std::vector<std::mutex> dq_locks(num_heads);
+    const std::vector<fmha::Work_item> items = fmha::make_key_schedule(
+        params.cu_seqlens_q, params.cu_seqlens_k, params.b, params.h, FMHA_CPU_BLOCK_N, params.is_causal);
+    FP16_SWITCH(params.is_bf16, [&] {
+        at::parallel_for(0, num_heads, 1, [&](int64_t begin, int64_t end) {
+            for( int64_t bh = begin; bh < end; ++bh ) {
+                fmha_dgrad_cpu_dot_do_o<elem_type>(params, bh / params.h, bh % params.h);
+            }
+        });
+        const fmha::Schedule_stats stats = fmha::run_work_stealing(
+            items, at::get_num_threads(), [&](const fmha::Work_item &item) {
+                fmha_dgrad_cpu_block<elem_type>(params, item.bidb, item.bidh, item.block,
+                                                dq_locks[size_t(item.bidb) * params.h + item.bidh]);
+            });
+        fmha::record_schedule_stats("bwd", stats);
+        at::parallel_for(0, num_heads, 1, [&](int64_t begin, int64_t end) {
+            for( int64_t bh = begin; bh < end; ++bh ) {
+                fmha_dgrad_cpu_store_dq<elem_type>(params, bh / params.h, bh % params.h, loop_steps);
+            }
+        });
+    });
+}
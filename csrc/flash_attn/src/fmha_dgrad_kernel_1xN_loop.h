@@ -31,6 +31,31 @@ inline __device__ void dot_do_o(const uint4 (&do_)[M], const uint4 (&o)[M], cons
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// With a sigmoid output gate, out = o * sigmoid(gate). The rows of dO are scaled by sigmoid(gate)
+// before they are committed to shared memory for the dV and dP GEMMs, and on the first loop step
+// (which visits every row) dgate = dout * out * (1 - sigmoid(gate)) is written out.
+template<bool Is_first, typename elem_type, typename Gmem_tile>
+inline __device__ void apply_output_gate(Gmem_tile &gmem_do, const Gmem_tile &gmem_o,
+                                         Gmem_tile &gmem_gate, Gmem_tile &gmem_dgate) {
+    gmem_gate.load();
+    if (Is_first) {
+        uint4 dgate[Gmem_tile::LDGS];
+        #pragma unroll
+        for (int ii = 0; ii < Gmem_tile::LDGS; ++ii) {
+            dgate[ii] = fmha::hdsigmoid8<elem_type>(gmem_do.fetch_[ii], gmem_o.fetch_[ii], gmem_gate.fetch_[ii]);
+        }
+        gmem_dgate.store(dgate);
+        gmem_dgate.move();
+    }
+    #pragma unroll
+    for (int ii = 0; ii < Gmem_tile::LDGS; ++ii) {
+        gmem_do.fetch_[ii] = fmha::hmul8_sigmoid<elem_type>(gmem_do.fetch_[ii], gmem_gate.fetch_[ii]);
+    }
+    gmem_gate.move();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 template<typename Kernel_traits, bool Is_dropout, bool Is_causal, bool has_attn_mask, bool has_attn_bias, bool Is_first, bool Is_last, typename Params, typename Prng>
 inline __device__ void compute_dq_dk_dv_1xN_one_iter(const Params &params, Prng &ph,
                                                      const int loop_step_idx) {
@@ -141,7 +166,7 @@ inline __device__ void compute_dq_dk_dv_1xN_one_iter(const Params &params, Prng
 
     Gemm1 gemm_q_k(&smem_[Smem_tile_do::BYTES_PER_TILE], tidx);
     // Allocate the global memory tile loader for Q.
-    Gmem_tile_q gmem_q(params.q_ptr, params.q_row_stride_in_elts, params.q_head_stride_in_elts, binfo, tidx, true);
+    Gmem_tile_q gmem_q(params.q_ptr, params.q_row_stride_in_elts, params.q_head_stride_in_elts, binfo, tidx, true, params.q_batch_offsets);
     // Allocate the global memory tile loader for dQ.
     Gmem_tile_dq gmem_dq(params.dq_ptr, params.dq_row_stride_in_elts, params.dq_head_stride_in_elts, binfo, tidx);
     Gmem_tile_dq_tmp gmem_dq_tmp(params.o_tmp_ptr, params.o_row_stride_in_elts, params.o_head_stride_in_elts, binfo, tidx);
@@ -164,9 +189,9 @@ inline __device__ void compute_dq_dk_dv_1xN_one_iter(const Params &params, Prng
     fmha::Mask<Cta_tile_p, Is_causal> mask(binfo, tidx, loop_step_idx);
 
     // Allocate the global memory tile loader for K.
-    Gmem_tile_k gmem_k(params.k_ptr, params.k_row_stride_in_elts, params.k_head_stride_in_elts, binfo, tidx, false);
+    Gmem_tile_k gmem_k(params.k_ptr, params.k_row_stride_in_elts, params.k_head_stride_in_elts, binfo, tidx, false, params.k_batch_offsets);
     // Allocate the global memory tile loader for V.
-    Gmem_tile_v gmem_v(params.v_ptr, params.v_row_stride_in_elts, params.v_head_stride_in_elts, binfo, tidx, false);
+    Gmem_tile_v gmem_v(params.v_ptr, params.v_row_stride_in_elts, params.v_head_stride_in_elts, binfo, tidx, false, params.v_batch_offsets);
     // The base pointer of smem_v;
     char *smem_v_ = &smem_[Smem_tile_do::BYTES_PER_TILE + Gemm1::SMEM_OFFSET_V];
 
@@ -189,6 +214,9 @@ inline __device__ void compute_dq_dk_dv_1xN_one_iter(const Params &params, Prng
 
     // Allocate the global memory tile loader for O.
     Gmem_tile_o gmem_o(params.o_ptr, params.o_row_stride_in_elts, params.o_head_stride_in_elts, binfo, tidx, true);
+    // Allocate the global memory tile loaders for the output gate and its gradient. They share the layout of O.
+    Gmem_tile_o gmem_gate(params.gate_ptr, params.o_row_stride_in_elts, params.o_head_stride_in_elts, binfo, tidx, true);
+    Gmem_tile_o gmem_dgate(params.dgate_ptr, params.o_row_stride_in_elts, params.o_head_stride_in_elts, binfo, tidx, true);
 
     // Allocate the shared memory tile loader for O. We use the same as K so be careful!!!
     Smem_tile_dq smem_dq(&smem_[Smem_tile_do::BYTES_PER_TILE + Gemm1::SMEM_OFFSET_O], tidx);
@@ -204,6 +232,8 @@ inline __device__ void compute_dq_dk_dv_1xN_one_iter(const Params &params, Prng
     gmem_q.move(begin);
     gmem_do.move(begin);
     gmem_o.move(begin);
+    gmem_gate.move(begin);
+    gmem_dgate.move(begin);
     gmem_dq.move(begin);
     gmem_dq_tmp.move(begin);
     // TODO: need to move gmem_s if we want the intermediate result for debugging
@@ -242,13 +272,16 @@ inline __device__ void compute_dq_dk_dv_1xN_one_iter(const Params &params, Prng
     if (!Is_first) { __syncthreads(); }
     // Commit the data for Q, dO, and V to shared memory.
     gmem_q.commit(gemm_q_k.smem_q);
-    gmem_do.commit(smem_do);
-
+    // D is the rowsum of dout * out, so it is taken before dO is scaled by the output gate.
     if (Is_first) {
         dot_do_o<Gmem_tile_do::ROWS, Gmem_tile_do::THREADS_PER_ROW, elem_type>(
             gmem_do.fetch_, gmem_o.fetch_, params.p_dropout, gmem_softmax_d, tidx
         );
     }
+    if (params.gate_ptr != nullptr) {
+        apply_output_gate<Is_first, elem_type>(gmem_do, gmem_o, gmem_gate, gmem_dgate);
+    }
+    gmem_do.commit(smem_do);
 
     // // Instead of scaling dP by rp_dropout, we scale V instead
     // if (Is_dropout) {
@@ -575,12 +608,15 @@ inline __device__ void compute_dq_dk_dv_1xN_one_iter(const Params &params, Prng
         // __syncthreads();
         // Commit the values for Q and dO into shared memory.
         if(l < steps - 1) {
-            gmem_do.commit(smem_do);
             if (Is_first) {
                 dot_do_o<Gmem_tile_do::ROWS, Gmem_tile_do::THREADS_PER_ROW, elem_type>(
                     gmem_do.fetch_, gmem_o.fetch_, params.p_dropout, gmem_softmax_d, tidx
                 );
             }
+            if (params.gate_ptr != nullptr) {
+                apply_output_gate<Is_first, elem_type>(gmem_do, gmem_o, gmem_gate, gmem_dgate);
+            }
+            gmem_do.commit(smem_do);
             gmem_softmax_lse.load(reinterpret_cast<uint32_t(&)[Mma_tile_p::MMAS_M * 2]>(p_lse));
             gmem_softmax_lse.move();
         }
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright (c) 2022, Tri Dao.
+ * Copyright (c) 2011-2021, NVIDIA CORPORATION.  All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#include <vector>
+
+#include <ATen/Parallel.h>
+
+#include "fp16_switch.h"
+#include "fmha.h"
+#include "fmha_cpu.h"
+#include "fmha_scheduler.h"
+
+// Computes O and the softmax logsumexp for a chunk of block_m rows of Q of one (batch, head). The
+// keys are streamed past the chunk block_n at a time: every K/V block (and the matching mask and
+// bias tiles, read in place from their (mod_size, h, s_q, s_k) layout) is converted once and used by
+// all the rows of the chunk, which keep the same online softmax state as the device loop.
+template<typename elem_type>
+void fmha_fprop_cpu_block(const FMHA_fprop_params &params, const int bidb, const int bidh, const int bidm,
+                          const int block_m, const int block_n) {
+    const fmha::cpu::Block_info binfo(params, bidb, bidh);
+    const int row_begin = bidm * block_m;
+    const int row_end = std::min(row_begin + block_m, binfo.actual_seqlen_q);
+    if( row_begin >= row_end ) { return; }
+    const int rows = row_end - row_begin;
+    const int d = params.d;
+    const float scale = params.scale_bmm1f;
+
+    std::vector<float> q(size_t(rows) * d);
+    std::vector<float> k(size_t(block_n) * d);
+    std::vector<float> v(size_t(block_n) * d);
+    std::vector<float> s(size_t(rows) * block_n);
+    std::vector<float> acc(size_t(rows) * d, 0.f);
+    std::vector<float> p_max(rows, -std::numeric_limits<float>::infinity());
+    std::vector<float> p_sum(rows, 0.f);
+    for( int row = row_begin; row < row_end; ++row ) {
+        const elem_type *src = fmha::cpu::row_ptr<elem_type>(params.q_ptr, params.q_row_stride_in_elts,
+                                                             params.q_head_stride_in_elts, row, bidh) + binfo.q_offset;
+        for( int di = 0; di < d; ++di ) { q[size_t(row - row_begin) * d + di] = fmha::cpu::to_float(src[di]); }
+    }
+
+    // With causal masking the last row of the chunk sees no key past itself.
+    const int seqlen_k = params.is_causal ? std::min(binfo.actual_seqlen_k, row_end) : binfo.actual_seqlen_k;
+    for( int col_begin = 0; col_begin < seqlen_k; col_begin += block_n ) {
+        const int col_end = std::min(col_begin + block_n, seqlen_k);
+        for( int col = col_begin; col < col_end; ++col ) {
+            const elem_type *k_src = fmha::cpu::row_ptr<elem_type>(params.k_ptr, params.k_row_stride_in_elts,
+                                                                   params.k_head_stride_in_elts, col, bidh) + binfo.k_offset;
+            const elem_type *v_src = fmha::cpu::row_ptr<elem_type>(params.v_ptr, params.v_row_stride_in_elts,
+                                                                   params.v_head_stride_in_elts, col, bidh) + binfo.v_offset;
+            for( int di = 0; di < d; ++di ) {
+                k[size_t(col - col_begin) * d + di] = fmha::cpu::to_float(k_src[di]);
+                v[size_t(col - col_begin) * d + di] = fmha::cpu::to_float(v_src[di]);
+            }
+        }
+        for( int ri = 0; ri < rows; ++ri ) {
+            const int row = row_begin + ri;
+            float *s_row = &s[size_t(ri) * block_n];
+            fmha::cpu::compute_logits<elem_type>(params, binfo, row, &q[size_t(ri) * d], k.data(),
+                                                 col_begin, col_end, s_row);
+            float block_max = -std::numeric_limits<float>::infinity();
+            for( int col = col_begin; col < col_end; ++col ) {
+                block_max = std::max(block_max, s_row[col - col_begin] * scale);
+            }
+            if( block_max == -std::numeric_limits<float>::infinity() ) { continue; }
+            const float new_max = std::max(p_max[ri], block_max);
+            const float correction = std::exp(p_max[ri] - new_max);
+            float *acc_row = &acc[size_t(ri) * d];
+            p_sum[ri] *= correction;
+            for( int di = 0; di < d; ++di ) { acc_row[di] *= correction; }
+            for( int col = col_begin; col < col_end; ++col ) {
+                const float p = std::exp(s_row[col - col_begin] * scale - new_max);
+                const float *v_row = &v[size_t(col - col_begin) * d];
+                p_sum[ri] += p;
+                for( int di = 0; di < d; ++di ) { acc_row[di] += p * v_row[di]; }
+            }
+            p_max[ri] = new_max;
+        }
+    }
+
+    float *lse = static_cast<float *>(params.softmax_lse_ptr) + (size_t(bidb) * params.h + bidh) * params.seqlen_q;
+    for( int ri = 0; ri < rows; ++ri ) {
+        const int row = row_begin + ri;
+        float *acc_row = &acc[size_t(ri) * d];
+        const float inv_sum = p_sum[ri] == 0.f ? 0.f : 1.f / p_sum[ri];
+        if( params.gate_ptr != nullptr ) {
+            const elem_type *gate = fmha::cpu::row_ptr<elem_type>(params.gate_ptr, params.o_row_stride_in_elts,
+                                                                  params.o_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+            for( int di = 0; di < d; ++di ) { acc_row[di] *= fmha::cpu::sigmoid(fmha::cpu::to_float(gate[di])); }
+        }
+        elem_type *o = fmha::cpu::row_ptr<elem_type>(params.o_ptr, params.o_row_stride_in_elts,
+                                                     params.o_head_stride_in_elts, binfo.sum_s_q + row, bidh);
+        for( int di = 0; di < d; ++di ) { o[di] = fmha::cpu::from_float<elem_type>(acc_row[di] * inv_sum); }
+        lse[row] = p_sum[ri] == 0.f ? INFINITY : p_max[ri] + std::log(p_sum[ri]);
+    }
+}
+
+void run_fmha_fprop_cpu(const FMHA_fprop_params &params) {
+    fmha::Chunk_plan plan;
+    plan.block_m = params.cpu_block_m;
+    plan.block_n = params.cpu_block_n;
+    if( plan.block_m <= 0 || plan.block_n <= 0 ) {
+        // Both element types are 2 bytes wide.
+        plan = fmha::plan_cpu_chunks(params.d, 2, params.attn_mask_ptr != nullptr,
+                                     params.attn_bias_ptr != nullptr, 0);
+    }
+    const int block_m = plan.block_m;
+    const int block_n = plan.block_n;
+    const std::vector<fmha::Work_item> items = fmha::make_query_schedule(
+        params.cu_seqlens_q, params.cu_seqlens_k, params.b, params.h, block_m, params.is_causal);
+    FP16_SWITCH(params.is_bf16, [&] {
+        const fmha::Schedule_stats stats = fmha::run_work_stealing(
+            items, at::get_num_threads(), [&](const fmha::Work_item &item) {
+                fmha_fprop_cpu_block<elem_type>(params, item.bidb, item.bidh, item.block, block_m, block_n);
+            });
+        fmha::record_schedule_stats("fwd", stats);
+    });
+}
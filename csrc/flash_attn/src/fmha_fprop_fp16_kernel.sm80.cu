@@ -38,6 +38,42 @@ __global__ void fmha_fprop_fp16_sm80_loop_kernel(FMHA_fprop_params params) {
     fmha::device_1xN_loop<Kernel_traits, Is_dropout, Is_causal, Return_softmax, Need_attn_mask, Need_attn_bias>(params);
 }
 
+template<typename Kernel_traits, bool Is_causal, bool Need_attn_mask, bool Need_attn_bias>
+__global__ void fmha_fprop_fp16_sm80_persistent_kernel(FMHA_fprop_params params) {
+    fmha::device_1xN_persistent<Kernel_traits, Is_causal, Need_attn_mask, Need_attn_bias>(params);
+}
+
+// Launches as many CTAs as can be resident at once, which then drain the LPT work queue.
+template<typename Kernel_traits>
+void run_fmha_fp16_sm80_persistent_(Launch_params<FMHA_fprop_params> &launch_params,
+                                    const int smem_size) {
+    bool has_attn_mask = !(launch_params.params.attn_mask_ptr == nullptr);
+    bool has_attn_bias = !(launch_params.params.attn_bias_ptr == nullptr);
+    BOOL_SWITCH(launch_params.params.is_causal, IsCausalConst, [&] {
+        auto kernel = has_attn_mask
+            ? (has_attn_bias
+            ? &fmha_fprop_fp16_sm80_persistent_kernel<Kernel_traits, IsCausalConst, true, true>
+            : &fmha_fprop_fp16_sm80_persistent_kernel<Kernel_traits, IsCausalConst, true, false>)
+            : (has_attn_bias
+            ? &fmha_fprop_fp16_sm80_persistent_kernel<Kernel_traits, IsCausalConst, false, true>
+            : &fmha_fprop_fp16_sm80_persistent_kernel<Kernel_traits, IsCausalConst, false, false>);
+        if( smem_size >= 48 * 1024 ) {
+            FMHA_CHECK_CUDA(cudaFuncSetAttribute(
+                kernel, cudaFuncAttributeMaxDynamicSharedMemorySize, smem_size));
+        }
+        int ctas_per_sm = 0;
+        FMHA_CHECK_CUDA(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+            &ctas_per_sm, kernel, Kernel_traits::THREADS, smem_size));
+        const int num_ctas = std::min(launch_params.params.num_work_items,
+                                      std::max(ctas_per_sm, 1) * launch_params.props->multiProcessorCount);
+        launch_params.num_persistent_ctas = num_ctas;
+        if( num_ctas == 0 ) { return; }
+        kernel<<<num_ctas, Kernel_traits::THREADS, smem_size, launch_params.stream>>>(
+            launch_params.params);
+        FMHA_CHECK_CUDA(cudaPeekAtLastError());
+    });
+}
+
 template<typename Kernel_traits>
 void run_fmha_fp16_sm80_loop_(Launch_params<FMHA_fprop_params> &launch_params,
                               const bool configure) {
@@ -60,6 +96,11 @@ void run_fmha_fp16_sm80_loop_(Launch_params<FMHA_fprop_params> &launch_params,
     const int smem_size = fmha::get_dynamic_smem_size<Kernel_traits>()
         + (loop_steps > 1 ? smem_size_softmax_lse : 0);
 
+    if (launch_params.params.work_items != nullptr) {
+        run_fmha_fp16_sm80_persistent_<Kernel_traits>(launch_params, smem_size);
+        return;
+    }
+
     bool has_attn_mask = !(launch_params.params.attn_mask_ptr == nullptr);
     bool has_attn_bias = !(launch_params.params.attn_bias_ptr == nullptr);
 
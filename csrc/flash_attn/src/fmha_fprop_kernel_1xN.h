@@ -258,10 +258,12 @@ inline __device__ void device_1xN_(const Params &params, const int bidb, const i
     Gemm1 gemm_q_k(smem_, tidx);
 
     // Allocate the global memory tile loader for Q.
-    Gmem_tile_q gmem_q(params.q_ptr, params.q_row_stride_in_elts, params.q_head_stride_in_elts, binfo, tidx, true);
+    Gmem_tile_q gmem_q(params.q_ptr, params.q_row_stride_in_elts, params.q_head_stride_in_elts, binfo, tidx, true, params.q_batch_offsets);
     // Allocate the global memory tile loader for O.
     Gmem_tile_o gmem_o(params.o_ptr, params.o_row_stride_in_elts, params.o_head_stride_in_elts, binfo, tidx);
     Gmem_tile_o_tmp gmem_o_tmp(params.o_tmp_ptr, params.o_row_stride_in_elts, params.o_head_stride_in_elts, binfo, tidx);
+    // Allocate the global memory tile loader for the output gate. It shares the layout of O.
+    Gmem_tile_o gmem_gate(params.gate_ptr, params.o_row_stride_in_elts, params.o_head_stride_in_elts, binfo, tidx);
     // Allocate the global memory tile loader for S.
     Gmem_tile_s gmem_s(params, binfo, tidx);
 
@@ -285,6 +287,7 @@ inline __device__ void device_1xN_(const Params &params, const int bidb, const i
     steps -= begin - begin_og;
     gmem_q.move(begin);
     gmem_o.move(begin);
+    gmem_gate.move(begin);
     gmem_o_tmp.move(begin);
     if (Return_softmax) { gmem_s.move(begin); }
     gmem_softmax_lse.move(begin);
@@ -300,9 +303,9 @@ inline __device__ void device_1xN_(const Params &params, const int bidb, const i
     fmha::Mask<Cta_tile_p, Is_causal> mask(binfo, tidx, loop_step_idx);
 
     // Allocate the global memory tile loader for K.
-    Gmem_tile_k gmem_k(params.k_ptr, params.k_row_stride_in_elts, params.k_head_stride_in_elts, binfo, tidx, false);
+    Gmem_tile_k gmem_k(params.k_ptr, params.k_row_stride_in_elts, params.k_head_stride_in_elts, binfo, tidx, false, params.k_batch_offsets);
     // Allocate the global memory tile loader for V.
-    Gmem_tile_v gmem_v(params.v_ptr, params.v_row_stride_in_elts, params.v_head_stride_in_elts, binfo, tidx, false);
+    Gmem_tile_v gmem_v(params.v_ptr, params.v_row_stride_in_elts, params.v_head_stride_in_elts, binfo, tidx, false, params.v_batch_offsets);
     // The base pointer of smem_v;
     char *smem_v_ = &smem_[Gemm1::SMEM_OFFSET_V];
     // smem_ is continous memory, each part is v, o
@@ -666,6 +669,11 @@ inline __device__ void device_1xN_(const Params &params, const int bidb, const i
 
         // Output the values.
         if (is_final_write) {
+            // Fuse the sigmoid output gate into the epilogue while O is still in fp32.
+            if (params.gate_ptr != nullptr) {
+                gmem_gate.template apply_sigmoid_gate<elem_type>(out, 0);
+                gmem_gate.move();
+            }
             gmem_o.template store<elem_type>(out, 0);
             gmem_o.move();
         } else {
@@ -724,5 +732,43 @@ inline __device__ void device_1xN_loop(const Params &params) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Persistent variant of device_1xN_loop: instead of owning one (batch, head), each CTA dequeues
+// work items (bidb, bidh, first step, steps) from params.work_items, which the host sorted longest
+// first, until the queue is drained. Dropout and Return_softmax are not supported since both tie
+// the Philox offsets and the S layout to one CTA per (batch, head).
+template<typename Kernel_traits, bool Is_causal, bool Need_attn_mask, bool Need_attn_bias, typename Params>
+inline __device__ void device_1xN_persistent(const Params &params) {
+
+    // Unused without dropout.
+    Philox ph0(0, 0, 0);
+    Philox ph1(0, 0, 0);
+
+    constexpr int blocksize_c = Kernel_traits::Cta_tile_p::N;
+    const int max_loop_steps = (params.seqlen_k + blocksize_c - 1) / blocksize_c;
+
+    __shared__ int work_idx;
+    while( true ) {
+        // Make sure the previous item is done with shared memory and everyone has read work_idx.
+        __syncthreads();
+        if( threadIdx.x == 0 ) { work_idx = atomicAdd(params.work_counter, 1); }
+        __syncthreads();
+        if( work_idx >= params.num_work_items ) { break; }
+        const int4 item = params.work_items[work_idx];
+        const int bidb = item.x, bidh = item.y, begin = item.z, steps = item.w;
+
+        if( max_loop_steps == 1 ) {
+            fmha::device_1xN_<Kernel_traits, false, Is_causal, false, Need_attn_mask, Need_attn_bias, true, true>(params, bidb, bidh, begin, steps, ph0, ph1, 0);
+        } else {
+            fmha::device_1xN_<Kernel_traits, false, Is_causal, false, Need_attn_mask, Need_attn_bias, true, false>(params, bidb, bidh, begin, steps, ph0, ph1, 0);
+            for( int loop_step_idx = 1; loop_step_idx < max_loop_steps - 1; loop_step_idx++ ) {
+                fmha::device_1xN_<Kernel_traits, false, Is_causal, false, Need_attn_mask, Need_attn_bias, false, false>(params, bidb, bidh, begin, steps, ph0, ph1, loop_step_idx);
+            }
+            fmha::device_1xN_<Kernel_traits, false, Is_causal, false, Need_attn_mask, Need_attn_bias, false, true>(params, bidb, bidh, begin, steps, ph0, ph1, max_loop_steps - 1);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace fmha
 
@@ -0,0 +1,291 @@
+/******************************************************************************
+ * Copyright (c) 2022, Tri Dao.
+ * Copyright (c) 2011-2021, NVIDIA CORPORATION.  All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+
+#include <unistd.h>
+
+#include <ATen/Parallel.h>
+
+#include "fmha_scheduler.h"
+
+namespace fmha {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Query row r sees the keys [0, min(r + 1, seqlen_k)) when causal.
+int64_t query_block_cost(const int row_begin, const int row_end, const int seqlen_k, const bool is_causal) {
+    if( !is_causal ) { return int64_t(row_end - row_begin) * seqlen_k; }
+    int64_t cost = 0;
+    for( int row = row_begin; row < row_end; ++row ) { cost += std::min(row + 1, seqlen_k); }
+    return cost;
+}
+
+// Key column c is seen by the queries [c, seqlen_q) when causal.
+int64_t key_block_cost(const int col_begin, const int col_end, const int seqlen_q, const bool is_causal) {
+    if( !is_causal ) { return int64_t(col_end - col_begin) * seqlen_q; }
+    int64_t cost = 0;
+    for( int col = col_begin; col < col_end; ++col ) { cost += std::max(seqlen_q - col, 0); }
+    return cost;
+}
+
+void sort_lpt(std::vector<Work_item> &items) {
+    std::stable_sort(items.begin(), items.end(),
+                     [](const Work_item &a, const Work_item &b) { return a.cost > b.cost; });
+}
+
+double imbalance_of(const std::vector<double> &loads) {
+    if( loads.empty() ) { return 1.0; }
+    double max_load = 0.0, sum = 0.0;
+    for( const double load : loads ) {
+        max_load = std::max(max_load, load);
+        sum += load;
+    }
+    return sum > 0.0 ? max_load * loads.size() / sum : 1.0;
+}
+
+struct Worker_queue {
+    std::mutex lock;
+    std::deque<int> items;
+};
+
+std::mutex stats_lock;
+std::map<std::string, Schedule_stats> stats_by_pass;
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<Work_item> make_query_schedule(const int *cu_seqlens_q, const int *cu_seqlens_k,
+                                           const int b, const int h, const int block_size,
+                                           const bool is_causal) {
+    std::vector<Work_item> items;
+    for( int bidb = 0; bidb < b; ++bidb ) {
+        const int seqlen_q = cu_seqlens_q[bidb + 1] - cu_seqlens_q[bidb];
+        const int seqlen_k = cu_seqlens_k[bidb + 1] - cu_seqlens_k[bidb];
+        const int blocks = (seqlen_q + block_size - 1) / block_size;
+        for( int bidh = 0; bidh < h; ++bidh ) {
+            for( int block = 0; block < blocks; ++block ) {
+                const int row_end = std::min((block + 1) * block_size, seqlen_q);
+                items.push_back({bidb, bidh, block, query_block_cost(block * block_size, row_end, seqlen_k, is_causal)});
+            }
+        }
+    }
+    sort_lpt(items);
+    return items;
+}
+
+std::vector<Work_item> make_head_schedule(const int *cu_seqlens_q, const int *cu_seqlens_k,
+                                          const int b, const int h, const bool is_causal) {
+    std::vector<Work_item> items;
+    for( int bidb = 0; bidb < b; ++bidb ) {
+        const int seqlen_q = cu_seqlens_q[bidb + 1] - cu_seqlens_q[bidb];
+        const int seqlen_k = cu_seqlens_k[bidb + 1] - cu_seqlens_k[bidb];
+        for( int bidh = 0; bidh < h; ++bidh ) {
+            items.push_back({bidb, bidh, 0, query_block_cost(0, seqlen_q, seqlen_k, is_causal)});
+        }
+    }
+    return items;
+}
+
+std::vector<Work_item> make_key_schedule(const int *cu_seqlens_q, const int *cu_seqlens_k,
+                                         const int b, const int h, const int block_size,
+                                         const bool is_causal) {
+    std::vector<Work_item> items;
+    for( int bidb = 0; bidb < b; ++bidb ) {
+        const int seqlen_q = cu_seqlens_q[bidb + 1] - cu_seqlens_q[bidb];
+        const int seqlen_k = cu_seqlens_k[bidb + 1] - cu_seqlens_k[bidb];
+        const int blocks = (seqlen_k + block_size - 1) / block_size;
+        for( int bidh = 0; bidh < h; ++bidh ) {
+            for( int block = 0; block < blocks; ++block ) {
+                const int col_end = std::min((block + 1) * block_size, seqlen_k);
+                items.push_back({bidb, bidh, block, key_block_cost(block * block_size, col_end, seqlen_q, is_causal)});
+            }
+        }
+    }
+    sort_lpt(items);
+    return items;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Schedule_stats simulate_schedule(const std::vector<Work_item> &items, const int num_workers) {
+    Schedule_stats stats;
+    stats.num_items = items.size();
+    stats.num_workers = std::max(num_workers, 1);
+    // Each item goes to the worker that becomes free first.
+    std::priority_queue<int64_t, std::vector<int64_t>, std::greater<int64_t>> free_at;
+    for( int w = 0; w < stats.num_workers; ++w ) { free_at.push(0); }
+    for( const Work_item &item : items ) {
+        const int64_t load = free_at.top() + item.cost;
+        free_at.pop();
+        free_at.push(load);
+        stats.total_cost += item.cost;
+    }
+    std::vector<double> loads;
+    while( !free_at.empty() ) {
+        stats.max_worker_cost = std::max(stats.max_worker_cost, free_at.top());
+        loads.push_back(free_at.top());
+        free_at.pop();
+    }
+    stats.imbalance = imbalance_of(loads);
+    return stats;
+}
+
+Schedule_stats run_work_stealing(const std::vector<Work_item> &items, const int num_workers,
+                                 const std::function<void(const Work_item &)> &fn) {
+    Schedule_stats stats;
+    stats.num_items = items.size();
+    stats.num_workers = std::max(num_workers, 1);
+
+    // Deal the items LPT first, so the queues start out balanced and stealing only fixes up the
+    // error of the cost model.
+    std::vector<Worker_queue> queues(stats.num_workers);
+    std::vector<int64_t> dealt(stats.num_workers, 0);
+    for( int i = 0; i < int(items.size()); ++i ) {
+        const int w = std::min_element(dealt.begin(), dealt.end()) - dealt.begin();
+        queues[w].items.push_back(i);
+        dealt[w] += items[i].cost;
+        stats.total_cost += items[i].cost;
+    }
+
+    std::vector<int64_t> worker_cost(stats.num_workers, 0);
+    std::vector<double> worker_seconds(stats.num_workers, 0.0);
+    std::atomic<int> num_steals(0);
+    auto work = [&](const int w) {
+        const auto start = std::chrono::steady_clock::now();
+        while( true ) {
+            int i = -1;
+            {
+                std::lock_guard<std::mutex> guard(queues[w].lock);
+                if( !queues[w].items.empty() ) {
+                    i = queues[w].items.front();
+                    queues[w].items.pop_front();
+                }
+            }
+            for( int v = 1; i < 0 && v < stats.num_workers; ++v ) {
+                Worker_queue &victim = queues[(w + v) % stats.num_workers];
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if( !victim.items.empty() ) {
+                    i = victim.items.back();
+                    victim.items.pop_back();
+                    ++num_steals;
+                }
+            }
+            // Nothing is ever pushed back, so empty queues everywhere mean we are done.
+            if( i < 0 ) { break; }
+            fn(items[i]);
+            worker_cost[w] += items[i].cost;
+        }
+        worker_seconds[w] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    at::parallel_for(0, stats.num_workers, 1, [&](int64_t begin, int64_t end) {
+        for( int64_t w = begin; w < end; ++w ) { work(w); }
+    });
+
+    stats.num_steals = num_steals;
+    stats.max_worker_cost = *std::max_element(worker_cost.begin(), worker_cost.end());
+    stats.imbalance = imbalance_of(worker_seconds);
+    return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t l2_cache_bytes() {
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    const long bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if( bytes > 0 ) { return size_t(bytes); }
+#endif
+    return size_t(1) << 20;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Chunk_plan plan_cpu_chunks(const int d, const int elem_bytes, const bool has_attn_mask,
+                           const bool has_attn_bias, const size_t budget_bytes) {
+    Chunk_plan plan;
+    // Leave the other half of L2 to the next K/V block and the output rows being written back.
+    plan.budget_bytes = budget_bytes > 0 ? budget_bytes : l2_cache_bytes() / 2;
+    auto working_set = [&](const int m, const int n) {
+        size_t bytes = size_t(m) * d * sizeof(float)             // Q chunk
+                     + size_t(2) * n * d * sizeof(float)         // K and V block
+                     + size_t(m) * d * sizeof(float)             // O accumulators
+                     + size_t(m) * 2 * sizeof(float)             // running max and sum
+                     + size_t(m) * n * sizeof(float);            // scores
+        if( has_attn_mask ) { bytes += size_t(m) * n * elem_bytes; }
+        if( has_attn_bias ) { bytes += size_t(m) * n * elem_bytes; }
+        return bytes;
+    };
+    double best_intensity = -1.0;
+    for( int m = 16; m <= 256; m += 16 ) {
+        for( int n = 16; n <= 512; n += 16 ) {
+            const size_t bytes = working_set(m, n);
+            if( bytes > plan.budget_bytes ) { break; }
+            const double intensity = double(m) * n / (m + n);
+            if( intensity > best_intensity ) {
+                best_intensity = intensity;
+                plan.block_m = m;
+                plan.block_n = n;
+                plan.working_set_bytes = bytes;
+            }
+        }
+    }
+    if( plan.block_m == 0 ) {
+        plan.block_m = plan.block_n = 16;
+        plan.working_set_bytes = working_set(16, 16);
+    }
+    return plan;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void record_schedule_stats(const char *pass, const Schedule_stats &stats) {
+    std::lock_guard<std::mutex> guard(stats_lock);
+    stats_by_pass[pass] = stats;
+}
+
+bool last_schedule_stats(const char *pass, Schedule_stats &stats) {
+    std::lock_guard<std::mutex> guard(stats_lock);
+    auto it = stats_by_pass.find(pass);
+    if( it == stats_by_pass.end() ) { return false; }
+    stats = it->second;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace fmha
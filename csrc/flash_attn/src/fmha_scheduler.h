@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright (c) 2022, Tri Dao.
+ * Copyright (c) 2011-2021, NVIDIA CORPORATION.  All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace fmha {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// One unit of work of a ragged batch: the block `block` of block_size query rows (forward) or key
+// columns (backward) of one (batch, head). The cost is the number of (query, key) pairs visited.
+struct Work_item {
+    int bidb;
+    int bidh;
+    int block;
+    int64_t cost;
+};
+
+// Load balance of one call. The load of a worker (a CTA or a CPU thread) is its predicted cost on
+// the GPU and its measured busy time on the CPU.
+struct Schedule_stats {
+    int num_items = 0;
+    int num_workers = 0;
+    int num_steals = 0;
+    int64_t total_cost = 0;
+    int64_t max_worker_cost = 0;
+    // The max over the mean of the per worker loads, 1.0 is a perfect balance.
+    double imbalance = 1.0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Splits every (sequence, head) of the batch into blocks of block_size query rows and returns them
+// longest processing time first. Ties keep the (bidb, bidh, block) order so the schedule is stable.
+std::vector<Work_item> make_query_schedule(const int *cu_seqlens_q, const int *cu_seqlens_k,
+                                           const int b, const int h, const int block_size,
+                                           const bool is_causal);
+
+// One item per (batch, head) in grid order, the unit of the (batch, head) grid of the default
+// kernel. Only used to compare a schedule against.
+std::vector<Work_item> make_head_schedule(const int *cu_seqlens_q, const int *cu_seqlens_k,
+                                          const int b, const int h, const bool is_causal);
+
+// Same as make_query_schedule for blocks of block_size key columns, the unit of the backward pass.
+std::vector<Work_item> make_key_schedule(const int *cu_seqlens_q, const int *cu_seqlens_k,
+                                         const int b, const int h, const int block_size,
+                                         const bool is_causal);
+
+// Predicts the balance of a queue drained in order by num_workers identical workers, which is what
+// the persistent kernel does with its atomic counter.
+Schedule_stats simulate_schedule(const std::vector<Work_item> &items, const int num_workers);
+
+// Runs fn on every item with num_workers work-stealing workers on the intra-op thread pool. The
+// items are dealt to the workers LPT first (largest item to the least loaded worker), each worker
+// pops its own queue from the front and steals from the back of the others when it runs dry.
+Schedule_stats run_work_stealing(const std::vector<Work_item> &items, const int num_workers,
+                                 const std::function<void(const Work_item &)> &fn);
+
+// Tile sizes of the chunked CPU forward pass: a chunk of block_m query rows stays resident while the
+// keys are streamed past it block_n at a time.
+struct Chunk_plan {
+    int block_m = 0;
+    int block_n = 0;
+    // The bytes touched per key block: the Q chunk, the K and V block, the scores, the mask and bias
+    // tiles and the accumulators of the chunk.
+    size_t working_set_bytes = 0;
+    size_t budget_bytes = 0;
+};
+
+// The L2 cache size of one core, or 1 MiB when the platform does not report it.
+size_t l2_cache_bytes();
+
+// Picks the multiples of 16 block_m <= 256 and block_n <= 512 whose working set fits in
+// budget_bytes (half of l2_cache_bytes() when 0) with the highest arithmetic intensity
+// block_m * block_n / (block_m + block_n). Falls back to 16 x 16 when nothing fits.
+Chunk_plan plan_cpu_chunks(const int d, const int elem_bytes, const bool has_attn_mask,
+                           const bool has_attn_bias, const size_t budget_bytes);
+
+// The stats of the last call of each pass ("fwd", "bwd"), readable from Python.
+void record_schedule_stats(const char *pass, const Schedule_stats &stats);
+bool last_schedule_stats(const char *pass, Schedule_stats &stats);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace fmha
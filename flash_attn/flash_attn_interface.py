@@ -15,11 +15,13 @@ def _get_block_size(device, head_dim, is_dropout):
 
 
 def _flash_attn_forward(q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q, max_seqlen_k, attn_mask, attn_bias, dropout_p,
-                        softmax_scale, causal, return_softmax):
+                        softmax_scale, causal, return_softmax, lpt_schedule=False, gate=None,
+                        cpu_memory_budget=0):
     # import pdb; pdb.set_trace()
     out, softmax_lse, *rest = flash_attn_cuda.fwd(
             q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q, max_seqlen_k, dropout_p, softmax_scale,
-            False, causal, return_softmax, None, attn_mask, attn_bias
+            False, causal, return_softmax, None, attn_mask, attn_bias, lpt_schedule, gate,
+            cpu_memory_budget
         )
     # if out.isnan().any() or softmax_lse.isnan().any():
     #     breakpoint()
@@ -28,14 +30,17 @@ def _flash_attn_forward(q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q, max_s
 
 
 def _flash_attn_backward(dout, q, k, v, out, softmax_lse, dq, dk, dv, cu_seqlens_q, cu_seqlens_k, attn_mask, attn_bias,
-                         max_seqlen_q, max_seqlen_k, dropout_p, softmax_scale, causal):
+                         max_seqlen_q, max_seqlen_k, dropout_p, softmax_scale, causal, deterministic=False,
+                         gate=None):
     softmax_d, *rest = flash_attn_cuda.bwd(
         dout, q, k, v, out, softmax_lse, dq, dk, dv, cu_seqlens_q, cu_seqlens_k,
-        max_seqlen_q, max_seqlen_k, dropout_p, softmax_scale, False, causal, None, attn_mask, attn_bias)
+        max_seqlen_q, max_seqlen_k, dropout_p, softmax_scale, False, causal, None, attn_mask, attn_bias,
+        deterministic, gate)
     # if dk.isnan().any() or dk.isnan().any() or dv.isnan().any() or softmax_d.isnan().any():
     #     breakpoint()
     dbias = None if attn_bias is None else rest[0]
-    return dq, dk, dv, softmax_d, dbias
+    dgate = None if gate is None else rest[-1]
+    return dq, dk, dv, softmax_d, dbias, dgate
 
 
 class FlashAttnQKVPackedFunc(torch.autograd.Function):
@@ -117,41 +122,71 @@ class FlashAttnFunc(torch.autograd.Function):
 
     @staticmethod
     def forward(ctx, q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q, max_seqlen_k, attn_mask, attn_bias,
-                dropout_p, softmax_scale, causal, return_softmax):
+                dropout_p, softmax_scale, causal, return_softmax, deterministic, lpt_schedule, gate,
+                cpu_memory_budget):
         # Save rng_state because the backward pass will regenerate the dropout mask
         rng_state = torch.cuda.get_rng_state() if dropout_p > 0 else None
         if softmax_scale is None:
             softmax_scale = q.shape[-1] ** (-0.5)
         out, softmax_lse, S_dmask = _flash_attn_forward(
             q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q, max_seqlen_k, attn_mask, attn_bias,
-            dropout_p, softmax_scale, causal=causal, return_softmax=return_softmax
+            dropout_p, softmax_scale, causal=causal, return_softmax=return_softmax,
+            lpt_schedule=lpt_schedule, gate=gate, cpu_memory_budget=cpu_memory_budget
         )
-        ctx.save_for_backward(q, k, v, out, softmax_lse, cu_seqlens_q, cu_seqlens_k, rng_state, attn_mask, attn_bias)
+        ctx.save_for_backward(q, k, v, out, softmax_lse, cu_seqlens_q, cu_seqlens_k, rng_state, attn_mask, attn_bias,
+                              gate)
         ctx.dropout_p = dropout_p
         ctx.max_seqlen_q = max_seqlen_q
         ctx.max_seqlen_k = max_seqlen_k
         ctx.softmax_scale = softmax_scale
         ctx.causal = causal
+        ctx.deterministic = deterministic
         return out if not return_softmax else (out, softmax_lse, S_dmask)
 
     @staticmethod
     def backward(ctx, dout, *args):
-        q, k, v, out, softmax_lse, cu_seqlens_q, cu_seqlens_k, rng_state, attn_mask, attn_bias = ctx.saved_tensors
+        q, k, v, out, softmax_lse, cu_seqlens_q, cu_seqlens_k, rng_state, attn_mask, attn_bias, gate = ctx.saved_tensors
         if rng_state is not None:
             cur_rng_state = torch.cuda.get_rng_state()
             torch.cuda.set_rng_state(rng_state)
         dq, dk, dv = torch.empty_like(q), torch.empty_like(k), torch.empty_like(v)
         # import pdb; pdb.set_trace()
-        dq, dk, dv, softmax_d, dbias = _flash_attn_backward(
+        dq, dk, dv, softmax_d, dbias, dgate = _flash_attn_backward(
             dout, q, k, v, out, softmax_lse, dq, dk, dv, cu_seqlens_q, cu_seqlens_k, attn_mask, attn_bias,
-            ctx.max_seqlen_q, ctx.max_seqlen_k, ctx.dropout_p, ctx.softmax_scale, ctx.causal
+            ctx.max_seqlen_q, ctx.max_seqlen_k, ctx.dropout_p, ctx.softmax_scale, ctx.causal,
+            ctx.deterministic, gate
         )
         if rng_state is not None:
             torch.cuda.set_rng_state(cur_rng_state)
-        return dq, dk, dv, None, None, None, None, None, dbias, None, None, None, None
+        return dq, dk, dv, None, None, None, None, None, dbias, None, None, None, None, None, None, dgate, None
         # TODO: the last two is attn_mask, attn_bias, bias need gradient
 
 
+class FlashAttnBatchedFunc(torch.autograd.Function):
+
+    @staticmethod
+    def forward(ctx, q, k, v, key_padding_mask, attn_bias, softmax_scale, causal, deterministic):
+        if softmax_scale is None:
+            softmax_scale = q.shape[-1] ** (-0.5)
+        out, softmax_lse = flash_attn_cuda.fwd_batched(q, k, v, softmax_scale, causal,
+                                                       key_padding_mask, attn_bias)
+        ctx.save_for_backward(q, k, v, out, softmax_lse, key_padding_mask, attn_bias)
+        ctx.softmax_scale = softmax_scale
+        ctx.causal = causal
+        ctx.deterministic = deterministic
+        return out
+
+    @staticmethod
+    def backward(ctx, dout):
+        q, k, v, out, softmax_lse, key_padding_mask, attn_bias = ctx.saved_tensors
+        dq, dk, dv, softmax_d, *rest = flash_attn_cuda.bwd_batched(
+            dout, q, k, v, out, softmax_lse, ctx.softmax_scale, ctx.causal, key_padding_mask,
+            attn_bias, ctx.deterministic
+        )
+        dbias = rest[0] if attn_bias is not None else None
+        return dq, dk, dv, None, dbias, None, None, None
+
+
 def flash_attn_unpadded_qkvpacked_func(qkv, cu_seqlens, max_seqlen, dropout_p, softmax_scale=None,
                                        causal=False, return_attn_probs=False):
     """dropout_p should be set to 0.0 during evaluation
@@ -215,7 +250,8 @@ def flash_attn_unpadded_kvpacked_func(q, kv, cu_seqlens_q, cu_seqlens_k, max_seq
 
 
 def flash_attn_unpadded_func(q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q, max_seqlen_k, attn_mask=None, attn_bias=None,
-                             dropout_p=0.0, softmax_scale=None, causal=False, return_attn_probs=False):
+                             dropout_p=0.0, softmax_scale=None, causal=False, return_attn_probs=False,
+                             deterministic=False, lpt_schedule=False, gate=None, cpu_memory_budget=None):
     """dropout_p should be set to 0.0 during evaluation
     Arguments:
         q: (total_q, nheads, headdim), where total_q = total number of query tokens in the batch.
@@ -234,6 +270,19 @@ def flash_attn_unpadded_func(q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q,
         return_attn_probs: bool. Whether to return the attention probabilities. This option is for
            testing only. The returned probabilities are not guaranteed to be correct
            (they might not have the right scaling).
+        deterministic: bool. Whether the backward pass reduces the partial gradients in a fixed
+           order, so that gradients are bitwise reproducible across runs and, on CPU, across
+           thread counts. Uses more memory on CPU.
+        lpt_schedule: bool. Whether the forward pass splits every (sequence, head) into blocks of
+           queries and runs them longest first on persistent CTAs, which balances ragged batches.
+           Not supported with dropout or return_attn_probs. CPU tensors always use this schedule.
+        gate: (total_q, nheads, headdim), contiguous, same dtype as q. If given, the output is
+           out * sigmoid(gate), applied in the epilogue of the kernel, and the backward pass also
+           returns the gradient of gate.
+        cpu_memory_budget: int. CPU only: bytes per thread that a chunk of queries, the block of
+           keys and values streamed past it and their bias tile must fit in, e.g. the L2 cache
+           size. The tile sizes are picked by flash_attn_cpu_chunk_plan. Default to half of the L2
+           cache of one core.
     Return:
         out: (total, nheads, headdim).
         softmax_lse [optional, if return_attn_probs=True]: (batch_size, nheads, seqlen). The
@@ -244,7 +293,73 @@ def flash_attn_unpadded_func(q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q,
             pattern (negative means that location was dropped, nonnegative means it was kept).
     """
     return FlashAttnFunc.apply(q, k, v, cu_seqlens_q, cu_seqlens_k, max_seqlen_q, max_seqlen_k, attn_mask, attn_bias,
-                               dropout_p, softmax_scale, causal, return_attn_probs)
+                               dropout_p, softmax_scale, causal, return_attn_probs, deterministic,
+                               lpt_schedule, gate, cpu_memory_budget or 0)
+
+
+def flash_attn_batched_func(q, k, v, key_padding_mask=None, attn_bias=None, softmax_scale=None,
+                            causal=False, deterministic=False):
+    """Attention over the last three dims of tensors with any leading batch dims, read in place.
+    Arguments:
+        q: (*, seqlen_q, nheads, headdim). The leading dims may have any strides, e.g. a transposed
+           view of a pair representation for the columns of triangle or axial attention.
+        k: (*, seqlen_k, nheads, headdim), with the same leading dims as q.
+        v: (*, seqlen_k, nheads, headdim), with the same leading dims as q.
+        key_padding_mask: (*, seqlen_k), bool or int. Nonzero means the key is valid. Padded keys
+           are masked out rather than removed, so no unpadding copy of k and v is made.
+        attn_bias: (*b, nheads, seqlen_q, seqlen_k) with contiguous last three dims. The leading
+           dims broadcast against those of q (missing or size 1 dims are shared, read with
+           stride 0), e.g. (B, 1, nheads, N, N) for the bias of triangle attention over (B, N)
+           rows. The gradient is summed back to the shape of attn_bias.
+        softmax_scale: float. The scaling of QK^T before applying softmax.
+            Default to 1 / sqrt(headdim).
+        causal: bool. Whether to apply causal attention mask (e.g., for auto-regressive modeling).
+        deterministic: bool. Whether the backward pass reduces the partial gradients in a fixed
+           order.
+    Return:
+        out: (*, seqlen_q, nheads, headdim).
+    """
+    return FlashAttnBatchedFunc.apply(q, k, v, key_padding_mask, attn_bias, softmax_scale, causal,
+                                      deterministic)
+
+
+def flash_attn_schedule_stats(pass_name="fwd"):
+    """Load balance of the last "fwd" (lpt_schedule=True or CPU) or "bwd" (CPU) call.
+    Return:
+        dict with num_items, num_workers, num_steals, total_cost, max_worker_cost and imbalance,
+        the max over the mean of the per worker load (1.0 is perfectly balanced). Empty if no such
+        call has been made yet.
+    """
+    return flash_attn_cuda.schedule_stats(pass_name)
+
+
+def flash_attn_simulate_schedule(cu_seqlens_q, cu_seqlens_k, nheads, num_workers, block_size=16,
+                                 causal=False):
+    """Predicted load balance of a ragged batch on num_workers identical workers that drain the
+    work queue in order, with the cost of a work item counted in (query, key) pairs.
+    Arguments:
+        cu_seqlens_q, cu_seqlens_k: (batch_size + 1,), torch.int32.
+        block_size: int. Split every (sequence, head) into blocks of block_size query rows and
+           queue them longest first, as lpt_schedule=True does. 0 queues one item per
+           (sequence, head) in grid order, as the default (batch, head) grid does.
+    Return:
+        dict with the keys of flash_attn_schedule_stats.
+    """
+    return flash_attn_cuda.simulate_schedule(cu_seqlens_q.cpu().contiguous(),
+                                             cu_seqlens_k.cpu().contiguous(), nheads, block_size,
+                                             causal, num_workers)
+
+
+def flash_attn_cpu_chunk_plan(headdim, dtype=torch.float16, has_attn_mask=False, has_attn_bias=False,
+                              memory_budget=0):
+    """Tile sizes of the CPU forward pass for cpu_memory_budget=memory_budget.
+    Return:
+        dict with block_m (queries per chunk), block_n (keys per block), working_set_bytes and
+        budget_bytes. A memory_budget of 0 plans for half of the L2 cache of one core.
+    """
+    element_size = torch.empty((), dtype=dtype).element_size()
+    return flash_attn_cuda.cpu_chunk_plan(headdim, element_size, has_attn_mask, has_attn_bias,
+                                          memory_budget)
 
 
 def flash_attn_func(qkv, cu_seqlens, dropout_p, max_s, softmax_scale=None, causal=False,
@@ -121,6 +121,9 @@ ext_modules.append(
             "csrc/flash_attn/src/fmha_dgrad_fp16_kernel_loop.sm80.cu",
             "csrc/flash_attn/src/fmha_block_fprop_fp16_kernel.sm80.cu",
             "csrc/flash_attn/src/fmha_block_dgrad_fp16_kernel_loop.sm80.cu",
+            "csrc/flash_attn/src/fmha_fprop_cpu.cpp",
+            "csrc/flash_attn/src/fmha_dgrad_cpu.cpp",
+            "csrc/flash_attn/src/fmha_scheduler.cpp",
         ],
         extra_compile_args={
             "cxx": ["-O3", "-std=c++17"] + generator_flag,
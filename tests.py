@@ -1,6 +1,5 @@
 import torch
-from flash_attn.flash_attn_interface import flash_attn_unpadded_func
-from flash_attn.bert_padding import unpad_input
+from flash_attn.flash_attn_interface import flash_attn_batched_func
 
 
 def _flash_attn(q, k, v, mask, bias, window_size=(-1, -1)):
@@ -15,50 +14,23 @@ def _flash_attn(q, k, v, mask, bias, window_size=(-1, -1)):
         mask:
             (*, seqlen), bool / int, 1 means valid and 0 means not valid.
         bias:
-            (*, n_heads, seq_len, seq_len) bias tensor
+            (*, n_heads, seq_len, seq_len) bias tensor, leading dims may be missing or 1 to share it
         window_size:
             (left, right). If not (-1, -1), implements sliding window local attention.
     """
-    batch_dims = q.shape[:-3]
-    n, no_heads, c = q.shape[-3:]
     dtype = q.dtype
-    q = q.half()
-    k = k.half()
-    v = v.half()
-    bias = bias.half()
-    mask = mask.bool()  # Ensure mask is boolean
+    if dtype not in (torch.float16, torch.bfloat16):
+        q, k, v, bias = q.half(), k.half(), v.half(), bias.half()
 
-    # Reshape inputs
-    q = q.reshape(-1, *q.shape[-3:])  # [B_flat, N, H, C]
-    k = k.reshape(-1, *k.shape[-3:])
-    v = v.reshape(-1, *v.shape[-3:])
-    
-    batch_size = q.shape[0]
-    q = q.reshape(-1, *q.shape[-2:])  # [B_flat * N, H, C]
-
-    # Create cu_seqlens for the entire batch
-    cu_seqlens = torch.arange(0, (batch_size + 1) * n, step=n, dtype=torch.int32, device=q.device)
-    
-    # Unpad k and v
-    k_unpad, k_indices, k_cu_seqlens, k_max_s = unpad_input(k, mask)
-    v_unpad, v_indices, v_cu_seqlens, v_max_s = unpad_input(v, mask)
-
-    out = flash_attn_unpadded_func(
+    # The leading dims, the key padding and the bias broadcast are all handled in place.
+    out = flash_attn_batched_func(
         q,
-        k_unpad,
-        v_unpad,
-        cu_seqlens,
-        k_cu_seqlens,
-        n,  # q_max_s
-        k_max_s,
-        attn_mask=None,  # We're using unpadded input, so no need for attn_mask
+        k,
+        v,
+        key_padding_mask=mask,
         attn_bias=bias,
-        dropout_p=0.,
         softmax_scale=1.,  # q has been scaled already
     )
-
-    # Reshape output
-    out = out.reshape(*batch_dims, n, no_heads, c)
     out = out.to(dtype=dtype)
     return out
 
@@ -7,12 +7,12 @@ import pytest
 
 from einops import rearrange, repeat
 
-from flash_attn.flash_attn_interface import flash_attn_func, flash_attn_unpadded_qkvpacked_func, _get_block_size, flash_attn_unpadded_kvpacked_func, flash_attn_unpadded_func
+from flash_attn.flash_attn_interface import flash_attn_func, flash_attn_unpadded_qkvpacked_func, _get_block_size, flash_attn_unpadded_kvpacked_func, flash_attn_unpadded_func, flash_attn_schedule_stats, flash_attn_simulate_schedule, flash_attn_batched_func, flash_attn_cpu_chunk_plan
 from flash_attn.bert_padding import unpad_input, pad_input, index_first_axis
 
 
-is_sm75 = torch.cuda.get_device_capability('cuda') == (7, 5)
-is_sm80 = torch.cuda.get_device_capability('cuda') == (8, 0)
+is_sm75 = torch.cuda.is_available() and torch.cuda.get_device_capability('cuda') == (7, 5)
+is_sm80 = torch.cuda.is_available() and torch.cuda.get_device_capability('cuda') == (8, 0)
 
 
 def generate_random_padding_mask(max_seqlen, batch_size, device, mode='random'):
@@ -666,4 +666,250 @@ def test_flash_attn_race_condition(seqlen, d, dropout_p, causal, dtype):
                                                                 (q_unpad, k_unpad, v_unpad), g)
             assert torch.equal(dq_unpad, dq_unpad_0)
             assert torch.equal(dk_unpad, dk_unpad_0)
-            assert torch.equal(dv_unpad, dv_unpad_0)
\ No newline at end of file
+            assert torch.equal(dv_unpad, dv_unpad_0)
+
+
+@pytest.mark.parametrize('dtype', [torch.float16, torch.bfloat16])
+@pytest.mark.parametrize('causal', [False, True])
+@pytest.mark.parametrize('seqlen', [97, 256, 300])
+def test_flash_attn_deterministic_cpu(seqlen, causal, dtype):
+    device = 'cpu'
+    # set seed
+    torch.random.manual_seed(0)
+    batch_size = 4
+    nheads = 2
+    d = 32
+    softmax_scale = d ** (-0.5)
+    q, k, v, g = [torch.randn(batch_size * seqlen, nheads, d, device=device, dtype=dtype)
+                  for _ in range(4)]
+    # Two bias groups, so dbias sums the ds of batches {0, 2} and {1, 3}.
+    bias = torch.randn(2, nheads, seqlen, seqlen, device=device, dtype=dtype)
+    cu_seqlens = torch.arange(0, (batch_size + 1) * seqlen, step=seqlen, dtype=torch.int32,
+                              device=device)
+
+    def run():
+        q_, k_, v_, bias_ = [x.detach().requires_grad_() for x in (q, k, v, bias)]
+        out = flash_attn_unpadded_func(q_, k_, v_, cu_seqlens, cu_seqlens, seqlen, seqlen,
+                                       attn_bias=bias_, softmax_scale=softmax_scale,
+                                       causal=causal, deterministic=True)
+        out.backward(g)
+        return out, q_.grad, k_.grad, v_.grad, bias_.grad
+
+    num_threads = torch.get_num_threads()
+    try:
+        torch.set_num_threads(1)
+        results_0 = run()
+        for n in range(1, max(num_threads, 4) + 1):
+            torch.set_num_threads(n)
+            for result, result_0 in zip(run(), results_0):
+                assert torch.equal(result, result_0)
+    finally:
+        torch.set_num_threads(num_threads)
+
+    q_ref, k_ref, v_ref, bias_ref = [x.float().requires_grad_() for x in (q, k, v, bias)]
+    scores = torch.einsum('bthd,bshd->bhts', *[rearrange(x, '(b s) h d -> b s h d', b=batch_size)
+                                              for x in (q_ref, k_ref)])
+    scores = (scores + bias_ref.repeat(batch_size // 2, 1, 1, 1)) * softmax_scale
+    if causal:
+        causal_mask = torch.triu(torch.ones(seqlen, seqlen, dtype=torch.bool, device=device), 1)
+        scores = scores.masked_fill(causal_mask, float('-inf'))
+    out_ref = torch.einsum('bhts,bshd->bthd', torch.softmax(scores, dim=-1),
+                           rearrange(v_ref, '(b s) h d -> b s h d', b=batch_size))
+    out_ref = rearrange(out_ref, 'b s h d -> (b s) h d')
+    out_ref.backward(g.float())
+    atol = 1e-2 if dtype == torch.float16 else 5e-2
+    for result, ref in zip(results_0, (out_ref, q_ref.grad, k_ref.grad, v_ref.grad, bias_ref.grad)):
+        print(f'max diff: {(result.float() - ref).abs().max().item()}')
+        assert torch.allclose(result.float(), ref, rtol=0, atol=atol)
+
+
+def attention_ragged_ref(q, k, v, cu_seqlens_q, cu_seqlens_k, softmax_scale, causal=False):
+    """Per sequence float reference for packed (total, nheads, headdim) inputs.
+    """
+    out = []
+    for i in range(cu_seqlens_q.numel() - 1):
+        qi = q[cu_seqlens_q[i]:cu_seqlens_q[i + 1]].float()
+        ki = k[cu_seqlens_k[i]:cu_seqlens_k[i + 1]].float()
+        vi = v[cu_seqlens_k[i]:cu_seqlens_k[i + 1]].float()
+        scores = torch.einsum('thd,shd->hts', qi, ki) * softmax_scale
+        if causal:
+            causal_mask = torch.triu(torch.ones(qi.shape[0], ki.shape[0], dtype=torch.bool,
+                                                device=q.device), 1)
+            scores = scores.masked_fill(causal_mask, float('-inf'))
+        out.append(torch.einsum('hts,shd->thd', torch.softmax(scores, dim=-1), vi))
+    return torch.cat(out)
+
+
+@pytest.mark.parametrize('causal', [False, True])
+def test_flash_attn_lpt_schedule_cpu(causal):
+    device = 'cpu'
+    dtype = torch.float16
+    # set seed
+    torch.random.manual_seed(0)
+    # One long sequence among short ones: a (batch, head) grid would leave it to a single worker.
+    seqlens = [700, 17, 64, 5, 130, 33]
+    nheads = 2
+    d = 32
+    softmax_scale = d ** (-0.5)
+    cu_seqlens = torch.tensor([0] + seqlens, dtype=torch.int32, device=device).cumsum(0, dtype=torch.int32)
+    total = sum(seqlens)
+    q, k, v = [torch.randn(total, nheads, d, device=device, dtype=dtype) for _ in range(3)]
+    out = flash_attn_unpadded_func(q, k, v, cu_seqlens, cu_seqlens, max(seqlens), max(seqlens),
+                                   softmax_scale=softmax_scale, causal=causal, lpt_schedule=True)
+    out_ref = attention_ragged_ref(q, k, v, cu_seqlens, cu_seqlens, softmax_scale, causal=causal)
+    print(f'Output max diff: {(out.float() - out_ref).abs().max().item()}')
+    assert torch.allclose(out.float(), out_ref, rtol=0, atol=1e-2)
+
+    stats = flash_attn_schedule_stats('fwd')
+    # Query blocks of the default chunk plan.
+    block_m = flash_attn_cpu_chunk_plan(d, dtype)['block_m']
+    assert stats['num_items'] == nheads * sum((s + block_m - 1) // block_m for s in seqlens)
+
+    # The predicted balance on a fixed number of workers, so the check does not depend on the
+    # machine or its L2 size: the long sequence alone is about half of the total cost.
+    num_workers = 8
+    lpt = flash_attn_simulate_schedule(cu_seqlens, cu_seqlens, nheads, num_workers, block_size=16,
+                                       causal=causal)
+    grid = flash_attn_simulate_schedule(cu_seqlens, cu_seqlens, nheads, num_workers, block_size=0,
+                                        causal=causal)
+    assert lpt['num_items'] == nheads * sum((s + 15) // 16 for s in seqlens)
+    assert grid['num_items'] == len(seqlens) * nheads
+    assert lpt['total_cost'] == grid['total_cost']
+    assert lpt['imbalance'] < 1.5
+    assert grid['imbalance'] > 3.0
+
+
+@pytest.mark.skipif(not torch.cuda.is_available(), reason='requires CUDA')
+@pytest.mark.parametrize('dtype', ([torch.float16] if not is_sm80 else [torch.float16, torch.bfloat16]))
+@pytest.mark.parametrize('causal', [False, True])
+@pytest.mark.parametrize('d', [32, 64, 128])
+def test_flash_attn_lpt_schedule(d, causal, dtype):
+    device = 'cuda'
+    # set seed
+    torch.random.manual_seed(0)
+    seqlens = [1500, 17, 64, 5, 300, 33, 700, 128]
+    nheads = 4
+    softmax_scale = d ** (-0.5)
+    cu_seqlens = torch.tensor([0] + seqlens, dtype=torch.int32, device=device).cumsum(0, dtype=torch.int32)
+    total = sum(seqlens)
+    q, k, v = [torch.randn(total, nheads, d, device=device, dtype=dtype) for _ in range(3)]
+    out_grid = flash_attn_unpadded_func(q, k, v, cu_seqlens, cu_seqlens, max(seqlens), max(seqlens),
+                                        softmax_scale=softmax_scale, causal=causal)
+    out = flash_attn_unpadded_func(q, k, v, cu_seqlens, cu_seqlens, max(seqlens), max(seqlens),
+                                   softmax_scale=softmax_scale, causal=causal, lpt_schedule=True)
+    # Every row is computed by the same sequence of tile operations, whichever CTA runs it.
+    assert torch.equal(out, out_grid)
+    stats = flash_attn_schedule_stats('fwd')
+    assert stats['num_items'] > len(seqlens) * nheads
+    # The (batch, head) grid on as many CTAs leaves the longest sequence to a single one.
+    grid = flash_attn_simulate_schedule(cu_seqlens, cu_seqlens, nheads, stats['num_workers'],
+                                        block_size=0, causal=causal)
+    assert stats['total_cost'] == grid['total_cost']
+    assert stats['max_worker_cost'] < grid['max_worker_cost']
+
+
+@pytest.mark.parametrize('device', ['cpu'] + (['cuda'] if torch.cuda.is_available() else []))
+@pytest.mark.parametrize('causal', [False, True])
+def test_flash_attn_output_gate(causal, device):
+    dtype = torch.float16
+    # set seed
+    torch.random.manual_seed(0)
+    seqlens = [300, 17, 64, 129]
+    nheads = 2
+    d = 32
+    softmax_scale = d ** (-0.5)
+    cu_seqlens = torch.tensor([0] + seqlens, dtype=torch.int32, device=device).cumsum(0, dtype=torch.int32)
+    total = sum(seqlens)
+    q, k, v, gate = [torch.randn(total, nheads, d, device=device, dtype=dtype, requires_grad=True)
+                     for _ in range(4)]
+    out = flash_attn_unpadded_func(q, k, v, cu_seqlens, cu_seqlens, max(seqlens), max(seqlens),
+                                   softmax_scale=softmax_scale, causal=causal, gate=gate)
+    g = torch.randn_like(out)
+    dq, dk, dv, dgate = torch.autograd.grad(out, (q, k, v, gate), g)
+
+    q_ref, k_ref, v_ref, gate_ref = [x.detach().float().requires_grad_() for x in (q, k, v, gate)]
+    out_ref = attention_ragged_ref(q_ref, k_ref, v_ref, cu_seqlens, cu_seqlens, softmax_scale,
+                                   causal=causal) * torch.sigmoid(gate_ref)
+    out_ref.backward(g.float())
+    for result, ref in zip((out, dq, dk, dv, dgate),
+                           (out_ref, q_ref.grad, k_ref.grad, v_ref.grad, gate_ref.grad)):
+        print(f'max diff: {(result.float() - ref).abs().max().item()}')
+        assert torch.allclose(result.float(), ref, rtol=0, atol=2e-2)
+
+
+@pytest.mark.parametrize('memory_budget', [0, 32 * 1024, 256 * 1024])
+@pytest.mark.parametrize('causal', [False, True])
+def test_flash_attn_cpu_chunked(causal, memory_budget):
+    device = 'cpu'
+    dtype = torch.float16
+    # set seed
+    torch.random.manual_seed(0)
+    batch_size, seqlen, nheads, d = 2, 333, 2, 64
+    softmax_scale = d ** (-0.5)
+    plan = flash_attn_cpu_chunk_plan(d, dtype, has_attn_bias=True, memory_budget=memory_budget)
+    if memory_budget > 0:
+        assert plan['budget_bytes'] == memory_budget
+    assert plan['working_set_bytes'] <= plan['budget_bytes']
+    assert plan['block_m'] % 16 == 0 and plan['block_n'] % 16 == 0
+
+    cu_seqlens = torch.arange(0, (batch_size + 1) * seqlen, seqlen, dtype=torch.int32, device=device)
+    q, k, v = [torch.randn(batch_size * seqlen, nheads, d, device=device, dtype=dtype) for _ in range(3)]
+    attn_bias = torch.randn(1, nheads, seqlen, seqlen, device=device, dtype=dtype)
+    out = flash_attn_unpadded_func(q, k, v, cu_seqlens, cu_seqlens, seqlen, seqlen, attn_bias=attn_bias,
+                                   softmax_scale=softmax_scale, causal=causal,
+                                   cpu_memory_budget=memory_budget)
+
+    q_ref, k_ref, v_ref = [rearrange(x.float(), '(b s) h d -> b s h d', b=batch_size) for x in (q, k, v)]
+    scores = torch.einsum('bthd,bshd->bhts', q_ref, k_ref) + attn_bias.float()
+    if causal:
+        causal_mask = torch.triu(torch.ones(seqlen, seqlen, dtype=torch.bool, device=device), 1)
+        scores = scores.masked_fill(causal_mask, float('-inf'))
+    out_ref = torch.einsum('bhts,bshd->bthd', torch.softmax(scores * softmax_scale, dim=-1), v_ref)
+    out_ref = rearrange(out_ref, 'b s h d -> (b s) h d')
+    print(f'Output max diff: {(out.float() - out_ref).abs().max().item()}')
+    assert torch.allclose(out.float(), out_ref, rtol=0, atol=1e-2)
+
+    stats = flash_attn_schedule_stats('fwd')
+    assert stats['num_items'] == batch_size * nheads * ((seqlen + plan['block_m'] - 1) // plan['block_m'])
+
+
+@pytest.mark.parametrize('device', ['cpu'] + (['cuda'] if torch.cuda.is_available() else []))
+@pytest.mark.parametrize('transpose', [False, True])
+def test_flash_attn_batched_triangle(transpose, device):
+    dtype = torch.float16
+    # set seed
+    torch.random.manual_seed(0)
+    batch_size = 2
+    n = 40
+    nheads = 2
+    d = 32
+    softmax_scale = d ** (-0.5)
+    # Triangle attention over the rows (or, transposed, the columns) of a (B, N, N, H, D) pair
+    # representation, with one (H, N, N) bias per batch shared by all N rows.
+    q, k, v, g = [torch.randn(batch_size, n, n, nheads, d, device=device, dtype=dtype)
+                  for _ in range(4)]
+    if transpose:
+        q, k, v = [x.transpose(1, 2) for x in (q, k, v)]
+    bias = torch.randn(batch_size, 1, nheads, n, n, device=device, dtype=dtype)
+    key_padding_mask = torch.rand(batch_size, n, n, device=device) > 0.2
+    key_padding_mask[..., 0] = True
+
+    q_, k_, v_, bias_ = [x.detach().requires_grad_() for x in (q, k, v, bias)]
+    out = flash_attn_batched_func(q_, k_, v_, key_padding_mask=key_padding_mask, attn_bias=bias_,
+                                  softmax_scale=softmax_scale)
+    out.backward(g)
+
+    q_ref, k_ref, v_ref, bias_ref = [x.detach().float().requires_grad_() for x in (q, k, v, bias)]
+    scores = torch.einsum('...thd,...shd->...hts', q_ref, k_ref) + bias_ref
+    scores = scores.masked_fill(~key_padding_mask[..., None, None, :], float('-inf'))
+    out_ref = torch.einsum('...hts,...shd->...thd', torch.softmax(scores * softmax_scale, dim=-1), v_ref)
+    out_ref.backward(g.float())
+
+    assert out.shape == q.shape
+    # dbias sums the ds of all n rows.
+    for result, ref, atol in zip((out, q_.grad, k_.grad, v_.grad, bias_.grad),
+                                 (out_ref, q_ref.grad, k_ref.grad, v_ref.grad, bias_ref.grad),
+                                 (2e-2, 2e-2, 2e-2, 2e-2, 5e-2)):
+        print(f'max diff: {(result.float() - ref).abs().max().item()}')
+        assert result.shape == ref.shape
+        assert torch.allclose(result.float(), ref, rtol=0, atol=atol)